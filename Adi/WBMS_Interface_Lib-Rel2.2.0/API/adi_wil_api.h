@@ -157,6 +157,12 @@ adi_wil_err_t adi_wil_GetMode (adi_wil_pack_t const * const pPack,
  *          network managers to use the given ACL. Note that the given ACL data does
  *          not need to be kept until the callback occurs as the WIL keeps an internal
  *          copy of this list.
+ *          The ACL held by the primary manager is read back first. If it already
+ *          matches the given list nothing is written, and if the given list only
+ *          appends entries to it, only the new entries are sent: the nodes already
+ *          in the ACL keep their device IDs and stay connected. Any other change
+ *          (an entry replaced, removed or reordered) clears the ACL and writes the
+ *          whole list, which disconnects every node.
  *          This API is a non-blocking API.
  *
  *          Returned in the API callback:
@@ -582,6 +588,49 @@ adi_wil_err_t adi_wil_GetFile (adi_wil_pack_t const * const pPack,
                                adi_wil_device_t eDeviceId,
                                adi_wil_file_type_t eFileType);
 
+/**
+ * @brief   Retrieves a whole file from a single device in one call.
+ *
+ * @details Streaming alternative to adi_wil_GetFile for configuration,
+ *          black-box, inventory or container files. The WIL first reads the
+ *          file CRC from the device, then requests the file block by block
+ *          from the process task without further calls from the application.
+ *          Each block is passed to the API callback as it arrives, so the
+ *          file never needs to be held in one buffer, and the CRC of the
+ *          reassembled file is checked against the device before the
+ *          transfer is reported as complete.
+ *
+ *          The transfer holds a request context rather than the pack lock
+ *          (see adi_wil_GetCallbackDeviceId): transfers from different
+ *          devices run at the same time and their blocks interleave in the
+ *          callback. The application places each block at its iOffset in
+ *          the file of the device returned by adi_wil_GetCallbackDeviceId.
+ *
+ *          Returned in the API callback, with eAPI ADI_WIL_API_GET_FILE:
+ *          - rc:    ADI_WIL_ERR_IN_PROGRESS for each block but the last.
+ *                   ADI_WIL_ERR_SUCCESS with the last block once the file CRC
+ *                   matched. ADI_WIL_ERR_CRC if the reassembled file does not
+ *                   match the CRC reported by the device, in which case the
+ *                   blocks delivered so far must be discarded. Any other
+ *                   error ends the transfer without data.
+ *          - pData: The address of an adi_wil_file_t structure {@link adi_wil_file_t}
+ *
+ *          API available in Standby mode only.
+ *
+ * @param   pPack           Pack handle.
+ * @param   eDeviceId       Destination device ID, valid targets are:
+ *                          ADI_WIL_DEV_NODE_x - single node
+ *                          ADI_WIL_DEV_MANAGER_x - single manager
+ * @param   eFileType       File type being retrieved, as for adi_wil_GetFile.
+ *
+ * @return  adi_wil_err_t   Operation error code. ADI_WIL_ERR_API_IN_PROGRESS
+ *                          if another request to the same device is in flight
+ *                          or all request contexts are in use.
+ */
+adi_wil_err_t adi_wil_GetFileStream (adi_wil_pack_t const * const pPack,
+                                     adi_wil_device_t eDeviceId,
+                                     adi_wil_file_type_t eFileType);
+
 
 /**
  * @brief   Retrieves the current version number of the WIL software.
@@ -603,6 +652,10 @@ adi_wil_err_t adi_wil_GetWILSoftwareVersion (adi_wil_version_t * const pVersion)
  * @details This function does all the WBMS Interface Library processing for the
  *          given pack. It should be run in the main application loop. It is to
  *          be called at the rate of the SPI Tx/Rx rate.
+ *          Each pack and each of its ports has its own process lock, so the
+ *          process tasks of different packs can be called independently, e.g.
+ *          from different tasks or cores, provided the OSAL resources are
+ *          try-locks that are safe across those contexts.
  *          This API is blocking.
  *
  * @param   pPack           Pack handle.
@@ -894,6 +947,11 @@ adi_wil_err_t adi_wil_EnableNetworkDataCapture (adi_wil_pack_t const * const pPa
  *          table used for EMS plausibility checks when in Monitor mode. This
  *          API should be called prior to entering Monitoring mode if desired.
  *
+ *          For ADI_WIL_DEV_ALL_NODES the data blocks are broadcast in order,
+ *          followed by a single commit and a read back of the table CRC from
+ *          up to ADI_WIL_UPDATE_MONITOR_PARAMS_WINDOW nodes at once. A node
+ *          reporting a different CRC completes the API with ADI_WIL_ERR_CRC.
+ *
  *          Returned in the API callback:
  *          - rc:   The result of the operation {@link adi_wil_err_t}
  *          - pData: The address of an 32-bit CRC of the updated table
@@ -1037,6 +1095,49 @@ adi_wil_err_t adi_wil_ConfigureCellBalancing (adi_wil_pack_t const * const pPack
  */
 adi_wil_err_t adi_wil_GetCellBalancingStatus (adi_wil_pack_t const * const pPack);
 
+/**
+ * @brief   API to identify the device a request callback belongs to.
+ *
+ * @details adi_wil_GetDeviceVersion, adi_wil_GetGPIO, adi_wil_GetContextualData,
+ *          adi_wil_GetFileStream and single device adi_wil_GetFileCRC requests
+ *          do not hold the pack lock until they complete: up to
+ *          ADI_WIL_MAX_CONCURRENT_REQUESTS of them, each to a different
+ *          device, can be in flight at once, and
+ *          their callbacks can arrive in any order. Called from within such a
+ *          callback, this API returns the device the request was sent to.
+ *          Other APIs keep the pack lock for their whole duration and are
+ *          refused with ADI_WIL_ERR_API_IN_PROGRESS while concurrent requests
+ *          are outstanding.
+ *
+ *          This is a blocking API, only valid from within the API callback.
+ *
+ * @param   pPack           Pack handle.
+ * @param   pDeviceId       Pointer to the device ID of the completing request.
+ *
+ * @return  adi_wil_err_t   Operation error code, ADI_WIL_ERR_FAIL when not
+ *                          called from a concurrent request callback.
+ */
+adi_wil_err_t adi_wil_GetCallbackDeviceId (adi_wil_pack_t const * const pPack,
+                                           adi_wil_device_t * const pDeviceId);
+
+/**
+ * @brief   API to read the transmit statistics of the safety messages.
+ *
+ * @details Copies the heartbeat jitter and latency, the safety command
+ *          latency and the message counts kept by the ASSL into the user
+ *          provided {@link adi_wil_assl_tx_statistics_t} structure. Only
+ *          messages that were submitted to the transport are counted.
+ *
+ *          This is a blocking API.
+ *
+ * @param   pPack           Pack handle.
+ * @param   pStatistics     Pointer to store the transmit statistics.
+ *
+ * @return  adi_wil_err_t   Operation error code.
+ */
+adi_wil_err_t adi_wil_GetSafetyTxStatistics (adi_wil_pack_t const * const pPack,
+                                             adi_wil_assl_tx_statistics_t * const pStatistics);
+
 #ifdef __cplusplus
 }
 #endif
@@ -31,11 +31,29 @@ typedef struct
     volatile bool bActive;                                              /*!< Boolean to mark request as active or not */
 } adi_wil_user_request_state_t;
 
+/**
+ * @brief   Transmit timing of the ASSL messages, in ticker milliseconds,
+ *          measured when a message has been submitted to the transport
+ */
+struct adi_wil_assl_tx_statistics_t
+{
+    uint32_t iLastHeartbeatTxTime;                                      /*!< Time the previous heartbeat was handed to the transport */
+    uint32_t iHeartbeatJitterMax;                                       /*!< Largest deviation of a heartbeat interval from ADI_WIL_SAFETY_HEARTBEAT_TIME */
+    uint32_t iHeartbeatLatencyMax;                                      /*!< Longest time from a heartbeat being written to its submission */
+    uint32_t iCommandLatencyMax;                                        /*!< Longest time from a safety command being posted to its submission */
+    uint32_t iCommandLatencyTotal;                                      /*!< Sum of the command latencies, for the average */
+    uint32_t iHeartbeatCount;                                           /*!< Heartbeats handed to the transport */
+    uint32_t iCommandCount;                                             /*!< Safety commands handed to the transport */
+    uint32_t iBatchCount;                                               /*!< Submissions that carried more than one message */
+    bool bHeartbeatIntervalValid;                                       /*!< iLastHeartbeatTxTime belongs to the current run of heartbeats */
+};
+
 /**
  * @brief   ASSL Internals structure
  */
  typedef struct {
     adi_wil_user_request_state_t UserRequestState;                    /*!< State of User request API */
+    adi_wil_assl_tx_statistics_t TxStatistics;                        /*!< Heartbeat jitter and safety command latency */
     uint64_t iConnectedNodes;                                         /*!< Bitmap of nodes that are connected */
     uint32_t iHeartbeatTimerStartTime;                                /*!< Time when the heartbeat timer was started */
     uint32_t iLastMessageReceivedTime[ADI_WIL_MAX_NODES];             /*!< Timestamp of last packet received from each node */
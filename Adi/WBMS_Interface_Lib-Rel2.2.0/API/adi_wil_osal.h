@@ -38,7 +38,11 @@ typedef enum {
  * @brief   Create and initialize a locking resource.
   *
  * @details This function creates and initializes a locking resource. The resource
- *          is identified by the argument pPack.
+ *          is identified by the argument pPack. Besides pack handles, the WIL
+ *          uses the pack internals and port addresses as IDs of the process
+ *          task locks, so one resource is needed for the WIL globally, two
+ *          per pack and one per port. Creating a resource that already exists
+ *          shall succeed.
  *
  * @param  pPack                The address of the pack is creating the resource.
  *                              This argument is used to identify the resource as
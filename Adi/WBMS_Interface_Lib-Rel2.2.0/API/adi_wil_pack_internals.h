@@ -36,6 +36,28 @@ typedef enum
     ADI_WIL_LOAD_FILE_STATE_TRANSFER,                   /*!< Handshaking has finished - proceed to data TX phase. */
 } adi_wil_transfer_state_t;
 
+/**
+* @brief   Concurrent request context states
+*/
+typedef enum
+{
+    ADI_WIL_REQUEST_CONTEXT_FREE,                       /*!< Context not in use */
+    ADI_WIL_REQUEST_CONTEXT_CLAIMED,                    /*!< Request lock taken, request being set up */
+    ADI_WIL_REQUEST_CONTEXT_QUEUED,                     /*!< Request waiting for a free request frame on its port */
+    ADI_WIL_REQUEST_CONTEXT_ACTIVE,                     /*!< Request sent, waiting for a response or a timeout */
+} adi_wil_request_context_state_t;
+
+/**
+* @brief   Phases of a pipelined monitor parameters update
+*/
+typedef enum
+{
+    ADI_WIL_UPDATE_MONITOR_PARAMS_IDLE,                 /*!< No pipelined update in progress */
+    ADI_WIL_UPDATE_MONITOR_PARAMS_DATA,                 /*!< Data blocks being streamed */
+    ADI_WIL_UPDATE_MONITOR_PARAMS_COMMIT,               /*!< Commit sent, waiting for all devices */
+    ADI_WIL_UPDATE_MONITOR_PARAMS_VERIFY,               /*!< Reading back the CRC of each device */
+} adi_wil_update_monitor_params_phase_t;
+
 /******************************************************************************
  * Structure Definitions
  *****************************************************************************/
@@ -95,6 +117,30 @@ typedef struct
     bool bPartialSuccess;                                               /*!< At least one device completed the operation */
 } adi_wil_cmd_state_t;
 
+/**
+ * @brief State of a single device request running concurrently with others
+ */
+struct adi_wil_request_context_t
+{
+    adi_wil_cmd_state_t Request;                                        /*!< Target, token, timer and retry state of the request */
+    adi_wil_request_context_func_t pfRequestFunc;                       /*!< Function (re)sending the request */
+    adi_wil_api_t eAPI;                                                 /*!< API completed by this request */
+    volatile adi_wil_request_context_state_t eState;                    /*!< Current state of the context */
+    uint8_t iParameter;                                                 /*!< Request parameter: file type, GPIO ID or contextual data ID */
+};
+
+/**
+ * @brief Pool of concurrent request contexts. Context n is owned by the
+ *        holder of UI request lock n.
+ */
+typedef struct
+{
+    adi_wil_request_context_t Contexts [ADI_WIL_MAX_CONCURRENT_REQUESTS];   /*!< Request contexts */
+    adi_wil_request_context_t * pSubmitting;                                /*!< Context being transmitted, NULL when transmitting UserRequestState */
+    adi_wil_request_context_t const * pCompleting;                          /*!< Context whose API callback is in progress */
+    uint8_t iInFlightMax;                                                   /*!< Highest number of contexts in use at once */
+} adi_wil_request_pool_t;
+
 /**
  * @brief State information for load file state machine
  */
@@ -170,6 +216,16 @@ typedef struct {
     uint8_t iPercentage;                        /*!< State of charge in percentage */
 } adi_wil_state_of_health_state_t;
 
+/**
+ * @brief State of a streamed file transfer, one per request context
+ */
+typedef struct {
+    uint32_t iExpectedCRC;                      /*!< File CRC reported by the device before the transfer */
+    uint32_t iCRC;                              /*!< CRC of the blocks received so far */
+    uint16_t iOffset;                           /*!< Offset of the next block to request */
+    bool bCRCReceived;                          /*!< Boolean indicating the file CRC has been retrieved and blocks are being requested */
+} adi_wil_get_file_stream_t;
+
 /**
  * @brief State variables for get file state machine
  */
@@ -178,6 +234,7 @@ typedef struct {
     uint16_t iOffset;                           /*!< Current block offset */
     uint8_t iFileType;                          /*!< Current file type */
     bool bInProgress;                           /*!< Boolean indicating if the operation is in progress */
+    adi_wil_get_file_stream_t Streams [ADI_WIL_MAX_CONCURRENT_REQUESTS];  /*!< Streamed transfers, indexed by request context */
 } adi_wil_get_file_state_t;
 
 /**
@@ -219,6 +276,15 @@ typedef struct {
     uint8_t iLength;                                            /*!< Length of the identifier data */
 } adi_wil_customer_identifier_state_t;
 
+/**
+ * @brief State variables for the differential set ACL state machine
+ */
+typedef struct {
+    uint8_t iReadCount;                                 /*!< Number of manager ACL entries read back so far */
+    bool bComparing;                                    /*!< Boolean indicating the manager ACL is being read back for comparison */
+    bool bMismatch;                                     /*!< Boolean indicating the manager ACL is not a prefix of the requested ACL */
+} adi_wil_set_acl_state_t;
+
 /**
  * @brief State variables for environmental monitoring
  */
@@ -231,10 +297,15 @@ typedef struct {
  */
 typedef struct {
     uint64_t iUpdateMap;                                /*!< Bitmap for keep tracking of nodes */
+    uint64_t iVerifyMap;                                /*!< Devices whose CRC has still to be read back */
+    adi_wil_request_context_t Window [ADI_WIL_UPDATE_MONITOR_PARAMS_WINDOW]; /*!< Data block, or per-node CRC reads, in flight */
+    uint16_t WindowOffset [ADI_WIL_UPDATE_MONITOR_PARAMS_WINDOW];           /*!< Data offset of the block in each window entry */
     uint8_t* pData;                                     /*!< Pointer to update data */
+    uint32_t iCRC;                                      /*!< CRC32 of the data, checked against each device */
     uint16_t iOffset;                                   /*!< Current offset into data */
     uint16_t iLength;                                   /*!< Total length of data */
     uint8_t iPreviousRequestLength;                     /*!< Length of previous request sent */
+    adi_wil_update_monitor_params_phase_t ePhase;       /*!< Phase of a pipelined update */
 } adi_wil_update_monitor_params_state_t;
 
 /**
@@ -249,6 +320,7 @@ typedef struct {
  */
 typedef struct {
     uint32_t iTimestamp;                                /*!< Current timestamp extracted from a measurement */
+    uint32_t iPreviousTimestamp;                        /*!< Timestamp of the interval before iTimestamp */
     bool bInitialized;                                  /*!< Flag indicating if we've populated the iTimestamp field */
     bool bPendingChange;                                /*!< Flag indicating if the iTimestamp field must change due to a new interval */
 } adi_wil_xms_timestamp_state_t;
@@ -259,8 +331,10 @@ typedef struct {
 typedef struct {
     adi_wil_xms_timestamp_state_t TimestampState [2u];      /*!< Array of timestamp states. Index 1 for Manager 1 and index 0 for all other devices */
     uint8_t iMeasurementsReceived [ADI_WIL_MAX_DEVICES];    /*!< Array of the current count of measurements received in this interval per device */
+    uint8_t iPreviousMeasurementsReceived [ADI_WIL_MAX_DEVICES];    /*!< Counts of the previous interval, for late packets stored in its grace window */
     uint8_t iBaseSequenceNumber;                            /*!< Base sequence number for the interval that all devices should increment from */
     bool bFlushRequired;                                    /*!< Flag to indicate that the sequence number has been rolled forward so flush any packets currently buffered */
+    bool bPreviousIntervalOpen;                             /*!< Flag to indicate that the previous interval was rolled over by a new timestamp and may still take late packets */
 } adi_wil_xms_timestamp_conversion_state_t;
 
 /**
@@ -339,6 +413,28 @@ typedef struct {
     adi_wil_mgr_status_msg_t Manager1StatusMsg; /*!< System status message from manager 1 */
 } adi_wil_mgr_statistics_t;
 
+/**
+ * @brief   Port selection state of one manager
+ */
+typedef struct {
+    uint32_t iSelectCount;                              /*!< Requests to the nodes sent through this manager */
+    uint32_t iFailoverCount;                            /*!< Requests sent through this manager as the other one was not connected */
+    uint32_t iLastSubmitTime;                           /*!< Time of the last request sent through this manager */
+    uint32_t iSpiTxQueueOFCount;                        /*!< SPI transmit queue overflow counter of the last system status */
+    uint16_t iCongestion;                               /*!< Decaying penalty for SPI transmit queue overflows */
+    uint8_t iOutstanding;                               /*!< SendData requests awaiting the manager's response */
+    bool bStatusReceived;                               /*!< A system status has been received from this manager */
+} adi_wil_port_select_mgr_t;
+
+/**
+ * @brief   Port selection state for requests to the nodes
+ */
+typedef struct {
+    adi_wil_port_select_mgr_t Manager [2];              /*!< Per manager load, index 0 for manager 0 */
+    int8_t iNodeRSSI [ADI_WIL_MAX_NODES][2];            /*!< Filtered RSSI of each node through each manager, 0 if not heard yet */
+    uint32_t iLinkSteerCount;                           /*!< Selections decided by the link quality of the target node */
+} adi_wil_port_select_state_t;
+
 /**
  * @brief   statistics structure
  */
@@ -357,6 +453,7 @@ typedef struct {
 struct adi_wil_pack_internals_t
 {
     adi_wil_cmd_state_t UserRequestState;                                                             /*!< Current user request state */
+    adi_wil_request_pool_t RequestPool;                                                               /*!< Concurrent single device requests */
     adi_wil_node_state_t NodeState;                                                                   /*!< current ACL list with node states */
     adi_wil_connect_state_t ConnectState;                                                             /*!< connect state */
     adi_wil_setmode_state_t SetModeState;                                                             /*!< state of SetMode WIL API state machine */
@@ -378,6 +475,7 @@ struct adi_wil_pack_internals_t
     adi_wil_update_monitor_params_state_t UpdateMonParamsState;                                       /*!< Update monitor mode parameters state */
     adi_wil_apply_network_topology_state_t ApplyNetworkTopologyState;                                 /*!< Apply Network Topology State */
     adi_wil_acl_t ACLState;                                                                           /*!< Get/Set ACL State */
+    adi_wil_set_acl_state_t SetACLState;                                                              /*!< Differential set ACL state */
     adi_wil_xms_parameters_t XmsMeasurementParameters;                                                /*!< XMS measurement parameters */
     adi_wil_xms_timestamp_conversion_state_t BmsTimestampConversionState;                             /*!< BMS timestamp conversion state */
     adi_wil_xms_timestamp_conversion_state_t PmsTimestampConversionState;                             /*!< PMS timestamp conversion state */
@@ -385,7 +483,8 @@ struct adi_wil_pack_internals_t
     adi_wil_statistics_t Stats;                                                                       /*!< Statistics */
     adi_wil_port_t * pManager0Port;                                                                   /*!< Manager 0 port pointer */
     adi_wil_port_t * pManager1Port;                                                                   /*!< Manager 1 port pointer */
-    adi_wil_port_t * pCurrentPort;                                                                    /*!< Current port to call SendData with - stripe between managers in dual manager mode */
+    adi_wil_port_t * pCurrentPort;                                                                    /*!< Port to call SendData with on a port selection cost tie - stripe between managers in dual manager mode */
+    adi_wil_port_select_state_t PortSelectState;                                                      /*!< Load and link quality used to select the port for requests to the nodes */
     adi_wil_pack_t const * pPack;                                                                     /*!< Reference only to parent pack - not de-referencable in non-safety code */
     adi_wil_mode_t eMode;                                                                             /*!< current system mode */
     uint8_t iMaxNodeCount;                                                                            /*!< Maximum number of nodes in the system. */
@@ -23,6 +23,7 @@ struct adi_wil_sensor_data_t
     adi_wil_device_t eDeviceId;                         /*!< Device that produced this packet */
     uint16_t iLength;                                   /*!< Length of the data contained in the buffer */
     uint8_t Data[ADI_WIL_SENSOR_DATA_SIZE];             /*!< Buffer containing the payload data */
+    uint16_t iRxTime;                                   /*!< Time in ms from the iStartTime of the delivering buffer to the reception of this packet, 0 for an empty slot */
 };
 
 #endif // ADI_WIL_SENSOR_DATA_H
@@ -17,10 +17,18 @@
 
 /**
  * @brief   Sensor data buffer
+ *
+ * @details Delivered with every data ready event. The age of a slot at
+ *          release is iReleaseTime - iStartTime - iRxTime of the slot.
  */
 struct adi_wil_sensor_data_buffer_t {
     adi_wil_sensor_data_t * pData;                     /*!< Pointer to sensor data array */
     uint16_t iCount;                                   /*!< Number of entries in the array */
+    uint64_t iReceivedMap;                             /*!< Devices with at least one packet in this interval */
+    uint64_t iCompleteMap;                             /*!< Devices with every packet of this interval, the slots of the others may be empty (zero length) */
+    uint32_t iStartTime;                               /*!< Ticker time in ms at which the interval was started */
+    uint32_t iReleaseTime;                             /*!< Ticker time in ms at which the interval was handed to the application */
+    uint16_t iGracePktCount;                           /*!< Packets stored within the grace window after the interval rolled over */
 };
 
 #endif // ADI_WIL_SENSOR_DATA_BUFFER_H
@@ -67,6 +67,20 @@ extern "C" {
 */
 #define ADI_WIL_MAX_API_TIMEOUT (ADI_WIL_RESPONSE_TIMEOUT_MS * ADI_WIL_RETRIES)
 
+/**
+* @brief Maximum number of single device requests (GetDeviceVersion,
+*        GetFileCRC, GetGPIO, GetContextualData and GetFileStream) in flight
+*        at once
+*/
+#define ADI_WIL_MAX_CONCURRENT_REQUESTS (8u)
+
+/**
+* @brief Number of nodes whose table CRC is read back at once when
+*        UpdateMonitorParameters targets all nodes. Data blocks are always
+*        broadcast one at a time, so each node receives them in order
+*/
+#define ADI_WIL_UPDATE_MONITOR_PARAMS_WINDOW (8u)
+
 /**
 * @brief Length of the missing block bitmap in bytes for OTAP
 */
@@ -638,6 +652,11 @@ typedef struct adi_wil_pack_t adi_wil_pack_t;
  */
 typedef struct adi_wil_pack_internals_t adi_wil_pack_internals_t;
 
+/**
+ * @brief   Concurrent request context structure
+ */
+typedef struct adi_wil_request_context_t adi_wil_request_context_t;
+
 /**
  * @brief   Safety internals structure
  */
@@ -668,6 +687,11 @@ typedef struct adi_wil_connection_details_t adi_wil_connection_details_t;
  */
 typedef struct adi_wil_cell_balancing_status_t adi_wil_cell_balancing_status_t;
 
+/**
+ * @brief   ASSL transmit statistics structure
+ */
+typedef struct adi_wil_assl_tx_statistics_t adi_wil_assl_tx_statistics_t;
+
 /******************************************************************************
  * Callback types
  *******************************************************************************/
@@ -676,6 +700,12 @@ typedef struct adi_wil_cell_balancing_status_t adi_wil_cell_balancing_status_t;
  */
 typedef void (*adi_wil_api_process_func_t)(adi_wil_pack_internals_t * const pInternals);
 
+/**
+ * @brief Function type for a concurrent request state machine function
+ */
+typedef void (*adi_wil_request_context_func_t)(adi_wil_pack_internals_t * const pInternals,
+                                               adi_wil_request_context_t * const pContext);
+
 #ifdef __cplusplus
 }
 #endif
@@ -10,6 +10,7 @@
 #ifndef ADI_WIL_UI_INTERNALS__H
 #define ADI_WIL_UI_INTERNALS__H
 
+#include "adi_wil_types.h"
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -29,7 +30,8 @@ typedef struct {
  * @brief   UI Internals structure
  */
 typedef struct {
-    adi_wil_ui_lock_state_t LockState;      /*!< Pack lock state */
+    adi_wil_ui_lock_state_t LockState;                                              /*!< Pack lock state */
+    adi_wil_ui_lock_state_t RequestLockState [ADI_WIL_MAX_CONCURRENT_REQUESTS];     /*!< Shared pack lock state of each concurrent request */
 } adi_wil_ui_internals_t;
 
 #endif //ADI_WIL_UI_INTERNALS__H
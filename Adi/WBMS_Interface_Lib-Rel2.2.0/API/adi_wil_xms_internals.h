@@ -22,10 +22,35 @@
 /** Number of previous timestamps to track for interval identification */
 #define ADI_WIL_TIMESTAMP_HISTORY_COUNT_MAX (2u)
 
+/** Time in ms an incomplete non-FuSa interval stays open for late packets
+ *  after the next interval started. 0 releases it at once. The interval is
+ *  only held if the slots allocated to its XMS type fit two intervals */
+#ifndef ADI_WIL_XMS_GRACE_WINDOW_MS
+#define ADI_WIL_XMS_GRACE_WINDOW_MS (0u)
+#endif
+
 /******************************************************************************
  * Structure Definitions
  *****************************************************************************/
 
+/**
+ * @brief   Interval held open for late packets
+ */
+typedef struct
+{
+    uint64_t iCollectingMap;                             /*!< Devices allocated for the held interval */
+    uint64_t iReceivedMap;                               /*!< Devices with at least one packet in the held interval */
+    uint64_t iCompleteMap;                               /*!< Devices with every packet of the held interval */
+    adi_wil_sensor_data_t * pData;                       /*!< Slots of the held interval */
+    uint32_t iStartTick;                                 /*!< Tick the held interval was started */
+    uint32_t iHoldTick;                                  /*!< Tick the held interval rolled over, start of the grace window */
+    uint16_t iNumSlotsCollecting;                        /*!< Number of slots of the held interval */
+    uint16_t iNumSlotsCollected;                         /*!< Number of slots filled so far */
+    uint16_t iGracePktCount;                             /*!< Packets stored while held */
+    uint8_t iNumMeasPerInt;                              /*!< Number of packets per device in the held interval */
+    bool bActive;                                        /*!< An interval is held */
+} adi_wil_xms_grace_state_t;
+
  /**
   * @brief   Data packet statistics
   */
@@ -45,16 +70,21 @@ typedef struct
     uint64_t iCollectingMap;                             /*!< List of devices allocated for the current measurement interval */
     uint64_t iReceivedMap;                               /*!< List of devices we have received at least one packet for in the current measurement interval */
     uint64_t iSequenceInitializedMap;                    /*!< Mask to detect a devices's first measurement */
-    adi_wil_sensor_data_t * pData;                       /*!< EMS node data buffer pointer */
+    uint64_t iCompleteMap;                               /*!< List of devices we have received every packet for in the current measurement interval */
+    adi_wil_sensor_data_t * pData;                       /*!< Slots of the current measurement interval */
+    adi_wil_sensor_data_t * pBuffer;                     /*!< Start of the slots allocated to this XMS type */
+    adi_wil_xms_grace_state_t Grace;                     /*!< Previous interval held open for late packets */
     adi_wil_fusa_pkt_statistics_t Stats;                 /*!< BMS data statistics */
     adi_wil_event_id_t eEvent;                           /*!< Buffer submission event associated with this XMS type */
     uint32_t iLastTick;                                  /*!< Tick corresponding to last VALID measurement */
+    uint32_t iStartTick;                                 /*!< Tick the current measurement interval was started */
     uint32_t iCurrentTimestamp;                          /*!< Current timestamp of the collection interval */
     uint32_t iHistoricalTimestamps [ADI_WIL_TIMESTAMP_HISTORY_COUNT_MAX];   /*!< Storage for historical timestamps for interval detection */
     uint16_t iNumSlotsCollecting;                        /*!< Number of slots we are currently collecting for */
     uint16_t iNumSlotsCollected;                         /*!< Number of slots we have collected so far */
     uint16_t iNumSlotsAllocated;                         /*!< Number of slots in buffer (measurements per device times number of devices). */
     uint8_t iStartSequenceNumber [ADI_WIL_MAX_DEVICES];  /*!< Array to track the sequence number corresponding to ADI_WIL_XMS_START_MEASUREMENT of each node/manager. */
+    uint8_t iCollectingPosition [ADI_WIL_MAX_DEVICES];   /*!< Position of each device of iCollectingMap within the buffer, written with the device ID fields */
     uint8_t iNumMeasPerInt;                              /*!< Number of measurements expected per measurement interval */
     uint8_t iCollectingNumMeasPerInt;                    /*!< Currently collecting number of measurements expected per measurement interval */
     uint8_t iHistoricalTimestampCount;                   /*!< Number of valid iHistoricalTimestamps elements */
@@ -27,6 +27,15 @@ bool wb_assl_GetPendingMessage (adi_wil_pack_t const * const pPack,
                                uint8_t ** const pMessage,
                                uint8_t * const pDeviceId);
 
+uint8_t wb_assl_GetPendingMessages (adi_wil_pack_t const * const pPack,
+                                    uint8_t * pMessages [],
+                                    uint8_t DeviceIds [],
+                                    uint8_t iMaxCount);
+
+void wb_assl_RecordTx (adi_wil_pack_t const * const pPack,
+                       uint8_t * const pMessages [],
+                       uint8_t iCount);
+
 void wb_assl_ReleaseBuffer (adi_wil_pack_t const * const pPack,
                             uint8_t const * const pMessage);
 
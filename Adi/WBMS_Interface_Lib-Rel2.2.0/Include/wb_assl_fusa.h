@@ -51,6 +51,9 @@ void wb_assl_HandleValidatedSCLFrame (adi_wil_safety_internals_t * const pIntern
 
 void wb_assl_ReportValidationError (adi_wil_pack_t const * const pPack);
 
+adi_wil_err_t wb_assl_GetTxStatisticsAPI (adi_wil_safety_internals_t const * const pInternals,
+                                          adi_wil_assl_tx_statistics_t * const pStatistics);
+
 #ifdef __cplusplus
 }
 #endif
@@ -25,6 +25,8 @@ adi_wil_err_t wb_nil_packet_Process(adi_wil_port_t * const pPort, wb_pack_elemen
 
 adi_wil_err_t wb_nil_packet_ProcessLoggedOutPacket(adi_wil_port_t * const pPort, wb_pack_element_t * const pElement, uint8_t iMessageId);
 
+void wb_nil_packet_ProcessPacketReceived(adi_wil_pack_internals_t * const pInternals, uint64_t iDeviceId, wb_pack_element_t * const pElement);
+
 #ifdef __cplusplus
 }
 #endif
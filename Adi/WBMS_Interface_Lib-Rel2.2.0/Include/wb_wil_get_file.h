@@ -25,6 +25,14 @@ adi_wil_err_t wb_wil_GetFileAPI (adi_wil_pack_internals_t * const pInternals,
                                  uint64_t iDeviceId,
                                  adi_wil_file_type_t eFileType);
 
+adi_wil_err_t wb_wil_GetFileStreamAPI (adi_wil_pack_internals_t * const pInternals,
+                                       uint64_t iDeviceId,
+                                       adi_wil_file_type_t eFileType);
+
+void wb_wil_HandleGetFileStreamCRCResponse (adi_wil_pack_internals_t * const pInternals,
+                                            adi_wil_request_context_t * const pContext,
+                                            wbms_cmd_resp_get_file_crc_t const * const pResponse);
+
 void wb_wil_HandleGetFileResponse (adi_wil_pack_internals_t * const pInternals,
                                    uint64_t iDeviceId,
                                    wbms_cmd_resp_get_file_t const * const pResponse,
@@ -0,0 +1,107 @@
+/******************************************************************************
+* @file    wb_wil_port_select.h
+*
+* @brief   Manager port selection for requests targeting the nodes
+*
+* Copyright (c) 2022 Analog Devices, Inc. All Rights Reserved.
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+*******************************************************************************/
+
+#ifndef WB_WIL_PORT_SELECT_H
+#define WB_WIL_PORT_SELECT_H
+
+#include "adi_wil_types.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************
+* #defines
+*****************************************************************************/
+
+#define WB_WIL_PORT_SELECT_ANY_NODE (0xFFu)     /* Node ID passed for requests without a single node target */
+
+/******************************************************************************
+* Public functions
+*****************************************************************************/
+
+/**
+* @brief Select the manager port a request to the nodes is sent on
+*
+* @details Weighs, for each connected manager, the SendData requests still
+*          waiting for the manager's response, the recent growth of its SPI
+*          transmit queue overflow counter and, for a single node target, how
+*          much weaker the node is heard through it than through the other
+*          manager. Equal costs alternate between the managers. If only one
+*          manager is connected it is selected.
+*
+* @param pInternals - pointer to pack internals
+* @param iNodeId - network node ID of the target or WB_WIL_PORT_SELECT_ANY_NODE
+*
+* @return Port to transmit on or NULL if no manager is connected
+*
+*/
+adi_wil_port_t * wb_wil_PortSelectForNode (adi_wil_pack_internals_t * const pInternals, uint8_t iNodeId);
+
+/**
+* @brief Record SendData requests queued on a manager port
+*
+* @details Call only once the frame has been submitted, with the number of
+*          SendData packets it holds: each of them is answered with its own
+*          response, see wb_wil_PortSelectRecordResponse.
+*
+* @param pInternals - pointer to pack internals
+* @param pPort - port the frame was submitted on
+* @param iCount - SendData packets in the frame
+*
+* @return none
+*
+*/
+void wb_wil_PortSelectRecordSubmit (adi_wil_pack_internals_t * const pInternals, adi_wil_port_t const * const pPort, uint8_t iCount);
+
+/**
+* @brief Record the RSSI of a packet received from a node
+*
+* @param pInternals - pointer to pack internals
+* @param iManagerId - manager the packet was received through
+* @param iNodeId - network node ID of the sender
+* @param iRSSI - packet RSSI
+*
+* @return none
+*
+*/
+void wb_wil_PortSelectRecordLink (adi_wil_pack_internals_t * const pInternals, uint64_t iManagerId, uint8_t iNodeId, int8_t iRSSI);
+
+/**
+* @brief Record the SPI transmit queue overflow counter of a system status
+*        notification
+*
+* @details The first notification of a manager only sets the baseline,
+*          the counter is cumulative in the manager.
+*
+* @param pInternals - pointer to pack internals
+* @param iManagerId - manager the notification was received from
+* @param iSpiTxQueueOFCount - overflow counter reported by the manager
+*
+* @return none
+*
+*/
+void wb_wil_PortSelectRecordStatus (adi_wil_pack_internals_t * const pInternals, uint64_t iManagerId, uint32_t iSpiTxQueueOFCount);
+
+/**
+* @brief Record a SendData response from a manager
+*
+* @param pInternals - pointer to pack internals
+* @param iManagerId - manager the response was received from
+*
+* @return none
+*
+*/
+void wb_wil_PortSelectRecordResponse (adi_wil_pack_internals_t * const pInternals, uint64_t iManagerId);
+
+#ifdef __cplusplus
+}
+#endif
+#endif  //WB_WIL_PORT_SELECT_H
@@ -19,6 +19,12 @@
 extern "C" {
 #endif
 
+/******************************************************************************
+ * #defines
+ *****************************************************************************/
+
+#define WB_WIL_ASSL_BATCH_MAX (2u)      /* ASSL messages carried by one batched frame */
+
 /******************************************************************************
  * Public functions
  *****************************************************************************/
@@ -29,6 +35,15 @@ adi_wil_err_t wb_wil_SetupRequest (adi_wil_pack_internals_t * const pInternals,
                                    adi_wil_target_t const ValidTargets [],
                                    adi_wil_api_process_func_t pfRequestFunc);
 
+adi_wil_err_t wb_wil_SetupRequestContext (adi_wil_pack_internals_t * const pInternals,
+                                          adi_wil_request_context_t * const pContext,
+                                          uint64_t iDeviceId,
+                                          uint8_t iTargetCount,
+                                          adi_wil_target_t const ValidTargets []);
+
+bool wb_wil_CheckRequestFrameAvailable (adi_wil_pack_internals_t const * const pInternals,
+                                        uint64_t iDeviceId);
+
 adi_wil_err_t wb_wil_ClearPendingResponse (adi_wil_pack_internals_t * const pInternals,
                                            uint64_t iDeviceId);
 
@@ -143,6 +158,11 @@ adi_wil_err_t wb_wil_ASSLSendDataRequest (adi_wil_pack_internals_t * const pInte
                                           uint8_t const * const pMessage,
                                           uint8_t iDeviceId);
 
+adi_wil_err_t wb_wil_ASSLSendDataBatchRequest (adi_wil_pack_internals_t * const pInternals,
+                                               uint8_t * const pMessages [],
+                                               uint8_t const DeviceIds [],
+                                               uint8_t iCount);
+
 adi_wil_err_t wb_wil_ApplyNetworkTopologyRequest (adi_wil_pack_internals_t * const pInternals,
                                                   wbms_cmd_req_dmh_apply_t * const pRequest,
                                                   uint32_t iTimeout);
@@ -0,0 +1,71 @@
+/******************************************************************************
+ * @file    wb_wil_request_context.h
+ *
+ * @brief   Concurrent single device request contexts
+ *
+ * Copyright (c) 2022 Analog Devices, Inc. All Rights Reserved.
+ * This software is proprietary to Analog Devices, Inc. and its licensors.
+ *****************************************************************************/
+
+#ifndef WB_WIL_REQUEST_CONTEXT_H
+#define WB_WIL_REQUEST_CONTEXT_H
+
+#include "adi_wil_types.h"
+#include "adi_wil_pack_internals.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************
+ * Public functions
+ *****************************************************************************/
+
+adi_wil_err_t wb_wil_AcquireRequestContext (adi_wil_pack_internals_t * const pInternals,
+                                            adi_wil_api_t eAPI,
+                                            uint64_t iDeviceId,
+                                            uint8_t iParameter,
+                                            uint8_t iTargetCount,
+                                            adi_wil_target_t const ValidTargets [],
+                                            adi_wil_request_context_func_t pfRequestFunc,
+                                            adi_wil_request_context_t ** ppContext);
+
+void wb_wil_QueueRequestContext (adi_wil_request_context_t * const pContext);
+
+void wb_wil_ReleaseRequestContext (adi_wil_pack_internals_t * const pInternals,
+                                   adi_wil_request_context_t * const pContext);
+
+adi_wil_err_t wb_wil_RequeueRequestContext (adi_wil_pack_internals_t * const pInternals,
+                                            adi_wil_request_context_t * const pContext);
+
+void wb_wil_NotifyRequestContext (adi_wil_pack_internals_t * const pInternals,
+                                  adi_wil_request_context_t const * const pContext,
+                                  adi_wil_err_t rc,
+                                  void const * const pData);
+
+void wb_wil_CompleteRequestContext (adi_wil_pack_internals_t * const pInternals,
+                                    adi_wil_request_context_t * const pContext,
+                                    adi_wil_err_t rc,
+                                    void const * const pData);
+
+adi_wil_request_context_t * wb_wil_FindRequestContext (adi_wil_pack_internals_t * const pInternals,
+                                                       uint16_t iToken);
+
+void wb_wil_ProcessRequestContexts (adi_wil_pack_internals_t * const pInternals,
+                                    uint32_t iCurrentTime);
+
+void wb_wil_ProcessRequestContext (adi_wil_pack_internals_t * const pInternals,
+                                   adi_wil_request_context_t * const pContext,
+                                   uint32_t iCurrentTime);
+
+adi_wil_cmd_state_t * wb_wil_GetSubmittingRequestState (adi_wil_pack_internals_t * const pInternals);
+
+adi_wil_err_t wb_wil_GetCallbackDeviceIdAPI (adi_wil_pack_internals_t const * const pInternals,
+                                             adi_wil_device_t * const pDeviceId);
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // WB_WIL_REQUEST_CONTEXT_H
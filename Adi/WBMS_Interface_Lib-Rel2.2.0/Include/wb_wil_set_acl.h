@@ -30,6 +30,10 @@ void wb_wil_HandleClearACLResponse (adi_wil_pack_internals_t * const pInternals,
 void wb_wil_HandleSetACLResponse (adi_wil_pack_internals_t * const pInternals,
                                   wbms_cmd_resp_generic_t const * const pResponse);
 
+void wb_wil_HandleSetACLCompareResponse (adi_wil_pack_internals_t * const pInternals,
+                                         wbms_cmd_resp_get_acl_t const * const pResponse,
+                                         uint8_t const * const pData);
+
 #ifdef __cplusplus
 }
 #endif
@@ -42,6 +42,22 @@ adi_wil_err_t wb_wil_ui_AcquireLock (adi_wil_pack_t const * const pPack,
 void wb_wil_ui_ReleaseLock (adi_wil_pack_t const * const pPack,
                             void const * const pLockID);
 
+adi_wil_err_t wb_wil_ui_AcquireRequestLock (adi_wil_pack_t const * const pPack,
+                                            void const * const pLockID,
+                                            uint8_t * const pSlot);
+
+void wb_wil_ui_ReleaseRequestLock (adi_wil_pack_t const * const pPack,
+                                   void const * const pLockID,
+                                   uint8_t iSlot);
+
+adi_wil_err_t wb_wil_ui_CreateProcessLock (void const * const pLockID);
+
+adi_wil_err_t wb_wil_ui_AcquireProcessLock (void const * const pLockID);
+
+void wb_wil_ui_ReleaseProcessLock (void const * const pLockID);
+
+void wb_wil_ui_DestroyProcessLock (void const * const pLockID);
+
 #ifdef __cplusplus
 }
 #endif
@@ -13,6 +13,7 @@
 #include "adi_wil_types.h"
 #include "wbms_cmd_defs.h"
 #include "wb_rsp_generic.h"
+#include "wb_rsp_get_mon_params_crc.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -35,6 +36,12 @@ void wb_wil_HandleUpdateMonParamCommitResponse (adi_wil_pack_internals_t * const
                                                 uint64_t iDeviceId,
                                                 wbms_cmd_resp_generic_t const * const pResponse);
 
+void wb_wil_HandleUpdateMonParamCRCResponse (adi_wil_pack_internals_t * const pInternals,
+                                             wbms_cmd_resp_get_mon_params_crc_t const * const pResponse);
+
+void wb_wil_ProcessUpdateMonitorParameters (adi_wil_pack_internals_t * const pInternals,
+                                            uint32_t iCurrentTime);
+
 #ifdef __cplusplus
 }
 #endif
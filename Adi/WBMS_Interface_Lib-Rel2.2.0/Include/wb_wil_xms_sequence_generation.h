@@ -14,6 +14,7 @@
 #include "wb_wil_xms_type.h"
 #include "wb_wil_msg_header.h"
 #include <stdint.h>
+#include <stdbool.h>
 
 void wb_wil_HandleXmsMeasurement (adi_wil_pack_internals_t * const pInternals,
                                   wb_msg_header_t * const pMsgHeader,
@@ -21,6 +22,12 @@ void wb_wil_HandleXmsMeasurement (adi_wil_pack_internals_t * const pInternals,
                                   uint8_t const * const pData,
                                   uint64_t iDeviceId);
 
+bool wb_wil_HandleBmsMeasurementFast (adi_wil_pack_internals_t * const pInternals,
+                                      uint8_t iSourceDeviceId,
+                                      uint8_t const * const pData,
+                                      uint8_t iLength,
+                                      uint64_t iDeviceId);
+
 void wb_wil_XmsStandbyTransition (adi_wil_pack_internals_t * const pInternals);
 
 #endif  //WB_WIL_XMS_SEQUENCE_GENERATION_H
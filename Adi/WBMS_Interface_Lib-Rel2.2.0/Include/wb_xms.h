@@ -14,6 +14,7 @@
 #include "wb_wil_xms_type.h"
 #include "wb_wil_msg_header.h"
 #include <stdint.h>
+#include <stdbool.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -28,9 +29,19 @@ adi_wil_err_t wb_xms_HandleMeasurement (adi_wil_pack_t const * const pPack,
                                         wb_xms_metadata_t const * const pXmsMetadata,
                                         uint8_t const * const pData);
 
+bool wb_xms_HandleBmsMeasurementFast (adi_wil_pack_t const * const pPack,
+                                      uint8_t iDeviceIndex,
+                                      uint8_t iSequenceNumber,
+                                      bool bStart,
+                                      uint8_t const * const pData,
+                                      uint8_t iLength);
+
 void wb_xms_Flush (adi_wil_pack_t const * const pPack,
                    adi_wil_xms_type_t eType);
 
+void wb_xms_RollOver (adi_wil_pack_t const * const pPack,
+                      adi_wil_xms_type_t eType);
+
 #ifdef __cplusplus
 }
 #endif
@@ -113,6 +113,14 @@ static bool wb_assl_CheckForTimeout (uint32_t iStartTime,
 
 static void wb_assl_IncrementWithRollover8 (uint8_t * pValue);
 
+static void wb_assl_RecordHeartbeatTx (adi_wil_assl_tx_statistics_t * const pStatistics,
+                                       uint32_t iWriteTime,
+                                       uint32_t iCurrentTime);
+
+static void wb_assl_RecordCommandTx (adi_wil_assl_tx_statistics_t * const pStatistics,
+                                     uint32_t iStartTime,
+                                     uint32_t iCurrentTime);
+
 static adi_wil_safety_internals_t * wb_assl_GetSafetyInternalsPointer (adi_wil_pack_t const * const pPack);
 
 /******************************************************************************
@@ -463,6 +471,120 @@ bool wb_assl_GetPendingMessage (adi_wil_pack_t const * const pPack,
     return bMessageAvailable;
 }
 
+uint8_t wb_assl_GetPendingMessages (adi_wil_pack_t const * const pPack,
+                                    uint8_t * pMessages [],
+                                    uint8_t DeviceIds [],
+                                    uint8_t iMaxCount)
+{
+    /* Number of messages returned */
+    uint8_t iCount;
+
+    /* Static variable for retrieving safety internals pointer */
+    adi_wil_safety_internals_t * pInternals;
+
+    /* Retrieve safety internals pointer */
+    pInternals = wb_assl_GetSafetyInternalsPointer (pPack);
+
+    iCount = 0u;
+
+    /* Validate input parameters */
+    if ((pInternals != (void *) 0) && (pMessages != (void *) 0) && (DeviceIds != (void *) 0))
+    {
+        /* User request message goes first, as in wb_assl_GetPendingMessage */
+        if ((iCount < iMaxCount) && pInternals->ASSL.bUserRequestMessageTxReady)
+        {
+            pMessages [iCount] = &pInternals->ASSL.UserRequestMessage [0];
+            DeviceIds [iCount] = pInternals->ASSL.UserRequestState.iDeviceId;
+            iCount++;
+        }
+
+        /* Heartbeat message rides along in the same submission */
+        if ((iCount < iMaxCount) && pInternals->ASSL.bHeartbeatMessageTxReady)
+        {
+            pMessages [iCount] = &pInternals->ASSL.HeartbeatMessage [0];
+            DeviceIds [iCount] = WB_WIL_DEV_ALL_NODES;
+            iCount++;
+        }
+    }
+
+    return iCount;
+}
+
+void wb_assl_RecordTx (adi_wil_pack_t const * const pPack,
+                       uint8_t * const pMessages [],
+                       uint8_t iCount)
+{
+    /* Static variable for retrieving safety internals pointer */
+    adi_wil_safety_internals_t * pInternals;
+
+    /* Time the messages were submitted */
+    uint32_t iCurrentTime;
+
+    /* Retrieve safety internals pointer */
+    pInternals = wb_assl_GetSafetyInternalsPointer (pPack);
+
+    /* Validate input parameters */
+    if ((pInternals != (void *) 0) && (pMessages != (void *) 0))
+    {
+        iCurrentTime = adi_wil_hal_TickerGetTimestamp ();
+
+        for (uint8_t i = 0u; i < iCount; i++)
+        {
+            if (pMessages [i] == &pInternals->ASSL.UserRequestMessage [0])
+            {
+                /* Record the time from posting the command to its
+                 * submission */
+                wb_assl_RecordCommandTx (&pInternals->ASSL.TxStatistics,
+                                         pInternals->ASSL.UserRequestState.iStartTime,
+                                         iCurrentTime);
+            }
+            else if (pMessages [i] == &pInternals->ASSL.HeartbeatMessage [0])
+            {
+                /* Record the heartbeat interval and the time from writing
+                 * the heartbeat to its submission */
+                wb_assl_RecordHeartbeatTx (&pInternals->ASSL.TxStatistics,
+                                           pInternals->ASSL.iHeartbeatTimerStartTime,
+                                           iCurrentTime);
+            }
+            else
+            {
+                /* No statistics for other buffers */
+            }
+        }
+
+        /* Count the submissions that carried more than one message */
+        if (iCount > 1u)
+        {
+            pInternals->ASSL.TxStatistics.iBatchCount++;
+        }
+    }
+}
+
+adi_wil_err_t wb_assl_GetTxStatisticsAPI (adi_wil_safety_internals_t const * const pInternals,
+                                          adi_wil_assl_tx_statistics_t * const pStatistics)
+{
+    /* Return error code */
+    adi_wil_err_t rc;
+
+    /* Validate input parameters */
+    if (((void *) 0 == pInternals) || ((void *) 0 == pStatistics))
+    {
+        rc = ADI_WIL_ERR_INVALID_PARAMETER;
+    }
+    else
+    {
+        /* Copy out the statistics, the process task keeps updating the
+         * internal copy */
+        (void) memcpy (pStatistics,
+                       &pInternals->ASSL.TxStatistics,
+                       sizeof (adi_wil_assl_tx_statistics_t));
+
+        rc = ADI_WIL_ERR_SUCCESS;
+    }
+
+    return rc;
+}
+
 void wb_assl_ReleaseBuffer (adi_wil_pack_t const * const pPack,
                             uint8_t const * const pMessage)
 {
@@ -656,6 +778,10 @@ static void wb_assl_CheckForHeartbeatOffState (adi_wil_safety_internals_t * cons
                                   WB_ASSL_NODE_ALIVE_TIMEOUT)))
     {
         pInternals->ASSL.bHeartbeatTimerOn = false;
+
+        /* The next heartbeat starts a new run, do not count the pause
+         * as jitter */
+        pInternals->ASSL.TxStatistics.bHeartbeatIntervalValid = false;
     }
 }
 
@@ -1283,6 +1409,60 @@ static void wb_assl_IncrementWithRollover8 (uint8_t * pValue)
     }
 }
 
+static void wb_assl_RecordHeartbeatTx (adi_wil_assl_tx_statistics_t * const pStatistics,
+                                       uint32_t iWriteTime,
+                                       uint32_t iCurrentTime)
+{
+    /* Time between this heartbeat and the previous one */
+    uint32_t iInterval;
+
+    /* Deviation of the interval from the heartbeat period */
+    uint32_t iJitter;
+
+    /* Timestamps wrap, unsigned subtraction gives the elapsed time */
+    if ((iCurrentTime - iWriteTime) > pStatistics->iHeartbeatLatencyMax)
+    {
+        pStatistics->iHeartbeatLatencyMax = iCurrentTime - iWriteTime;
+    }
+
+    if (pStatistics->bHeartbeatIntervalValid)
+    {
+        iInterval = iCurrentTime - pStatistics->iLastHeartbeatTxTime;
+
+        iJitter = (iInterval > ADI_WIL_SAFETY_HEARTBEAT_TIME) ?
+                  (iInterval - ADI_WIL_SAFETY_HEARTBEAT_TIME) :
+                  (ADI_WIL_SAFETY_HEARTBEAT_TIME - iInterval);
+
+        if (iJitter > pStatistics->iHeartbeatJitterMax)
+        {
+            pStatistics->iHeartbeatJitterMax = iJitter;
+        }
+    }
+
+    pStatistics->iLastHeartbeatTxTime = iCurrentTime;
+    pStatistics->bHeartbeatIntervalValid = true;
+    pStatistics->iHeartbeatCount++;
+}
+
+static void wb_assl_RecordCommandTx (adi_wil_assl_tx_statistics_t * const pStatistics,
+                                     uint32_t iStartTime,
+                                     uint32_t iCurrentTime)
+{
+    /* Time from posting the command to its submission */
+    uint32_t iLatency;
+
+    /* Timestamps wrap, unsigned subtraction gives the elapsed time */
+    iLatency = iCurrentTime - iStartTime;
+
+    if (iLatency > pStatistics->iCommandLatencyMax)
+    {
+        pStatistics->iCommandLatencyMax = iLatency;
+    }
+
+    pStatistics->iCommandLatencyTotal += iLatency;
+    pStatistics->iCommandCount++;
+}
+
 static adi_wil_safety_internals_t * wb_assl_GetSafetyInternalsPointer (adi_wil_pack_t const * const pPack)
 {
     /* Return value of this method */
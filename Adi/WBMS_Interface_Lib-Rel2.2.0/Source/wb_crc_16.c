@@ -17,6 +17,12 @@
  * Function Definitions
  *****************************************************************************/
 
+/* Runs over every packet header, see wb_crc_ComputeCRC32 */
+#define ADI_WIL_HAL_START_SEC_HOT_CODE
+#include "adi_wil_hal_memmap.h"
+#define ADI_WIL_HAL_START_SEC_FAST_CONST
+#include "adi_wil_hal_memmap.h"
+
 uint16_t wb_crc_ComputeCRC16 (uint8_t const * const pData,
                               uint32_t iLength,
                               uint16_t iSeedValue)
@@ -78,3 +84,8 @@ uint16_t wb_crc_ComputeCRC16 (uint8_t const * const pData,
     /* Return calculated CRC value */
     return (uint16_t) (iValue & 0xFFFFu);
 }
+
+#define ADI_WIL_HAL_STOP_SEC_FAST_CONST
+#include "adi_wil_hal_memmap.h"
+#define ADI_WIL_HAL_STOP_SEC_HOT_CODE
+#include "adi_wil_hal_memmap.h"
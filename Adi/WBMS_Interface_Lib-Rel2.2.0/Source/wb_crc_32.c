@@ -17,6 +17,13 @@
  * Function Definitions
  *****************************************************************************/
 
+/* Runs over every byte of every SPI frame: code in PSPR, table in DSPR
+ * when built with the performance profile */
+#define ADI_WIL_HAL_START_SEC_HOT_CODE
+#include "adi_wil_hal_memmap.h"
+#define ADI_WIL_HAL_START_SEC_FAST_CONST
+#include "adi_wil_hal_memmap.h"
+
 uint32_t wb_crc_ComputeCRC32 (uint8_t const * const pData,
                               uint32_t iLength,
                               uint32_t iSeedValue)
@@ -78,3 +85,8 @@ uint32_t wb_crc_ComputeCRC32 (uint8_t const * const pData,
     /* Return calculated CRC value */
     return iValue;
 }
+
+#define ADI_WIL_HAL_STOP_SEC_FAST_CONST
+#include "adi_wil_hal_memmap.h"
+#define ADI_WIL_HAL_STOP_SEC_HOT_CODE
+#include "adi_wil_hal_memmap.h"
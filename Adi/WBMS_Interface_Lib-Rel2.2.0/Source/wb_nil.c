@@ -14,9 +14,11 @@
 #include "adi_wil_hal_spi.h"
 #include "adi_wil_hal_ticker.h"
 #include "adi_wil_hal_tmr.h"
+#include "adi_wil_hal_trace.h"
 #include "wb_nil_packet.h"
 #include "wb_wil_utils.h"
 #include "wb_wil_query_device.h"
+#include "wb_wil_ui.h"
 #include "wb_wil_ack.h"
 #include "wb_wil_error_notify.h"
 #include "wb_crc_32.h"
@@ -24,6 +26,7 @@
 
 /* Structure definition headers */
 #include "adi_wil_port.h"
+#include "adi_wil_pack_internals.h"
 
 /* Standard library headers */
 #include <string.h>
@@ -184,6 +187,17 @@ adi_wil_err_t wb_nil_Terminate (void)
     }
     else
     {
+        /* Destroy the process locks of every registered port and its pack,
+         * so a process task run after terminating reports not connected */
+        for (uint8_t i = 0u; i < ADI_WIL_MAX_PORTS; i++)
+        {
+            if (bInUseList [i] && ((void *) 0 != DeviceList [i]))
+            {
+                wb_wil_ui_DestroyProcessLock (DeviceList [i]->Internals.pPackInternals);
+                wb_wil_ui_DestroyProcessLock (DeviceList [i]);
+            }
+        }
+
         /* Zero the list of in-use flags */
         (void) memset (&bInUseList [0], 0, sizeof (bInUseList));
 
@@ -239,14 +253,18 @@ void wb_nil_ProcessAllPorts (void)
         /* If an entry is non-null and in-use, select it */
         if (bInUseList [i] && ((void *) 0 != DeviceList [i]))
         {
-            /* If an entry is currently performing a QueryDevice operation, process it */
-            if (DeviceList [i]->Internals.QueryDeviceState.bInProgress)
+            /* If an entry is currently performing a QueryDevice operation,
+             * process it unless another process task already is */
+            if (DeviceList [i]->Internals.QueryDeviceState.bInProgress &&
+                (ADI_WIL_ERR_SUCCESS == wb_wil_ui_AcquireProcessLock (DeviceList [i])))
             {
                 /* Process any Rx frames */
                 (void) wb_nil_Process (DeviceList [i]);
 
                 /* Check for any query device timeouts */
                 wb_wil_QueryDeviceCheckTimeout (DeviceList [i]);
+
+                wb_wil_ui_ReleaseProcessLock (DeviceList [i]);
             }
         }
     }
@@ -703,6 +721,8 @@ static void wb_nil_Transmit (adi_wil_port_t * const pPort)
             /* Increment the transmission count */
             wb_wil_IncrementWithRollover32 (&pPort->Internals.PortStatistics.iTxFrameCount);
 
+            ADI_WIL_HAL_TRACE (ADI_WIL_HAL_TRACE_EVT_FRAME_TX, pPort->iSPIDevice, pPort->Internals.pTx [0u]);
+
             /* Flag this port as having successfully transmitted */
             pPort->Internals.bTransmitted = true;
 
@@ -777,6 +797,11 @@ static void wb_wil_SetupRxTransmission (adi_wil_port_internal_t * const pInterna
     }
 }
 
+/* Receive path, run for every frame read from the managers: executed from
+ * PSPR0 under the performance profile */
+#define ADI_WIL_HAL_START_SEC_HOT_CODE
+#include "adi_wil_hal_memmap.h"
+
 static void wb_nil_ReadFrame (adi_wil_port_t * const pPort,
                               uint8_t * const pData)
 {
@@ -790,6 +815,10 @@ static void wb_nil_ReadFrame (adi_wil_port_t * const pPort,
     iPayloadLength = pData [0];
     iSessionId = pData [WBMS_FRAME_SESSION_ID_OFFSET];
 
+    ADI_WIL_HAL_TRACE (ADI_WIL_HAL_TRACE_EVT_FRAME_RX, pPort->iSPIDevice, iPayloadLength);
+
+    ADI_WIL_HAL_PROFILE_BEGIN (ADI_WIL_HAL_PROFILE_NIL_READ_FRAME);
+
     /* Check if the frame is an idle frame... */
     if (iPayloadLength == 0u)
     {
@@ -851,6 +880,8 @@ static void wb_nil_ReadFrame (adi_wil_port_t * const pPort,
         /* Process the frame payload as a "logged in" frame */
         wb_nil_ProcessFramePayload (pPort, iPayloadLength, pData, true);
     }
+
+    ADI_WIL_HAL_PROFILE_END (ADI_WIL_HAL_PROFILE_NIL_READ_FRAME);
 }
 
 static bool wb_nil_ValidateFrameMetadata (uint8_t const * const pData,
@@ -866,6 +897,8 @@ static bool wb_nil_ValidateFrameMetadata (uint8_t const * const pData,
     iComputedCRC = 0u;
     iExtractedCRC = 0u;
 
+    ADI_WIL_HAL_PROFILE_BEGIN (ADI_WIL_HAL_PROFILE_NIL_VALIDATE_FRAME);
+
     if (iPayloadLength <= WBMS_FRAME_PAYLOAD_MAX_SIZE)
     {
         /* Calculate the CRC over the header and payload */
@@ -880,6 +913,8 @@ static bool wb_nil_ValidateFrameMetadata (uint8_t const * const pData,
                          (((pData [WBMS_FRAME_CRC_OFFSET + 3u] & 0xFFFFFFFFu) << 0u)  & 0x0000000FFu)) & 0xFFFFFFFFu;
     }
 
+    ADI_WIL_HAL_PROFILE_END (ADI_WIL_HAL_PROFILE_NIL_VALIDATE_FRAME);
+
     /* Return true if the payload was in range and the two values match */
     return ((iPayloadLength <= WBMS_FRAME_PAYLOAD_MAX_SIZE) &&
             (iComputedCRC == iExtractedCRC));
@@ -893,6 +928,10 @@ static void wb_nil_ProcessFramePayload (adi_wil_port_t * const pPort,
     uint32_t iProcessedBytes;
     uint8_t iMessageId;
     uint8_t iMessageLength;
+#if defined(ADI_WIL_BMS_FAST_PATH_ENABLE)
+    adi_wil_pack_internals_t * pPackInternals;
+    uint64_t iManagerId;
+#endif
 
     /* Initialize element manually for extra speed */
     wb_pack_element_t Element = { .data = 0u,
@@ -907,9 +946,23 @@ static void wb_nil_ProcessFramePayload (adi_wil_port_t * const pPort,
     Element.origin = &pData [WBMS_FRAME_HDR_LEN];
     Element.packer.buf = &pData [WBMS_FRAME_HDR_LEN];
 
+    ADI_WIL_HAL_PROFILE_BEGIN (ADI_WIL_HAL_PROFILE_NIL_PROCESS_FRAME);
+
     /* Init number of processed bytes to 0 */
     iProcessedBytes = 0u;
 
+#if defined(ADI_WIL_BMS_FAST_PATH_ENABLE)
+    /* Resolve the pack and the sending manager once per frame rather than
+     * once per packet */
+    pPackInternals = pPort->Internals.pPackInternals;
+    iManagerId = ADI_WIL_DEV_MANAGER_1;
+
+    if (((void *) 0 != pPackInternals) && (pPort == pPackInternals->pManager0Port))
+    {
+        iManagerId = ADI_WIL_DEV_MANAGER_0;
+    }
+#endif
+
     /* Validate the payload length */
     if ((iPayloadLength > 0u) &&
         (iPayloadLength <= WBMS_FRAME_PAYLOAD_MAX_SIZE))
@@ -944,7 +997,20 @@ static void wb_nil_ProcessFramePayload (adi_wil_port_t * const pPort,
                  * sent with a logged out or logged in session ID */
                 if (bLoggedInFrame)
                 {
+#if defined(ADI_WIL_BMS_FAST_PATH_ENABLE)
+                    /* Measurement data arrives in packet received
+                     * notifications, skip the generic dispatch for them */
+                    if ((WBMS_NOTIF_PACKET_RECIEVED == iMessageId) && ((void *) 0 != pPackInternals))
+                    {
+                        wb_nil_packet_ProcessPacketReceived (pPackInternals, iManagerId, &Element);
+                    }
+                    else
+                    {
+                        (void) wb_nil_packet_Process (pPort, &Element, iMessageId);
+                    }
+#else
                     (void) wb_nil_packet_Process (pPort, &Element, iMessageId);
+#endif
                 }
                 else
                 {
@@ -956,6 +1022,8 @@ static void wb_nil_ProcessFramePayload (adi_wil_port_t * const pPort,
             }
         }
     }
+
+    ADI_WIL_HAL_PROFILE_END (ADI_WIL_HAL_PROFILE_NIL_PROCESS_FRAME);
 }
 
 static void wb_nil_ReleaseFrame (adi_wil_port_t * const pPort,
@@ -976,6 +1044,9 @@ static void wb_nil_ReleaseFrame (adi_wil_port_t * const pPort,
     }
 }
 
+#define ADI_WIL_HAL_STOP_SEC_HOT_CODE
+#include "adi_wil_hal_memmap.h"
+
 static void wb_nil_TimerCb (void)
 {
     /* Only perform activity if ISRs are enabled*/
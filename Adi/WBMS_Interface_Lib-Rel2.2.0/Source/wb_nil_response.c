@@ -80,6 +80,7 @@
 #include "wb_scl.h"
 #include "wb_wil_dmh.h"
 #include "wb_assl.h"
+#include "wb_wil_port_select.h"
 #include <string.h>
 
 /******************************************************************************
@@ -96,7 +97,7 @@ static void wb_nil_HandleSetModeResponse (adi_wil_pack_internals_t * const pInte
 static void wb_nil_HandleSetACLResponse (adi_wil_pack_internals_t * const pInternals, wb_pack_element_t * pElement);
 static void wb_nil_HandleClearACLResponse (adi_wil_pack_internals_t * const pInternals, wb_pack_element_t * pElement);
 static void wb_nil_HandleGetACLResponse (adi_wil_pack_internals_t * const pInternals, wb_pack_element_t * pElement);
-static void wb_nil_HandleSendDataResponse (adi_wil_pack_internals_t * const pInternals, wb_pack_element_t * pElement);
+static void wb_nil_HandleSendDataResponse (adi_wil_pack_internals_t * const pInternals, uint64_t iDeviceId, wb_pack_element_t * pElement);
 static void wb_nil_HandleRotateKeyResponse (adi_wil_pack_internals_t * const pInternals, wb_pack_element_t * pElement);
 static void wb_nil_HandleFaultServiceResponse (adi_wil_pack_internals_t * const pInternals, uint64_t iDeviceId, wb_pack_element_t * pElement);
 static void wb_nil_HandleQueryDeviceResponse (adi_wil_port_t * const pPort, wb_pack_element_t * pElement);
@@ -182,7 +183,7 @@ adi_wil_err_t wb_nil_packet_Process (adi_wil_port_t * const pPort, wb_pack_eleme
                 break;
             /*  Handle for the command, send data */
             case WBMS_CMD_SEND_DATA:
-                wb_nil_HandleSendDataResponse (pPort->Internals.pPackInternals, pElement);
+                wb_nil_HandleSendDataResponse (pPort->Internals.pPackInternals, iDeviceId, pElement);
                 break;
             /*  Handle ACL cases: setting, clearing and getting ACL */
             case WBMS_CMD_CLEAR_ACL:
@@ -265,12 +266,20 @@ adi_wil_err_t wb_nil_packet_Process (adi_wil_port_t * const pPort, wb_pack_eleme
     return rc;
 }
 
+void wb_nil_packet_ProcessPacketReceived (adi_wil_pack_internals_t * const pInternals, uint64_t iDeviceId, wb_pack_element_t * const pElement)
+{
+    /* Caller has validated the pack internals and resolved the manager for
+     * the whole frame */
+    wb_nil_HandlePacketReceivedNotif (pInternals, iDeviceId, pElement);
+}
+
 static void wb_nil_HandlePacketReceivedNotif (adi_wil_pack_internals_t * const pInternals, uint64_t iDeviceId, wb_pack_element_t * const pElement)
 {
     wbms_notif_packet_received_t obj = { 0 };
     uint8_t * pData;
     wb_msg_header_t MsgHeader;
     wb_xms_metadata_t XmsMetadata;
+    bool bStored;
 
     /* Only proceed if size is within limits */
     if (pElement->size >= WBMS_CMD_NOTIF_PACKET_RECEIVED_LEN)
@@ -292,10 +301,20 @@ static void wb_nil_HandlePacketReceivedNotif (adi_wil_pack_internals_t * const p
                     break;
 
                 case WB_BMS_PORT_ID:
-                    MsgHeader.iPayloadLength = (uint8_t) (obj.iLength & (uint8_t)0xFF);
-                    MsgHeader.iSourceDeviceId = obj.iDeviceId;
-                    XmsMetadata.eType = ADI_WIL_XMS_BMS;
-                    wb_wil_HandleXmsMeasurement (pInternals, &MsgHeader, &XmsMetadata, pData, iDeviceId);
+#if defined(ADI_WIL_BMS_FAST_PATH_ENABLE)
+                    /* Steady state packets are written straight into their
+                     * slot, anything else takes the generic path */
+                    bStored = wb_wil_HandleBmsMeasurementFast (pInternals, obj.iDeviceId, pData, (uint8_t) (obj.iLength & (uint8_t)0xFF), iDeviceId);
+#else
+                    bStored = false;
+#endif
+                    if (!bStored)
+                    {
+                        MsgHeader.iPayloadLength = (uint8_t) (obj.iLength & (uint8_t)0xFF);
+                        MsgHeader.iSourceDeviceId = obj.iDeviceId;
+                        XmsMetadata.eType = ADI_WIL_XMS_BMS;
+                        wb_wil_HandleXmsMeasurement (pInternals, &MsgHeader, &XmsMetadata, pData, iDeviceId);
+                    }
                     break;
 
                 case WB_SCL_PORT_ID:
@@ -678,10 +697,13 @@ static void wb_nil_HandleGetContextualResponse (adi_wil_pack_internals_t * const
     }
 }
 
-static void wb_nil_HandleSendDataResponse (adi_wil_pack_internals_t * const pInternals, wb_pack_element_t * pElement)
+static void wb_nil_HandleSendDataResponse (adi_wil_pack_internals_t * const pInternals, uint64_t iDeviceId, wb_pack_element_t * pElement)
 {
     wbms_cmd_resp_generic_t obj = { 0 };
 
+    /* The manager has answered a request the port selection sent to it */
+    wb_wil_PortSelectRecordResponse (pInternals, iDeviceId);
+
     /* Validate size before proceeding */
     if (pElement->size >= WBMS_CMD_RESP_GENERIC_LEN)
     {
@@ -13,6 +13,7 @@
 #include "adi_wil_pack.h"
 #include "wb_assl_fusa.h"
 #include "wb_wil_msg_header.h"
+#include "adi_wil_hal_trace.h"
 #include <string.h>
 
 /******************************************************************************
@@ -166,6 +167,12 @@ bool wb_scl_WrapSCLFrame (wb_msg_header_t const * const pMsgHeader,
  *  Static function definitions
  *****************************************************************************/
 
+/* The 21-bit CRC runs over every SCL frame in both directions */
+#define ADI_WIL_HAL_START_SEC_HOT_CODE
+#include "adi_wil_hal_memmap.h"
+#define ADI_WIL_HAL_START_SEC_FAST_CONST
+#include "adi_wil_hal_memmap.h"
+
 static bool wb_scl_ValidateCrc (uint8_t const * const pBuffer,
                                 uint8_t iLength)
 {
@@ -236,6 +243,8 @@ static void wb_scl_ComputeCrc (uint8_t const * const pBuffer,
     /* Computed 21-bit CRC value */
     uint32_t iCrcValue;
 
+    ADI_WIL_HAL_PROFILE_BEGIN (ADI_WIL_HAL_PROFILE_SCL_COMPUTE_CRC);
+
     /* Initialize the CRC value with the initial seed */
     iCrcValue = WB_SCL_CRC_INITIAL_SEED_VALUE;
 
@@ -252,6 +261,8 @@ static void wb_scl_ComputeCrc (uint8_t const * const pBuffer,
 
     /* Reverse the bits in the CRC to produce corrected CRC value*/
     *pCrc = wb_scl_BitReverseCrc (iCrcValue);
+
+    ADI_WIL_HAL_PROFILE_END (ADI_WIL_HAL_PROFILE_SCL_COMPUTE_CRC);
 }
 
 static void wb_scl_PackCrc (uint8_t * const pBuffer, uint32_t const * const pCrc)
@@ -272,6 +283,11 @@ static void wb_scl_UnpackCrc (uint8_t const * const pBuffer, uint32_t * const pC
              ((((uint32_t) pBuffer [3]) << 0u) & 0x000000ffu));
 }
 
+#define ADI_WIL_HAL_STOP_SEC_FAST_CONST
+#include "adi_wil_hal_memmap.h"
+#define ADI_WIL_HAL_STOP_SEC_HOT_CODE
+#include "adi_wil_hal_memmap.h"
+
 static adi_wil_safety_internals_t * wb_scl_GetSafetyInternalsPointer (adi_wil_pack_t const * const pPack)
 {
     /* Return value of this method */
@@ -372,6 +388,11 @@ static bool wb_scl_ValidateHandleSCLFrameParameters (adi_wil_safety_internals_t
             (iLength <= WB_SCL_FRAME_LEN_MAX));
 }
 
+#define ADI_WIL_HAL_START_SEC_HOT_CODE
+#include "adi_wil_hal_memmap.h"
+#define ADI_WIL_HAL_START_SEC_FAST_CONST
+#include "adi_wil_hal_memmap.h"
+
 static uint32_t wb_scl_BitReverseCrc (uint32_t iCrc)
 {
     /* Look-up table containing the inverted bits for each possible value */
@@ -418,3 +439,8 @@ static uint32_t wb_scl_BitReverseCrc (uint32_t iCrc)
             (BitReverseLUT [(iCrc >> 16u) & 0xFFu] << 8u) |
             (BitReverseLUT [(iCrc >> 24u) & 0xFFu] << 0u));
 }
+
+#define ADI_WIL_HAL_STOP_SEC_FAST_CONST
+#include "adi_wil_hal_memmap.h"
+#define ADI_WIL_HAL_STOP_SEC_HOT_CODE
+#include "adi_wil_hal_memmap.h"
@@ -15,6 +15,7 @@
 #include "wb_wil_utils.h"
 #include "adi_wil_osal.h"
 #include "adi_wil_pack_internals.h"
+#include "wb_wil_request_context.h"
 #include <stdint.h>
 
 /******************************************************************************
@@ -162,6 +163,7 @@ adi_wil_err_t adi_wil_CheckFileType (adi_wil_pack_internals_t const * const pInt
 adi_wil_err_t wb_wil_api_StartTimer (adi_wil_pack_internals_t * const pInternals, uint16_t * const pToken, uint32_t iTimeout)
 {
     adi_wil_err_t rc;
+    adi_wil_cmd_state_t * pState;
 
     /* Validate input params */
     if (((void *) 0 == pInternals) || ((void *) 0 == pToken))
@@ -177,11 +179,14 @@ adi_wil_err_t wb_wil_api_StartTimer (adi_wil_pack_internals_t * const pInternals
     }
     else
     {
-        pInternals->UserRequestState.iStartTime = adi_wil_hal_TickerGetTimestamp ();
-        pInternals->UserRequestState.iTimeout = iTimeout;
-        pInternals->UserRequestState.bValid = true;
+        /* Time the concurrent request context being transmitted, if any */
+        pState = wb_wil_GetSubmittingRequestState (pInternals);
 
-        *pToken = pInternals->UserRequestState.iToken;
+        pState->iStartTime = adi_wil_hal_TickerGetTimestamp ();
+        pState->iTimeout = iTimeout;
+        pState->bValid = true;
+
+        *pToken = pState->iToken;
 
         rc = ADI_WIL_ERR_SUCCESS;
     }
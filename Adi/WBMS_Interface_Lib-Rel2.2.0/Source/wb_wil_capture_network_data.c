@@ -15,6 +15,7 @@
 #include "adi_wil_pack_internals.h"
 #include "wb_wil_api.h"
 #include "wb_wil_ui.h"
+#include "wb_wil_port_select.h"
 
 #include <string.h>
 #include <stdbool.h>
@@ -77,6 +78,9 @@ void wb_wil_NetworkDataNotify (adi_wil_pack_internals_t * const pInternals, uint
          * received */
         wb_wil_IncrementWithRollover32 (&pInternals->Stats.NetworkPktStats.iPktReceivedCount);
 
+        /* Track the node's link through this manager for the port selection */
+        wb_wil_PortSelectRecordLink (pInternals, iDeviceId, pElement->iDeviceId, pElement->iRSSI);
+
         if ((pInternals->NetDataBuffer.iDataBufferCount != 0u) && (pInternals->NetDataBuffer.pData != (void *) 0))
         {
             pNetData = &pInternals->NetDataBuffer.pData [pInternals->NetDataBuffer.iCount];
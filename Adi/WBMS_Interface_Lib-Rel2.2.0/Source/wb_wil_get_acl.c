@@ -12,6 +12,7 @@
  *****************************************************************************/
 
 #include "wb_wil_get_acl.h"
+#include "wb_wil_set_acl.h"
 #include "wb_wil_ui.h"
 #include "wb_wil_request.h"
 #include "wb_req_get_acl.h"
@@ -157,7 +158,12 @@ static void wb_wil_GetACLFunc (adi_wil_pack_internals_t * const pInternals)
 
 void wb_wil_HandleGetACLResponse (adi_wil_pack_internals_t * const pInternals, wbms_cmd_resp_get_acl_t const * const pResponse, uint8_t const * const pData)
 {
-    if (ADI_WIL_ERR_SUCCESS != wb_wil_api_CheckToken (pInternals, pResponse->iToken, true))
+    if (pInternals->SetACLState.bComparing)
+    {
+        /* Set ACL is reading the manager ACL back to compare it */
+        wb_wil_HandleSetACLCompareResponse (pInternals, pResponse, pData);
+    }
+    else if (ADI_WIL_ERR_SUCCESS != wb_wil_api_CheckToken (pInternals, pResponse->iToken, true))
     {
         /* Do nothing, there is no active request with this token */
     }
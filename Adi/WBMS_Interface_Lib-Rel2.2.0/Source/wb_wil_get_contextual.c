@@ -14,7 +14,7 @@
 #include "wb_rsp_get_contextual.h"
 #include "adi_wil_contextual_data.h"
 #include "adi_wil_pack_internals.h"
-#include "wb_wil_ui.h"
+#include "wb_wil_request_context.h"
 #include "wb_wil_utils.h"
 #include "wb_wil_api.h"
 #include <string.h>
@@ -23,8 +23,7 @@
  * Static functions
  *****************************************************************************/
 
-static void wb_wil_GetContextualFunc (adi_wil_pack_internals_t * const pInternals);
-static void wb_wil_GetContextualComplete (adi_wil_pack_internals_t * const pInternals, adi_wil_err_t rc);
+static void wb_wil_GetContextualFunc (adi_wil_pack_internals_t * const pInternals, adi_wil_request_context_t * const pContext);
 
 /******************************************************************************
  * Public functions
@@ -38,18 +37,25 @@ adi_wil_err_t wb_wil_GetContextualDataAPI (adi_wil_pack_internals_t * const pInt
     const adi_wil_mode_t ValidModes[] = { ADI_WIL_MODE_STANDBY };
     const adi_wil_target_t ValidTargets[] = { ADI_WIL_TARGET_SINGLE_MANAGER, ADI_WIL_TARGET_SINGLE_NODE };
     uint8_t iContextualId;
-    bool bReleaseLock;
-    
+    adi_wil_request_context_t * pContext;
+
     /* Initialize local variables */
     iContextualId = 0u;
-    bReleaseLock = false;
+    pContext = (void *) 0;
 
     rc = adi_wil_ValidateInstance (pInternals, true);
 
-    /* Acquire lock */
     if (ADI_WIL_ERR_SUCCESS == rc)
     {
-        rc = wb_wil_ui_AcquireLock (pInternals->pPack, pInternals->pPack);
+        /* Map contextual type from adi_wil_contextual_id_t to uint8_t* */
+        rc = wb_wil_ContextualIDToUint (eContextualDataId, &iContextualId);
+    }
+
+    /* Acquire a request context - runs concurrently with requests to other
+     * devices. The contextual ID is carried in the context for retries */
+    if (ADI_WIL_ERR_SUCCESS == rc)
+    {
+        rc = wb_wil_AcquireRequestContext (pInternals, ADI_WIL_API_GET_CONTEXTUAL_DATA, iDeviceId, iContextualId, (sizeof (ValidTargets) / sizeof (adi_wil_target_t)), ValidTargets, &wb_wil_GetContextualFunc, &pContext);
     }
 
     if (ADI_WIL_ERR_SUCCESS == rc)
@@ -59,79 +65,63 @@ adi_wil_err_t wb_wil_GetContextualDataAPI (adi_wil_pack_internals_t * const pInt
 
         if (ADI_WIL_ERR_SUCCESS == rc)
         {
-            /* Map contextual type from adi_wil_contextual_id_t to uint8_t* */
-            rc = wb_wil_ContextualIDToUint (eContextualDataId, &iContextualId);
-        }
-
-        if (ADI_WIL_ERR_SUCCESS == rc)
-        {
-            /* Set-up the correct bit-mask to prepare for a new packet
-             * request generation */
-            rc = wb_wil_SetupRequest (pInternals, iDeviceId, (sizeof (ValidTargets) / sizeof (adi_wil_target_t)), ValidTargets, &wb_wil_GetContextualFunc);
-        }
-
-        if (ADI_WIL_ERR_SUCCESS == rc)
-        {
-            /* Initialize the internal variables required to send the request
-             * packet */
-            pInternals->ContextualState.iContextualId = iContextualId;
-            (void) memset (&pInternals->ContextualState.ContextualData.Data [0], 0, ADI_WIL_CONTEXTUAL_DATA_SIZE);
-
-            /* Send 'get contextual data' request packet */
-            wb_wil_GetContextualFunc (pInternals);
+            /* Queue 'get contextual data' request packet for the process
+             * task */
+            wb_wil_QueueRequestContext (pContext);
         }
-
-        /* Release mutex if any of the above steps returns a failure */
-        if (ADI_WIL_ERR_SUCCESS != rc)
+        else
         {
-            bReleaseLock = true;
+            /* Release the context if any of the above steps returns a failure */
+            wb_wil_ReleaseRequestContext (pInternals, pContext);
         }
     }
 
-    if (bReleaseLock)
-    {
-        wb_wil_ui_ReleaseLock (pInternals->pPack, pInternals->pPack);
-    }
-
     return rc;
 }
 
 void wb_wil_HandleGetContextualResponse (adi_wil_pack_internals_t * const pInternals, uint64_t iDeviceId, wbms_cmd_resp_get_contextual_t const * const pResponse, void const * const pData)
 {
+    adi_wil_request_context_t * pContext;
+
     (void) iDeviceId;
 
-    if (ADI_WIL_ERR_SUCCESS != wb_wil_api_CheckToken (pInternals, pResponse->iToken, true))
+    pContext = wb_wil_FindRequestContext (pInternals, pResponse->iToken);
+
+    if ((void *) 0 == pContext)
     {
         /* Do nothing, there is no active request with this token */
     }
     else if (WBMS_CMD_RC_WAIT == pResponse->rc)
     {
-        /* End device has responded with a WAIT. So, resend the
-         * 'Get Contextual' packet */
-        wb_wil_GetContextualFunc (pInternals);
+        /* End device has responded with a WAIT. So, queue the
+         * 'Get Contextual' packet to be resent */
+        wb_wil_QueueRequestContext (pContext);
     }
     else if (WBMS_CMD_RC_SUCCESS != pResponse->rc)
     {
         /* End device has responded with neither a WAIT, nor a SUCCESS.
          * Complete the 'Get Contextual' API with the return code received from
          * the end device */
-        wb_wil_GetContextualComplete (pInternals, wb_wil_GetErrFromUint (pResponse->rc));
+        wb_wil_CompleteRequestContext (pInternals, pContext, wb_wil_GetErrFromUint (pResponse->rc), (void *) 0);
     }
     else if (ADI_WIL_CONTEXTUAL_DATA_SIZE < pResponse->iLength)
     {
         /* End device has responded with a size that is out of limits.
          * Complete the 'Get Contextual' API with a return code of INVALID
          * PARAMETER */
-        wb_wil_GetContextualComplete (pInternals, ADI_WIL_ERR_INVALID_PARAMETER);
+        wb_wil_CompleteRequestContext (pInternals, pContext, ADI_WIL_ERR_INVALID_PARAMETER, (void *) 0);
     }
     else
     {
+        /* The callback is generated before the next response is handled, so
+         * the contextual state can be shared by all contexts */
+        (void) memset (&pInternals->ContextualState.ContextualData.Data [0], 0, ADI_WIL_CONTEXTUAL_DATA_SIZE);
         pInternals->ContextualState.ContextualData.iLength = pResponse->iLength;
         (void) memcpy (&pInternals->ContextualState.ContextualData.Data [0], pData, pResponse->iLength);
 
         /* End device has responded with a return code of SUCCESS.
          * Complete the 'Get Contextual' API with a return code of SUCCESS */
-        wb_wil_GetContextualComplete (pInternals, ADI_WIL_ERR_SUCCESS);
+        wb_wil_CompleteRequestContext (pInternals, pContext, ADI_WIL_ERR_SUCCESS, (void *) &pInternals->ContextualState.ContextualData);
     }
 }
 
@@ -139,47 +129,25 @@ void wb_wil_HandleGetContextualResponse (adi_wil_pack_internals_t * const pInter
  * Static functions
  *****************************************************************************/
 
-static void wb_wil_GetContextualFunc (adi_wil_pack_internals_t * const pInternals)
+static void wb_wil_GetContextualFunc (adi_wil_pack_internals_t * const pInternals, adi_wil_request_context_t * const pContext)
 {
     wbms_cmd_req_get_contextual_t Request;
 
     /* Initialize request structure */
     (void) memset (&Request, 0, sizeof (Request));
 
+    Request.iContextualId = pContext->iParameter;
 
-    Request.iContextualId = pInternals->ContextualState.iContextualId;
-
-    if (pInternals->UserRequestState.iRetries >= ADI_WIL_RETRIES)
+    if (pContext->Request.iRetries >= ADI_WIL_RETRIES)
     {
-        wb_wil_GetContextualComplete (pInternals, ADI_WIL_ERR_TIMEOUT);
+        wb_wil_CompleteRequestContext (pInternals, pContext, ADI_WIL_ERR_TIMEOUT, (void *) 0);
     }
     else if (ADI_WIL_ERR_SUCCESS != wb_wil_GetContextualRequest (pInternals, &Request, ADI_WIL_RESPONSE_TIMEOUT_MS))
     {
-        wb_wil_GetContextualComplete (pInternals, ADI_WIL_ERR_FAIL);
+        wb_wil_CompleteRequestContext (pInternals, pContext, ADI_WIL_ERR_FAIL, (void *) 0);
     }
     else
     {
         /* MISRA Else */
     }
 }
-
-static void wb_wil_GetContextualComplete (adi_wil_pack_internals_t * const pInternals, adi_wil_err_t rc)
-{
-    /* Clear the valid flag since this API is completed */
-    pInternals->UserRequestState.bValid = false;
-    pInternals->UserRequestState.pfRequestFunc = (void *) 0;
-
-    if (ADI_WIL_ERR_SUCCESS == rc)
-    {
-        /* Generate a callback with the correct response pointer */
-        wb_wil_ui_GenerateCb (pInternals->pPack, ADI_WIL_API_GET_CONTEXTUAL_DATA, rc, (void *) &pInternals->ContextualState.ContextualData);
-    }
-    else
-    {
-        /* Because return code is not a success, return null as a response */
-        wb_wil_ui_GenerateCb (pInternals->pPack, ADI_WIL_API_GET_CONTEXTUAL_DATA, rc, (void *) 0);
-    }
-
-    /* Release lock */
-    wb_wil_ui_ReleaseLock (pInternals->pPack, pInternals->pPack);
-}
@@ -9,19 +9,38 @@
 
 #include "wb_wil_get_file.h"
 #include "wb_wil_request.h"
+#include "wb_wil_request_context.h"
 #include "wb_req_get_file.h"
 #include "wb_rsp_get_file.h"
+#include "wb_req_get_file_crc.h"
+#include "wb_rsp_get_file_crc.h"
 #include "adi_wil_pack_internals.h"
 #include "wb_wil_ui.h"
 #include "adi_wil_file.h"
 #include "wb_wil_utils.h"
 #include "wb_wil_api.h"
+#include "wb_crc_32.h"
+#include "wb_crc_config.h"
 #include <string.h>
 
+/******************************************************************************
+ * Static variables
+ *****************************************************************************/
+
+static const adi_wil_file_type_t wb_wil_GetFileManagerFileTypes[] = { ADI_WIL_FILE_TYPE_PMS_CONTAINER, ADI_WIL_FILE_TYPE_EMS_CONTAINER, ADI_WIL_FILE_TYPE_CONFIGURATION,
+                                                                      ADI_WIL_FILE_TYPE_BLACK_BOX_LOG, ADI_WIL_FILE_TYPE_ENV_MON };
+
+static const adi_wil_file_type_t wb_wil_GetFileNodeFileTypes[] = { ADI_WIL_FILE_TYPE_BMS_CONTAINER, ADI_WIL_FILE_TYPE_PMS_CONTAINER, ADI_WIL_FILE_TYPE_EMS_CONTAINER,
+                                                                   ADI_WIL_FILE_TYPE_CONFIGURATION, ADI_WIL_FILE_TYPE_BLACK_BOX_LOG, ADI_WIL_FILE_TYPE_INVENTORY_LOG, ADI_WIL_FILE_TYPE_ENV_MON };
+
 /******************************************************************************
  * Static functions
  *****************************************************************************/
 
+static adi_wil_err_t wb_wil_GetFileCheckFileType (adi_wil_pack_internals_t const * const pInternals, adi_wil_target_t eTarget, adi_wil_file_type_t eFileType);
+static adi_wil_get_file_stream_t * wb_wil_GetFileStreamState (adi_wil_pack_internals_t * const pInternals, adi_wil_request_context_t const * const pContext);
+static void wb_wil_GetFileStreamContextFunc (adi_wil_pack_internals_t * const pInternals, adi_wil_request_context_t * const pContext);
+static void wb_wil_HandleGetFileStreamResponse (adi_wil_pack_internals_t * const pInternals, adi_wil_request_context_t * const pContext, wbms_cmd_resp_get_file_t const * const pResponse, uint8_t * const pData);
 static void wb_wil_GetFileFunc (adi_wil_pack_internals_t * const pInternals);
 static void wb_wil_GetFileComplete (adi_wil_pack_internals_t * const pInternals, adi_wil_err_t rc, adi_wil_file_t const * const pData);
 
@@ -36,10 +55,6 @@ adi_wil_err_t wb_wil_GetFileAPI (adi_wil_pack_internals_t * const pInternals,
     adi_wil_err_t rc;
     const adi_wil_mode_t ValidModes[] = { ADI_WIL_MODE_STANDBY };
     const adi_wil_target_t ValidTargets[] = { ADI_WIL_TARGET_SINGLE_NODE, ADI_WIL_TARGET_SINGLE_MANAGER };
-    const adi_wil_file_type_t ValidManagerFileTypes[] = { ADI_WIL_FILE_TYPE_PMS_CONTAINER, ADI_WIL_FILE_TYPE_EMS_CONTAINER, ADI_WIL_FILE_TYPE_CONFIGURATION, 
-                                                          ADI_WIL_FILE_TYPE_BLACK_BOX_LOG, ADI_WIL_FILE_TYPE_ENV_MON };
-    const adi_wil_file_type_t ValidNodeFileTypes[] = { ADI_WIL_FILE_TYPE_BMS_CONTAINER, ADI_WIL_FILE_TYPE_PMS_CONTAINER, ADI_WIL_FILE_TYPE_EMS_CONTAINER, 
-                                                       ADI_WIL_FILE_TYPE_CONFIGURATION, ADI_WIL_FILE_TYPE_BLACK_BOX_LOG, ADI_WIL_FILE_TYPE_INVENTORY_LOG, ADI_WIL_FILE_TYPE_ENV_MON };
 
     bool bReleaseLock;
 
@@ -71,16 +86,10 @@ adi_wil_err_t wb_wil_GetFileAPI (adi_wil_pack_internals_t * const pInternals,
             rc = wb_wil_SetupRequest (pInternals, iDeviceId, (sizeof (ValidTargets) / sizeof (adi_wil_target_t)), ValidTargets, &wb_wil_GetFileFunc);
         }
 
-        /* Validate file type for manager */
-        if ((ADI_WIL_ERR_SUCCESS == rc) && (ADI_WIL_TARGET_SINGLE_MANAGER == pInternals->UserRequestState.eTarget))
-        {
-            rc = adi_wil_CheckFileType (pInternals, eFileType, (sizeof (ValidManagerFileTypes) / sizeof (adi_wil_file_type_t)), ValidManagerFileTypes);
-        }
-
-        /* Validate file type for node */
-        if ((ADI_WIL_ERR_SUCCESS == rc) && (ADI_WIL_TARGET_SINGLE_NODE == pInternals->UserRequestState.eTarget))
+        /* Validate file type for the target */
+        if (ADI_WIL_ERR_SUCCESS == rc)
         {
-            rc = adi_wil_CheckFileType (pInternals, eFileType, (sizeof (ValidNodeFileTypes) / sizeof (adi_wil_file_type_t)), ValidNodeFileTypes);
+            rc = wb_wil_GetFileCheckFileType (pInternals, pInternals->UserRequestState.eTarget, eFileType);
         }
 
         if (ADI_WIL_ERR_SUCCESS == rc)
@@ -124,9 +133,101 @@ adi_wil_err_t wb_wil_GetFileAPI (adi_wil_pack_internals_t * const pInternals,
     return rc;
 }
 
+adi_wil_err_t wb_wil_GetFileStreamAPI (adi_wil_pack_internals_t * const pInternals,
+                                       uint64_t iDeviceId,
+                                       adi_wil_file_type_t eFileType)
+{
+    adi_wil_err_t rc;
+    const adi_wil_mode_t ValidModes[] = { ADI_WIL_MODE_STANDBY };
+    const adi_wil_target_t ValidTargets[] = { ADI_WIL_TARGET_SINGLE_NODE, ADI_WIL_TARGET_SINGLE_MANAGER };
+    adi_wil_request_context_t * pContext = (void *) 0;
+    adi_wil_get_file_stream_t * pStream;
+    uint8_t iFileType = 0u;
+
+    /* Validate input parameter */
+    rc = adi_wil_ValidateInstance (pInternals, true);
+
+    if (ADI_WIL_ERR_SUCCESS == rc)
+    {
+        /* Map file type from adi_wil_file_type_t to uint8_t */
+        rc = wb_wil_GetUintFromFileType (eFileType, &iFileType);
+    }
+
+    /* Acquire a request context for the whole transfer. The file type is
+     * carried in the context, the transfer state is indexed by it */
+    if (ADI_WIL_ERR_SUCCESS == rc)
+    {
+        rc = wb_wil_AcquireRequestContext (pInternals, ADI_WIL_API_GET_FILE, iDeviceId, iFileType, (sizeof (ValidTargets) / sizeof (adi_wil_target_t)), ValidTargets, &wb_wil_GetFileStreamContextFunc, &pContext);
+    }
+
+    if (ADI_WIL_ERR_SUCCESS == rc)
+    {
+        /* Validate system mode */
+        rc = adi_wil_CheckSystemMode (pInternals, (sizeof (ValidModes) / sizeof (adi_wil_mode_t)), ValidModes);
+
+        if (ADI_WIL_ERR_SUCCESS == rc)
+        {
+            /* Verify if the input file type is allowed for the target */
+            rc = wb_wil_GetFileCheckFileType (pInternals, pContext->Request.eTarget, eFileType);
+        }
+
+        if (ADI_WIL_ERR_SUCCESS == rc)
+        {
+            /* Start with the file CRC request, blocks follow from offset 0 */
+            pStream = wb_wil_GetFileStreamState (pInternals, pContext);
+            (void) memset (pStream, 0, sizeof (adi_wil_get_file_stream_t));
+
+            /* Queue 'get file CRC' request packet for the process task */
+            wb_wil_QueueRequestContext (pContext);
+        }
+        else
+        {
+            /* Release the context if any of the above steps returns a failure */
+            wb_wil_ReleaseRequestContext (pInternals, pContext);
+        }
+    }
+
+    return rc;
+}
+
+void wb_wil_HandleGetFileStreamCRCResponse (adi_wil_pack_internals_t * const pInternals,
+                                            adi_wil_request_context_t * const pContext,
+                                            wbms_cmd_resp_get_file_crc_t const * const pResponse)
+{
+    adi_wil_get_file_stream_t * pStream;
+
+    pStream = wb_wil_GetFileStreamState (pInternals, pContext);
+
+    if (pStream->bCRCReceived)
+    {
+        /* Return as failed, the context is waiting for a block */
+        wb_wil_CompleteRequestContext (pInternals, pContext, ADI_WIL_ERR_FAIL, (void *) 0);
+    }
+    else if (WBMS_CMD_RC_SUCCESS != pResponse->rc)
+    {
+        /* File not present on the device or any other error condition */
+        wb_wil_CompleteRequestContext (pInternals, pContext, wb_wil_GetErrFromUint (pResponse->rc), (void *) 0);
+    }
+    else
+    {
+        /* Keep the CRC to validate the reassembled file against */
+        pStream->iExpectedCRC = pResponse->iCRC;
+        pStream->iCRC = WB_CRC_SEED;
+        pStream->iOffset = 0u;
+        pStream->bCRCReceived = true;
+
+        /* Request the first block */
+        if (ADI_WIL_ERR_SUCCESS != wb_wil_RequeueRequestContext (pInternals, pContext))
+        {
+            wb_wil_CompleteRequestContext (pInternals, pContext, ADI_WIL_ERR_FAIL, (void *) 0);
+        }
+    }
+}
+
 void wb_wil_HandleGetFileResponse (adi_wil_pack_internals_t * const pInternals, uint64_t iDeviceId, wbms_cmd_resp_get_file_t const * const pResponse, uint8_t * const pData)
 {
     adi_wil_file_t Response;
+    adi_wil_request_context_t * pContext;
 
     (void) iDeviceId;
 
@@ -138,7 +239,14 @@ void wb_wil_HandleGetFileResponse (adi_wil_pack_internals_t * const pInternals,
     Response.iRemainingBytes = pResponse->iRemainingBytes;
     Response.iOffset = pInternals->GetFileState.iOffset;
 
-    if (ADI_WIL_ERR_SUCCESS != wb_wil_api_CheckToken (pInternals, pResponse->iToken, true))
+    pContext = wb_wil_FindRequestContext (pInternals, pResponse->iToken);
+
+    if ((void *) 0 != pContext)
+    {
+        /* Block of a streamed transfer */
+        wb_wil_HandleGetFileStreamResponse (pInternals, pContext, pResponse, pData);
+    }
+    else if (ADI_WIL_ERR_SUCCESS != wb_wil_api_CheckToken (pInternals, pResponse->iToken, true))
     {
         /* Do nothing, there is no active request with this token */
     }
@@ -179,6 +287,136 @@ void wb_wil_HandleGetFileResponse (adi_wil_pack_internals_t * const pInternals,
  * Static functions
  *****************************************************************************/
 
+static adi_wil_err_t wb_wil_GetFileCheckFileType (adi_wil_pack_internals_t const * const pInternals, adi_wil_target_t eTarget, adi_wil_file_type_t eFileType)
+{
+    adi_wil_err_t rc;
+
+    if (ADI_WIL_TARGET_SINGLE_MANAGER == eTarget)
+    {
+        /* Verify if the input file type is allowed for a manager */
+        rc = adi_wil_CheckFileType (pInternals, eFileType, (sizeof (wb_wil_GetFileManagerFileTypes) / sizeof (adi_wil_file_type_t)), wb_wil_GetFileManagerFileTypes);
+    }
+    else
+    {
+        /* Verify if the input file type is allowed for a node */
+        rc = adi_wil_CheckFileType (pInternals, eFileType, (sizeof (wb_wil_GetFileNodeFileTypes) / sizeof (adi_wil_file_type_t)), wb_wil_GetFileNodeFileTypes);
+    }
+
+    return rc;
+}
+
+static adi_wil_get_file_stream_t * wb_wil_GetFileStreamState (adi_wil_pack_internals_t * const pInternals, adi_wil_request_context_t const * const pContext)
+{
+    /* Transfer state shares the index of its request context */
+    return &pInternals->GetFileState.Streams [pContext - &pInternals->RequestPool.Contexts [0]];
+}
+
+static void wb_wil_GetFileStreamContextFunc (adi_wil_pack_internals_t * const pInternals, adi_wil_request_context_t * const pContext)
+{
+    wbms_cmd_req_get_file_crc_t CRCRequest;
+    wbms_cmd_req_get_file_t Request;
+    adi_wil_get_file_stream_t const * pStream;
+    adi_wil_err_t rc;
+
+    pStream = wb_wil_GetFileStreamState (pInternals, pContext);
+
+    if (pContext->Request.iRetries >= ADI_WIL_RETRIES)
+    {
+        wb_wil_CompleteRequestContext (pInternals, pContext, ADI_WIL_ERR_TIMEOUT, (void *) 0);
+    }
+    else
+    {
+        if (!pStream->bCRCReceived)
+        {
+            /* Initialize request structure */
+            (void) memset (&CRCRequest, 0, sizeof (CRCRequest));
+
+            CRCRequest.iFileType = pContext->iParameter;
+
+            rc = wb_wil_GetFileCRCRequest (pInternals, &CRCRequest, ADI_WIL_RESPONSE_TIMEOUT_MS);
+        }
+        else
+        {
+            /* Initialize request structure */
+            (void) memset (&Request, 0, sizeof (Request));
+
+            Request.iFileType = pContext->iParameter;
+            Request.iOffset = pStream->iOffset;
+
+            rc = wb_wil_GetFileRequest (pInternals, &Request, ADI_WIL_RESPONSE_TIMEOUT_MS);
+        }
+
+        if (ADI_WIL_ERR_SUCCESS != rc)
+        {
+            wb_wil_CompleteRequestContext (pInternals, pContext, ADI_WIL_ERR_FAIL, (void *) 0);
+        }
+    }
+}
+
+static void wb_wil_HandleGetFileStreamResponse (adi_wil_pack_internals_t * const pInternals, adi_wil_request_context_t * const pContext, wbms_cmd_resp_get_file_t const * const pResponse, uint8_t * const pData)
+{
+    adi_wil_file_t Response;
+    adi_wil_get_file_stream_t * pStream;
+
+    pStream = wb_wil_GetFileStreamState (pInternals, pContext);
+
+    /* Initialize request structure */
+    (void) memset (&Response, 0, sizeof (Response));
+
+    Response.pData = pData;
+    Response.iByteCount = pResponse->iLength;
+    Response.iRemainingBytes = pResponse->iRemainingBytes;
+    Response.iOffset = pStream->iOffset;
+
+    if (!pStream->bCRCReceived)
+    {
+        /* Return as failed, the context is waiting for the file CRC */
+        wb_wil_CompleteRequestContext (pInternals, pContext, ADI_WIL_ERR_FAIL, (void *) 0);
+    }
+    else if (WBMS_CMD_RC_SUCCESS != pResponse->rc)
+    {
+        /* Return as failed */
+        wb_wil_CompleteRequestContext (pInternals, pContext, wb_wil_GetErrFromUint (pResponse->rc), (void *) 0);
+    }
+    else if (((pStream->iOffset + pResponse->iLength) > (uint16_t) UINT16_MAX) ||
+             (pResponse->iLength > (uint8_t) WBMS_GET_FILE_BLOCK_SIZE) ||
+             ((0u == pResponse->iLength) && (pResponse->iRemainingBytes > 0u)))
+    {
+        /* Return as failed - an empty block before the end of the file would
+         * request the same offset forever */
+        wb_wil_CompleteRequestContext (pInternals, pContext, ADI_WIL_ERR_FAIL, (void *) 0);
+    }
+    else
+    {
+        /* Blocks are requested in order, so the CRC is carried from one
+         * block to the next */
+        pStream->iCRC = wb_crc_ComputeCRC32 (pData, pResponse->iLength, pStream->iCRC);
+        pStream->iOffset += pResponse->iLength;
+
+        if (pResponse->iRemainingBytes > 0u)
+        {
+            /* Hand the block to the application, then request the next one */
+            wb_wil_NotifyRequestContext (pInternals, pContext, ADI_WIL_ERR_IN_PROGRESS, &Response);
+
+            if (ADI_WIL_ERR_SUCCESS != wb_wil_RequeueRequestContext (pInternals, pContext))
+            {
+                wb_wil_CompleteRequestContext (pInternals, pContext, ADI_WIL_ERR_FAIL, (void *) 0);
+            }
+        }
+        else if (pStream->iCRC != pStream->iExpectedCRC)
+        {
+            /* Reassembled file does not match the device - the blocks
+             * delivered so far must be discarded */
+            wb_wil_CompleteRequestContext (pInternals, pContext, ADI_WIL_ERR_CRC, (void *) 0);
+        }
+        else
+        {
+            /* Return as completed with the last block */
+            wb_wil_CompleteRequestContext (pInternals, pContext, ADI_WIL_ERR_SUCCESS, &Response);
+        }
+    }
+}
+
 static void wb_wil_GetFileFunc (adi_wil_pack_internals_t * const pInternals)
 {
     wbms_cmd_req_get_file_t Request;
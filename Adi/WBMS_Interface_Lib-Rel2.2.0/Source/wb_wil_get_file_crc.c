@@ -8,7 +8,9 @@
  *****************************************************************************/
 
 #include "wb_wil_get_file_crc.h"
+#include "wb_wil_get_file.h"
 #include "wb_wil_request.h"
+#include "wb_wil_request_context.h"
 #include "wb_req_get_file_crc.h"
 #include "wb_rsp_get_file_crc.h"
 #include "adi_wil_pack_internals.h"
@@ -25,10 +27,24 @@
 #define WB_GET_FILE_CRC_LIST_MANAGER_0_INDEX    (62u)
 #define WB_GET_FILE_CRC_LIST_MANAGER_1_INDEX    (63u)
 
+/******************************************************************************
+ * Static variables
+ *****************************************************************************/
+
+static const adi_wil_file_type_t wb_wil_GetFileCRCManagerFileTypes[] = { ADI_WIL_FILE_TYPE_FIRMWARE, ADI_WIL_FILE_TYPE_PMS_CONTAINER, ADI_WIL_FILE_TYPE_EMS_CONTAINER,
+                                                                         ADI_WIL_FILE_TYPE_CONFIGURATION, ADI_WIL_FILE_TYPE_BLACK_BOX_LOG, ADI_WIL_FILE_TYPE_ENV_MON };
+
+static const adi_wil_file_type_t wb_wil_GetFileCRCNodeFileTypes[] = { ADI_WIL_FILE_TYPE_FIRMWARE, ADI_WIL_FILE_TYPE_BMS_CONTAINER, ADI_WIL_FILE_TYPE_EMS_CONTAINER,
+                                                                      ADI_WIL_FILE_TYPE_CONFIGURATION, ADI_WIL_FILE_TYPE_BLACK_BOX_LOG, ADI_WIL_FILE_TYPE_INVENTORY_LOG, ADI_WIL_FILE_TYPE_ENV_MON };
+
 /******************************************************************************
  * Static functions
  *****************************************************************************/
 
+static adi_wil_err_t wb_wil_GetFileCRCMultipleAPI (adi_wil_pack_internals_t * const pInternals, uint64_t iDeviceId, adi_wil_file_type_t eFileType);
+static adi_wil_err_t wb_wil_GetFileCRCSingleAPI (adi_wil_pack_internals_t * const pInternals, uint64_t iDeviceId, adi_wil_file_type_t eFileType);
+static adi_wil_err_t wb_wil_GetFileCRCCheckFileType (adi_wil_pack_internals_t const * const pInternals, adi_wil_target_t eTarget, adi_wil_file_type_t eFileType);
+static void wb_wil_GetFileCRCContextFunc (adi_wil_pack_internals_t * const pInternals, adi_wil_request_context_t * const pContext);
 static void wb_wil_GetFileCRCFunc (adi_wil_pack_internals_t * const pInternals);
 static void wb_wil_GetFileCRCComplete (adi_wil_pack_internals_t * const pInternals, adi_wil_err_t rc, void const * const pResponse);
 static void wb_wil_GetFileCRCUpdateCRCList (adi_wil_pack_internals_t * const pInternals, uint64_t iDeviceId, uint32_t iCRC, bool bFileExists);
@@ -42,13 +58,109 @@ adi_wil_err_t wb_wil_GetFileCRCAPI (adi_wil_pack_internals_t * const pInternals,
                                     adi_wil_file_type_t eFileType)
 {
     adi_wil_err_t rc;
-    const adi_wil_mode_t ValidModes[] = { ADI_WIL_MODE_STANDBY };
-    const adi_wil_target_t ValidTargets[] = { ADI_WIL_TARGET_SINGLE_MANAGER, ADI_WIL_TARGET_SINGLE_NODE, ADI_WIL_TARGET_ALL_MANAGERS, ADI_WIL_TARGET_ALL_NODES};
-    const adi_wil_file_type_t ValidManagerFileTypes[] = { ADI_WIL_FILE_TYPE_FIRMWARE, ADI_WIL_FILE_TYPE_PMS_CONTAINER, ADI_WIL_FILE_TYPE_EMS_CONTAINER, 
-                                                          ADI_WIL_FILE_TYPE_CONFIGURATION, ADI_WIL_FILE_TYPE_BLACK_BOX_LOG, ADI_WIL_FILE_TYPE_ENV_MON };
-    const adi_wil_file_type_t ValidNodeFileTypes[] = { ADI_WIL_FILE_TYPE_FIRMWARE, ADI_WIL_FILE_TYPE_BMS_CONTAINER, ADI_WIL_FILE_TYPE_EMS_CONTAINER, 
-                                                       ADI_WIL_FILE_TYPE_CONFIGURATION, ADI_WIL_FILE_TYPE_BLACK_BOX_LOG, ADI_WIL_FILE_TYPE_INVENTORY_LOG, ADI_WIL_FILE_TYPE_ENV_MON };
 
+    /* A single device request runs concurrently with requests to other
+     * devices, a multiple device request holds the pack lock */
+    if ((iDeviceId != 0u) && ((iDeviceId & (iDeviceId - 1u)) == 0u))
+    {
+        rc = wb_wil_GetFileCRCSingleAPI (pInternals, iDeviceId, eFileType);
+    }
+    else
+    {
+        rc = wb_wil_GetFileCRCMultipleAPI (pInternals, iDeviceId, eFileType);
+    }
+
+    return rc;
+}
+
+void wb_wil_HandleGetFileCRCResponse (adi_wil_pack_internals_t * const pInternals, uint64_t iDeviceId, wbms_cmd_resp_get_file_crc_t const * const pResponse)
+{
+    adi_wil_err_t rc;
+    bool bComplete;
+    adi_wil_request_context_t * pContext;
+
+    rc = ADI_WIL_ERR_SUCCESS;
+    bComplete = false;
+
+    pContext = wb_wil_FindRequestContext (pInternals, pResponse->iToken);
+
+    if (((void *) 0 != pContext) && (ADI_WIL_API_GET_FILE == pContext->eAPI))
+    {
+        /* First step of a streamed file transfer */
+        wb_wil_HandleGetFileStreamCRCResponse (pInternals, pContext, pResponse);
+    }
+    else if ((void *) 0 != pContext)
+    {
+        /* Single device request - the CRC list is built for this callback
+         * only, so one list serves all contexts */
+        (void) memset (&pInternals->GetFileCRCState.FileCRCList, 0, sizeof (pInternals->GetFileCRCState.FileCRCList));
+
+        if ((WBMS_CMD_RC_SUCCESS == pResponse->rc) || (WBMS_CMD_RC_CRC_ERROR == pResponse->rc))
+        {
+            /* File CRC returned, or file not present on remote device */
+            wb_wil_GetFileCRCUpdateCRCList (pInternals, iDeviceId, pResponse->iCRC, (WBMS_CMD_RC_SUCCESS == pResponse->rc));
+            wb_wil_CompleteRequestContext (pInternals, pContext, ADI_WIL_ERR_SUCCESS, (void *) (&pInternals->GetFileCRCState.FileCRCList));
+        }
+        else
+        {
+            /* Any other error condition */
+            wb_wil_CompleteRequestContext (pInternals, pContext, ADI_WIL_ERR_FAIL, (void *) 0);
+        }
+    }
+    else if (ADI_WIL_ERR_SUCCESS != wb_wil_api_CheckToken (pInternals, pResponse->iToken, false))
+    {
+        /* Do nothing, there is no active request with this token */
+    }
+    else
+    {
+        rc = wb_wil_ClearPendingResponse (pInternals, iDeviceId);
+
+        /* Received response from valid device */
+        if ((ADI_WIL_ERR_SUCCESS == rc) || (ADI_WIL_ERR_IN_PROGRESS == rc))
+        {
+            if (WBMS_CMD_RC_SUCCESS == pResponse->rc)
+            {
+                /* File CRC returned successfully */
+                wb_wil_GetFileCRCUpdateCRCList (pInternals, iDeviceId, pResponse->iCRC, true);
+            }
+            else if (WBMS_CMD_RC_CRC_ERROR == pResponse->rc)
+            {
+                /* File not present on remote device */
+                wb_wil_GetFileCRCUpdateCRCList (pInternals, iDeviceId, 0u, false);
+            }
+            else
+            {
+                /* Any other error condition */
+                bComplete = true;
+                rc = ADI_WIL_ERR_FAIL;
+            }
+        }
+
+        if (ADI_WIL_ERR_SUCCESS == rc)
+        {
+            /* Received responses from all targets */
+            bComplete = true;
+            rc = ADI_WIL_ERR_SUCCESS;
+        }
+    }
+
+    if (bComplete)
+    {
+        wb_wil_GetFileCRCComplete (pInternals, 
+                                   rc, 
+                                   (rc == ADI_WIL_ERR_SUCCESS) ? (void*) (&pInternals->GetFileCRCState.FileCRCList) : (void*)(0u));
+    }
+}
+
+/******************************************************************************
+ * Static functions
+ *****************************************************************************/
+
+static adi_wil_err_t wb_wil_GetFileCRCMultipleAPI (adi_wil_pack_internals_t * const pInternals, uint64_t iDeviceId, adi_wil_file_type_t eFileType)
+{
+    adi_wil_err_t rc;
+    const adi_wil_mode_t ValidModes[] = { ADI_WIL_MODE_STANDBY };
+    const adi_wil_target_t ValidTargets[] = { ADI_WIL_TARGET_ALL_MANAGERS, ADI_WIL_TARGET_ALL_NODES };
     bool bReleaseLock = false;
 
     /* Validate input parameter */
@@ -78,21 +190,10 @@ adi_wil_err_t wb_wil_GetFileCRCAPI (adi_wil_pack_internals_t * const pInternals,
             rc = wb_wil_SetupRequest (pInternals, iDeviceId, (sizeof (ValidTargets) / sizeof (adi_wil_target_t)), ValidTargets, &wb_wil_GetFileCRCFunc);
         }
 
-        /* Handle manager and node cases separately */
-        if ((ADI_WIL_ERR_SUCCESS == rc) &&
-            ((ADI_WIL_TARGET_SINGLE_MANAGER == pInternals->UserRequestState.eTarget) ||
-             (ADI_WIL_TARGET_ALL_MANAGERS == pInternals->UserRequestState.eTarget)))
-        {
-            /* Verify if the input file type is allowed for manager(s) */
-            rc = adi_wil_CheckFileType (pInternals, eFileType, (sizeof (ValidManagerFileTypes) / sizeof (adi_wil_file_type_t)), ValidManagerFileTypes);
-        }
-
-        if ((ADI_WIL_ERR_SUCCESS == rc) &&
-            ((ADI_WIL_TARGET_SINGLE_NODE == pInternals->UserRequestState.eTarget) ||
-             (ADI_WIL_TARGET_ALL_NODES == pInternals->UserRequestState.eTarget)))
+        if (ADI_WIL_ERR_SUCCESS == rc)
         {
-            /* Verify if the input file type is allowed for node(s) */
-            rc = adi_wil_CheckFileType (pInternals, eFileType, (sizeof (ValidNodeFileTypes) / sizeof (adi_wil_file_type_t)), ValidNodeFileTypes);
+            /* Verify if the input file type is allowed for the target(s) */
+            rc = wb_wil_GetFileCRCCheckFileType (pInternals, pInternals->UserRequestState.eTarget, eFileType);
         }
 
         if (ADI_WIL_ERR_SUCCESS == rc)
@@ -120,62 +221,97 @@ adi_wil_err_t wb_wil_GetFileCRCAPI (adi_wil_pack_internals_t * const pInternals,
     return rc;
 }
 
-void wb_wil_HandleGetFileCRCResponse (adi_wil_pack_internals_t * const pInternals, uint64_t iDeviceId, wbms_cmd_resp_get_file_crc_t const * const pResponse)
+static adi_wil_err_t wb_wil_GetFileCRCSingleAPI (adi_wil_pack_internals_t * const pInternals, uint64_t iDeviceId, adi_wil_file_type_t eFileType)
 {
     adi_wil_err_t rc;
-    bool bComplete;
+    const adi_wil_mode_t ValidModes[] = { ADI_WIL_MODE_STANDBY };
+    const adi_wil_target_t ValidTargets[] = { ADI_WIL_TARGET_SINGLE_MANAGER, ADI_WIL_TARGET_SINGLE_NODE };
+    adi_wil_request_context_t * pContext = (void *) 0;
+    uint8_t iFileType = 0u;
 
-    rc = ADI_WIL_ERR_SUCCESS;
-    bComplete = false;
+    /* Validate input parameter */
+    rc = adi_wil_ValidateInstance (pInternals, true);
 
-    if (ADI_WIL_ERR_SUCCESS != wb_wil_api_CheckToken (pInternals, pResponse->iToken, false))
+    if (ADI_WIL_ERR_SUCCESS == rc)
     {
-        /* Do nothing, there is no active request with this token */
+        /* Map file type from adi_wil_file_type_t to uint8_t* */
+        rc = wb_wil_GetUintFromFileType (eFileType, &iFileType);
     }
-    else
+
+    /* Acquire a request context. The file type is carried in the context for
+     * retries */
+    if (ADI_WIL_ERR_SUCCESS == rc)
     {
-        rc = wb_wil_ClearPendingResponse (pInternals, iDeviceId);
+        rc = wb_wil_AcquireRequestContext (pInternals, ADI_WIL_API_GET_FILE_CRC, iDeviceId, iFileType, (sizeof (ValidTargets) / sizeof (adi_wil_target_t)), ValidTargets, &wb_wil_GetFileCRCContextFunc, &pContext);
+    }
 
-        /* Received response from valid device */
-        if ((ADI_WIL_ERR_SUCCESS == rc) || (ADI_WIL_ERR_IN_PROGRESS == rc))
+    if (ADI_WIL_ERR_SUCCESS == rc)
+    {
+        /* Validate system mode */
+        rc = adi_wil_CheckSystemMode (pInternals, (sizeof (ValidModes) / sizeof (adi_wil_mode_t)), ValidModes);
+
+        if (ADI_WIL_ERR_SUCCESS == rc)
         {
-            if (WBMS_CMD_RC_SUCCESS == pResponse->rc)
-            {
-                /* File CRC returned successfully */
-                wb_wil_GetFileCRCUpdateCRCList (pInternals, iDeviceId, pResponse->iCRC, true);
-            }
-            else if (WBMS_CMD_RC_CRC_ERROR == pResponse->rc)
-            {
-                /* File not present on remote device */
-                wb_wil_GetFileCRCUpdateCRCList (pInternals, iDeviceId, 0u, false);
-            }
-            else
-            {
-                /* Any other error condition */
-                bComplete = true;
-                rc = ADI_WIL_ERR_FAIL;
-            }
+            /* Verify if the input file type is allowed for the target */
+            rc = wb_wil_GetFileCRCCheckFileType (pInternals, pContext->Request.eTarget, eFileType);
         }
 
         if (ADI_WIL_ERR_SUCCESS == rc)
         {
-            /* Received responses from all targets */
-            bComplete = true;
-            rc = ADI_WIL_ERR_SUCCESS;
+            /* Queue 'get CRC' request packet for the process task */
+            wb_wil_QueueRequestContext (pContext);
+        }
+        else
+        {
+            /* Release the context if any of the above steps returns a failure */
+            wb_wil_ReleaseRequestContext (pInternals, pContext);
         }
     }
 
-    if (bComplete)
+    return rc;
+}
+
+static adi_wil_err_t wb_wil_GetFileCRCCheckFileType (adi_wil_pack_internals_t const * const pInternals, adi_wil_target_t eTarget, adi_wil_file_type_t eFileType)
+{
+    adi_wil_err_t rc;
+
+    if ((ADI_WIL_TARGET_SINGLE_MANAGER == eTarget) ||
+        (ADI_WIL_TARGET_ALL_MANAGERS == eTarget))
     {
-        wb_wil_GetFileCRCComplete (pInternals, 
-                                   rc, 
-                                   (rc == ADI_WIL_ERR_SUCCESS) ? (void*) (&pInternals->GetFileCRCState.FileCRCList) : (void*)(0u));
+        /* Verify if the input file type is allowed for manager(s) */
+        rc = adi_wil_CheckFileType (pInternals, eFileType, (sizeof (wb_wil_GetFileCRCManagerFileTypes) / sizeof (adi_wil_file_type_t)), wb_wil_GetFileCRCManagerFileTypes);
     }
+    else
+    {
+        /* Verify if the input file type is allowed for node(s) */
+        rc = adi_wil_CheckFileType (pInternals, eFileType, (sizeof (wb_wil_GetFileCRCNodeFileTypes) / sizeof (adi_wil_file_type_t)), wb_wil_GetFileCRCNodeFileTypes);
+    }
+
+    return rc;
 }
 
-/******************************************************************************
- * Static functions
- *****************************************************************************/
+static void wb_wil_GetFileCRCContextFunc (adi_wil_pack_internals_t * const pInternals, adi_wil_request_context_t * const pContext)
+{
+    wbms_cmd_req_get_file_crc_t Request;
+
+    /* Initialize request structure */
+    (void) memset (&Request, 0, sizeof (Request));
+
+    Request.iFileType = pContext->iParameter;
+
+    if (pContext->Request.iRetries >= ADI_WIL_RETRIES)
+    {
+        wb_wil_CompleteRequestContext (pInternals, pContext, ADI_WIL_ERR_TIMEOUT, (void *) 0);
+    }
+    else if (ADI_WIL_ERR_SUCCESS != wb_wil_GetFileCRCRequest (pInternals, &Request, ADI_WIL_RESPONSE_TIMEOUT_MS))
+    {
+        wb_wil_CompleteRequestContext (pInternals, pContext, ADI_WIL_ERR_FAIL, (void *) 0);
+    }
+    else
+    {
+        /* MISRA Else */
+    }
+}
 
 static void wb_wil_GetFileCRCFunc (adi_wil_pack_internals_t * const pInternals)
 {
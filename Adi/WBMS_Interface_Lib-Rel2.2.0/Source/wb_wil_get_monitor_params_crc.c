@@ -15,6 +15,7 @@
 #include "adi_wil_pack_internals.h"
 #include "wb_wil_utils.h"
 #include "wb_wil_api.h"
+#include "wb_wil_update_monitor_params.h"
 
 /******************************************************************************
  * Static functions
@@ -82,7 +83,12 @@ adi_wil_err_t wb_wil_GetMonitorParametersCRCAPI (adi_wil_pack_internals_t * cons
 void wb_wil_HandleGetMonitorParametersCRCResponse (adi_wil_pack_internals_t * const pInternals,
                                                    wbms_cmd_resp_get_mon_params_crc_t const * const pResponse)
 {
-    if (ADI_WIL_ERR_SUCCESS != wb_wil_api_CheckToken (pInternals, pResponse->iToken, true))
+    if (ADI_WIL_UPDATE_MONITOR_PARAMS_VERIFY == pInternals->UpdateMonParamsState.ePhase)
+    {
+        /* CRC read back by a monitor parameters update */
+        wb_wil_HandleUpdateMonParamCRCResponse (pInternals, pResponse);
+    }
+    else if (ADI_WIL_ERR_SUCCESS != wb_wil_api_CheckToken (pInternals, pResponse->iToken, true))
     {
         /* Do nothing, there is no active request with this token */
     }
@@ -10,9 +10,9 @@
 #include "wb_wil_get_version.h"
 #include "adi_wil_pack_internals.h"
 #include "wb_wil_request.h"
+#include "wb_wil_request_context.h"
 #include "wb_rsp_get_version.h"
 #include "wb_req_generic.h"
-#include "wb_wil_ui.h"
 #include "wb_wil_version.h"
 #include "adi_wil_version.h"
 #include "adi_wil_dev_version.h"
@@ -24,11 +24,8 @@
  * Static functions
  *****************************************************************************/
 
-static void wb_wil_GetVersionFunc (adi_wil_pack_internals_t * const pInternals);
-
-static void wb_wil_GetVersionComplete (adi_wil_pack_internals_t * const pInternals,
-                                       adi_wil_err_t rc,
-                                       void const * const pResponse);
+static void wb_wil_GetVersionFunc (adi_wil_pack_internals_t * const pInternals,
+                                   adi_wil_request_context_t * const pContext);
 
 /******************************************************************************
  * Public functions
@@ -60,14 +57,15 @@ adi_wil_err_t wb_wil_GetDeviceVersionAPI (adi_wil_pack_internals_t * const pInte
     adi_wil_err_t rc;
     const adi_wil_mode_t ValidModes[] = { ADI_WIL_MODE_STANDBY, ADI_WIL_MODE_OTAP };
     const adi_wil_target_t ValidTargets[] = { ADI_WIL_TARGET_SINGLE_MANAGER, ADI_WIL_TARGET_SINGLE_NODE };
-    bool bReleaseLock = false;
+    adi_wil_request_context_t * pContext = (void *) 0;
 
     rc = adi_wil_ValidateInstance (pInternals, true);
 
-    /* Acquire lock */
+    /* Acquire a request context - runs concurrently with requests to other
+     * devices */
     if (ADI_WIL_ERR_SUCCESS == rc)
     {
-        rc = wb_wil_ui_AcquireLock (pInternals->pPack, pInternals->pPack);
+        rc = wb_wil_AcquireRequestContext (pInternals, ADI_WIL_API_GET_DEVICE_VERSION, iDeviceId, 0u, (sizeof (ValidTargets) / sizeof (adi_wil_target_t)), ValidTargets, &wb_wil_GetVersionFunc, &pContext);
     }
 
     if (ADI_WIL_ERR_SUCCESS == rc)
@@ -77,28 +75,16 @@ adi_wil_err_t wb_wil_GetDeviceVersionAPI (adi_wil_pack_internals_t * const pInte
 
         if (ADI_WIL_ERR_SUCCESS == rc)
         {
-            /* Set up the correct bit mask */
-            rc = wb_wil_SetupRequest (pInternals, iDeviceId, (sizeof (ValidTargets) / sizeof (adi_wil_target_t)), ValidTargets, &wb_wil_GetVersionFunc);
-        }
-
-        if (ADI_WIL_ERR_SUCCESS == rc)
-        {
-            /* Send 'get version' request packet */
-            wb_wil_GetVersionFunc (pInternals);
+            /* Queue 'get version' request packet for the process task */
+            wb_wil_QueueRequestContext (pContext);
         }
-
-        /* Release lock if any of the above steps returns a failure */
-        if (ADI_WIL_ERR_SUCCESS != rc)
+        else
         {
-            bReleaseLock = true;
+            /* Release the context if any of the above steps returns a failure */
+            wb_wil_ReleaseRequestContext (pInternals, pContext);
         }
     }
 
-    if (bReleaseLock)
-    {
-        wb_wil_ui_ReleaseLock (pInternals->pPack, pInternals->pPack);
-    }
-
     return rc;
 }
 
@@ -107,13 +93,16 @@ void wb_wil_HandleGetVersionResponse (adi_wil_pack_internals_t * const pInternal
                                       wbms_cmd_resp_get_version_t const * const pResponse)
 {
     adi_wil_dev_version_t UserResponse;
+    adi_wil_request_context_t * pContext;
 
     (void) iDeviceId;
 
     /* Initialize request structure */
     (void) memset (&UserResponse, 0, sizeof (UserResponse));
 
-    if (ADI_WIL_ERR_SUCCESS != wb_wil_api_CheckToken (pInternals, pResponse->iToken, true))
+    pContext = wb_wil_FindRequestContext (pInternals, pResponse->iToken);
+
+    if ((void *) 0 == pContext)
     {
         /* Do nothing, there is no active request with this token */
     }
@@ -122,7 +111,7 @@ void wb_wil_HandleGetVersionResponse (adi_wil_pack_internals_t * const pInternal
         /* End device has responded with not a SUCCESS.
          * Complete the 'Get Version' API with the return code received from
          * the end device */
-        wb_wil_GetVersionComplete (pInternals, wb_wil_GetErrFromUint (pResponse->rc), (void *) 0);
+        wb_wil_CompleteRequestContext (pInternals, pContext, wb_wil_GetErrFromUint (pResponse->rc), (void *) 0);
     }
     else
     {
@@ -141,7 +130,7 @@ void wb_wil_HandleGetVersionResponse (adi_wil_pack_internals_t * const pInternal
         UserResponse.iCoProcSiVersion = pResponse->iCPSiliconVersion;
         UserResponse.iLifeCycleInfo = pResponse->iLifeCycleInfo;
 
-        wb_wil_GetVersionComplete (pInternals, ADI_WIL_ERR_SUCCESS, &UserResponse);
+        wb_wil_CompleteRequestContext (pInternals, pContext, ADI_WIL_ERR_SUCCESS, &UserResponse);
     }
 }
 
@@ -149,47 +138,21 @@ void wb_wil_HandleGetVersionResponse (adi_wil_pack_internals_t * const pInternal
  * Static functions
  *****************************************************************************/
 
-static void wb_wil_GetVersionFunc (adi_wil_pack_internals_t * const pInternals)
+static void wb_wil_GetVersionFunc (adi_wil_pack_internals_t * const pInternals,
+                                   adi_wil_request_context_t * const pContext)
 {
     wbms_cmd_req_generic_t Request;
 
-    if (pInternals->UserRequestState.iRetries >= ADI_WIL_RETRIES)
+    if (pContext->Request.iRetries >= ADI_WIL_RETRIES)
     {
-        wb_wil_GetVersionComplete (pInternals, ADI_WIL_ERR_TIMEOUT, (void *) 0);
+        wb_wil_CompleteRequestContext (pInternals, pContext, ADI_WIL_ERR_TIMEOUT, (void *) 0);
     }
     else if (ADI_WIL_ERR_SUCCESS != wb_wil_GenericRequest (pInternals, &Request, WBMS_CMD_GET_VERSION, ADI_WIL_RESPONSE_TIMEOUT_MS))
     {
-        wb_wil_GetVersionComplete (pInternals, ADI_WIL_ERR_FAIL, (void *) 0);
+        wb_wil_CompleteRequestContext (pInternals, pContext, ADI_WIL_ERR_FAIL, (void *) 0);
     }
     else
     {
         /* MISRA Else */
     }
 }
-
-static void wb_wil_GetVersionComplete (adi_wil_pack_internals_t * const pInternals,
-                                       adi_wil_err_t rc,
-                                       void const * const pResponse)
-{
-    pInternals->UserRequestState.bValid = false;
-    pInternals->UserRequestState.pfRequestFunc = ((void *) 0);
-
-    if (ADI_WIL_ERR_SUCCESS == rc)
-    {
-        /* End device has responded with a SUCCESS.
-         * Generate a callback to the host device with the return code of
-         * SUCCESS and with the return structure that is populated with version
-         * numbers */
-        wb_wil_ui_GenerateCb (pInternals->pPack, ADI_WIL_API_GET_DEVICE_VERSION, rc, pResponse);
-    }
-    else
-    {
-        /* End device has responded with not a SUCCESS.
-         * Generate a callback to the host device with the return code received
-         * from the end device */
-        wb_wil_ui_GenerateCb (pInternals->pPack, ADI_WIL_API_GET_DEVICE_VERSION, rc, (void *) 0);
-    }
-
-    /* Release lock */
-    wb_wil_ui_ReleaseLock (pInternals->pPack, pInternals->pPack);
-}
@@ -9,11 +9,11 @@
 
 #include "wb_wil_getgpio.h"
 #include "wb_wil_request.h"
+#include "wb_wil_request_context.h"
 #include "wb_nil.h"
 #include "wb_req_get_gpio.h"
 #include "wb_rsp_get_gpio.h"
 #include "adi_wil_pack_internals.h"
-#include "wb_wil_ui.h"
 #include "wb_wil_setgpio.h"
 #include "wb_wil_utils.h"
 #include "wb_wil_api.h"
@@ -23,10 +23,8 @@
  * Static functions
  *****************************************************************************/
 
-static void wb_wil_GetGPIOFunc (adi_wil_pack_internals_t * const pInternals);
-
-static void wb_wil_GetGPIOComplete (adi_wil_pack_internals_t * const pInternals,
-                                    adi_wil_err_t rc);
+static void wb_wil_GetGPIOFunc (adi_wil_pack_internals_t * const pInternals,
+                                adi_wil_request_context_t * const pContext);
 
 /******************************************************************************
  * Public functions
@@ -39,14 +37,20 @@ adi_wil_err_t wb_wil_GetGPIOAPI (adi_wil_pack_internals_t * const pInternals,
     adi_wil_err_t rc;
     const adi_wil_mode_t ValidModes[] = { ADI_WIL_MODE_ACTIVE, ADI_WIL_MODE_STANDBY, ADI_WIL_MODE_MONITORING };
     const adi_wil_target_t ValidTargets[] = { ADI_WIL_TARGET_SINGLE_MANAGER, ADI_WIL_TARGET_SINGLE_NODE };
-    bool bReleaseLock = false;
+    adi_wil_request_context_t * pContext = (void *) 0;
 
     rc = adi_wil_ValidateInstance (pInternals, true);
 
-    /* Acquire lock */
     if (ADI_WIL_ERR_SUCCESS == rc)
     {
-        rc = wb_wil_ui_AcquireLock (pInternals->pPack, pInternals->pPack);
+        rc = wb_wil_SetGPIOCheckPin (eGPIOId);
+    }
+
+    /* Acquire a request context - runs concurrently with requests to other
+     * devices. The GPIO is carried in the context for retries */
+    if (ADI_WIL_ERR_SUCCESS == rc)
+    {
+        rc = wb_wil_AcquireRequestContext (pInternals, ADI_WIL_API_GET_GPIO, iDeviceId, wb_wil_GPIOtoUint (eGPIOId), (sizeof (ValidTargets) / sizeof (adi_wil_target_t)), ValidTargets, &wb_wil_GetGPIOFunc, &pContext);
     }
 
     if (ADI_WIL_ERR_SUCCESS == rc)
@@ -56,33 +60,14 @@ adi_wil_err_t wb_wil_GetGPIOAPI (adi_wil_pack_internals_t * const pInternals,
 
         if (ADI_WIL_ERR_SUCCESS == rc)
         {
-            rc = wb_wil_SetGPIOCheckPin (eGPIOId);
+            /* Queue 'get GPIO' request packet for the process task */
+            wb_wil_QueueRequestContext (pContext);
         }
-
-        if (ADI_WIL_ERR_SUCCESS == rc)
+        else
         {
-            /* Set-up the correct bit-mask to prepare for a new packet request
-             * generation */
-            rc = wb_wil_SetupRequest (pInternals, iDeviceId, (sizeof (ValidTargets) / sizeof (adi_wil_target_t)), ValidTargets, &wb_wil_GetGPIOFunc);
+            /* Release the context if any of the above steps returns a failure */
+            wb_wil_ReleaseRequestContext (pInternals, pContext);
         }
-
-        if (ADI_WIL_ERR_SUCCESS == rc)
-        {
-            pInternals->GpioState.GpioId = eGPIOId;
-            /* Send 'get GPIO' request packet */
-            wb_wil_GetGPIOFunc (pInternals);
-        }
-
-        /* Release lock if any of the above steps returns a failure */
-        if (ADI_WIL_ERR_SUCCESS != rc)
-        {
-            bReleaseLock = true;
-        }
-    }
-
-    if (bReleaseLock)
-    {
-        wb_wil_ui_ReleaseLock (pInternals->pPack, pInternals->pPack);
     }
 
     return rc;
@@ -92,9 +77,14 @@ void wb_wil_HandleGetGPIOResponse (adi_wil_pack_internals_t * const pInternals,
                                    uint64_t iDeviceId,
                                    wbms_cmd_resp_get_gpio_t const * const pResponse)
 {
+    adi_wil_request_context_t * pContext;
+    adi_wil_gpio_value_t GpioVal;
+
     (void) iDeviceId;
 
-    if (wb_wil_api_CheckToken (pInternals, pResponse->iToken, true) != ADI_WIL_ERR_SUCCESS)
+    pContext = wb_wil_FindRequestContext (pInternals, pResponse->iToken);
+
+    if ((void *) 0 == pContext)
     {
         /* Do nothing, there is no active request with this token */
     }
@@ -104,21 +94,21 @@ void wb_wil_HandleGetGPIOResponse (adi_wil_pack_internals_t * const pInternals,
          * completed successfully.Generate call back to the host application
          * with a return code from end device (that has responded with this
          * response packet) */
-        wb_wil_GetGPIOComplete (pInternals, wb_wil_GetErrFromUint (pResponse->rc));
+        wb_wil_CompleteRequestContext (pInternals, pContext, wb_wil_GetErrFromUint (pResponse->rc), (void *) 0);
     }
-    else if (ADI_WIL_ERR_SUCCESS != wb_wil_GetGpioValueFromUint (pResponse->iValue, &pInternals->GpioState.GpioValue))
+    else if (ADI_WIL_ERR_SUCCESS != wb_wil_GetGpioValueFromUint (pResponse->iValue, &GpioVal))
     {
         /* Response packet from end device does not have a valid GPIO value.
          * Generate call back to the host application with a return code
          * of FAIL */
-        wb_wil_GetGPIOComplete (pInternals, ADI_WIL_ERR_FAIL);
+        wb_wil_CompleteRequestContext (pInternals, pContext, ADI_WIL_ERR_FAIL, (void *) 0);
     }
     else
     {
         /* Get GPIO API has been completed successfully.
          * Generate call back to the host application with the GPIO value and
          * return code of SUCCESS */
-        wb_wil_GetGPIOComplete (pInternals, ADI_WIL_ERR_SUCCESS);
+        wb_wil_CompleteRequestContext (pInternals, pContext, ADI_WIL_ERR_SUCCESS, (void *) &GpioVal);
     }
 }
 
@@ -126,53 +116,26 @@ void wb_wil_HandleGetGPIOResponse (adi_wil_pack_internals_t * const pInternals,
  * Static functions
  *****************************************************************************/
 
-static void wb_wil_GetGPIOFunc (adi_wil_pack_internals_t * const pInternals)
+static void wb_wil_GetGPIOFunc (adi_wil_pack_internals_t * const pInternals,
+                                adi_wil_request_context_t * const pContext)
 {
     wbms_cmd_req_get_gpio_t Request;
 
     /* Initialize request structure */
     (void) memset (&Request, 0, sizeof (Request));
 
-    Request.iGPIOId = wb_wil_GPIOtoUint (pInternals->GpioState.GpioId);
+    Request.iGPIOId = pContext->iParameter;
 
-    if (pInternals->UserRequestState.iRetries >= ADI_WIL_RETRIES)
+    if (pContext->Request.iRetries >= ADI_WIL_RETRIES)
     {
-        wb_wil_GetGPIOComplete (pInternals, ADI_WIL_ERR_TIMEOUT);
+        wb_wil_CompleteRequestContext (pInternals, pContext, ADI_WIL_ERR_TIMEOUT, (void *) 0);
     }
     else if (ADI_WIL_ERR_SUCCESS != wb_wil_GetGPIORequest (pInternals, &Request, ADI_WIL_RESPONSE_TIMEOUT_MS))
     {
-        wb_wil_GetGPIOComplete (pInternals, ADI_WIL_ERR_FAIL);
+        wb_wil_CompleteRequestContext (pInternals, pContext, ADI_WIL_ERR_FAIL, (void *) 0);
     }
     else
     {
         /* MISRA Else */
     }
 }
-
-static void wb_wil_GetGPIOComplete (adi_wil_pack_internals_t * const pInternals,
-                                    adi_wil_err_t rc)
-{
-    adi_wil_gpio_value_t GpioVal;
-
-    /* Get GPIO API has reached a completion. Reset all the internal
-     * variables */
-    (void) memcpy (&GpioVal, &pInternals->GpioState.GpioValue, sizeof (adi_wil_gpio_value_t));
-    pInternals->UserRequestState.bValid = false;
-    pInternals->UserRequestState.pfRequestFunc = (void *) 0;
-
-    if (ADI_WIL_ERR_SUCCESS == rc)
-    {
-        /* Generate callback with return structure that contains the GPIO state
-         * and a return code of SUCCESS */
-        wb_wil_ui_GenerateCb (pInternals->pPack, ADI_WIL_API_GET_GPIO, rc, (void *) &GpioVal);
-    }
-    else
-    {
-        /* Because the Get GPIO API has failed, generate callback with a null
-         * return structure and a return code of FAIL */
-        wb_wil_ui_GenerateCb (pInternals->pPack, ADI_WIL_API_GET_GPIO, rc, (void *) 0);
-    }
-
-    /* Release lock */
-    wb_wil_ui_ReleaseLock (pInternals->pPack, pInternals->pPack);
-}
@@ -34,6 +34,7 @@ adi_wil_err_t adi_wil_InitializePack (adi_wil_pack_t const * const pPack,
     adi_wil_err_t rc;
     adi_wil_pack_t * pLockId;
     bool bLockAcquired = false;
+    bool bProcessLockAcquired = false;
 
     void const * const NullableParams[] = { pPack, pInternals, pManager0Port };
 
@@ -44,12 +45,31 @@ adi_wil_err_t adi_wil_InitializePack (adi_wil_pack_t const * const pPack,
     {
         (void) memset (&pLockId, 0xFF, sizeof (void *));
 
-        /* Acquire lock to make sure processTask isn't running */
+        /* Acquire the global lock to serialize port registration with
+         * QueryDevice and other packs */
         rc = wb_wil_ui_AcquireLock ((void *)0, pLockId);
 
         if (rc == ADI_WIL_ERR_SUCCESS)
         {
             bLockAcquired = true;
+
+            /* Create the per pack process lock and hold it to make sure this
+             * pack's processTask isn't running */
+            rc = wb_wil_ui_CreateProcessLock (pInternals);
+
+            if (rc == ADI_WIL_ERR_SUCCESS)
+            {
+                rc = wb_wil_ui_AcquireProcessLock (pInternals);
+            }
+
+            if (rc == ADI_WIL_ERR_SUCCESS)
+            {
+                bProcessLockAcquired = true;
+            }
+            else
+            {
+                rc = ADI_WIL_ERR_FAIL;
+            }
         }
         else
         {
@@ -59,16 +79,26 @@ adi_wil_err_t adi_wil_InitializePack (adi_wil_pack_t const * const pPack,
             rc = ADI_WIL_ERR_FAIL;
         }
 
-        /* Initialize manager 0's port */
+        /* Initialize manager 0's port and its process lock */
         if (ADI_WIL_ERR_SUCCESS == rc)
         {
             rc = wb_nil_InitPort (pInternals, pManager0Port);
         }
 
-        /* Initialize manager 1's port */
+        if (ADI_WIL_ERR_SUCCESS == rc)
+        {
+            rc = wb_wil_ui_CreateProcessLock (pManager0Port);
+        }
+
+        /* Initialize manager 1's port and its process lock */
         if ((ADI_WIL_ERR_SUCCESS == rc) && ((void *) 0 != pManager1Port))
         {
             rc = wb_nil_InitPort (pInternals, pManager1Port);
+
+            if (ADI_WIL_ERR_SUCCESS == rc)
+            {
+                rc = wb_wil_ui_CreateProcessLock (pManager1Port);
+            }
         }
 
         if (rc == ADI_WIL_ERR_SUCCESS)
@@ -88,6 +118,11 @@ adi_wil_err_t adi_wil_InitializePack (adi_wil_pack_t const * const pPack,
             pInternals->Stats.BmsPktStats.iManager1PktCount = 0u;
         }
 
+        if (bProcessLockAcquired)
+        {
+            wb_wil_ui_ReleaseProcessLock (pInternals);
+        }
+
         if (bLockAcquired)
         {
             wb_wil_ui_ReleaseLock ((void *)0, pLockId);
@@ -0,0 +1,347 @@
+/******************************************************************************
+ * @file    wb_wil_port_select.c
+ *
+ * @brief   Manager port selection for requests targeting the nodes
+ *
+ * Copyright (c) 2022 Analog Devices, Inc. All Rights Reserved.
+ * This software is proprietary to Analog Devices, Inc. and its licensors.
+ *****************************************************************************/
+
+#include "wb_wil_port_select.h"
+#include "adi_wil_pack_internals.h"
+#include "adi_wil_port.h"
+#include "adi_wil_hal_ticker.h"
+#include "wb_wil_utils.h"
+
+#include <stdbool.h>
+
+/******************************************************************************
+ * #defines
+ *****************************************************************************/
+
+#define WB_WIL_PORT_SELECT_OUTSTANDING_COST     (4u)    /* Cost of each request awaiting the manager's response */
+#define WB_WIL_PORT_SELECT_OUTSTANDING_MAX      (255u)  /* Saturation of the outstanding request count */
+#define WB_WIL_PORT_SELECT_OUTSTANDING_TIMEOUT  (1000u) /* ms without a response after which outstanding requests are dropped */
+#define WB_WIL_PORT_SELECT_OVERFLOW_COST        (16u)   /* Cost added for each SPI transmit queue overflow */
+#define WB_WIL_PORT_SELECT_OVERFLOW_MAX         (16u)   /* Overflows counted from a single system status */
+#define WB_WIL_PORT_SELECT_CONGESTION_MAX       (256u)  /* Saturation of the congestion penalty */
+#define WB_WIL_PORT_SELECT_UNHEARD_COST         (8u)    /* Cost of a manager the target node has not been heard through */
+#define WB_WIL_PORT_SELECT_RSSI_UNKNOWN         (0)     /* RSSI value of a node not heard yet */
+
+/******************************************************************************
+ * Static functions
+ *****************************************************************************/
+
+static uint8_t wb_wil_PortSelectGetIndex (uint64_t iManagerId);
+
+static bool wb_wil_PortSelectCheckConnected (adi_wil_port_t const * const pPort);
+
+static uint32_t wb_wil_PortSelectGetLoadCost (adi_wil_port_select_mgr_t * const pManager,
+                                              uint32_t iCurrentTime);
+
+static void wb_wil_PortSelectGetLinkCost (adi_wil_port_select_state_t const * const pState,
+                                          uint8_t iNodeId,
+                                          uint32_t iLinkCost []);
+
+/******************************************************************************
+ * Public functions
+ *****************************************************************************/
+
+adi_wil_port_t * wb_wil_PortSelectForNode (adi_wil_pack_internals_t * const pInternals, uint8_t iNodeId)
+{
+    /* Return value of this function */
+    adi_wil_port_t * pPort;
+
+    /* Port selection state of the pack */
+    adi_wil_port_select_state_t * pState;
+
+    /* Ports of manager 0 and manager 1 */
+    adi_wil_port_t * Ports [2];
+
+    /* Load and link quality costs of each manager */
+    uint32_t iLoadCost [2];
+    uint32_t iLinkCost [2];
+
+    /* Current time for ageing the outstanding requests */
+    uint32_t iCurrentTime;
+
+    /* Index of the manager selected by load alone and with link quality */
+    uint8_t iLoadIndex;
+    uint8_t iIndex;
+
+    /* Initialize return value to NULL */
+    pPort = (void *) 0;
+
+    iCurrentTime = adi_wil_hal_TickerGetTimestamp ();
+
+    pState = &pInternals->PortSelectState;
+    Ports [0] = pInternals->pManager0Port;
+    Ports [1] = pInternals->pManager1Port;
+
+    /* If both managers are connected, weigh their costs... */
+    if (wb_wil_PortSelectCheckConnected (Ports [0]) &&
+        wb_wil_PortSelectCheckConnected (Ports [1]))
+    {
+        iLoadCost [0] = wb_wil_PortSelectGetLoadCost (&pState->Manager [0], iCurrentTime);
+        iLoadCost [1] = wb_wil_PortSelectGetLoadCost (&pState->Manager [1], iCurrentTime);
+
+        wb_wil_PortSelectGetLinkCost (pState, iNodeId, iLinkCost);
+
+        /* Equal costs alternate between the managers as before */
+        iIndex = (pInternals->pCurrentPort == Ports [1]) ? 1u : 0u;
+        iLoadIndex = iIndex;
+
+        if (iLoadCost [0] != iLoadCost [1])
+        {
+            iLoadIndex = (iLoadCost [0] < iLoadCost [1]) ? 0u : 1u;
+        }
+
+        if ((iLoadCost [0] + iLinkCost [0]) != (iLoadCost [1] + iLinkCost [1]))
+        {
+            iIndex = ((iLoadCost [0] + iLinkCost [0]) < (iLoadCost [1] + iLinkCost [1])) ? 0u : 1u;
+        }
+
+        /* Count the selections the target node's link moved to the other
+         * manager */
+        if (iIndex != iLoadIndex)
+        {
+            wb_wil_IncrementWithRollover32 (&pState->iLinkSteerCount);
+        }
+
+        pPort = Ports [iIndex];
+
+        /* Start from the other manager on the next tie */
+        pInternals->pCurrentPort = Ports [iIndex ^ 1u];
+    }
+    /* ... else, select whichever manager is connected */
+    else if (wb_wil_PortSelectCheckConnected (Ports [0]))
+    {
+        iIndex = 0u;
+        pPort = Ports [0];
+    }
+    else if (wb_wil_PortSelectCheckConnected (Ports [1]))
+    {
+        iIndex = 1u;
+        pPort = Ports [1];
+    }
+    else
+    {
+        /* No manager is connected, return NULL */
+        iIndex = 0u;
+    }
+
+    /* Account the selection to the selected manager, the request only
+     * counts as outstanding once wb_wil_PortSelectRecordSubmit () reports
+     * it queued */
+    if ((void *) 0 != pPort)
+    {
+        wb_wil_IncrementWithRollover32 (&pState->Manager [iIndex].iSelectCount);
+
+        /* Count it as a failover if the other manager exists but is not
+         * connected */
+        if (((void *) 0 != Ports [iIndex ^ 1u]) && !Ports [iIndex ^ 1u]->Internals.bConnected)
+        {
+            wb_wil_IncrementWithRollover32 (&pState->Manager [iIndex].iFailoverCount);
+        }
+    }
+
+    return pPort;
+}
+
+void wb_wil_PortSelectRecordSubmit (adi_wil_pack_internals_t * const pInternals, adi_wil_port_t const * const pPort, uint8_t iCount)
+{
+    /* Port selection state of the manager */
+    adi_wil_port_select_mgr_t * pManager;
+
+    /* Outstanding requests after adding this submission */
+    uint32_t iOutstanding;
+
+    if (((void *) 0 != pInternals) && ((void *) 0 != pPort))
+    {
+        pManager = &pInternals->PortSelectState.Manager [(pPort == pInternals->pManager1Port) ? 1u : 0u];
+
+        iOutstanding = (uint32_t) pManager->iOutstanding + iCount;
+
+        if (iOutstanding > WB_WIL_PORT_SELECT_OUTSTANDING_MAX)
+        {
+            iOutstanding = WB_WIL_PORT_SELECT_OUTSTANDING_MAX;
+        }
+
+        pManager->iOutstanding = (uint8_t) iOutstanding;
+        pManager->iLastSubmitTime = adi_wil_hal_TickerGetTimestamp ();
+    }
+}
+
+void wb_wil_PortSelectRecordLink (adi_wil_pack_internals_t * const pInternals, uint64_t iManagerId, uint8_t iNodeId, int8_t iRSSI)
+{
+    /* Stored RSSI of the node through this manager */
+    int8_t * pRSSI;
+
+    /* RSSI after filtering */
+    int16_t iFiltered;
+
+    if (((void *) 0 != pInternals) && (iNodeId < ADI_WIL_MAX_NODES))
+    {
+        pRSSI = &pInternals->PortSelectState.iNodeRSSI [iNodeId][wb_wil_PortSelectGetIndex (iManagerId)];
+
+        /* Seed the filter with the first packet, then move a quarter of the
+         * way towards each new sample */
+        if (WB_WIL_PORT_SELECT_RSSI_UNKNOWN == *pRSSI)
+        {
+            iFiltered = iRSSI;
+        }
+        else
+        {
+            iFiltered = (int16_t) (*pRSSI + ((iRSSI - *pRSSI) / 4));
+        }
+
+        /* Keep a heard node distinguishable from one not heard yet */
+        if (WB_WIL_PORT_SELECT_RSSI_UNKNOWN == iFiltered)
+        {
+            iFiltered = -1;
+        }
+
+        *pRSSI = (int8_t) iFiltered;
+    }
+}
+
+void wb_wil_PortSelectRecordStatus (adi_wil_pack_internals_t * const pInternals, uint64_t iManagerId, uint32_t iSpiTxQueueOFCount)
+{
+    /* Port selection state of the manager */
+    adi_wil_port_select_mgr_t * pManager;
+
+    /* Overflows since the previous system status */
+    uint32_t iOverflows;
+
+    if ((void *) 0 != pInternals)
+    {
+        pManager = &pInternals->PortSelectState.Manager [wb_wil_PortSelectGetIndex (iManagerId)];
+
+        /* Only an increase of the counter is an overflow. The first status
+         * and a counter that went back after a manager reset only set the
+         * baseline */
+        if (pManager->bStatusReceived && (iSpiTxQueueOFCount > pManager->iSpiTxQueueOFCount))
+        {
+            iOverflows = iSpiTxQueueOFCount - pManager->iSpiTxQueueOFCount;
+
+            if (iOverflows > WB_WIL_PORT_SELECT_OVERFLOW_MAX)
+            {
+                iOverflows = WB_WIL_PORT_SELECT_OVERFLOW_MAX;
+            }
+
+            pManager->iCongestion = (uint16_t) (pManager->iCongestion + (iOverflows * WB_WIL_PORT_SELECT_OVERFLOW_COST));
+
+            if (pManager->iCongestion > WB_WIL_PORT_SELECT_CONGESTION_MAX)
+            {
+                pManager->iCongestion = WB_WIL_PORT_SELECT_CONGESTION_MAX;
+            }
+        }
+        /* ... else, halve the penalty for each status without overflows */
+        else
+        {
+            pManager->iCongestion = (uint16_t) (pManager->iCongestion >> 1u);
+        }
+
+        pManager->iSpiTxQueueOFCount = iSpiTxQueueOFCount;
+        pManager->bStatusReceived = true;
+    }
+}
+
+void wb_wil_PortSelectRecordResponse (adi_wil_pack_internals_t * const pInternals, uint64_t iManagerId)
+{
+    /* Port selection state of the manager */
+    adi_wil_port_select_mgr_t * pManager;
+
+    if ((void *) 0 != pInternals)
+    {
+        pManager = &pInternals->PortSelectState.Manager [wb_wil_PortSelectGetIndex (iManagerId)];
+
+        if (pManager->iOutstanding > 0u)
+        {
+            pManager->iOutstanding--;
+        }
+    }
+}
+
+/******************************************************************************
+ * Static function definitions
+ *****************************************************************************/
+
+static uint8_t wb_wil_PortSelectGetIndex (uint64_t iManagerId)
+{
+    return (ADI_WIL_DEV_MANAGER_1 == iManagerId) ? 1u : 0u;
+}
+
+static bool wb_wil_PortSelectCheckConnected (adi_wil_port_t const * const pPort)
+{
+    return ((void *) 0 != pPort) && pPort->Internals.bConnected;
+}
+
+static uint32_t wb_wil_PortSelectGetLoadCost (adi_wil_port_select_mgr_t * const pManager,
+                                              uint32_t iCurrentTime)
+{
+    /* Time since the last request was sent through this manager */
+    uint32_t iElapsedTime;
+
+    iElapsedTime = iCurrentTime - pManager->iLastSubmitTime;
+
+    if (iElapsedTime < iCurrentTime)
+    {
+        /* CERT-C - Allow rollover as timers are expected to wrap */
+    }
+
+    /* Responses lost with a manager reset would otherwise hold the manager's
+     * cost up forever, drop them once the manager has been quiet */
+    if (iElapsedTime > WB_WIL_PORT_SELECT_OUTSTANDING_TIMEOUT)
+    {
+        pManager->iOutstanding = 0u;
+    }
+
+    return ((uint32_t) pManager->iOutstanding * WB_WIL_PORT_SELECT_OUTSTANDING_COST) + pManager->iCongestion;
+}
+
+static void wb_wil_PortSelectGetLinkCost (adi_wil_port_select_state_t const * const pState,
+                                          uint8_t iNodeId,
+                                          uint32_t iLinkCost [])
+{
+    /* Filtered RSSI of the target node through manager 0 and manager 1 */
+    int8_t iRSSI0;
+    int8_t iRSSI1;
+
+    iLinkCost [0] = 0u;
+    iLinkCost [1] = 0u;
+
+    /* Only a single node target has a link to weigh */
+    if (iNodeId < ADI_WIL_MAX_NODES)
+    {
+        iRSSI0 = pState->iNodeRSSI [iNodeId][0];
+        iRSSI1 = pState->iNodeRSSI [iNodeId][1];
+
+        /* Charge the weaker manager one point per dB it is behind... */
+        if ((WB_WIL_PORT_SELECT_RSSI_UNKNOWN != iRSSI0) && (WB_WIL_PORT_SELECT_RSSI_UNKNOWN != iRSSI1))
+        {
+            if (iRSSI0 < iRSSI1)
+            {
+                iLinkCost [0] = (uint32_t) ((int32_t) iRSSI1 - (int32_t) iRSSI0);
+            }
+            else
+            {
+                iLinkCost [1] = (uint32_t) ((int32_t) iRSSI0 - (int32_t) iRSSI1);
+            }
+        }
+        /* ... or a fixed cost if the node has only been heard through the
+         * other manager */
+        else if (WB_WIL_PORT_SELECT_RSSI_UNKNOWN != iRSSI1)
+        {
+            iLinkCost [0] = WB_WIL_PORT_SELECT_UNHEARD_COST;
+        }
+        else if (WB_WIL_PORT_SELECT_RSSI_UNKNOWN != iRSSI0)
+        {
+            iLinkCost [1] = WB_WIL_PORT_SELECT_UNHEARD_COST;
+        }
+        else
+        {
+            /* Not heard through either manager, load decides */
+        }
+    }
+}
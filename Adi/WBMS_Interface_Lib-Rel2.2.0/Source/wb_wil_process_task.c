@@ -16,6 +16,8 @@
 #include "wb_wil_ack.h"
 #include "wb_wil_utils.h"
 #include "wb_wil_api.h"
+#include "wb_wil_request_context.h"
+#include "wb_wil_update_monitor_params.h"
 #include "wb_wil_ui.h"
 #include "adi_wil_pack_internals.h"
 #include "wb_assl.h"
@@ -32,6 +34,10 @@ static void wb_wil_ProcessPendingASSLMessages (adi_wil_pack_internals_t * const
                                                adi_wil_port_t const * const pManager0Port,
                                                adi_wil_port_t const * const pManager1Port);
 
+static bool wb_wil_AcquirePortProcessLock (adi_wil_port_t const * const pPort);
+
+static void wb_wil_ReleasePortProcessLock (adi_wil_port_t const * const pPort);
+
 /******************************************************************************
  * Function Definitions
  *****************************************************************************/
@@ -40,22 +46,34 @@ adi_wil_err_t wb_wil_ProcessTaskAPI (adi_wil_pack_internals_t * const pInternals
                                      uint32_t iCurrentTicks)
 {
     adi_wil_err_t rc;
-    adi_wil_pack_t * pLockId;
+    bool bManager0Locked;
+    bool bManager1Locked;
 
     rc = ADI_WIL_ERR_SUCCESS;
 
     /* Proceed only if input is valid */
     if (pInternals != (void *) 0)
     {
-        (void) memset (&pLockId, 0xFF, sizeof (void *));
-        rc = wb_wil_ui_AcquireLock ((void *) 0, (pLockId));
+        /* Each pack has its own process lock, so the process tasks of
+         * different packs never wait on each other */
+        rc = wb_wil_ui_AcquireProcessLock (pInternals);
 
         /* If processing is activated for this pack, perform the processing */
         if (rc == ADI_WIL_ERR_SUCCESS)
         {
             rc = adi_wil_ValidateInstance (pInternals, false);
 
+            /* Lock the pack's ports against QueryDevice processing */
+            bManager0Locked = false;
+            bManager1Locked = false;
+
             if (ADI_WIL_ERR_SUCCESS == rc)
+            {
+                bManager0Locked = wb_wil_AcquirePortProcessLock (pInternals->pManager0Port);
+                bManager1Locked = wb_wil_AcquirePortProcessLock (pInternals->pManager1Port);
+            }
+
+            if ((ADI_WIL_ERR_SUCCESS == rc) && bManager0Locked && bManager1Locked)
             {
                 /* Process manager 0 and 1 separately */
                 if (pInternals->pManager0Port != (void *) 0)
@@ -76,6 +94,8 @@ adi_wil_err_t wb_wil_ProcessTaskAPI (adi_wil_pack_internals_t * const pInternals
 
                 wb_wil_CheckConnectionTimeout (pInternals, iCurrentTicks);
                 wb_wil_api_CheckForTimeout (pInternals, iCurrentTicks);
+                wb_wil_ProcessRequestContexts (pInternals, iCurrentTicks);
+                wb_wil_ProcessUpdateMonitorParameters (pInternals, iCurrentTicks);
 
                 if ((void *) 0 != pInternals->pManager0Port)
                 {
@@ -90,12 +110,27 @@ adi_wil_err_t wb_wil_ProcessTaskAPI (adi_wil_pack_internals_t * const pInternals
                 wb_wil_ProcessPendingASSLMessages (pInternals, pInternals->pManager0Port, pInternals->pManager1Port);
             }
 
-            wb_wil_ui_ReleaseLock ((void *)0, (pLockId));
+            if (bManager0Locked)
+            {
+                wb_wil_ReleasePortProcessLock (pInternals->pManager0Port);
+            }
+
+            if (bManager1Locked)
+            {
+                wb_wil_ReleasePortProcessLock (pInternals->pManager1Port);
+            }
+
+            wb_wil_ui_ReleaseProcessLock (pInternals);
         }
         else if (rc == ADI_WIL_ERR_API_IN_PROGRESS)
         {
             rc = ADI_WIL_ERR_SUCCESS;
         }
+        else if (rc == ADI_WIL_ERR_NOT_CONNECTED)
+        {
+            /* adi_wil_InitializePack has not created the process lock yet */
+            rc = ADI_WIL_ERR_INVALID_PARAMETER;
+        }
         else
         {
             /* MISRA else */
@@ -162,8 +197,15 @@ static void wb_wil_ProcessPendingASSLMessages (adi_wil_pack_internals_t * const
                                                adi_wil_port_t const * const pManager0Port,
                                                adi_wil_port_t const * const pManager1Port)
 {
+#if defined(ADI_WIL_ASSL_BATCH_ENABLE)
+    uint8_t * Messages [WB_WIL_ASSL_BATCH_MAX];
+    uint8_t DeviceIds [WB_WIL_ASSL_BATCH_MAX];
+    uint8_t iCount;
+    uint8_t i;
+#else
     uint8_t * pMessage;
     uint8_t iDeviceId;
+#endif
     bool bProcessTaskRequestPending;
 
     bProcessTaskRequestPending = false;
@@ -189,11 +231,74 @@ static void wb_wil_ProcessPendingASSLMessages (adi_wil_pack_internals_t * const
     /* Check if process task message is not pending on either port */
     if (!bProcessTaskRequestPending)
     {
+#if defined(ADI_WIL_ASSL_BATCH_ENABLE)
+        /* Send the pending safety command and heartbeat in one frame rather
+         * than one per process task cycle */
+        iCount = wb_assl_GetPendingMessages (pInternals->pPack, Messages, DeviceIds, WB_WIL_ASSL_BATCH_MAX);
+
+        if (iCount > 0u)
+        {
+            /* Only messages that reached the transport count towards the
+             * transmit statistics */
+            if (ADI_WIL_ERR_SUCCESS == wb_wil_ASSLSendDataBatchRequest (pInternals, Messages, DeviceIds, iCount))
+            {
+                wb_assl_RecordTx (pInternals->pPack, Messages, iCount);
+            }
+
+            for (i = 0u; i < iCount; i++)
+            {
+                wb_assl_ReleaseBuffer (pInternals->pPack, Messages [i]);
+            }
+        }
+#else
         if (wb_assl_GetPendingMessage (pInternals->pPack, &pMessage, &iDeviceId))
         {
-            (void) wb_wil_ASSLSendDataRequest (pInternals, pMessage, iDeviceId);
+            /* Only messages that reached the transport count towards the
+             * transmit statistics */
+            if (ADI_WIL_ERR_SUCCESS == wb_wil_ASSLSendDataRequest (pInternals, pMessage, iDeviceId))
+            {
+                wb_assl_RecordTx (pInternals->pPack, &pMessage, 1u);
+            }
 
             wb_assl_ReleaseBuffer (pInternals->pPack, pMessage);
         }
+#endif
+    }
+}
+
+static bool wb_wil_AcquirePortProcessLock (adi_wil_port_t const * const pPort)
+{
+    bool bLocked;
+
+    /* A missing port needs no lock */
+    if ((void *) 0 == pPort)
+    {
+        bLocked = true;
+    }
+    else if (ADI_WIL_ERR_SUCCESS != wb_wil_ui_AcquireProcessLock (pPort))
+    {
+        /* Port busy in another process task this pass */
+        bLocked = false;
+    }
+    else if (pPort->Internals.QueryDeviceState.bInProgress)
+    {
+        /* QueryDevice owns the port until it completes, leave it to
+         * wb_nil_ProcessAllPorts */
+        wb_wil_ui_ReleaseProcessLock (pPort);
+        bLocked = false;
+    }
+    else
+    {
+        bLocked = true;
+    }
+
+    return bLocked;
+}
+
+static void wb_wil_ReleasePortProcessLock (adi_wil_port_t const * const pPort)
+{
+    if ((void *) 0 != pPort)
+    {
+        wb_wil_ui_ReleaseProcessLock (pPort);
     }
 }
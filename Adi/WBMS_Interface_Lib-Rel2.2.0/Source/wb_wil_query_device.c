@@ -79,7 +79,8 @@ adi_wil_err_t wb_wil_QueryDeviceAPI (adi_wil_port_t * const pPort)
                  * QueryDevice */
                 if (ADI_WIL_ERR_API_IN_PROGRESS != rc)
                 {
-                    pPort->Internals.QueryDeviceState.bPackLockAcquired = true;
+                    /* Only a lock that was actually taken is released later */
+                    pPort->Internals.QueryDeviceState.bPackLockAcquired = (ADI_WIL_ERR_SUCCESS == rc);
                     rc = ADI_WIL_ERR_SUCCESS;
                 }
             }
@@ -105,20 +106,43 @@ adi_wil_err_t wb_wil_QueryDeviceAPI (adi_wil_port_t * const pPort)
                 rc = wb_nil_InitPort (NULL, pPort);
             }
 
+            /* Hold the port's process lock while QueryDevice takes the port
+             * over, so the owning pack's process task is not mid-pass on
+             * it */
             if (ADI_WIL_ERR_SUCCESS == rc)
             {
-                pPort->Internals.QueryDeviceState.bInProgress = true;
-                pPort->Internals.QueryDeviceState.iRetries = 0u;
+                rc = wb_wil_ui_CreateProcessLock (pPort);
+            }
 
-                wb_wil_QueryDeviceFunc (pPort);
+            if (ADI_WIL_ERR_SUCCESS == rc)
+            {
+                rc = wb_wil_ui_AcquireProcessLock (pPort);
+
+                if (ADI_WIL_ERR_SUCCESS == rc)
+                {
+                    pPort->Internals.QueryDeviceState.bInProgress = true;
+                    pPort->Internals.QueryDeviceState.iRetries = 0u;
+
+                    wb_wil_QueryDeviceFunc (pPort);
+
+                    wb_wil_ui_ReleaseProcessLock (pPort);
+                }
+                else if (!pPort->Internals.QueryDeviceState.bDeviceExists)
+                {
+                    /* Undo the port initialization above */
+                    (void) wb_nil_ClosePort (pPort);
+                }
+                else
+                {
+                    /* MISRA else */
+                }
             }
         }
 
         /* Check the result from the previous operation. If it's non success
-         * and it's not in progress, then something else went wrong, so we
-         * release all the locks */
-        if ((ADI_WIL_ERR_SUCCESS != rc) &&
-            (ADI_WIL_ERR_API_IN_PROGRESS != rc))
+         * then something else went wrong, so we release all the locks that
+         * were acquired */
+        if (ADI_WIL_ERR_SUCCESS != rc)
         {
             /* Check we acquired the pack level lock previously */
             if (pPort->Internals.QueryDeviceState.bPackLockAcquired && 
@@ -26,6 +26,7 @@
 #include "wb_req_get_file.h"
 #include "wb_req_otap_data.h"
 #include "adi_wil_pack_internals.h"
+#include "wb_wil_request_context.h"
 #include "wbms_port_config.h"
 #include "adi_wil_file.h"
 #include "wb_req_set_mon_params_data.h"
@@ -39,6 +40,7 @@
 #include "wb_wil_utils.h"
 #include "wb_wil_api.h"
 #include "wb_wil_device.h"
+#include "wb_wil_port_select.h"
 #include "wb_packer.h"
 #include "wb_pack_cmd.h"
 #include "wb_pack_cmd_mgr.h"
@@ -68,6 +70,13 @@
 /** @brief Pre-calculated constant for 64-bit De Bruijn Log2 */
 #define ADI_WIL_REQUEST_DEBRUJIN_SEQ (0x7EDD5E59A4E28C2ULL)
 
+/** @brief Length of one SendData packet carrying an ASSL message */
+#define ADI_WIL_REQUEST_ASSL_PACKET_LEN (WBMS_PACKET_HDR_SIZE + WBMS_CMD_REQ_SEND_DATA_LEN + ADI_WIL_MAX_APP_PAYLOAD_SIZE)
+
+#if ((WB_WIL_ASSL_BATCH_MAX * ADI_WIL_REQUEST_ASSL_PACKET_LEN) > WBMS_FRAME_PAYLOAD_MAX_SIZE)
+#error "ASSL batch exceeds the frame payload size."
+#endif
+
 /******************************************************************************
  * Typedefs
  *****************************************************************************/
@@ -84,10 +93,13 @@ typedef struct {
  * Static function declarations
  *****************************************************************************/
 
-static bool wb_wil_SetTargetForRequest (adi_wil_pack_internals_t * const pInternals,
+static bool wb_wil_SetTargetForRequest (adi_wil_pack_internals_t const * const pInternals,
+                                        adi_wil_cmd_state_t * const pState,
                                         adi_wil_target_t const ValidTargets [],
                                         uint8_t iTargetCount);
 
+static bool wb_wil_CheckPortFrameAvailable (adi_wil_port_t const * const pPort);
+
 static bool wb_wil_ValidateTargetExists (adi_wil_pack_internals_t const * const pInternals,
                                          adi_wil_device_t iDeviceId,
                                          adi_wil_target_t eTarget);
@@ -96,7 +108,7 @@ static bool wb_wil_ValidateTargetAllowed (adi_wil_target_t eTarget,
                                           adi_wil_target_t const ValidTargets [],
                                           uint8_t iTargetCount);
 
-static void wb_wil_WriteSendDataRequest (adi_wil_pack_internals_t const * const pInternals,
+static void wb_wil_WriteSendDataRequest (adi_wil_pack_internals_t * const pInternals,
                                          wb_pack_element_t * pElement,
                                          wb_request_message_details_t const * const pMessageDetails,
                                          wb_request_message_details_t * const pSendDataDetails);
@@ -116,7 +128,7 @@ static void wb_wil_AppendPayload (wb_request_message_details_t * const pMessageD
                                   uint8_t const * const pSource,
                                   uint8_t iLength);
 
-static adi_wil_err_t wb_wil_SubmitBuffer (adi_wil_pack_internals_t const * const pInternals,
+static adi_wil_err_t wb_wil_SubmitBuffer (adi_wil_pack_internals_t * const pInternals,
                                           adi_wil_port_t * const pPort,
                                           wb_pack_element_t * const pElement,
                                           wb_request_message_details_t const * const pMessageDetails);
@@ -126,8 +138,6 @@ static void adi_wil_PrepareElementForSubmission (wb_pack_element_t * const pElem
 
 static adi_wil_port_t * adi_wil_SelectPort (adi_wil_pack_internals_t * const pInternals);
 
-static adi_wil_port_t * adi_wil_SelectPortForNodeTarget (adi_wil_pack_internals_t * const pInternals);
-
 static uint8_t wb_wil_GetNetworkDeviceId (uint64_t iDeviceId);
 
 static bool wb_wil_CheckDeviceSingleTarget (uint64_t iDeviceId);
@@ -162,6 +172,7 @@ adi_wil_err_t wb_wil_SetupRequest (adi_wil_pack_internals_t * const pInternals,
 
         /* Check the targeted device exists, and is allowed. Sets eTarget and response mask */
         if (!wb_wil_SetTargetForRequest (pInternals,
+                                         &pInternals->UserRequestState,
                                          ValidTargets,
                                          iTargetCount))
         {
@@ -193,6 +204,95 @@ adi_wil_err_t wb_wil_SetupRequest (adi_wil_pack_internals_t * const pInternals,
     return rc;
 }
 
+adi_wil_err_t wb_wil_SetupRequestContext (adi_wil_pack_internals_t * const pInternals,
+                                          adi_wil_request_context_t * const pContext,
+                                          uint64_t iDeviceId,
+                                          uint8_t iTargetCount,
+                                          adi_wil_target_t const ValidTargets [])
+{
+    /* Return value of this function */
+    adi_wil_err_t rc;
+
+    /* Validate input parameters before dereferencing */
+    if (((void *) 0 == pInternals) ||
+        ((void *) 0 == pContext))
+    {
+        rc = ADI_WIL_ERR_INVALID_PARAMETER;
+    }
+    else
+    {
+        /* Store context request Device Id */
+        pContext->Request.iDeviceId = iDeviceId;
+
+        /* Check the targeted device exists, and is allowed. Sets eTarget and response mask */
+        if (!wb_wil_SetTargetForRequest (pInternals,
+                                         &pContext->Request,
+                                         ValidTargets,
+                                         iTargetCount))
+        {
+            rc = ADI_WIL_ERR_INVALID_PARAMETER;
+        }
+        else
+        {
+            /* Tokens are drawn from the user request counter so a context
+             * token never matches a recent exclusive request */
+            wb_wil_IncrementWithRollover16 (&pInternals->UserRequestState.iToken);
+
+            /* If we rolled over, increment it again so the token is now non-zero */
+            if (pInternals->UserRequestState.iToken == 0u)
+            {
+                wb_wil_IncrementWithRollover16 (&pInternals->UserRequestState.iToken);
+            }
+
+            pContext->Request.iToken = pInternals->UserRequestState.iToken;
+
+            /* Reset parameters used for retrying a request */
+            pContext->Request.iRetries = 0u;
+            pContext->Request.bPartialSuccess = false;
+            pContext->Request.bValid = false;
+            pContext->Request.pfRequestFunc = (void *) 0;
+
+            /* Mark operation as success */
+            rc = ADI_WIL_ERR_SUCCESS;
+        }
+    }
+
+    /* Return response code */
+    return rc;
+}
+
+bool wb_wil_CheckRequestFrameAvailable (adi_wil_pack_internals_t const * const pInternals,
+                                        uint64_t iDeviceId)
+{
+    /* Return value of this function */
+    bool bAvailable;
+
+    /* Validate input parameter before dereferencing */
+    if ((void *) 0 == pInternals)
+    {
+        bAvailable = false;
+    }
+    /* Node requests go out on whichever port SelectPort () picks next, so
+     * both must be free */
+    else if (wb_wil_CheckNodeTarget (iDeviceId))
+    {
+        bAvailable = wb_wil_CheckPortFrameAvailable (pInternals->pManager0Port) &&
+                     (((void *) 0 == pInternals->pManager1Port) ||
+                      wb_wil_CheckPortFrameAvailable (pInternals->pManager1Port));
+    }
+    /* Manager requests always use their own port */
+    else if (iDeviceId == ADI_WIL_DEV_MANAGER_1)
+    {
+        bAvailable = wb_wil_CheckPortFrameAvailable (pInternals->pManager1Port);
+    }
+    else
+    {
+        bAvailable = wb_wil_CheckPortFrameAvailable (pInternals->pManager0Port);
+    }
+
+    return bAvailable;
+}
+
 adi_wil_err_t wb_wil_ClearPendingResponse (adi_wil_pack_internals_t * const pInternals,
                                            uint64_t iDeviceId)
 {
@@ -1559,7 +1659,7 @@ adi_wil_err_t wb_wil_ASSLSendDataRequest (adi_wil_pack_internals_t * const pInte
     else
     {
         /* Obtain the port to transmit wirelessly on */
-        pPort = adi_wil_SelectPortForNodeTarget (pInternals);
+        pPort = wb_wil_PortSelectForNode (pInternals, iDeviceId);
 
         /* Attempt to get a buffer from this port */
         if ((void *) 0 == pPort)
@@ -1599,6 +1699,124 @@ adi_wil_err_t wb_wil_ASSLSendDataRequest (adi_wil_pack_internals_t * const pInte
 
             /* Submit the buffer for transmission */
             rc = wb_nil_SubmitFrame (pPort, &Element);
+
+            if (ADI_WIL_ERR_SUCCESS == rc)
+            {
+                wb_wil_PortSelectRecordSubmit (pInternals, pPort, 1u);
+            }
+        }
+    }
+
+    /* Return response code */
+    return rc;
+}
+
+adi_wil_err_t wb_wil_ASSLSendDataBatchRequest (adi_wil_pack_internals_t * const pInternals,
+                                               uint8_t * const pMessages [],
+                                               uint8_t const DeviceIds [],
+                                               uint8_t iCount)
+{
+    /* SendData Header, device ID updated for each message */
+    wbms_cmd_req_send_data_t Request = { .iToken = 0u,
+                                         .iDeviceId = 0u,
+                                         .iLength = ADI_WIL_MAX_APP_PAYLOAD_SIZE,
+                                         .iHighPriority = 1u,
+                                         .iPortId = WB_SCL_PORT_ID };
+
+    /* Storage for Payload pointer */
+    uint8_t * pData;
+
+    /* Variable for storing message packing details */
+    wb_pack_element_t Element;
+
+    /* Variable for storing port to send message on */
+    adi_wil_port_t * pPort;
+
+    /* Offset of the packet being written in the frame */
+    uint16_t iPacketOffset;
+
+    /* Loop variable for iterating over the messages */
+    uint8_t i;
+
+    /* Return value of this function */
+    adi_wil_err_t rc;
+
+    /* Validate input params */
+    if (((void *) 0 == pInternals) || ((void *) 0 == pMessages) || ((void *) 0 == DeviceIds) ||
+        (0u == iCount) || (iCount > WB_WIL_ASSL_BATCH_MAX))
+    {
+        rc = ADI_WIL_ERR_INVALID_PARAMETER;
+    }
+    else
+    {
+        /* A single message keeps its node target for the port selection,
+         * a batch is weighed as a request to any node */
+        pPort = wb_wil_PortSelectForNode (pInternals, (1u == iCount) ? DeviceIds [0] : WB_WIL_PORT_SELECT_ANY_NODE);
+
+        if ((void *) 0 == pPort)
+        {
+            rc = ADI_WIL_ERR_INVALID_PARAMETER;
+        }
+        else
+        {
+            /* Clear Element's internals prior to use */
+            (void) memset (&Element, 0, sizeof (Element));
+
+            /* Initialize Element and Packer internals */
+            Element.origin = &pPort->Internals.ProcessTaskRequestFrame [0];
+            Element.packer.buf = Element.origin;
+            Element.packer.direction = WB_PACK_WRITE;
+
+            /* Clear contents of buffer before use */
+            (void) memset (Element.origin, 0, ADI_WIL_SPI_TRANSACTION_SIZE);
+
+            /* First packet follows the frame header */
+            iPacketOffset = WBMS_FRAME_HDR_LEN;
+
+            rc = ADI_WIL_ERR_SUCCESS;
+
+            /* Write one SendData packet per message. Each message keeps the
+             * SCL header and CRC it was written with, only the transport
+             * submission is shared */
+            for (i = 0u; (i < iCount) && (ADI_WIL_ERR_SUCCESS == rc); i++)
+            {
+                if ((void *) 0 == pMessages [i])
+                {
+                    rc = ADI_WIL_ERR_INVALID_PARAMETER;
+                }
+                else
+                {
+                    /* Write the packet header */
+                    Element.origin [iPacketOffset + 0u] = WBMS_CMD_SEND_DATA;
+                    Element.origin [iPacketOffset + 1u] = WBMS_CMD_REQ_SEND_DATA_LEN + ADI_WIL_MAX_APP_PAYLOAD_SIZE;
+
+                    /* Write the SendData header behind the packet header */
+                    Request.iDeviceId = DeviceIds [i];
+                    Element.packer.index = iPacketOffset + WBMS_PACKET_HDR_SIZE;
+                    wb_pack_SendDataReq (&Element, &Request, &pData);
+
+                    /* Copy the SCL message in as the SendData payload */
+                    (void) memcpy (pData, pMessages [i], ADI_WIL_MAX_APP_PAYLOAD_SIZE);
+
+                    iPacketOffset += ADI_WIL_REQUEST_ASSL_PACKET_LEN;
+                }
+            }
+
+            if (ADI_WIL_ERR_SUCCESS == rc)
+            {
+                /* Frame payload holds all packets, size adds the frame header */
+                Element.data = iPacketOffset - WBMS_FRAME_HDR_LEN;
+                Element.size = iPacketOffset;
+
+                /* Submit the buffer for transmission */
+                rc = wb_nil_SubmitFrame (pPort, &Element);
+            }
+
+            /* Each packet of the batch is answered separately */
+            if (ADI_WIL_ERR_SUCCESS == rc)
+            {
+                wb_wil_PortSelectRecordSubmit (pInternals, pPort, iCount);
+            }
         }
     }
 
@@ -1610,7 +1828,8 @@ adi_wil_err_t wb_wil_ASSLSendDataRequest (adi_wil_pack_internals_t * const pInte
  * Static function definitions
  *****************************************************************************/
 
-static bool wb_wil_SetTargetForRequest (adi_wil_pack_internals_t * const pInternals,
+static bool wb_wil_SetTargetForRequest (adi_wil_pack_internals_t const * const pInternals,
+                                        adi_wil_cmd_state_t * const pState,
                                         adi_wil_target_t const ValidTargets [],
                                         uint8_t iTargetCount)
 {
@@ -1621,37 +1840,37 @@ static bool wb_wil_SetTargetForRequest (adi_wil_pack_internals_t * const pIntern
     bValid = false;
 
     /* Clear any existing pending responses */
-    pInternals->UserRequestState.iPendingResponses = 0u;
+    pState->iPendingResponses = 0u;
 
     /* Check if device ID only contains either nodes or managers */
-    if (!wb_wil_CheckExclusiveTarget (pInternals->UserRequestState.iDeviceId))
+    if (!wb_wil_CheckExclusiveTarget (pState->iDeviceId))
     {
         /* Do nothing - return failure */
     }
-    else if (wb_wil_CheckNodeTarget (pInternals->UserRequestState.iDeviceId))
+    else if (wb_wil_CheckNodeTarget (pState->iDeviceId))
     {
         /* Check if it's for a single node... */
-        if (wb_wil_CheckDeviceSingleTarget (pInternals->UserRequestState.iDeviceId))
+        if (wb_wil_CheckDeviceSingleTarget (pState->iDeviceId))
         {
-            pInternals->UserRequestState.eTarget = ADI_WIL_TARGET_SINGLE_NODE;
+            pState->eTarget = ADI_WIL_TARGET_SINGLE_NODE;
 
             /* Set the singular bit in the mask */
-            pInternals->UserRequestState.iPendingResponses = pInternals->UserRequestState.iDeviceId;
+            pState->iPendingResponses = pState->iDeviceId;
         }
         /* Else, it's for all nodes */
         else
         {
-            pInternals->UserRequestState.eTarget = ADI_WIL_TARGET_ALL_NODES;
+            pState->eTarget = ADI_WIL_TARGET_ALL_NODES;
 
             /* Set the pending responses to map to all nodes currently in the ACL */
             if (pInternals->NodeState.iCount != 0u)
             {
-                pInternals->UserRequestState.iPendingResponses = 0xFFFFFFFFFFFFFFFFULL >> (64u - pInternals->NodeState.iCount);
+                pState->iPendingResponses = 0xFFFFFFFFFFFFFFFFULL >> (64u - pInternals->NodeState.iCount);
             }
             /* If we have no nodes in the ACL, set pending responses to nothing */
             else
             {
-                pInternals->UserRequestState.iPendingResponses = 0ULL;
+                pState->iPendingResponses = 0ULL;
             }
         }
     }
@@ -1659,37 +1878,37 @@ static bool wb_wil_SetTargetForRequest (adi_wil_pack_internals_t * const pIntern
     else
     {
         /* Check if it's for a single manager... */
-        if (wb_wil_CheckDeviceSingleTarget (pInternals->UserRequestState.iDeviceId))
+        if (wb_wil_CheckDeviceSingleTarget (pState->iDeviceId))
         {
-            pInternals->UserRequestState.eTarget = ADI_WIL_TARGET_SINGLE_MANAGER;
+            pState->eTarget = ADI_WIL_TARGET_SINGLE_MANAGER;
 
             /* Set the singular bit in the mask */
-            pInternals->UserRequestState.iPendingResponses = pInternals->UserRequestState.iDeviceId;
+            pState->iPendingResponses = pState->iDeviceId;
         }
         /* Else, it's for all managers */
         else
         {
-            pInternals->UserRequestState.eTarget = ADI_WIL_TARGET_ALL_MANAGERS;
+            pState->eTarget = ADI_WIL_TARGET_ALL_MANAGERS;
 
             /* Always set the singular bit in the mask for manager 0 */
-            pInternals->UserRequestState.iPendingResponses |= (1ULL << ADI_WIL_REQUEST_MANAGER_0_BITP);
+            pState->iPendingResponses |= (1ULL << ADI_WIL_REQUEST_MANAGER_0_BITP);
 
             /* If Manager 1 exists, set the bit for it too */
             if ((void *) 0 != pInternals->pManager1Port)
             {
-                pInternals->UserRequestState.iPendingResponses |= (1ULL << ADI_WIL_REQUEST_MANAGER_1_BITP);
+                pState->iPendingResponses |= (1ULL << ADI_WIL_REQUEST_MANAGER_1_BITP);
             }
         }
     }
 
     /* Check the target device exists... */
     if (wb_wil_ValidateTargetExists (pInternals,
-                                     pInternals->UserRequestState.iDeviceId,
-                                     pInternals->UserRequestState.eTarget))
+                                     pState->iDeviceId,
+                                     pState->eTarget))
     {
         /* If the above steps were successful, check that this request
          * is allowed to be called with this device id */
-        bValid = wb_wil_ValidateTargetAllowed (pInternals->UserRequestState.eTarget,
+        bValid = wb_wil_ValidateTargetAllowed (pState->eTarget,
                                                ValidTargets,
                                                iTargetCount);
     }
@@ -1832,7 +2051,7 @@ static bool wb_nil_GetBufferFromPack (adi_wil_pack_internals_t * const pInternal
         /* If we were successful, and the intended target is for a node, set
          * the current offset in the element to hold space for a SendData
          * header + command ID */
-        if (bSuccess && wb_wil_CheckNodeTarget (pInternals->UserRequestState.iDeviceId))
+        if (bSuccess && wb_wil_CheckNodeTarget (wb_wil_GetSubmittingRequestState (pInternals)->iDeviceId))
         {
             pElement->packer.index = WBMS_FRAME_HDR_LEN + WBMS_PACKET_HDR_SIZE + WBMS_CMD_REQ_SEND_DATA_LEN + WBMS_PACKET_CMD_ID_LEN;
         }
@@ -1846,14 +2065,21 @@ static adi_wil_port_t * adi_wil_SelectPort (adi_wil_pack_internals_t * const pIn
     /* Return value of this function */
     adi_wil_port_t * pPort;
 
-    /* If the request is to be sent to the nodes select either connected port */
-    if (wb_wil_CheckNodeTarget (pInternals->UserRequestState.iDeviceId))
+    /* Target of the request being built */
+    uint64_t iDeviceId;
+
+    iDeviceId = wb_wil_GetSubmittingRequestState (pInternals)->iDeviceId;
+
+    /* If the request is to be sent to the nodes select either connected port,
+     * weighing the link to the node for a single node target */
+    if (wb_wil_CheckNodeTarget (iDeviceId))
     {
-        pPort = adi_wil_SelectPortForNodeTarget (pInternals);
+        pPort = wb_wil_PortSelectForNode (pInternals,
+                                          wb_wil_CheckDeviceSingleTarget (iDeviceId) ? wb_wil_GetNetworkDeviceId (iDeviceId) : WB_WIL_PORT_SELECT_ANY_NODE);
     }
     /* ... else, we've got a manager target which must always go to the
      * designated port selected in SetupRequest (). Check for manager 1 */
-    else if (pInternals->UserRequestState.iDeviceId == ADI_WIL_DEV_MANAGER_1)
+    else if (iDeviceId == ADI_WIL_DEV_MANAGER_1)
     {
         pPort = pInternals->pManager1Port;
     }
@@ -1868,67 +2094,6 @@ static adi_wil_port_t * adi_wil_SelectPort (adi_wil_pack_internals_t * const pIn
     return pPort;
 }
 
-static adi_wil_port_t * adi_wil_SelectPortForNodeTarget (adi_wil_pack_internals_t * const pInternals)
-{
-    /* Return value of this function */
-    adi_wil_port_t * pPort;
-
-    /* Initialize return value to NULL */
-    pPort = (void *) 0;
-
-    /* Validate the port is non-null before dereferencing */
-    if (pInternals->pCurrentPort != (void *) 0)
-    {
-        /* If the expected current port is connected, select it... */
-        if (pInternals->pCurrentPort->Internals.bConnected)
-        {
-            pPort = pInternals->pCurrentPort;
-
-            /* If Manager 1 exists, select it for transmission for the next
-             * message to the nodes */
-            if ((pInternals->pCurrentPort == pInternals->pManager0Port) &&
-                (pInternals->pManager1Port != (void *) 0))
-            {
-                pInternals->pCurrentPort = pInternals->pManager1Port;
-            }
-            /* Else, manager 1 does not exist or manager 1 was just selected,
-             * so select manager 0 for the next transmission */
-            else
-            {
-                pInternals->pCurrentPort = pInternals->pManager0Port;
-            }
-        }
-        /* Else, at least one port is not connected. Check if manager 0
-         * is connected */
-        else
-        {
-            /* Validate that the port is not null before dereferencing */
-            if (pInternals->pManager0Port != (void *) 0)
-            {
-                if (pInternals->pManager0Port->Internals.bConnected)
-                {
-                    /* Select Manager 0 for transmission */
-                    pPort = pInternals->pManager0Port;
-                }
-            }
-            /* If pPort is still null, it's Manager 0 that's not connected so check if
-             * Manager 1 exists... */
-            if ((pPort == (void *) 0) &&
-                (pInternals->pManager1Port != (void *) 0))
-            {
-                /* Check if Manager 1 is connected... */
-                if (pInternals->pManager1Port->Internals.bConnected)
-                {
-                    /* Select Manager 0 for transmission */
-                    pPort = pInternals->pManager1Port;
-                }
-            }
-        }
-    }
-
-    return pPort;
-}
-
 static void wb_wil_AppendPayload (wb_request_message_details_t * const pMessageDetails,
                                   wb_pack_element_t * const pElement,
                                   uint8_t * const pDestination,
@@ -1948,7 +2113,7 @@ static void wb_wil_AppendPayload (wb_request_message_details_t * const pMessageD
     }
 }
 
-static adi_wil_err_t wb_wil_SubmitBuffer (adi_wil_pack_internals_t const * const pInternals,
+static adi_wil_err_t wb_wil_SubmitBuffer (adi_wil_pack_internals_t * const pInternals,
                                           adi_wil_port_t * const pPort,
                                           wb_pack_element_t * const pElement,
                                           wb_request_message_details_t const * const pMessageDetails)
@@ -1962,8 +2127,13 @@ static adi_wil_err_t wb_wil_SubmitBuffer (adi_wil_pack_internals_t const * const
     /* Return value of this function */
     adi_wil_err_t rc;
 
+    /* Request being submitted */
+    adi_wil_cmd_state_t const * pState;
+
+    pState = wb_wil_GetSubmittingRequestState (pInternals);
+
     /* If it's a node target prepare the element, */
-    if (wb_wil_CheckNodeTarget (pInternals->UserRequestState.iDeviceId))
+    if (wb_wil_CheckNodeTarget (pState->iDeviceId))
     {
         wb_wil_WriteSendDataRequest (pInternals,
                                      pElement,
@@ -1975,6 +2145,11 @@ static adi_wil_err_t wb_wil_SubmitBuffer (adi_wil_pack_internals_t const * const
 
         /* Submit the buffer for transmission */
         rc = wb_nil_SubmitFrame (pPort, pElement);
+
+        if (ADI_WIL_ERR_SUCCESS == rc)
+        {
+            wb_wil_PortSelectRecordSubmit (pInternals, pPort, 1u);
+        }
     }
     else
     {
@@ -1994,7 +2169,7 @@ static adi_wil_err_t wb_wil_SubmitBuffer (adi_wil_pack_internals_t const * const
          */
         if (pMessageDetails->bUserRequestContext &&
             (ADI_WIL_ERR_SUCCESS == rc) &&
-            (ADI_WIL_TARGET_ALL_MANAGERS == pInternals->UserRequestState.eTarget) &&
+            (ADI_WIL_TARGET_ALL_MANAGERS == pState->eTarget) &&
             ((void *) 0 != pInternals->pManager0Port) &&
             ((void *) 0 != pInternals->pManager1Port))
         {
@@ -2038,7 +2213,7 @@ static void adi_wil_PrepareElementForSubmission (wb_pack_element_t * const pElem
     }
 }
 
-static void wb_wil_WriteSendDataRequest (adi_wil_pack_internals_t const * const pInternals,
+static void wb_wil_WriteSendDataRequest (adi_wil_pack_internals_t * const pInternals,
                                          wb_pack_element_t * pElement,
                                          wb_request_message_details_t const * const pMessageDetails,
                                          wb_request_message_details_t * const pSendDataDetails)
@@ -2046,9 +2221,12 @@ static void wb_wil_WriteSendDataRequest (adi_wil_pack_internals_t const * const
     /* Local storage for Message Id to pass to non-const function */
     uint8_t iMessageId = pMessageDetails->iMessageId;
 
+    /* Request being submitted */
+    adi_wil_cmd_state_t const * pState = wb_wil_GetSubmittingRequestState (pInternals);
+
     /* Initialize SendData Header */
     wbms_cmd_req_send_data_t Request = { .iToken = 0u,
-                                         .iDeviceId = wb_wil_GetNetworkDeviceId (pInternals->UserRequestState.iDeviceId),
+                                         .iDeviceId = wb_wil_GetNetworkDeviceId (pState->iDeviceId),
                                          .iHighPriority = 1u,
                                          .iPortId = WB_OPCMD_PORT_ID };
 
@@ -2063,7 +2241,7 @@ static void wb_wil_WriteSendDataRequest (adi_wil_pack_internals_t const * const
         /* If the SendData request is using the token, set it in the structure */
         if (pMessageDetails->bUseTokenForSendData)
         {
-            Request.iToken = pInternals->UserRequestState.iToken;
+            Request.iToken = pState->iToken;
         }
 
         /* Set SendData length field to include the length of the message payload */
@@ -2083,6 +2261,15 @@ static void wb_wil_WriteSendDataRequest (adi_wil_pack_internals_t const * const
     }
 }
 
+static bool wb_wil_CheckPortFrameAvailable (adi_wil_port_t const * const pPort)
+{
+    /* A port can take a new user request once the previous one has been
+     * clocked out */
+    return ((void *) 0 != pPort) &&
+           pPort->Internals.bConnected &&
+           !pPort->Internals.bUserRequestFramePending;
+}
+
 static bool wb_wil_CheckDeviceSingleTarget (uint64_t iDeviceId)
 {
     /* Check if a single bit (target) is set */
@@ -0,0 +1,444 @@
+/******************************************************************************
+ * @file    wb_wil_request_context.c
+ *
+ * @brief   Concurrent single device request contexts
+ *
+ * @details Read-only requests to a single device (GetDeviceVersion,
+ *          GetFileCRC, GetGPIO, GetContextualData, GetFileStream) take one
+ *          of the pack's request locks instead of the exclusive pack lock.
+ *          Each one owns a context with its own token, timer and retry count,
+ *          so requests to different devices overlap. Only one request per
+ *          device is in flight at a time, matching the one command buffer a
+ *          device has. Contexts are transmitted from the process task as soon
+ *          as the user request frame of their port is free. A transfer that
+ *          takes several requests requeues its context with a new token for
+ *          each one.
+ *
+ * Copyright (c) 2022 Analog Devices, Inc. All Rights Reserved.
+ * This software is proprietary to Analog Devices, Inc. and its licensors.
+ *****************************************************************************/
+
+#include "wb_wil_request_context.h"
+#include "wb_wil_request.h"
+#include "wb_wil_ui.h"
+#include "wb_wil_utils.h"
+#include "adi_wil_pack_internals.h"
+#include "adi_wil_hal_ticker.h"
+#include <string.h>
+
+/******************************************************************************
+ * #defines
+ *****************************************************************************/
+
+#define WB_WIL_REQUEST_CONTEXT_JITTER_TOLERANCE (5u)
+
+/******************************************************************************
+ * Static function declarations
+ *****************************************************************************/
+
+static bool wb_wil_CheckRequestContextElapsed (uint32_t iStartTime,
+                                               uint32_t iCurrentTime,
+                                               uint32_t iTimeout);
+
+static bool wb_wil_CheckRequestContextDeviceBusy (adi_wil_pack_internals_t const * const pInternals,
+                                                  uint8_t iSlot,
+                                                  uint64_t iDeviceId);
+
+static void wb_wil_UpdateRequestContextStats (adi_wil_pack_internals_t * const pInternals);
+
+/******************************************************************************
+ * Public functions
+ *****************************************************************************/
+
+adi_wil_err_t wb_wil_AcquireRequestContext (adi_wil_pack_internals_t * const pInternals,
+                                            adi_wil_api_t eAPI,
+                                            uint64_t iDeviceId,
+                                            uint8_t iParameter,
+                                            uint8_t iTargetCount,
+                                            adi_wil_target_t const ValidTargets [],
+                                            adi_wil_request_context_func_t pfRequestFunc,
+                                            adi_wil_request_context_t ** ppContext)
+{
+    /* Return value of this function */
+    adi_wil_err_t rc;
+
+    /* Index of the request lock, and context, claimed */
+    uint8_t iSlot;
+
+    /* Context claimed */
+    adi_wil_request_context_t * pContext;
+
+    /* Initialize local variables */
+    iSlot = 0u;
+
+    /* Validate input parameters before dereferencing */
+    if (((void *) 0 == pInternals) ||
+        ((void *) 0 == pfRequestFunc) ||
+        ((void *) 0 == ppContext))
+    {
+        rc = ADI_WIL_ERR_INVALID_PARAMETER;
+    }
+    else
+    {
+        /* Claim a request lock - fails while an exclusive API is running or
+         * every context is in use */
+        rc = wb_wil_ui_AcquireRequestLock (pInternals->pPack, pInternals->pPack, &iSlot);
+    }
+
+    if (ADI_WIL_ERR_SUCCESS == rc)
+    {
+        pContext = &pInternals->RequestPool.Contexts [iSlot];
+
+        /* A request lock reclaimed by its timer can come back while its
+         * context is still in use, leave that context alone */
+        if (ADI_WIL_REQUEST_CONTEXT_FREE != pContext->eState)
+        {
+            rc = ADI_WIL_ERR_API_IN_PROGRESS;
+        }
+        /* The device only services one command at a time, keep its requests
+         * in order by refusing a second one */
+        else if (wb_wil_CheckRequestContextDeviceBusy (pInternals, iSlot, iDeviceId))
+        {
+            rc = ADI_WIL_ERR_API_IN_PROGRESS;
+        }
+        else
+        {
+            /* Mark the context busy before it is set up, so no other caller
+             * can claim it or a second request to the same device */
+            pContext->Request.iDeviceId = iDeviceId;
+            pContext->eState = ADI_WIL_REQUEST_CONTEXT_CLAIMED;
+
+            /* Validate the target and take a token */
+            rc = wb_wil_SetupRequestContext (pInternals, pContext, iDeviceId, iTargetCount, ValidTargets);
+
+            if (ADI_WIL_ERR_SUCCESS != rc)
+            {
+                pContext->eState = ADI_WIL_REQUEST_CONTEXT_FREE;
+            }
+        }
+
+        if (ADI_WIL_ERR_SUCCESS == rc)
+        {
+            pContext->pfRequestFunc = pfRequestFunc;
+            pContext->eAPI = eAPI;
+            pContext->iParameter = iParameter;
+
+            *ppContext = pContext;
+        }
+        else
+        {
+            /* Hand the request lock back */
+            wb_wil_ui_ReleaseRequestLock (pInternals->pPack, pInternals->pPack, iSlot);
+        }
+    }
+
+    /* Return response code */
+    return rc;
+}
+
+void wb_wil_QueueRequestContext (adi_wil_request_context_t * const pContext)
+{
+    if ((void *) 0 != pContext)
+    {
+        /* Time spent waiting for a request frame is bounded like a response */
+        pContext->Request.iStartTime = adi_wil_hal_TickerGetTimestamp ();
+        pContext->Request.bValid = false;
+
+        /* Publish the context to the process task last */
+        pContext->eState = ADI_WIL_REQUEST_CONTEXT_QUEUED;
+    }
+}
+
+void wb_wil_ReleaseRequestContext (adi_wil_pack_internals_t * const pInternals,
+                                   adi_wil_request_context_t * const pContext)
+{
+    /* Index of the context, which is also its request lock */
+    uint8_t iSlot;
+
+    if (((void *) 0 != pInternals) && ((void *) 0 != pContext))
+    {
+        iSlot = (uint8_t) (pContext - &pInternals->RequestPool.Contexts [0]);
+
+        /* Stop the context before its request lock can be reclaimed */
+        pContext->Request.bValid = false;
+        pContext->pfRequestFunc = (void *) 0;
+        pContext->eState = ADI_WIL_REQUEST_CONTEXT_FREE;
+
+        wb_wil_ui_ReleaseRequestLock (pInternals->pPack, pInternals->pPack, iSlot);
+    }
+}
+
+adi_wil_err_t wb_wil_RequeueRequestContext (adi_wil_pack_internals_t * const pInternals,
+                                            adi_wil_request_context_t * const pContext)
+{
+    /* Return value of this function */
+    adi_wil_err_t rc;
+
+    /* Target of the request being continued */
+    adi_wil_target_t ValidTargets [1];
+
+    /* Validate input parameters before dereferencing */
+    if (((void *) 0 == pInternals) ||
+        ((void *) 0 == pContext))
+    {
+        rc = ADI_WIL_ERR_INVALID_PARAMETER;
+    }
+    else
+    {
+        /* Take a new token for the same device, so a late response to the
+         * previous request cannot be taken for the next one. This also
+         * checks the device is still in the ACL */
+        ValidTargets [0] = pContext->Request.eTarget;
+
+        rc = wb_wil_SetupRequestContext (pInternals, pContext, pContext->Request.iDeviceId, 1u, ValidTargets);
+    }
+
+    if (ADI_WIL_ERR_SUCCESS == rc)
+    {
+        wb_wil_QueueRequestContext (pContext);
+    }
+
+    /* Return response code */
+    return rc;
+}
+
+void wb_wil_NotifyRequestContext (adi_wil_pack_internals_t * const pInternals,
+                                  adi_wil_request_context_t const * const pContext,
+                                  adi_wil_err_t rc,
+                                  void const * const pData)
+{
+    if (((void *) 0 != pInternals) && ((void *) 0 != pContext))
+    {
+        /* Make the context visible to adi_wil_GetCallbackDeviceId () for the
+         * duration of the callback */
+        pInternals->RequestPool.pCompleting = pContext;
+
+        wb_wil_ui_GenerateCb (pInternals->pPack, pContext->eAPI, rc, pData);
+
+        pInternals->RequestPool.pCompleting = (void *) 0;
+    }
+}
+
+void wb_wil_CompleteRequestContext (adi_wil_pack_internals_t * const pInternals,
+                                    adi_wil_request_context_t * const pContext,
+                                    adi_wil_err_t rc,
+                                    void const * const pData)
+{
+    if (((void *) 0 != pInternals) && ((void *) 0 != pContext))
+    {
+        /* Stop the timer, the request is complete */
+        pContext->Request.bValid = false;
+
+        if (ADI_WIL_ERR_SUCCESS == rc)
+        {
+            /* Generate a callback with the correct response pointer */
+            wb_wil_NotifyRequestContext (pInternals, pContext, rc, pData);
+        }
+        else
+        {
+            /* Because return code is not a success, return null as a response */
+            wb_wil_NotifyRequestContext (pInternals, pContext, rc, (void *) 0);
+        }
+
+        /* Free the context and its request lock */
+        wb_wil_ReleaseRequestContext (pInternals, pContext);
+    }
+}
+
+adi_wil_request_context_t * wb_wil_FindRequestContext (adi_wil_pack_internals_t * const pInternals,
+                                                       uint16_t iToken)
+{
+    /* Return value of this function */
+    adi_wil_request_context_t * pContext;
+
+    /* Initialize return value to no matching context */
+    pContext = (void *) 0;
+
+    if ((void *) 0 != pInternals)
+    {
+        for (uint8_t i = 0u; i < ADI_WIL_MAX_CONCURRENT_REQUESTS; i++)
+        {
+            /* Only a request waiting for its response can match */
+            if ((ADI_WIL_REQUEST_CONTEXT_ACTIVE == pInternals->RequestPool.Contexts [i].eState) &&
+                pInternals->RequestPool.Contexts [i].Request.bValid &&
+                (iToken == pInternals->RequestPool.Contexts [i].Request.iToken))
+            {
+                pContext = &pInternals->RequestPool.Contexts [i];
+
+                /* Stop the response timer, the caller completes or requeues
+                 * the request */
+                pContext->Request.bValid = false;
+                break;
+            }
+        }
+    }
+
+    return pContext;
+}
+
+void wb_wil_ProcessRequestContexts (adi_wil_pack_internals_t * const pInternals,
+                                    uint32_t iCurrentTime)
+{
+    if ((void *) 0 != pInternals)
+    {
+        for (uint8_t i = 0u; i < ADI_WIL_MAX_CONCURRENT_REQUESTS; i++)
+        {
+            wb_wil_ProcessRequestContext (pInternals, &pInternals->RequestPool.Contexts [i], iCurrentTime);
+        }
+
+        wb_wil_UpdateRequestContextStats (pInternals);
+    }
+}
+
+void wb_wil_ProcessRequestContext (adi_wil_pack_internals_t * const pInternals,
+                                   adi_wil_request_context_t * const pContext,
+                                   uint32_t iCurrentTime)
+{
+    if (((void *) 0 != pInternals) && ((void *) 0 != pContext))
+    {
+        /* Response timed out - count a retry and queue a resend */
+        if ((ADI_WIL_REQUEST_CONTEXT_ACTIVE == pContext->eState) &&
+            pContext->Request.bValid &&
+            wb_wil_CheckRequestContextElapsed (pContext->Request.iStartTime,
+                                               iCurrentTime,
+                                               pContext->Request.iTimeout))
+        {
+            wb_wil_IncrementWithRollover8 (&pContext->Request.iRetries);
+            wb_wil_QueueRequestContext (pContext);
+        }
+
+        if (ADI_WIL_REQUEST_CONTEXT_QUEUED == pContext->eState)
+        {
+            /* Transmit once the port can take it. A request that has run
+             * out of retries is handed to its function to complete */
+            if ((pContext->Request.iRetries >= ADI_WIL_RETRIES) ||
+                wb_wil_CheckRequestFrameAvailable (pInternals, pContext->Request.iDeviceId))
+            {
+                pContext->eState = ADI_WIL_REQUEST_CONTEXT_ACTIVE;
+
+                /* Build the request from this context rather than the
+                 * user request state */
+                pInternals->RequestPool.pSubmitting = pContext;
+                pContext->pfRequestFunc (pInternals, pContext);
+                pInternals->RequestPool.pSubmitting = (void *) 0;
+            }
+            /* Waiting for a frame counts against the retries as well, so
+             * a port that stays busy or disconnected cannot hold the
+             * context forever */
+            else if (wb_wil_CheckRequestContextElapsed (pContext->Request.iStartTime,
+                                                        iCurrentTime,
+                                                        ADI_WIL_RESPONSE_TIMEOUT_MS))
+            {
+                wb_wil_IncrementWithRollover8 (&pContext->Request.iRetries);
+                pContext->Request.iStartTime = iCurrentTime;
+            }
+            else
+            {
+                /* MISRA Else */
+            }
+        }
+    }
+}
+
+adi_wil_cmd_state_t * wb_wil_GetSubmittingRequestState (adi_wil_pack_internals_t * const pInternals)
+{
+    /* Requests are built and timed for the user request state unless a
+     * concurrent request context is being transmitted */
+    return ((void *) 0 != pInternals->RequestPool.pSubmitting) ? &pInternals->RequestPool.pSubmitting->Request : &pInternals->UserRequestState;
+}
+
+adi_wil_err_t wb_wil_GetCallbackDeviceIdAPI (adi_wil_pack_internals_t const * const pInternals,
+                                             adi_wil_device_t * const pDeviceId)
+{
+    /* Return value of this function */
+    adi_wil_err_t rc;
+
+    /* Validate input parameters before dereferencing */
+    if (((void *) 0 == pInternals) || ((void *) 0 == pDeviceId))
+    {
+        rc = ADI_WIL_ERR_INVALID_PARAMETER;
+    }
+    /* Only valid inside the callback of a concurrent request */
+    else if ((void *) 0 == pInternals->RequestPool.pCompleting)
+    {
+        rc = ADI_WIL_ERR_FAIL;
+    }
+    else
+    {
+        *pDeviceId = pInternals->RequestPool.pCompleting->Request.iDeviceId;
+        rc = ADI_WIL_ERR_SUCCESS;
+    }
+
+    return rc;
+}
+
+/******************************************************************************
+ * Static functions
+ *****************************************************************************/
+
+static bool wb_wil_CheckRequestContextElapsed (uint32_t iStartTime,
+                                               uint32_t iCurrentTime,
+                                               uint32_t iTimeout)
+{
+    /* Elapsed time since the start time */
+    uint32_t iElapsedTime;
+
+    iElapsedTime = (iCurrentTime - iStartTime);
+
+    if (iElapsedTime < iCurrentTime)
+    {
+        /* CERT-C - Allow rollover as timers are expected to wrap */
+    }
+
+    /* Don't trigger a timeout if we've potentially underflowed by 5ms to
+     * allow for timer jitter */
+    return (iElapsedTime > iTimeout) &&
+           (iElapsedTime < (UINT32_MAX - WB_WIL_REQUEST_CONTEXT_JITTER_TOLERANCE));
+}
+
+static bool wb_wil_CheckRequestContextDeviceBusy (adi_wil_pack_internals_t const * const pInternals,
+                                                  uint8_t iSlot,
+                                                  uint64_t iDeviceId)
+{
+    /* Return value of this function */
+    bool bBusy;
+
+    /* Initialize return value to device not busy */
+    bBusy = false;
+
+    for (uint8_t i = 0u; i < ADI_WIL_MAX_CONCURRENT_REQUESTS; i++)
+    {
+        if ((i != iSlot) &&
+            (ADI_WIL_REQUEST_CONTEXT_FREE != pInternals->RequestPool.Contexts [i].eState) &&
+            (iDeviceId == pInternals->RequestPool.Contexts [i].Request.iDeviceId))
+        {
+            bBusy = true;
+            break;
+        }
+    }
+
+    return bBusy;
+}
+
+static void wb_wil_UpdateRequestContextStats (adi_wil_pack_internals_t * const pInternals)
+{
+    /* Number of contexts in use */
+    uint8_t iInFlight;
+
+    /* Initialize local variables */
+    iInFlight = 0u;
+
+    for (uint8_t i = 0u; i < ADI_WIL_MAX_CONCURRENT_REQUESTS; i++)
+    {
+        if (ADI_WIL_REQUEST_CONTEXT_FREE != pInternals->RequestPool.Contexts [i].eState)
+        {
+            iInFlight++;
+        }
+    }
+
+    /* Track the high water mark for sizing ADI_WIL_MAX_CONCURRENT_REQUESTS */
+    if (iInFlight > pInternals->RequestPool.iInFlightMax)
+    {
+        pInternals->RequestPool.iInFlightMax = iInFlight;
+    }
+}
@@ -11,6 +11,8 @@
 #include "wb_wil_ui.h"
 #include "wb_wil_request.h"
 #include "wb_req_set_acl.h"
+#include "wb_req_get_acl.h"
+#include "wb_rsp_get_acl.h"
 #include "wb_req_generic.h"
 #include "wb_rsp_generic.h"
 #include "adi_wil_port.h"
@@ -34,8 +36,11 @@
  * Static Function declarations
  *****************************************************************************/
 
+static void wb_wil_CompareACLFunc (adi_wil_pack_internals_t * const pInternals);
 static void wb_wil_ClearACLFunc (adi_wil_pack_internals_t * const pInternals);
 static void wb_wil_SetACLFunc (adi_wil_pack_internals_t * const pInternals);
+static void wb_wil_SetACLNextRequest (adi_wil_pack_internals_t * const pInternals, adi_wil_api_process_func_t pfRequestFunc);
+static uint8_t wb_wil_SetACLGetRequestCount (adi_wil_pack_internals_t const * const pInternals);
 static void wb_wil_SetACLComplete (adi_wil_pack_internals_t * const pInternals, adi_wil_err_t rc);
 
 /******************************************************************************
@@ -134,7 +139,7 @@ adi_wil_err_t wb_wil_SetACLAPI (adi_wil_pack_internals_t * const pInternals,
 
         if (ADI_WIL_ERR_SUCCESS == rc)
         {
-            rc = wb_wil_SetupRequest (pInternals, iDeviceId, (sizeof (ValidTargets) / sizeof (adi_wil_target_t)), ValidTargets, &wb_wil_ClearACLFunc);
+            rc = wb_wil_SetupRequest (pInternals, iDeviceId, (sizeof (ValidTargets) / sizeof (adi_wil_target_t)), ValidTargets, &wb_wil_CompareACLFunc);
         }
 
         if (ADI_WIL_ERR_SUCCESS == rc)
@@ -149,7 +154,14 @@ adi_wil_err_t wb_wil_SetACLAPI (adi_wil_pack_internals_t * const pInternals,
                 (void) memcpy (&pInternals->ACLState.Data [0], pData, ((size_t) ADI_WIL_MAC_ADDR_SIZE * iCount));
             }
 
-            wb_wil_ClearACLFunc (pInternals);
+            /* Read the manager ACL back first. Only a list that differs from
+             * it in more than appended entries needs the ACL cleared, which
+             * disconnects every node */
+            pInternals->SetACLState.iReadCount = 0u;
+            pInternals->SetACLState.bMismatch = false;
+            pInternals->SetACLState.bComparing = true;
+
+            wb_wil_CompareACLFunc (pInternals);
         }
 
         /* Release lock if any of the above steps returns a failure */
@@ -167,6 +179,33 @@ adi_wil_err_t wb_wil_SetACLAPI (adi_wil_pack_internals_t * const pInternals,
     return rc;
 }
 
+static void wb_wil_CompareACLFunc (adi_wil_pack_internals_t * const pInternals)
+{
+    wbms_cmd_req_get_acl_t Request;
+
+    /* Initialize request structure */
+    (void) memset (&Request, 0, sizeof (Request));
+
+    Request.iIndex = pInternals->SetACLState.iReadCount;
+
+    /* Increment the request count each time this method is entered */
+    wb_wil_IncrementWithRollover8 (&pInternals->UserRequestState.iRequestCount);
+
+    /* Check that the request count has not exceeded limit */
+    if (pInternals->UserRequestState.iRequestCount > WB_WIL_SET_ACL_REQUEST_LIMIT)
+    {
+        wb_wil_SetACLComplete (pInternals, ADI_WIL_ERR_TIMEOUT);
+    }
+    else if (ADI_WIL_ERR_SUCCESS != wb_wil_GetACLRequest (pInternals, &Request, WB_WIL_SET_ACL_REQUEST_TIMEOUT))
+    {
+        wb_wil_SetACLComplete (pInternals, ADI_WIL_ERR_FAIL);
+    }
+    else
+    {
+        /* MISRA Else */
+    }
+}
+
 static void wb_wil_ClearACLFunc (adi_wil_pack_internals_t * const pInternals)
 {
     wbms_cmd_req_generic_t Request;
@@ -196,19 +235,7 @@ static void wb_wil_SetACLFunc (adi_wil_pack_internals_t * const pInternals)
     /* Initialize request structure */
     (void) memset (&Request, 0, sizeof (Request));
 
-    if ((pInternals->NodeState.iCount + WBMS_MAX_ACL_ENTRIES_PER_REQ) > pInternals->ACLState.iCount)
-    {
-        Request.iCount = (pInternals->ACLState.iCount % WBMS_MAX_ACL_ENTRIES_PER_REQ);
-
-        if (Request.iCount == 0u)
-        {
-            Request.iCount = WBMS_MAX_ACL_ENTRIES_PER_REQ;
-        }
-    }
-    else
-    {
-        Request.iCount = WBMS_MAX_ACL_ENTRIES_PER_REQ;
-    }
+    Request.iCount = wb_wil_SetACLGetRequestCount (pInternals);
 
     /* Increment the request count each time this method is entered */
     wb_wil_IncrementWithRollover8 (&pInternals->UserRequestState.iRequestCount);
@@ -312,19 +339,7 @@ void wb_wil_HandleSetACLResponse (adi_wil_pack_internals_t * const pInternals, w
     }
     else
     {
-        if ((pInternals->NodeState.iCount + WBMS_MAX_ACL_ENTRIES_PER_REQ) > pInternals->ACLState.iCount)
-        {
-            iCount = (pInternals->ACLState.iCount % WBMS_MAX_ACL_ENTRIES_PER_REQ);
-
-            if (iCount == 0u)
-            {
-                iCount = WBMS_MAX_ACL_ENTRIES_PER_REQ;
-            }
-        }
-        else
-        {
-            iCount = WBMS_MAX_ACL_ENTRIES_PER_REQ;
-        }
+        iCount = wb_wil_SetACLGetRequestCount (pInternals);
 
         /* Check if node count is within limits */
         if ((((uint16_t) pInternals->NodeState.iCount) + ((uint16_t) iCount)) > ((uint16_t) ADI_WIL_MAX_NODES))
@@ -362,10 +377,112 @@ void wb_wil_HandleSetACLResponse (adi_wil_pack_internals_t * const pInternals, w
     }
 }
 
+void wb_wil_HandleSetACLCompareResponse (adi_wil_pack_internals_t * const pInternals, wbms_cmd_resp_get_acl_t const * const pResponse, uint8_t const * const pData)
+{
+    /* Index in the requested ACL of the entry being compared */
+    uint8_t iIndex;
+
+    if (ADI_WIL_ERR_SUCCESS != wb_wil_api_CheckToken (pInternals, pResponse->iToken, true))
+    {
+        /* Do nothing, there is no active request with this token */
+    }
+    else if (WBMS_CMD_RC_WAIT == pResponse->rc)
+    {
+        /* Manager is busy, so resend request */
+        wb_wil_CompareACLFunc (pInternals);
+    }
+    else if (WBMS_CMD_RC_SUCCESS != pResponse->rc)
+    {
+        wb_wil_SetACLComplete (pInternals, wb_wil_GetErrFromUint (pResponse->rc));
+    }
+    else if ((WBMS_MAX_ACL_ENTRIES_PER_REQ < pResponse->iCount) ||
+             (ADI_WIL_MAX_NODES < (pResponse->iCount + pInternals->SetACLState.iReadCount)))
+    {
+        /* More entries than a response or the ACL can hold */
+        wb_wil_SetACLComplete (pInternals, ADI_WIL_ERR_FAIL);
+    }
+    else if (pResponse->iCount > 0u)
+    {
+        /* Compare the entries against the same positions of the requested
+         * ACL - node IDs are ACL positions, so any difference in the entries
+         * the manager already has means the list must be rewritten */
+        for (uint8_t i = 0u; i < pResponse->iCount; i++)
+        {
+            iIndex = pInternals->SetACLState.iReadCount + i;
+
+            if ((iIndex >= pInternals->ACLState.iCount) ||
+                (0 != memcmp (&pData [i * ADI_WIL_MAC_ADDR_SIZE], &pInternals->ACLState.Data [iIndex * ADI_WIL_MAC_ADDR_SIZE], ADI_WIL_MAC_ADDR_SIZE)))
+            {
+                pInternals->SetACLState.bMismatch = true;
+            }
+        }
+
+        pInternals->SetACLState.iReadCount += pResponse->iCount;
+
+        /* Fetch the next block of entries */
+        wb_wil_SetACLNextRequest (pInternals, &wb_wil_CompareACLFunc);
+    }
+    else
+    {
+        /* A response count of 0 ends the manager ACL */
+        pInternals->SetACLState.bComparing = false;
+
+        /* The write phase has its own request budget */
+        pInternals->UserRequestState.iRequestCount = 0u;
+
+        if (pInternals->SetACLState.bMismatch)
+        {
+            /* Entries changed or removed - clear and write the whole list */
+            wb_wil_SetACLNextRequest (pInternals, &wb_wil_ClearACLFunc);
+        }
+        else if (pInternals->SetACLState.iReadCount == pInternals->ACLState.iCount)
+        {
+            /* Manager already holds the requested ACL */
+            pInternals->NodeState.iCount = pInternals->SetACLState.iReadCount;
+            wb_wil_SetACLComplete (pInternals, ADI_WIL_ERR_SUCCESS);
+        }
+        else
+        {
+            /* Entries appended - send only those, the nodes already in the
+             * ACL keep their IDs and stay connected */
+            pInternals->NodeState.iCount = pInternals->SetACLState.iReadCount;
+            wb_wil_SetACLNextRequest (pInternals, &wb_wil_SetACLFunc);
+        }
+    }
+}
+
+static void wb_wil_SetACLNextRequest (adi_wil_pack_internals_t * const pInternals, adi_wil_api_process_func_t pfRequestFunc)
+{
+    /* Increment the token */
+    wb_wil_IncrementWithRollover16 (&pInternals->UserRequestState.iToken);
+
+    /* If we rolled over, increment it again so the token is now non-zero */
+    if (pInternals->UserRequestState.iToken == 0u)
+    {
+        wb_wil_IncrementWithRollover16 (&pInternals->UserRequestState.iToken);
+    }
+
+    pInternals->UserRequestState.iRetries = 0u;
+    pInternals->UserRequestState.pfRequestFunc = pfRequestFunc;
+    pfRequestFunc (pInternals);
+}
+
+static uint8_t wb_wil_SetACLGetRequestCount (adi_wil_pack_internals_t const * const pInternals)
+{
+    /* Number of entries left to send, the write may start part way through
+     * a block when only appended entries are sent */
+    uint8_t iRemaining;
+
+    iRemaining = (pInternals->ACLState.iCount > pInternals->NodeState.iCount) ? (uint8_t) (pInternals->ACLState.iCount - pInternals->NodeState.iCount) : 0u;
+
+    return (iRemaining > WBMS_MAX_ACL_ENTRIES_PER_REQ) ? WBMS_MAX_ACL_ENTRIES_PER_REQ : iRemaining;
+}
+
 static void wb_wil_SetACLComplete (adi_wil_pack_internals_t * const pInternals, adi_wil_err_t rc)
 {
     pInternals->UserRequestState.bValid = false;
     pInternals->UserRequestState.pfRequestFunc = (void *) 0;
+    pInternals->SetACLState.bComparing = false;
 
     /* Refresh the XMS parameters if we have a valid number of nodes */
     if (pInternals->NodeState.iCount <= ADI_WIL_MAX_NODES)
@@ -13,6 +13,7 @@
 #include "wb_ntf_system_status.h"
 #include "wb_wil_utils.h"
 #include "wb_wil_ui.h"
+#include "wb_wil_port_select.h"
 #include <string.h>
 
 void wb_wil_HandleSystemStatus (adi_wil_pack_internals_t * const pInternals, uint64_t iDeviceId, wbms_notif_system_status_t const * const pNotif)
@@ -33,6 +34,9 @@ void wb_wil_HandleSystemStatus (adi_wil_pack_internals_t * const pInternals, uin
         status->iDeviceId = WBMS_MANAGER_1_DEVICE_ID;
     }
 
+    /* Let the port selection weigh the overflows of this manager */
+    wb_wil_PortSelectRecordStatus (pInternals, iDeviceId, pNotif->iSpiTxQueueOFCount);
+
     /* Update the manager statistics. If the manager SPI queue
      * overflow counter has increased, then generate an overflow event */
 
@@ -16,6 +16,7 @@
 #include "adi_wil_osal.h"
 #include "adi_wil_pack.h"
 #include "adi_wil_hal_ticker.h"
+#include "adi_wil_hal_trace.h"
 #include "adi_wil_app_interface.h"
 #include "wb_assl_fusa.h"
 
@@ -55,6 +56,7 @@
 #include "wb_wil_configure_cell_balancing.h"
 #include "wb_wil_get_cell_balancing_status.h"
 #include "wb_wil_device.h"
+#include "wb_wil_request_context.h"
 
 #include <string.h>
 
@@ -100,6 +102,8 @@ static void wb_wil_ui_ActivateLock (adi_wil_ui_lock_state_t * const pState,
 static bool wb_wil_ui_DeactivateLock (adi_wil_ui_lock_state_t * const pState,
                                       bool bFusaContext);
 
+static bool wb_wil_ui_CheckRequestLocksFree (adi_wil_ui_internals_t const * const pInternals);
+
 static adi_wil_safety_internals_t * wb_ui_GetSafetyInternalsPointer (adi_wil_pack_t const * const pPack);
 
 /******************************************************************************
@@ -605,6 +609,28 @@ adi_wil_err_t adi_wil_GetFile (adi_wil_pack_t const * const pPack,
     return rc;
 }
 
+adi_wil_err_t adi_wil_GetFileStream (adi_wil_pack_t const * const pPack,
+                                     adi_wil_device_t eDeviceId,
+                                     adi_wil_file_type_t eFileType)
+{
+    /* Method return code variable */
+    adi_wil_err_t rc;
+
+    /* Validate pack instance before dereferencing */
+    if ((void *) 0 == pPack)
+    {
+        rc = ADI_WIL_ERR_INVALID_PARAMETER;
+    }
+    else
+    {
+        /* If valid, invoke API and set rc to return value */
+        rc = wb_wil_GetFileStreamAPI (pPack->pInternals, eDeviceId, eFileType);
+    }
+
+    /* Return error code to caller */
+    return rc;
+}
+
 adi_wil_err_t adi_wil_ProcessTask (adi_wil_pack_t const * const pPack)
 {
     /* Method return code variable */
@@ -981,6 +1007,48 @@ adi_wil_err_t adi_wil_GetCellBalancingStatus (adi_wil_pack_t const * const pPack
     return rc;
 }
 
+adi_wil_err_t adi_wil_GetCallbackDeviceId (adi_wil_pack_t const * const pPack,
+                                           adi_wil_device_t * const pDeviceId)
+{
+    /* Method return code variable */
+    adi_wil_err_t rc;
+
+    /* Validate pack instance before dereferencing */
+    if ((void *) 0 == pPack)
+    {
+        rc = ADI_WIL_ERR_INVALID_PARAMETER;
+    }
+    else
+    {
+        /* If valid, invoke API and set rc to return value */
+        rc = wb_wil_GetCallbackDeviceIdAPI (pPack->pInternals, pDeviceId);
+    }
+
+    /* Return error code to caller */
+    return rc;
+}
+
+adi_wil_err_t adi_wil_GetSafetyTxStatistics (adi_wil_pack_t const * const pPack,
+                                             adi_wil_assl_tx_statistics_t * const pStatistics)
+{
+    /* Method return code variable */
+    adi_wil_err_t rc;
+
+    /* Validate pack instance before dereferencing */
+    if ((void *) 0 == pPack)
+    {
+        rc = ADI_WIL_ERR_INVALID_PARAMETER;
+    }
+    else
+    {
+        /* If valid, invoke API and set rc to return value */
+        rc = wb_assl_GetTxStatisticsAPI (pPack->pSafetyInternals, pStatistics);
+    }
+
+    /* Return error code to caller */
+    return rc;
+}
+
 void wb_wil_ui_GenerateCb (adi_wil_pack_t const * const pPack,
                            adi_wil_api_t eNonSafetyAPI,
                            adi_wil_err_t rc,
@@ -1031,6 +1099,13 @@ void wb_wil_ui_GenerateCb (adi_wil_pack_t const * const pPack,
         }
     }
 
+    ADI_WIL_HAL_TRACE (ADI_WIL_HAL_TRACE_EVT_API_CB, eNonSafetyAPI, rc);
+
+    if (ADI_WIL_ERR_TIMEOUT == rc)
+    {
+        ADI_WIL_HAL_TRACE (ADI_WIL_HAL_TRACE_EVT_API_TIMEOUT, eNonSafetyAPI, 0u);
+    }
+
     /* Check validity and pPack before dereferencing */
     if (bValid && ((void *) 0 != pPack))
     {
@@ -1065,6 +1140,13 @@ void wb_wil_ui_GeneratePortCb (adi_wil_port_t const * const pPort,
         }
     }
 
+    ADI_WIL_HAL_TRACE (ADI_WIL_HAL_TRACE_EVT_API_CB, eNonSafetyAPI, rc);
+
+    if (ADI_WIL_ERR_TIMEOUT == rc)
+    {
+        ADI_WIL_HAL_TRACE (ADI_WIL_HAL_TRACE_EVT_API_TIMEOUT, eNonSafetyAPI, 0u);
+    }
+
     /* Check validity and pPack before dereferencing */
     if (bValid && ((void *) 0 != pPort))
     {
@@ -1156,6 +1238,13 @@ void wb_wil_ui_GenerateFuSaCb (adi_wil_pack_t const * const pPack,
         }
     }
 
+    ADI_WIL_HAL_TRACE (ADI_WIL_HAL_TRACE_EVT_API_CB, eSafetyAPI, rc);
+
+    if (ADI_WIL_ERR_TIMEOUT == rc)
+    {
+        ADI_WIL_HAL_TRACE (ADI_WIL_HAL_TRACE_EVT_API_TIMEOUT, eSafetyAPI, 0u);
+    }
+
     /* Check validity and pPack before dereferencing */
     if (bValid && ((void *) 0 != pPack))
     {
@@ -1240,6 +1329,198 @@ void wb_wil_ui_ReleaseFuSaLock (adi_wil_pack_t const * const pPack,
     wb_wil_ui_ReleaseLockCommon (pPack, pLockID, true);
 }
 
+adi_wil_err_t wb_wil_ui_AcquireRequestLock (adi_wil_pack_t const * const pPack,
+                                            void const * const pLockID,
+                                            uint8_t * const pSlot)
+{
+    /* Method return code variable */
+    adi_wil_err_t rc;
+
+    /* OSAL API return code variable */
+    adi_wil_osal_err_t eOSALrc;
+
+    /* Static variable for retrieving safety internals pointer */
+    adi_wil_safety_internals_t * pInternals;
+
+    /* Retrieve safety internals pointer */
+    pInternals = wb_ui_GetSafetyInternalsPointer (pPack);
+
+    /* Validate input parameters - request locks only exist for the pack
+     * lock */
+    if (((void *) 0 == pInternals) ||
+        ((void *) 0 == pSlot) ||
+        (pLockID != pPack))
+    {
+        rc = ADI_WIL_ERR_INVALID_PARAMETER;
+    }
+    else
+    {
+        /* Hold the pack lock while a request slot is claimed so no exclusive
+         * API can start in between */
+        eOSALrc = adi_wil_osal_AcquireResource (pLockID);
+
+        if (ADI_WIL_OSAL_ERR_SUCCESS == eOSALrc)
+        {
+            /* Assume all slots are taken until a free one is found */
+            rc = ADI_WIL_ERR_API_IN_PROGRESS;
+
+            for (uint8_t i = 0u; i < ADI_WIL_MAX_CONCURRENT_REQUESTS; i++)
+            {
+                if (!pInternals->UI.RequestLockState [i].bAcquired)
+                {
+                    /* Start the request lock timer */
+                    wb_wil_ui_ActivateLock (&pInternals->UI.RequestLockState [i], false);
+
+                    *pSlot = i;
+                    rc = ADI_WIL_ERR_SUCCESS;
+                    break;
+                }
+            }
+
+            /* The pack lock itself is only held for the claim */
+            if (adi_wil_osal_ReleaseResource (pLockID) != ADI_WIL_OSAL_ERR_SUCCESS)
+            {
+                wb_wil_ui_GenerateFuSaEvent (pPack, ADI_WIL_EVENT_FAULT_LOCK_RELEASE, (void *) 0);
+            }
+        }
+        /* ...else if the lock has not been created, set rc to not connected */
+        else if (ADI_WIL_OSAL_ERR_NO_RESOURCE == eOSALrc)
+        {
+            rc = ADI_WIL_ERR_NOT_CONNECTED;
+        }
+        /* ...else an exclusive API owns the lock, set rc to in progress */
+        else
+        {
+            rc = ADI_WIL_ERR_API_IN_PROGRESS;
+        }
+    }
+
+    /* Return error code to caller */
+    return rc;
+}
+
+void wb_wil_ui_ReleaseRequestLock (adi_wil_pack_t const * const pPack,
+                                   void const * const pLockID,
+                                   uint8_t iSlot)
+{
+    /* Storage for return code value indicating if a lock was able to be
+     * released */
+    bool bValid;
+
+    /* Static variable for retrieving safety internals pointer */
+    adi_wil_safety_internals_t * pInternals;
+
+    /* Initialize local variables */
+    bValid = false;
+
+    /* Retrieve safety internals pointer */
+    pInternals = wb_ui_GetSafetyInternalsPointer (pPack);
+
+    /* Validate input parameters and only release a slot that is held */
+    if (((void *) 0 != pInternals) &&
+        (pLockID == pPack) &&
+        (iSlot < ADI_WIL_MAX_CONCURRENT_REQUESTS))
+    {
+        if (pInternals->UI.RequestLockState [iSlot].bAcquired)
+        {
+            bValid = wb_wil_ui_DeactivateLock (&pInternals->UI.RequestLockState [iSlot], false);
+        }
+    }
+
+    /* If we're no longer in a valid state, generate a fault notification */
+    if (!bValid)
+    {
+        wb_wil_ui_GenerateFuSaEvent (pPack, ADI_WIL_EVENT_FAULT_LOCK_RELEASE, (void *) 0);
+    }
+}
+
+adi_wil_err_t wb_wil_ui_CreateProcessLock (void const * const pLockID)
+{
+    /* Method return code variable */
+    adi_wil_err_t rc;
+
+    /* Validate input parameters - a process lock can never alias the global
+     * lock */
+    if (((void *) 0 == pLockID) ||
+        ((void *) 0 == pGlobalLockID) ||
+        (pLockID == pGlobalLockID))
+    {
+        rc = ADI_WIL_ERR_INVALID_PARAMETER;
+    }
+    /* Creating a lock that already exists succeeds in the OSAL */
+    else if (adi_wil_osal_CreateResource (pLockID) != ADI_WIL_OSAL_ERR_SUCCESS)
+    {
+        rc = ADI_WIL_ERR_FAIL;
+    }
+    else
+    {
+        rc = ADI_WIL_ERR_SUCCESS;
+    }
+
+    /* Return error code to caller */
+    return rc;
+}
+
+adi_wil_err_t wb_wil_ui_AcquireProcessLock (void const * const pLockID)
+{
+    /* Method return code variable */
+    adi_wil_err_t rc;
+
+    /* OSAL API return code variable */
+    adi_wil_osal_err_t eOSALrc;
+
+    /* Validate input parameters */
+    if (((void *) 0 == pLockID) ||
+        (pLockID == pGlobalLockID))
+    {
+        rc = ADI_WIL_ERR_INVALID_PARAMETER;
+    }
+    else
+    {
+        /* Process locks are only held for one process task pass, so they
+         * have no hold timer */
+        eOSALrc = adi_wil_osal_AcquireResource (pLockID);
+
+        if (ADI_WIL_OSAL_ERR_SUCCESS == eOSALrc)
+        {
+            rc = ADI_WIL_ERR_SUCCESS;
+        }
+        /* ...else if the lock has not been created, set rc to not connected */
+        else if (ADI_WIL_OSAL_ERR_NO_RESOURCE == eOSALrc)
+        {
+            rc = ADI_WIL_ERR_NOT_CONNECTED;
+        }
+        /* ...else another context is processing, set rc to in progress */
+        else
+        {
+            rc = ADI_WIL_ERR_API_IN_PROGRESS;
+        }
+    }
+
+    /* Return error code to caller */
+    return rc;
+}
+
+void wb_wil_ui_ReleaseProcessLock (void const * const pLockID)
+{
+    /* Call for OSAL lock release and generate a fault notification if it
+     * fails */
+    if (adi_wil_osal_ReleaseResource (pLockID) != ADI_WIL_OSAL_ERR_SUCCESS)
+    {
+        wb_wil_ui_GenerateFuSaEvent ((void *) 0, ADI_WIL_EVENT_FAULT_LOCK_RELEASE, (void *) 0);
+    }
+}
+
+void wb_wil_ui_DestroyProcessLock (void const * const pLockID)
+{
+    /* Destroy the lock regardless of if it is acquired and ignore RC as it
+     * may never have been created */
+    if (((void *) 0 != pLockID) && (pLockID != pGlobalLockID))
+    {
+        (void) adi_wil_osal_DestroyResource (pLockID);
+    }
+}
+
 /******************************************************************************
  * Local Function Definitions
  *****************************************************************************/
@@ -1250,6 +1531,14 @@ static void wb_wil_ui_Initialize (adi_wil_ui_internals_t * const pInternals)
     pInternals->LockState.bAcquired = false;
     pInternals->LockState.bFusaContext = false;
     pInternals->LockState.iTimestamp = 0u;
+
+    /* Initialize request lock timer variables */
+    for (uint8_t i = 0u; i < ADI_WIL_MAX_CONCURRENT_REQUESTS; i++)
+    {
+        pInternals->RequestLockState [i].bAcquired = false;
+        pInternals->RequestLockState [i].bFusaContext = false;
+        pInternals->RequestLockState [i].iTimestamp = 0u;
+    }
 }
 
 static void wb_wil_ui_ActivateLock (adi_wil_ui_lock_state_t * const pState,
@@ -1291,6 +1580,27 @@ static bool wb_wil_ui_DeactivateLock (adi_wil_ui_lock_state_t * const pState,
     return bValid;
 }
 
+static bool wb_wil_ui_CheckRequestLocksFree (adi_wil_ui_internals_t const * const pInternals)
+{
+    /* Return value of this method */
+    bool bFree;
+
+    /* Initialize local variables */
+    bFree = true;
+
+    /* Check no concurrent request is holding a shared pack lock */
+    for (uint8_t i = 0u; i < ADI_WIL_MAX_CONCURRENT_REQUESTS; i++)
+    {
+        if (pInternals->RequestLockState [i].bAcquired)
+        {
+            bFree = false;
+            break;
+        }
+    }
+
+    return bFree;
+}
+
 static bool wb_wil_ui_CheckTimer (adi_wil_ui_lock_state_t * const pState,
                                   uint32_t iCurrentTime)
 {
@@ -1368,8 +1678,21 @@ static adi_wil_err_t wb_wil_ui_AcquireLockCommon (adi_wil_pack_t const * const p
         {
             rc = ADI_WIL_ERR_SUCCESS;
 
+            /* The pack lock is exclusive, refuse it while concurrent
+             * requests are still in flight */
+            if ((pLockID != pGlobalLockID) &&
+                !wb_wil_ui_CheckRequestLocksFree (&pInternals->UI))
+            {
+                rc = ADI_WIL_ERR_API_IN_PROGRESS;
+
+                /* Hand the lock back */
+                if (adi_wil_osal_ReleaseResource (pLockID) != ADI_WIL_OSAL_ERR_SUCCESS)
+                {
+                    wb_wil_ui_GenerateFuSaEvent (pPack, ADI_WIL_EVENT_FAULT_LOCK_RELEASE, (void *) 0);
+                }
+            }
             /* If we acquired the pack lock, start the pack lock timer */
-            if (pLockID != pGlobalLockID)
+            else if (pLockID != pGlobalLockID)
             {
                 wb_wil_ui_ActivateLock (&pInternals->UI.LockState, bFusaContext);
             }
@@ -1469,6 +1792,15 @@ static void wb_wil_ui_Process (adi_wil_pack_t const * const pPack,
              * out */
             wb_wil_ui_GenerateFuSaEvent (pPack, ADI_WIL_EVENT_FAULT_LOCK_RELEASE, (void *) 0);
         }
+
+        /* Check request lock states */
+        for (uint8_t i = 0u; i < ADI_WIL_MAX_CONCURRENT_REQUESTS; i++)
+        {
+            if (!wb_wil_ui_CheckTimer (&pInternals->UI.RequestLockState [i], iCurrentTicks))
+            {
+                wb_wil_ui_GenerateFuSaEvent (pPack, ADI_WIL_EVENT_FAULT_LOCK_RELEASE, (void *) 0);
+            }
+        }
     }
 
     /* Check global lock state */
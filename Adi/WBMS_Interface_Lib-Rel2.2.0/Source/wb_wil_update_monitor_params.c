@@ -19,6 +19,7 @@
 #include "wb_crc_32.h"
 #include "wb_crc_config.h"
 #include "wb_wil_api.h"
+#include "wb_wil_request_context.h"
 #include <string.h>
 
 
@@ -43,6 +44,21 @@ static void wb_wil_UpdateMonitorParametersCommitFunc (adi_wil_pack_internals_t *
 static void wb_wil_UpdateMonitorParametersComplete (adi_wil_pack_internals_t * const pInternals,
                                                     adi_wil_err_t rc);
 
+static void wb_wil_UpdateMonitorParametersStartWindow (adi_wil_pack_internals_t * const pInternals);
+
+static void wb_wil_UpdateMonitorParametersFillSlot (adi_wil_pack_internals_t * const pInternals,
+                                                    uint8_t iSlot);
+
+static void wb_wil_UpdateMonitorParametersSlotFunc (adi_wil_pack_internals_t * const pInternals,
+                                                    adi_wil_request_context_t * const pContext);
+
+static void wb_wil_UpdateMonitorParametersStartCommit (adi_wil_pack_internals_t * const pInternals);
+
+static adi_wil_request_context_t * wb_wil_UpdateMonitorParametersFindSlot (adi_wil_pack_internals_t * const pInternals,
+                                                                           uint16_t iToken);
+
+static void wb_wil_UpdateMonitorParametersReleaseSlot (adi_wil_request_context_t * const pSlot);
+
 /******************************************************************************
  * Public functions
  *****************************************************************************/
@@ -100,7 +116,17 @@ adi_wil_err_t wb_wil_UpdateMonitorParametersAPI (adi_wil_pack_internals_t * cons
             /* Set the request count to 0u at the start of API invocation */
             pInternals->UserRequestState.iRequestCount = 0u;
 
-            wb_wil_UpdateMonitorParametersDataFunc (pInternals);
+            /* Blocks for all nodes are streamed through the window from the
+             * process task, other targets step through the blocks one at a
+             * time */
+            if (ADI_WIL_TARGET_ALL_NODES == pInternals->UserRequestState.eTarget)
+            {
+                wb_wil_UpdateMonitorParametersStartWindow (pInternals);
+            }
+            else
+            {
+                wb_wil_UpdateMonitorParametersDataFunc (pInternals);
+            }
         }
         else
         {
@@ -119,7 +145,34 @@ adi_wil_err_t wb_wil_UpdateMonitorParametersAPI (adi_wil_pack_internals_t * cons
 
 void wb_wil_HandleUpdateMonParamDataResponse (adi_wil_pack_internals_t * const pInternals, uint64_t iDeviceId, wbms_cmd_resp_generic_t const * const pResponse)
 {
-    if (ADI_WIL_ERR_SUCCESS != wb_wil_api_CheckToken (pInternals, pResponse->iToken, false))
+    /* Window entry the response belongs to */
+    adi_wil_request_context_t * pSlot;
+
+    if (ADI_WIL_UPDATE_MONITOR_PARAMS_DATA == pInternals->UpdateMonParamsState.ePhase)
+    {
+        pSlot = wb_wil_UpdateMonitorParametersFindSlot (pInternals, pResponse->iToken);
+
+        if ((void *) 0 == pSlot)
+        {
+            /* Do nothing, there is no block in flight with this token */
+        }
+        else if (WBMS_CMD_RC_SUCCESS != pResponse->rc)
+        {
+            wb_wil_UpdateMonitorParametersComplete (pInternals, wb_wil_GetErrFromUint (pResponse->rc));
+        }
+        else
+        {
+            /* The entry is free for the next block once every node has
+             * acknowledged this one */
+            pSlot->Request.iPendingResponses &= ~(iDeviceId);
+
+            if (0u == pSlot->Request.iPendingResponses)
+            {
+                wb_wil_UpdateMonitorParametersReleaseSlot (pSlot);
+            }
+        }
+    }
+    else if (ADI_WIL_ERR_SUCCESS != wb_wil_api_CheckToken (pInternals, pResponse->iToken, false))
     {
         /* Do nothing, there is no active request with this token */
     }
@@ -179,7 +232,19 @@ void wb_wil_HandleUpdateMonParamCommitResponse (adi_wil_pack_internals_t * const
     }
     else
     {
-        if (ADI_WIL_ERR_SUCCESS == wb_wil_ClearPendingResponse (pInternals, iDeviceId))
+        if (ADI_WIL_ERR_SUCCESS != wb_wil_ClearPendingResponse (pInternals, iDeviceId))
+        {
+            /* Do nothing, still waiting for other devices */
+        }
+        else if (ADI_WIL_UPDATE_MONITOR_PARAMS_COMMIT == pInternals->UpdateMonParamsState.ePhase)
+        {
+            /* All nodes committed, read the CRC back from each of them
+             * through the window before completing */
+            (void) wb_wil_api_CheckToken (pInternals, pResponse->iToken, true);
+            pInternals->UpdateMonParamsState.iVerifyMap = pInternals->UpdateMonParamsState.iUpdateMap;
+            pInternals->UpdateMonParamsState.ePhase = ADI_WIL_UPDATE_MONITOR_PARAMS_VERIFY;
+        }
+        else
         {
             /* If all devices have been serviced, complete API with return code
              * as SUCCESS */
@@ -188,6 +253,87 @@ void wb_wil_HandleUpdateMonParamCommitResponse (adi_wil_pack_internals_t * const
     }
 }
 
+void wb_wil_HandleUpdateMonParamCRCResponse (adi_wil_pack_internals_t * const pInternals,
+                                             wbms_cmd_resp_get_mon_params_crc_t const * const pResponse)
+{
+    /* Window entry the response belongs to */
+    adi_wil_request_context_t * pSlot;
+
+    pSlot = wb_wil_UpdateMonitorParametersFindSlot (pInternals, pResponse->iToken);
+
+    if ((void *) 0 == pSlot)
+    {
+        /* Do nothing, there is no CRC read in flight with this token */
+    }
+    else if (WBMS_CMD_RC_SUCCESS != pResponse->rc)
+    {
+        wb_wil_UpdateMonitorParametersComplete (pInternals, wb_wil_GetErrFromUint (pResponse->rc));
+    }
+    else if (pInternals->UpdateMonParamsState.iCRC != pResponse->iCRC)
+    {
+        /* The node committed a table that differs from the one sent */
+        wb_wil_UpdateMonitorParametersComplete (pInternals, ADI_WIL_ERR_CRC);
+    }
+    else
+    {
+        wb_wil_UpdateMonitorParametersReleaseSlot (pSlot);
+    }
+}
+
+void wb_wil_ProcessUpdateMonitorParameters (adi_wil_pack_internals_t * const pInternals,
+                                            uint32_t iCurrentTime)
+{
+    /* Set while any window entry has a request queued or in flight */
+    bool bBusy = false;
+
+    if (((void *) 0 != pInternals) &&
+        ((ADI_WIL_UPDATE_MONITOR_PARAMS_DATA == pInternals->UpdateMonParamsState.ePhase) ||
+         (ADI_WIL_UPDATE_MONITOR_PARAMS_VERIFY == pInternals->UpdateMonParamsState.ePhase)))
+    {
+        for (uint8_t i = 0u; i < ADI_WIL_UPDATE_MONITOR_PARAMS_WINDOW; i++)
+        {
+            if (ADI_WIL_REQUEST_CONTEXT_FREE == pInternals->UpdateMonParamsState.Window [i].eState)
+            {
+                wb_wil_UpdateMonitorParametersFillSlot (pInternals, i);
+            }
+
+            if (ADI_WIL_REQUEST_CONTEXT_FREE != pInternals->UpdateMonParamsState.Window [i].eState)
+            {
+                bBusy = true;
+                wb_wil_ProcessRequestContext (pInternals, &pInternals->UpdateMonParamsState.Window [i], iCurrentTime);
+            }
+
+            /* Stop if the entry completed the API */
+            if (ADI_WIL_UPDATE_MONITOR_PARAMS_IDLE == pInternals->UpdateMonParamsState.ePhase)
+            {
+                break;
+            }
+        }
+
+        if (bBusy)
+        {
+            /* Do nothing, blocks or CRC reads still in flight */
+        }
+        else if (ADI_WIL_UPDATE_MONITOR_PARAMS_DATA == pInternals->UpdateMonParamsState.ePhase)
+        {
+            /* Every block has been acknowledged by every node, commit them
+             * all with a single request once the port is free */
+            if (wb_wil_CheckRequestFrameAvailable (pInternals, pInternals->UserRequestState.iDeviceId))
+            {
+                wb_wil_UpdateMonitorParametersStartCommit (pInternals);
+            }
+        }
+        else if (ADI_WIL_UPDATE_MONITOR_PARAMS_VERIFY == pInternals->UpdateMonParamsState.ePhase)
+        {
+            wb_wil_UpdateMonitorParametersComplete (pInternals, ADI_WIL_ERR_SUCCESS);
+        }
+        else
+        {
+            /* MISRA Else */
+        }
+    }
+}
+
 /******************************************************************************
  * Static functions
  *****************************************************************************/
@@ -271,6 +417,14 @@ static void wb_wil_UpdateMonitorParametersComplete (adi_wil_pack_internals_t * c
     pInternals->UserRequestState.bValid = false;
     pInternals->UserRequestState.pfRequestFunc = ((void *) 0);
 
+    /* Drop anything still in the window */
+    for (uint8_t i = 0u; i < ADI_WIL_UPDATE_MONITOR_PARAMS_WINDOW; i++)
+    {
+        wb_wil_UpdateMonitorParametersReleaseSlot (&pInternals->UpdateMonParamsState.Window [i]);
+    }
+
+    pInternals->UpdateMonParamsState.ePhase = ADI_WIL_UPDATE_MONITOR_PARAMS_IDLE;
+
     if (ADI_WIL_ERR_SUCCESS != rc)
     {
         wb_wil_ui_GenerateCb (pInternals->pPack, ADI_WIL_API_UPDATE_MONITOR_PARAMETERS, rc, (void *) 0);
@@ -285,3 +439,179 @@ static void wb_wil_UpdateMonitorParametersComplete (adi_wil_pack_internals_t * c
     /* Release lock */
     wb_wil_ui_ReleaseLock (pInternals->pPack, pInternals->pPack);
 }
+
+static void wb_wil_UpdateMonitorParametersStartWindow (adi_wil_pack_internals_t * const pInternals)
+{
+    (void) memset (&pInternals->UpdateMonParamsState.Window [0], 0, sizeof (pInternals->UpdateMonParamsState.Window));
+
+    /* Every node is checked against this once the commit has completed */
+    pInternals->UpdateMonParamsState.iCRC = wb_crc_ComputeCRC32 (pInternals->UpdateMonParamsState.pData, pInternals->UpdateMonParamsState.iLength, WB_CRC_SEED);
+    pInternals->UpdateMonParamsState.iVerifyMap = 0u;
+
+    /* The process task fills the window on its next pass. Each entry has
+     * its own timer, so the user request state is not timed */
+    pInternals->UserRequestState.bValid = false;
+    pInternals->UpdateMonParamsState.ePhase = ADI_WIL_UPDATE_MONITOR_PARAMS_DATA;
+}
+
+static void wb_wil_UpdateMonitorParametersFillSlot (adi_wil_pack_internals_t * const pInternals,
+                                                    uint8_t iSlot)
+{
+    /* Window entry being filled */
+    adi_wil_request_context_t * pSlot;
+
+    /* Device the entry is sent to */
+    uint64_t iDeviceId = 0u;
+
+    /* Target the entry is allowed to address */
+    adi_wil_target_t eTarget;
+
+    /* Length of the block sent in the entry */
+    uint16_t iLength;
+
+    pSlot = &pInternals->UpdateMonParamsState.Window [iSlot];
+
+    if (ADI_WIL_UPDATE_MONITOR_PARAMS_DATA == pInternals->UpdateMonParamsState.ePhase)
+    {
+        /* Next block to all nodes. Blocks are broadcast from the first
+         * entry only, so every node has at most one block in flight and
+         * receives them in order */
+        if ((0u == iSlot) &&
+            (pInternals->UpdateMonParamsState.iOffset < pInternals->UpdateMonParamsState.iLength))
+        {
+            iDeviceId = pInternals->UserRequestState.iDeviceId;
+            pInternals->UpdateMonParamsState.WindowOffset [iSlot] = pInternals->UpdateMonParamsState.iOffset;
+
+            iLength = pInternals->UpdateMonParamsState.iLength - pInternals->UpdateMonParamsState.iOffset;
+
+            if (iLength > WBMS_CMD_REQ_SET_MON_PARAMS_PAYLOAD_MAX_LEN)
+            {
+                iLength = WBMS_CMD_REQ_SET_MON_PARAMS_PAYLOAD_MAX_LEN;
+            }
+
+            pInternals->UpdateMonParamsState.iOffset += iLength;
+        }
+    }
+    else
+    {
+        /* Next node whose CRC has not been requested yet, one read per node
+         * and up to a window of nodes at once */
+        for (uint8_t i = 0u; (i < ADI_WIL_MAX_NODES) && (0u == iDeviceId); i++)
+        {
+            if (0u != (pInternals->UpdateMonParamsState.iVerifyMap & (1ULL << i)))
+            {
+                iDeviceId = (1ULL << i);
+            }
+        }
+
+        pInternals->UpdateMonParamsState.iVerifyMap &= ~(iDeviceId);
+    }
+
+    if (0u != iDeviceId)
+    {
+        eTarget = (ADI_WIL_UPDATE_MONITOR_PARAMS_DATA == pInternals->UpdateMonParamsState.ePhase) ? ADI_WIL_TARGET_ALL_NODES : ADI_WIL_TARGET_SINGLE_NODE;
+
+        if (ADI_WIL_ERR_SUCCESS != wb_wil_SetupRequestContext (pInternals, pSlot, iDeviceId, 1u, &eTarget))
+        {
+            /* The node set changed under the update */
+            wb_wil_UpdateMonitorParametersComplete (pInternals, ADI_WIL_ERR_FAIL);
+        }
+        else
+        {
+            pSlot->pfRequestFunc = &wb_wil_UpdateMonitorParametersSlotFunc;
+            pSlot->eAPI = ADI_WIL_API_UPDATE_MONITOR_PARAMETERS;
+            wb_wil_QueueRequestContext (pSlot);
+        }
+    }
+}
+
+static void wb_wil_UpdateMonitorParametersSlotFunc (adi_wil_pack_internals_t * const pInternals,
+                                                    adi_wil_request_context_t * const pContext)
+{
+    wbms_cmd_req_set_mon_params_data_t DataRequest;
+    wbms_cmd_req_generic_t Request;
+    adi_wil_err_t rc;
+    uint16_t iLength;
+
+    /* Initialize request structure */
+    (void) memset (&DataRequest, 0, sizeof (DataRequest));
+
+    if (pContext->Request.iRetries >= ADI_WIL_RETRIES)
+    {
+        wb_wil_UpdateMonitorParametersComplete (pInternals, ADI_WIL_ERR_TIMEOUT);
+    }
+    else
+    {
+        if (ADI_WIL_UPDATE_MONITOR_PARAMS_DATA == pInternals->UpdateMonParamsState.ePhase)
+        {
+            /* Rebuild the block from the offset held by the entry */
+            DataRequest.iOffset = pInternals->UpdateMonParamsState.WindowOffset [pContext - &pInternals->UpdateMonParamsState.Window [0]];
+            iLength = pInternals->UpdateMonParamsState.iLength - DataRequest.iOffset;
+
+            if (iLength > WBMS_CMD_REQ_SET_MON_PARAMS_PAYLOAD_MAX_LEN)
+            {
+                iLength = WBMS_CMD_REQ_SET_MON_PARAMS_PAYLOAD_MAX_LEN;
+            }
+
+            DataRequest.iLength = (uint8_t) (iLength & (uint16_t) 0x00FF);
+            DataRequest.iCRC = wb_crc_ComputeCRC16 (&pInternals->UpdateMonParamsState.pData [DataRequest.iOffset], DataRequest.iLength, WB_CRC_SEED);
+
+            rc = wb_wil_UpdateMonitorParametersDataRequest (pInternals, &DataRequest, &pInternals->UpdateMonParamsState.pData [DataRequest.iOffset], DataRequest.iLength, WB_WIL_SET_MONITOR_PARAMS_REQUEST_TIMEOUT);
+        }
+        else
+        {
+            rc = wb_wil_GenericRequest (pInternals, &Request, WBMS_CMD_GET_MON_PARAMS_CRC, ADI_WIL_RESPONSE_TIMEOUT_MS);
+        }
+
+        if (ADI_WIL_ERR_SUCCESS != rc)
+        {
+            wb_wil_UpdateMonitorParametersComplete (pInternals, ADI_WIL_ERR_FAIL);
+        }
+    }
+}
+
+static void wb_wil_UpdateMonitorParametersStartCommit (adi_wil_pack_internals_t * const pInternals)
+{
+    /* Increment the token */
+    wb_wil_IncrementWithRollover16 (&pInternals->UserRequestState.iToken);
+
+    /* If we rolled over, increment it again so the token is now non-zero */
+    if (pInternals->UserRequestState.iToken == 0u)
+    {
+        wb_wil_IncrementWithRollover16 (&pInternals->UserRequestState.iToken);
+    }
+
+    /* The commit goes through the user request state as it would without
+     * the window */
+    pInternals->UserRequestState.iRetries = 0u;
+    pInternals->UserRequestState.iRequestCount = 0u;
+    pInternals->UserRequestState.iPendingResponses = pInternals->UpdateMonParamsState.iUpdateMap;
+    pInternals->UserRequestState.pfRequestFunc = &wb_wil_UpdateMonitorParametersCommitFunc;
+    pInternals->UpdateMonParamsState.ePhase = ADI_WIL_UPDATE_MONITOR_PARAMS_COMMIT;
+
+    wb_wil_UpdateMonitorParametersCommitFunc (pInternals);
+}
+
+static adi_wil_request_context_t * wb_wil_UpdateMonitorParametersFindSlot (adi_wil_pack_internals_t * const pInternals,
+                                                                           uint16_t iToken)
+{
+    /* Return value of this function */
+    adi_wil_request_context_t * pSlot = (void *) 0;
+
+    for (uint8_t i = 0u; i < ADI_WIL_UPDATE_MONITOR_PARAMS_WINDOW; i++)
+    {
+        if ((ADI_WIL_REQUEST_CONTEXT_FREE != pInternals->UpdateMonParamsState.Window [i].eState) &&
+            (iToken == pInternals->UpdateMonParamsState.Window [i].Request.iToken))
+        {
+            pSlot = &pInternals->UpdateMonParamsState.Window [i];
+        }
+    }
+
+    return pSlot;
+}
+
+static void wb_wil_UpdateMonitorParametersReleaseSlot (adi_wil_request_context_t * const pSlot)
+{
+    pSlot->Request.bValid = false;
+    pSlot->eState = ADI_WIL_REQUEST_CONTEXT_FREE;
+}
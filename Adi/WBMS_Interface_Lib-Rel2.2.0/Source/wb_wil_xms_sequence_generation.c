@@ -9,6 +9,7 @@
 
 #include "wb_wil_xms_sequence_generation.h"
 #include "adi_wil_pack_internals.h"
+#include "adi_wil_xms_internals.h"
 #include "wb_wil_msg_header.h"
 #include "wb_xms.h"
 #include "wb_wil_utils.h"
@@ -55,6 +56,19 @@ static bool wb_wil_CheckXMSTimestampDistance (adi_wil_xms_timestamp_conversion_s
                                               uint32_t iNewTimestamp,
                                               uint8_t iPacketsPerInterval);
 
+static bool wb_wil_IsPreviousIntervalPacket (adi_wil_xms_timestamp_conversion_state_t const * const pState,
+                                             uint8_t const * const pData,
+                                             uint8_t iDeviceIndex);
+
+static void wb_wil_HandlePreviousIntervalPacket (adi_wil_pack_internals_t * const pInternals,
+                                                 adi_wil_xms_timestamp_conversion_state_t * const pState,
+                                                 adi_wil_xms_pkt_statistics_t * const pStats,
+                                                 wb_msg_header_t * const pMsgHeader,
+                                                 wb_xms_metadata_t * const pXmsMetadata,
+                                                 uint8_t const * const pData,
+                                                 uint8_t iDeviceIndex,
+                                                 uint8_t iPacketsPerInterval);
+
 static void wb_wil_RollIntervalForward (adi_wil_xms_timestamp_conversion_state_t * const pState,
                                         uint8_t iPacketsPerInterval);
 
@@ -161,8 +175,9 @@ void wb_wil_HandleXmsMeasurement (adi_wil_pack_internals_t * const pInternals,
              * packets if the sequence number was not initialized yet */
             if (pState->bFlushRequired)
             {
-                /* Invoke XMS flush function for this data type */
-                wb_xms_Flush (pInternals->pPack, pXmsMetadata->eType);
+                /* Roll the XMS buffer over for this data type, it may hold
+                 * the interval open for late packets */
+                wb_xms_RollOver (pInternals->pPack, pXmsMetadata->eType);
                 
                 /* Reset flush flag */
                 pState->bFlushRequired = false;
@@ -191,7 +206,98 @@ void wb_wil_HandleXmsMeasurement (adi_wil_pack_internals_t * const pInternals,
                 pState->iMeasurementsReceived [iDeviceIndex]++;
             }
         }
+        /* Else, a late packet of the previous interval is offered to the
+         * interval held in its grace window */
+        else if ((ADI_WIL_XMS_GRACE_WINDOW_MS > 0u) &&
+                 wb_wil_IsPreviousIntervalPacket (pState,
+                                                  pData,
+                                                  iDeviceIndex))
+        {
+            wb_wil_HandlePreviousIntervalPacket (pInternals,
+                                                 pState,
+                                                 pStats,
+                                                 pMsgHeader,
+                                                 pXmsMetadata,
+                                                 pData,
+                                                 iDeviceIndex,
+                                                 iPacketsPerInterval);
+        }
+        else
+        {
+            /* Do nothing - old timestamp */
+        }
+    }
+}
+
+bool wb_wil_HandleBmsMeasurementFast (adi_wil_pack_internals_t * const pInternals,
+                                      uint8_t iSourceDeviceId,
+                                      uint8_t const * const pData,
+                                      uint8_t iLength,
+                                      uint64_t iDeviceId)
+{
+    /* Pointer to BMS timestamp state */
+    adi_wil_xms_timestamp_conversion_state_t * pState;
+
+    /* Storage for the extracted timestamp */
+    uint32_t iNewTimestamp;
+
+    /* Measurements of this device stored so far in the interval */
+    uint8_t iReceived;
+
+    /* Return value of this function */
+    bool bStored;
+
+    /* Initialize return value to hand the packet back to the caller */
+    bStored = false;
+
+    /* Only node packets received through a manager are taken */
+    if ((pInternals != NULL) &&
+        (pData != NULL) &&
+        (iSourceDeviceId < ADI_WIL_MAX_NODES) &&
+        ((iDeviceId == ADI_WIL_DEV_MANAGER_0) || (iDeviceId == ADI_WIL_DEV_MANAGER_1)))
+    {
+        pState = &pInternals->BmsTimestampConversionState;
+        iReceived = pState->iMeasurementsReceived [iSourceDeviceId];
+
+        /* Extract timestamp as a 32-bit value, as wb_wil_ProcessXMSTimestamp */
+        iNewTimestamp = ((uint32_t) pData [1] << 24) |
+                        ((uint32_t) pData [2] << 16) |
+                        ((uint32_t) pData [3] << 8);
+
+        /* Steady state: the packet carries the timestamp of the current
+         * interval, no interval change or flush is pending and the device
+         * still has packets to deliver. Node timestamps are tracked at
+         * index 0 */
+        if (pState->TimestampState [0u].bInitialized &&
+            !pState->TimestampState [0u].bPendingChange &&
+            (pState->TimestampState [0u].iTimestamp == iNewTimestamp) &&
+            !pState->bFlushRequired &&
+            (iReceived < pInternals->XmsMeasurementParameters.iBMSPackets) &&
+            wb_xms_HandleBmsMeasurementFast (pInternals->pPack,
+                                             iSourceDeviceId,
+                                             (uint8_t) (pState->iBaseSequenceNumber + iReceived),
+                                             (0u == iReceived),
+                                             pData,
+                                             iLength))
+        {
+            /* Increment the packet count for the relevant manager */
+            if (iDeviceId == ADI_WIL_DEV_MANAGER_0)
+            {
+                wb_wil_IncrementWithRollover32 (&pInternals->Stats.BmsPktStats.iManager0PktCount);
+            }
+            else
+            {
+                wb_wil_IncrementWithRollover32 (&pInternals->Stats.BmsPktStats.iManager1PktCount);
+            }
+
+            /* Increment the count of measurements received for this device */
+            pState->iMeasurementsReceived [iSourceDeviceId]++;
+
+            bStored = true;
+        }
     }
+
+    return bStored;
 }
 
 void wb_wil_XmsStandbyTransition (adi_wil_pack_internals_t * const pInternals)
@@ -319,6 +425,7 @@ static bool wb_wil_ProcessXMSTimestamp (adi_wil_xms_timestamp_conversion_state_t
     if (!pThisTimestamp->bInitialized)
     {
         pThisTimestamp->iTimestamp = iNewTimestamp;
+        pThisTimestamp->iPreviousTimestamp = iNewTimestamp;
         pThisTimestamp->bInitialized = true;
         pThisTimestamp->bPendingChange = false;
     }
@@ -336,9 +443,85 @@ static bool wb_wil_ProcessXMSTimestamp (adi_wil_xms_timestamp_conversion_state_t
     return bValid;
 }
 
+static bool wb_wil_IsPreviousIntervalPacket (adi_wil_xms_timestamp_conversion_state_t const * const pState,
+                                             uint8_t const * const pData,
+                                             uint8_t iDeviceIndex)
+{
+    /* Pointer to the relevant timestamp for this device */
+    adi_wil_xms_timestamp_state_t const * pThisTimestamp;
+
+    /* Storage for the extracted timestamp */
+    uint32_t iNewTimestamp;
+
+    /* Extract timestamp as a 32-bit value, as wb_wil_ProcessXMSTimestamp */
+    iNewTimestamp = ((uint32_t) pData [1] << 24) |
+                    ((uint32_t) pData [2] << 16) |
+                    ((uint32_t) pData [3] << 8);
+
+    /* Use the timestamp at index 0 for all devices except manager 1 */
+    pThisTimestamp = (iDeviceIndex != WB_XMS_MANAGER_1_INDEX) ? &pState->TimestampState [0u] :
+                                                                &pState->TimestampState [1u];
+
+    /* While a timestamp is pending its change it still holds the previous
+     * interval's value, afterwards the previous value was kept aside */
+    return (pState->bPreviousIntervalOpen &&
+            pThisTimestamp->bInitialized &&
+            (pThisTimestamp->bPendingChange ? (iNewTimestamp == pThisTimestamp->iTimestamp) :
+                                              ((iNewTimestamp == pThisTimestamp->iPreviousTimestamp) &&
+                                               (iNewTimestamp != pThisTimestamp->iTimestamp))));
+}
+
+static void wb_wil_HandlePreviousIntervalPacket (adi_wil_pack_internals_t * const pInternals,
+                                                 adi_wil_xms_timestamp_conversion_state_t * const pState,
+                                                 adi_wil_xms_pkt_statistics_t * const pStats,
+                                                 wb_msg_header_t * const pMsgHeader,
+                                                 wb_xms_metadata_t * const pXmsMetadata,
+                                                 uint8_t const * const pData,
+                                                 uint8_t iDeviceIndex,
+                                                 uint8_t iPacketsPerInterval)
+{
+    /* Measurements of this device stored so far in the previous interval */
+    uint8_t iReceived;
+
+    iReceived = pState->iPreviousMeasurementsReceived [iDeviceIndex];
+
+    /* Check we haven't already submitted a full set of packets for this
+     * device in the previous interval */
+    if (iReceived >= iPacketsPerInterval)
+    {
+        wb_wil_IncrementWithRollover32 (&pStats->iRejectedPktCount);
+    }
+    else
+    {
+        /* The previous interval's sequence numbers end at the current base */
+        pMsgHeader->iSequenceNumber = (uint8_t) ((pState->iBaseSequenceNumber - iPacketsPerInterval) + iReceived);
+
+        pXmsMetadata->eCmdId = (iReceived == 0u) ? ADI_WIL_XMS_START_MEASUREMENT :
+                                                   ADI_WIL_XMS_SUPPLEMENTAL_MEASUREMENT;
+
+        /* Rejected by the XMS module once the grace window has closed */
+        if (ADI_WIL_ERR_SUCCESS != wb_xms_HandleMeasurement (pInternals->pPack,
+                                                             pMsgHeader,
+                                                             pXmsMetadata,
+                                                             pData))
+        {
+            wb_wil_IncrementWithRollover32 (&pStats->iRejectedPktCount);
+        }
+        else
+        {
+            pState->iPreviousMeasurementsReceived [iDeviceIndex]++;
+        }
+    }
+}
+
 static void wb_wil_RollIntervalForward (adi_wil_xms_timestamp_conversion_state_t * const pState,
                                         uint8_t iPacketsPerInterval)
 {
+    /* Keep the counts of the interval being closed for its late packets */
+    (void) memcpy (pState->iPreviousMeasurementsReceived,
+                   pState->iMeasurementsReceived,
+                   sizeof (pState->iPreviousMeasurementsReceived));
+
     /* Reset the individual device measurement counts for this interval */
     (void) memset (pState->iMeasurementsReceived, 0, sizeof (pState->iMeasurementsReceived));
 
@@ -385,7 +568,8 @@ static bool wb_wil_CheckXMSTimestampDistance (adi_wil_xms_timestamp_conversion_s
      * by a normal amount */
     else if ((iDistance < ((uint32_t) UINT32_MAX - (WB_XMS_TIMESTAMP_ROLLOVER_DIFFERENCE << 8u))))
     {
-        /* Update to the new timestamp */
+        /* Update to the new timestamp, keeping the one it replaces */
+        pThisTimestamp->iPreviousTimestamp = pThisTimestamp->iTimestamp;
         pThisTimestamp->iTimestamp = iNewTimestamp;
 
         /* If this timestamp was pending a change, clear pending flag and return */
@@ -404,6 +588,9 @@ static bool wb_wil_CheckXMSTimestampDistance (adi_wil_xms_timestamp_conversion_s
 
             /* Flag this state as now flushable as the timestamp has changed */
             pState->bFlushRequired = true;
+
+            /* The interval just closed may take late packets */
+            pState->bPreviousIntervalOpen = true;
         }
     }
     /* Else, we've rolled backwards. Mark as invalid */
@@ -435,5 +622,8 @@ static void wb_wil_ClearCurrentIntervalState (adi_wil_xms_timestamp_conversion_s
         /* Mark both timestamps as now pending a change */
         pState->TimestampState [0].bPendingChange = true;
         pState->TimestampState [1].bPendingChange = true;
+
+        /* The interval was flushed, not rolled over */
+        pState->bPreviousIntervalOpen = false;
     }
 }
@@ -16,6 +16,7 @@
 #include "adi_wil_safety_internals.h"
 #include "adi_wil_types.h"
 #include "adi_wil_hal_ticker.h"
+#include "adi_wil_hal_trace.h"
 #include "adi_wil_xms_internals.h"
 #include "adi_wil_sensor_data.h"
 #include "adi_wil_sensor_data_buffer.h"
@@ -59,7 +60,12 @@ static bool wb_xms_ActivateBuffer (adi_wil_safety_internals_t const * const pInt
                                    adi_wil_xms_storage_state_t * const pStorage,
                                    uint8_t const * const pData);
 
-static bool wb_xms_WriteDeviceIdFields (adi_wil_xms_storage_state_t * const pStorage);
+static bool wb_xms_WriteDeviceIdFields (adi_wil_xms_storage_state_t * const pStorage,
+                                        uint16_t iSlotCapacity);
+
+static void wb_xms_PlaceInterval (adi_wil_safety_internals_t const * const pInternals,
+                                  adi_wil_xms_storage_state_t * const pStorage,
+                                  uint16_t * const pSlotCapacity);
 
 static bool wb_xms_ValidateTimestamp (adi_wil_safety_internals_t const * const pInternals,
                                       adi_wil_xms_storage_state_t * const pStorage,
@@ -97,6 +103,31 @@ static bool wb_xms_StorePacket (adi_wil_safety_internals_t const * const pIntern
 static void wb_xms_SubmitBuffer (adi_wil_safety_internals_t const * const pInternals,
                                  adi_wil_xms_storage_state_t * const pStorage);
 
+static void wb_xms_HoldBuffer (adi_wil_safety_internals_t const * const pInternals,
+                               adi_wil_xms_storage_state_t * const pStorage);
+
+static void wb_xms_CloseInterval (adi_wil_xms_storage_state_t * const pStorage);
+
+static void wb_xms_ReleaseGrace (adi_wil_safety_internals_t const * const pInternals,
+                                 adi_wil_xms_storage_state_t * const pStorage);
+
+static bool wb_xms_StoreGracePacket (adi_wil_safety_internals_t const * const pInternals,
+                                     adi_wil_xms_storage_state_t * const pStorage,
+                                     wb_msg_header_t const * const pMsgHeader,
+                                     wb_xms_metadata_t const * const pXmsMetadata,
+                                     uint8_t const * const pData,
+                                     uint8_t iDeviceIndex);
+
+static void wb_xms_WriteSlot (adi_wil_sensor_data_t * const pSlot,
+                              uint8_t const * const pData,
+                              uint8_t iLength,
+                              uint32_t iStartTick);
+
+static bool wb_xms_CheckDeviceComplete (adi_wil_sensor_data_t const * const pDeviceSlots,
+                                        uint8_t iNumMeasPerInt);
+
+static uint8_t wb_xms_CountDevices (uint64_t iDeviceMap);
+
 static void wb_xms_RollSequenceForward (adi_wil_xms_storage_state_t * const pStorage);
 
 static bool wb_xms_FuSaDuplicateCheck (adi_wil_safety_internals_t const * const pInternals,
@@ -108,6 +139,10 @@ static bool wb_xms_NonFuSaDuplicateCheck (adi_wil_safety_internals_t const * con
                                           uint8_t const * const pData,
                                           uint32_t iStartIndex);
 
+static bool wb_xms_FindNonFuSaDuplicate (adi_wil_sensor_data_t const * const pDeviceSlots,
+                                         uint8_t iNumMeasPerInt,
+                                         uint8_t const * const pData);
+
 static void wb_xms_IncrementWithRollover32 (uint32_t * pValue);
 
 static adi_wil_safety_internals_t * wb_xms_GetSafetyInternalsPointer (adi_wil_pack_t const * const pPack);
@@ -118,9 +153,8 @@ static adi_wil_xms_storage_state_t * wb_xms_GetStorageState (adi_wil_safety_inte
 static bool wb_xms_GetDeviceIndex (uint8_t * pDeviceIndex,
                                    uint8_t iSourceDeviceId);
 
-static uint32_t wb_xms_GetTargetSlot (uint64_t iCollectingMap,
-                                      uint64_t iDeviceId,
-                                      uint8_t iNumMeasPerInt,
+static uint32_t wb_xms_GetTargetSlot (adi_wil_xms_storage_state_t const * const pStorage,
+                                      uint8_t iDeviceIndex,
                                       uint8_t iDistance);
 
 static uint8_t wb_xms_GetDistanceFromStartSequence (uint8_t iStartSequenceNumber,
@@ -215,6 +249,11 @@ void wb_xms_InitializeAllocation (adi_wil_safety_internals_t * const pInternals,
     }
 }
 
+/* Measurement path, run for every BMS/PMS/EMS packet: executed from PSPR0
+ * under the performance profile */
+#define ADI_WIL_HAL_START_SEC_HOT_CODE
+#include "adi_wil_hal_memmap.h"
+
 adi_wil_err_t wb_xms_HandleMeasurement (adi_wil_pack_t const * const pPack,
                                         wb_msg_header_t const * const pMsgHeader,
                                         wb_xms_metadata_t const * const pXmsMetadata,
@@ -235,6 +274,108 @@ adi_wil_err_t wb_xms_HandleMeasurement (adi_wil_pack_t const * const pPack,
                                            false);
 }
 
+bool wb_xms_HandleBmsMeasurementFast (adi_wil_pack_t const * const pPack,
+                                      uint8_t iDeviceIndex,
+                                      uint8_t iSequenceNumber,
+                                      bool bStart,
+                                      uint8_t const * const pData,
+                                      uint8_t iLength)
+{
+    /* Static variable for retrieving safety internals pointer */
+    adi_wil_safety_internals_t * pInternals;
+
+    /* Pointer to the BMS storage state */
+    adi_wil_xms_storage_state_t * pStorage;
+
+    /* Storage for 64-bit version of device ID */
+    uint64_t iDeviceId;
+
+    /* First slot of this device within the buffer */
+    uint32_t iDeviceSlot;
+
+    /* Distance of sequence number from the expected start message */
+    uint8_t iDistance;
+
+    /* Return value of this function */
+    bool bStored;
+
+    /* Initialize return value to hand the packet back to the caller */
+    bStored = false;
+
+    ADI_WIL_HAL_PROFILE_BEGIN (ADI_WIL_HAL_PROFILE_XMS_BMS_FAST_PATH);
+
+    /* Retrieve safety internals pointer */
+    pInternals = wb_xms_GetSafetyInternalsPointer (pPack);
+
+    /* Only node packets that fit in a slot are taken */
+    if ((NULL != pInternals) &&
+        (NULL != pData) &&
+        (iDeviceIndex < ADI_WIL_MAX_NODES) &&
+        (iLength <= ADI_WIL_MAX_APP_PAYLOAD_SIZE))
+    {
+        pStorage = &pInternals->XMS.BmsStorageState;
+        iDeviceId = 1ULL << iDeviceIndex;
+
+        /* Get the distance from the start message */
+        iDistance = wb_xms_GetDistanceFromStartSequence (pStorage->iStartSequenceNumber [iDeviceIndex],
+                                                         iSequenceNumber);
+
+        /* Steady state: a non-FuSa interval is being collected with the
+         * parameters it was started with, the device is part of it with an
+         * established sequence and the packet falls into the device's slots
+         * of this interval as a START or SUPPLEMENTAL as expected. These are
+         * the cases in which the validation of wb_xms_HandleMeasurementCommon
+         * passes without side effects */
+        if (pInternals->XMS.bAllocationInitialized &&
+            !pStorage->bFuSaBuffer &&
+            pStorage->bCollecting &&
+            !pStorage->bCollectingFuSa &&
+            (pStorage->iCollectingNumMeasPerInt == pStorage->iNumMeasPerInt) &&
+            (pStorage->iNumMeasPerInt <= ADI_WIL_XMS_MAX_PACKETS_PER_INT) &&
+            ((pStorage->iDeviceMap & pStorage->iCollectingMap & pStorage->iSequenceInitializedMap & iDeviceId) != 0ULL) &&
+            (iDistance < pStorage->iNumMeasPerInt) &&
+            (bStart == (0u == iDistance)))
+        {
+            /* Device slots were laid out when the interval was activated */
+            iDeviceSlot = (uint32_t) pStorage->iCollectingPosition [iDeviceIndex] * (uint32_t) pStorage->iCollectingNumMeasPerInt;
+
+            /* Duplicates are left to the generic path, which reports them */
+            if (!wb_xms_FindNonFuSaDuplicate (&pStorage->pData [iDeviceSlot], pStorage->iCollectingNumMeasPerInt, pData))
+            {
+                bStored = true;
+
+                /* Store the measurement packet */
+                wb_xms_WriteSlot (&pStorage->pData [iDeviceSlot + iDistance], pData, iLength, pStorage->iStartTick);
+
+                /* Increment the valid packet statistic */
+                wb_xms_IncrementWithRollover32 (&pStorage->Stats.iValidPktCount);
+
+                /* Add the device we received on to the list of received devices */
+                pStorage->iReceivedMap |= iDeviceId;
+
+                /* Mark the device complete once all of its slots are filled */
+                if (wb_xms_CheckDeviceComplete (&pStorage->pData [iDeviceSlot], pStorage->iCollectingNumMeasPerInt))
+                {
+                    pStorage->iCompleteMap |= iDeviceId;
+                }
+
+                /* If all packets have been received, submit the buffer */
+                if (++pStorage->iNumSlotsCollected == pStorage->iNumSlotsCollecting)
+                {
+                    wb_xms_SubmitBuffer (pInternals, pStorage);
+                }
+            }
+        }
+    }
+
+    ADI_WIL_HAL_PROFILE_END (ADI_WIL_HAL_PROFILE_XMS_BMS_FAST_PATH);
+
+    return bStored;
+}
+
+#define ADI_WIL_HAL_STOP_SEC_HOT_CODE
+#include "adi_wil_hal_memmap.h"
+
 adi_wil_err_t wb_xms_HandleFuSaMeasurement (adi_wil_safety_internals_t * const pInternals,
                                             wb_msg_header_t const * const pMsgHeader,
                                             wb_xms_metadata_t const * const pXmsMetadata,
@@ -280,6 +421,14 @@ adi_wil_err_t wb_xms_CheckTimeouts (adi_wil_safety_internals_t * const pInternal
          * the last received measurement exceeds the timeout threshold */
         for (uint8_t i = 0u; i < (sizeof (eStorageStates) / sizeof (eStorageStates [0])); ++i)
         {
+            /* Release a held interval once its grace window has passed */
+            if (eStorageStates [i]->Grace.bActive &&
+                ((iCurrentTicks - eStorageStates [i]->Grace.iHoldTick) > ADI_WIL_XMS_GRACE_WINDOW_MS))
+            {
+                wb_xms_ReleaseGrace (pInternals,
+                                     eStorageStates [i]);
+            }
+
             if (eStorageStates [i]->bCollecting)
             {
                 /* Calculate time we've been in the collecting state */
@@ -350,6 +499,10 @@ void wb_xms_Flush (adi_wil_pack_t const * const pPack,
         pState = wb_xms_GetStorageState (pInternals,
                                          eType);
 
+        /* Release an interval still held for late packets */
+        wb_xms_ReleaseGrace (pInternals,
+                             pState);
+
         /* Only allow this function to flush the buffer if it's allocated to a
          * non-fusa context */
         if (!pState->bFuSaBuffer)
@@ -361,6 +514,36 @@ void wb_xms_Flush (adi_wil_pack_t const * const pPack,
     }
 }
 
+void wb_xms_RollOver (adi_wil_pack_t const * const pPack,
+                      adi_wil_xms_type_t eType)
+{
+    /* Static variable for retrieving safety internals pointer */
+    adi_wil_safety_internals_t * pInternals;
+
+    /* Static variable for selecting internals based on XMS type */
+    adi_wil_xms_storage_state_t * pState;
+
+    /* Retrieve safety internals pointer */
+    pInternals = wb_xms_GetSafetyInternalsPointer (pPack);
+
+    /* Validate before dereferencing */
+    if (NULL != pInternals)
+    {
+        /* Get the storage state */
+        pState = wb_xms_GetStorageState (pInternals,
+                                         eType);
+
+        /* Only allow this function to roll the buffer over if it's allocated
+         * to a non-fusa context */
+        if (!pState->bFuSaBuffer)
+        {
+            /* Hold the interval for late packets or submit it */
+            wb_xms_HoldBuffer (pInternals,
+                               pState);
+        }
+    }
+}
+
 /******************************************************************************
 *   Local functions
 ******************************************************************************/
@@ -371,7 +554,8 @@ static void wb_xms_InitializeStorageState (adi_wil_xms_storage_state_t * const p
                                            uint16_t iNumSlotsAllocated)
 {
     /* Store a pointer to the start of this XMS type's buffer */
-    pStorage->pData = &pBuffer [*pBufferPosition];
+    pStorage->pBuffer = &pBuffer [*pBufferPosition];
+    pStorage->pData = pStorage->pBuffer;
 
     /* Store the number of packets allocated to this XMS type */
     pStorage->iNumSlotsAllocated = iNumSlotsAllocated;
@@ -417,6 +601,10 @@ static void wb_xms_UpdateStorageStateAllocation (adi_wil_xms_storage_state_t * c
     }
 }
 
+/* Everything from here to the end of the file is on the measurement path */
+#define ADI_WIL_HAL_START_SEC_HOT_CODE
+#include "adi_wil_hal_memmap.h"
+
 static adi_wil_err_t wb_xms_HandleMeasurementCommon (adi_wil_safety_internals_t * const pInternals,
                                                      wb_msg_header_t const * const pMsgHeader,
                                                      wb_xms_metadata_t const * const pXmsMetadata,
@@ -438,6 +626,8 @@ static adi_wil_err_t wb_xms_HandleMeasurementCommon (adi_wil_safety_internals_t
     /* Initialize device index var to 0 before passing to child function */
     iDeviceIndex = 0u;
 
+    ADI_WIL_HAL_PROFILE_BEGIN (ADI_WIL_HAL_PROFILE_XMS_HANDLE_MEASUREMENT);
+
     /* Validate the input parameters before dereferencing */
     if ((NULL == pInternals) ||
         (NULL == pMsgHeader) ||
@@ -464,8 +654,19 @@ static adi_wil_err_t wb_xms_HandleMeasurementCommon (adi_wil_safety_internals_t
         /* Initialize return code to assume failure */
         rc = ADI_WIL_ERR_FAIL;
 
+        /* A late packet of the interval held for its grace window is stored
+         * there */
+        if (!bFuSaContext && wb_xms_StoreGracePacket (pInternals,
+                                                      pStorage,
+                                                      pMsgHeader,
+                                                      pXmsMetadata,
+                                                      pData,
+                                                      iDeviceIndex))
+        {
+            rc = ADI_WIL_ERR_SUCCESS;
+        }
         /* If the packet received is unable to be stored, return failure */
-        if (!wb_xms_ValidateState (pInternals,
+        else if (!wb_xms_ValidateState (pInternals,
                                    pStorage,
                                    iDeviceId,
                                    bFuSaContext))
@@ -510,6 +711,8 @@ static adi_wil_err_t wb_xms_HandleMeasurementCommon (adi_wil_safety_internals_t
         }
     }
 
+    ADI_WIL_HAL_PROFILE_END (ADI_WIL_HAL_PROFILE_XMS_HANDLE_MEASUREMENT);
+
     return rc;
 }
 
@@ -739,8 +942,8 @@ static bool wb_xms_ValidateStartSequence (adi_wil_safety_internals_t const * con
     /* Check if this is the start of the next interval */
     else if (iDistance == pStorage->iNumMeasPerInt)
     {
-        /* Submit anything that's currently buffered, rolling forward */
-        wb_xms_SubmitBuffer (pInternals, pStorage);
+        /* Hold or submit anything that's currently buffered, rolling forward */
+        wb_xms_HoldBuffer (pInternals, pStorage);
     }
     /* Else, if it's an unexpected jump in sequence beyond two measurement,
      * intervals, accept and re-sync to this new sequence if: 
@@ -796,8 +999,8 @@ static bool wb_xms_ValidateSupplementalSequence (adi_wil_safety_internals_t cons
              (iDistance != pStorage->iNumMeasPerInt) &&
              (iDistance < (2u * pStorage->iNumMeasPerInt)))
     {
-        /* Submit anything that's currently buffered, rolling forward */
-        wb_xms_SubmitBuffer (pInternals, pStorage);
+        /* Hold or submit anything that's currently buffered, rolling forward */
+        wb_xms_HoldBuffer (pInternals, pStorage);
     }
     /* Else, if it's an unexpected jump in sequence beyond two measurement,
      * intervals, accept and re-sync to this new sequence if:
@@ -837,19 +1040,29 @@ static bool wb_xms_ActivateBuffer (adi_wil_safety_internals_t const * const pInt
                                    adi_wil_xms_storage_state_t * const pStorage,
                                    uint8_t const * const pData)
 {
+    /* Slots available to the interval */
+    uint16_t iSlotCapacity;
+
     if (!pStorage->bCollecting)
     {
+        /* Select the slots for the interval next to any held interval */
+        wb_xms_PlaceInterval (pInternals, pStorage, &iSlotCapacity);
+
         /* Clear the sensor data memory before use */
-        (void) memset (pStorage->pData, 0, sizeof (adi_wil_sensor_data_t) * pStorage->iNumSlotsAllocated);
+        (void) memset (pStorage->pData, 0, sizeof (adi_wil_sensor_data_t) * iSlotCapacity);
 
         /* Initialize the tick count prior to switching to COLLECTING */
         pStorage->iLastTick = adi_wil_hal_TickerGetTimestamp ();
 
+        /* The slot reception times are relative to the interval start */
+        pStorage->iStartTick = pStorage->iLastTick;
+
         /* Reset number of slots collected so far */
         pStorage->iNumSlotsCollected = 0u;
 
-        /* Zero the map of devices that we've received measurements for */
+        /* Zero the maps of devices that we've received measurements for */
         pStorage->iReceivedMap = 0ULL;
+        pStorage->iCompleteMap = 0ULL;
 
         /* Store a map of currently collecting devices for this interval */
         pStorage->iCollectingMap = pStorage->iDeviceMap;
@@ -862,7 +1075,7 @@ static bool wb_xms_ActivateBuffer (adi_wil_safety_internals_t const * const pInt
 
         /* Write the device ID fields to all slots. Flag as collecting if
          * we had enough buffer to complete the task */
-        pStorage->bCollecting = wb_xms_WriteDeviceIdFields (pStorage);
+        pStorage->bCollecting = wb_xms_WriteDeviceIdFields (pStorage, iSlotCapacity);
 
         /* Extract timestamp as a 32-bit value. As the value is only 24-bits,
          * shift everything up 8-bits to simplify comparisons */
@@ -886,38 +1099,71 @@ static bool wb_xms_ActivateBuffer (adi_wil_safety_internals_t const * const pInt
     return pStorage->bCollecting;
 }
 
-static bool wb_xms_WriteDeviceIdFields (adi_wil_xms_storage_state_t * const pStorage)
+static void wb_xms_PlaceInterval (adi_wil_safety_internals_t const * const pInternals,
+                                  adi_wil_xms_storage_state_t * const pStorage,
+                                  uint16_t * const pSlotCapacity)
 {
-    /* Temporary copy of the device map to find device index within */
-    uint64_t iTempDeviceMap;
+    /* Half of the slots allocated to this XMS type */
+    uint16_t iHalf;
 
+    /* Slots the interval will need */
+    uint32_t iSlotsNeeded;
+
+    iHalf = pStorage->iNumSlotsAllocated / 2u;
+    iSlotsNeeded = (uint32_t) wb_xms_CountDevices (pStorage->iDeviceMap) * (uint32_t) pStorage->iNumMeasPerInt;
+
+    /* A held interval occupies one half, use the other one if it fits */
+    if (pStorage->Grace.bActive && (iSlotsNeeded <= iHalf))
+    {
+        pStorage->pData = (pStorage->Grace.pData == pStorage->pBuffer) ? &pStorage->pBuffer [iHalf] :
+                                                                         pStorage->pBuffer;
+        *pSlotCapacity = iHalf;
+    }
+    /* Else, the interval may need every slot so release any held interval */
+    else
+    {
+        wb_xms_ReleaseGrace (pInternals, pStorage);
+
+        pStorage->pData = pStorage->pBuffer;
+        *pSlotCapacity = pStorage->iNumSlotsAllocated;
+    }
+}
+
+static bool wb_xms_WriteDeviceIdFields (adi_wil_xms_storage_state_t * const pStorage,
+                                        uint16_t iSlotCapacity)
+{
     /* Storage for device ID we are currently writing to the buffer */
     uint64_t iDeviceId;
 
+    /* Position of the current device within the collecting map */
+    uint8_t iPosition;
+
     /* Return value of this function */
     bool bSuccess;
 
     /* Initialize return value to successful */
     bSuccess = true;
 
-    /* Store a local copy of the device map */
-    iTempDeviceMap = pStorage->iCollectingMap;
+    /* Start at the first position of the buffer */
+    iPosition = 0u;
 
     /* Initialize the total packet count to 0 */
     pStorage->iNumSlotsCollecting = 0u;
 
-    /* Loop through each set bit of the device map */
-    while (iTempDeviceMap != 0ULL)
+    /* Loop through each device index, in the order of the bits of the map */
+    for (uint8_t iDeviceIndex = 0u; iDeviceIndex < ADI_WIL_MAX_DEVICES; iDeviceIndex++)
     {
-        /* Generate the device ID from the LSB of map */
-        iDeviceId = iTempDeviceMap & ~(iTempDeviceMap - 1ULL);
-
-        /* Clear the bit in the device map */
-        iTempDeviceMap &= ~iDeviceId;
+        /* Generate the device ID from the index */
+        iDeviceId = 1ULL << iDeviceIndex;
 
+        /* Skip devices we are not collecting for */
+        if ((pStorage->iCollectingMap & iDeviceId) == 0ULL)
+        {
+            /* Do nothing */
+        }
         /* Check we have sufficient storage in the buffer... */
-        if (pStorage->iNumSlotsAllocated >= (pStorage->iNumSlotsCollecting +
-                                             pStorage->iCollectingNumMeasPerInt))
+        else if (iSlotCapacity >= (pStorage->iNumSlotsCollecting +
+                                   pStorage->iCollectingNumMeasPerInt))
         {
             /* Write the device id for n = number packets per device */
             for (uint8_t i = 0u; i < pStorage->iCollectingNumMeasPerInt; i++)
@@ -925,6 +1171,10 @@ static bool wb_xms_WriteDeviceIdFields (adi_wil_xms_storage_state_t * const pSto
                 pStorage->pData [pStorage->iNumSlotsCollecting + i].eDeviceId = iDeviceId;
             }
 
+            /* Store the position for the packet lookup in wb_xms_StorePacket */
+            pStorage->iCollectingPosition [iDeviceIndex] = iPosition;
+            iPosition++;
+
             /* Increment the number of slots we are collecting */
             pStorage->iNumSlotsCollecting += pStorage->iCollectingNumMeasPerInt;
         }
@@ -963,6 +1213,8 @@ static bool wb_xms_StorePacket (adi_wil_safety_internals_t const * const pIntern
     /* Initialize device index var to 0 before passing to child function */
     iDeviceIndex = 0u;
 
+    ADI_WIL_HAL_PROFILE_BEGIN (ADI_WIL_HAL_PROFILE_XMS_STORE_PACKET);
+
     /* Already validated the device ID is good so cast return value to void */
     (void) wb_xms_GetDeviceIndex (&iDeviceIndex, pMsgHeader->iSourceDeviceId);
 
@@ -971,9 +1223,8 @@ static bool wb_xms_StorePacket (adi_wil_safety_internals_t const * const pIntern
                                                      pMsgHeader->iSequenceNumber);
 
     /* Find the device's START packet position within the buffer */
-    iTargetSlot = wb_xms_GetTargetSlot (pStorage->iCollectingMap,
-                                        iDeviceId,
-                                        pStorage->iCollectingNumMeasPerInt,
+    iTargetSlot = wb_xms_GetTargetSlot (pStorage,
+                                        iDeviceIndex,
                                         iDistance);
 
     /* Perform a sanity check on the slot position */
@@ -1004,12 +1255,8 @@ static bool wb_xms_StorePacket (adi_wil_safety_internals_t const * const pIntern
         /* Set response code to valid */
         bValid = true;
 
-        /* Store the length */
-        pStorage->pData [iTargetSlot].iLength = pMsgHeader->iPayloadLength;
-
         /* Store the measurement packet */
-        (void) memcpy (&pStorage->pData [iTargetSlot].Data [0], &pData [0],
-                       pMsgHeader->iPayloadLength);
+        wb_xms_WriteSlot (&pStorage->pData [iTargetSlot], pData, pMsgHeader->iPayloadLength, pStorage->iStartTick);
 
         /* Increment the valid packet statistic */
         wb_xms_IncrementWithRollover32 (&pStorage->Stats.iValidPktCount);
@@ -1017,6 +1264,12 @@ static bool wb_xms_StorePacket (adi_wil_safety_internals_t const * const pIntern
         /* Add the device we received on to the list of received devices */
         pStorage->iReceivedMap |= iDeviceId;
 
+        /* Mark the device complete once all of its slots are filled */
+        if (wb_xms_CheckDeviceComplete (&pStorage->pData [iTargetSlot - iDistance], pStorage->iCollectingNumMeasPerInt))
+        {
+            pStorage->iCompleteMap |= iDeviceId;
+        }
+
         /* If all packets have been received, submit the buffer */
         if (++pStorage->iNumSlotsCollected == pStorage->iNumSlotsCollecting)
         {
@@ -1024,6 +1277,8 @@ static bool wb_xms_StorePacket (adi_wil_safety_internals_t const * const pIntern
         }
     }
 
+    ADI_WIL_HAL_PROFILE_END (ADI_WIL_HAL_PROFILE_XMS_STORE_PACKET);
+
     /* Return success/non-success to caller */
     return bValid;
 }
@@ -1031,12 +1286,28 @@ static bool wb_xms_StorePacket (adi_wil_safety_internals_t const * const pIntern
 static void wb_xms_SubmitBuffer (adi_wil_safety_internals_t const * const pInternals,
                                  adi_wil_xms_storage_state_t * const pStorage)
 {
-    adi_wil_sensor_data_buffer_t const  Buffer = { .pData = pStorage->pData,
-                                                   .iCount = pStorage->iNumSlotsCollecting };
+    /* Buffer handed to the application */
+    adi_wil_sensor_data_buffer_t Buffer;
+
+    ADI_WIL_HAL_PROFILE_BEGIN (ADI_WIL_HAL_PROFILE_XMS_SUBMIT_BUFFER);
+
+    /* Release any held interval first so intervals are delivered in order */
+    wb_xms_ReleaseGrace (pInternals, pStorage);
 
     /* Check if we're currently collecting measurements */
     if (pStorage->bCollecting)
     {
+        ADI_WIL_HAL_TRACE (ADI_WIL_HAL_TRACE_EVT_XMS_SUBMIT, pStorage->eEvent, pStorage->iNumSlotsCollecting);
+
+        /* Describe the interval in place, the slots are not copied */
+        Buffer.pData = pStorage->pData;
+        Buffer.iCount = pStorage->iNumSlotsCollecting;
+        Buffer.iReceivedMap = pStorage->iReceivedMap;
+        Buffer.iCompleteMap = pStorage->iCompleteMap;
+        Buffer.iStartTime = pStorage->iStartTick;
+        Buffer.iReleaseTime = adi_wil_hal_TickerGetTimestamp ();
+        Buffer.iGracePktCount = 0u;
+
         /* Notify the application that data is available to be read */
         wb_wil_ui_GenerateFuSaEvent (pInternals->pPack,
                                      pStorage->eEvent,
@@ -1045,27 +1316,247 @@ static void wb_xms_SubmitBuffer (adi_wil_safety_internals_t const * const pInter
         /* Increment the notification count */
         wb_xms_IncrementWithRollover32 (&pStorage->Stats.iDataNotifCount);
 
-        /* Roll the sequence number forward for all the collecting nodes */
-        wb_xms_RollSequenceForward (pStorage);
+        /* Roll forward to the next interval */
+        wb_xms_CloseInterval (pStorage);
+    }
 
-        /* Shift the timestamp history forward to make space for the recently
-         * submitted interval as a historical timestamp */
-        (void) memmove (&pStorage->iHistoricalTimestamps [1u],
-                        &pStorage->iHistoricalTimestamps [0u],
-                        (sizeof (pStorage->iHistoricalTimestamps [0u]) * (ADI_WIL_TIMESTAMP_HISTORY_COUNT_MAX - 1u)));
+    ADI_WIL_HAL_PROFILE_END (ADI_WIL_HAL_PROFILE_XMS_SUBMIT_BUFFER);
+}
 
-        /* Store this interval's timestamp in the history */
-        pStorage->iHistoricalTimestamps [0] = pStorage->iCurrentTimestamp;
+static void wb_xms_HoldBuffer (adi_wil_safety_internals_t const * const pInternals,
+                               adi_wil_xms_storage_state_t * const pStorage)
+{
+    /* Hold the interval only if some packets are missing and the next
+     * interval still finds a free half of the slots */
+    if ((ADI_WIL_XMS_GRACE_WINDOW_MS > 0u) &&
+        pStorage->bCollecting &&
+        !pStorage->bCollectingFuSa &&
+        (pStorage->iNumSlotsCollected < pStorage->iNumSlotsCollecting) &&
+        (pStorage->iNumSlotsCollecting <= (pStorage->iNumSlotsAllocated / 2u)))
+    {
+        /* Only one interval is held at a time, release the older one */
+        wb_xms_ReleaseGrace (pInternals, pStorage);
+
+        /* Keep the interval where it is, the next one uses the other half */
+        pStorage->Grace.iCollectingMap = pStorage->iCollectingMap;
+        pStorage->Grace.iReceivedMap = pStorage->iReceivedMap;
+        pStorage->Grace.iCompleteMap = pStorage->iCompleteMap;
+        pStorage->Grace.pData = pStorage->pData;
+        pStorage->Grace.iStartTick = pStorage->iStartTick;
+        pStorage->Grace.iHoldTick = adi_wil_hal_TickerGetTimestamp ();
+        pStorage->Grace.iNumSlotsCollecting = pStorage->iNumSlotsCollecting;
+        pStorage->Grace.iNumSlotsCollected = pStorage->iNumSlotsCollected;
+        pStorage->Grace.iGracePktCount = 0u;
+        pStorage->Grace.iNumMeasPerInt = pStorage->iCollectingNumMeasPerInt;
+        pStorage->Grace.bActive = true;
+
+        /* Roll forward to the next interval */
+        wb_xms_CloseInterval (pStorage);
+    }
+    /* Else, hand the interval over now */
+    else
+    {
+        wb_xms_SubmitBuffer (pInternals, pStorage);
+    }
+}
+
+static void wb_xms_ReleaseGrace (adi_wil_safety_internals_t const * const pInternals,
+                                 adi_wil_xms_storage_state_t * const pStorage)
+{
+    /* Buffer handed to the application */
+    adi_wil_sensor_data_buffer_t Buffer;
+
+    if (pStorage->Grace.bActive)
+    {
+        ADI_WIL_HAL_TRACE (ADI_WIL_HAL_TRACE_EVT_XMS_SUBMIT, pStorage->eEvent, pStorage->Grace.iNumSlotsCollecting);
+
+        /* Describe the held interval in place */
+        Buffer.pData = pStorage->Grace.pData;
+        Buffer.iCount = pStorage->Grace.iNumSlotsCollecting;
+        Buffer.iReceivedMap = pStorage->Grace.iReceivedMap;
+        Buffer.iCompleteMap = pStorage->Grace.iCompleteMap;
+        Buffer.iStartTime = pStorage->Grace.iStartTick;
+        Buffer.iReleaseTime = adi_wil_hal_TickerGetTimestamp ();
+        Buffer.iGracePktCount = pStorage->Grace.iGracePktCount;
+
+        /* Mark the held slots free before notifying, the application may
+         * start the next interval from within the event */
+        pStorage->Grace.bActive = false;
+
+        /* Notify the application that data is available to be read */
+        wb_wil_ui_GenerateFuSaEvent (pInternals->pPack,
+                                     pStorage->eEvent,
+                                     &Buffer);
+
+        /* Increment the notification count */
+        wb_xms_IncrementWithRollover32 (&pStorage->Stats.iDataNotifCount);
+    }
+}
+
+static void wb_xms_CloseInterval (adi_wil_xms_storage_state_t * const pStorage)
+{
+    /* Roll the sequence number forward for all the collecting nodes */
+    wb_xms_RollSequenceForward (pStorage);
+
+    /* Shift the timestamp history forward to make space for the recently
+     * submitted interval as a historical timestamp */
+    (void) memmove (&pStorage->iHistoricalTimestamps [1u],
+                    &pStorage->iHistoricalTimestamps [0u],
+                    (sizeof (pStorage->iHistoricalTimestamps [0u]) * (ADI_WIL_TIMESTAMP_HISTORY_COUNT_MAX - 1u)));
+
+    /* Store this interval's timestamp in the history */
+    pStorage->iHistoricalTimestamps [0] = pStorage->iCurrentTimestamp;
+
+    /* Add to the count of historical timestamps if not already full */
+    if (pStorage->iHistoricalTimestampCount < ADI_WIL_TIMESTAMP_HISTORY_COUNT_MAX)
+    {
+        pStorage->iHistoricalTimestampCount++;
+    }
+
+    /* Transition to INACTIVE */
+    pStorage->bCollecting = false;
+}
+
+static bool wb_xms_StoreGracePacket (adi_wil_safety_internals_t const * const pInternals,
+                                     adi_wil_xms_storage_state_t * const pStorage,
+                                     wb_msg_header_t const * const pMsgHeader,
+                                     wb_xms_metadata_t const * const pXmsMetadata,
+                                     uint8_t const * const pData,
+                                     uint8_t iDeviceIndex)
+{
+    /* Return value of the function */
+    bool bStored;
+
+    /* Bit of the device in the device maps */
+    uint64_t iDeviceId;
+
+    /* Distance of the packet from the START of the held interval */
+    uint8_t iDistance;
+
+    /* First slot of the device in the held interval */
+    uint32_t iDeviceSlot;
+
+    /* Initialize return value to indicate the packet is not for the held
+     * interval */
+    bStored = false;
+
+    if (pStorage->Grace.bActive && (iDeviceIndex < ADI_WIL_MAX_DEVICES))
+    {
+        iDeviceId = (1ULL << iDeviceIndex);
+
+        /* The start sequence of the device was rolled past the held
+         * interval, step back by its length */
+        iDistance = (uint8_t) (wb_xms_GetDistanceFromStartSequence (pStorage->iStartSequenceNumber [iDeviceIndex],
+                                                                    pMsgHeader->iSequenceNumber) +
+                               pStorage->Grace.iNumMeasPerInt);
+
+        /* Only store packets the held interval has a free slot for */
+        if (((pStorage->Grace.iCollectingMap & pStorage->iSequenceInitializedMap & iDeviceId) != 0ULL) &&
+            (iDistance < pStorage->Grace.iNumMeasPerInt) &&
+            ((pXmsMetadata->eCmdId == ADI_WIL_XMS_START_MEASUREMENT) == (0u == iDistance)))
+        {
+            /* Devices are laid out in device index order */
+            iDeviceSlot = (uint32_t) wb_xms_CountDevices (pStorage->Grace.iCollectingMap & (iDeviceId - 1ULL)) *
+                          (uint32_t) pStorage->Grace.iNumMeasPerInt;
+
+            bStored = true;
+
+            if (wb_xms_FindNonFuSaDuplicate (&pStorage->Grace.pData [iDeviceSlot],
+                                             pStorage->Grace.iNumMeasPerInt,
+                                             pData))
+            {
+                /* Count the duplicate as the current interval would */
+                wb_xms_IncrementWithRollover32 (&pStorage->Stats.iDupePktCount);
+
+                wb_wil_ui_GenerateFuSaEvent (pInternals->pPack,
+                                             ADI_WIL_EVENT_XMS_DUPLICATE,
+                                             NULL);
+            }
+            else
+            {
+                /* Store the measurement packet */
+                wb_xms_WriteSlot (&pStorage->Grace.pData [iDeviceSlot + iDistance],
+                                  pData,
+                                  pMsgHeader->iPayloadLength,
+                                  pStorage->Grace.iStartTick);
+
+                pStorage->Grace.iReceivedMap |= iDeviceId;
+
+                if (wb_xms_CheckDeviceComplete (&pStorage->Grace.pData [iDeviceSlot], pStorage->Grace.iNumMeasPerInt))
+                {
+                    pStorage->Grace.iCompleteMap |= iDeviceId;
+                }
+
+                pStorage->Grace.iNumSlotsCollected++;
+                pStorage->Grace.iGracePktCount++;
+                wb_xms_IncrementWithRollover32 (&pStorage->Stats.iValidPktCount);
+
+                /* Nothing left to wait for */
+                if (pStorage->Grace.iNumSlotsCollected >= pStorage->Grace.iNumSlotsCollecting)
+                {
+                    wb_xms_ReleaseGrace (pInternals, pStorage);
+                }
+            }
+        }
+    }
+
+    return bStored;
+}
+
+static void wb_xms_WriteSlot (adi_wil_sensor_data_t * const pSlot,
+                              uint8_t const * const pData,
+                              uint8_t iLength,
+                              uint32_t iStartTick)
+{
+    /* Time elapsed since the interval started */
+    uint32_t iElapsed;
+
+    iElapsed = adi_wil_hal_TickerGetTimestamp () - iStartTick;
+
+    /* Store the length and the reception time */
+    pSlot->iLength = iLength;
+    pSlot->iRxTime = (iElapsed > UINT16_MAX) ? (uint16_t) UINT16_MAX : (uint16_t) iElapsed;
+
+    /* Store the measurement packet */
+    (void) memcpy (&pSlot->Data [0], &pData [0], iLength);
+}
+
+static bool wb_xms_CheckDeviceComplete (adi_wil_sensor_data_t const * const pDeviceSlots,
+                                        uint8_t iNumMeasPerInt)
+{
+    /* Return value of the function */
+    bool bComplete;
 
-        /* Add to the count of historical timestamps if not already full */
-        if (pStorage->iHistoricalTimestampCount < ADI_WIL_TIMESTAMP_HISTORY_COUNT_MAX)
+    bComplete = true;
+
+    /* A device is complete once none of its slots is empty */
+    for (uint8_t i = 0u; i < iNumMeasPerInt; i++)
+    {
+        if (pDeviceSlots [i].iLength == 0u)
         {
-            pStorage->iHistoricalTimestampCount++;
+            bComplete = false;
+            break;
         }
+    }
 
-        /* Transition to INACTIVE */
-        pStorage->bCollecting = false;
+    return bComplete;
+}
+
+static uint8_t wb_xms_CountDevices (uint64_t iDeviceMap)
+{
+    /* Number of bits set */
+    uint8_t iCount;
+
+    iCount = 0u;
+
+    /* Clear the lowest set bit until none is left */
+    while (iDeviceMap != 0ULL)
+    {
+        iDeviceMap &= (iDeviceMap - 1ULL);
+        iCount++;
     }
+
+    return iCount;
 }
 
 static void wb_xms_RollSequenceForward (adi_wil_xms_storage_state_t * const pStorage)
@@ -1158,28 +1649,45 @@ static bool wb_xms_NonFuSaDuplicateCheck (adi_wil_safety_internals_t const * con
     /* Return value of the function */
     bool rc;
 
+    /* Look for the packet ID among this device's packets of the interval */
+    rc = wb_xms_FindNonFuSaDuplicate (&pStorage->pData [iStartIndex], pStorage->iCollectingNumMeasPerInt, pData);
+
+    if (rc)
+    {
+        /* If the target slot was already occupied, the current packet must
+         * be a duplicate */
+        wb_xms_IncrementWithRollover32 (&pStorage->Stats.iDupePktCount);
+
+        /* Generate event indicating a duplicate packet was received */
+        wb_wil_ui_GenerateFuSaEvent (pInternals->pPack,
+                                     ADI_WIL_EVENT_XMS_DUPLICATE,
+                                     NULL);
+    }
+
+    /* Return a boolean indicating if this packet was already buffered */
+    return rc;
+}
+
+static bool wb_xms_FindNonFuSaDuplicate (adi_wil_sensor_data_t const * const pDeviceSlots,
+                                         uint8_t iNumMeasPerInt,
+                                         uint8_t const * const pData)
+{
+    /* Return value of the function */
+    bool rc;
+
     /* Initialize return value to indicate we haven't found a match */
     rc = false;
 
     /* Loop through all packets in the measurement interval for this device */
-    for (uint8_t i = 0u; i < pStorage->iCollectingNumMeasPerInt; i++)
+    for (uint8_t i = 0u; i < iNumMeasPerInt; i++)
     {
         /* If the following clauses are met:
          * 1. The slot is already filled, and
          * 2. The first byte (Packet ID) matches our new packet
          * ... then indicate a duplicate */
-        if ((pStorage->pData [iStartIndex + i].iLength != 0u) &&
-            (pStorage->pData [iStartIndex + i].Data [0] == pData [0]))
+        if ((pDeviceSlots [i].iLength != 0u) &&
+            (pDeviceSlots [i].Data [0] == pData [0]))
         {
-            /* If the target slot was already occupied, the current packet must
-             * be a duplicate */
-            wb_xms_IncrementWithRollover32 (&pStorage->Stats.iDupePktCount);
-
-            /* Generate event indicating a duplicate packet was received */
-            wb_wil_ui_GenerateFuSaEvent (pInternals->pPack,
-                                         ADI_WIL_EVENT_XMS_DUPLICATE,
-                                         NULL);
-
             /* Set the return value to true indicating a duplicate was found
              * and exit loop */
             rc = true;
@@ -1187,54 +1695,21 @@ static bool wb_xms_NonFuSaDuplicateCheck (adi_wil_safety_internals_t const * con
         }
     }
 
-    /* Return a boolean indicating if this packet was already buffered */
     return rc;
 }
 
-static uint32_t wb_xms_GetTargetSlot (uint64_t iCollectingMap,
-                                      uint64_t iDeviceId,
-                                      uint8_t iNumMeasPerInt,
+static uint32_t wb_xms_GetTargetSlot (adi_wil_xms_storage_state_t const * const pStorage,
+                                      uint8_t iDeviceIndex,
                                       uint8_t iDistance)
 {
-    /* Temporary copy of the collecting map to find device index within */
-    uint64_t iTempCollectingMap;
-
-    /* The set bit's position within the collecting map */
-    uint8_t iPositionWithinMap;
-
     /* Return value of this function */
     uint32_t iTargetSlot;
 
-    /* Init temporary collecting map to 0 */
-    iTempCollectingMap = 0ULL;
-
-    /* Init the position within the map to bit 0 */
-    iPositionWithinMap = 0u;
-
-    /* Store a copy of the collecting map for identifying the device
-     * position within it. Mask off any bits higher than our device */
-    if (iDeviceId > 0ULL)
-    {
-        iTempCollectingMap = iCollectingMap & (iDeviceId - 1ULL);
-    }
-
-    /* Count the number of set bits in the temp collecting map while
-     * clearing each set bit to get the number of leading 1's before our device */
-    while (iTempCollectingMap != 0ULL)
-    {
-        iTempCollectingMap = iTempCollectingMap & (iTempCollectingMap - 1u);
-        iPositionWithinMap++;
-
-        if (iPositionWithinMap >= ((uint8_t) ADI_WIL_MAX_DEVICES - 1u))
-        {
-            break;
-        }
-    }
-
-    /* Return the device's position within the map multiplied by the number
-     * of measurements per interval and offset it by the distance from the
+    /* The device's position within the collecting map was stored when the
+     * device ID fields were written, multiply it by the number of
+     * measurements per interval and offset it by the distance from the
      * START */
-    iTargetSlot = (uint32_t) iPositionWithinMap * (uint32_t) iNumMeasPerInt;
+    iTargetSlot = (uint32_t) pStorage->iCollectingPosition [iDeviceIndex] * (uint32_t) pStorage->iCollectingNumMeasPerInt;
 
     return wb_xms_GetTargetSlotFromPosition (iTargetSlot, iDistance);
 }
@@ -1356,3 +1831,6 @@ static bool wb_xms_CheckSameTimestamp (uint32_t iTimestamp,
     return ((iDistance <= ((uint32_t) ADI_WIL_XMS_TIMESTAMP_TOLERANCE << 8u)) ||
             (iDistance > ((uint32_t) UINT32_MAX - ((uint32_t) ADI_WIL_XMS_TIMESTAMP_TOLERANCE << 8u))));
 }
+
+#define ADI_WIL_HAL_STOP_SEC_HOT_CODE
+#include "adi_wil_hal_memmap.h"
@@ -0,0 +1,94 @@
+/*******************************************************************************
+ * @brief    HAL Memory Map
+ *
+ * @details  Section placement for the performance linker profile. A source
+ *           file selects a section by defining one of the
+ *           ADI_WIL_HAL_START_SEC_* / ADI_WIL_HAL_STOP_SEC_* names and then
+ *           including this file, which issues the matching compiler pragma:
+ *
+ *               #define ADI_WIL_HAL_START_SEC_HOT_CODE
+ *               #include "adi_wil_hal_memmap.h"
+ *               ... functions ...
+ *               #define ADI_WIL_HAL_STOP_SEC_HOT_CODE
+ *               #include "adi_wil_hal_memmap.h"
+ *
+ *           HOT_CODE   code executed from the CPU0 program scratchpad (PSPR0)
+ *           FAST_CONST constant tables copied to the CPU0 data scratchpad
+ *                      (DSPR0) at startup
+ *           FAST_BSS   zero initialised buffers pinned to DSPR0
+ *
+ *           The placement only applies when ADI_WIL_PERF_PROFILE is defined on
+ *           the compiler command line, otherwise the default layout is kept
+ *           and the linker selects the sections as before. Both linker
+ *           scripts route the section names used here, so no linker option is
+ *           needed to switch profiles.
+ *
+ *           This file deliberately has no include guard.
+ *
+ * Copyright (c) 2021 Analog Devices, Inc. All Rights Reserved.
+ * This software is proprietary and confidential to Analog Devices, Inc. and its licensors.
+ *******************************************************************************/
+
+#if defined(ADI_WIL_HAL_START_SEC_HOT_CODE)
+#undef ADI_WIL_HAL_START_SEC_HOT_CODE
+#if defined(ADI_WIL_PERF_PROFILE)
+#if defined(__TASKING__)
+#pragma section code "cpu0_psram"
+#elif defined(__GNUC__)
+#pragma section ".cpu0_psram" ax
+#endif
+#endif
+
+#elif defined(ADI_WIL_HAL_STOP_SEC_HOT_CODE)
+#undef ADI_WIL_HAL_STOP_SEC_HOT_CODE
+#if defined(ADI_WIL_PERF_PROFILE)
+#if defined(__TASKING__)
+#pragma section code restore
+#elif defined(__GNUC__)
+#pragma section
+#endif
+#endif
+
+#elif defined(ADI_WIL_HAL_START_SEC_FAST_CONST)
+#undef ADI_WIL_HAL_START_SEC_FAST_CONST
+#if defined(ADI_WIL_PERF_PROFILE)
+#if defined(__TASKING__)
+#pragma section farrom "dspr_cpu0"
+#elif defined(__GNUC__)
+#pragma section ".rodata_dspr_cpu0" a
+#endif
+#endif
+
+#elif defined(ADI_WIL_HAL_STOP_SEC_FAST_CONST)
+#undef ADI_WIL_HAL_STOP_SEC_FAST_CONST
+#if defined(ADI_WIL_PERF_PROFILE)
+#if defined(__TASKING__)
+#pragma section farrom restore
+#elif defined(__GNUC__)
+#pragma section
+#endif
+#endif
+
+#elif defined(ADI_WIL_HAL_START_SEC_FAST_BSS)
+#undef ADI_WIL_HAL_START_SEC_FAST_BSS
+#if defined(ADI_WIL_PERF_PROFILE)
+#if defined(__TASKING__)
+#pragma section farbss "bss_cpu0"
+#elif defined(__GNUC__)
+#pragma section ".bss_cpu0" awB
+#endif
+#endif
+
+#elif defined(ADI_WIL_HAL_STOP_SEC_FAST_BSS)
+#undef ADI_WIL_HAL_STOP_SEC_FAST_BSS
+#if defined(ADI_WIL_PERF_PROFILE)
+#if defined(__TASKING__)
+#pragma section farbss restore
+#elif defined(__GNUC__)
+#pragma section
+#endif
+#endif
+
+#else
+#error "adi_wil_hal_memmap.h included without selecting a section"
+#endif
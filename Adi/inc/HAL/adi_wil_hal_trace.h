@@ -0,0 +1,143 @@
+/*******************************************************************************
+ * @brief    HAL Trace
+ *
+ * @details  Binary event trace for timing analysis. Each event is stored as a
+ *           fixed 16-byte record (STM0 timestamp, event ID, two 32-bit
+ *           arguments) in a per-core ring buffer. Slots are reserved with
+ *           CMPSWAP so recording is lock-free and safe from ISR context.
+ *
+ *           Tracing is compiled in only when ADI_WIL_HAL_TRACE_ENABLE is
+ *           defined on the compiler command line. Otherwise the
+ *           ADI_WIL_HAL_TRACE* macros expand to nothing and their arguments are
+ *           not evaluated, so they must not have side effects.
+ *
+ *           The whole adi_wil_hal_TraceBuffer object is dumped from the target
+ *           (see Tool/Trace) and decoded on the host.
+ *
+ *           Function profiling (ADI_WIL_HAL_PROFILE_ENABLE) accumulates the
+ *           STM0 ticks spent between ADI_WIL_HAL_PROFILE_BEGIN/END per
+ *           function: call count, total, minimum and maximum. Used to compare
+ *           the default and performance (ADI_WIL_PERF_PROFILE, see
+ *           adi_wil_hal_memmap.h) layouts on the same traffic. A function
+ *           must not be re-entered or run on two cores at once while timed.
+ *
+ * Copyright (c) 2021 Analog Devices, Inc. All Rights Reserved.
+ * This software is proprietary and confidential to Analog Devices, Inc. and its licensors.
+ *******************************************************************************/
+#ifndef ADI_WIL_HAL_TRACE_H
+#define ADI_WIL_HAL_TRACE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+
+#define ADI_WIL_HAL_TRACE_MAGIC         (0x52544441u)   /* "ADTR" little-endian */
+#define ADI_WIL_HAL_TRACE_CORE_COUNT    (4u)            /* TC38x has CPU0..CPU3 */
+
+#ifndef ADI_WIL_HAL_TRACE_RECORD_COUNT
+#define ADI_WIL_HAL_TRACE_RECORD_COUNT  (256u)          /* Records per core, must be a power of two */
+#endif
+
+
+/* Event identifiers. Values are part of the dump format - append only. */
+typedef enum
+{
+    ADI_WIL_HAL_TRACE_EVT_NONE          = 0x0000u,
+    ADI_WIL_HAL_TRACE_EVT_FRAME_TX      = 0x0001u,  /* arg0: SPI device, arg1: payload length */
+    ADI_WIL_HAL_TRACE_EVT_FRAME_RX      = 0x0002u,  /* arg0: SPI device, arg1: payload length */
+    ADI_WIL_HAL_TRACE_EVT_API_CB        = 0x0003u,  /* arg0: adi_wil_api_t, arg1: adi_wil_err_t */
+    ADI_WIL_HAL_TRACE_EVT_API_TIMEOUT   = 0x0004u,  /* arg0: adi_wil_api_t, arg1: 0 */
+    ADI_WIL_HAL_TRACE_EVT_XMS_SUBMIT    = 0x0005u,  /* arg0: adi_wil_event_id_t, arg1: slot count */
+    ADI_WIL_HAL_TRACE_EVT_CMIC_STEP     = 0x0006u,  /* arg0: new packed state, arg1: previous packed state */
+    ADI_WIL_HAL_TRACE_EVT_USER          = 0x8000u,  /* First ID free for application use */
+} adi_wil_hal_trace_event_t;
+
+typedef struct
+{
+    uint32_t iTimestamp;        /* STM0 lower 32 bits */
+    uint16_t iEvent;            /* adi_wil_hal_trace_event_t */
+    uint16_t iSequence;         /* Low 16 bits of the ring position, written last */
+    uint32_t iArg0;
+    uint32_t iArg1;
+} adi_wil_hal_trace_record_t;
+
+typedef struct
+{
+    volatile uint32_t iHead;    /* Total number of records ever reserved on this core */
+    uint32_t iReserved [3];     /* Pad the header to one record */
+    adi_wil_hal_trace_record_t Record [ADI_WIL_HAL_TRACE_RECORD_COUNT];
+} adi_wil_hal_trace_ring_t;
+
+/* Functions timed by ADI_WIL_HAL_PROFILE_BEGIN/END. Times are inclusive of
+ * the functions they call. */
+typedef enum
+{
+    ADI_WIL_HAL_PROFILE_NIL_READ_FRAME          = 0u,   /* wb_nil_ReadFrame */
+    ADI_WIL_HAL_PROFILE_NIL_VALIDATE_FRAME      = 1u,   /* wb_nil_ValidateFrameMetadata, frame CRC32 */
+    ADI_WIL_HAL_PROFILE_NIL_PROCESS_FRAME       = 2u,   /* wb_nil_ProcessFramePayload */
+    ADI_WIL_HAL_PROFILE_XMS_HANDLE_MEASUREMENT  = 3u,   /* wb_xms_HandleMeasurementCommon */
+    ADI_WIL_HAL_PROFILE_XMS_STORE_PACKET        = 4u,   /* wb_xms_StorePacket */
+    ADI_WIL_HAL_PROFILE_XMS_SUBMIT_BUFFER       = 5u,   /* wb_xms_SubmitBuffer, includes the application callback */
+    ADI_WIL_HAL_PROFILE_SCL_COMPUTE_CRC         = 6u,   /* wb_scl_ComputeCrc */
+    ADI_WIL_HAL_PROFILE_XMS_BMS_FAST_PATH       = 7u,   /* wb_xms_HandleBmsMeasurementFast, ADI_WIL_BMS_FAST_PATH_ENABLE */
+    ADI_WIL_HAL_PROFILE_COUNT                   = 8u,
+} adi_wil_hal_profile_func_t;
+
+typedef struct
+{
+    uint32_t iCount;            /* Completed BEGIN/END pairs */
+    uint32_t iMinTicks;
+    uint32_t iMaxTicks;
+    uint32_t iStart;            /* STM0 at the last BEGIN */
+    uint64_t iTotalTicks;
+} adi_wil_hal_profile_entry_t;
+
+typedef struct
+{
+    uint32_t iMagic;
+    uint16_t iRecordSize;
+    uint16_t iRecordCount;
+    uint32_t iTickHz;           /* STM0 frequency, filled by adi_wil_hal_TraceInit() */
+    uint32_t iCoreCount;
+    adi_wil_hal_trace_ring_t Ring [ADI_WIL_HAL_TRACE_CORE_COUNT];
+} adi_wil_hal_trace_buffer_t;
+
+
+#if defined(ADI_WIL_HAL_TRACE_ENABLE)
+
+extern adi_wil_hal_trace_buffer_t adi_wil_hal_TraceBuffer;
+
+void adi_wil_hal_TraceInit(void);
+void adi_wil_hal_TraceRecord(uint16_t iEvent, uint32_t iArg0, uint32_t iArg1);
+
+#define ADI_WIL_HAL_TRACE_INIT()                        adi_wil_hal_TraceInit()
+#define ADI_WIL_HAL_TRACE(eEvent, iArg0, iArg1)         adi_wil_hal_TraceRecord((uint16_t) (eEvent), (uint32_t) (iArg0), (uint32_t) (iArg1))
+
+#else
+
+#define ADI_WIL_HAL_TRACE_INIT()                        ((void) 0)
+#define ADI_WIL_HAL_TRACE(eEvent, iArg0, iArg1)         ((void) 0)
+
+#endif
+
+
+#if defined(ADI_WIL_HAL_PROFILE_ENABLE)
+
+extern adi_wil_hal_profile_entry_t adi_wil_hal_ProfileTable [ADI_WIL_HAL_PROFILE_COUNT];
+
+void adi_wil_hal_ProfileBegin(adi_wil_hal_profile_func_t eFunc);
+void adi_wil_hal_ProfileEnd(adi_wil_hal_profile_func_t eFunc);
+void adi_wil_hal_ProfileReset(void);
+
+#define ADI_WIL_HAL_PROFILE_BEGIN(eFunc)                adi_wil_hal_ProfileBegin(eFunc)
+#define ADI_WIL_HAL_PROFILE_END(eFunc)                  adi_wil_hal_ProfileEnd(eFunc)
+
+#else
+
+#define ADI_WIL_HAL_PROFILE_BEGIN(eFunc)                ((void) 0)
+#define ADI_WIL_HAL_PROFILE_END(eFunc)                  ((void) 0)
+
+#endif
+
+
+#endif  /*  ADI_WIL_HAL_TRACE_H  */
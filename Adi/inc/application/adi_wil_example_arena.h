@@ -0,0 +1,55 @@
+/*******************************************************************************
+ * @file adi_wil_example_arena.h
+ *
+ * Copyright (c) 2020-2022 Analog Devices, Inc. All Rights Reserved. This
+ * software is proprietary and confidential to Analog Devices, Inc. and its
+ * licensors.
+ *******************************************************************************/
+
+#ifndef ADI_WIL_EXAMPLE_ARENA_H
+#define ADI_WIL_EXAMPLE_ARENA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define ADI_ARENA_ALIGN                         8u      /* Alignment of every region */
+#define ADI_ARENA_MAX_REGIONS                   16u     /* Regions tracked for the footprint report */
+
+/* Bytes a region of iBytesPerNode per node plus iFixedBytes needs for iNodes,
+ * for dimensioning the block at compile time */
+#define ADI_ARENA_REGION_SIZE(iBytesPerNode, iFixedBytes, iNodes) \
+    ((((uint32_t)(iBytesPerNode) * (uint32_t)(iNodes)) + (uint32_t)(iFixedBytes) + (ADI_ARENA_ALIGN - 1u)) & ~(ADI_ARENA_ALIGN - 1u))
+
+/*******************************************************************************
+ * Structures
+ *******************************************************************************/
+typedef struct
+{
+    const char  *pName;
+    uint32_t    iBytesPerNode;
+    uint32_t    iFixedBytes;
+    uint32_t    iBytes;                 /* Carved for the current node count, alignment included */
+}adi_arena_region_t;
+
+/*******************************************************************************
+ * Functions
+ *******************************************************************************/
+/* Hands the arena the user block and the node count the regions are carved
+ * for. Forgets all earlier regions, their memory must no longer be in use */
+extern void adi_wil_example_ArenaInit(void *pBlock, uint32_t iSize, uint8_t iNodeCount);
+
+/* Carves iBytesPerNode * node count + iFixedBytes zeroed bytes from the block.
+ * Returns NULL when the block or the region table is exhausted */
+extern void *adi_wil_example_ArenaAlloc(const char *pName, uint32_t iBytesPerNode, uint32_t iFixedBytes);
+
+/* Node count given to adi_wil_example_ArenaInit */
+extern uint8_t adi_wil_example_ArenaNodeCount(void);
+
+/* Prints every region with its bytes per node, the block usage and the
+ * saving against dimensioning for ADI_WIL_MAX_NODES */
+extern void adi_wil_example_ArenaDumpFootprint(void);
+
+#endif /* ADI_WIL_EXAMPLE_ARENA_H */
@@ -34,12 +34,78 @@
 #define USART_BAUDRATE                           921600
 #define VERBOSE                                  1
 
+/*
+ * Deferred logging: adi_wil_ex_printf()/info()/error()/fatal() store the format
+ * string address plus raw arguments in a RAM ring instead of formatting and
+ * blocking on the UART. adi_wil_ex_LogDrain() streams the ring out in the idle
+ * loop; Tool/Trace/adi_log_decode.py formats it on the host using the ELF file.
+ * It stays off by default: with it on the console carries binary records that
+ * only the decoder can read, which breaks the serial terminal the example is
+ * driven from and needs the matching ELF on the host. Off, adi_wil_ex_printf()
+ * writes text synchronously. Turn it on for timing sensitive runs.
+ **/
+#define ADI_WIL_EX_LOG_DEFERRED                  0
+#define ADI_WIL_EX_LOG_RING_WORDS                1024u   /* Ring size in 32-bit words, must be a power of two */
+#define ADI_WIL_EX_LOG_MAX_WORDS                 24u     /* Largest record (header + format + arguments) in words */
+#define ADI_WIL_EX_LOG_MAX_STRING                32u     /* Characters of a %s argument copied into the record */
+
+/*
+ * W2CAN gateway: forwards BMS/PMS data and health reports as CAN frames.
+ * ADI_W2CAN_VIRTUAL_SINK sends the frames to a RAM sink (adi_gW2canSink)
+ * instead of MCMCAN, ADI_W2CAN_LOOPBACK uses the MCMCAN internal bus loopback
+ * and captures the frames received back into the same sink.
+ **/
+#define ADI_W2CAN_ENABLE                         0       /* Schedule the W2CAN handlers */
+#define ADI_W2CAN_VIRTUAL_SINK                   0
+#define ADI_W2CAN_LOOPBACK                       0
+#define ADI_W2CAN_EXTENDED_ID                    0       /* 1: 29-bit IDs for all 62 nodes, 0: 11-bit IDs for nodes 1 to 12 */
+#define ADI_W2CAN_FD_ENABLE                      0       /* 1: CAN FD frames with bit rate switching */
+#define ADI_W2CAN_BAUDRATE                       500000u
+#define ADI_W2CAN_PMS_FORWARD                    1       /* Forward PMS packets, from the ADK and the CMIC event handlers */
+#define ADI_W2CAN_TX_PIN                         IfxCan_TXD00_P20_8_OUT     /* MCMCAN0 node 0 pins of the board */
+#define ADI_W2CAN_RX_PIN                         IfxCan_RXD00B_P20_7_IN
+#define ADI_W2CAN_FAST_BAUDRATE                  2000000u
+
 /* defines to map physical SPI ports/devices to WIL port_t */
 #define PORT0_SPI_DEVICE                        (0)
 #define PORT0_CHIP_SELECT                       (0)
 #define PORT1_SPI_DEVICE                        (1)
 #define PORT1_CHIP_SELECT                       (0)
 #define PORT_COUNT                               2u      /* Number of SPI ports in the system */
+#define PACK_COUNT                               1u      /* Number of adi_wil_pack_t instances in the system */
+
+/*
+ * Largest ACL the buffer arena is dimensioned for. The WIL sensor and network
+ * data buffers and the per node application buffers are carved from it for
+ * the nodes actually in the ACL.
+ **/
+#define ADI_WIL_EX_ARENA_NODES                   24u
+
+/*
+ * 1: OSAL resources are real try-locks (IfxCpu mutex), required when the
+ * process tasks of different packs run on different cores. 0: single core,
+ * resources are plain flags.
+ **/
+#define ADI_WIL_EX_OSAL_MULTICORE                0
+
+/*
+ * Event bus: 1 moves the BMS packet decode (cell voltages, OWD) out of the WIL
+ * event callback into the core 0 event queue, drained from the 1ms scheduler
+ * table. The packet copy stays in the callback.
+ **/
+#define ADI_WIL_EX_BMS_DECODE_DEFERRED           0
+
+/*
+ * 1: time the device directory against the linear device ID and MAC searches
+ * on a synthetic 62 node ACL at initialization and print the results.
+ **/
+#define ADI_WIL_EX_DEVICE_DIR_BENCHMARK          0
+
+/*
+ * 1: time the table driven PEC10/PEC15 against the bitwise PEC10 at
+ * initialization and print the results.
+ **/
+#define ADI_WIL_EX_PEC_BENCHMARK                 0
 
 #ifdef DBG_GET_FILE_TEST
 /* Get file buffer configuration */
@@ -0,0 +1,59 @@
+/*******************************************************************************
+ * @file adi_wil_example_device_dir.h
+ *
+ * Copyright (c) 2020-2022 Analog Devices, Inc. All Rights Reserved. This
+ * software is proprietary and confidential to Analog Devices, Inc. and its
+ * licensors.
+ *******************************************************************************/
+
+#ifndef ADI_WIL_EXAMPLE_DEVICE_DIR_H
+#define ADI_WIL_EXAMPLE_DEVICE_DIR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "adi_wil_types.h"
+#include "adi_wil_acl.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define ADI_DEVICE_DIR_NODE_COUNT               ADI_WIL_MAX_NODES
+#define ADI_DEVICE_DIR_HASH_SIZE                128u    /* MAC hash buckets, power of two, at least twice the node count */
+
+/* Node index values of the non node device IDs, as returned by ADK_ConvertDeviceId */
+#define ADI_DEVICE_DIR_INVALID                  200u
+#define ADI_DEVICE_DIR_MANAGER_0                240u
+#define ADI_DEVICE_DIR_MANAGER_1                241u
+#define ADI_DEVICE_DIR_ALL_MANAGERS             254u
+#define ADI_DEVICE_DIR_ALL_NODES                255u
+
+/*******************************************************************************
+ * Structures
+ *******************************************************************************/
+typedef struct
+{
+    uint8_t     MacHash[ADI_DEVICE_DIR_HASH_SIZE];          /* ACL index + 1 per bucket, 0 : empty */
+    uint8_t     Mac[ADI_DEVICE_DIR_NODE_COUNT][ADI_WIL_MAC_ADDR_SIZE];
+    uint8_t     iCount;                                     /* Nodes in the ACL the directory was built from */
+}adi_device_dir_t;
+
+/*******************************************************************************
+ * Functions
+ *******************************************************************************/
+/* Rebuilds the directory, call whenever a new ACL is read from the managers */
+extern void adi_wil_example_DeviceDirUpdate(adi_wil_acl_t const *pAcl);
+
+/* Node index of the lowest device in eDevice, or one of the ADI_DEVICE_DIR_
+ * values for the manager, broadcast and empty device IDs */
+extern uint8_t adi_wil_example_DeviceDirNodeIndex(adi_wil_device_t eDevice);
+
+/* Looks up the ACL index (= node index) of a node MAC. Returns false, leaving
+ * *pNodeIndex unchanged, when the MAC is not in the ACL */
+extern bool adi_wil_example_DeviceDirFindMac(uint8_t const *pMac, uint8_t *pNodeIndex);
+
+/* Times the directory against the linear lookups it replaced on a synthetic
+ * 62 node ACL and prints the results */
+extern void adi_wil_example_DeviceDirBenchmark(void);
+
+#endif /* ADI_WIL_EXAMPLE_DEVICE_DIR_H */
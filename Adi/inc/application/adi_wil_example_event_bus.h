@@ -0,0 +1,83 @@
+/*******************************************************************************
+ * @file adi_wil_example_event_bus.h
+ *
+ * Copyright (c) 2020-2022 Analog Devices, Inc. All Rights Reserved. This
+ * software is proprietary and confidential to Analog Devices, Inc. and its
+ * licensors.
+ *******************************************************************************/
+
+#ifndef ADI_WIL_EXAMPLE_EVENT_BUS_H
+#define ADI_WIL_EXAMPLE_EVENT_BUS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "adi_wil_types.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define ADI_EVENT_BUS_MAX_HANDLERS              32u     /* Registered handlers over all events */
+#define ADI_EVENT_BUS_EVENT_COUNT               ((uint8_t)ADI_WIL_EVENT_CELL_BALANCING_STATUS + 1u)
+#define ADI_EVENT_BUS_CORE_COUNT                4u      /* TC38x has CPU0..CPU3, one deferred queue each */
+#define ADI_EVENT_BUS_QUEUE_DEPTH               16u     /* Deferred events per core, must be a power of two */
+#define ADI_EVENT_BUS_INVALID_HANDLE            0xFFu
+
+/*******************************************************************************
+ * Structures
+ *******************************************************************************/
+/* pData is the WIL event data for inline handlers and a copy of it for deferred
+ * ones. For the sensor and network data buffer events only the buffer descriptor
+ * is copied, the packets it points to are rewritten by the WIL every interval:
+ * a deferred handler of these events reads packets only from a copy an inline
+ * handler of higher priority made. */
+typedef void (*adi_event_handler_t)(adi_wil_pack_t const *pPack, adi_wil_event_id_t eEvent, void const *pData);
+
+typedef enum
+{
+    ADI_EVENT_EXEC_INLINE,              /* In the WIL event callback */
+    ADI_EVENT_EXEC_DEFERRED,            /* From adi_wil_example_EventBusDrain() on the handler's core */
+}adi_event_exec_t;
+
+typedef struct
+{
+    uint32_t    iCalls;
+    uint32_t    iDropped;               /* Deferred events lost to a full queue */
+    uint32_t    iLastTicks;             /* STM ticks of the last run */
+    uint32_t    iMaxTicks;              /* Longest run observed, STM ticks */
+    uint32_t    iMaxLatencyTicks;       /* Longest event to handler start delay, STM ticks */
+    uint64_t    iTotalTicks;
+}adi_event_handler_stats_t;
+
+/*******************************************************************************
+ * Functions
+ *******************************************************************************/
+/* Removes all handlers and empties the deferred queues */
+extern void adi_wil_example_EventBusReset(void);
+
+/* Registers pfHandler for eEvent. Handlers of one event run in ascending
+ * iPriority, equal priorities in registration order. iCore selects the queue of
+ * a deferred handler and is ignored for inline ones. Returns the handle used
+ * for the statistics, ADI_EVENT_BUS_INVALID_HANDLE when the table is full or
+ * an argument is out of range */
+extern uint8_t adi_wil_example_EventBusRegister(adi_wil_event_id_t eEvent,
+                                                adi_event_handler_t pfHandler,
+                                                const char *pName,
+                                                uint8_t iPriority,
+                                                adi_event_exec_t eExec,
+                                                uint8_t iCore);
+
+/* Called from adi_wil_HandleEvent: runs the inline handlers of the event and
+ * queues the deferred ones */
+extern void adi_wil_example_EventBusDispatch(adi_wil_pack_t const *pPack, adi_wil_event_id_t eEvent, void const *pData);
+
+/* Runs the deferred handlers queued for the calling core */
+extern void adi_wil_example_EventBusDrain(void);
+
+/* Read access, NULL for an unused handle */
+extern adi_event_handler_stats_t const *adi_wil_example_EventBusGetStats(uint8_t iHandle);
+
+/* Prints calls, drops, WCET, average and worst latency of every handler */
+extern void adi_wil_example_EventBusDumpStats(bool bReset);
+
+#endif /* ADI_WIL_EXAMPLE_EVENT_BUS_H */
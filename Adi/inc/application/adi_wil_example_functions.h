@@ -14,6 +14,8 @@
 
 #include "adi_wil_types.h"
 #include "adi_wil_example_debug_functions.h"
+#include "adi_wil_example_arena.h"
+#include "adi_wil_example_hr_store.h"
 #include "adi_wil_hal.h"
 #include "adi_wil_version.h"
 #include "adi_wil.h"
@@ -39,7 +41,6 @@
 #define ADK_MAX_mngr            2
 #define PDR_depth               100
 #define PDR_AVG_depth           200
-#define PDR_pktbuf_depth        (pkt_valid_index_threshold+(ADK_MAX_node*BMS_PACKETS_PER_INTERVAL))
 #define NO_SET_MODE             true
 #define SET_MODE                false
 #define ADK_SINGLE              true
@@ -49,7 +50,6 @@
 #define MAX_NODE_TO_NODE_RSSI   24
 #define MAX_MNG_TO_NODE_RSSI    2
 #define MAX_DEV_FOR_RSSI        MAX_NODE_TO_NODE_RSSI + MAX_MNG_TO_NODE_RSSI
-#define pkt_valid_index_threshold               4
 #define NETWORK_STATUS_THRESHOLD                60000
 
 /* the waitForEvent() function issues a prompt if it is still waiting after this amount of time. */
@@ -869,6 +869,28 @@ void adi_wil_example_PrintACL(adi_wil_pack_t * const pPack);
  */
 adi_wil_err_t adi_wil_example_GetDeviceVersion(adi_wil_pack_t * const pPack, adi_wil_device_t eDevice, bool no_set_mode);
 
+/**
+ * @brief    Get the device version of several nodes concurrently
+ *
+ * @details  Issues adi_wil_GetDeviceVersion for nodes 0 to iNodeCount - 1 with
+ *           as many requests in flight as the WIL accepts, waits for all of
+ *           them and prints the elapsed time.
+ *
+ * @param    pPack[in,out]                          pointer to pack instance
+ *
+ * @param    uint8_t[in]                            number of nodes to query
+ *
+ * @return adi_wil_err_t                            last failure, ADI_WIL_ERR_SUCCESS if all nodes answered
+ */
+adi_wil_err_t adi_wil_example_GetNodeVersions(adi_wil_pack_t * const pPack, uint8_t iNodeCount);
+
+/**
+ * @brief    Load a node version collected by adi_wil_example_GetNodeVersions into ClientData.DeviceVersion
+ *
+ * @return bool                                     false if the node did not answer
+ */
+bool adi_wil_example_SelectNodeVersion(uint8_t iNode);
+
 /**
  * @brief    Get container details from manager/node wrapper function
  *
@@ -906,6 +928,24 @@ adi_wil_err_t adi_wil_example_GetFileCRC(adi_wil_pack_t * const pPack,
 adi_wil_err_t adi_wil_example_ExecuteGetFile(adi_wil_pack_t * const pPack, 
                                              adi_wil_file_type_t eFileType,
                                              adi_wil_device_t eDevice);
+
+/**
+ * @brief   WIL retrieves specified file from a manager or a node device in one streamed transfer.
+ *
+ * @details Wrapper function will call WIL Get File Stream API for a specified device and wait
+ *          for the last block. Blocks are placed in userGetFileContainer by the API callback.
+ *
+ * @param   pPack[in,out]                          pointer to pack instance
+ *
+ * @param   adi_wil_file_type_t[in]                file type to retrieve the file from.
+ *
+ * @param   adi_wil_device_t[in]                   target device to get file from
+ *
+ * @return  adi_wil_err_t                          error code of the get file stream API from a specified device.
+ */
+adi_wil_err_t adi_wil_example_ExecuteGetFileStream(adi_wil_pack_t * const pPack,
+                                                   adi_wil_file_type_t eFileType,
+                                                   adi_wil_device_t eDevice);
 #endif
 
 /**
@@ -949,6 +989,22 @@ extern void adi_wil_HandleEvent (adi_wil_pack_t const * const pPack,
                                  adi_wil_event_id_t EventCode,
                                  void const * const pData);
 
+/* Registers the example event handlers with the event bus (adi_wil_example_event_bus.h),
+ * ADI_WIL_ERR_FAIL when the handler table is full */
+extern adi_wil_err_t adi_wil_example_RegisterEventHandlers(void);
+
+/* Carves the per node BMS, network data and health report buffers and the health report store from the arena (adi_wil_example_arena.h) */
+extern adi_wil_err_t adi_wil_example_AllocateNodeBuffers(void);
+
+/* Per node per subsystem bytes, for dimensioning the arena block */
+#define ADI_WIL_EX_NODE_BUFFER_BYTES_PER_NODE   (ADI_ARENA_REGION_SIZE(ADI_BMS_PACKETS_PER_NODE_PER_INTERVAL * sizeof(adi_wil_sensor_data_t), 0u, 1u) + \
+                                                 ADI_ARENA_REGION_SIZE(ADI_BMS_PACKETS_PER_NODE_PER_INTERVAL * sizeof(adi_wil_network_data_t), 0u, 1u) + \
+                                                 ADI_ARENA_REGION_SIZE(sizeof(adi_wil_health_report0_t), 0u, 1u) + \
+                                                 ADI_ARENA_REGION_SIZE(sizeof(adi_wil_health_report1_t), 0u, 1u) + \
+                                                 ADI_ARENA_REGION_SIZE(sizeof(adi_wil_health_report2_t), 0u, 1u) + \
+                                                 ADI_ARENA_REGION_SIZE(sizeof(adi_wil_health_report80_t), 0u, 1u) + \
+                                                 ADI_ARENA_REGION_SIZE(sizeof(adi_hr_node_store_t), 0u, 1u))
+
 
 void adi_wil_mac_deviceID_return(adi_wil_pack_t *pPack, bool bMacReturn, uint8_t *pMacPtr, uint8_t *pDeviceID);
 
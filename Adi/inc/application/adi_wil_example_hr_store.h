@@ -0,0 +1,127 @@
+/*******************************************************************************
+ * @file adi_wil_example_hr_store.h
+ *
+ * Copyright (c) 2020-2022 Analog Devices, Inc. All Rights Reserved. This
+ * software is proprietary and confidential to Analog Devices, Inc. and its
+ * licensors.
+ *******************************************************************************/
+
+#ifndef ADI_WIL_EXAMPLE_HR_STORE_H
+#define ADI_WIL_EXAMPLE_HR_STORE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "adi_wil_types.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define ADI_HR_STORE_DEPTH                      16u     /* Node device reports kept per node */
+#define ADI_HR_STORE_WARMUP                     8u      /* Reports before the detectors may raise alerts */
+
+/*******************************************************************************
+ * Structures
+ *******************************************************************************/
+/* Node device health report (0x00) fields kept in the store */
+typedef enum
+{
+    ADI_HR_FIELD_PKTS_GENERATED,
+    ADI_HR_FIELD_PKTS_NACKED,
+    ADI_HR_FIELD_NET_MIC_FAILURES,
+    ADI_HR_FIELD_MAC_MIC_FAILURES,
+    ADI_HR_FIELD_JOIN_ATTEMPTS,
+    ADI_HR_FIELD_PARENTS,
+    ADI_HR_FIELD_QUEUE_FAILURES,
+    ADI_HR_FIELD_ADC_TEMP,
+    ADI_HR_FIELD_COUNT
+}adi_hr_field_t;
+
+/* Per report quantities the trend detectors follow, derived from two
+ * consecutive reports of a node */
+typedef enum
+{
+    ADI_HR_METRIC_NACK_RATE,            /* Nacked packets per 1000 generated */
+    ADI_HR_METRIC_MIC_FAILURES,         /* Network and MAC MIC failures */
+    ADI_HR_METRIC_JOIN_ATTEMPTS,
+    ADI_HR_METRIC_QUEUE_FAILURES,
+    ADI_HR_METRIC_TEMPERATURE,          /* ADC temperature, degC */
+    ADI_HR_METRIC_COUNT
+}adi_hr_metric_t;
+
+typedef enum
+{
+    ADI_HR_ALERT_SLOPE,                 /* The metric keeps rising faster than its limit */
+    ADI_HR_ALERT_DEVIATION,             /* The metric jumped above its average */
+}adi_hr_alert_t;
+
+/* A report as returned by the query API */
+typedef struct
+{
+    uint64_t    iPacketGenerationTime;  /* ASN */
+    int32_t     Values[ADI_HR_FIELD_COUNT];
+    uint8_t     iApproxMask;            /* Fields off by a clamped delta between this report and the newest */
+}adi_hr_sample_t;
+
+/* A stored report: the change against the report before it */
+typedef struct
+{
+    uint32_t    iTimeDelta;             /* ASN since the previous report, saturated */
+    int16_t     iPktsGenerated;         /* Wide deltas, exact modulo 2^16 */
+    int16_t     iPktsNacked;
+    int8_t      Deltas[ADI_HR_FIELD_COUNT - 2u];    /* Narrow deltas of the remaining fields, clamped */
+    uint8_t     iClampMask;             /* Narrow deltas that did not fit, bit per field */
+}adi_hr_record_t;
+
+/* Incremental detector state of one metric */
+typedef struct
+{
+    float       fMean;                  /* EWMA of the metric */
+    float       fDeviation;             /* EWMA of the absolute deviation from fMean */
+    float       fSlope;                 /* EWMA of the change per report */
+    float       fLast;                  /* Metric of the newest report */
+    uint16_t    iSamples;
+    uint8_t     iActiveAlerts;          /* Bit per adi_hr_alert_t, raised until the condition clears */
+    uint8_t     iAlertCount;
+}adi_hr_trend_t;
+
+/* Everything kept for one node, carved per node from the arena */
+typedef struct
+{
+    adi_hr_record_t Records[ADI_HR_STORE_DEPTH];
+    adi_hr_sample_t Newest;             /* Exact values of the newest report, the records are walked back from it */
+    adi_hr_trend_t  Trends[ADI_HR_METRIC_COUNT];
+    uint8_t         iHead;              /* Next record written */
+    uint8_t         iCount;
+}adi_hr_node_store_t;
+
+/* Called from adi_wil_example_HrStoreAdd() when a detector raises an alert */
+typedef void (*adi_hr_alert_handler_t)(uint8_t iNodeIndex, adi_hr_metric_t eMetric, adi_hr_alert_t eAlert, adi_hr_trend_t const *pTrend);
+
+/*******************************************************************************
+ * Functions
+ *******************************************************************************/
+/* Hands the store iNodeCount zeroed node entries and the alert handler */
+extern void adi_wil_example_HrStoreInit(adi_hr_node_store_t *pNodes, uint8_t iNodeCount, adi_hr_alert_handler_t pfAlert);
+
+/* Stores a node device health report (PACKET_ID_NODE_DEVICE) of node
+ * iNodeIndex and runs the detectors. Other reports are ignored */
+extern void adi_wil_example_HrStoreAdd(uint8_t iNodeIndex, adi_wil_health_report_t const *pReport);
+
+/* Reports held for the node */
+extern uint8_t adi_wil_example_HrStoreGetCount(uint8_t iNodeIndex);
+
+/* Rebuilds the report iAge reports before the newest one (0 is the newest).
+ * Returns false when the node has fewer reports */
+extern bool adi_wil_example_HrStoreGetSample(uint8_t iNodeIndex, uint8_t iAge, adi_hr_sample_t *pSample);
+
+/* Read access to a detector, NULL for an unknown node */
+extern adi_hr_trend_t const *adi_wil_example_HrStoreGetTrend(uint8_t iNodeIndex, adi_hr_metric_t eMetric);
+
+/* Printable name of a metric */
+extern const char *adi_wil_example_HrStoreMetricName(adi_hr_metric_t eMetric);
+
+/* Prints the detector state of every metric of the node */
+extern void adi_wil_example_HrStoreDumpNode(uint8_t iNodeIndex);
+
+#endif /* ADI_WIL_EXAMPLE_HR_STORE_H */
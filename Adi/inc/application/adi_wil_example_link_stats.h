@@ -0,0 +1,91 @@
+/*******************************************************************************
+ * @file adi_wil_example_link_stats.h
+ *
+ * Copyright (c) 2020-2022 Analog Devices, Inc. All Rights Reserved. This
+ * software is proprietary and confidential to Analog Devices, Inc. and its
+ * licensors.
+ *******************************************************************************/
+
+#ifndef ADI_WIL_EXAMPLE_LINK_STATS_H
+#define ADI_WIL_EXAMPLE_LINK_STATS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "adi_wil_types.h"
+#include "adi_wil_network_data.h"
+#include "adi_wil_example_config.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define ADI_LINK_STATS_NODE_COUNT               ADI_WIL_MAX_NODES
+#define ADI_LINK_STATS_MANAGER_COUNT            2u
+#define ADI_LINK_STATS_CHANNEL_COUNT            16u     /* Channel offsets 0-15, others only count in the node totals */
+#define ADI_LINK_STATS_LATENCY_BUCKETS          8u      /* See adi_link_stats_LatencyEdges */
+
+#define ADI_LINK_STATS_SEQ_BITS                 16u     /* Sequence numbers are compared modulo 2^SEQ_BITS */
+#define ADI_LINK_STATS_SEQ_WINDOW               32u     /* Late / duplicate packets are recognised this far back */
+#define ADI_LINK_STATS_SEQ_RESYNC               1024u   /* A forward jump larger than this restarts the sequence (node reset) */
+#define ADI_LINK_STATS_EWMA_SHIFT               3u      /* RSSI EWMA weight 1/8 */
+
+#define ADI_LINK_STATS_RSSI_NONE                ((int8_t)-128)
+
+/*******************************************************************************
+ * Structures
+ *******************************************************************************/
+typedef struct
+{
+    uint32_t    iPackets;
+    int16_t     iRssiEwma;          /* dBm, Q8 */
+    int8_t      iRssiLast;
+    int8_t      iRssiMin;
+    int8_t      iRssiMax;
+    uint8_t     iReserved[3];
+}adi_link_stats_rssi_t;
+
+typedef struct
+{
+    /* Packet delivery, counted once per sequence number over both managers */
+    uint32_t    iExpected;          /* Sequence numbers covered so far */
+    uint32_t    iReceived;          /* Distinct sequence numbers received */
+    uint32_t    iDuplicates;
+    uint32_t    iStale;             /* Older than the window, not counted */
+    uint32_t    iResyncs;
+    uint32_t    iSeqWindow;         /* Bit n : iSeqHighest - n received */
+    uint16_t    iSeqHighest;
+    bool        bSeqValid;
+
+    /* Per path figures, index 0 : manager 0, 1 : manager 1 */
+    adi_link_stats_rssi_t Path[ADI_LINK_STATS_MANAGER_COUNT];
+    uint32_t    LatencyHist[ADI_LINK_STATS_MANAGER_COUNT][ADI_LINK_STATS_LATENCY_BUCKETS];
+    uint32_t    iLatencySum[ADI_LINK_STATS_MANAGER_COUNT];
+    uint16_t    iLatencyMax[ADI_LINK_STATS_MANAGER_COUNT];
+}adi_link_stats_node_t;
+
+/*******************************************************************************
+ * Functions
+ *******************************************************************************/
+/* Clears all statistics */
+extern void adi_wil_example_LinkStatsReset(void);
+
+/* Clears one node, e.g. on disconnect */
+extern void adi_wil_example_LinkStatsResetNode(uint8_t iNodeId);
+
+/* Folds one network data record into the statistics, O(1) */
+extern void adi_wil_example_LinkStatsUpdate(adi_wil_network_data_t const *pRecord);
+
+/* Folds a network data buffer as delivered with ADI_WIL_EVENT_DATA_READY_NETWORK_DATA */
+extern void adi_wil_example_LinkStatsUpdateBuffer(adi_wil_network_data_t const *pData, uint16_t iCount);
+
+/* Read access, NULL / false for an out of range index */
+extern adi_link_stats_node_t const *adi_wil_example_LinkStatsGetNode(uint8_t iNodeId);
+extern bool adi_wil_example_LinkStatsGetChannel(uint8_t iNodeId, uint8_t iChannel, adi_link_stats_rssi_t *pStats);
+
+/* Packet delivery ratio in 0.01 % (10000 = 100 %) since the last reset */
+extern uint16_t adi_wil_example_LinkStatsGetPdr(uint8_t iNodeId);
+
+/* Upper latency of each histogram bucket, the last bucket is open ended */
+extern uint16_t adi_wil_example_LinkStatsLatencyEdge(uint8_t iBucket);
+
+#endif /* ADI_WIL_EXAMPLE_LINK_STATS_H */
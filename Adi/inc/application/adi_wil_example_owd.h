@@ -74,12 +74,46 @@
 #else   /* Not supported */
 #endif
 
+/* Cells per node evaluated by the batch open wire check, the same for both devices */
+#define ADI_OWD_CELLS_PER_NODE                              (16U)
+
+/******************************************************************************
+ * Enumerations
+ *****************************************************************************/
+/* Device selecting the batch open wire thresholds */
+typedef enum
+{
+    ADI_OWD_ADBMS6830,
+    ADI_OWD_ADBMS6833,
+    ADI_OWD_DEVICE_COUNT
+} adi_owd_device_t;
+
+#if     (ADK_ADBMS683x == 0) /* ADBMS6830 */
+#define ADI_OWD_DEVICE                                      ADI_OWD_ADBMS6830
+#elif   (ADK_ADBMS683x == 3) /* ADBMS6833 */
+#define ADI_OWD_DEVICE                                      ADI_OWD_ADBMS6833
+#else   /* Not supported */
+#endif
+
 
 /******************************************************************************
  * Function Declarations
  *****************************************************************************/
 extern void adi_wil_example_ExecuteOWD(void);
 
+/* Open wire check of iNodeCount consecutive nodes in one pass. pNominal and
+ * pOpenWire hold ADI_OWD_CELLS_PER_NODE raw C and S channel codes per node,
+ * node after node. Per node, pFaultMask gets the cells whose drop exceeds
+ * the device threshold and pZeroMask the cells whose nominal reading is
+ * below the zero voltage limit, bit per cell. A cell in pZeroMask is never
+ * in pFaultMask */
+extern void adi_wil_example_OwdBatch(adi_owd_device_t eDevice,
+                                     int16_t const *pNominal,
+                                     int16_t const *pOpenWire,
+                                     uint8_t iNodeCount,
+                                     uint16_t *pFaultMask,
+                                     uint16_t *pZeroMask);
+
 
 #endif /* ADI_WIL_EXAMPLE_OWD_H_ */
 
@@ -0,0 +1,44 @@
+/*******************************************************************************
+ * @file adi_wil_example_pec.h
+ *
+ * Copyright (c) 2020-2022 Analog Devices, Inc. All Rights Reserved. This
+ * software is proprietary and confidential to Analog Devices, Inc. and its
+ * licensors.
+ *******************************************************************************/
+
+#ifndef ADI_WIL_EXAMPLE_PEC_H
+#define ADI_WIL_EXAMPLE_PEC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define ADI_PEC_GROUP_DATA_SIZE                 6u      /* Data bytes of an ADBMS683x register group */
+#define ADI_PEC_GROUP_SIZE                      8u      /* Register group followed by its two PEC bytes */
+
+/*******************************************************************************
+ * Functions
+ *******************************************************************************/
+/* PEC15 of len bytes, as sent with ADBMS683x commands and write data. The
+ * result is shifted left by one, ready to be sent */
+extern uint16_t adi_pec15_Calc(uint8_t len, uint8_t *data);
+
+/* PEC10 of iLen data bytes. With bRxCmd the 6 bit command counter held in
+ * bits 7..2 of pData[iLen] is included, as for data read from the device */
+extern uint16_t adi_pec10_Calc(uint8_t const *pData, uint8_t iLen, bool bRxCmd);
+
+/* Checks the PEC10 of a register group read from the device: 6 data bytes,
+ * then the command counter and PEC bits 9..8, then PEC bits 7..0 */
+extern bool adi_pec10_CheckGroup(uint8_t const *pGroup);
+
+/* Checks iCount consecutive register groups, returns the failing ones, bit
+ * per group. iCount is limited to 16 */
+extern uint16_t adi_pec10_CheckGroups(uint8_t const *pGroups, uint8_t iCount);
+
+/* Times the table driven PEC10 and PEC15 against the bitwise PEC10 and
+ * prints the results */
+extern void adi_wil_example_PecBenchmark(void);
+
+#endif /* ADI_WIL_EXAMPLE_PEC_H */
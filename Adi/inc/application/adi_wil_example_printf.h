@@ -22,6 +22,7 @@ int adi_wil_ex_printf(const char * format, ...) __format__(printf,1,2);
 int adi_wil_ex_info(const char * format, ...) __format__(printf,1,2);
 int adi_wil_ex_error(const char * format, ...) __format__(printf,1,2);
 int adi_wil_ex_fatal(const char * format, ...) __format__(printf,1,2);
+void adi_wil_ex_LogDrain(void);
 
 bool adi_debug_hal_Getch(char * const gotten);
 bool adi_debug_hal_IsGetch(char * const gotten);
@@ -14,6 +14,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "adi_wil_example_config.h"
 
 /*******************************************************************************/
 /* #defines                                                                    */
@@ -21,11 +22,20 @@
 /**
  * @remark : Scheduler select
  */
-#define SCHDLR_1MS_TABLE_SIZE           0U
+#if (ADI_W2CAN_ENABLE == 1)
+#define SCHDLR_1MS_TABLE_SIZE           3U
+#else
+#define SCHDLR_1MS_TABLE_SIZE           2U
+#endif
 #define SCHDLR_2MS_TABLE_SIZE           0U
 #define SCHDLR_5MS_TABLE_SIZE           0U
+#if (ADI_W2CAN_ENABLE == 1)
+#define SCHDLR_10MS_TABLE_SIZE          2U
+#define SCHDLR_25MS_TABLE_SIZE          1U
+#else
 #define SCHDLR_10MS_TABLE_SIZE          0U
 #define SCHDLR_25MS_TABLE_SIZE          0U
+#endif
 #define SCHDLR_50MS_TABLE_SIZE          0U
 #define SCHDLR_100MS_TABLE_SIZE         0U
 #define SCHDLR_1000MS_TABLE_SIZE        0U
@@ -44,13 +54,45 @@
 #define SCHDLR_MAXSLOTS                 10              /* Maximum number of time based schedules */
 #define SCHDLR_TIMER_1MS_INTERVAL       1000U           /* 1 millisecond */
 
+/**
+ * @remark : Dispatch policy
+ * Every table entry is a periodic task released at (ms % period) == TickDelay.
+ * Released tasks run earliest deadline first; the deadline is the period unless
+ * the entry gives a shorter one. A task more than one period late has the
+ * missed releases skipped (counted in iSkippedReleases) instead of running back
+ * to back. With SCHDLR_IDLE_WAIT the core executes WAIT when nothing is
+ * released, the 1ms STM tick (or any other interrupt) wakes it up again.
+ */
+#define SCHDLR_IDLE_WAIT                1U
+#define SCHDLR_STATS_DUMP_ENABLE        0U              /* Print the task statistics from the 60000ms table */
+#define SCHDLR_TASK_COUNT_MAX           32U
+
+/* Table entry helper : SCHDLR_TASK(TickDelay, Task) or SCHDLR_TASK_DL(TickDelay, Task, Deadline in ms) */
+#define SCHDLR_TASK(delay, task)                SCHDLR_TASK_DL(delay, task, 0U)
+#define SCHDLR_TASK_DL(delay, task, deadline)   { (delay), (task), #task, (deadline), 0U, { 0U, 0U, 0U, 0U, 0U, 0U, 0U } }
+
 /*******************************************************************************
  * Structures
  *******************************************************************************/
+typedef struct
+{
+    uint32_t iReleases;                 /* Times the task was run */
+    uint32_t iSkippedReleases;          /* Releases dropped because the task was more than a period late */
+    uint32_t iMissedDeadlines;          /* Runs that finished after release + deadline */
+    uint32_t iLastExecTicks;            /* STM ticks of the last run */
+    uint32_t iWcetTicks;                /* Longest run observed, STM ticks */
+    uint32_t iMaxJitterTicks;           /* Longest release to start delay, STM ticks */
+    uint64_t iTotalExecTicks;
+}SchedulerTaskStats_t;
+
 typedef struct
 {
     uint8_t TickDelay;
     void (*TaskPtr)(void);
+    const char *pName;
+    uint8_t Deadline;                   /* ms after release, 0 : the period */
+    uint32_t NextRelease;               /* ms count of the next release */
+    SchedulerTaskStats_t Stats;
 }SchedulerEntry_t;
 
 typedef struct
@@ -142,6 +184,18 @@ void adi_task_spiPortStatisticsRetrieval(void);
  ***********************************************************************************/
 bool adi_wil_example_SchedulerInit(void);
 
+/************************************************************************************
+ * adi_wil_example_SchedulerDumpStats
+ *
+ * Prints per task release count, WCET, average execution time, worst jitter,
+ * missed deadlines and skipped releases, plus the CPU load since the last dump.
+ *
+* @arguments : bReset : clear the statistics after printing
+*
+* @return none
+ ***********************************************************************************/
+void adi_wil_example_SchedulerDumpStats(bool bReset);
+
 
 /**
  * @remark : select script example state machine
@@ -0,0 +1,71 @@
+/*******************************************************************************
+ * @file adi_wil_example_script_cache.h
+ *
+ * Copyright (c) 2020-2022 Analog Devices, Inc. All Rights Reserved. This
+ * software is proprietary and confidential to Analog Devices, Inc. and its
+ * licensors.
+ *******************************************************************************/
+
+#ifndef ADI_WIL_EXAMPLE_SCRIPT_CACHE_H
+#define ADI_WIL_EXAMPLE_SCRIPT_CACHE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "adi_wil_types.h"
+#include "adi_wil_example_pec.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define ADI_SCRIPT_CACHE_REG_MASK(eReg)         (1u << (uint8_t)(eReg))
+
+/*******************************************************************************
+ * Structures
+ *******************************************************************************/
+/* Configuration registers written with ModifyScript */
+typedef enum
+{
+    ADI_SCRIPT_REG_CFGA,
+    ADI_SCRIPT_REG_CFGB,
+    ADI_SCRIPT_REG_COUNT
+}adi_script_reg_t;
+
+/* Register payloads of one node: 6 data bytes followed by the PEC10 bytes */
+typedef struct
+{
+    uint8_t     Applied[ADI_SCRIPT_REG_COUNT][ADI_PEC_GROUP_SIZE];  /* Last payload the node accepted */
+    uint8_t     Pending[ADI_SCRIPT_REG_COUNT][ADI_PEC_GROUP_SIZE];  /* Last payload built, PEC kept for a resend */
+    uint8_t     iAppliedMask;           /* Registers whose Applied payload is known, bit per adi_script_reg_t */
+    uint8_t     iPendingMask;
+}adi_script_node_cache_t;
+
+typedef struct
+{
+    uint32_t    iBuilds;                /* Registers passed to the builder */
+    uint32_t    iRequests;              /* Registers that need a ModifyScript request */
+    uint32_t    iPecComputed;           /* Requests whose PEC had to be computed */
+}adi_script_cache_stats_t;
+
+/*******************************************************************************
+ * Functions
+ *******************************************************************************/
+/* Forgets every node, the next build of each register asks for a request */
+extern void adi_wil_example_ScriptCacheReset(void);
+
+/* Forgets what node iNodeIndex applied, e.g. after the node was reset */
+extern void adi_wil_example_ScriptCacheInvalidate(uint8_t iNodeIndex);
+
+/* Takes a register payload with its 6 data bytes filled in. Returns false
+ * when the node already applied these bytes, no request is needed. Otherwise
+ * the PEC bytes of pPayload are set, reusing the PEC of an identical pending
+ * payload, and true is returned */
+extern bool adi_wil_example_ScriptCacheBuild(uint8_t iNodeIndex, adi_script_reg_t eReg, uint8_t *pPayload);
+
+/* Reports the outcome of the request for the pending payload. A failed
+ * request leaves the register unknown so the next build asks again */
+extern void adi_wil_example_ScriptCacheCommit(uint8_t iNodeIndex, adi_script_reg_t eReg, bool bApplied);
+
+extern adi_script_cache_stats_t const *adi_wil_example_ScriptCacheGetStats(void);
+
+#endif /* ADI_WIL_EXAMPLE_SCRIPT_CACHE_H */
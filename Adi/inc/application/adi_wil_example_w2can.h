@@ -12,7 +12,11 @@
 #define __W2CAN__
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "adi_wil_health_report.h"
+#include "adi_wil_sensor_data.h"
+#include "adi_wil_network_data.h"
+#include "adi_wil_example_config.h"
 /*******************************************************************************/
 /*                      Local MACRO Declarations                               */
 /*******************************************************************************/
@@ -804,6 +808,31 @@
 #define ADI_W2CAN_HR_TX_START                   0U
 #define ADI_W2CAN_HR_TX_STOP                    1U
 
+/* Message Mapping Index for PMS and EMS Signal Tables */
+#define ADI_W2CAN_G2B_PMS_AUX_MSGINDEX          0U
+#define ADI_W2CAN_G2B_PMS_I1_I2_VBAT_MSGINDEX   1U
+#define ADI_W2CAN_G2B_EMS1_CELL_MSGINDEX        0U
+#define ADI_W2CAN_G2B_EMS1_DIAG_MSGINDEX        1U
+#define ADI_W2CAN_PMS_CANMESSAGES               2U      /* AUX and I1/I2/VBAT */
+#define ADI_W2CAN_EMS_CANMESSAGES               2U      /* Cell group A and diagnostic cell group A */
+
+/* Gateway transmit path */
+#define ADI_W2CAN_NODE_COUNT                    ADI_WIL_MAX_NODES
+#define ADI_W2CAN_TXQUEUE_SIZE                  1024U   /* Software frame queue (power of two) : 62 node snapshot (682 frames) + PMS + HR */
+#define ADI_W2CAN_TXFIFO_SIZE                   32U     /* MCMCAN Tx FIFO elements, frames handed to the hardware per burst */
+#define ADI_W2CAN_SINK_SIZE                     256U    /* Frames kept by the virtual CAN sink (power of two) */
+
+/* 29-bit identifier layout used with ADI_W2CAN_EXTENDED_ID : base | group << 12 | node << 6 | message index */
+#define ADI_W2CAN_EXT_ID_BASE                   0x18F00000UL
+#define ADI_W2CAN_EXT_GROUP_BMS                 0U
+#define ADI_W2CAN_EXT_GROUP_HR                  1U
+#define ADI_W2CAN_EXT_GROUP_PACK                2U
+#define ADI_W2CAN_EXT_ID(group, node, msg)      (ADI_W2CAN_EXT_ID_BASE | ((uint32_t)(group) << 12) | ((uint32_t)(node) << 6) | (uint32_t)(msg))
+
+/* Signal source selectors for the signal maps (iSrcPacketId) */
+#define ADI_W2CAN_SRC_ANY_PACKET                0xFFU   /* PMS / EMS packets : any packet of the sensor data buffer */
+#define ADI_W2CAN_SRC_NETWORK_DATA              0xFEU   /* Network metadata record built from adi_wil_network_data_t */
+
 /* Macro definitions for PMS Buffer */
 #define ADI_PMS_HEADER_LEN                      6
 #define ADI_PMS_VI_OFFSET                       ADI_PMS_HEADER_LEN + 5
@@ -972,6 +1001,8 @@ typedef struct
     uint8_t iMsgTableIndex;
     uint8_t iStartByte;
     uint8_t iSignalLen;             /* no. of bits */
+    uint8_t iSrcPacketId;           /* BMS packet / health report ID the signal is taken from */
+    uint8_t iSrcOffset;             /* byte offset of the signal in the source packet */
 }adi_w2can_CanSignals_t;
 
 typedef struct 
@@ -980,13 +1011,56 @@ typedef struct
     uint8_t iTxBuffId;
 }adi_w2can_NodeMsgs_t;
 
+/* One queued CAN frame (8 byte payload, word aligned for the MCMCAN message RAM) */
+typedef struct
+{
+    uint32_t iCanFrameID;
+    uint8_t bExtendedId;
+    uint8_t iDlc;
+    uint8_t iReserved[2];
+    uint32_t Data[ADI_W2CAN_CANMESSAGE_SIZE / 4U];
+}adi_w2can_Frame_t;
+
+/* Gateway counters */
+typedef struct
+{
+    uint32_t iFramesQueued;         /* frames accepted into the software queue */
+    uint32_t iFramesSent;           /* frames handed to the MCMCAN Tx FIFO / virtual sink */
+    uint32_t iFramesDropped;        /* frames dropped because the software queue was full */
+    uint32_t iSnapshotsSkipped;     /* BMS snapshots skipped because the previous one was still queued */
+    uint32_t iNodesWithoutId;       /* nodes skipped because no 11-bit ID is defined for them */
+    uint32_t iHRAborted;            /* health report transmissions aborted after retries */
+    uint32_t iSinkFrames;           /* frames captured by the virtual sink */
+    uint16_t iQueuePeak;            /* software queue high-water mark */
+    uint16_t iTxBurstPeak;          /* largest burst written into the Tx FIFO */
+}adi_w2can_Stats_t;
+
+/*******************************************************************************/
+/* Global Variable Declarations                                                */
+/*******************************************************************************/
+extern uint32_t adi_gW2canNodeCount;
+extern adi_w2can_Stats_t adi_gW2canStats;
+extern adi_w2can_Frame_t adi_gW2canSink[ADI_W2CAN_SINK_SIZE];
+extern volatile uint32_t adi_gW2canSinkHead;
 
-#if 0
+
+/************************************************************************************
+ * adi_wil_example_w2canInit
+ *
+ * Initializes the MCMCAN node (Tx FIFO mode) used by the gateway and clears
+ * the CAN message images.
+ *
+ * @arguments : None
+ *
+ * @return true on success, false if the CAN node could not be initialized
+ ***********************************************************************************/
+bool adi_wil_example_w2canInit(void);
 
 /************************************************************************************
  * adi_wil_example_w2canBmsMsgHandler
  *
- * Cyclic task to pass the BMS CAN Messages to the CAN Driver.
+ * 1ms task : hands queued frames to the MCMCAN Tx FIFO in bursts and, every
+ * ADI_W2CAN_BMS_MSGPERIODICITY, queues the CAN Messages of all nodes at once.
  *
  * @arguments : None
  *
@@ -1021,64 +1095,19 @@ void adi_wil_example_w2canEmsMsgHandler(void);
  *
  * API to set the value a particular signal.
  *
- * @arguments : Node ID : Node Index (range : 0 to Maximum Nodes) 
+ * @arguments : Node ID : Node Index (range : 0 to Maximum Nodes), ignored for PMS / EMS signals
  *              Signal ID : Signal Index (enumerated List of the Signals)
- *              SrcBuff : pointer to Source Buffer
+ *              SrcBuff : pointer to the source packet, the signal map gives the offset
  *
  * @return none
  ***********************************************************************************/
-void adi_wil_example_w2canSetSignal(uint8_t NodeId, uint16_t SignalID, uint8_t *SrcBuff);
-
-/************************************************************************************
-  * adi_wil_example_w2canSetPM1AuxSignal
-  *
-  * API to set the value a particular signal of CAN Message PMS
-  *
-  * @arguments : Signal ID : Signal Index (enumerated List of the Signals)
-  *              SrcBuff : pointer to Source Buffer
-  * @return none
-***********************************************************************************/
-void adi_wil_example_w2canSetPM1AuxSignal(uint16_t iSignal, uint8_t *pSrcBuff);
-
-/************************************************************************************
-  * adi_wil_example_w2canSetPM1Signal
-  *
-  * API to set the value a particular signal of CAN Message PMS
-  *
-  * @arguments : Signal ID : Signal Index (enumerated List of the Signals)
-  *              SrcBuff : pointer to Source Buffer
-  * @return none
-***********************************************************************************/
-void adi_wil_example_w2canSetPM1Signal(uint16_t iSignal, uint8_t *pSrcBuff);
+void adi_wil_example_w2canSetSignal(uint8_t NodeId, uint16_t SignalID, uint8_t const *SrcBuff);
 
-/************************************************************************************
-  * adi_wil_example_w2canSetEMS1Signal
-  *
-  * API to set the value a particular signal of CAN Message EMS
-  *
-  * @arguments : Signal ID : Signal Index (enumerated List of the Signals)
-  *              SrcBuff : pointer to Source Buffer
-  * @return none
-***********************************************************************************/
-void adi_wil_example_w2canSetEMS1Signal(uint16_t iSignal, uint8_t *pSrcBuff);
-
-/************************************************************************************
-  * adi_wil_example_w2canSetEMS1DiagSignal
-  *
-  * API to set the value a particular signal of CAN Message EMS DIAG
-  *
-  * @arguments : Signal ID : Signal Index (enumerated List of the Signals)
-  *              SrcBuff : pointer to Source Buffer
-  * @return none
-***********************************************************************************/
-void adi_wil_example_w2canSetEMS1DiagSignal(uint16_t iSignal, uint8_t *pSrcBuff);
-    
 /************************************************************************************
  * adi_wil_example_w2canHealthReportHandler
  *
  * Cyclic task to parse the Health Report and
- * to Send Health report CAN Messages to the CAN Driver 
- * (dedicated CAN Tx Buffer No. 31)
+ * to queue the Health report CAN Messages of one node at a time
  *
  * @arguments : None
  *
@@ -1091,11 +1120,12 @@ void adi_wil_example_w2canHealthReportHandler(void);
  *
  * API to notify that 1 health report has been received by WIL
  *
- * @arguments : none
+ * @arguments : Node ID : Node Index the report was received from
+ *              Packet ID : health report packet ID (PACKET_ID_xxx)
  *
  * @return none
  ***********************************************************************************/
-void adi_w2can_NotifyHR_availability(void);
+void adi_w2can_NotifyHR_availability(uint8_t iNodeId, uint8_t iPacketId);
 
 /************************************************************************************
   * adi_wil_example_w2canSetHRSignal
@@ -1104,10 +1134,35 @@ void adi_w2can_NotifyHR_availability(void);
   *
   * @arguments : Node ID : Node Index (range : 0 to Maximum Nodes) 
                  Signal ID : Signal Index (enumerated List of the Signals)
-  *              SrcBuff : pointer to Source Buffer
+  *              SrcBuff : pointer to the health report the signal is taken from
   * @return none
 ***********************************************************************************/
-void adi_wil_example_w2canSetHRSignal(uint8_t iNodeId, uint16_t iSignal, uint8_t *pSrcBuff);
-#endif
+void adi_wil_example_w2canSetHRSignal(uint8_t iNodeId, uint16_t iSignal, uint8_t const *pSrcBuff);
+
+/************************************************************************************
+ * adi_w2can_NotifyBmsData / adi_w2can_NotifyPmsData / adi_w2can_NotifyEmsData
+ *
+ * APIs to update the CAN message images from a sensor data buffer received by WIL
+ *
+ * @arguments : pData : sensor data packets
+ *              iCount : number of packets in pData
+ *
+ * @return none
+ ***********************************************************************************/
+void adi_w2can_NotifyBmsData(adi_wil_sensor_data_t const *pData, uint16_t iCount);
+void adi_w2can_NotifyPmsData(adi_wil_sensor_data_t const *pData, uint16_t iCount);
+void adi_w2can_NotifyEmsData(adi_wil_sensor_data_t const *pData, uint16_t iCount);
+
+/************************************************************************************
+ * adi_w2can_NotifyNetworkData
+ *
+ * API to update the metadata CAN message images from the network metadata buffer
+ *
+ * @arguments : pData : network metadata records
+ *              iCount : number of records in pData
+ *
+ * @return none
+ ***********************************************************************************/
+void adi_w2can_NotifyNetworkData(adi_wil_network_data_t const *pData, uint16_t iCount);
 
 #endif
@@ -0,0 +1,117 @@
+/*******************************************************************************
+ * @brief    HAL Trace
+ *
+ * @details  Implement lock-free per-core binary trace rings
+ *
+ * Copyright (c) 2021 Analog Devices, Inc. All Rights Reserved.
+ * This software is proprietary and confidential to Analog Devices, Inc. and its licensors.
+ *******************************************************************************/
+#include "adi_wil_hal_trace.h"
+
+#if defined(ADI_WIL_HAL_TRACE_ENABLE)
+
+#include "IfxCpu.h"
+#include "IfxStm.h"
+
+#define HAL_TRACE_STM          &MODULE_STM0   /* Timestamp source, shared with the HAL ticker */
+#define HAL_TRACE_INDEX_MASK   (ADI_WIL_HAL_TRACE_RECORD_COUNT - 1u)
+
+#if ((ADI_WIL_HAL_TRACE_RECORD_COUNT & HAL_TRACE_INDEX_MASK) != 0u)
+#error "ADI_WIL_HAL_TRACE_RECORD_COUNT must be a power of two"
+#endif
+
+
+/* Single object so the debugger can dump every ring plus the header in one go */
+adi_wil_hal_trace_buffer_t adi_wil_hal_TraceBuffer =
+{
+    .iMagic       = ADI_WIL_HAL_TRACE_MAGIC,
+    .iRecordSize  = (uint16_t)sizeof(adi_wil_hal_trace_record_t),
+    .iRecordCount = (uint16_t)ADI_WIL_HAL_TRACE_RECORD_COUNT,
+    .iTickHz      = 0u,
+    .iCoreCount   = ADI_WIL_HAL_TRACE_CORE_COUNT,
+};
+
+
+void adi_wil_hal_TraceInit(void)
+{
+    /* Record the STM frequency so the host decoder can convert ticks to time */
+    adi_wil_hal_TraceBuffer.iTickHz = (uint32_t)IfxStm_getFrequency(HAL_TRACE_STM);
+}
+
+
+void adi_wil_hal_TraceRecord(uint16_t iEvent, uint32_t iArg0, uint32_t iArg1)
+{
+    adi_wil_hal_trace_ring_t *pRing = &adi_wil_hal_TraceBuffer.Ring[IfxCpu_getCoreIndex()];
+    adi_wil_hal_trace_record_t *pRecord;
+    uint32_t iSlot;
+
+    /* Reserve a slot. Only an ISR on this core can race us, CMPSWAP retries if it did */
+    do
+    {
+        iSlot = pRing->iHead;
+    } while (Ifx__cmpAndSwap((unsigned int volatile *)&pRing->iHead, iSlot + 1u, iSlot) != iSlot);
+
+    /* Oldest records are overwritten once the ring has wrapped */
+    pRecord = &pRing->Record[iSlot & HAL_TRACE_INDEX_MASK];
+
+    pRecord->iTimestamp = IfxStm_getLower(HAL_TRACE_STM);
+    pRecord->iEvent     = iEvent;
+    pRecord->iArg0      = iArg0;
+    pRecord->iArg1      = iArg1;
+
+    /* Sequence last, lets the decoder drop records torn by a dump mid-write */
+    pRecord->iSequence  = (uint16_t)(iSlot & 0xFFFFu);
+}
+
+#endif
+
+#if defined(ADI_WIL_HAL_PROFILE_ENABLE)
+
+#include <string.h>
+#include "IfxStm.h"
+
+#define HAL_PROFILE_STM        &MODULE_STM0   /* Same time base as the trace records */
+
+
+adi_wil_hal_profile_entry_t adi_wil_hal_ProfileTable [ADI_WIL_HAL_PROFILE_COUNT];
+
+
+/* Called from the timed functions, keep them next to each other */
+#define ADI_WIL_HAL_START_SEC_HOT_CODE
+#include "adi_wil_hal_memmap.h"
+
+void adi_wil_hal_ProfileBegin(adi_wil_hal_profile_func_t eFunc)
+{
+    adi_wil_hal_ProfileTable[eFunc].iStart = IfxStm_getLower(HAL_PROFILE_STM);
+}
+
+
+void adi_wil_hal_ProfileEnd(adi_wil_hal_profile_func_t eFunc)
+{
+    adi_wil_hal_profile_entry_t *pEntry = &adi_wil_hal_ProfileTable[eFunc];
+    uint32_t iTicks = IfxStm_getLower(HAL_PROFILE_STM) - pEntry->iStart;
+
+    if ((pEntry->iCount == 0u) || (iTicks < pEntry->iMinTicks))
+    {
+        pEntry->iMinTicks = iTicks;
+    }
+
+    if (iTicks > pEntry->iMaxTicks)
+    {
+        pEntry->iMaxTicks = iTicks;
+    }
+
+    pEntry->iTotalTicks += iTicks;
+    pEntry->iCount++;
+}
+
+#define ADI_WIL_HAL_STOP_SEC_HOT_CODE
+#include "adi_wil_hal_memmap.h"
+
+
+void adi_wil_hal_ProfileReset(void)
+{
+    memset(adi_wil_hal_ProfileTable, 0, sizeof(adi_wil_hal_ProfileTable));
+}
+
+#endif
@@ -12,10 +12,15 @@
 #include <stdbool.h>
 #include <string.h>
 #include "adi_wil_example_debug_functions.h"
+#include "adi_wil_example_config.h"
+#if (ADI_WIL_EX_OSAL_MULTICORE == 1)
+#include "IfxCpu.h"
+#endif
 
 // Maxinum number of semaphores to be supported.
-// Equivalent to max number of packs + 1 semaphore for QueryDevice. */
-#define MAX_NUM_SEM 2u
+// 1 global semaphore (QueryDevice, InitializePack), per pack an API and a
+// process task semaphore, and 1 process task semaphore per port.
+#define MAX_NUM_SEM (1u + (2u * PACK_COUNT) + PORT_COUNT)
 
 // Define a structure to hold the WIL semaphore ID and corresponding semaphore handle.
 typedef struct {
@@ -27,6 +32,11 @@ static adi_wil_sem_t osal_sem[MAX_NUM_SEM];
 
 volatile bool bgResourceAcquired[MAX_NUM_SEM] = {false};
 
+#if (ADI_WIL_EX_OSAL_MULTICORE == 1)
+/* Try-lock per semaphore, process tasks on other cores may contend for it */
+static IfxCpu_mutexLock osal_mutex[MAX_NUM_SEM];
+#endif
+
 
 adi_wil_osal_err_t adi_wil_osal_CreateResource(void const * const pPack)
 {
@@ -60,6 +70,9 @@ adi_wil_osal_err_t adi_wil_osal_CreateResource(void const * const pPack)
         osal_sem[iFreeSlot].pPack = pPack;
         osal_sem[iFreeSlot].bResourceAcquiredEn = true;
         bgResourceAcquired[iFreeSlot] = false;
+#if (ADI_WIL_EX_OSAL_MULTICORE == 1)
+        osal_mutex[iFreeSlot] = 0u;
+#endif
 
         err = ADI_WIL_OSAL_ERR_SUCCESS;
     }
@@ -69,20 +82,29 @@ adi_wil_osal_err_t adi_wil_osal_CreateResource(void const * const pPack)
 
 adi_wil_osal_err_t adi_wil_osal_AcquireResource(void const * const pPack)
 {
-    bool bFoundId = false;
+    /* A resource that was never created, or was destroyed, is reported as such */
+    adi_wil_osal_err_t err = ADI_WIL_OSAL_ERR_NO_RESOURCE;
 
     /* Find the semaphore handle with the given Res Id */
     for(uint8_t i = 0; i < MAX_NUM_SEM; i++)
     {
         if((osal_sem[i].bResourceAcquiredEn == true) && (osal_sem[i].pPack == pPack))
         {
+#if (ADI_WIL_EX_OSAL_MULTICORE == 1)
+           /* Fail without waiting if another core holds it */
+           if(IfxCpu_acquireMutex(&osal_mutex[i]) == FALSE)
+           {
+               err = ADI_WIL_OSAL_ERR_FAIL;
+               break;
+           }
+#endif
            bgResourceAcquired[i] = true;
-           bFoundId = true;
+           err = ADI_WIL_OSAL_ERR_SUCCESS;
            break;
         }
     }
 
-    return (bFoundId == true) ? ADI_WIL_OSAL_ERR_SUCCESS : ADI_WIL_OSAL_ERR_FAIL;
+    return err;
 }
 
 
@@ -96,11 +118,14 @@ adi_wil_osal_err_t adi_wil_osal_ReleaseResource(void const * const pPack)
         if((osal_sem[i].bResourceAcquiredEn == true) && (osal_sem[i].pPack == pPack))
         {
            bgResourceAcquired[i] = false;
+#if (ADI_WIL_EX_OSAL_MULTICORE == 1)
+           IfxCpu_releaseMutex(&osal_mutex[i]);
+#endif
            bFoundId = true;
            break;
         }
     }
-    return (bFoundId == true) ? ADI_WIL_OSAL_ERR_SUCCESS : ADI_WIL_OSAL_ERR_FAIL;
+    return (bFoundId == true) ? ADI_WIL_OSAL_ERR_SUCCESS : ADI_WIL_OSAL_ERR_NO_RESOURCE;
 }
 
 
@@ -119,7 +144,7 @@ adi_wil_osal_err_t adi_wil_osal_DestroyResource(void const * const pPack)
            break;
         }
     }
-    return (bFoundId == true) ? ADI_WIL_OSAL_ERR_SUCCESS : ADI_WIL_OSAL_ERR_FAIL;
+    return (bFoundId == true) ? ADI_WIL_OSAL_ERR_SUCCESS : ADI_WIL_OSAL_ERR_NO_RESOURCE;
 }
 
 /**
@@ -52,8 +52,9 @@
 IfxStm_CompareConfig g_STMConf;                                 /* STM configuration structure                      */
 Ifx_TickTime g_ticksFor1ms;                                   /* Variable to store the number of ticks to wait    */
 unsigned int DBG_STM_count = 0;                               /* @remark  : counter for STM */
-unsigned int Schdlr_CurrentMsCount;                           /* @remark  : static removed */  
-bool Schdlr_1ms_tick;                                         /* @remark  : static removed */  
+volatile unsigned int Schdlr_CurrentMsCount;                  /* @remark  : static removed */  
+volatile bool Schdlr_1ms_tick;                                /* @remark  : static removed */  
+volatile unsigned int Schdlr_TickStm;                         /* @remark  : STM0 count at the last tick, for scheduler jitter */
 
 
 /*********************************************************************************************************************/
@@ -122,6 +123,7 @@ void initPeripherals(void)
 void Scheduler_1ms_Trigger(void)
 {
     /* Update the compare register value that will trigger the next interrupt and toggle the LED */
+    Schdlr_TickStm = IfxStm_getCompare(STM, g_STMConf.comparator);
     IfxStm_increaseCompare(STM, g_STMConf.comparator, (unsigned int)g_ticksFor1ms);
     DBG_STM_count++; /* @remark : increase count */
     Schdlr_1ms_tick = true;
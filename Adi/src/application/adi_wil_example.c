@@ -70,6 +70,7 @@
 #include "adi_wil_example_scheduler.h"
 #include "adi_wil_example_cell_balance.h"
 #include "adi_wil_example_owd.h"
+#include "adi_wil_example_link_stats.h"
 #include "adi_bms_defs.h"
 #include "adi_wil_hal_ticker.h"
 #include "adi_wil_example_cfg_profiles.h"
@@ -93,6 +94,7 @@ extern void adi_wil_hal_TaskStop(void);
 void adi_wil_example_OTA_mode(void);
 void adi_wil_example_OTA_Node(void);
 void adi_wil_example_OTA_MNG(void);
+static void adi_wil_example_AllocateBuffers(void);
 
 /******************************************************************************************/
 /* Global Structure Declarations                                                          */
@@ -120,7 +122,7 @@ extern uint8_t latent1_recv_confirm[ADK_MAX_node];
 #endif
 volatile adi_wil_err_t adi_gProcessTaskErrorCode = ADI_WIL_ERR_SUCCESS;
 adi_wil_network_status_t networkStatus;
-adi_wil_network_data_t   networkDataBuffer[ADI_WIL_MAX_NODES*ADI_BMS_PACKETS_PER_NODE_PER_INTERVAL];
+adi_wil_network_data_t   *networkDataBuffer;       /* Carved from the arena, ADI_BMS_PACKETS_PER_NODE_PER_INTERVAL per node */
 adi_wil_pack_t packInstance; /* pack instance object */
 adi_wil_acl_t realAcl;
 #ifdef DBG_ACL_MAP_TEST
@@ -155,7 +157,17 @@ extern uint8_t   userGetFileContainer[GET_FILE_BUFFER_COUNT];
 /******************************************************************************************/
 /* Local Variable Declarations                                                            */
 /******************************************************************************************/
-static adi_wil_sensor_data_t  wbmsSysSensorData[BMS_DATA_PACKET_COUNT + PMS_DATA_PACKET_COUNT + EMS_DATA_PACKET_COUNT];
+/* Arena block for the WIL data buffers and the per node application buffers,
+ * dimensioned for ADI_WIL_EX_ARENA_NODES and carved for the nodes of userAcl */
+#define ADI_WIL_EX_ARENA_BYTES  (ADI_ARENA_REGION_SIZE(ADI_BMS_PACKETS_PER_NODE_PER_INTERVAL * sizeof(adi_wil_sensor_data_t), \
+                                                       (PMS_DATA_PACKET_COUNT + EMS_DATA_PACKET_COUNT) * sizeof(adi_wil_sensor_data_t), \
+                                                       ADI_WIL_EX_ARENA_NODES) + \
+                                 ADI_ARENA_REGION_SIZE(ADI_BMS_PACKETS_PER_NODE_PER_INTERVAL * sizeof(adi_wil_network_data_t), 0u, \
+                                                       ADI_WIL_EX_ARENA_NODES) + \
+                                 (ADI_WIL_EX_NODE_BUFFER_BYTES_PER_NODE * ADI_WIL_EX_ARENA_NODES))
+static uint64_t AppArenaBlock[(ADI_WIL_EX_ARENA_BYTES + 7u) / 8u];
+static adi_wil_sensor_data_t  *wbmsSysSensorData;
+static uint16_t iSysSensorDataCount;
 static adi_wil_port_t portVar[PORT_COUNT];
 static adi_wil_configuration_t portConfig[PORT_COUNT];
 
@@ -191,6 +203,7 @@ int adi_wil_example_Main(void)
     /* STEP 1  : WBMS System Initialization **********************************************/
     adk_debug_BootTimeLog(Interval, LogStart, 100, Demo_ExecuteInitialize________________);
     adi_wil_example_ExecuteInitialize();
+    adi_wil_example_AllocateBuffers();
     ADK_DEMO.BOOT = 100;
     adk_debug_BootTimeLog(Interval, LogEnd__, 100, Demo_ExecuteInitialize________________);
 
@@ -225,7 +238,7 @@ int adi_wil_example_Main(void)
         adi_wil_err_t rc;
         rc = (adi_wil_example_ExecuteConnect(&packInstance,
                                              wbmsSysSensorData,
-                                             (BMS_DATA_PACKET_COUNT + PMS_DATA_PACKET_COUNT + EMS_DATA_PACKET_COUNT)));
+                                             iSysSensorDataCount));
         ADK_DEMO.BOOT = 120;
         adk_debug_BootTimeLog(Interval, LogEnd__, 120, Demo_ExecuteConnect_0_________________);
 
@@ -275,7 +288,7 @@ int adi_wil_example_Main(void)
     adk_debug_BootTimeLog(Interval, LogStart, 130, Demo_ExecuteConnect_1_________________);
     returnOnWilError(adi_wil_example_ExecuteConnect(&packInstance,
                                         wbmsSysSensorData,
-                                        (BMS_DATA_PACKET_COUNT + PMS_DATA_PACKET_COUNT + EMS_DATA_PACKET_COUNT)));
+                                        iSysSensorDataCount));
     ADK_DEMO.BOOT = 130;
     adk_debug_BootTimeLog(Interval, LogEnd__, 130, Demo_ExecuteConnect_1_________________);
 
@@ -501,7 +514,7 @@ int adi_wil_example_Main(void)
 
         /* STEP 27 : Connect *************************************************************/
         adk_debug_BootTimeLog(Interval, LogStart, 261, Demo_ExecuteConnect_2_________________);
-        returnOnWilError(adi_wil_example_ExecuteConnect(&packInstance, wbmsSysSensorData, (BMS_DATA_PACKET_COUNT + PMS_DATA_PACKET_COUNT + EMS_DATA_PACKET_COUNT)));
+        returnOnWilError(adi_wil_example_ExecuteConnect(&packInstance, wbmsSysSensorData, iSysSensorDataCount));
         ADK_DEMO.BOOT = 261;
         adk_debug_BootTimeLog(Interval, LogEnd__, 261, Demo_ExecuteConnect_2_________________);
 
@@ -523,6 +536,8 @@ int adi_wil_example_Main(void)
         /* GetFile for single manager / single node */
         memset(&userGetFileContainer[0], 0, GET_FILE_BUFFER_COUNT);
         adi_wil_example_ExecuteGetFile(&packInstance, ADI_WIL_FILE_TYPE_CONFIGURATION, ADI_WIL_DEV_MANAGER_0);
+        memset(&userGetFileContainer[0], 0, GET_FILE_BUFFER_COUNT);
+        adi_wil_example_ExecuteGetFileStream(&packInstance, ADI_WIL_FILE_TYPE_CONFIGURATION, ADI_WIL_DEV_MANAGER_0);
         // adi_wil_example_ExecuteGetFile(&packInstance, ADI_WIL_FILE_TYPE_CONFIGURATION, ADI_WIL_DEV_MANAGER_1);
         // adi_wil_example_ExecuteGetFile(&packInstance, ADI_WIL_FILE_TYPE_CONFIGURATION, ADI_WIL_DEV_NODE_0);
         // adi_wil_example_ExecuteGetFile(&packInstance, ADI_WIL_FILE_TYPE_CONFIGURATION, ADI_WIL_DEV_NODE_1);
@@ -597,9 +612,11 @@ int adi_wil_example_Main(void)
         adk_debug_BootTimeLog(Interval, LogEnd__, 360, Demo_GetDeviceVersion_Mngr_Now________);
 
         adk_debug_BootTimeLog(Interval, LogStart, 361, Demo_GetDeviceVersion_Node_Now________);
+        (void)adi_wil_example_GetNodeVersions(&packInstance, networkStatus.iCount);
         for(uint8_t k=0; k<networkStatus.iCount; k++) {
-            adi_wil_example_GetDeviceVersion(&packInstance, 1ULL << k, NO_SET_MODE);
-            adk_debug_log_GetDeviceVersion(OTAP_Node, OTAP_NOW, k);
+            if(adi_wil_example_SelectNodeVersion(k)) {
+                adk_debug_log_GetDeviceVersion(OTAP_Node, OTAP_NOW, k);
+            }
         }
         ADK_DEMO.BOOT = 361;
         adk_debug_BootTimeLog(Interval, LogEnd__, 361, Demo_GetDeviceVersion_Node_Now________);   
@@ -614,8 +631,10 @@ int adi_wil_example_Main(void)
 
     /* STEP 37 : Enable Network Data Capture *********************************************/
     adk_debug_BootTimeLog(Interval, LogStart, 420, Demo_EnableNetworkDataCapture_________);
-    NWBufferSize = networkStatus.iCount*ADI_BMS_PACKETS_PER_NODE_PER_INTERVAL;
-    adi_wil_EnableNetworkDataCapture(&packInstance, networkDataBuffer, (networkStatus.iCount*ADI_BMS_PACKETS_PER_NODE_PER_INTERVAL), true);
+    /* The capture buffer holds the nodes the arena was carved for */
+    NWBufferSize = ((networkStatus.iCount < adi_wil_example_ArenaNodeCount()) ? networkStatus.iCount : adi_wil_example_ArenaNodeCount()) * ADI_BMS_PACKETS_PER_NODE_PER_INTERVAL;
+    adi_wil_example_LinkStatsReset();
+    adi_wil_EnableNetworkDataCapture(&packInstance, networkDataBuffer, NWBufferSize, true);
     ADK_DEMO.BOOT = 420;
     adk_debug_BootTimeLog(Interval, LogEnd__, 420, Demo_EnableNetworkDataCapture_________);
     gTotalNodes= networkStatus.iCount;     /*  @remark : Variable to store total no. of Nodes in network */
@@ -953,6 +972,7 @@ void adi_example_key_on_event(void){
 
     adk_debug_BootTimeLog(Interval, LogStart, 703, Demo_TaskStart________________________);
     adi_wil_example_ExecuteInitialize();
+    adi_wil_example_AllocateBuffers();
     ADK_DEMO.BOOT = 702;
     adi_wil_example_PeriodicallyCallProcessTask();
     ADK_DEMO.BOOT = 703;
@@ -961,7 +981,7 @@ void adi_example_key_on_event(void){
     adk_debug_BootTimeLog(Interval, LogStart, 710, Demo_ExcuteConnect____________________);
     rc = (adi_wil_example_ExecuteConnect(&packInstance,
                                         wbmsSysSensorData,
-                                        (BMS_DATA_PACKET_COUNT + PMS_DATA_PACKET_COUNT + EMS_DATA_PACKET_COUNT)));
+                                        iSysSensorDataCount));
     ADK_DEMO.BOOT = 710;
 
     /* Set to Standby mode */
@@ -984,7 +1004,9 @@ void adi_example_key_on_event(void){
     adk_debug_BootTimeLog(Interval, LogStart, 720, Demo_TaskStartCB______________________);
     adi_wil_example_ExecuteSetMode(&packInstance, ADI_WIL_MODE_ACTIVE);
     ADK_DEMO.BOOT = 713;
-    adi_wil_EnableNetworkDataCapture(&packInstance, networkDataBuffer, (networkStatus.iCount*ADI_BMS_PACKETS_PER_NODE_PER_INTERVAL), true);
+    NWBufferSize = ((networkStatus.iCount < adi_wil_example_ArenaNodeCount()) ? networkStatus.iCount : adi_wil_example_ArenaNodeCount()) * ADI_BMS_PACKETS_PER_NODE_PER_INTERVAL;
+    adi_wil_example_LinkStatsReset();
+    adi_wil_EnableNetworkDataCapture(&packInstance, networkDataBuffer, NWBufferSize, true);
     ADK_DEMO.BOOT = 714;
     adi_wil_example_PeriodicallyCallProcessTaskCB();
     ADK_DEMO.BOOT = 720;
@@ -1010,6 +1032,34 @@ void adi_example_key_on_event(void){
     }
 }
 
+/******************************************************************************************/
+/* Carves the WIL sensor and network data buffers and the per node application buffers   */
+/* for the nodes of userAcl from AppArenaBlock. No connection may be using the previous  */
+/* buffers.                                                                               */
+/******************************************************************************************/
+static void adi_wil_example_AllocateBuffers(void)
+{
+    uint8_t iNodeCount = (userAcl.iCount != 0u) ? userAcl.iCount : (uint8_t)ADI_WIL_EX_ARENA_NODES;
+
+    adi_wil_example_ArenaInit(AppArenaBlock, sizeof(AppArenaBlock), iNodeCount);
+
+    iSysSensorDataCount = (uint16_t)((iNodeCount * ADI_BMS_PACKETS_PER_NODE_PER_INTERVAL) + PMS_DATA_PACKET_COUNT + EMS_DATA_PACKET_COUNT);
+    wbmsSysSensorData = adi_wil_example_ArenaAlloc("WIL sensor data",
+                                                   ADI_BMS_PACKETS_PER_NODE_PER_INTERVAL * sizeof(adi_wil_sensor_data_t),
+                                                   (PMS_DATA_PACKET_COUNT + EMS_DATA_PACKET_COUNT) * sizeof(adi_wil_sensor_data_t));
+    networkDataBuffer = adi_wil_example_ArenaAlloc("WIL network data",
+                                                   ADI_BMS_PACKETS_PER_NODE_PER_INTERVAL * sizeof(adi_wil_network_data_t), 0u);
+
+    if ((wbmsSysSensorData == NULL) || (networkDataBuffer == NULL) ||
+        (adi_wil_example_AllocateNodeBuffers() != ADI_WIL_ERR_SUCCESS))
+    {
+        /* userAcl holds more nodes than ADI_WIL_EX_ARENA_NODES */
+        fatalError(ADI_WIL_ERR_FAIL);
+    }
+
+    adi_wil_example_ArenaDumpFootprint();
+}
+
 void adi_example_null_function(void){
     
 }
@@ -22,7 +22,7 @@
 /*******************************************************************************/
 extern uint16_t         NWBufferSize;
 extern volatile bool    adi_gNotifyNetworkMeta;
-extern adi_wil_network_data_t   userNetworkBuffer[ADI_WIL_MAX_NODES * ADI_BMS_PACKETS_PER_NODE_PER_INTERVAL];
+extern adi_wil_network_data_t   *userNetworkBuffer;
 
 bool bUpdateExpectedGenTime = TRUE;
 
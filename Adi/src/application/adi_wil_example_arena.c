@@ -0,0 +1,107 @@
+/*******************************************************************************
+ * @file     adi_wil_example_arena.c
+ *
+ * @brief    Node count sized buffer arena
+ *
+ * @details  Carves the per node buffers of the application and the buffers
+ *           handed to the WIL from a single block, sized for the nodes of the
+ *           ACL instead of ADI_WIL_MAX_NODES. Regions are never freed one by
+ *           one, the whole arena is reinitialised before the next connect.
+ *
+ * Copyright (c) 2020-2022 Analog Devices, Inc. All Rights Reserved.
+ * This software is proprietary and confidential to Analog Devices, Inc. and its licensors.
+ *******************************************************************************/
+
+#include <string.h>
+
+#include "adi_wil_example_arena.h"
+#include "adi_wil_example_printf.h"
+#include "adi_wil_types.h"
+
+/******************************************************************************
+ * Static variable declarations
+ *****************************************************************************/
+static uint8_t *pArenaBlock = NULL;
+static uint32_t iArenaSize = 0;
+static uint32_t iArenaUsed = 0;
+static uint8_t iArenaNodeCount = 0;
+static uint8_t iArenaRegionCount = 0;
+static adi_arena_region_t ArenaRegions[ADI_ARENA_MAX_REGIONS];
+
+/*******************************************************************************
+ * Funtion definitions
+ ******************************************************************************/
+void adi_wil_example_ArenaInit(void *pBlock, uint32_t iSize, uint8_t iNodeCount)
+{
+    uint32_t iPadding;
+
+    /* Start the block on an aligned address */
+    iPadding = (uint32_t)((ADI_ARENA_ALIGN - ((uintptr_t)pBlock & (ADI_ARENA_ALIGN - 1u))) & (ADI_ARENA_ALIGN - 1u));
+
+    pArenaBlock = (uint8_t *)pBlock + iPadding;
+    iArenaSize = (iSize > iPadding) ? (iSize - iPadding) : 0u;
+    iArenaUsed = 0;
+    iArenaNodeCount = iNodeCount;
+    iArenaRegionCount = 0;
+    memset(ArenaRegions, 0, sizeof(ArenaRegions));
+}
+
+void *adi_wil_example_ArenaAlloc(const char *pName, uint32_t iBytesPerNode, uint32_t iFixedBytes)
+{
+    adi_arena_region_t *pRegion;
+    uint32_t iBytes = ADI_ARENA_REGION_SIZE(iBytesPerNode, iFixedBytes, iArenaNodeCount);
+    void *pMemory = NULL;
+
+    if ((pArenaBlock != NULL) &&
+        (iArenaRegionCount < ADI_ARENA_MAX_REGIONS) &&
+        (iBytes <= (iArenaSize - iArenaUsed)))
+    {
+        pMemory = &pArenaBlock[iArenaUsed];
+        memset(pMemory, 0, iBytes);
+        iArenaUsed += iBytes;
+
+        pRegion = &ArenaRegions[iArenaRegionCount++];
+        pRegion->pName = pName;
+        pRegion->iBytesPerNode = iBytesPerNode;
+        pRegion->iFixedBytes = iFixedBytes;
+        pRegion->iBytes = iBytes;
+    }
+    else
+    {
+        adi_wil_ex_error("Arena : no room for %s, %u bytes (%u of %u used)",
+                         pName, (unsigned int)iBytes, (unsigned int)iArenaUsed, (unsigned int)iArenaSize);
+    }
+
+    return pMemory;
+}
+
+uint8_t adi_wil_example_ArenaNodeCount(void)
+{
+    return iArenaNodeCount;
+}
+
+void adi_wil_example_ArenaDumpFootprint(void)
+{
+    adi_arena_region_t const *pRegion;
+    uint32_t iMaxBytes = 0;
+    uint8_t i;
+
+    adi_wil_ex_printf("Arena : %u nodes, %u of %u bytes used" LINE_END,
+                      (unsigned int)iArenaNodeCount, (unsigned int)iArenaUsed, (unsigned int)iArenaSize);
+    adi_wil_ex_printf("%-24s %8s %8s %8s %10s" LINE_END,
+                      "region", "per node", "fixed", "bytes", "62 nodes");
+
+    for (i = 0; i < iArenaRegionCount; i++)
+    {
+        pRegion = &ArenaRegions[i];
+        adi_wil_ex_printf("%-24s %8u %8u %8u %10u" LINE_END,
+                          pRegion->pName,
+                          (unsigned int)pRegion->iBytesPerNode,
+                          (unsigned int)pRegion->iFixedBytes,
+                          (unsigned int)pRegion->iBytes,
+                          (unsigned int)ADI_ARENA_REGION_SIZE(pRegion->iBytesPerNode, pRegion->iFixedBytes, ADI_WIL_MAX_NODES));
+        iMaxBytes += ADI_ARENA_REGION_SIZE(pRegion->iBytesPerNode, pRegion->iFixedBytes, ADI_WIL_MAX_NODES);
+    }
+
+    adi_wil_ex_printf("%-24s %8s %8s %8u %10u" LINE_END, "total", "", "", (unsigned int)iArenaUsed, (unsigned int)iMaxBytes);
+}
@@ -0,0 +1,301 @@
+/*******************************************************************************
+ * @file     adi_wil_example_device_dir.c
+ *
+ * @brief    Device directory
+ *
+ * @details  Constant time translations between WIL device IDs, node indexes
+ *           and node MAC addresses. The node index of a device ID is its bit
+ *           position, found with a de Bruijn multiply instead of a bit scan.
+ *           MACs are found through an open addressing hash over the ACL,
+ *           rebuilt whenever a new ACL is read.
+ *
+ * Copyright (c) 2020-2022 Analog Devices, Inc. All Rights Reserved.
+ * This software is proprietary and confidential to Analog Devices, Inc. and its licensors.
+ *******************************************************************************/
+
+#include <string.h>
+
+#include "adi_wil_example_device_dir.h"
+#include "adi_wil_example_printf.h"
+#include "IfxStm.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define STM                             &MODULE_STM0            /* Timestamp source, shared with the scheduler */
+#define ADI_DEVICE_DIR_HASH_MASK        (ADI_DEVICE_DIR_HASH_SIZE - 1u)
+#define ADI_DEVICE_DIR_DEBRUIJN32       0x077CB531u
+#define ADI_DEVICE_DIR_BENCH_ROUNDS     100u
+
+/******************************************************************************
+ * Static variable declarations
+ *****************************************************************************/
+extern Ifx_TickTime g_ticksFor1ms;
+
+static adi_device_dir_t DeviceDir;
+
+/* Bit position of an isolated bit, indexed by (bit * ADI_DEVICE_DIR_DEBRUIJN32) >> 27 */
+static const uint8_t adi_device_dir_BitPosition[32] =
+{
+    0u, 1u, 28u, 2u, 29u, 14u, 24u, 3u, 30u, 22u, 20u, 15u, 25u, 17u, 4u, 8u,
+    31u, 27u, 13u, 23u, 21u, 19u, 16u, 7u, 26u, 12u, 18u, 6u, 11u, 5u, 10u, 9u
+};
+
+/* Keeps the benchmark loops from being optimised away */
+static volatile uint8_t iDeviceDirBenchSink;
+
+/*******************************************************************************
+ * Local Funtion Declarations
+ ******************************************************************************/
+static void adi_device_dir_Build(adi_device_dir_t *pDir, adi_wil_acl_t const *pAcl);
+static bool adi_device_dir_Find(adi_device_dir_t const *pDir, uint8_t const *pMac, uint8_t *pNodeIndex);
+static uint32_t adi_device_dir_Hash(uint8_t const *pMac);
+static uint8_t adi_device_dir_LowestBit(uint64_t iMask);
+static uint8_t adi_device_dir_ScanNodeIndex(adi_wil_device_t eDevice);
+static bool adi_device_dir_ScanMac(adi_wil_acl_t const *pAcl, uint8_t const *pMac, uint8_t *pNodeIndex);
+static uint32_t adi_device_dir_TicksToNs(uint32_t iTicks, uint32_t iCount);
+
+/*******************************************************************************
+ * Funtion definitions
+ ******************************************************************************/
+void adi_wil_example_DeviceDirUpdate(adi_wil_acl_t const *pAcl)
+{
+    adi_device_dir_Build(&DeviceDir, pAcl);
+}
+
+uint8_t adi_wil_example_DeviceDirNodeIndex(adi_wil_device_t eDevice)
+{
+    uint8_t iNodeIndex;
+
+    if (eDevice == 0u)
+    {
+        iNodeIndex = ADI_DEVICE_DIR_INVALID;
+    }
+    else if (eDevice == ADI_WIL_DEV_MANAGER_0)
+    {
+        iNodeIndex = ADI_DEVICE_DIR_MANAGER_0;
+    }
+    else if (eDevice == ADI_WIL_DEV_MANAGER_1)
+    {
+        iNodeIndex = ADI_DEVICE_DIR_MANAGER_1;
+    }
+    else if (eDevice == ADI_WIL_DEV_ALL_MANAGERS)
+    {
+        iNodeIndex = ADI_DEVICE_DIR_ALL_MANAGERS;
+    }
+    else if (eDevice == ADI_WIL_DEV_ALL_NODES)
+    {
+        iNodeIndex = ADI_DEVICE_DIR_ALL_NODES;
+    }
+    else
+    {
+        iNodeIndex = adi_device_dir_LowestBit(eDevice);
+    }
+
+    return iNodeIndex;
+}
+
+bool adi_wil_example_DeviceDirFindMac(uint8_t const *pMac, uint8_t *pNodeIndex)
+{
+    return adi_device_dir_Find(&DeviceDir, pMac, pNodeIndex);
+}
+
+void adi_wil_example_DeviceDirBenchmark(void)
+{
+    static adi_wil_acl_t BenchAcl;
+    static adi_device_dir_t BenchDir;
+    uint32_t iStart;
+    uint32_t iScanIdTicks, iDirIdTicks, iScanMacTicks, iDirMacTicks;
+    uint32_t iRound;
+    uint8_t iNode;
+    uint8_t iFound = 0;
+    uint8_t iResult = 0;
+    uint8_t *pMac;
+
+    /* 62 nodes with MACs differing in the last three bytes, as in a real pack */
+    memset(&BenchAcl, 0, sizeof(BenchAcl));
+    for (iNode = 0; iNode < ADI_WIL_MAX_NODES; iNode++)
+    {
+        pMac = &BenchAcl.Data[iNode * ADI_WIL_MAC_ADDR_SIZE];
+        pMac[0] = 0x64u;
+        pMac[1] = 0xF9u;
+        pMac[2] = 0xC0u;
+        pMac[5] = 0x30u;
+        pMac[6] = (uint8_t)(0x80u + (iNode >> 2));
+        pMac[7] = (uint8_t)(0x11u * (iNode & 3u) + iNode);
+    }
+    BenchAcl.iCount = ADI_WIL_MAX_NODES;
+
+    iStart = IfxStm_getLower(STM);
+    adi_device_dir_Build(&BenchDir, &BenchAcl);
+    adi_wil_ex_printf("Device directory : build %u us for %u nodes" LINE_END,
+                      (unsigned int)(adi_device_dir_TicksToNs(IfxStm_getLower(STM) - iStart, 1u) / 1000u),
+                      (unsigned int)ADI_WIL_MAX_NODES);
+
+    iStart = IfxStm_getLower(STM);
+    for (iRound = 0; iRound < ADI_DEVICE_DIR_BENCH_ROUNDS; iRound++)
+    {
+        for (iNode = 0; iNode < ADI_WIL_MAX_NODES; iNode++)
+        {
+            iDeviceDirBenchSink = adi_device_dir_ScanNodeIndex(ADI_WIL_DEV_NODE_0 << iNode);
+        }
+    }
+    iScanIdTicks = IfxStm_getLower(STM) - iStart;
+
+    iStart = IfxStm_getLower(STM);
+    for (iRound = 0; iRound < ADI_DEVICE_DIR_BENCH_ROUNDS; iRound++)
+    {
+        for (iNode = 0; iNode < ADI_WIL_MAX_NODES; iNode++)
+        {
+            iDeviceDirBenchSink = adi_wil_example_DeviceDirNodeIndex(ADI_WIL_DEV_NODE_0 << iNode);
+        }
+    }
+    iDirIdTicks = IfxStm_getLower(STM) - iStart;
+
+    iStart = IfxStm_getLower(STM);
+    for (iRound = 0; iRound < ADI_DEVICE_DIR_BENCH_ROUNDS; iRound++)
+    {
+        for (iNode = 0; iNode < ADI_WIL_MAX_NODES; iNode++)
+        {
+            iFound += adi_device_dir_ScanMac(&BenchAcl, &BenchAcl.Data[iNode * ADI_WIL_MAC_ADDR_SIZE], &iResult) ? 1u : 0u;
+        }
+    }
+    iScanMacTicks = IfxStm_getLower(STM) - iStart;
+
+    iStart = IfxStm_getLower(STM);
+    for (iRound = 0; iRound < ADI_DEVICE_DIR_BENCH_ROUNDS; iRound++)
+    {
+        for (iNode = 0; iNode < ADI_WIL_MAX_NODES; iNode++)
+        {
+            iFound += adi_device_dir_Find(&BenchDir, &BenchAcl.Data[iNode * ADI_WIL_MAC_ADDR_SIZE], &iResult) ? 1u : 0u;
+        }
+    }
+    iDirMacTicks = IfxStm_getLower(STM) - iStart;
+    iDeviceDirBenchSink = (uint8_t)(iFound + iResult);
+
+    adi_wil_ex_printf("%-24s %10s %10s" LINE_END, "lookup (ns per call)", "scan", "directory");
+    adi_wil_ex_printf("%-24s %10u %10u" LINE_END, "device ID -> node",
+                      (unsigned int)adi_device_dir_TicksToNs(iScanIdTicks, ADI_DEVICE_DIR_BENCH_ROUNDS * ADI_WIL_MAX_NODES),
+                      (unsigned int)adi_device_dir_TicksToNs(iDirIdTicks, ADI_DEVICE_DIR_BENCH_ROUNDS * ADI_WIL_MAX_NODES));
+    adi_wil_ex_printf("%-24s %10u %10u" LINE_END, "MAC -> node",
+                      (unsigned int)adi_device_dir_TicksToNs(iScanMacTicks, ADI_DEVICE_DIR_BENCH_ROUNDS * ADI_WIL_MAX_NODES),
+                      (unsigned int)adi_device_dir_TicksToNs(iDirMacTicks, ADI_DEVICE_DIR_BENCH_ROUNDS * ADI_WIL_MAX_NODES));
+}
+
+static void adi_device_dir_Build(adi_device_dir_t *pDir, adi_wil_acl_t const *pAcl)
+{
+    uint8_t iNode;
+    uint8_t iCount;
+    uint32_t iBucket;
+
+    memset(pDir, 0, sizeof(adi_device_dir_t));
+
+    iCount = (pAcl->iCount > ADI_DEVICE_DIR_NODE_COUNT) ? (uint8_t)ADI_DEVICE_DIR_NODE_COUNT : pAcl->iCount;
+    for (iNode = 0; iNode < iCount; iNode++)
+    {
+        memcpy(&pDir->Mac[iNode][0], &pAcl->Data[iNode * ADI_WIL_MAC_ADDR_SIZE], ADI_WIL_MAC_ADDR_SIZE);
+
+        /* Linear probing, a duplicate MAC keeps the first index like the
+         * linear search did */
+        iBucket = adi_device_dir_Hash(&pDir->Mac[iNode][0]);
+        while (pDir->MacHash[iBucket] != 0u)
+        {
+            if (memcmp(&pDir->Mac[pDir->MacHash[iBucket] - 1u][0], &pDir->Mac[iNode][0], ADI_WIL_MAC_ADDR_SIZE) == 0)
+            {
+                break;
+            }
+            iBucket = (iBucket + 1u) & ADI_DEVICE_DIR_HASH_MASK;
+        }
+        if (pDir->MacHash[iBucket] == 0u)
+        {
+            pDir->MacHash[iBucket] = (uint8_t)(iNode + 1u);
+        }
+    }
+    pDir->iCount = iCount;
+}
+
+static bool adi_device_dir_Find(adi_device_dir_t const *pDir, uint8_t const *pMac, uint8_t *pNodeIndex)
+{
+    uint32_t iBucket = adi_device_dir_Hash(pMac);
+    uint8_t iEntry;
+    bool bFound = false;
+
+    /* The table is never more than half full, an empty bucket ends the probe */
+    while ((iEntry = pDir->MacHash[iBucket]) != 0u)
+    {
+        if (memcmp(&pDir->Mac[iEntry - 1u][0], pMac, ADI_WIL_MAC_ADDR_SIZE) == 0)
+        {
+            *pNodeIndex = (uint8_t)(iEntry - 1u);
+            bFound = true;
+            break;
+        }
+        iBucket = (iBucket + 1u) & ADI_DEVICE_DIR_HASH_MASK;
+    }
+
+    return bFound;
+}
+
+static uint32_t adi_device_dir_Hash(uint8_t const *pMac)
+{
+    /* The vendor prefix is shared by all nodes, only the last bytes differ */
+    uint32_t iKey = ((uint32_t)pMac[5] << 16) | ((uint32_t)pMac[6] << 8) | (uint32_t)pMac[7];
+
+    return ((uint32_t)(iKey * 0x9E3779B1u) >> 25) & ADI_DEVICE_DIR_HASH_MASK;
+}
+
+static uint8_t adi_device_dir_LowestBit(uint64_t iMask)
+{
+    uint32_t iWord = (uint32_t)iMask;
+    uint8_t iOffset = 0u;
+
+    if (iWord == 0u)
+    {
+        iWord = (uint32_t)(iMask >> 32);
+        iOffset = 32u;
+    }
+
+    /* Isolate the lowest set bit, the multiply moves a unique 5-bit pattern
+     * for each bit position into the top bits */
+    iWord &= (0u - iWord);
+
+    return (uint8_t)(iOffset + adi_device_dir_BitPosition[(uint32_t)(iWord * ADI_DEVICE_DIR_DEBRUIJN32) >> 27]);
+}
+
+/* The bit scan ADK_ConvertDeviceId used, kept as the benchmark reference */
+static uint8_t adi_device_dir_ScanNodeIndex(adi_wil_device_t eDevice)
+{
+    uint8_t iNodeIndex = 0u;
+
+    while ((eDevice & (ADI_WIL_DEV_NODE_0 << iNodeIndex)) == 0u)
+    {
+        iNodeIndex++;
+    }
+
+    return iNodeIndex;
+}
+
+/* The search adi_wil_mac_deviceID_return used, kept as the benchmark reference */
+static bool adi_device_dir_ScanMac(adi_wil_acl_t const *pAcl, uint8_t const *pMac, uint8_t *pNodeIndex)
+{
+    bool bMacFound = false;
+
+    for (uint8_t i = 0; (i < ADI_WIL_MAX_NODES) && !bMacFound; i++)
+    {
+        bMacFound = true;
+        for (uint8_t j = 0; (j < ADI_WIL_MAC_ADDR_SIZE) && bMacFound; j++)
+        {
+            bMacFound = (pAcl->Data[(ADI_WIL_MAC_ADDR_SIZE * i) + j] == pMac[j]);
+        }
+        if (bMacFound)
+        {
+            *pNodeIndex = i;
+        }
+    }
+
+    return bMacFound;
+}
+
+static uint32_t adi_device_dir_TicksToNs(uint32_t iTicks, uint32_t iCount)
+{
+    return ((g_ticksFor1ms > 0) && (iCount > 0u)) ? (uint32_t)(((uint64_t)iTicks * 1000000u) / ((uint64_t)g_ticksFor1ms * iCount)) : 0u;
+}
@@ -0,0 +1,383 @@
+/*******************************************************************************
+ * @file     adi_wil_example_event_bus.c
+ *
+ * @brief    WIL event dispatch table
+ *
+ * @details  adi_wil_HandleEvent hands every WIL event to the handlers
+ *           registered for its event ID, in priority order. Inline handlers
+ *           run in the event callback, deferred handlers get a copy of the
+ *           event data through a per-core queue drained by
+ *           adi_wil_example_EventBusDrain(). Each handler keeps its own
+ *           execution time and latency statistics.
+ *
+ * Copyright (c) 2020-2022 Analog Devices, Inc. All Rights Reserved.
+ * This software is proprietary and confidential to Analog Devices, Inc. and its licensors.
+ *******************************************************************************/
+
+#include <string.h>
+
+#include "adi_wil_example_event_bus.h"
+#include "adi_wil_example_printf.h"
+#include "adi_wil.h"
+#include "IfxCpu.h"
+#include "IfxStm.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define STM                             &MODULE_STM0            /* Timestamp source, shared with the scheduler */
+#define ADI_EVENT_BUS_QUEUE_MASK        (ADI_EVENT_BUS_QUEUE_DEPTH - 1u)
+
+#if ((ADI_EVENT_BUS_QUEUE_DEPTH & ADI_EVENT_BUS_QUEUE_MASK) != 0u)
+#error "ADI_EVENT_BUS_QUEUE_DEPTH must be a power of two"
+#endif
+
+/*******************************************************************************
+ * Structures
+ ******************************************************************************/
+/* Largest event data copied for a deferred handler */
+typedef union
+{
+    adi_wil_device_t                    eDeviceId;
+    adi_wil_sensor_data_buffer_t        SensorData;
+    adi_wil_network_data_buffer_t       NetworkData;
+    adi_wil_health_report_t             HealthReport;
+    adi_wil_fault_report_t              FaultReport;
+    adi_wil_device_removed_t            DeviceRemoved;
+    adi_wil_cell_balancing_status_t     CellBalancing;
+    adi_wil_err_t                       rc;
+    uint16_t                            iCount;
+    uint8_t                             MAC[ADI_WIL_MAC_ADDR_SIZE];
+}adi_event_bus_payload_t;
+
+typedef struct
+{
+    adi_event_handler_t pfHandler;
+    const char          *pName;
+    uint8_t             eEvent;
+    uint8_t             iPriority;
+    uint8_t             eExec;
+    uint8_t             iCore;
+    uint8_t             iLink;              /* Next handler of the same event + 1, 0 : last */
+    adi_event_handler_stats_t Stats;
+}adi_event_bus_entry_t;
+
+typedef struct
+{
+    adi_wil_pack_t const *pPack;
+    uint32_t            iRaisedStm;         /* STM0 lower 32 bits when the WIL raised the event */
+    uint8_t             iHandle;
+    uint8_t             eEvent;
+    bool                bHasData;
+    volatile bool       bReady;             /* Written last by the producer */
+    adi_event_bus_payload_t Payload;
+}adi_event_bus_item_t;
+
+typedef struct
+{
+    volatile uint32_t   iHead;              /* Items ever reserved, any core */
+    volatile uint32_t   iTail;              /* Items ever run, owning core only */
+    adi_event_bus_item_t Item[ADI_EVENT_BUS_QUEUE_DEPTH];
+}adi_event_bus_queue_t;
+
+/******************************************************************************
+ * Static variable declarations
+ *****************************************************************************/
+extern Ifx_TickTime g_ticksFor1ms;
+
+static adi_event_bus_entry_t EventBusEntries[ADI_EVENT_BUS_MAX_HANDLERS];
+static uint8_t EventBusHead[ADI_EVENT_BUS_EVENT_COUNT];                     /* First handler of each event + 1, 0 : none */
+static uint8_t iEventBusCount = 0;
+static adi_event_bus_queue_t EventBusQueues[ADI_EVENT_BUS_CORE_COUNT];
+
+/*******************************************************************************
+ * Local Funtion Declarations
+ ******************************************************************************/
+static void adi_event_bus_Run(adi_event_bus_entry_t *pEntry, adi_wil_pack_t const *pPack, adi_wil_event_id_t eEvent, void const *pData, uint32_t iRaisedStm);
+static void adi_event_bus_Queue(uint8_t iHandle, adi_wil_pack_t const *pPack, adi_wil_event_id_t eEvent, void const *pData, uint32_t iRaisedStm);
+static uint32_t adi_event_bus_PayloadSize(adi_wil_event_id_t eEvent);
+static uint32_t adi_event_bus_TicksToUs(uint64_t iTicks);
+
+/*******************************************************************************
+ * Funtion definitions
+ ******************************************************************************/
+void adi_wil_example_EventBusReset(void)
+{
+    memset(EventBusEntries, 0, sizeof(EventBusEntries));
+    memset(EventBusHead, 0, sizeof(EventBusHead));
+    memset(EventBusQueues, 0, sizeof(EventBusQueues));
+    iEventBusCount = 0;
+}
+
+uint8_t adi_wil_example_EventBusRegister(adi_wil_event_id_t eEvent,
+                                         adi_event_handler_t pfHandler,
+                                         const char *pName,
+                                         uint8_t iPriority,
+                                         adi_event_exec_t eExec,
+                                         uint8_t iCore)
+{
+    adi_event_bus_entry_t *pEntry;
+    uint8_t *pLink;
+    uint8_t iHandle;
+
+    if (((uint32_t)eEvent >= ADI_EVENT_BUS_EVENT_COUNT) || (pfHandler == NULL) ||
+        (iCore >= ADI_EVENT_BUS_CORE_COUNT) || (iEventBusCount >= ADI_EVENT_BUS_MAX_HANDLERS))
+    {
+        return ADI_EVENT_BUS_INVALID_HANDLE;
+    }
+
+    iHandle = iEventBusCount++;
+    pEntry = &EventBusEntries[iHandle];
+    memset(pEntry, 0, sizeof(adi_event_bus_entry_t));
+    pEntry->pfHandler = pfHandler;
+    pEntry->pName = (pName != NULL) ? pName : "";
+    pEntry->eEvent = (uint8_t)eEvent;
+    pEntry->iPriority = iPriority;
+    pEntry->eExec = (uint8_t)eExec;
+    pEntry->iCore = iCore;
+
+    /* Insert behind the handlers of the same or a more urgent priority */
+    pLink = &EventBusHead[eEvent];
+    while ((*pLink != 0u) && (EventBusEntries[*pLink - 1u].iPriority <= iPriority))
+    {
+        pLink = &EventBusEntries[*pLink - 1u].iLink;
+    }
+    pEntry->iLink = *pLink;
+    *pLink = (uint8_t)(iHandle + 1u);
+
+    return iHandle;
+}
+
+void adi_wil_example_EventBusDispatch(adi_wil_pack_t const *pPack, adi_wil_event_id_t eEvent, void const *pData)
+{
+    uint32_t iRaisedStm = IfxStm_getLower(STM);
+    uint8_t iLink;
+
+    if ((uint32_t)eEvent >= ADI_EVENT_BUS_EVENT_COUNT)
+    {
+        return;
+    }
+
+    for (iLink = EventBusHead[eEvent]; iLink != 0u; iLink = EventBusEntries[iLink - 1u].iLink)
+    {
+        if (EventBusEntries[iLink - 1u].eExec == (uint8_t)ADI_EVENT_EXEC_INLINE)
+        {
+            adi_event_bus_Run(&EventBusEntries[iLink - 1u], pPack, eEvent, pData, iRaisedStm);
+        }
+        else
+        {
+            adi_event_bus_Queue((uint8_t)(iLink - 1u), pPack, eEvent, pData, iRaisedStm);
+        }
+    }
+}
+
+void adi_wil_example_EventBusDrain(void)
+{
+    uint32_t iCore = (uint32_t)IfxCpu_getCoreIndex();
+    adi_event_bus_queue_t *pQueue;
+    adi_event_bus_item_t *pItem;
+
+    if (iCore >= ADI_EVENT_BUS_CORE_COUNT)
+    {
+        return;
+    }
+    pQueue = &EventBusQueues[iCore];
+
+    while (pQueue->iTail != pQueue->iHead)
+    {
+        pItem = &pQueue->Item[pQueue->iTail & ADI_EVENT_BUS_QUEUE_MASK];
+        if (!pItem->bReady)
+        {
+            /* Reserved but still being written, picked up on the next drain */
+            break;
+        }
+        adi_event_bus_Run(&EventBusEntries[pItem->iHandle],
+                          pItem->pPack,
+                          (adi_wil_event_id_t)pItem->eEvent,
+                          pItem->bHasData ? (void const *)&pItem->Payload : NULL,
+                          pItem->iRaisedStm);
+        pItem->bReady = false;
+        pQueue->iTail++;
+    }
+}
+
+adi_event_handler_stats_t const *adi_wil_example_EventBusGetStats(uint8_t iHandle)
+{
+    return (iHandle < iEventBusCount) ? &EventBusEntries[iHandle].Stats : NULL;
+}
+
+void adi_wil_example_EventBusDumpStats(bool bReset)
+{
+    adi_event_bus_entry_t *pEntry;
+    uint8_t iHandle;
+
+    adi_wil_ex_printf("Event bus : %u handlers" LINE_END, (unsigned int)iEventBusCount);
+    adi_wil_ex_printf("%-32s %5s %4s %9s %6s %8s %8s %8s" LINE_END,
+                      "handler", "event", "exec", "calls", "drop", "wcet", "avg", "latency");
+
+    for (iHandle = 0; iHandle < iEventBusCount; iHandle++)
+    {
+        pEntry = &EventBusEntries[iHandle];
+        adi_wil_ex_printf("%-32s %5u %4s %9u %6u %8u %8u %8u" LINE_END,
+                          pEntry->pName,
+                          (unsigned int)pEntry->eEvent,
+                          (pEntry->eExec == (uint8_t)ADI_EVENT_EXEC_INLINE) ? "cb" : ((pEntry->iCore == 0u) ? "q0" : (pEntry->iCore == 1u) ? "q1" : (pEntry->iCore == 2u) ? "q2" : "q3"),
+                          (unsigned int)pEntry->Stats.iCalls,
+                          (unsigned int)pEntry->Stats.iDropped,
+                          (unsigned int)adi_event_bus_TicksToUs(pEntry->Stats.iMaxTicks),
+                          (unsigned int)((pEntry->Stats.iCalls != 0u) ? adi_event_bus_TicksToUs(pEntry->Stats.iTotalTicks / pEntry->Stats.iCalls) : 0u),
+                          (unsigned int)adi_event_bus_TicksToUs(pEntry->Stats.iMaxLatencyTicks));
+        if (bReset)
+        {
+            memset(&pEntry->Stats, 0, sizeof(adi_event_handler_stats_t));
+        }
+    }
+}
+
+/**
+ * @brief   Runs one handler and folds its execution time and its delay from the
+ *          event into the statistics. Only the core running the handler writes
+ *          these fields.
+ */
+static void adi_event_bus_Run(adi_event_bus_entry_t *pEntry, adi_wil_pack_t const *pPack, adi_wil_event_id_t eEvent, void const *pData, uint32_t iRaisedStm)
+{
+    uint32_t iStartStm;
+    uint32_t iTicks;
+
+    iStartStm = IfxStm_getLower(STM);
+    pEntry->pfHandler(pPack, eEvent, pData);
+    iTicks = IfxStm_getLower(STM) - iStartStm;
+
+    pEntry->Stats.iCalls++;
+    pEntry->Stats.iLastTicks = iTicks;
+    pEntry->Stats.iTotalTicks += iTicks;
+    if (iTicks > pEntry->Stats.iMaxTicks)
+    {
+        pEntry->Stats.iMaxTicks = iTicks;
+    }
+    if ((iStartStm - iRaisedStm) > pEntry->Stats.iMaxLatencyTicks)
+    {
+        pEntry->Stats.iMaxLatencyTicks = iStartStm - iRaisedStm;
+    }
+}
+
+/**
+ * @brief   Copies the event into the queue of the handler's core. Slots are
+ *          reserved with CMPSWAP so packs processed on different cores can
+ *          raise events into the same queue. A full queue drops the event and
+ *          counts it against the handler.
+ */
+static void adi_event_bus_Queue(uint8_t iHandle, adi_wil_pack_t const *pPack, adi_wil_event_id_t eEvent, void const *pData, uint32_t iRaisedStm)
+{
+    adi_event_bus_entry_t *pEntry = &EventBusEntries[iHandle];
+    adi_event_bus_queue_t *pQueue = &EventBusQueues[pEntry->iCore];
+    adi_event_bus_item_t *pItem;
+    uint32_t iSize = adi_event_bus_PayloadSize(eEvent);
+    uint32_t iSlot;
+    bool bFull;
+
+    do
+    {
+        iSlot = pQueue->iHead;
+        bFull = ((iSlot - pQueue->iTail) >= ADI_EVENT_BUS_QUEUE_DEPTH);
+    } while (!bFull && (Ifx__cmpAndSwap((unsigned int volatile *)&pQueue->iHead, iSlot + 1u, iSlot) != iSlot));
+
+    if (bFull)
+    {
+        pEntry->Stats.iDropped++;
+        return;
+    }
+
+    pItem = &pQueue->Item[iSlot & ADI_EVENT_BUS_QUEUE_MASK];
+    pItem->pPack = pPack;
+    pItem->iRaisedStm = iRaisedStm;
+    pItem->iHandle = iHandle;
+    pItem->eEvent = (uint8_t)eEvent;
+    pItem->bHasData = ((pData != NULL) && (iSize != 0u));
+    if (pItem->bHasData)
+    {
+        memcpy(&pItem->Payload, pData, iSize);
+    }
+    pItem->bReady = true;
+}
+
+/**
+ * @brief   Size of the data the WIL passes with an event, see adi_wil_event_id_t.
+ *          Events whose data is not copied reach deferred handlers with NULL.
+ */
+static uint32_t adi_event_bus_PayloadSize(adi_wil_event_id_t eEvent)
+{
+    uint32_t iSize;
+
+    switch (eEvent)
+    {
+        case ADI_WIL_EVENT_COMM_NODE_CONNECTED:
+        case ADI_WIL_EVENT_COMM_NODE_DISCONNECTED:
+        case ADI_WIL_EVENT_COMM_MGR_CONNECTED:
+        case ADI_WIL_EVENT_COMM_MGR_DISCONNECTED:
+        case ADI_WIL_EVENT_COMM_SAFETY_CPU_DISCONNECTED:
+        case ADI_WIL_EVENT_FAULT_SOURCES:
+        case ADI_WIL_EVENT_MGR_QUEUE_OVERFLOW:
+        case ADI_WIL_EVENT_NODE_MODE_MISMATCH:
+            iSize = sizeof(adi_wil_device_t);
+            break;
+
+        case ADI_WIL_EVENT_DATA_READY_BMS:
+        case ADI_WIL_EVENT_DATA_READY_PMS:
+        case ADI_WIL_EVENT_DATA_READY_EMS:
+            iSize = sizeof(adi_wil_sensor_data_buffer_t);
+            break;
+
+        case ADI_WIL_EVENT_DATA_READY_HEALTH_REPORT:
+            iSize = sizeof(adi_wil_health_report_t);
+            break;
+
+        case ADI_WIL_EVENT_DATA_READY_NETWORK_DATA:
+            iSize = sizeof(adi_wil_network_data_buffer_t);
+            break;
+
+        case ADI_WIL_EVENT_FAULT_REPORT:
+            iSize = sizeof(adi_wil_fault_report_t);
+            break;
+
+        case ADI_WIL_EVENT_SEC_NODE_NOT_IN_ACL:
+        case ADI_WIL_EVENT_SEC_CERTIFICATE_CALCULATION_ERROR:
+        case ADI_WIL_EVENT_SEC_JOIN_NO_KEY:
+        case ADI_WIL_EVENT_SEC_JOIN_DUPLICATE_JOIN_COUNTER:
+        case ADI_WIL_EVENT_SEC_JOIN_MIC_FAILED:
+        case ADI_WIL_EVENT_SEC_UNKNOWN_ERROR:
+        case ADI_WIL_EVENT_SEC_SESSION_MIC_FAILED:
+        case ADI_WIL_EVENT_SEC_M2M_JOIN_CNTR_ERROR:
+        case ADI_WIL_EVENT_SEC_M2M_SESSION_CNTR_ERROR:
+        case ADI_WIL_EVENT_SEC_CERTIFICATE_EXCHANGE_LOCK_ERROR:
+            iSize = ADI_WIL_MAC_ADDR_SIZE;
+            break;
+
+        case ADI_WIL_EVENT_XFER_DEVICE_REMOVED:
+            iSize = sizeof(adi_wil_device_removed_t);
+            break;
+
+        case ADI_WIL_EVENT_INSUFFICIENT_BUFFER:
+            iSize = sizeof(uint16_t);
+            break;
+
+        case ADI_WIL_EVENT_TOPOLOGY_APPLICATION_COMPLETE:
+            iSize = sizeof(adi_wil_err_t);
+            break;
+
+        case ADI_WIL_EVENT_CELL_BALANCING_STATUS:
+            iSize = sizeof(adi_wil_cell_balancing_status_t);
+            break;
+
+        default:
+            iSize = 0u;
+            break;
+    }
+
+    return iSize;
+}
+
+static uint32_t adi_event_bus_TicksToUs(uint64_t iTicks)
+{
+    return (g_ticksFor1ms > 0) ? (uint32_t)((iTicks * 1000u) / (uint64_t)g_ticksFor1ms) : 0u;
+}
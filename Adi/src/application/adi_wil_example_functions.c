@@ -34,6 +34,12 @@
 #include "adi_wil_example_owd.h"
 #include "adi_wil_hal_task_cb.h"
 #include "adi_wil_example_cell_balance.h"
+#include "adi_wil_example_event_bus.h"
+#include "adi_wil_example_device_dir.h"
+#include "adi_wil_example_arena.h"
+#include "adi_wil_example_hr_store.h"
+#include "adi_wil_example_pec.h"
+#include "adi_wil_example_script_cache.h"
 #include "adi_wil_example_debug_functions.h"
 #include "wb_rsp_query_device.h"
 #include "adi_wil_app_interface.h"
@@ -43,6 +49,7 @@
 #include "otap_mngr_opfw_220.h"
 
 #include "adi_wil_example_PSFromLatency.h"
+#include "adi_wil_example_link_stats.h"
 
 
 
@@ -76,7 +83,6 @@ extern bool bUpdateExpectedGenTime;
 extern bool gQueryDeviceRetry;     /*  @remark : request by sure-soft */
 extern volatile adi_wil_err_t adi_gProcessTaskErrorCode;
 
-extern uint32_t adi_gW2canNodeCount;
 extern const uint8_t bms_container_file;
 extern const uint8_t pms_container_file;
 extern adi_wil_pack_t packInstance;
@@ -96,7 +102,6 @@ bool KEY_OFF = false;
 bool bFirstBMSdata = false;
 bool gOTAPQueryDeviceRetry = false;
 bool ADK_NodeState[64] = {false,};
-bool FLG_pdr_initial = false;
 bool iDisconn_node[ADK_MAX_node] = {false,};
 /* Flag, set to true to indicate queryDevice callback has been called */
 bool volatile queryDeviceCallbackCalled = false;
@@ -105,20 +110,16 @@ uint8_t iPacketLostData = 0;
 uint32_t TEMP_BUFFER_ZERO[TEST_BUFFER_MAX] = {0,};
 uint8_t recv_confirm[ADK_MAX_node] = {0,};
 
-uint8_t pkt_valid_index[ADK_MAX_node];
-uint8_t FLG_pdr_seq_initial[ADK_MAX_node];
-uint8_t FLG_seq_num_rollback_period[ADK_MAX_node];
-uint32_t pkt_seq_buffer[ADK_MAX_node][PDR_pktbuf_depth];
-uint32_t pkt_valid_seq[ADK_MAX_node];
-uint64_t accm_PDR_OK[ADK_MAX_node];
-uint64_t accm_PDR_TOTAL[ADK_MAX_node];
+/* Link statistics at the previous publish, for the per interval PDR / duplicates */
+static uint32_t pdr_last_expected[ADK_MAX_node];
+static uint32_t pdr_last_received[ADK_MAX_node];
+static uint32_t pdr_last_duplicates[ADK_MAX_node];
+static bool     pdr_interval_valid[ADK_MAX_node];
 
 int32_t accm_rssi_rx_0 = 0;
 int32_t accm_rssi_rx_1 = 0;
 int32_t accm_pkt_num_0 = 0;
 int32_t accm_pkt_num_1 = 0;
-int64_t temp_rssi_rx[ADK_MAX_node][2] = {{0,}, {0,}};
-int64_t temp_count[ADK_MAX_node][2] = {{0,}, {0,}};
 
 uint16_t Compare_depth = 0;
 uint16_t Compare_cnt = 0;
@@ -132,8 +133,13 @@ adi_wil_err_t volatile queryDeviceRc = ADI_WIL_ERR_FAIL;
 /* Pointer to storage for configuration information passed into queryDevice callback. */
 adi_wil_configuration_t * pQueryDeviceConfig = (void*)0;
 
-adi_wil_network_data_t   userNetworkBuffer[ADI_WIL_MAX_NODES * ADI_BMS_PACKETS_PER_NODE_PER_INTERVAL];
+adi_wil_network_data_t   *userNetworkBuffer;         /* Carved from the arena, ADI_BMS_PACKETS_PER_NODE_PER_INTERVAL per node */
 adi_wil_err_t gNotifRc;
+/* Devices with a concurrent request (version, CRC, GPIO, contextual) outstanding, cleared in the API callback */
+static volatile uint64_t iConcurrentPending = 0u;
+/* Node versions and callback rc collected by adi_wil_example_GetNodeVersions */
+static adi_wil_dev_version_t NodeVersions[ADI_WIL_MAX_NODES];
+static adi_wil_err_t NodeVersionRc[ADI_WIL_MAX_NODES];
 unsigned int temp_BMS=0;
 uint8_t EventCallback_pkt_count = 0;
 uint32_t NetworkStatusTmr = 0;      /* Support Network Status Timer */
@@ -155,10 +161,11 @@ adi_wil_api_t  logAPIInProgress;
 volatile uint8_t iMgrConnectCount = 0, iMgrDisconnectCount = 0;
 uint16_t  nTotalPcktsRcvd = 0u;     /*  @remark : Variable to store total no. of bms packets received */
 
-adi_wil_sensor_data_t           userBMSBuffer[BMS_DATA_PACKET_COUNT];
-adi_wil_health_report0_t        userHR0Buffer[ADI_WIL_MAX_NODES];
-adi_wil_health_report1_t        userHR1Buffer[ADI_WIL_MAX_NODES];
-adi_wil_health_report2_t        userHR2Buffer[ADI_WIL_MAX_NODES];
+/* Per node buffers, carved from the arena by adi_wil_example_AllocateNodeBuffers */
+adi_wil_sensor_data_t           *userBMSBuffer;
+adi_wil_health_report0_t        *userHR0Buffer;
+adi_wil_health_report1_t        *userHR1Buffer;
+adi_wil_health_report2_t        *userHR2Buffer;
 adi_wil_health_report10_t       userHR10Buffer[NUM_OF_MANAGERS];
 adi_wil_health_report11_t       userHR11Buffer[NUM_OF_MANAGERS];
 adi_wil_health_report12_t       userHR12Buffer[NUM_OF_MANAGERS];
@@ -167,7 +174,8 @@ adi_wil_health_report14_t       userHR15Buffer[NUM_OF_MANAGERS];
 adi_wil_health_report14_t       userHR16Buffer[NUM_OF_MANAGERS];
 adi_wil_health_report14_t       userHR17Buffer[NUM_OF_MANAGERS];
 adi_wil_health_report14_t       userHR18Buffer[NUM_OF_MANAGERS];
-adi_wil_health_report80_t       userHR80Buffer[ADI_WIL_MAX_NODES];
+adi_wil_health_report80_t       *userHR80Buffer;
+static adi_hr_node_store_t      *pHrStore;
 adi_wil_device_t                faultSources;
 adi_wil_fault_report_t          faultReport;
 adi_wil_file_crc_list_t         crclist;
@@ -267,17 +275,20 @@ static volatile uint32_t      iSecurityEvtCount = 0u;
 
 
 static adi_wil_sensor_data_t    userPMSBuffer[PMS_DATA_PACKET_COUNT];
+static uint16_t                 iUserPMSPacketCount = 0u;   /* Valid packets in userPMSBuffer */
 static adi_wil_sensor_data_t    userEMSBuffer[EMS_DATA_PACKET_COUNT];
 #else
 #endif
 
 static volatile uint32_t      iBMSNotificationCount = 0u;
 static volatile bool          bConnectApiCalled = false;
+/* Manager ports of the connected pack, their Internals hold the SPI Rx/Tx
+ * frame buffers read by the WIL receive path */
+#define ADI_WIL_HAL_START_SEC_FAST_BSS
+#include "adi_wil_hal_memmap.h"
 static adi_wil_port_t PortA, PortB;
-
-#ifdef DBG_GET_FILE_TEST
-static uint16_t     getfile_index = 0;
-#endif
+#define ADI_WIL_HAL_STOP_SEC_FAST_BSS
+#include "adi_wil_hal_memmap.h"
 
 /******************************************************************************
  * Custom structure
@@ -293,8 +304,8 @@ extern BOOTTIMESTR BOOT_TIME;
 /* Local Funtion Declarations                                                 */
 /******************************************************************************/
 void adi_wil_example_ADK_readBms(void);
-static void adi_wil_example_ADK_PDR_calc(void);
-static void adi_wil_example_ADK_RSSI_calc(void);
+static void adi_wil_example_ADK_LinkStatsPublish(void);
+static void adi_wil_example_ADK_LinkStatsResetNode(uint8_t i_node);
 
 // static void adi_wil_example_ADK_BGRSSI_calc(void);
 
@@ -319,6 +330,21 @@ adi_wil_err_t adi_wil_example_ExecuteInitialize(void)
 {
     adi_wil_err_t errorCode = ADI_WIL_ERR_SUCCESS;
 
+#ifdef _ADI_ONLY
+    /* Event handlers must be in place before the WIL raises any event */
+    if ((errorCode = adi_wil_example_RegisterEventHandlers()) != ADI_WIL_ERR_SUCCESS)
+    {
+        return errorCode;
+    }
+#endif
+
+#if (ADI_WIL_EX_DEVICE_DIR_BENCHMARK == 1)
+    adi_wil_example_DeviceDirBenchmark();
+#endif
+#if (ADI_WIL_EX_PEC_BENCHMARK == 1)
+    adi_wil_example_PecBenchmark();
+#endif
+
     /* Initialize the WIL */
     if ((errorCode = adi_wil_Initialize()) != ADI_WIL_ERR_SUCCESS)
     {
@@ -1297,6 +1323,61 @@ void adi_wil_example_print_welcome(void)
     adi_wil_GetWILSoftwareVersion(&version);
 }
 
+/******************************************************************************
+ * Wait for a request to complete. Single device version, CRC, GPIO and
+ * contextual requests run concurrently and release the pack lock straight
+ * away, so they are waited for through their callback instead
+ *****************************************************************************/
+static bool adi_wil_example_IsConcurrent(adi_wil_device_t eDevice)
+{
+    return ((eDevice != 0u) && ((eDevice & (eDevice - 1u)) == 0u));
+}
+
+static void adi_wil_example_WaitForRequest(adi_wil_pack_t * const pPack, adi_wil_device_t eDevice)
+{
+    if (adi_wil_example_IsConcurrent(eDevice))
+    {
+        while ((iConcurrentPending & eDevice) != 0u)
+        {
+            /* spin wait */
+        }
+    }
+    else
+    {
+        WaitForWilAPI(pPack);
+    }
+}
+
+/******************************************************************************
+ * API callback of a concurrent request
+ *****************************************************************************/
+static void adi_wil_example_HandleConcurrentCallback(adi_wil_pack_t const * const pPack,
+                                                     adi_wil_api_t eAPI,
+                                                     adi_wil_err_t rc,
+                                                     void const * const pData)
+{
+    adi_wil_device_t eDevice;
+    uint8_t iNode;
+
+    if (adi_wil_GetCallbackDeviceId(pPack, &eDevice) == ADI_WIL_ERR_SUCCESS)
+    {
+        if ((eAPI == ADI_WIL_API_GET_DEVICE_VERSION) && ((eDevice & ADI_WIL_DEV_ALL_NODES) != 0u))
+        {
+            iNode = ADK_ConvertDeviceId(eDevice);
+            NodeVersionRc[iNode] = rc;
+            if ((rc == ADI_WIL_ERR_SUCCESS) && (pData != NULL))
+            {
+                (void)memcpy(&NodeVersions[iNode], pData, sizeof(adi_wil_dev_version_t));
+            }
+        }
+        /* A streamed file transfer continues after each block */
+        if (rc != ADI_WIL_ERR_IN_PROGRESS)
+        {
+            iConcurrentPending &= ~eDevice;
+        }
+    }
+}
+
 /******************************************************************************
  * Example function using adi_wil_GetDeviceVersion
  *****************************************************************************/
@@ -1313,16 +1394,21 @@ adi_wil_err_t adi_wil_example_GetDeviceVersion(adi_wil_pack_t * const pPack, adi
     logAPIInProgress = ADI_WIL_API_GET_DEVICE_VERSION;
 
     /* Call the adi_wil_GetDeviceVersion API */
+    if (adi_wil_example_IsConcurrent(eDevice))
+    {
+        iConcurrentPending |= eDevice;
+    }
     errorCode = adi_wil_GetDeviceVersion(pPack, eDevice);
     if (errorCode != ADI_WIL_ERR_SUCCESS)
     {
         /* Handle error */
+        iConcurrentPending &= ~eDevice;
         adk_debug_Report(DBG_wil_GetDeviceVersion, errorCode);
     }
     else
     {
         /* Wait for non-blocking API to complete */
-        WaitForWilAPI(pPack);
+        adi_wil_example_WaitForRequest(pPack, eDevice);
     }
 
     /* Check for rc from the API callback and print out the main processor device information and silicon version */
@@ -1337,6 +1423,88 @@ adi_wil_err_t adi_wil_example_GetDeviceVersion(adi_wil_pack_t * const pPack, adi
     return errorCode;
 }
 
+/******************************************************************************
+ * Version inventory of the first iNodeCount nodes, keeping as many requests in
+ * flight as the WIL accepts
+ *****************************************************************************/
+adi_wil_err_t adi_wil_example_GetNodeVersions(adi_wil_pack_t * const pPack, uint8_t iNodeCount)
+{
+    adi_wil_err_t errorCode = ADI_WIL_ERR_SUCCESS;
+    adi_wil_device_t eDevice;
+    uint64_t iPending;
+    uint32_t iStartTime;
+    uint8_t iNode = 0u;
+
+    if (iNodeCount > ADI_WIL_MAX_NODES)
+    {
+        iNodeCount = ADI_WIL_MAX_NODES;
+    }
+
+    logAPIInProgress = ADI_WIL_API_GET_DEVICE_VERSION;
+    iStartTime = adi_wil_hal_TickerGetTimestamp();
+
+    while (iNode < iNodeCount)
+    {
+        eDevice = 1ULL << iNode;
+        NodeVersionRc[iNode] = ADI_WIL_ERR_IN_PROGRESS;
+        iPending = iConcurrentPending;
+        iConcurrentPending = iPending | eDevice;
+        errorCode = adi_wil_GetDeviceVersion(pPack, eDevice);
+        if (errorCode == ADI_WIL_ERR_SUCCESS)
+        {
+            iNode++;
+        }
+        else
+        {
+            iConcurrentPending &= ~eDevice;
+            if ((errorCode == ADI_WIL_ERR_API_IN_PROGRESS) && (iPending != 0u))
+            {
+                /* All request contexts busy, retry once one completes */
+                while (iConcurrentPending == iPending)
+                {
+                    /* spin wait */
+                }
+            }
+            else
+            {
+                adk_debug_Report(DBG_wil_GetDeviceVersion, errorCode);
+                NodeVersionRc[iNode] = errorCode;
+                iNode++;
+            }
+        }
+    }
+
+    while (iConcurrentPending != 0u)
+    {
+        /* spin wait */
+    }
+
+    adi_wil_ex_info("Version inventory of %d nodes took %d ms", iNodeCount, (adi_wil_hal_TickerGetTimestamp() - iStartTime));
+
+    for (iNode = 0u; iNode < iNodeCount; iNode++)
+    {
+        if (NodeVersionRc[iNode] != ADI_WIL_ERR_SUCCESS)
+        {
+            errorCode = NodeVersionRc[iNode];
+        }
+    }
+    return errorCode;
+}
+
+/******************************************************************************
+ * Copies the version of one node collected by adi_wil_example_GetNodeVersions
+ * into ClientData.DeviceVersion
+ *****************************************************************************/
+bool adi_wil_example_SelectNodeVersion(uint8_t iNode)
+{
+    if ((iNode >= ADI_WIL_MAX_NODES) || (NodeVersionRc[iNode] != ADI_WIL_ERR_SUCCESS))
+    {
+        return false;
+    }
+    (void)memcpy(&ClientData.DeviceVersion, &NodeVersions[iNode], sizeof(adi_wil_dev_version_t));
+    return true;
+}
+
 /******************************************************************************
  * Example function using adi_wil_GetFileCRC
  *****************************************************************************/
@@ -1356,16 +1524,21 @@ adi_wil_err_t adi_wil_example_GetFileCRC(adi_wil_pack_t * const pPack,
     logAPIInProgress = ADI_WIL_API_GET_FILE_CRC;
 
     /* Call the adi_wil_GetFileCRC API */
+    if (adi_wil_example_IsConcurrent(eDevice))
+    {
+        iConcurrentPending |= eDevice;
+    }
     errorCode = adi_wil_GetFileCRC(pPack, eDevice, eFileType);
     if (errorCode != ADI_WIL_ERR_SUCCESS)
     {
         /* Handle error */
+        iConcurrentPending &= ~eDevice;
         adk_debug_Report(DBG_wil_GetFileCRC, errorCode);
     }
     else
     {
         /* Wait for non-blocking API to complete */
-        WaitForWilAPI(pPack);
+        adi_wil_example_WaitForRequest(pPack, eDevice);
     }
 
     /* Check for rc from the API callback and print out the container details */
@@ -1392,10 +1565,13 @@ adi_wil_err_t adi_wil_example_ExecuteGetFile(adi_wil_pack_t * const pPack,
 {
     adi_wil_err_t errorCode = ADI_WIL_ERR_SUCCESS;
     uint32_t iTotalFileSizeRcvd = 0u;
+    uint32_t iStartTime;
 
     /* Set the Network Mode to STANDBY */
     returnOnWilError(adi_wil_example_ExecuteSetMode(pPack, ADI_WIL_MODE_STANDBY));
 
+    iStartTime = adi_wil_hal_TickerGetTimestamp();
+
     do
     {
         /* Call the API to get the next block in file */
@@ -1420,8 +1596,7 @@ adi_wil_err_t adi_wil_example_ExecuteGetFile(adi_wil_pack_t * const pPack,
                 }
                 iTotalFileSizeRcvd += getFileInformation.iByteCount;
                 if (errorCode == ADI_WIL_ERR_SUCCESS) {
-                    // adi_wil_ex_info("Get File Success!");
-                    // adi_wil_ex_info("File size received (bytes): %d", iTotalFileSizeRcvd);
+                    adi_wil_ex_info("GetFile: %d bytes in %d ms", iTotalFileSizeRcvd, (adi_wil_hal_TickerGetTimestamp() - iStartTime));
                 }
             }
             else {
@@ -1432,6 +1607,53 @@ adi_wil_err_t adi_wil_example_ExecuteGetFile(adi_wil_pack_t * const pPack,
 
     return errorCode;
 }
+
+/******************************************************************************
+ * Example function using adi_wil_GetFileStream, same result as
+ * adi_wil_example_ExecuteGetFile with a single API call
+ *****************************************************************************/
+adi_wil_err_t adi_wil_example_ExecuteGetFileStream(adi_wil_pack_t * const pPack,
+                                                   adi_wil_file_type_t eFileType,
+                                                   adi_wil_device_t eDevice)
+{
+    adi_wil_err_t errorCode = ADI_WIL_ERR_SUCCESS;
+    uint32_t iStartTime;
+
+    /* Set the Network Mode to STANDBY */
+    returnOnWilError(adi_wil_example_ExecuteSetMode(pPack, ADI_WIL_MODE_STANDBY));
+
+    (void)memset(&getFileInformation, 0, sizeof(getFileInformation));
+    iStartTime = adi_wil_hal_TickerGetTimestamp();
+
+    iConcurrentPending |= eDevice;
+    errorCode = adi_wil_GetFileStream(pPack, eDevice, eFileType);
+    if (errorCode != ADI_WIL_ERR_SUCCESS)
+    {
+        /* Handle error */
+        iConcurrentPending &= ~eDevice;
+        adk_debug_Report(DBG_wil_GetFile, errorCode);
+    }
+    else
+    {
+        /* Wait for the last block or an error */
+        while ((iConcurrentPending & eDevice) != 0u)
+        {
+            /* spin wait */
+        }
+
+        errorCode = gNotifRc;
+        if (errorCode == ADI_WIL_ERR_SUCCESS)
+        {
+            adi_wil_ex_info("GetFileStream: %d bytes in %d ms", (getFileInformation.iOffset + getFileInformation.iByteCount), (adi_wil_hal_TickerGetTimestamp() - iStartTime));
+        }
+        else
+        {
+            adk_debug_Report(DBG_wil_GetFile_wait, errorCode);
+        }
+    }
+
+    return errorCode;
+}
 #endif
 
 /******************************************************************************
@@ -1681,294 +1903,86 @@ void adi_wil_example_ADK_readBms(void)
 
 
 /**
- * @remark: This is example, exceptional case must be handled for PDR accuracy
+ * @remark: Restarts the link statistics of a node and the per interval baseline
+ *          taken from them, so the next publish does not subtract the old totals.
  */
-static void adi_wil_example_ADK_PDR_calc(void)
+static void adi_wil_example_ADK_LinkStatsResetNode(uint8_t i_node)
 {
-    uint8_t i_node = 0;
-    uint8_t i_pkt = 0;
-    uint32_t temp_buffer;
-
-    uint16_t i,j,k;   
-
-    uint8_t  temp_drvd_pkt[ADK_MAX_node]={0,};
-
-    uint16_t temp_PDR_OK[ADK_MAX_node]={0,};
-    uint16_t temp_PDR_TOTAL[ADK_MAX_node]={0,};
-    uint8_t  pdr_DUP_buffer[ADK_MAX_node]={0,};
-
-    /* Step 1 : Init global PDR data */
-    if(FLG_pdr_initial == false)
+    adi_wil_example_LinkStatsResetNode(i_node);
+    if(i_node < ADK_MAX_node)
     {
-        memset(&accm_PDR_OK[0],                 0, sizeof(uint64_t) * ADK_MAX_node);
-        memset(&accm_PDR_TOTAL[0],             0, sizeof(uint64_t) * ADK_MAX_node);
-
-        memset(&pkt_seq_buffer[0][0],           0, sizeof(uint32_t) * PDR_pktbuf_depth * ADK_MAX_node);
-        memset(&pkt_valid_index[0],             0, sizeof(uint8_t) * ADK_MAX_node);
-        memset(&pkt_valid_seq[0],               0, sizeof(uint32_t) * ADK_MAX_node);
-        memset(&FLG_pdr_seq_initial[0],         0, sizeof(uint8_t) * ADK_MAX_node);
-        memset(&FLG_seq_num_rollback_period[0], 0, sizeof(uint8_t) * ADK_MAX_node);
-        FLG_pdr_initial = true;
+        pdr_last_expected[i_node] = 0;
+        pdr_last_received[i_node] = 0;
+        pdr_last_duplicates[i_node] = 0;
+        pdr_interval_valid[i_node] = false;
     }
+}
+
+/**
+ * @remark: Copies the streaming link statistics (adi_wil_example_link_stats.c) into the
+ *          demo node view. PDR[0] / DUPLICATE[0] cover the records since the previous
+ *          call, PDR[3] everything since the node (re)joined.
+ */
+static void adi_wil_example_ADK_LinkStatsPublish(void)
+{
+    uint8_t i_node;
+    uint8_t i_mngr;
+    uint32_t iExpected;
+    uint32_t iReceived;
+    adi_link_stats_node_t const *pStats;
 
-    for(i_node=0 ; i_node<NODE_NUM ; i_node++)
+    for(i_node = 0; (i_node < NODE_NUM) && (i_node < ADK_MAX_node); i_node++)
     {
-        // Step 2 : Store sequence number of all NW packet
-            //Store sequence number into "pkt_seq_buffer"
-            //Inclease valid index number of "pkt_seq_buffer" to "pkt_valid_index(15)"
-            //Assume initial number of derivered packet for instant PDR during (buffer<15)
-        for(i_pkt=0 ; i_pkt<(NODE_NUM*BMS_PACKETS_PER_INTERVAL) ; i_pkt++)
-        {
-            if(ADK_ConvertDeviceId(userNetworkBuffer[i_pkt].eSrcDeviceId) == i_node)
-            {
-                if(FLG_seq_num_rollback_period[i_node]) //if rollback status
-                {
-                    pkt_seq_buffer[i_node][pkt_valid_index[i_node]++] = userNetworkBuffer[i_pkt].iSequenceNumber + 0x10000;
-                    temp_drvd_pkt[i_node]++;
-                }
-                else                                    //not rollback status
-                {
-                    pkt_seq_buffer[i_node][pkt_valid_index[i_node]++] = userNetworkBuffer[i_pkt].iSequenceNumber;
-                    temp_drvd_pkt[i_node]++;
-                }
-                
-            }
-        }
+        pStats = adi_wil_example_LinkStatsGetNode(i_node);
 
-        // Step 3 : SEQ_NUM into the rollback action
-        if((FLG_seq_num_rollback_period[i_node]==0) && (pkt_seq_buffer[i_node][0]>0xFFFFF000))
+        /* PDR=0, RSSI=0x80 when Node_disconnected */
+        if((pStats == NULL) || (ADK_DEMO.NODE[i_node].BMS_PKT_MAP[0] == 0))
         {
-            for(i=0; i<pkt_valid_index[i_node]; i++)
+            memset(ADK_DEMO.NODE[i_node].PDR, 0, sizeof(ADK_DEMO.NODE[i_node].PDR));
+            for(i_mngr = 0; i_mngr < ADK_MAX_mngr; i_mngr++)
             {
-                pkt_seq_buffer[i_node][i] += 0x10000;
+                ADK_DEMO.NODE[i_node].RSSI[i_mngr][0] = ADI_LINK_STATS_RSSI_NONE;
+                ADK_DEMO.NODE[i_node].RSSI[i_mngr][1] = 0;
+                ADK_DEMO.NODE[i_node].RSSI[i_mngr][2] = ADI_LINK_STATS_RSSI_NONE;
+                ADK_DEMO.NODE[i_node].RSSI[i_mngr][3] = ADI_LINK_STATS_RSSI_NONE;
             }
-            if (pkt_valid_seq[i_node])  pkt_valid_seq[i_node] += 0x10000;
-            FLG_seq_num_rollback_period[i_node]=1;
+            adi_wil_example_ADK_LinkStatsResetNode(i_node);
+            continue;
         }
 
-        // Step 4 : SEQ_NUM out from the rollback action
-        if((FLG_seq_num_rollback_period[i_node]==1) && (pkt_seq_buffer[i_node][0]>0x10100))
+        iExpected = pStats->iExpected - pdr_last_expected[i_node];
+        iReceived = pStats->iReceived - pdr_last_received[i_node];
+        if(iExpected != 0)
         {
-            for(i=0; i<pkt_valid_index[i_node]; i++)
+            ADK_DEMO.NODE[i_node].PDR[0] = ((float)iReceived) / ((float)iExpected) * 100.0f;
+            if(!pdr_interval_valid[i_node])
             {
-                pkt_seq_buffer[i_node][i] -= 0x10000;
+                ADK_DEMO.NODE[i_node].PDR[1] = 100.0f;
+                ADK_DEMO.NODE[i_node].PDR[2] = 0.0f;
+                ADK_DEMO.NODE[i_node].DUPLICATE[1] = 0;
+                pdr_interval_valid[i_node] = true;
             }
-            if (pkt_valid_seq[i_node])  pkt_valid_seq[i_node] -= 0x10000;
-            FLG_seq_num_rollback_period[i_node]=0;
-        }
+            if(ADK_DEMO.NODE[i_node].PDR[0] < ADK_DEMO.NODE[i_node].PDR[1])   ADK_DEMO.NODE[i_node].PDR[1] = ADK_DEMO.NODE[i_node].PDR[0];
+            if(ADK_DEMO.NODE[i_node].PDR[0] > ADK_DEMO.NODE[i_node].PDR[2])   ADK_DEMO.NODE[i_node].PDR[2] = ADK_DEMO.NODE[i_node].PDR[0];
+            ADK_DEMO.NODE[i_node].PDR[3] = ((float)adi_wil_example_LinkStatsGetPdr(i_node)) / 100.0f;
 
-        // Step 5 : Calculate instant start time PDR
-        if(FLG_pdr_seq_initial[i_node]==0)
-        {
-            //Current PDR calculation
-            ADK_DEMO.NODE[i_node].PDR[0] = ((float)temp_drvd_pkt[i_node]) / ((float)BMS_PACKETS_PER_INTERVAL) * 100;
-            if(ADK_DEMO.NODE[i_node].PDR[0]>100.0)  ADK_DEMO.NODE[i_node].PDR[0] = 100.0;
-            //Minimum PDR init
-            ADK_DEMO.NODE[i_node].PDR[1] = 100.0;
-            //Maximum PDR init
-            ADK_DEMO.NODE[i_node].PDR[2] = 0.0;
-            //DUP init
-            ADK_DEMO.NODE[i_node].DUPLICATE[1] = 0;
+            ADK_DEMO.NODE[i_node].DUPLICATE[0] = pStats->iDuplicates - pdr_last_duplicates[i_node];
+            if(ADK_DEMO.NODE[i_node].DUPLICATE[0] > ADK_DEMO.NODE[i_node].DUPLICATE[1]) ADK_DEMO.NODE[i_node].DUPLICATE[1] = ADK_DEMO.NODE[i_node].DUPLICATE[0];
         }
+        pdr_last_expected[i_node] = pStats->iExpected;
+        pdr_last_received[i_node] = pStats->iReceived;
+        pdr_last_duplicates[i_node] = pStats->iDuplicates;
 
-        // Step 6 : When buffer index exceeds pkt_valid_index_threshold,
-        if(pkt_valid_index[i_node]>pkt_valid_index_threshold)
-        {
-            // Step 6-1 : duplicated packet count and descending sort
-            k=pkt_valid_index[i_node];
-            for(i=0;i<(k-1);i++)
-            {
-                for(j=i+1;j<k;j++)
-                {
-                    if(pkt_seq_buffer[i_node][i]==pkt_seq_buffer[i_node][j])        //same value
-                    {
-                        // Step 6-1-a : Duplication detect
-                        if(pkt_seq_buffer[i_node][i])                               //same value && none zero
-                        {
-                            pkt_seq_buffer[i_node][j]=0;                            //delete duplicated
-                            pkt_valid_index[i_node]--;                              //declease index
-                            pdr_DUP_buffer[i_node]++;
-                        }
-                    }
-                    else if(pkt_seq_buffer[i_node][i]<pkt_seq_buffer[i_node][j])
-                    {
-                        // Step 6-1-b : Sorting
-                        temp_buffer = pkt_seq_buffer[i_node][i];
-                        pkt_seq_buffer[i_node][i] = pkt_seq_buffer[i_node][j];
-                        pkt_seq_buffer[i_node][j] = temp_buffer;
-                    }
-                }
-            }
-            
-            // Step 6-2 : Assign sequence start number
-            if(FLG_pdr_seq_initial[i_node]==0)
-            {
-                pkt_valid_seq[i_node] = pkt_seq_buffer[i_node][pkt_valid_index[i_node]-1] - 1;
-                FLG_pdr_seq_initial[i_node]=1;
-            }
-        
-            // Step 6-3 : Loop until buffer < 4 , count OK/NG cases
-            while(pkt_valid_index[i_node]>pkt_valid_index_threshold)
-            {
-                //Rollback moment
-                if((pkt_valid_seq[i_node]==0xFFFF) && (FLG_seq_num_rollback_period[i_node]==1))
-                {
-                    pkt_valid_seq[i_node]++;
-                }
-                
-                //OK case   [expected value] == [acquired smalest value]
-                if((pkt_valid_seq[i_node] + 1) == pkt_seq_buffer[i_node][pkt_valid_index[i_node]-1])
-                {
-                    pkt_seq_buffer[i_node][pkt_valid_index[i_node]-1]=0;
-                    pkt_valid_index[i_node]--;
-                    temp_PDR_OK[i_node]++;
-                    temp_PDR_TOTAL[i_node]++;
-
-                    pkt_valid_seq[i_node]++;
-                }
-
-                //Upset case    [expected value] > [acquired smallest value]    <- "NEVER happen case"
-                else if((pkt_valid_seq[i_node] + 1) > pkt_seq_buffer[i_node][pkt_valid_index[i_node]-1])
-                {
-                    pkt_seq_buffer[i_node][pkt_valid_index[i_node]-1]=0;
-                    pkt_valid_index[i_node]--;
-                    temp_PDR_TOTAL[i_node]++;
-                }
-                //NG(=packet lost) case
-                else    
-                {
-                    pkt_valid_seq[i_node]++;
-                    temp_PDR_TOTAL[i_node]++;
-                }
-            }
-            accm_PDR_OK[i_node] += temp_PDR_OK[i_node];
-            accm_PDR_TOTAL[i_node] += temp_PDR_TOTAL[i_node];
-
-            if((accm_PDR_OK[i_node]&0x8000000000000000)&&((accm_PDR_TOTAL[i_node]&0x8000000000000000)))
-            {
-                accm_PDR_OK[i_node]/=2;
-                accm_PDR_TOTAL[i_node]/=2;
-            }
-            
-            // Step 6-4 : Current PDR = OK / (OK + NG) -> Display
-            ADK_DEMO.NODE[i_node].PDR[0] = ((float)temp_PDR_OK[i_node]) / ((float)temp_PDR_TOTAL[i_node]) * 100.0;
-            ADK_DEMO.NODE[i_node].PDR[3] = ((float)accm_PDR_OK[i_node]) / ((float)accm_PDR_TOTAL[i_node]) * 100.0;
-
-            if(ADK_DEMO.NODE[i_node].PDR[0] < 10)
-            {
-                memset(pkt_seq_buffer[i_node], 0, sizeof(uint32_t) * PDR_pktbuf_depth);
-            }
-            //Minimum PDR of current PDR calculation
-            if(ADK_DEMO.NODE[i_node].PDR[0]<ADK_DEMO.NODE[i_node].PDR[1])   ADK_DEMO.NODE[i_node].PDR[1] = ADK_DEMO.NODE[i_node].PDR[0];
-            //Maximum PDR of current PDR calculation
-            if(ADK_DEMO.NODE[i_node].PDR[0]>ADK_DEMO.NODE[i_node].PDR[2])   ADK_DEMO.NODE[i_node].PDR[2] = ADK_DEMO.NODE[i_node].PDR[0];
-
-            // Step 6-5 : Current DUP -> Display
-            ADK_DEMO.NODE[i_node].DUPLICATE[0] = pdr_DUP_buffer[i_node];
-            if(ADK_DEMO.NODE[i_node].DUPLICATE[0]>ADK_DEMO.NODE[i_node].DUPLICATE[1]) ADK_DEMO.NODE[i_node].DUPLICATE[1]=ADK_DEMO.NODE[i_node].DUPLICATE[0];
-        }   
-        // Step 7 : PDR=0 when Node_disconnected
-        if(ADK_DEMO.NODE[i_node].BMS_PKT_MAP[0]==0)
+        /* RSSI : Current, Worst, Best, Average (EWMA) per manager */
+        for(i_mngr = 0; i_mngr < ADK_MAX_mngr; i_mngr++)
         {
-            ADK_DEMO.NODE[i_node].PDR[0]=0;
-            ADK_DEMO.NODE[i_node].PDR[1]=0;
-            ADK_DEMO.NODE[i_node].PDR[2]=0;
-            ADK_DEMO.NODE[i_node].PDR[3]=0;
-            FLG_pdr_seq_initial[i_node]=0;
-            memset(pkt_seq_buffer[i_node], 0, sizeof(uint32_t) * PDR_pktbuf_depth);
-            pkt_valid_index[i_node] = 0;
-        }
-    }
-}
-
-static void adi_wil_example_ADK_RSSI_calc(void){
-
-    bool FLG_rssi_initial = false;
-    uint8_t temp_cnt = 0;
-    // uint8_t temp_cnt1 = 0;
-    uint8_t temp_mngr[ADK_MAX_node * ADI_BMS_PACKETS_PER_NODE_PER_INTERVAL];
-    uint8_t temp_node[ADK_MAX_node * ADI_BMS_PACKETS_PER_NODE_PER_INTERVAL];
-    int8_t  temp_rssi[ADK_MAX_node * ADI_BMS_PACKETS_PER_NODE_PER_INTERVAL];
-
-    if(FLG_rssi_initial == false){
-        /* Step 0 : Init temp */
-        memset(&temp_mngr[temp_cnt], 0, sizeof(uint8_t) * ADK_MAX_node * ADI_BMS_PACKETS_PER_NODE_PER_INTERVAL);
-        memset(&temp_rssi[temp_cnt], 0, sizeof(uint8_t) * ADK_MAX_node * ADI_BMS_PACKETS_PER_NODE_PER_INTERVAL);
-        FLG_rssi_initial = true;
-    }
-    else{   /* This code goes after 1st entry */    }
-
-    /* Step 1 : Read data from "userNetworkBuffer" */
-    for(temp_cnt = 0; temp_cnt < NODE_NUM * ADI_BMS_PACKETS_PER_NODE_PER_INTERVAL; temp_cnt++){
-        temp_mngr[temp_cnt] = ADK_ConvertDeviceId(userNetworkBuffer[temp_cnt].eSrcManagerId);
-        temp_node[temp_cnt] = ADK_ConvertDeviceId(userNetworkBuffer[temp_cnt].eSrcDeviceId);
-        temp_rssi[temp_cnt] = userNetworkBuffer[temp_cnt].iRSSI;
-    }
-
-    /* Step 2 : Data relocation */
-    for(temp_cnt = 0; temp_cnt < NODE_NUM * ADI_BMS_PACKETS_PER_NODE_PER_INTERVAL; temp_cnt++)
-    {
-        if(temp_mngr[temp_cnt] == 240){                 /* ADI_WIL_DEV_MANAGER_0 */
-            //adi_wil_example_ADK_RSSI_save(temp_node[temp_cnt], ADI_WIL_DEV_MANAGER_0, temp_rssi[temp_cnt]);
-            ADK_DEMO.NODE[temp_node[temp_cnt]].RSSI[0][0] = temp_rssi[temp_cnt];
-            temp_rssi_rx[temp_node[temp_cnt]][0] += temp_rssi[temp_cnt];
-            if(temp_count[temp_node[temp_cnt]][0] != 0)
-            {
-                if(ADK_DEMO.NODE[temp_node[temp_cnt]].RSSI[0][1] > temp_rssi[temp_cnt])
-                {
-                    ADK_DEMO.NODE[temp_node[temp_cnt]].RSSI[0][1] = temp_rssi[temp_cnt];
-                }
-                if(ADK_DEMO.NODE[temp_node[temp_cnt]].RSSI[0][2] < temp_rssi[temp_cnt])
-                {
-                    ADK_DEMO.NODE[temp_node[temp_cnt]].RSSI[0][2] = temp_rssi[temp_cnt];
-                }
-            }
-            else if (temp_count[temp_node[temp_cnt]][0] == 0)
-            {
-                ADK_DEMO.NODE[temp_node[temp_cnt]].RSSI[0][2] = temp_rssi[temp_cnt];
-            }
-            temp_count[temp_node[temp_cnt]][0]++;
-            ADK_DEMO.NODE[temp_node[temp_cnt]].RSSI[0][3] = (int8_t)(temp_rssi_rx[temp_node[temp_cnt]][0] / temp_count[temp_node[temp_cnt]][0]);
-        }
-        else if(temp_mngr[temp_cnt] == 241) {           /* ADI_WIL_DEV_MANAGER_1 */
-            //adi_wil_example_ADK_RSSI_save(temp_node[temp_cnt], ADI_WIL_DEV_MANAGER_1, temp_rssi[temp_cnt]);
-            ADK_DEMO.NODE[temp_node[temp_cnt]].RSSI[1][0] = temp_rssi[temp_cnt];
-            temp_rssi_rx[temp_node[temp_cnt]][1] += temp_rssi[temp_cnt];
-            if(temp_count[temp_node[temp_cnt]][1] != 0)
-            {
-                if(ADK_DEMO.NODE[temp_node[temp_cnt]].RSSI[1][1] > temp_rssi[temp_cnt])
-                {
-                    ADK_DEMO.NODE[temp_node[temp_cnt]].RSSI[1][1] = temp_rssi[temp_cnt];
-                }
-                if(ADK_DEMO.NODE[temp_node[temp_cnt]].RSSI[1][2] < temp_rssi[temp_cnt])
-                {
-                    ADK_DEMO.NODE[temp_node[temp_cnt]].RSSI[1][2] = temp_rssi[temp_cnt];
-                }
-            }
-            else if (temp_count[temp_node[temp_cnt]][1] == 0)
+            if(pStats->Path[i_mngr].iPackets != 0)
             {
-                ADK_DEMO.NODE[temp_node[temp_cnt]].RSSI[1][2] = temp_rssi[temp_cnt];
+                ADK_DEMO.NODE[i_node].RSSI[i_mngr][0] = pStats->Path[i_mngr].iRssiLast;
+                ADK_DEMO.NODE[i_node].RSSI[i_mngr][1] = pStats->Path[i_mngr].iRssiMin;
+                ADK_DEMO.NODE[i_node].RSSI[i_mngr][2] = pStats->Path[i_mngr].iRssiMax;
+                ADK_DEMO.NODE[i_node].RSSI[i_mngr][3] = (int8_t)(pStats->Path[i_mngr].iRssiEwma / 256);
             }
-            temp_count[temp_node[temp_cnt]][1]++;
-            ADK_DEMO.NODE[temp_node[temp_cnt]].RSSI[1][3] = (int8_t)(temp_rssi_rx[temp_node[temp_cnt]][1] / temp_count[temp_node[temp_cnt]][1]);
-        }
-        else{/* DO NOTHING */}
-    }
-
-    for(temp_cnt = 0; temp_cnt < NODE_NUM ; temp_cnt++)
-    {
-        //RSSI=0 when Node_disconnected
-        if(ADK_DEMO.NODE[temp_cnt].BMS_PKT_MAP[0]==0)
-        {
-            ADK_DEMO.NODE[temp_cnt].RSSI[0][0]=0x80;
-            ADK_DEMO.NODE[temp_cnt].RSSI[0][1]=0;
-            ADK_DEMO.NODE[temp_cnt].RSSI[0][2]=0x80;
-            ADK_DEMO.NODE[temp_cnt].RSSI[0][3]=0x80;
-
-            ADK_DEMO.NODE[temp_cnt].RSSI[1][0]=0x80;
-            ADK_DEMO.NODE[temp_cnt].RSSI[1][1]=0;
-            ADK_DEMO.NODE[temp_cnt].RSSI[1][2]=0x80;
-            ADK_DEMO.NODE[temp_cnt].RSSI[1][3]=0x80;
         }
     }
 }
@@ -2034,8 +2048,11 @@ void adi_wil_HandleCallback (adi_wil_pack_t const * const pPack,
             if ( (rc == ADI_WIL_ERR_IN_PROGRESS) || (rc == ADI_WIL_ERR_SUCCESS) )
             {
                 (void)memcpy(&getFileInformation, pData, sizeof(getFileInformation));
-                (void)memcpy(&userGetFileContainer[getfile_index], getFileInformation.pData, getFileInformation.iByteCount);
-                getfile_index += getFileInformation.iByteCount;
+                /* Place each block at its offset, blocks of streamed transfers are not serialised by the application */
+                if (((uint32_t)getFileInformation.iOffset + getFileInformation.iByteCount) <= GET_FILE_BUFFER_COUNT)
+                {
+                    (void)memcpy(&userGetFileContainer[getFileInformation.iOffset], getFileInformation.pData, getFileInformation.iByteCount);
+                }
             }
         }
         #endif
@@ -2062,6 +2079,7 @@ void adi_wil_HandleCallback (adi_wil_pack_t const * const pPack,
         else if (eAPI == ADI_WIL_API_GET_ACL)
         {
             (void)memcpy(&systemAcl, pData, sizeof(adi_wil_acl_t));
+            adi_wil_example_DeviceDirUpdate(&systemAcl);
         }
         else if (eAPI == ADI_WIL_API_CONNECT)
         {
@@ -2072,6 +2090,12 @@ void adi_wil_HandleCallback (adi_wil_pack_t const * const pPack,
             }
         }
     }
+    if ((eAPI == ADI_WIL_API_GET_DEVICE_VERSION) || (eAPI == ADI_WIL_API_GET_FILE_CRC) ||
+        (eAPI == ADI_WIL_API_GET_GPIO) || (eAPI == ADI_WIL_API_GET_CONTEXTUAL_DATA) ||
+        (eAPI == ADI_WIL_API_GET_FILE))
+    {
+        adi_wil_example_HandleConcurrentCallback(pPack, eAPI, rc, pData);
+    }
     gNotifRc = rc;
 }
 #endif
@@ -2154,15 +2178,63 @@ void adi_wil_example_readInitPacket(void)
 
 #ifdef _ADI_ONLY
 /******************************************************************************
- * Event notification callback
+ * Event handlers, registered with the event bus by
+ * adi_wil_example_RegisterEventHandlers()
  *****************************************************************************/
-void adi_wil_HandleEvent (adi_wil_pack_t const * const pPack,
-                          void const * const pClientData,
-                          adi_wil_event_id_t EventCode,
-                          void const * const pData)
+static bool adi_wil_example_RegisterHandler(adi_wil_event_id_t eEvent, adi_event_handler_t pfHandler, const char *pName, uint8_t iPriority, adi_event_exec_t eExec);
+static void adi_wil_example_EventMgrConnected(adi_wil_pack_t const *pPack, adi_wil_event_id_t eEvent, void const *pData);
+static void adi_wil_example_EventMgrDisconnected(adi_wil_pack_t const *pPack, adi_wil_event_id_t eEvent, void const *pData);
+static void adi_wil_example_EventPms(adi_wil_pack_t const *pPack, adi_wil_event_id_t eEvent, void const *pData);
+static void adi_wil_example_EventBms(adi_wil_pack_t const *pPack, adi_wil_event_id_t eEvent, void const *pData);
+static void adi_wil_example_EventEms(adi_wil_pack_t const *pPack, adi_wil_event_id_t eEvent, void const *pData);
+static void adi_wil_example_EventNodeConnected(adi_wil_pack_t const *pPack, adi_wil_event_id_t eEvent, void const *pData);
+static void adi_wil_example_EventNodeDisconnected(adi_wil_pack_t const *pPack, adi_wil_event_id_t eEvent, void const *pData);
+static void adi_wil_example_EventMgrToMgrError(adi_wil_pack_t const *pPack, adi_wil_event_id_t eEvent, void const *pData);
+static void adi_wil_example_EventQueueOverflow(adi_wil_pack_t const *pPack, adi_wil_event_id_t eEvent, void const *pData);
+static void adi_wil_example_EventHealthReport(adi_wil_pack_t const *pPack, adi_wil_event_id_t eEvent, void const *pData);
+static void adi_wil_example_EventNetworkData(adi_wil_pack_t const *pPack, adi_wil_event_id_t eEvent, void const *pData);
+static void adi_wil_example_EventFaultSources(adi_wil_pack_t const *pPack, adi_wil_event_id_t eEvent, void const *pData);
+static void adi_wil_example_EventFaultReport(adi_wil_pack_t const *pPack, adi_wil_event_id_t eEvent, void const *pData);
+static void adi_wil_example_EventSecurity(adi_wil_pack_t const *pPack, adi_wil_event_id_t eEvent, void const *pData);
+static void adi_wil_example_EventXferDeviceRemoved(adi_wil_pack_t const *pPack, adi_wil_event_id_t eEvent, void const *pData);
+static void adi_wil_example_HrStoreAlert(uint8_t iNodeIndex, adi_hr_metric_t eMetric, adi_hr_alert_t eAlert, adi_hr_trend_t const *pTrend);
+static void adi_wil_example_EventBmsDecode(adi_wil_pack_t const *pPack, adi_wil_event_id_t eEvent, void const *pData);
+
+/* ADI_WIL_EVENT_COMM_MGR_CONNECTED */
+static void adi_wil_example_EventMgrConnected(adi_wil_pack_t const *pPack, adi_wil_event_id_t eEvent, void const *pData)
+{
+    iMgrConnectCount++;
+}
+
+/* ADI_WIL_EVENT_COMM_MGR_DISCONNECTED */
+static void adi_wil_example_EventMgrDisconnected(adi_wil_pack_t const *pPack, adi_wil_event_id_t eEvent, void const *pData)
+{
+    iMgrDisconnectCount++;
+}
+
+/* ADI_WIL_EVENT_DATA_READY_PMS */
+static void adi_wil_example_EventPms(adi_wil_pack_t const *pPack, adi_wil_event_id_t eEvent, void const *pData)
 {
     uint16_t iCount;
-    uint8_t HR_index=0;
+
+    /* Handle PMS data here in the event CB from pData */
+    /* The application should signal here to let the PMS data processing routine know that there is new PMS data. */
+    iPMSNotificationCount++;
+    /* If somehow WIL passes more sensor data packets than example code can store, store as much data as fits. */
+    iCount = ((adi_wil_sensor_data_buffer_t *)pData)->iCount;
+    if (iCount > PMS_DATA_PACKET_COUNT)
+    {
+        iCount = PMS_DATA_PACKET_COUNT;
+    }
+    /* copy the PMS data out here in the event CB from pData */
+    memcpy(userPMSBuffer, ((adi_wil_sensor_data_buffer_t *)pData)->pData, iCount*(sizeof(adi_wil_sensor_data_t)));
+    iUserPMSPacketCount = (uint16_t)iCount;
+    adi_gNotifyPms = true;
+}
+
+/* ADI_WIL_EVENT_DATA_READY_BMS */
+static void adi_wil_example_EventBms(adi_wil_pack_t const *pPack, adi_wil_event_id_t eEvent, void const *pData)
+{
     #if     (ADK_ADBMS683x == 0) /* ADBMS6830 */
     #elif   (ADK_ADBMS683x == 3) /* ADBMS6833 */
     bool bLatent0 = false;
@@ -2171,467 +2243,562 @@ void adi_wil_HandleEvent (adi_wil_pack_t const * const pPack,
     #else
     #endif
 
-    /* For readability, cast the void pointer to app's client data type */
-    client_data_t * appClientData = (client_data_t *)pClientData;
-
-    if (appClientData->eEventWaitingFor == EventCode)
-    {
-        appClientData->iEventWaitingForCount++;
-    }
-    else
-    {
-        /* code flow should never enter here */
-    }
-
-    switch (EventCode)
-    {
-        case ADI_WIL_EVENT_COMM_MGR_CONNECTED:
-            iMgrConnectCount++;
-            break;
-
-        case ADI_WIL_EVENT_COMM_MGR_DISCONNECTED:
-            iMgrDisconnectCount++;
-            break;
+    iBMSNotificationCount++;
+    /* copy the BMS data out here in the event CB from pData */
+    memcpy(userBMSBuffer, ((adi_wil_sensor_data_buffer_t *)pData)->pData, (((adi_wil_sensor_data_buffer_t *)pData)->iCount)*(sizeof(adi_wil_sensor_data_t)));
+    /* The application should signal here to let the BMS data processing thread know that there is new BMS data. */
+    adi_gNotifyBms = true;
+    adi_gNotifyBmsData = true;
+    nTotalPcktsRcvd = ((adi_wil_sensor_data_buffer_t *)pData)->iCount;  /*  @remark Akash : Variable to store total no. of bms packets received */
+#if (ADI_W2CAN_ENABLE == 1)
+    adi_w2can_NotifyBmsData(userBMSBuffer, nTotalPcktsRcvd);
+#endif
 
-        case ADI_WIL_EVENT_DATA_READY_PMS:
-            /* Handle PMS data here in the event CB from pData */
-            /* The application should signal here to let the PMS data processing routine know that there is new PMS data. */
-            iPMSNotificationCount++;
-            /* If somehow WIL passes more sensor data packets than example code can store, store as much data as fits. */
-            iCount = ((adi_wil_sensor_data_buffer_t *)pData)->iCount;
-            if (iCount > PMS_DATA_PACKET_COUNT)
-            {
-                iCount = PMS_DATA_PACKET_COUNT;
-            }
-            /* copy the PMS data out here in the event CB from pData */
-            memcpy(userPMSBuffer, ((adi_wil_sensor_data_buffer_t *)pData)->pData, iCount*(sizeof(adi_wil_sensor_data_t)));
-            adi_gNotifyPms = true;
-            break;
+    /* @remark  : check BASE packet header */
+    for(EventCallback_pkt_count = 0; EventCallback_pkt_count < nTotalPcktsRcvd; EventCallback_pkt_count++){
+        #if     (ADK_ADBMS683x == 0) /* ADBMS6830 */
+        #elif   (ADK_ADBMS683x == 3) /* ADBMS6833 */
+        BMS_eNode = ADK_ConvertDeviceId(userBMSBuffer[EventCallback_pkt_count].eDeviceId);
+        if (userBMSBuffer[EventCallback_pkt_count].Data[0] == ADI_BMS_LATENT0_PKT_0_ID){
+            bLatent0 = true;
+            latent0_recv_confirm[BMS_eNode] |= 0x01;
+            memcpy(&Latency0_Packet_0, (adi_bms_latent0_pkt_0_t*)userBMSBuffer[EventCallback_pkt_count].Data, sizeof(adi_bms_packetheader_t));
+            memcpy(&Latency0_Packet_0.Rdstatc, (adi_bms_latent0_pkt_0_t*)&userBMSBuffer[EventCallback_pkt_count].Data[sizeof(adi_bms_packetheader_t)], sizeof(adi_bms_latent0_pkt_0_t) - 8);
+        }
+        else if (userBMSBuffer[EventCallback_pkt_count].Data[0] == ADI_BMS_LATENT0_PKT_1_ID){
+            bLatent0 = true;
+            latent0_recv_confirm[BMS_eNode] |= 0x02;
+            memcpy(&Latency0_Packet_1, (adi_bms_latent0_pkt_1_t*)userBMSBuffer[EventCallback_pkt_count].Data, sizeof(adi_bms_packetheader_t));
+            memcpy(&Latency0_Packet_1.Rdpwma_2, (adi_bms_latent0_pkt_1_t*)&userBMSBuffer[EventCallback_pkt_count].Data[sizeof(adi_bms_packetheader_t)], sizeof(adi_bms_latent0_pkt_1_t) - 8);
+        }
+        else if (userBMSBuffer[EventCallback_pkt_count].Data[0] == ADI_BMS_LATENT0_PKT_2_ID){
+            bLatent0 = true;
+            latent0_recv_confirm[BMS_eNode] |= 0x04;
+            memcpy(&Latency0_Packet_2, (adi_bms_latent0_pkt_2_t*)userBMSBuffer[EventCallback_pkt_count].Data, sizeof(adi_bms_packetheader_t));
+            memcpy(&Latency0_Packet_2.Rdace, (adi_bms_latent0_pkt_2_t*)&userBMSBuffer[EventCallback_pkt_count].Data[sizeof(adi_bms_packetheader_t)], sizeof(adi_bms_latent0_pkt_2_t) - 8);
+        }
+        else if (userBMSBuffer[EventCallback_pkt_count].Data[0] == ADI_BMS_LATENT1_PKT_0_ID){
+            bLatent1 = true;
+            latent1_recv_confirm[BMS_eNode] |= 0x01;
+            memcpy(&Latency1_Packet_0, (adi_bms_latent1_pkt_0_t*)userBMSBuffer[EventCallback_pkt_count].Data, sizeof(adi_bms_packetheader_t));
+            memcpy(&Latency1_Packet_0.Rdaca, (adi_bms_latent1_pkt_0_t*)&userBMSBuffer[EventCallback_pkt_count].Data[sizeof(adi_bms_packetheader_t)], sizeof(adi_bms_latent1_pkt_0_t) - 8);
+        }
+        else if (userBMSBuffer[EventCallback_pkt_count].Data[0] == ADI_BMS_LATENT1_PKT_1_ID){
+            bLatent1 = true;
+            latent1_recv_confirm[BMS_eNode] |= 0x02;
+            memcpy(&Latency1_Packet_1, (adi_bms_latent1_pkt_1_t*)userBMSBuffer[EventCallback_pkt_count].Data, sizeof(adi_bms_packetheader_t));
+            memcpy(&Latency1_Packet_1.Rdsvd, (adi_bms_latent1_pkt_1_t*)&userBMSBuffer[EventCallback_pkt_count].Data[sizeof(adi_bms_packetheader_t)], sizeof(adi_bms_latent1_pkt_1_t) - 8);
+        }
+        #else   /* Not supported */
+        #endif
 
-        case ADI_WIL_EVENT_DATA_READY_BMS:
-            iBMSNotificationCount++;
-            /* copy the BMS data out here in the event CB from pData */
-            memcpy(userBMSBuffer, ((adi_wil_sensor_data_buffer_t *)pData)->pData, (((adi_wil_sensor_data_buffer_t *)pData)->iCount)*(sizeof(adi_wil_sensor_data_t)));
-            /* The application should signal here to let the BMS data processing thread know that there is new BMS data. */
-            adi_gNotifyBms = true;
-            adi_gNotifyBmsData = true;
-            /* @remark : Read BMS data */
-            adi_wil_example_ADK_ExecuteProcessBMSBuffer();
-            nTotalPcktsRcvd = ((adi_wil_sensor_data_buffer_t *)pData)->iCount;  /*  @remark Akash : Variable to store total no. of bms packets received */
-
-            /* @remark  : check BASE packet header */
-            for(EventCallback_pkt_count = 0; EventCallback_pkt_count < nTotalPcktsRcvd; EventCallback_pkt_count++){
-                #if     (ADK_ADBMS683x == 0) /* ADBMS6830 */
-                #elif   (ADK_ADBMS683x == 3) /* ADBMS6833 */
-                BMS_eNode = ADK_ConvertDeviceId(userBMSBuffer[EventCallback_pkt_count].eDeviceId);
-                if (userBMSBuffer[EventCallback_pkt_count].Data[0] == ADI_BMS_LATENT0_PKT_0_ID){
-                    bLatent0 = true;
-                    latent0_recv_confirm[BMS_eNode] |= 0x01;
-                    memcpy(&Latency0_Packet_0, (adi_bms_latent0_pkt_0_t*)userBMSBuffer[EventCallback_pkt_count].Data, sizeof(adi_bms_packetheader_t));
-                    memcpy(&Latency0_Packet_0.Rdstatc, (adi_bms_latent0_pkt_0_t*)&userBMSBuffer[EventCallback_pkt_count].Data[sizeof(adi_bms_packetheader_t)], sizeof(adi_bms_latent0_pkt_0_t) - 8);
-                }
-                else if (userBMSBuffer[EventCallback_pkt_count].Data[0] == ADI_BMS_LATENT0_PKT_1_ID){
-                    bLatent0 = true;
-                    latent0_recv_confirm[BMS_eNode] |= 0x02;
-                    memcpy(&Latency0_Packet_1, (adi_bms_latent0_pkt_1_t*)userBMSBuffer[EventCallback_pkt_count].Data, sizeof(adi_bms_packetheader_t));
-                    memcpy(&Latency0_Packet_1.Rdpwma_2, (adi_bms_latent0_pkt_1_t*)&userBMSBuffer[EventCallback_pkt_count].Data[sizeof(adi_bms_packetheader_t)], sizeof(adi_bms_latent0_pkt_1_t) - 8);
-                }
-                else if (userBMSBuffer[EventCallback_pkt_count].Data[0] == ADI_BMS_LATENT0_PKT_2_ID){
-                    bLatent0 = true;
-                    latent0_recv_confirm[BMS_eNode] |= 0x04;
-                    memcpy(&Latency0_Packet_2, (adi_bms_latent0_pkt_2_t*)userBMSBuffer[EventCallback_pkt_count].Data, sizeof(adi_bms_packetheader_t));
-                    memcpy(&Latency0_Packet_2.Rdace, (adi_bms_latent0_pkt_2_t*)&userBMSBuffer[EventCallback_pkt_count].Data[sizeof(adi_bms_packetheader_t)], sizeof(adi_bms_latent0_pkt_2_t) - 8);
-                }
-                else if (userBMSBuffer[EventCallback_pkt_count].Data[0] == ADI_BMS_LATENT1_PKT_0_ID){
-                    bLatent1 = true;
-                    latent1_recv_confirm[BMS_eNode] |= 0x01;
-                    memcpy(&Latency1_Packet_0, (adi_bms_latent1_pkt_0_t*)userBMSBuffer[EventCallback_pkt_count].Data, sizeof(adi_bms_packetheader_t));
-                    memcpy(&Latency1_Packet_0.Rdaca, (adi_bms_latent1_pkt_0_t*)&userBMSBuffer[EventCallback_pkt_count].Data[sizeof(adi_bms_packetheader_t)], sizeof(adi_bms_latent1_pkt_0_t) - 8);
-                }
-                else if (userBMSBuffer[EventCallback_pkt_count].Data[0] == ADI_BMS_LATENT1_PKT_1_ID){
-                    bLatent1 = true;
-                    latent1_recv_confirm[BMS_eNode] |= 0x02;
-                    memcpy(&Latency1_Packet_1, (adi_bms_latent1_pkt_1_t*)userBMSBuffer[EventCallback_pkt_count].Data, sizeof(adi_bms_packetheader_t));
-                    memcpy(&Latency1_Packet_1.Rdsvd, (adi_bms_latent1_pkt_1_t*)&userBMSBuffer[EventCallback_pkt_count].Data[sizeof(adi_bms_packetheader_t)], sizeof(adi_bms_latent1_pkt_1_t) - 8);
-                }
-                #else   /* Not supported */
-                #endif
+        /* capture Init script data */
+        #ifdef DBG_INIT_SCRIPT_TEST
+        if(userBMSBuffer[EventCallback_pkt_count].iLength == 0)
+        {
+            iLostPacketCnt++;
+        }
+        else if((userBMSBuffer[EventCallback_pkt_count].Data[0] == ADI_BMS_INIT_PKT_0_ID) && (iInitBuffer0index < userAcl.iCount))
+        {
+            iBMSNotificationCount = 0; // Adele: to init BMS_PKT_MAP [1]
+            memcpy(&initBuffer0[iInitBuffer0index++], &userBMSBuffer[EventCallback_pkt_count].Data, userBMSBuffer[EventCallback_pkt_count].iLength);
+            adi_wil_example_readInitPacket();
+            if (!bFirstBMSdata)  adk_debug_BootTimeLog(Overall_, LogEnd__, 730, Demo_key_on_event_____________________);
+            bFirstBMSdata=true;
+        }
+        else if((userBMSBuffer[EventCallback_pkt_count].Data[0] == ADI_BMS_INIT_PKT_1_ID) && (iInitBuffer1index < ADK_MAX_node))
+        {
+            memcpy(&initBuffer1[iInitBuffer1index++], &userBMSBuffer[EventCallback_pkt_count].Data, userBMSBuffer[EventCallback_pkt_count].iLength);
+            if (!bFirstBMSdata)  adk_debug_BootTimeLog(Overall_, LogEnd__, 730, Demo_key_on_event_____________________);
+            bFirstBMSdata=true;
+        }
+        else if((userBMSBuffer[EventCallback_pkt_count].Data[0] == ADI_BMS_INIT_PKT_2_ID) && (iInitBuffer2index < ADK_MAX_node))
+        {
+            memcpy(&initBuffer2[iInitBuffer2index++], &userBMSBuffer[EventCallback_pkt_count].Data, userBMSBuffer[EventCallback_pkt_count].iLength);
+            if (!bFirstBMSdata)  adk_debug_BootTimeLog(Overall_, LogEnd__, 730, Demo_key_on_event_____________________);
+            bFirstBMSdata=true;
+        }
+        #endif
+        if(userBMSBuffer[EventCallback_pkt_count].Data[0] == ADI_BMS_BASE_PKT_0_ID || userBMSBuffer[EventCallback_pkt_count].Data[0] == ADI_BMS_BASE_PKT_1_ID || userBMSBuffer[EventCallback_pkt_count].Data[0] == ADI_BMS_BASE_PKT_2_ID){
+               BASE_PACKET_RECEIVED = true;
+               if (!bFirstBMSdata)  adk_debug_BootTimeLog(Overall_, LogEnd__, 730, Demo_key_on_event_____________________);
+               bFirstBMSdata=true;
+               break;
+           }
+        else{
+            BASE_PACKET_RECEIVED = false;
+        }
+    }
 
-                /* capture Init script data */
-                #ifdef DBG_INIT_SCRIPT_TEST
-                if(userBMSBuffer[EventCallback_pkt_count].iLength == 0)
-                {
-                    iLostPacketCnt++;
-                }
-                else if((userBMSBuffer[EventCallback_pkt_count].Data[0] == ADI_BMS_INIT_PKT_0_ID) && (iInitBuffer0index < userAcl.iCount))
-                {
-                    iBMSNotificationCount = 0; // Adele: to init BMS_PKT_MAP [1]
-                    memcpy(&initBuffer0[iInitBuffer0index++], &userBMSBuffer[EventCallback_pkt_count].Data, userBMSBuffer[EventCallback_pkt_count].iLength);
-                    adi_wil_example_readInitPacket();
-                    if (!bFirstBMSdata)  adk_debug_BootTimeLog(Overall_, LogEnd__, 730, Demo_key_on_event_____________________);
-                    bFirstBMSdata=true;
-                }
-                else if((userBMSBuffer[EventCallback_pkt_count].Data[0] == ADI_BMS_INIT_PKT_1_ID) && (iInitBuffer1index < ADK_MAX_node))
-                {
-                    memcpy(&initBuffer1[iInitBuffer1index++], &userBMSBuffer[EventCallback_pkt_count].Data, userBMSBuffer[EventCallback_pkt_count].iLength);
-                    if (!bFirstBMSdata)  adk_debug_BootTimeLog(Overall_, LogEnd__, 730, Demo_key_on_event_____________________);
-                    bFirstBMSdata=true;
-                }
-                else if((userBMSBuffer[EventCallback_pkt_count].Data[0] == ADI_BMS_INIT_PKT_2_ID) && (iInitBuffer2index < ADK_MAX_node))
-                {
-                    memcpy(&initBuffer2[iInitBuffer2index++], &userBMSBuffer[EventCallback_pkt_count].Data, userBMSBuffer[EventCallback_pkt_count].iLength);
-                    if (!bFirstBMSdata)  adk_debug_BootTimeLog(Overall_, LogEnd__, 730, Demo_key_on_event_____________________);
-                    bFirstBMSdata=true;
-                }
-                #endif
-                if(userBMSBuffer[EventCallback_pkt_count].Data[0] == ADI_BMS_BASE_PKT_0_ID || userBMSBuffer[EventCallback_pkt_count].Data[0] == ADI_BMS_BASE_PKT_1_ID || userBMSBuffer[EventCallback_pkt_count].Data[0] == ADI_BMS_BASE_PKT_2_ID){
-                       BASE_PACKET_RECEIVED = true;
-                       if (!bFirstBMSdata)  adk_debug_BootTimeLog(Overall_, LogEnd__, 730, Demo_key_on_event_____________________);
-                       bFirstBMSdata=true;
-                       break;
-                   }
-                else{
-                    BASE_PACKET_RECEIVED = false;
-                }
-            }
-            
-            #if     (ADK_ADBMS683x == 0) /* ADBMS6830 */
-            #elif   (ADK_ADBMS683x == 3) /* ADBMS6833 */
-            for(EventCallback_pkt_count = 0; EventCallback_pkt_count < NODE_NUM; EventCallback_pkt_count++)
-            {
-                if(latent0_recv_confirm[EventCallback_pkt_count] != 0x07)
-                {
-                    bLatent0 = false;
-                }
-                if(latent1_recv_confirm[EventCallback_pkt_count] != 0x03)
-                {
-                    bLatent1 = false;
-                }
-            }
-            if(bLatent0)
-            {
-                adi_gNotifyLatent0 = true;
-            }
-            if(bLatent1)
-            {
-                adi_gNotifyLatent1 = true;
-            }
-            #else   /* Not supported */
-            #endif
+    #if     (ADK_ADBMS683x == 0) /* ADBMS6830 */
+    #elif   (ADK_ADBMS683x == 3) /* ADBMS6833 */
+    for(EventCallback_pkt_count = 0; EventCallback_pkt_count < NODE_NUM; EventCallback_pkt_count++)
+    {
+        if(latent0_recv_confirm[EventCallback_pkt_count] != 0x07)
+        {
+            bLatent0 = false;
+        }
+        if(latent1_recv_confirm[EventCallback_pkt_count] != 0x03)
+        {
+            bLatent1 = false;
+        }
+    }
+    if(bLatent0)
+    {
+        adi_gNotifyLatent0 = true;
+    }
+    if(bLatent1)
+    {
+        adi_gNotifyLatent1 = true;
+    }
+    #else   /* Not supported */
+    #endif
+}
 
-            break;
+/* ADI_WIL_EVENT_DATA_READY_BMS, after adi_wil_example_EventBms has copied the packets out */
+static void adi_wil_example_EventBmsDecode(adi_wil_pack_t const *pPack, adi_wil_event_id_t eEvent, void const *pData)
+{
+    /* @remark : Read BMS data */
+    adi_wil_example_ADK_ExecuteProcessBMSBuffer();
+}
 
-        case ADI_WIL_EVENT_DATA_READY_EMS:
-            iEMSNotificationCount++;
-            /* copy the EMS data out here in the event CB from pData */
-            memcpy(userEMSBuffer, ((adi_wil_sensor_data_buffer_t *)pData)->pData, (((adi_wil_sensor_data_buffer_t *)pData)->iCount)*(sizeof(adi_wil_sensor_data_t)));
-            /* The application should signal here to let the BMS data processing thread know that there is new BMS data. */
-            adi_gNotifyEms = true;
-            break;
+/* ADI_WIL_EVENT_DATA_READY_EMS */
+static void adi_wil_example_EventEms(adi_wil_pack_t const *pPack, adi_wil_event_id_t eEvent, void const *pData)
+{
+    iEMSNotificationCount++;
+    /* copy the EMS data out here in the event CB from pData */
+    memcpy(userEMSBuffer, ((adi_wil_sensor_data_buffer_t *)pData)->pData, (((adi_wil_sensor_data_buffer_t *)pData)->iCount)*(sizeof(adi_wil_sensor_data_t)));
+    /* The application should signal here to let the BMS data processing thread know that there is new BMS data. */
+    adi_gNotifyEms = true;
+}
 
-        case ADI_WIL_EVENT_COMM_NODE_CONNECTED:
-            /* A node joined the WBMS network. Connected node device ID (adi_wil_device_t) is returned  */
-            /* Counter to track connected nodes in the network */
-            iNodeConnectedCount++;
-            iDisconn_node[ADK_ConvertDeviceId(*((uint8_t*)pData))] = false;
-            break;
+/* ADI_WIL_EVENT_COMM_NODE_CONNECTED */
+static void adi_wil_example_EventNodeConnected(adi_wil_pack_t const *pPack, adi_wil_event_id_t eEvent, void const *pData)
+{
+    /* A node joined the WBMS network. Connected node device ID (adi_wil_device_t) is returned  */
+    /* Counter to track connected nodes in the network */
+    iNodeConnectedCount++;
+    uint8_t Node_index = ADK_ConvertDeviceId(*((adi_wil_device_t const *)pData));
+    iDisconn_node[Node_index] = false;
+    /* The node may have reset while away, its script registers are written again */
+    adi_wil_example_ScriptCacheInvalidate(Node_index);
+}
 
-        case ADI_WIL_EVENT_COMM_NODE_DISCONNECTED:
-            /* A node dropped from the WBMS network. Disconnected node device ID (adi_wil_device_t) is returned */
-            /* Counter to track disconnected nodes in the network */
-            iNodeDisconnectedCount++;
-            uint8_t Node_index = ADK_ConvertDeviceId(*((uint8_t*)pData));
-            iDisconn_node[Node_index] = true;
-            ADK_DEMO.NODE[Node_index].BMS_PKT_MAP[0] = 0;
-            for(uint8_t i = 0; i < 4; i++)
-            {
-                ADK_DEMO.NODE[Node_index].PDR[i]=0;
-            }
-            FLG_pdr_seq_initial[Node_index]=0;
-            pkt_valid_index[Node_index] = 0;
-            accm_PDR_OK[Node_index] = 0;
-            accm_PDR_TOTAL[Node_index] = 0;
-            memset(pkt_seq_buffer[Node_index], 0, sizeof(uint32_t) * PDR_pktbuf_depth);
-            break;
+/* ADI_WIL_EVENT_COMM_NODE_DISCONNECTED */
+static void adi_wil_example_EventNodeDisconnected(adi_wil_pack_t const *pPack, adi_wil_event_id_t eEvent, void const *pData)
+{
+    /* A node dropped from the WBMS network. Disconnected node device ID (adi_wil_device_t) is returned */
+    /* Counter to track disconnected nodes in the network */
+    iNodeDisconnectedCount++;
+    uint8_t Node_index = ADK_ConvertDeviceId(*((adi_wil_device_t const *)pData));
+    iDisconn_node[Node_index] = true;
+    adi_wil_example_ScriptCacheInvalidate(Node_index);
+    ADK_DEMO.NODE[Node_index].BMS_PKT_MAP[0] = 0;
+    for(uint8_t i = 0; i < 4; i++)
+    {
+        ADK_DEMO.NODE[Node_index].PDR[i]=0;
+    }
+    adi_wil_example_ADK_LinkStatsResetNode(Node_index);
+}
 
-        case ADI_WIL_EVENT_COMM_MGR_TO_MGR_ERROR:
-            /* Communication between the two network managers failed (dual manager mode only), no data is returned */
-            /* Counter to track MGR to MGR errors */
-            iMgrToMgrErrCount++;
-            break;
-        
-        case ADI_WIL_EVENT_MGR_QUEUE_OVERFLOW:
-            /* Event used to identified SPI transmission queue issues in the managers */
-            iQueueOverflowNotificationCount++;
-            break;
-        
-        case ADI_WIL_EVENT_DATA_READY_HEALTH_REPORT:
-            /* copy the HR data out here in the event CB from pData */
-            if (((adi_wil_health_report_t *)pData)->Data[0] == PACKET_ID_NODE_DEVICE)
-            {
-                /* HR Data Packet1 : contains signal rssi, reset counter
-                twohop counter, join attempts etc */
-                memcpy(&userHR0Buffer[ADK_ConvertDeviceId(((adi_wil_health_report_t *)pData)->eDeviceId)], 
-                       &((adi_wil_health_report_t*)pData)->Data[0], 
-                       sizeof(adi_wil_health_report0_t));
-                // adi_w2can_NotifyHR_availability();   /* @remark: Not used this time */
-            }
-            else if (((adi_wil_health_report_t *)pData)->Data[0] == PACKET_ID_NODE_AVERAGE_RSSI)
-            {
-                /* HR Data Packet2 : contains node average rssi */
-                memcpy(&userHR1Buffer[ADK_ConvertDeviceId(((adi_wil_health_report_t *)pData)->eDeviceId)], 
-                       &((adi_wil_health_report_t*)pData)->Data[0], 
-                       sizeof(adi_wil_health_report1_t));
-            }
-            else if (((adi_wil_health_report_t *)pData)->Data[0] == PACKET_ID_NODE_BACKGROUND_RSSI)
-            {
-                /* HR Data Packet2 : contains background rssi */
-                memcpy(&userHR2Buffer[ADK_ConvertDeviceId(((adi_wil_health_report_t *)pData)->eDeviceId)], 
-                       &((adi_wil_health_report_t*)pData)->Data[0], 
-                       sizeof(adi_wil_health_report2_t));
-                // adi_wil_example_ADK_BGRSSI_calc();   /* @remark: Not used this time */
-                // adi_w2can_NotifyHR_availability();   /* @remark: Not used this time */
-            }
-            else if (((adi_wil_health_report_t *)pData)->Data[0] == PACKET_ID_MANAGER_APPLICATION)
-            {
-                /* HR Data Packet 0x10 :  */
-                if(((adi_wil_health_report_t *)pData)->eDeviceId == ADI_WIL_DEV_MANAGER_0)
-                {
-                    HR_index = 0;
-                }
-                else if(((adi_wil_health_report_t *)pData)->eDeviceId == ADI_WIL_DEV_MANAGER_1)
-                {
-                    HR_index = 1;
-                }
-                else
-                {
-                    break;
-                }
-                memcpy(&userHR10Buffer[HR_index],
-                       &((adi_wil_health_report_t*)pData)->Data[0],
-                       sizeof(adi_wil_health_report10_t));
-            }
-            else if (((adi_wil_health_report_t *)pData)->Data[0] == PACKET_ID_MANAGER_BACKGROUND_RSSI)
-            {
-                /* HR Data Packet 0x11 :  */
-                if(((adi_wil_health_report_t *)pData)->eDeviceId == ADI_WIL_DEV_MANAGER_0)
-                {
-                    HR_index = 0;
-                }
-                else if(((adi_wil_health_report_t *)pData)->eDeviceId == ADI_WIL_DEV_MANAGER_1)
-                {
-                    HR_index = 1;
-                }
-                else
-                {
-                    break;
-                }
-                memcpy(&userHR11Buffer[HR_index],
-                       &((adi_wil_health_report_t*)pData)->Data[0],
-                       sizeof(adi_wil_health_report11_t));
-            }
-            else if (((adi_wil_health_report_t *)pData)->Data[0] == PACKET_ID_MANAGER_DEVICE)
-            {
-                /* HR Data Packet 0x12 :  */
-                if(((adi_wil_health_report_t *)pData)->eDeviceId == ADI_WIL_DEV_MANAGER_0)
-                {
-                    HR_index = 0;
-                }
-                else if(((adi_wil_health_report_t *)pData)->eDeviceId == ADI_WIL_DEV_MANAGER_1)
-                {
-                    HR_index = 1;
-                }
-                else
-                {
-                    break;
-                }
-                memcpy(&userHR12Buffer[HR_index],
-                       &((adi_wil_health_report_t*)pData)->Data[0],
-                       sizeof(adi_wil_health_report12_t));
-            }
-            else if (((adi_wil_health_report_t *)pData)->Data[0] == PACKET_ID_NODE_MANAGER_0_4_RSSI)
-            {
-                /* HR Data Packet 0x14 :  */
-                if(((adi_wil_health_report_t *)pData)->eDeviceId == ADI_WIL_DEV_MANAGER_0)
-                {
-                    HR_index = 0;
-                }
-                else if(((adi_wil_health_report_t *)pData)->eDeviceId == ADI_WIL_DEV_MANAGER_1)
-                {
-                    HR_index = 1;
-                }
-                else
-                {
-                    break;
-                }
-                memcpy(&userHR14Buffer[HR_index],
-                       &((adi_wil_health_report_t*)pData)->Data[0],
-                       sizeof(adi_wil_health_report14_t));
-            }
-            else if (((adi_wil_health_report_t *)pData)->Data[0] == PACKET_ID_NODE_MANAGER_5_9_RSSI)
-            {
-                /* HR Data Packet 0x15 :  */
-                if(((adi_wil_health_report_t *)pData)->eDeviceId == ADI_WIL_DEV_MANAGER_0)
-                {
-                    HR_index = 0;
-                }
-                else if(((adi_wil_health_report_t *)pData)->eDeviceId == ADI_WIL_DEV_MANAGER_1)
-                {
-                    HR_index = 1;
-                }
-                else
-                {
-                    break;
-                }
-                memcpy(&userHR15Buffer[HR_index],
-                       &((adi_wil_health_report_t*)pData)->Data[0],
-                       sizeof(adi_wil_health_report14_t));
-            }
-            else if (((adi_wil_health_report_t *)pData)->Data[0] == PACKET_ID_NODE_MANAGER_10_14_RSSI)
-            {
-                /* HR Data Packet 0x16 :  */
-                if(((adi_wil_health_report_t *)pData)->eDeviceId == ADI_WIL_DEV_MANAGER_0)
-                {
-                    HR_index = 0;
-                }
-                else if(((adi_wil_health_report_t *)pData)->eDeviceId == ADI_WIL_DEV_MANAGER_1)
-                {
-                    HR_index = 1;
-                }
-                else
-                {
-                    break;
-                }
-                memcpy(&userHR16Buffer[HR_index],
-                       &((adi_wil_health_report_t*)pData)->Data[0],
-                       sizeof(adi_wil_health_report14_t));
-            }
-            else if (((adi_wil_health_report_t *)pData)->Data[0] == PACKET_ID_NODE_MANAGER_15_19_RSSI)
-            {
-                /* HR Data Packet 0x17 :  */
-                if(((adi_wil_health_report_t *)pData)->eDeviceId == ADI_WIL_DEV_MANAGER_0)
-                {
-                    HR_index = 0;
-                }
-                else if(((adi_wil_health_report_t *)pData)->eDeviceId == ADI_WIL_DEV_MANAGER_1)
-                {
-                    HR_index = 1;
-                }
-                else
-                {
-                    break;
-                }
-                memcpy(&userHR17Buffer[HR_index],
-                       &((adi_wil_health_report_t*)pData)->Data[0],
-                       sizeof(adi_wil_health_report14_t));
-            }
-            else if (((adi_wil_health_report_t *)pData)->Data[0] == PACKET_ID_NODE_MANAGER_20_23_RSSI)
-            {
-                /* HR Data Packet 0x18 :  */
-                if(((adi_wil_health_report_t *)pData)->eDeviceId == ADI_WIL_DEV_MANAGER_0)
-                {
-                    HR_index = 0;
-                }
-                else if(((adi_wil_health_report_t *)pData)->eDeviceId == ADI_WIL_DEV_MANAGER_1)
-                {
-                    HR_index = 1;
-                }
-                else
-                {
-                    break;
-                }
-                memcpy(&userHR18Buffer[HR_index],
-                       &((adi_wil_health_report_t*)pData)->Data[0],
-                       sizeof(adi_wil_health_report14_t));
-            }
-            else if (((adi_wil_health_report_t *)pData)->Data[0] == PACKET_ID_NODE_APPLICATION)
-            {
-                /* HR Data Packet 0x80 : contains data about node firmware */
-                memcpy(&userHR80Buffer[ADK_ConvertDeviceId(((adi_wil_health_report_t *)pData)->eDeviceId)],
-                       &((adi_wil_health_report_t*)pData)->Data[0],
-                       sizeof(adi_wil_health_report80_t));
-                // adi_w2can_NotifyHR_availability();   /* @remark: Not used this time */
-            }
-            else
-            {
-                // invalid Data Packet ID - ignore
-            }
-            break;
+/* ADI_WIL_EVENT_COMM_MGR_TO_MGR_ERROR */
+static void adi_wil_example_EventMgrToMgrError(adi_wil_pack_t const *pPack, adi_wil_event_id_t eEvent, void const *pData)
+{
+    /* Communication between the two network managers failed (dual manager mode only), no data is returned */
+    /* Counter to track MGR to MGR errors */
+    iMgrToMgrErrCount++;
+}
 
-        case ADI_WIL_EVENT_DATA_READY_NETWORK_DATA:
-            /* Copy out the network data if enabled */
-            memcpy(userNetworkBuffer, ((adi_wil_network_data_buffer_t *)pData)->pData, (((adi_wil_network_data_buffer_t *)pData)->iCount)*(sizeof(adi_wil_network_data_t)));
-            adi_gNotifyNetworkMeta = true;
-            adi_wil_example_ADK_PDR_calc();
-            adi_wil_example_ADK_RSSI_calc();
-            adi_wil_example_StoreNWDataForPS(userNetworkBuffer);
-            break;
+/* ADI_WIL_EVENT_MGR_QUEUE_OVERFLOW */
+static void adi_wil_example_EventQueueOverflow(adi_wil_pack_t const *pPack, adi_wil_event_id_t eEvent, void const *pData)
+{
+    /* Event used to identified SPI transmission queue issues in the managers */
+    iQueueOverflowNotificationCount++;
+}
 
-        case ADI_WIL_EVENT_FAULT_SOURCES:
-            /* A fault in monitor mode has occured and a system summary has been received. */
-            /* Copy out the fault sources summary */
-            memcpy(&faultSources, pData, sizeof(adi_wil_device_t));
-            break;
+/* ADI_WIL_EVENT_DATA_READY_HEALTH_REPORT */
+static void adi_wil_example_EventHealthReport(adi_wil_pack_t const *pPack, adi_wil_event_id_t eEvent, void const *pData)
+{
+    uint8_t HR_index=0;
+    /* Node reports are only stored for the nodes the arena was carved for */
+    uint8_t iNodeIndex = ADK_ConvertDeviceId(((adi_wil_health_report_t *)pData)->eDeviceId);
+    bool bNodeStored = (iNodeIndex < adi_wil_example_ArenaNodeCount());
 
-        case ADI_WIL_EVENT_FAULT_REPORT:
-            /* Environmental monitoring fault report has been received. */
-            /* Copy out the fault report */
-            memcpy(&faultReport, pData, sizeof(adi_wil_fault_report_t));
-            adi_gFaultDetected = true;
-            break;
+    /* Keep the node device report history and run the trend detectors */
+    if (bNodeStored)
+    {
+        adi_wil_example_HrStoreAdd(iNodeIndex, (adi_wil_health_report_t const *)pData);
+    }
 
-        case ADI_WIL_EVENT_SEC_NODE_NOT_IN_ACL:
-            /* Node that tried to join the WBMS is not in the ACL list, the MAC
-               address of the unidentified node (uint8_t *) is returned*/
-        case ADI_WIL_EVENT_SEC_CERTIFICATE_CALCULATION_ERROR:
-            /* A certificate calculation error occurred, the MAC address of the
-               device (uint8_t *) that triggered the event is returned*/
-        case ADI_WIL_EVENT_SEC_JOIN_NO_KEY:
-            /* A node does not have a valid join key, the MAC address of the
-               device (uint8_t *) that triggered the event is returned */
-        case ADI_WIL_EVENT_SEC_JOIN_DUPLICATE_JOIN_COUNTER:
-            /* A node has a duplicate join counter, the MAC address of the
-               device (uint8_t *) that triggered the event is returned */
-        case ADI_WIL_EVENT_SEC_JOIN_MIC_FAILED:
-            /* MIC verification failed for a join packet, the MAC address of the
-               device (uint8_t *) that triggered the event is returned */
-        case ADI_WIL_EVENT_SEC_SESSION_MIC_FAILED:
-            /* Session MIC Failure for a session packet, the MAC address of the
-               device (uint8_t *) that triggered the event is returned */
-        case ADI_WIL_EVENT_SEC_M2M_JOIN_CNTR_ERROR:
-            /* M2M Join Counter Security Error, the MAC address of the peer
-               manager (uint8_t *) that triggered the event is returned */
-        case ADI_WIL_EVENT_SEC_M2M_SESSION_CNTR_ERROR:
-            /* M2M Session Counter Security Error, the MAC address of the peer
-               manager (uint8_t *) that triggered the event is returned */
-        case ADI_WIL_EVENT_SEC_UNKNOWN_ERROR:
-            /* Unknown security error, the MAC address of the device (uint8_t *)
-               that triggered the event is returned */
-        case ADI_WIL_EVENT_SEC_CERTIFICATE_EXCHANGE_LOCK_ERROR:
-            /* A certificate exchange error occurred, the MAC address of the
-               device (uint8_t *) that triggered the event is returned */
-            iSecurityEvtCount++;
-            break;
-        case ADI_WIL_EVENT_XFER_DEVICE_REMOVED:
-            memcpy(&LF_NG_LIST[ADK_DEMO.LF_NG_CNT], pData, sizeof(adi_wil_device_removed_t));
-            ADK_DEMO.LF_NG_CNT++;
-            if( ADK_DEMO.LF_NG_CNT >= MAX_LF_RETRY ){
-                /* @warning Load file command failed a lot */
-                adk_debug_Report(DBG_need_investigation, ADI_WIL_ERR_FAIL);
-            }
-            /* This event applies only during the LoadFile API */
-            /* pData points to a adi_wil_device_removed_t structure. This data
-               can be copied out so that the thread that is executing the
-               LoadFile API can determine which device has dropped off. */
-            break;
-        case ADI_WIL_EVENT_INSUFFICIENT_BUFFER:
-            /* The user has provided a adi_wil_sensor_data_t (adi_wil_sensor_data_t)
-               buffer that is insufficiently sized for this network */
-            /* The correct number of buffers the user should provide is returned
-               (uint16_t *). */
-            break;
-        default: ;
+    /* copy the HR data out here in the event CB from pData */
+    if ((((adi_wil_health_report_t *)pData)->Data[0] == PACKET_ID_NODE_DEVICE) && bNodeStored)
+    {
+        /* HR Data Packet1 : contains signal rssi, reset counter
+        twohop counter, join attempts etc */
+        memcpy(&userHR0Buffer[iNodeIndex], 
+               &((adi_wil_health_report_t*)pData)->Data[0], 
+               sizeof(adi_wil_health_report0_t));
+#if (ADI_W2CAN_ENABLE == 1)
+        adi_w2can_NotifyHR_availability(iNodeIndex, PACKET_ID_NODE_DEVICE);
+#endif
+    }
+    else if ((((adi_wil_health_report_t *)pData)->Data[0] == PACKET_ID_NODE_AVERAGE_RSSI) && bNodeStored)
+    {
+        /* HR Data Packet2 : contains node average rssi */
+        memcpy(&userHR1Buffer[iNodeIndex], 
+               &((adi_wil_health_report_t*)pData)->Data[0], 
+               sizeof(adi_wil_health_report1_t));
+    }
+    else if ((((adi_wil_health_report_t *)pData)->Data[0] == PACKET_ID_NODE_BACKGROUND_RSSI) && bNodeStored)
+    {
+        /* HR Data Packet2 : contains background rssi */
+        memcpy(&userHR2Buffer[iNodeIndex], 
+               &((adi_wil_health_report_t*)pData)->Data[0], 
+               sizeof(adi_wil_health_report2_t));
+        // adi_wil_example_ADK_BGRSSI_calc();   /* @remark: Not used this time */
+#if (ADI_W2CAN_ENABLE == 1)
+        adi_w2can_NotifyHR_availability(iNodeIndex, PACKET_ID_NODE_BACKGROUND_RSSI);
+#endif
+    }
+    else if (((adi_wil_health_report_t *)pData)->Data[0] == PACKET_ID_MANAGER_APPLICATION)
+    {
+        /* HR Data Packet 0x10 :  */
+        if(((adi_wil_health_report_t *)pData)->eDeviceId == ADI_WIL_DEV_MANAGER_0)
+        {
+            HR_index = 0;
+        }
+        else if(((adi_wil_health_report_t *)pData)->eDeviceId == ADI_WIL_DEV_MANAGER_1)
+        {
+            HR_index = 1;
+        }
+        else
+        {
+            return;
+        }
+        memcpy(&userHR10Buffer[HR_index],
+               &((adi_wil_health_report_t*)pData)->Data[0],
+               sizeof(adi_wil_health_report10_t));
+    }
+    else if (((adi_wil_health_report_t *)pData)->Data[0] == PACKET_ID_MANAGER_BACKGROUND_RSSI)
+    {
+        /* HR Data Packet 0x11 :  */
+        if(((adi_wil_health_report_t *)pData)->eDeviceId == ADI_WIL_DEV_MANAGER_0)
+        {
+            HR_index = 0;
+        }
+        else if(((adi_wil_health_report_t *)pData)->eDeviceId == ADI_WIL_DEV_MANAGER_1)
+        {
+            HR_index = 1;
+        }
+        else
+        {
+            return;
+        }
+        memcpy(&userHR11Buffer[HR_index],
+               &((adi_wil_health_report_t*)pData)->Data[0],
+               sizeof(adi_wil_health_report11_t));
+    }
+    else if (((adi_wil_health_report_t *)pData)->Data[0] == PACKET_ID_MANAGER_DEVICE)
+    {
+        /* HR Data Packet 0x12 :  */
+        if(((adi_wil_health_report_t *)pData)->eDeviceId == ADI_WIL_DEV_MANAGER_0)
+        {
+            HR_index = 0;
+        }
+        else if(((adi_wil_health_report_t *)pData)->eDeviceId == ADI_WIL_DEV_MANAGER_1)
+        {
+            HR_index = 1;
+        }
+        else
+        {
+            return;
+        }
+        memcpy(&userHR12Buffer[HR_index],
+               &((adi_wil_health_report_t*)pData)->Data[0],
+               sizeof(adi_wil_health_report12_t));
+    }
+    else if (((adi_wil_health_report_t *)pData)->Data[0] == PACKET_ID_NODE_MANAGER_0_4_RSSI)
+    {
+        /* HR Data Packet 0x14 :  */
+        if(((adi_wil_health_report_t *)pData)->eDeviceId == ADI_WIL_DEV_MANAGER_0)
+        {
+            HR_index = 0;
+        }
+        else if(((adi_wil_health_report_t *)pData)->eDeviceId == ADI_WIL_DEV_MANAGER_1)
+        {
+            HR_index = 1;
+        }
+        else
+        {
+            return;
+        }
+        memcpy(&userHR14Buffer[HR_index],
+               &((adi_wil_health_report_t*)pData)->Data[0],
+               sizeof(adi_wil_health_report14_t));
+    }
+    else if (((adi_wil_health_report_t *)pData)->Data[0] == PACKET_ID_NODE_MANAGER_5_9_RSSI)
+    {
+        /* HR Data Packet 0x15 :  */
+        if(((adi_wil_health_report_t *)pData)->eDeviceId == ADI_WIL_DEV_MANAGER_0)
+        {
+            HR_index = 0;
+        }
+        else if(((adi_wil_health_report_t *)pData)->eDeviceId == ADI_WIL_DEV_MANAGER_1)
+        {
+            HR_index = 1;
+        }
+        else
+        {
+            return;
+        }
+        memcpy(&userHR15Buffer[HR_index],
+               &((adi_wil_health_report_t*)pData)->Data[0],
+               sizeof(adi_wil_health_report14_t));
+    }
+    else if (((adi_wil_health_report_t *)pData)->Data[0] == PACKET_ID_NODE_MANAGER_10_14_RSSI)
+    {
+        /* HR Data Packet 0x16 :  */
+        if(((adi_wil_health_report_t *)pData)->eDeviceId == ADI_WIL_DEV_MANAGER_0)
+        {
+            HR_index = 0;
+        }
+        else if(((adi_wil_health_report_t *)pData)->eDeviceId == ADI_WIL_DEV_MANAGER_1)
+        {
+            HR_index = 1;
+        }
+        else
+        {
+            return;
+        }
+        memcpy(&userHR16Buffer[HR_index],
+               &((adi_wil_health_report_t*)pData)->Data[0],
+               sizeof(adi_wil_health_report14_t));
+    }
+    else if (((adi_wil_health_report_t *)pData)->Data[0] == PACKET_ID_NODE_MANAGER_15_19_RSSI)
+    {
+        /* HR Data Packet 0x17 :  */
+        if(((adi_wil_health_report_t *)pData)->eDeviceId == ADI_WIL_DEV_MANAGER_0)
+        {
+            HR_index = 0;
+        }
+        else if(((adi_wil_health_report_t *)pData)->eDeviceId == ADI_WIL_DEV_MANAGER_1)
+        {
+            HR_index = 1;
+        }
+        else
+        {
+            return;
+        }
+        memcpy(&userHR17Buffer[HR_index],
+               &((adi_wil_health_report_t*)pData)->Data[0],
+               sizeof(adi_wil_health_report14_t));
+    }
+    else if (((adi_wil_health_report_t *)pData)->Data[0] == PACKET_ID_NODE_MANAGER_20_23_RSSI)
+    {
+        /* HR Data Packet 0x18 :  */
+        if(((adi_wil_health_report_t *)pData)->eDeviceId == ADI_WIL_DEV_MANAGER_0)
+        {
+            HR_index = 0;
+        }
+        else if(((adi_wil_health_report_t *)pData)->eDeviceId == ADI_WIL_DEV_MANAGER_1)
+        {
+            HR_index = 1;
+        }
+        else
+        {
+            return;
+        }
+        memcpy(&userHR18Buffer[HR_index],
+               &((adi_wil_health_report_t*)pData)->Data[0],
+               sizeof(adi_wil_health_report14_t));
+    }
+    else if ((((adi_wil_health_report_t *)pData)->Data[0] == PACKET_ID_NODE_APPLICATION) && bNodeStored)
+    {
+        /* HR Data Packet 0x80 : contains data about node firmware */
+        memcpy(&userHR80Buffer[iNodeIndex],
+               &((adi_wil_health_report_t*)pData)->Data[0],
+               sizeof(adi_wil_health_report80_t));
+#if (ADI_W2CAN_ENABLE == 1)
+        adi_w2can_NotifyHR_availability(iNodeIndex, PACKET_ID_NODE_APPLICATION);
+#endif
+    }
+    else
+    {
+        // invalid Data Packet ID - ignore
+    }
+}
+
+/* ADI_WIL_EVENT_DATA_READY_NETWORK_DATA */
+static void adi_wil_example_EventNetworkData(adi_wil_pack_t const *pPack, adi_wil_event_id_t eEvent, void const *pData)
+{
+    /* Copy out the network data if enabled */
+    memcpy(userNetworkBuffer, ((adi_wil_network_data_buffer_t *)pData)->pData, (((adi_wil_network_data_buffer_t *)pData)->iCount)*(sizeof(adi_wil_network_data_t)));
+    adi_gNotifyNetworkMeta = true;
+    adi_wil_example_LinkStatsUpdateBuffer(userNetworkBuffer, ((adi_wil_network_data_buffer_t *)pData)->iCount);
+    adi_wil_example_ADK_LinkStatsPublish();
+    adi_wil_example_StoreNWDataForPS(userNetworkBuffer);
+#if (ADI_W2CAN_ENABLE == 1)
+    adi_w2can_NotifyNetworkData(userNetworkBuffer, ((adi_wil_network_data_buffer_t *)pData)->iCount);
+#endif
+}
+
+/* ADI_WIL_EVENT_FAULT_SOURCES */
+static void adi_wil_example_EventFaultSources(adi_wil_pack_t const *pPack, adi_wil_event_id_t eEvent, void const *pData)
+{
+    /* A fault in monitor mode has occured and a system summary has been received. */
+    /* Copy out the fault sources summary */
+    memcpy(&faultSources, pData, sizeof(adi_wil_device_t));
+}
+
+/* ADI_WIL_EVENT_FAULT_REPORT */
+static void adi_wil_example_EventFaultReport(adi_wil_pack_t const *pPack, adi_wil_event_id_t eEvent, void const *pData)
+{
+    /* Environmental monitoring fault report has been received. */
+    /* Copy out the fault report */
+    memcpy(&faultReport, pData, sizeof(adi_wil_fault_report_t));
+    adi_gFaultDetected = true;
+}
+
+/* ADI_WIL_EVENT_SEC_* */
+static void adi_wil_example_EventSecurity(adi_wil_pack_t const *pPack, adi_wil_event_id_t eEvent, void const *pData)
+{
+    /* Join, session, M2M counter and certificate security errors, the MAC
+       address of the device (uint8_t *) that triggered the event is returned */
+    iSecurityEvtCount++;
+}
+
+/* ADI_WIL_EVENT_XFER_DEVICE_REMOVED */
+static void adi_wil_example_EventXferDeviceRemoved(adi_wil_pack_t const *pPack, adi_wil_event_id_t eEvent, void const *pData)
+{
+    memcpy(&LF_NG_LIST[ADK_DEMO.LF_NG_CNT], pData, sizeof(adi_wil_device_removed_t));
+    ADK_DEMO.LF_NG_CNT++;
+    if( ADK_DEMO.LF_NG_CNT >= MAX_LF_RETRY ){
+        /* @warning Load file command failed a lot */
+        adk_debug_Report(DBG_need_investigation, ADI_WIL_ERR_FAIL);
     }
+    /* This event applies only during the LoadFile API */
+    /* pData points to a adi_wil_device_removed_t structure. This data
+       can be copied out so that the thread that is executing the
+       LoadFile API can determine which device has dropped off. */
+}
+
+/* Raised by the health report store when a node starts to degrade */
+static void adi_wil_example_HrStoreAlert(uint8_t iNodeIndex, adi_hr_metric_t eMetric, adi_hr_alert_t eAlert, adi_hr_trend_t const *pTrend)
+{
+    adi_wil_ex_info("Node %u %s %s: last %.2f, mean %.2f, slope %.2f",
+                    (unsigned int)iNodeIndex, adi_wil_example_HrStoreMetricName(eMetric),
+                    (eAlert == ADI_HR_ALERT_SLOPE) ? "rising" : "jumped",
+                    pTrend->fLast, pTrend->fMean, pTrend->fSlope);
+}
+
+/******************************************************************************
+ * Carves the per node application buffers from the arena, for the node count
+ * the arena was initialised with. The BMS and network data copies hold what
+ * the WIL buffers of adi_wil_example.c can deliver in one event.
+ *****************************************************************************/
+adi_wil_err_t adi_wil_example_AllocateNodeBuffers(void)
+{
+    userBMSBuffer = adi_wil_example_ArenaAlloc("BMS data copy",
+                                               ADI_BMS_PACKETS_PER_NODE_PER_INTERVAL * sizeof(adi_wil_sensor_data_t), 0u);
+    userNetworkBuffer = adi_wil_example_ArenaAlloc("Network data copy",
+                                                   ADI_BMS_PACKETS_PER_NODE_PER_INTERVAL * sizeof(adi_wil_network_data_t), 0u);
+    userHR0Buffer = adi_wil_example_ArenaAlloc("Health report 0", sizeof(adi_wil_health_report0_t), 0u);
+    userHR1Buffer = adi_wil_example_ArenaAlloc("Health report 1", sizeof(adi_wil_health_report1_t), 0u);
+    userHR2Buffer = adi_wil_example_ArenaAlloc("Health report 2", sizeof(adi_wil_health_report2_t), 0u);
+    userHR80Buffer = adi_wil_example_ArenaAlloc("Health report 80", sizeof(adi_wil_health_report80_t), 0u);
+    pHrStore = adi_wil_example_ArenaAlloc("Health report store", sizeof(adi_hr_node_store_t), 0u);
+
+    adi_wil_example_HrStoreInit(pHrStore, adi_wil_example_ArenaNodeCount(), adi_wil_example_HrStoreAlert);
+
+    return ((userBMSBuffer != NULL) && (userNetworkBuffer != NULL) &&
+            (userHR0Buffer != NULL) && (userHR1Buffer != NULL) &&
+            (userHR2Buffer != NULL) && (userHR80Buffer != NULL) &&
+            (pHrStore != NULL)) ? ADI_WIL_ERR_SUCCESS : ADI_WIL_ERR_FAIL;
+}
+
+/******************************************************************************
+ * Registers one handler on core 0, reports it when the event bus has no room
+ * left for it.
+ *****************************************************************************/
+static bool adi_wil_example_RegisterHandler(adi_wil_event_id_t eEvent, adi_event_handler_t pfHandler, const char *pName, uint8_t iPriority, adi_event_exec_t eExec)
+{
+    if (adi_wil_example_EventBusRegister(eEvent, pfHandler, pName, iPriority, eExec, 0u) == ADI_EVENT_BUS_INVALID_HANDLE)
+    {
+        adi_wil_ex_error("Event bus : handler %s for event %u not registered", pName, (unsigned int)eEvent);
+        return false;
+    }
+    return true;
+}
+
+/******************************************************************************
+ * Registers the handlers above. Copy handlers run first (priority 0), the
+ * consumers of the copied data after them. Fails when any handler could not
+ * be registered, the others stay in place.
+ *****************************************************************************/
+adi_wil_err_t adi_wil_example_RegisterEventHandlers(void)
+{
+    bool bRegistered = true;
+
+    adi_wil_example_EventBusReset();
+
+    bRegistered &= adi_wil_example_RegisterHandler(ADI_WIL_EVENT_COMM_MGR_CONNECTED, adi_wil_example_EventMgrConnected, "MgrConnected", 0u, ADI_EVENT_EXEC_INLINE);
+    bRegistered &= adi_wil_example_RegisterHandler(ADI_WIL_EVENT_COMM_MGR_DISCONNECTED, adi_wil_example_EventMgrDisconnected, "MgrDisconnected", 0u, ADI_EVENT_EXEC_INLINE);
+    bRegistered &= adi_wil_example_RegisterHandler(ADI_WIL_EVENT_DATA_READY_PMS, adi_wil_example_EventPms, "Pms", 0u, ADI_EVENT_EXEC_INLINE);
+    bRegistered &= adi_wil_example_RegisterHandler(ADI_WIL_EVENT_DATA_READY_BMS, adi_wil_example_EventBms, "Bms", 0u, ADI_EVENT_EXEC_INLINE);
+#if (ADI_WIL_EX_BMS_DECODE_DEFERRED == 1)
+    bRegistered &= adi_wil_example_RegisterHandler(ADI_WIL_EVENT_DATA_READY_BMS, adi_wil_example_EventBmsDecode, "BmsDecode", 1u, ADI_EVENT_EXEC_DEFERRED);
+#else
+    bRegistered &= adi_wil_example_RegisterHandler(ADI_WIL_EVENT_DATA_READY_BMS, adi_wil_example_EventBmsDecode, "BmsDecode", 1u, ADI_EVENT_EXEC_INLINE);
+#endif
+    bRegistered &= adi_wil_example_RegisterHandler(ADI_WIL_EVENT_DATA_READY_EMS, adi_wil_example_EventEms, "Ems", 0u, ADI_EVENT_EXEC_INLINE);
+    bRegistered &= adi_wil_example_RegisterHandler(ADI_WIL_EVENT_COMM_NODE_CONNECTED, adi_wil_example_EventNodeConnected, "NodeConnected", 0u, ADI_EVENT_EXEC_INLINE);
+    bRegistered &= adi_wil_example_RegisterHandler(ADI_WIL_EVENT_COMM_NODE_DISCONNECTED, adi_wil_example_EventNodeDisconnected, "NodeDisconnected", 0u, ADI_EVENT_EXEC_INLINE);
+    bRegistered &= adi_wil_example_RegisterHandler(ADI_WIL_EVENT_COMM_MGR_TO_MGR_ERROR, adi_wil_example_EventMgrToMgrError, "MgrToMgrError", 0u, ADI_EVENT_EXEC_INLINE);
+    bRegistered &= adi_wil_example_RegisterHandler(ADI_WIL_EVENT_MGR_QUEUE_OVERFLOW, adi_wil_example_EventQueueOverflow, "QueueOverflow", 0u, ADI_EVENT_EXEC_INLINE);
+    bRegistered &= adi_wil_example_RegisterHandler(ADI_WIL_EVENT_DATA_READY_HEALTH_REPORT, adi_wil_example_EventHealthReport, "HealthReport", 0u, ADI_EVENT_EXEC_INLINE);
+    bRegistered &= adi_wil_example_RegisterHandler(ADI_WIL_EVENT_DATA_READY_NETWORK_DATA, adi_wil_example_EventNetworkData, "NetworkData", 0u, ADI_EVENT_EXEC_INLINE);
+    bRegistered &= adi_wil_example_RegisterHandler(ADI_WIL_EVENT_FAULT_SOURCES, adi_wil_example_EventFaultSources, "FaultSources", 0u, ADI_EVENT_EXEC_INLINE);
+    bRegistered &= adi_wil_example_RegisterHandler(ADI_WIL_EVENT_FAULT_REPORT, adi_wil_example_EventFaultReport, "FaultReport", 0u, ADI_EVENT_EXEC_INLINE);
+    bRegistered &= adi_wil_example_RegisterHandler(ADI_WIL_EVENT_SEC_NODE_NOT_IN_ACL, adi_wil_example_EventSecurity, "SecNodeNotInAcl", 0u, ADI_EVENT_EXEC_INLINE);
+    bRegistered &= adi_wil_example_RegisterHandler(ADI_WIL_EVENT_SEC_CERTIFICATE_CALCULATION_ERROR, adi_wil_example_EventSecurity, "SecCertCalc", 0u, ADI_EVENT_EXEC_INLINE);
+    bRegistered &= adi_wil_example_RegisterHandler(ADI_WIL_EVENT_SEC_JOIN_NO_KEY, adi_wil_example_EventSecurity, "SecJoinNoKey", 0u, ADI_EVENT_EXEC_INLINE);
+    bRegistered &= adi_wil_example_RegisterHandler(ADI_WIL_EVENT_SEC_JOIN_DUPLICATE_JOIN_COUNTER, adi_wil_example_EventSecurity, "SecJoinDupCounter", 0u, ADI_EVENT_EXEC_INLINE);
+    bRegistered &= adi_wil_example_RegisterHandler(ADI_WIL_EVENT_SEC_JOIN_MIC_FAILED, adi_wil_example_EventSecurity, "SecJoinMic", 0u, ADI_EVENT_EXEC_INLINE);
+    bRegistered &= adi_wil_example_RegisterHandler(ADI_WIL_EVENT_SEC_SESSION_MIC_FAILED, adi_wil_example_EventSecurity, "SecSessionMic", 0u, ADI_EVENT_EXEC_INLINE);
+    bRegistered &= adi_wil_example_RegisterHandler(ADI_WIL_EVENT_SEC_M2M_JOIN_CNTR_ERROR, adi_wil_example_EventSecurity, "SecM2MJoinCounter", 0u, ADI_EVENT_EXEC_INLINE);
+    bRegistered &= adi_wil_example_RegisterHandler(ADI_WIL_EVENT_SEC_M2M_SESSION_CNTR_ERROR, adi_wil_example_EventSecurity, "SecM2MSessionCounter", 0u, ADI_EVENT_EXEC_INLINE);
+    bRegistered &= adi_wil_example_RegisterHandler(ADI_WIL_EVENT_SEC_UNKNOWN_ERROR, adi_wil_example_EventSecurity, "SecUnknown", 0u, ADI_EVENT_EXEC_INLINE);
+    bRegistered &= adi_wil_example_RegisterHandler(ADI_WIL_EVENT_SEC_CERTIFICATE_EXCHANGE_LOCK_ERROR, adi_wil_example_EventSecurity, "SecCertExchangeLock", 0u, ADI_EVENT_EXEC_INLINE);
+    bRegistered &= adi_wil_example_RegisterHandler(ADI_WIL_EVENT_XFER_DEVICE_REMOVED, adi_wil_example_EventXferDeviceRemoved, "XferDeviceRemoved", 0u, ADI_EVENT_EXEC_INLINE);
+
+    /* ADI_WIL_EVENT_INSUFFICIENT_BUFFER: the user has provided a sensor data
+       buffer that is insufficiently sized for this network, the correct number
+       of buffers (uint16_t *) is returned. Not handled by the example. */
+
+    return bRegistered ? ADI_WIL_ERR_SUCCESS : ADI_WIL_ERR_FAIL;
+}
+
+/******************************************************************************
+ * Event notification callback
+ *****************************************************************************/
+void adi_wil_HandleEvent (adi_wil_pack_t const * const pPack,
+                          void const * const pClientData,
+                          adi_wil_event_id_t EventCode,
+                          void const * const pData)
+{
+    /* For readability, cast the void pointer to app's client data type */
+    client_data_t * appClientData = (client_data_t *)pClientData;
+
+    if (appClientData->eEventWaitingFor == EventCode)
+    {
+        appClientData->iEventWaitingForCount++;
+    }
+    else
+    {
+        /* code flow should never enter here */
+    }
+
+    adi_wil_example_EventBusDispatch(pPack, EventCode, pData);
 }
 #endif
 
@@ -2651,17 +2818,8 @@ void adi_wil_mac_deviceID_return(adi_wil_pack_t *pPack, bool bMacReturn, uint8_t
         }
     }
     else {
-        for(uint8_t i=0;i<ADI_WIL_MAX_NODES;i++) {
-            bool bMacFound = true;
-            for(uint8_t j=0;j<ADI_WIL_MAC_ADDR_SIZE && bMacFound;j++) {
-                bMacFound = (systemAcl.Data[(ADI_WIL_MAC_ADDR_SIZE*i)+j] == *(pMacPtr+j));
-            }
-            if(bMacFound == true) {
-                /*Retrieving the Device ID */
-                *pDeviceID = i;
-                break;
-            }
-        }
+        /*Retrieving the Device ID, left unchanged when the MAC is not in the ACL */
+        (void)adi_wil_example_DeviceDirFindMac(pMacPtr, pDeviceID);
     }
 }
 
@@ -2686,6 +2844,21 @@ uint8_t readSensorPacketCount(adi_wil_configuration_t* pPortConfig) {
     return sensorPacketCount;
 }
 
+/******************************************************************************
+ * PMS Data retrieval Task : forwards the latest PMS packets to W2CAN
+ *****************************************************************************/
+void adi_task_pmsDataRetrieval(void)
+{
+    if (adi_gNotifyPms == true)
+    {
+        adi_gNotifyPms = false;
+#if defined(_ADI_ONLY) && (ADI_W2CAN_ENABLE == 1) && (ADI_W2CAN_PMS_FORWARD == 1)
+        /* userPMSBuffer is only kept by the ADK handlers, CMIC builds forward from Cmic_EventPms */
+        adi_w2can_NotifyPmsData(userPMSBuffer, iUserPMSPacketCount);
+#endif
+    }
+}
+
 /******************************************************************************
  * Print Event Statistics
  *****************************************************************************/
@@ -2859,33 +3032,7 @@ void adk_debug_BootTimeLog(bool final, bool start, uint16_t step, ADK_LOG_FUNCTI
 
 uint8_t ADK_ConvertDeviceId (adi_wil_device_t WilDeviceId)
 {
-    uint8_t DeviceId = 0;
-    
-    if(WilDeviceId != 0)
-    {
-        if (WilDeviceId == ADI_WIL_DEV_MANAGER_0) return 240;
-        else if (WilDeviceId == ADI_WIL_DEV_MANAGER_1) return 241;
-        else if (WilDeviceId == ADI_WIL_DEV_ALL_MANAGERS) return 254;
-        else if (WilDeviceId == ADI_WIL_DEV_ALL_NODES) return 255;
-    
-        while ((WilDeviceId & (ADI_WIL_DEV_NODE_0 << DeviceId)) == 0)
-        {
-            if(DeviceId < 255)
-            {
-                DeviceId++;
-            }
-            else
-            {
-                DeviceId = 200;
-                break;
-            }
-        }
-    }
-    else
-    {
-        DeviceId = 200;
-    }
-    return DeviceId;
+    return adi_wil_example_DeviceDirNodeIndex(WilDeviceId);
 }
 
 
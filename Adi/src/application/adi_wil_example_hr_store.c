@@ -0,0 +1,364 @@
+/*******************************************************************************
+ * @file     adi_wil_example_hr_store.c
+ *
+ * @brief    Health report history and trend detection
+ *
+ * @details  Keeps the last ADI_HR_STORE_DEPTH node device health reports of
+ *           every node as deltas against the report before them, in memory
+ *           fixed at initialization. The newest report is kept exact and
+ *           older ones are rebuilt by walking the deltas back from it.
+ *           Every report also updates per metric EWMA mean, deviation and
+ *           slope detectors, which call the alert handler when a metric
+ *           keeps rising or jumps above its average.
+ *
+ * Copyright (c) 2020-2022 Analog Devices, Inc. All Rights Reserved.
+ * This software is proprietary and confidential to Analog Devices, Inc. and its licensors.
+ *******************************************************************************/
+
+#include <string.h>
+#include <stddef.h>
+
+#include "adi_wil_example_hr_store.h"
+#include "adi_wil_example_functions.h"
+#include "adi_wil_example_printf.h"
+#include "adi_wil_example_w2can.h"
+#include "adi_wil_health_report.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define ADI_HR_MEAN_WEIGHT              0.125f  /* EWMA weight of a new report in mean and deviation */
+#define ADI_HR_SLOPE_WEIGHT             0.25f   /* EWMA weight of a new change in the slope */
+#define ADI_HR_DEVIATION_FACTOR         4.0f    /* Deviations from the mean that raise ADI_HR_ALERT_DEVIATION */
+#define ADI_HR_NARROW_FIRST             ADI_HR_FIELD_NET_MIC_FAILURES
+
+/*******************************************************************************
+ * Structures
+ ******************************************************************************/
+/* Where a field sits in adi_wil_health_report0_t */
+typedef struct
+{
+    uint8_t     iOffset;
+    uint8_t     iBytes;                 /* 2: unsigned little endian counter, 1: signed */
+}adi_hr_field_desc_t;
+
+/* Detector limits of a metric. The deviation floor keeps a flat metric
+ * (deviation near zero) from alerting on its first small change */
+typedef struct
+{
+    const char  *pName;
+    float       fSlopeLimit;            /* Change per report */
+    float       fDeviationFloor;
+}adi_hr_metric_desc_t;
+
+/*******************************************************************************
+ * Static variable declarations
+ *******************************************************************************/
+static const adi_hr_field_desc_t HrFields[ADI_HR_FIELD_COUNT] =
+{
+    [ADI_HR_FIELD_PKTS_GENERATED]   = {offsetof(adi_wil_health_report0_t, iTotalPktsGenerated), 2u},
+    [ADI_HR_FIELD_PKTS_NACKED]      = {offsetof(adi_wil_health_report0_t, iPacketsNacked),      2u},
+    [ADI_HR_FIELD_NET_MIC_FAILURES] = {offsetof(adi_wil_health_report0_t, iNetMicFailures),     2u},
+    [ADI_HR_FIELD_MAC_MIC_FAILURES] = {offsetof(adi_wil_health_report0_t, iMacMicFailures),     2u},
+    [ADI_HR_FIELD_JOIN_ATTEMPTS]    = {offsetof(adi_wil_health_report0_t, iJoinAttempts),       2u},
+    [ADI_HR_FIELD_PARENTS]          = {offsetof(adi_wil_health_report0_t, iParents),            2u},
+    [ADI_HR_FIELD_QUEUE_FAILURES]   = {offsetof(adi_wil_health_report0_t, iPacketQueueFailure), 1u},
+    [ADI_HR_FIELD_ADC_TEMP]         = {offsetof(adi_wil_health_report0_t, iADCtemp),            1u},
+};
+
+static const adi_hr_metric_desc_t HrMetrics[ADI_HR_METRIC_COUNT] =
+{
+    [ADI_HR_METRIC_NACK_RATE]       = {"nack rate",      10.0f, 20.0f},
+    [ADI_HR_METRIC_MIC_FAILURES]    = {"MIC failures",    1.0f,  2.0f},
+    [ADI_HR_METRIC_JOIN_ATTEMPTS]   = {"join attempts",   0.5f,  2.0f},
+    [ADI_HR_METRIC_QUEUE_FAILURES]  = {"queue failures",  1.0f,  2.0f},
+    [ADI_HR_METRIC_TEMPERATURE]     = {"temperature",     0.5f,  5.0f},
+};
+
+static adi_hr_node_store_t *pHrNodes = NULL;
+static uint8_t iHrNodeCount = 0;
+static adi_hr_alert_handler_t pfHrAlert = NULL;
+
+/*******************************************************************************
+ * Static functions
+ ******************************************************************************/
+static int32_t adi_hr_ReadField(uint8_t const *pData, adi_hr_field_t eField);
+static int32_t adi_hr_CounterDelta(int32_t iNew, int32_t iOld);
+static void adi_hr_Encode(adi_hr_record_t *pRecord, adi_hr_sample_t const *pNew, adi_hr_sample_t const *pOld);
+static void adi_hr_Decode(adi_hr_sample_t *pSample, adi_hr_record_t const *pRecord);
+static void adi_hr_UpdateMetrics(uint8_t iNodeIndex, adi_hr_node_store_t *pNode, adi_hr_sample_t const *pNew, adi_hr_sample_t const *pOld);
+static void adi_hr_UpdateTrend(uint8_t iNodeIndex, adi_hr_metric_t eMetric, adi_hr_trend_t *pTrend, float fValue);
+static void adi_hr_SetAlert(uint8_t iNodeIndex, adi_hr_metric_t eMetric, adi_hr_trend_t *pTrend, adi_hr_alert_t eAlert, bool bCondition);
+
+/*******************************************************************************
+ * Funtion definitions
+ ******************************************************************************/
+void adi_wil_example_HrStoreInit(adi_hr_node_store_t *pNodes, uint8_t iNodeCount, adi_hr_alert_handler_t pfAlert)
+{
+    pHrNodes = pNodes;
+    iHrNodeCount = (pNodes != NULL) ? iNodeCount : 0u;
+    pfHrAlert = pfAlert;
+
+    if (pHrNodes != NULL)
+    {
+        memset(pHrNodes, 0, (size_t)iHrNodeCount * sizeof(adi_hr_node_store_t));
+    }
+}
+
+void adi_wil_example_HrStoreAdd(uint8_t iNodeIndex, adi_wil_health_report_t const *pReport)
+{
+    adi_hr_node_store_t *pNode;
+    adi_hr_sample_t New;
+    uint8_t i;
+
+    if ((iNodeIndex < iHrNodeCount) &&
+        (pReport != NULL) &&
+        (pReport->Data[0] == PACKET_ID_NODE_DEVICE) &&
+        (pReport->iLength >= sizeof(adi_wil_health_report0_t)))
+    {
+        pNode = &pHrNodes[iNodeIndex];
+
+        New.iPacketGenerationTime = pReport->iPacketGenerationTime;
+        New.iApproxMask = 0u;
+        for (i = 0; i < (uint8_t)ADI_HR_FIELD_COUNT; i++)
+        {
+            New.Values[i] = adi_hr_ReadField(pReport->Data, (adi_hr_field_t)i);
+        }
+
+        /* The oldest record is overwritten once the ring is full. The
+         * first report has nothing to be a delta against and is stored
+         * as a zero change */
+        if (pNode->iCount == 0u)
+        {
+            memset(&pNode->Records[pNode->iHead], 0, sizeof(adi_hr_record_t));
+        }
+        else
+        {
+            adi_hr_Encode(&pNode->Records[pNode->iHead], &New, &pNode->Newest);
+            adi_hr_UpdateMetrics(iNodeIndex, pNode, &New, &pNode->Newest);
+        }
+
+        pNode->iHead = (uint8_t)((pNode->iHead + 1u) % ADI_HR_STORE_DEPTH);
+        if (pNode->iCount < ADI_HR_STORE_DEPTH)
+        {
+            pNode->iCount++;
+        }
+
+        pNode->Newest = New;
+    }
+}
+
+uint8_t adi_wil_example_HrStoreGetCount(uint8_t iNodeIndex)
+{
+    return (iNodeIndex < iHrNodeCount) ? pHrNodes[iNodeIndex].iCount : 0u;
+}
+
+bool adi_wil_example_HrStoreGetSample(uint8_t iNodeIndex, uint8_t iAge, adi_hr_sample_t *pSample)
+{
+    adi_hr_node_store_t const *pNode;
+    uint8_t iIndex;
+    uint8_t i;
+    bool bFound = false;
+
+    if ((iNodeIndex < iHrNodeCount) && (iAge < pHrNodes[iNodeIndex].iCount))
+    {
+        pNode = &pHrNodes[iNodeIndex];
+        *pSample = pNode->Newest;
+
+        /* Undo the newest iAge changes, newest first */
+        iIndex = pNode->iHead;
+        for (i = 0; i < iAge; i++)
+        {
+            iIndex = (uint8_t)((iIndex + ADI_HR_STORE_DEPTH - 1u) % ADI_HR_STORE_DEPTH);
+            adi_hr_Decode(pSample, &pNode->Records[iIndex]);
+        }
+
+        bFound = true;
+    }
+
+    return bFound;
+}
+
+adi_hr_trend_t const *adi_wil_example_HrStoreGetTrend(uint8_t iNodeIndex, adi_hr_metric_t eMetric)
+{
+    return ((iNodeIndex < iHrNodeCount) && (eMetric < ADI_HR_METRIC_COUNT)) ? &pHrNodes[iNodeIndex].Trends[eMetric] : NULL;
+}
+
+const char *adi_wil_example_HrStoreMetricName(adi_hr_metric_t eMetric)
+{
+    return (eMetric < ADI_HR_METRIC_COUNT) ? HrMetrics[eMetric].pName : "unknown";
+}
+
+void adi_wil_example_HrStoreDumpNode(uint8_t iNodeIndex)
+{
+    adi_hr_trend_t const *pTrend;
+    uint8_t i;
+
+    if (iNodeIndex < iHrNodeCount)
+    {
+        adi_wil_ex_printf("HR store : node %u, %u reports" LINE_END,
+                          (unsigned int)iNodeIndex, (unsigned int)pHrNodes[iNodeIndex].iCount);
+        adi_wil_ex_printf("%-16s %10s %10s %10s %10s %6s" LINE_END,
+                          "metric", "last", "mean", "deviation", "slope", "alerts");
+
+        for (i = 0; i < (uint8_t)ADI_HR_METRIC_COUNT; i++)
+        {
+            pTrend = &pHrNodes[iNodeIndex].Trends[i];
+            adi_wil_ex_printf("%-16s %10.2f %10.2f %10.2f %10.2f %6u" LINE_END,
+                              HrMetrics[i].pName,
+                              pTrend->fLast, pTrend->fMean, pTrend->fDeviation, pTrend->fSlope,
+                              (unsigned int)pTrend->iAlertCount);
+        }
+    }
+}
+
+/*******************************************************************************
+ * Static function definitions
+ ******************************************************************************/
+static int32_t adi_hr_ReadField(uint8_t const *pData, adi_hr_field_t eField)
+{
+    uint8_t const *pField = &pData[HrFields[eField].iOffset];
+
+    return (HrFields[eField].iBytes == 2u) ? (int32_t)((uint32_t)pField[0] | ((uint32_t)pField[1] << 8)) :
+           (eField == ADI_HR_FIELD_ADC_TEMP) ? (int32_t)(int8_t)pField[0] : (int32_t)pField[0];
+}
+
+/* Change of a counter over one report. A counter that went back was
+ * restarted by a node reset and has counted iNew since */
+static int32_t adi_hr_CounterDelta(int32_t iNew, int32_t iOld)
+{
+    return (iNew >= iOld) ? (iNew - iOld) : iNew;
+}
+
+static void adi_hr_Encode(adi_hr_record_t *pRecord, adi_hr_sample_t const *pNew, adi_hr_sample_t const *pOld)
+{
+    uint64_t iTimeDelta = pNew->iPacketGenerationTime - pOld->iPacketGenerationTime;
+    int32_t iDelta;
+    uint8_t i;
+
+    pRecord->iTimeDelta = (iTimeDelta > UINT32_MAX) ? UINT32_MAX : (uint32_t)iTimeDelta;
+
+    /* Wrapping the 16 bit counters makes the wide deltas exact */
+    pRecord->iPktsGenerated = (int16_t)(uint16_t)(pNew->Values[ADI_HR_FIELD_PKTS_GENERATED] - pOld->Values[ADI_HR_FIELD_PKTS_GENERATED]);
+    pRecord->iPktsNacked = (int16_t)(uint16_t)(pNew->Values[ADI_HR_FIELD_PKTS_NACKED] - pOld->Values[ADI_HR_FIELD_PKTS_NACKED]);
+
+    pRecord->iClampMask = 0u;
+    for (i = ADI_HR_NARROW_FIRST; i < (uint8_t)ADI_HR_FIELD_COUNT; i++)
+    {
+        iDelta = pNew->Values[i] - pOld->Values[i];
+
+        if ((iDelta > INT8_MAX) || (iDelta < INT8_MIN))
+        {
+            iDelta = (iDelta > 0) ? INT8_MAX : INT8_MIN;
+            pRecord->iClampMask |= (uint8_t)(1u << i);
+        }
+
+        pRecord->Deltas[i - ADI_HR_NARROW_FIRST] = (int8_t)iDelta;
+    }
+}
+
+/* Turns pSample into the report before it */
+static void adi_hr_Decode(adi_hr_sample_t *pSample, adi_hr_record_t const *pRecord)
+{
+    uint8_t i;
+
+    pSample->iPacketGenerationTime -= pRecord->iTimeDelta;
+    pSample->Values[ADI_HR_FIELD_PKTS_GENERATED] = (int32_t)(uint16_t)(pSample->Values[ADI_HR_FIELD_PKTS_GENERATED] - pRecord->iPktsGenerated);
+    pSample->Values[ADI_HR_FIELD_PKTS_NACKED] = (int32_t)(uint16_t)(pSample->Values[ADI_HR_FIELD_PKTS_NACKED] - pRecord->iPktsNacked);
+
+    for (i = ADI_HR_NARROW_FIRST; i < (uint8_t)ADI_HR_FIELD_COUNT; i++)
+    {
+        pSample->Values[i] -= pRecord->Deltas[i - ADI_HR_NARROW_FIRST];
+    }
+
+    pSample->iApproxMask |= pRecord->iClampMask;
+}
+
+static void adi_hr_UpdateMetrics(uint8_t iNodeIndex, adi_hr_node_store_t *pNode, adi_hr_sample_t const *pNew, adi_hr_sample_t const *pOld)
+{
+    int32_t iGenerated = adi_hr_CounterDelta(pNew->Values[ADI_HR_FIELD_PKTS_GENERATED], pOld->Values[ADI_HR_FIELD_PKTS_GENERATED]);
+    int32_t iNacked = adi_hr_CounterDelta(pNew->Values[ADI_HR_FIELD_PKTS_NACKED], pOld->Values[ADI_HR_FIELD_PKTS_NACKED]);
+    float fValues[ADI_HR_METRIC_COUNT];
+    uint8_t i;
+
+    fValues[ADI_HR_METRIC_NACK_RATE] = (iGenerated > 0) ? ((1000.0f * (float)iNacked) / (float)iGenerated) : 0.0f;
+    fValues[ADI_HR_METRIC_MIC_FAILURES] = (float)(adi_hr_CounterDelta(pNew->Values[ADI_HR_FIELD_NET_MIC_FAILURES], pOld->Values[ADI_HR_FIELD_NET_MIC_FAILURES]) +
+                                                  adi_hr_CounterDelta(pNew->Values[ADI_HR_FIELD_MAC_MIC_FAILURES], pOld->Values[ADI_HR_FIELD_MAC_MIC_FAILURES]));
+    fValues[ADI_HR_METRIC_JOIN_ATTEMPTS] = (float)adi_hr_CounterDelta(pNew->Values[ADI_HR_FIELD_JOIN_ATTEMPTS], pOld->Values[ADI_HR_FIELD_JOIN_ATTEMPTS]);
+    fValues[ADI_HR_METRIC_QUEUE_FAILURES] = (float)adi_hr_CounterDelta(pNew->Values[ADI_HR_FIELD_QUEUE_FAILURES], pOld->Values[ADI_HR_FIELD_QUEUE_FAILURES]);
+    fValues[ADI_HR_METRIC_TEMPERATURE] = (float)pNew->Values[ADI_HR_FIELD_ADC_TEMP];
+
+    for (i = 0; i < (uint8_t)ADI_HR_METRIC_COUNT; i++)
+    {
+        adi_hr_UpdateTrend(iNodeIndex, (adi_hr_metric_t)i, &pNode->Trends[i], fValues[i]);
+    }
+}
+
+static void adi_hr_UpdateTrend(uint8_t iNodeIndex, adi_hr_metric_t eMetric, adi_hr_trend_t *pTrend, float fValue)
+{
+    adi_hr_metric_desc_t const *pDesc = &HrMetrics[eMetric];
+    float fError;
+    float fSlopeLimit;
+    bool bWarm;
+    bool bJump;
+
+    if (pTrend->iSamples == 0u)
+    {
+        pTrend->fMean = fValue;
+        pTrend->fDeviation = 0.0f;
+        pTrend->fSlope = 0.0f;
+        pTrend->fLast = fValue;
+    }
+    else
+    {
+        /* Judge the report against the history before it joins it */
+        fError = fValue - pTrend->fMean;
+        bWarm = (pTrend->iSamples >= ADI_HR_STORE_WARMUP);
+        bJump = bWarm && (fError > ((ADI_HR_DEVIATION_FACTOR * pTrend->fDeviation) + pDesc->fDeviationFloor));
+
+        pTrend->fSlope += ADI_HR_SLOPE_WEIGHT * ((fValue - pTrend->fLast) - pTrend->fSlope);
+        pTrend->fMean += ADI_HR_MEAN_WEIGHT * fError;
+        pTrend->fDeviation += ADI_HR_MEAN_WEIGHT * (((fError < 0.0f) ? -fError : fError) - pTrend->fDeviation);
+        pTrend->fLast = fValue;
+
+        /* Half the limit clears the alert again, so a slope hovering at
+         * the limit does not toggle it on every report */
+        fSlopeLimit = ((pTrend->iActiveAlerts & (1u << ADI_HR_ALERT_SLOPE)) != 0u) ? (0.5f * pDesc->fSlopeLimit) : pDesc->fSlopeLimit;
+
+        adi_hr_SetAlert(iNodeIndex, eMetric, pTrend, ADI_HR_ALERT_DEVIATION, bJump);
+        adi_hr_SetAlert(iNodeIndex, eMetric, pTrend, ADI_HR_ALERT_SLOPE, bWarm && (pTrend->fSlope > fSlopeLimit));
+    }
+
+    if (pTrend->iSamples < UINT16_MAX)
+    {
+        pTrend->iSamples++;
+    }
+}
+
+/* Calls the alert handler when the condition starts to hold */
+static void adi_hr_SetAlert(uint8_t iNodeIndex, adi_hr_metric_t eMetric, adi_hr_trend_t *pTrend, adi_hr_alert_t eAlert, bool bCondition)
+{
+    uint8_t iMask = (uint8_t)(1u << eAlert);
+
+    if (bCondition && ((pTrend->iActiveAlerts & iMask) == 0u))
+    {
+        pTrend->iActiveAlerts |= iMask;
+        if (pTrend->iAlertCount < UINT8_MAX)
+        {
+            pTrend->iAlertCount++;
+        }
+
+        if (pfHrAlert != NULL)
+        {
+            pfHrAlert(iNodeIndex, eMetric, eAlert, pTrend);
+        }
+    }
+    else if (!bCondition)
+    {
+        pTrend->iActiveAlerts &= (uint8_t)~iMask;
+    }
+    else
+    {
+        /* Still raised */
+    }
+}
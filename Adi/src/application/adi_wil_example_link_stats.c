@@ -0,0 +1,249 @@
+/*******************************************************************************
+ * @file     adi_wil_example_link_stats.c
+ *
+ * @brief    Streaming link quality statistics
+ *
+ * @details  Per node packet delivery, RSSI and latency figures updated record
+ *           by record from the WIL network data. Memory is fixed by the node,
+ *           manager and channel counts, independent of the capture length.
+ *
+ * Copyright (c) 2020-2022 Analog Devices, Inc. All Rights Reserved.
+ * This software is proprietary and confidential to Analog Devices, Inc. and its licensors.
+ *******************************************************************************/
+
+#include <string.h>
+
+#include "adi_wil_example_link_stats.h"
+#include "adi_wil_example_functions.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define ADI_LINK_STATS_SEQ_MASK         ((uint32_t)((1uL << ADI_LINK_STATS_SEQ_BITS) - 1u))
+#define ADI_LINK_STATS_SEQ_HALF         ((int32_t)(1L << (ADI_LINK_STATS_SEQ_BITS - 1u)))
+
+/******************************************************************************
+ * Static variable declarations
+ *****************************************************************************/
+static adi_link_stats_node_t NodeLinkStats[ADI_LINK_STATS_NODE_COUNT];
+static adi_link_stats_rssi_t ChannelLinkStats[ADI_LINK_STATS_NODE_COUNT][ADI_LINK_STATS_CHANNEL_COUNT];
+
+/* Upper latency (inclusive) of each histogram bucket */
+static const uint16_t adi_link_stats_LatencyEdges[ADI_LINK_STATS_LATENCY_BUCKETS] =
+{
+    8u, 16u, 24u, 32u, 48u, 64u, 128u, 0xFFFFu
+};
+
+/*******************************************************************************
+ * Local Funtion Declarations
+ ******************************************************************************/
+static void adi_link_stats_UpdateSequence(adi_link_stats_node_t *pNode, uint32_t iSequenceNumber);
+static void adi_link_stats_UpdateRssi(adi_link_stats_rssi_t *pRssi, int8_t iRssi);
+static uint8_t adi_link_stats_LatencyBucket(uint16_t iLatency);
+
+/*******************************************************************************
+ * Funtion definitions
+ ******************************************************************************/
+void adi_wil_example_LinkStatsReset(void)
+{
+    uint8_t iNode;
+
+    for (iNode = 0; iNode < ADI_LINK_STATS_NODE_COUNT; iNode++)
+    {
+        adi_wil_example_LinkStatsResetNode(iNode);
+    }
+}
+
+void adi_wil_example_LinkStatsResetNode(uint8_t iNodeId)
+{
+    uint8_t i;
+
+    if (iNodeId >= ADI_LINK_STATS_NODE_COUNT)
+    {
+        return;
+    }
+
+    memset(&NodeLinkStats[iNodeId], 0, sizeof(adi_link_stats_node_t));
+    memset(&ChannelLinkStats[iNodeId][0], 0, sizeof(ChannelLinkStats[iNodeId]));
+    for (i = 0; i < ADI_LINK_STATS_MANAGER_COUNT; i++)
+    {
+        NodeLinkStats[iNodeId].Path[i].iRssiLast = ADI_LINK_STATS_RSSI_NONE;
+    }
+    for (i = 0; i < ADI_LINK_STATS_CHANNEL_COUNT; i++)
+    {
+        ChannelLinkStats[iNodeId][i].iRssiLast = ADI_LINK_STATS_RSSI_NONE;
+    }
+}
+
+void adi_wil_example_LinkStatsUpdate(adi_wil_network_data_t const *pRecord)
+{
+    adi_link_stats_node_t *pNode;
+    uint8_t iNodeId;
+    uint8_t iPath;
+    uint8_t iBucket;
+
+    iNodeId = ADK_ConvertDeviceId(pRecord->eSrcDeviceId);
+    if (iNodeId >= ADI_LINK_STATS_NODE_COUNT)
+    {
+        return;
+    }
+    pNode = &NodeLinkStats[iNodeId];
+    iPath = (pRecord->eSrcManagerId == ADI_WIL_DEV_MANAGER_1) ? 1u : 0u;
+
+    adi_link_stats_UpdateSequence(pNode, pRecord->iSequenceNumber);
+
+    adi_link_stats_UpdateRssi(&pNode->Path[iPath], pRecord->iRSSI);
+    if (pRecord->iChannel < ADI_LINK_STATS_CHANNEL_COUNT)
+    {
+        adi_link_stats_UpdateRssi(&ChannelLinkStats[iNodeId][pRecord->iChannel], pRecord->iRSSI);
+    }
+
+    iBucket = adi_link_stats_LatencyBucket(pRecord->iLatency);
+    pNode->LatencyHist[iPath][iBucket]++;
+    pNode->iLatencySum[iPath] += pRecord->iLatency;
+    if (pRecord->iLatency > pNode->iLatencyMax[iPath])
+    {
+        pNode->iLatencyMax[iPath] = pRecord->iLatency;
+    }
+}
+
+void adi_wil_example_LinkStatsUpdateBuffer(adi_wil_network_data_t const *pData, uint16_t iCount)
+{
+    uint16_t i;
+
+    for (i = 0; i < iCount; i++)
+    {
+        adi_wil_example_LinkStatsUpdate(&pData[i]);
+    }
+}
+
+adi_link_stats_node_t const *adi_wil_example_LinkStatsGetNode(uint8_t iNodeId)
+{
+    return (iNodeId < ADI_LINK_STATS_NODE_COUNT) ? &NodeLinkStats[iNodeId] : NULL;
+}
+
+bool adi_wil_example_LinkStatsGetChannel(uint8_t iNodeId, uint8_t iChannel, adi_link_stats_rssi_t *pStats)
+{
+    if ((iNodeId >= ADI_LINK_STATS_NODE_COUNT) || (iChannel >= ADI_LINK_STATS_CHANNEL_COUNT) || (pStats == NULL))
+    {
+        return false;
+    }
+    *pStats = ChannelLinkStats[iNodeId][iChannel];
+    return true;
+}
+
+uint16_t adi_wil_example_LinkStatsGetPdr(uint8_t iNodeId)
+{
+    adi_link_stats_node_t const *pNode = adi_wil_example_LinkStatsGetNode(iNodeId);
+
+    if ((pNode == NULL) || (pNode->iExpected == 0u))
+    {
+        return 0u;
+    }
+    return (uint16_t)(((uint64_t)pNode->iReceived * 10000u) / pNode->iExpected);
+}
+
+uint16_t adi_wil_example_LinkStatsLatencyEdge(uint8_t iBucket)
+{
+    return (iBucket < ADI_LINK_STATS_LATENCY_BUCKETS) ? adi_link_stats_LatencyEdges[iBucket] : 0u;
+}
+
+/**
+ * @brief   Sliding window over the last ADI_LINK_STATS_SEQ_WINDOW sequence numbers.
+ *          A sequence number ahead of the highest one extends the expected count by
+ *          the gap, one inside the window fills a hole or is a duplicate (the same
+ *          packet through the other manager).
+ */
+static void adi_link_stats_UpdateSequence(adi_link_stats_node_t *pNode, uint32_t iSequenceNumber)
+{
+    uint32_t iSeq = iSequenceNumber & ADI_LINK_STATS_SEQ_MASK;
+    int32_t iDelta;
+    uint32_t iBit;
+
+    if (!pNode->bSeqValid)
+    {
+        pNode->bSeqValid = true;
+        pNode->iSeqHighest = (uint16_t)iSeq;
+        pNode->iSeqWindow = 1u;
+        pNode->iExpected++;
+        pNode->iReceived++;
+        return;
+    }
+
+    /* Signed distance modulo 2^SEQ_BITS */
+    iDelta = (int32_t)((iSeq - pNode->iSeqHighest) & ADI_LINK_STATS_SEQ_MASK);
+    if (iDelta >= ADI_LINK_STATS_SEQ_HALF)
+    {
+        iDelta -= (int32_t)(ADI_LINK_STATS_SEQ_MASK + 1u);
+    }
+
+    if (iDelta > (int32_t)ADI_LINK_STATS_SEQ_RESYNC)
+    {
+        /* Node restarted its counter, do not count the jump as lost packets */
+        pNode->iResyncs++;
+        pNode->iSeqHighest = (uint16_t)iSeq;
+        pNode->iSeqWindow = 1u;
+        pNode->iExpected++;
+        pNode->iReceived++;
+    }
+    else if (iDelta > 0)
+    {
+        pNode->iExpected += (uint32_t)iDelta;
+        pNode->iReceived++;
+        pNode->iSeqWindow = ((iDelta < (int32_t)ADI_LINK_STATS_SEQ_WINDOW) ? (pNode->iSeqWindow << iDelta) : 0u) | 1u;
+        pNode->iSeqHighest = (uint16_t)iSeq;
+    }
+    else if (iDelta > -(int32_t)ADI_LINK_STATS_SEQ_WINDOW)
+    {
+        iBit = 1uL << (uint32_t)(-iDelta);
+        if ((pNode->iSeqWindow & iBit) != 0u)
+        {
+            pNode->iDuplicates++;
+        }
+        else
+        {
+            /* Late arrival, it was counted in iExpected when the gap was seen */
+            pNode->iSeqWindow |= iBit;
+            pNode->iReceived++;
+        }
+    }
+    else
+    {
+        pNode->iStale++;
+    }
+}
+
+static void adi_link_stats_UpdateRssi(adi_link_stats_rssi_t *pRssi, int8_t iRssi)
+{
+    if (pRssi->iPackets == 0u)
+    {
+        pRssi->iRssiEwma = (int16_t)(iRssi * 256);
+        pRssi->iRssiMin = iRssi;
+        pRssi->iRssiMax = iRssi;
+    }
+    else
+    {
+        pRssi->iRssiEwma += (int16_t)(((int32_t)iRssi * 256 - pRssi->iRssiEwma) >> ADI_LINK_STATS_EWMA_SHIFT);
+        if (iRssi < pRssi->iRssiMin)
+        {
+            pRssi->iRssiMin = iRssi;
+        }
+        if (iRssi > pRssi->iRssiMax)
+        {
+            pRssi->iRssiMax = iRssi;
+        }
+    }
+    pRssi->iRssiLast = iRssi;
+    pRssi->iPackets++;
+}
+
+static uint8_t adi_link_stats_LatencyBucket(uint16_t iLatency)
+{
+    uint8_t iBucket = 0;
+
+    while ((iBucket < (ADI_LINK_STATS_LATENCY_BUCKETS - 1u)) && (iLatency > adi_link_stats_LatencyEdges[iBucket]))
+    {
+        iBucket++;
+    }
+    return iBucket;
+}
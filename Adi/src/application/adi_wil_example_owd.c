@@ -41,6 +41,26 @@ static int16_t aiNominalCellData[ADI_WIL_MAX_NODES][SM_ADBMS6833_TOTAL_CELLS_PER
 /* iOWDPcktsRcvd - Status flag to indicate if all the packets for Open Wire detection are received */
 uint8_t  iOWDPcktsRcvd[ADI_WIL_MAX_NODES];
 
+/* Batch open wire thresholds of a device, in raw register codes */
+typedef struct
+{
+    int32_t iZeroCode;          /* Nominal code below which the cell reads as zero volt */
+    int32_t iOffsetCode;        /* Register offset in codes, VTG_REG_OFFSET / VTG_REG_RESOLUTION */
+    int32_t iPercent;           /* Allowed drop in percent of the nominal cell voltage */
+} adi_owd_thresholds_t;
+
+/* With V = (code + iOffsetCode) * resolution the check
+ * |Vnom - Vow| > (Vnom * percent) / 100 becomes
+ * 100 * |nom - ow| > percent * (nom + iOffsetCode), the resolution cancels
+ * and no divide is left. Both sides are exact integers, so the result
+ * matches the truncating divide for every code that yields a positive
+ * voltage, and fails below as the divide does */
+static const adi_owd_thresholds_t OwdThresholds[ADI_OWD_DEVICE_COUNT] =
+{
+    { -12000, 10000, 25 },      /* ADBMS6830 */
+    { -12000, 10000, 30 },      /* ADBMS6833 */
+};
+
 /*******************************************************************************/
 /* Extern Variable Declarations                                                */
 /*******************************************************************************/
@@ -50,7 +70,7 @@ extern bool                         adi_gNotifyBms;
 extern uint8_t                      gTotalNodes;
 extern uint16_t                     nTotalPcktsRcvd;
 extern adi_wil_pack_t               packInstance;
-extern adi_wil_sensor_data_t        userBMSBuffer[BMS_DATA_PACKET_COUNT];
+extern adi_wil_sensor_data_t        *userBMSBuffer;
 extern DISPLAYSTR ADK_DEMO;
 extern bool OWD_PACKET_RECEIVED;
 extern void adk_debug_Report(ADK_FAIL_API_NAME api, adi_wil_err_t rc );
@@ -242,75 +262,94 @@ void Adbms683x_Monitor_Base_Pkt2(adi_wil_sensor_data_t* BMSBufferPtr)
 void Adbms683x_Monitor_Cell_OWD(adi_wil_device_t eNode)
 {
     uint8_t iCellIndx       = 0U;
-    int32_t iCellData       = 0U;
-    int32_t iCellOWData     = 0U;
-    int32_t iCellDrop       = 0U;
-    int32_t iCellOWThres_p    = 0U;
-    int32_t iCellOWThres_m    = 0U;
+    uint16_t iFaultMask     = 0U;
+    uint16_t iZeroMask      = 0U;
 
+    adi_wil_example_OwdBatch(ADI_OWD_DEVICE, &aiNominalCellData[eNode][0], &aiOWCellData[eNode][0], 1U, &iFaultMask, &iZeroMask);
+
+    /* A zero volt reading counts as a failed check but does not fail the node */
     #if     (ADK_ADBMS683x == 0) /* ADBMS6830 */
-    aiOWStatus[eNode] = SM_ADBMS6830_STATUS_PASS;
-    ADK_DEMO.NODE[eNode].OWD_STAT = SM_ADBMS6830_STATUS_PASS;
+    aiOWStatus[eNode] = (iFaultMask != 0U) ? SM_ADBMS6830_STATUS_FAIL : SM_ADBMS6830_STATUS_PASS;
+    #elif   (ADK_ADBMS683x == 3) /* ADBMS6833 */
+    aiOWStatus[eNode] = (iFaultMask != 0U) ? SM_ADBMS6833_STATUS_FAIL : SM_ADBMS6833_STATUS_PASS;
+    #else   /* Not supported */
+    #endif
+    ADK_DEMO.NODE[eNode].OWD_STAT = aiOWStatus[eNode];
 
-    for(iCellIndx = 0U; iCellIndx < SM_ADBMS6830_TOTAL_CELLS_PER_DEVICE; iCellIndx++)
+    for(iCellIndx = 0U; iCellIndx < ADI_OWD_CELLS_PER_NODE; iCellIndx++)
     {
-        iCellData    = (aiNominalCellData[eNode][iCellIndx] * SM_ADBMS6830_VTG_REG_RESOLUTION) + SM_ADBMS6830_VTG_REG_OFFSET;
-        iCellOWData  = (aiOWCellData[eNode][iCellIndx]      * SM_ADBMS6830_VTG_REG_RESOLUTION) + SM_ADBMS6830_VTG_REG_OFFSET;
-        iCellDrop    = iCellData - iCellOWData;
-
-        iCellOWThres_p = ((iCellData * SM_ADBMS6830_OW_THRESHOLD_PERCENT) / 100);
-        iCellOWThres_m = -((iCellData * SM_ADBMS6830_OW_THRESHOLD_PERCENT) / 100);
-
-        if(aiNominalCellData[eNode][iCellIndx] < SM_ADBMS6830_OW_ZERO_VOL)
+        if ((((iFaultMask | iZeroMask) >> iCellIndx) & 1U) != 0U)
         {
             ADK_DEMO.NODE[eNode].OWD_FAIL[iCellIndx]++;
         }
-        else
-        {
-            if ((iCellDrop > iCellOWThres_p) || (iCellDrop < iCellOWThres_m))
-            {
-                ADK_DEMO.NODE[eNode].OWD_FAIL[iCellIndx]++;
-                aiOWStatus[eNode] = SM_ADBMS6830_STATUS_FAIL;
-                ADK_DEMO.NODE[eNode].OWD_STAT = SM_ADBMS6830_STATUS_FAIL;
-            }
-            else{ /* DEBUG */
-                ADK_DEMO.NODE[eNode].OWD_SUCCESS[iCellIndx]++;
-            }
+        else{ /* DEBUG */
+            ADK_DEMO.NODE[eNode].OWD_SUCCESS[iCellIndx]++;
         }
-    
     }
-    #elif   (ADK_ADBMS683x == 3) /* ADBMS6833 */
-    aiOWStatus[eNode] = SM_ADBMS6833_STATUS_PASS;
-    ADK_DEMO.NODE[eNode].OWD_STAT = SM_ADBMS6833_STATUS_PASS;
+}
 
-    for(iCellIndx = 0U; iCellIndx < SM_ADBMS6833_TOTAL_CELLS_PER_DEVICE; iCellIndx++)
+/**
+ * @brief   Batch Cell Open Wire evaluation
+ *
+ * @details Evaluates the open wire condition of consecutive nodes in a single
+ *          pass over the contiguous nominal and open wire cell codes. Each
+ *          cell is decided from the sign of a threshold difference, without a
+ *          divide or a branch, and collected into the node's bit masks.
+ *
+ * @param  eDevice[in]      Device selecting the thresholds
+ * @param  pNominal[in]     C channel codes, ADI_OWD_CELLS_PER_NODE per node
+ * @param  pOpenWire[in]    S channel codes, ADI_OWD_CELLS_PER_NODE per node
+ * @param  iNodeCount[in]   Nodes to evaluate
+ * @param  pFaultMask[out]  Cells failing the drop threshold, per node
+ * @param  pZeroMask[out]   Cells reading below zero volt, per node
+ *
+ * @return None
+ */
+void adi_wil_example_OwdBatch(adi_owd_device_t eDevice,
+                              int16_t const *pNominal,
+                              int16_t const *pOpenWire,
+                              uint8_t iNodeCount,
+                              uint16_t *pFaultMask,
+                              uint16_t *pZeroMask)
+{
+    const adi_owd_thresholds_t *pThres = &OwdThresholds[eDevice];
+    uint8_t iNode;
+    uint8_t iCellIndx;
+    int32_t iNom;
+    int32_t iDrop;
+    int32_t iSign;
+    uint32_t iFault;
+    uint32_t iZero;
+    uint32_t iFaultMask;
+    uint32_t iZeroMask;
+
+    for (iNode = 0U; iNode < iNodeCount; iNode++)
     {
-        iCellData    = (aiNominalCellData[eNode][iCellIndx] * SM_ADBMS6833_VTG_REG_RESOLUTION) + SM_ADBMS6833_VTG_REG_OFFSET;
-        iCellOWData  = (aiOWCellData[eNode][iCellIndx]      * SM_ADBMS6833_VTG_REG_RESOLUTION) + SM_ADBMS6833_VTG_REG_OFFSET;
-        iCellDrop    = iCellData - iCellOWData;
-
-        iCellOWThres_p = ((iCellData * SM_ADBMS6833_OW_THRESHOLD_PERCENT) / 100);
-        iCellOWThres_m = -((iCellData * SM_ADBMS6833_OW_THRESHOLD_PERCENT) / 100);
+        iFaultMask = 0U;
+        iZeroMask = 0U;
 
-        if(aiNominalCellData[eNode][iCellIndx] < SM_ADBMS6833_OW_ZERO_VOL)
+        for (iCellIndx = 0U; iCellIndx < ADI_OWD_CELLS_PER_NODE; iCellIndx++)
         {
-            ADK_DEMO.NODE[eNode].OWD_FAIL[iCellIndx]++;
-        }
-        else
-        {
-            if ((iCellDrop > iCellOWThres_p) || (iCellDrop < iCellOWThres_m))
-            {
-                ADK_DEMO.NODE[eNode].OWD_FAIL[iCellIndx]++;
-                aiOWStatus[eNode] = SM_ADBMS6833_STATUS_FAIL;
-                ADK_DEMO.NODE[eNode].OWD_STAT = SM_ADBMS6833_STATUS_FAIL;
-            }
-            else{ /* DEBUG */
-                ADK_DEMO.NODE[eNode].OWD_SUCCESS[iCellIndx]++;
-            }
+            iNom  = pNominal[iCellIndx];
+            iDrop = iNom - pOpenWire[iCellIndx];
+
+            /* |iDrop| without a branch */
+            iSign = iDrop >> 31;
+            iDrop = (iDrop ^ iSign) - iSign;
+
+            /* Sign bits: set when the drop exceeds the threshold and when the
+             * nominal reading is below zero volt */
+            iFault = (uint32_t)((pThres->iPercent * (iNom + pThres->iOffsetCode)) - (100 * iDrop)) >> 31;
+            iZero  = (uint32_t)(iNom - pThres->iZeroCode) >> 31;
+
+            iFaultMask |= (iFault & (iZero ^ 1U)) << iCellIndx;
+            iZeroMask  |= iZero << iCellIndx;
         }
-    
-    }
-    #else   /* Not supported */
-    #endif
 
+        pFaultMask[iNode] = (uint16_t)iFaultMask;
+        pZeroMask[iNode]  = (uint16_t)iZeroMask;
+
+        pNominal  += ADI_OWD_CELLS_PER_NODE;
+        pOpenWire += ADI_OWD_CELLS_PER_NODE;
+    }
 }
@@ -0,0 +1,276 @@
+/*******************************************************************************
+ * @file     adi_wil_example_pec.c
+ *
+ * @brief    ADBMS683x packet error codes
+ *
+ * @details  Table driven PEC15 and PEC10. The PEC10 table holds the remainder
+ *           of each byte shifted through the 10 bit register, so a data byte
+ *           costs one lookup instead of eight conditional shifts. Used to
+ *           build ModifyScript payloads and to check the register groups
+ *           received in BMS packets.
+ *
+ * Copyright (c) 2020-2022 Analog Devices, Inc. All Rights Reserved.
+ * This software is proprietary and confidential to Analog Devices, Inc. and its licensors.
+ *******************************************************************************/
+
+#include <string.h>
+
+#include "adi_wil_example_pec.h"
+#include "adi_wil_example_config.h"
+#if (ADI_WIL_EX_PEC_BENCHMARK == 1)
+#include "adi_wil_example_printf.h"
+#include "IfxStm.h"
+#endif
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define ADI_PEC10_SEED                  16u         /* 0000010000 */
+#define ADI_PEC10_POLY                  0x8Fu       /* x10 + x7 + x3 + x2 + x + 1 */
+#define ADI_PEC10_MASK                  0x3FFu
+#define ADI_PEC15_SEED                  16u
+#define ADI_PEC_BENCH_ROUNDS            1000u
+#define STM                             &MODULE_STM0
+
+/******************************************************************************
+ * Static variable declarations
+ *****************************************************************************/
+/* Precomputed CRC15 Table */
+static const uint16_t adi_Crc15Table[256] ={
+    0x0000, 0xc599, 0xceab, 0x0b32, 0xd8cf, 0x1d56, 0x1664, 0xd3fd, 0xf407, 0x319e,
+    0x3aac, 0xff35, 0x2cc8, 0xe951, 0xe263, 0x27fa, 0xad97, 0x680e, 0x633c, 0xa6a5,
+    0x7558, 0xb0c1, 0xbbf3, 0x7e6a, 0x5990, 0x9c09, 0x973b, 0x52a2, 0x815f, 0x44c6,
+    0x4ff4, 0x8a6d, 0x5b2e, 0x9eb7, 0x9585, 0x501c, 0x83e1, 0x4678, 0x4d4a, 0x88d3,
+    0xaf29, 0x6ab0, 0x6182, 0xa41b, 0x77e6, 0xb27f, 0xb94d, 0x7cd4, 0xf6b9, 0x3320,
+    0x3812, 0xfd8b, 0x2e76, 0xebef, 0xe0dd, 0x2544, 0x02be, 0xc727, 0xcc15, 0x098c,
+    0xda71, 0x1fe8, 0x14da, 0xd143, 0xf3c5, 0x365c, 0x3d6e, 0xf8f7, 0x2b0a, 0xee93,
+    0xe5a1, 0x2038, 0x07c2, 0xc25b, 0xc969, 0x0cf0, 0xdf0d, 0x1a94, 0x11a6, 0xd43f,
+    0x5e52, 0x9bcb, 0x90f9, 0x5560, 0x869d, 0x4304, 0x4836, 0x8daf, 0xaa55, 0x6fcc,
+    0x64fe, 0xa167, 0x729a, 0xb703, 0xbc31, 0x79a8, 0xa8eb, 0x6d72, 0x6640, 0xa3d9,
+    0x7024, 0xb5bd, 0xbe8f, 0x7b16, 0x5cec, 0x9975, 0x9247, 0x57de, 0x8423, 0x41ba,
+    0x4a88, 0x8f11, 0x057c, 0xc0e5, 0xcbd7, 0x0e4e, 0xddb3, 0x182a, 0x1318, 0xd681,
+    0xf17b, 0x34e2, 0x3fd0, 0xfa49, 0x29b4, 0xec2d, 0xe71f, 0x2286, 0xa213, 0x678a,
+    0x6cb8, 0xa921, 0x7adc, 0xbf45, 0xb477, 0x71ee, 0x5614, 0x938d, 0x98bf, 0x5d26,
+    0x8edb, 0x4b42, 0x4070, 0x85e9, 0x0f84, 0xca1d, 0xc12f, 0x04b6, 0xd74b, 0x12d2,
+    0x19e0, 0xdc79, 0xfb83, 0x3e1a, 0x3528, 0xf0b1, 0x234c, 0xe6d5, 0xede7, 0x287e,
+    0xf93d, 0x3ca4, 0x3796, 0xf20f, 0x21f2, 0xe46b, 0xef59, 0x2ac0, 0x0d3a, 0xc8a3,
+    0xc391, 0x0608, 0xd5f5, 0x106c, 0x1b5e, 0xdec7, 0x54aa, 0x9133, 0x9a01, 0x5f98,
+    0x8c65, 0x49fc, 0x42ce, 0x8757, 0xa0ad, 0x6534, 0x6e06, 0xab9f, 0x7862, 0xbdfb,
+    0xb6c9, 0x7350, 0x51d6, 0x944f, 0x9f7d, 0x5ae4, 0x8919, 0x4c80, 0x47b2, 0x822b,
+    0xa5d1, 0x6048, 0x6b7a, 0xaee3, 0x7d1e, 0xb887, 0xb3b5, 0x762c, 0xfc41, 0x39d8,
+    0x32ea, 0xf773, 0x248e, 0xe117, 0xea25, 0x2fbc, 0x0846, 0xcddf, 0xc6ed, 0x0374,
+    0xd089, 0x1510, 0x1e22, 0xdbbb, 0x0af8, 0xcf61, 0xc453, 0x01ca, 0xd237, 0x17ae,
+    0x1c9c, 0xd905, 0xfeff, 0x3b66, 0x3054, 0xf5cd, 0x2630, 0xe3a9, 0xe89b, 0x2d02,
+    0xa76f, 0x62f6, 0x69c4, 0xac5d, 0x7fa0, 0xba39, 0xb10b, 0x7492, 0x5368, 0x96f1,
+    0x9dc3, 0x585a, 0x8ba7, 0x4e3e, 0x450c, 0x8095
+};
+
+/* PEC10 remainder of (i << 2) after eight shifts */
+static const uint16_t adi_Crc10Table[256] = {
+    0x000, 0x08f, 0x11e, 0x191, 0x23c, 0x2b3, 0x322, 0x3ad, 0x0f7, 0x078,
+    0x1e9, 0x166, 0x2cb, 0x244, 0x3d5, 0x35a, 0x1ee, 0x161, 0x0f0, 0x07f,
+    0x3d2, 0x35d, 0x2cc, 0x243, 0x119, 0x196, 0x007, 0x088, 0x325, 0x3aa,
+    0x23b, 0x2b4, 0x3dc, 0x353, 0x2c2, 0x24d, 0x1e0, 0x16f, 0x0fe, 0x071,
+    0x32b, 0x3a4, 0x235, 0x2ba, 0x117, 0x198, 0x009, 0x086, 0x232, 0x2bd,
+    0x32c, 0x3a3, 0x00e, 0x081, 0x110, 0x19f, 0x2c5, 0x24a, 0x3db, 0x354,
+    0x0f9, 0x076, 0x1e7, 0x168, 0x337, 0x3b8, 0x229, 0x2a6, 0x10b, 0x184,
+    0x015, 0x09a, 0x3c0, 0x34f, 0x2de, 0x251, 0x1fc, 0x173, 0x0e2, 0x06d,
+    0x2d9, 0x256, 0x3c7, 0x348, 0x0e5, 0x06a, 0x1fb, 0x174, 0x22e, 0x2a1,
+    0x330, 0x3bf, 0x012, 0x09d, 0x10c, 0x183, 0x0eb, 0x064, 0x1f5, 0x17a,
+    0x2d7, 0x258, 0x3c9, 0x346, 0x01c, 0x093, 0x102, 0x18d, 0x220, 0x2af,
+    0x33e, 0x3b1, 0x105, 0x18a, 0x01b, 0x094, 0x339, 0x3b6, 0x227, 0x2a8,
+    0x1f2, 0x17d, 0x0ec, 0x063, 0x3ce, 0x341, 0x2d0, 0x25f, 0x2e1, 0x26e,
+    0x3ff, 0x370, 0x0dd, 0x052, 0x1c3, 0x14c, 0x216, 0x299, 0x308, 0x387,
+    0x02a, 0x0a5, 0x134, 0x1bb, 0x30f, 0x380, 0x211, 0x29e, 0x133, 0x1bc,
+    0x02d, 0x0a2, 0x3f8, 0x377, 0x2e6, 0x269, 0x1c4, 0x14b, 0x0da, 0x055,
+    0x13d, 0x1b2, 0x023, 0x0ac, 0x301, 0x38e, 0x21f, 0x290, 0x1ca, 0x145,
+    0x0d4, 0x05b, 0x3f6, 0x379, 0x2e8, 0x267, 0x0d3, 0x05c, 0x1cd, 0x142,
+    0x2ef, 0x260, 0x3f1, 0x37e, 0x024, 0x0ab, 0x13a, 0x1b5, 0x218, 0x297,
+    0x306, 0x389, 0x1d6, 0x159, 0x0c8, 0x047, 0x3ea, 0x365, 0x2f4, 0x27b,
+    0x121, 0x1ae, 0x03f, 0x0b0, 0x31d, 0x392, 0x203, 0x28c, 0x038, 0x0b7,
+    0x126, 0x1a9, 0x204, 0x28b, 0x31a, 0x395, 0x0cf, 0x040, 0x1d1, 0x15e,
+    0x2f3, 0x27c, 0x3ed, 0x362, 0x20a, 0x285, 0x314, 0x39b, 0x036, 0x0b9,
+    0x128, 0x1a7, 0x2fd, 0x272, 0x3e3, 0x36c, 0x0c1, 0x04e, 0x1df, 0x150,
+    0x3e4, 0x36b, 0x2fa, 0x275, 0x1d8, 0x157, 0x0c6, 0x049, 0x313, 0x39c,
+    0x20d, 0x282, 0x12f, 0x1a0, 0x031, 0x0be
+};
+
+#if (ADI_WIL_EX_PEC_BENCHMARK == 1)
+extern Ifx_TickTime g_ticksFor1ms;
+
+static volatile uint16_t iPecBenchSink;
+#endif
+
+/******************************************************************************
+ * Static functions
+ *****************************************************************************/
+#if (ADI_WIL_EX_PEC_BENCHMARK == 1)
+static uint16_t adi_pec10_CalcBitwise(uint8_t const *pData, uint8_t iLen, bool bRxCmd);
+static uint32_t adi_pec_TicksToNs(uint32_t iTicks, uint32_t iCount);
+#endif
+
+/*******************************************************************************
+ * Funtion definitions
+ ******************************************************************************/
+uint16_t adi_pec15_Calc(uint8_t len, /* Number of bytes that will be used to calculate a PEC */
+                        uint8_t *data /* Array of data that will be used to calculate  a PEC */
+                        )
+{
+    uint16_t remainder, addr;
+    remainder = ADI_PEC15_SEED; /* initialize the PEC */
+
+    for (uint8_t i = 0; i<len; i++) /* loops for each byte in data array */
+    {
+        addr = (((remainder>>7)^data[i])&0xff); /* calculate PEC table address */
+        remainder = ((remainder<<8)^adi_Crc15Table[addr]);
+    }
+
+    return(remainder*2); /* The CRC15 has a 0 in the LSB so the remainder must be multiplied by 2 */
+}
+
+uint16_t adi_pec10_Calc(uint8_t const *pData, uint8_t iLen, bool bRxCmd)
+{
+    uint16_t iRemainder = ADI_PEC10_SEED;
+    uint8_t i;
+
+    for (i = 0u; i < iLen; i++)
+    {
+        /* The two low remainder bits are only shifted up by a byte, the
+         * eight above them select the table entry together with the data */
+        iRemainder = (uint16_t)(((iRemainder & 0x3u) << 8) ^ adi_Crc10Table[((iRemainder >> 2) ^ pData[i]) & 0xFFu]);
+    }
+
+    if (bRxCmd)
+    {
+        /* The command counter is 6 bits, shifted in bitwise */
+        iRemainder ^= (uint16_t)((pData[iLen] & 0xFCu) << 2);
+        for (i = 0u; i < 6u; i++)
+        {
+            iRemainder = (uint16_t)((iRemainder << 1) ^ (((iRemainder & 0x200u) != 0u) ? ADI_PEC10_POLY : 0u));
+        }
+    }
+
+    return (uint16_t)(iRemainder & ADI_PEC10_MASK);
+}
+
+bool adi_pec10_CheckGroup(uint8_t const *pGroup)
+{
+    uint16_t iReceived = (uint16_t)(((pGroup[ADI_PEC_GROUP_DATA_SIZE] & 0x3u) << 8) | pGroup[ADI_PEC_GROUP_DATA_SIZE + 1u]);
+
+    return (adi_pec10_Calc(pGroup, ADI_PEC_GROUP_DATA_SIZE, true) == iReceived);
+}
+
+uint16_t adi_pec10_CheckGroups(uint8_t const *pGroups, uint8_t iCount)
+{
+    uint16_t iFailed = 0u;
+    uint8_t i;
+
+    for (i = 0u; (i < iCount) && (i < 16u); i++)
+    {
+        if (!adi_pec10_CheckGroup(&pGroups[i * ADI_PEC_GROUP_SIZE]))
+        {
+            iFailed |= (uint16_t)(1u << i);
+        }
+    }
+
+    return iFailed;
+}
+
+#if (ADI_WIL_EX_PEC_BENCHMARK == 1)
+void adi_wil_example_PecBenchmark(void)
+{
+    /* One BMS base packet 0 worth of register groups */
+    static uint8_t Groups[9u * ADI_PEC_GROUP_SIZE];
+    uint32_t iStart;
+    uint32_t iBitTicks, iTableTicks, iPec15Ticks;
+    uint32_t iRound;
+    uint16_t iPec;
+    uint8_t i;
+
+    for (i = 0u; i < sizeof(Groups); i++)
+    {
+        Groups[i] = (uint8_t)((i * 37u) + 11u);
+    }
+    for (i = 0u; i < 9u; i++)
+    {
+        iPec = adi_pec10_Calc(&Groups[i * ADI_PEC_GROUP_SIZE], ADI_PEC_GROUP_DATA_SIZE, true);
+        Groups[(i * ADI_PEC_GROUP_SIZE) + 6u] = (uint8_t)((Groups[(i * ADI_PEC_GROUP_SIZE) + 6u] & 0xFCu) | (iPec >> 8));
+        Groups[(i * ADI_PEC_GROUP_SIZE) + 7u] = (uint8_t)iPec;
+    }
+
+    iStart = IfxStm_getLower(STM);
+    for (iRound = 0; iRound < ADI_PEC_BENCH_ROUNDS; iRound++)
+    {
+        iPecBenchSink = adi_pec10_CalcBitwise(&Groups[(iRound % 9u) * ADI_PEC_GROUP_SIZE], ADI_PEC_GROUP_DATA_SIZE, true);
+    }
+    iBitTicks = IfxStm_getLower(STM) - iStart;
+
+    iStart = IfxStm_getLower(STM);
+    for (iRound = 0; iRound < ADI_PEC_BENCH_ROUNDS; iRound++)
+    {
+        iPecBenchSink = adi_pec10_Calc(&Groups[(iRound % 9u) * ADI_PEC_GROUP_SIZE], ADI_PEC_GROUP_DATA_SIZE, true);
+    }
+    iTableTicks = IfxStm_getLower(STM) - iStart;
+
+    iStart = IfxStm_getLower(STM);
+    for (iRound = 0; iRound < ADI_PEC_BENCH_ROUNDS; iRound++)
+    {
+        iPecBenchSink = adi_pec15_Calc(ADI_PEC_GROUP_DATA_SIZE, &Groups[(iRound % 9u) * ADI_PEC_GROUP_SIZE]);
+    }
+    iPec15Ticks = IfxStm_getLower(STM) - iStart;
+
+    adi_wil_ex_printf("%-24s %10s" LINE_END, "PEC (ns per group)", "time");
+    adi_wil_ex_printf("%-24s %10u" LINE_END, "PEC10 bitwise",
+                      (unsigned int)adi_pec_TicksToNs(iBitTicks, ADI_PEC_BENCH_ROUNDS));
+    adi_wil_ex_printf("%-24s %10u" LINE_END, "PEC10 table",
+                      (unsigned int)adi_pec_TicksToNs(iTableTicks, ADI_PEC_BENCH_ROUNDS));
+    adi_wil_ex_printf("%-24s %10u" LINE_END, "PEC15 table",
+                      (unsigned int)adi_pec_TicksToNs(iPec15Ticks, ADI_PEC_BENCH_ROUNDS));
+    adi_wil_ex_printf("%-24s %10u" LINE_END, "62 nodes x 22 groups (us)",
+                      (unsigned int)(adi_pec_TicksToNs(iTableTicks, ADI_PEC_BENCH_ROUNDS) * 62u * 22u / 1000u));
+    adi_wil_ex_printf("PEC10 check of the packet : %s" LINE_END,
+                      (adi_pec10_CheckGroups(Groups, 9u) == 0u) ? "pass" : "FAIL");
+}
+
+/* The bit at a time PEC10 the table replaced, kept as the benchmark reference */
+static uint16_t adi_pec10_CalcBitwise(uint8_t const *pData, uint8_t iLen, bool bRxCmd)
+{
+    uint16_t remainder = ADI_PEC10_SEED;
+    uint16_t polynom = ADI_PEC10_POLY;
+
+    for (uint8_t pbyte = 0; pbyte < iLen; ++pbyte)
+    {
+        remainder ^= (uint16_t)(pData[pbyte] << 2);
+
+        for (uint8_t bit_ = 8; bit_ > 0; --bit_)
+        {
+            if ((remainder & 0x200) > 0) {
+                remainder = (uint16_t)((remainder << 1));
+                remainder = (uint16_t)(remainder ^ polynom);
+            } else {
+                remainder = (uint16_t)(remainder << 1);
+            }
+        }
+    }
+
+    if (bRxCmd) {
+        remainder ^= (uint16_t)((pData[iLen] & 0xFC) << 2);
+
+        for (uint8_t bit_ = 6; bit_ > 0; --bit_)
+        {
+            if ((remainder & 0x200) > 0) {
+                remainder = (uint16_t)((remainder << 1));
+                remainder = (uint16_t)(remainder ^ polynom);
+            } else {
+                remainder = (uint16_t)((remainder << 1));
+            }
+        }
+    }
+    return ((uint16_t)(remainder & ADI_PEC10_MASK));
+}
+
+static uint32_t adi_pec_TicksToNs(uint32_t iTicks, uint32_t iCount)
+{
+    return ((g_ticksFor1ms > 0) && (iCount > 0u)) ? (uint32_t)(((uint64_t)iTicks * 1000000u) / ((uint64_t)g_ticksFor1ms * iCount)) : 0u;
+}
+#endif
@@ -1,15 +1,22 @@
 /*******************************************************************************
 * @brief    Print utilities
 *
-* @details  Set of printf-like functions which send their output to host device's UART-to_USB bridge
+* @details  Set of printf-like functions which send their output to host device's UART-to_USB bridge.
+*           With ADI_WIL_EX_LOG_DEFERRED the functions only queue a binary record
+*           (format string address + raw arguments) and adi_wil_ex_LogDrain()
+*           streams the queue to the UART without blocking.
 *
 * Copyright (c) 2021 Analog Devices, Inc. All Rights Reserved.
 * This software is proprietary and confidential to Analog Devices, Inc. and its licensors.
 *******************************************************************************/
 #include "adi_wil_example_printf.h"
 #include <stdarg.h>
+#include <string.h>
 #include "IfxAsclin_Asc.h"
+#include "IfxCpu.h"
 #include "adi_wil_example_isr_priorities.h"
+#include "adi_wil_example_config.h"
+#include "adi_wil_hal_ticker.h"
 
 
 #define ASCLIN_TX_BUFFER_SIZE (256)         /* Number of characters in the transmit buffer */
@@ -24,6 +31,22 @@
 #define ASCLIN_ENDLINE        "\r\n"        /* Macro for end-of-line character sequence (can be overridden by application) */
 #endif
 
+#if (ADI_WIL_EX_LOG_DEFERRED == 1)
+#define LOG_RING_BYTES        (ADI_WIL_EX_LOG_RING_WORDS * 4u)
+#define LOG_SYNC              (0xA55Au)     /* Upper half of every record header, lets the host resync */
+#define LOG_LEVEL_PRINTF      (0u)
+#define LOG_LEVEL_INFO        (1u)
+#define LOG_LEVEL_ERROR       (2u)
+#define LOG_LEVEL_FATAL       (3u)
+#define LOG_LEVEL_DROPPED     (0xFFu)       /* Arguments: number of records lost since the last one sent */
+#define LOG_HEADER_WORDS      (3u)          /* Header, format address, timestamp */
+#define LOG_LOCK_TIMEOUT      (0x1000u)     /* Spin attempts before a record is dropped */
+
+#if ((ADI_WIL_EX_LOG_RING_WORDS & (ADI_WIL_EX_LOG_RING_WORDS - 1u)) != 0u)
+#error "ADI_WIL_EX_LOG_RING_WORDS must be a power of two"
+#endif
+#endif
+
 /* Application Asclin instance */
 static IfxAsclin_Asc asc;
 
@@ -38,6 +61,24 @@ static uint8 ascTxBuffer[ASCLIN_TX_BUFFER_SIZE + sizeof(Ifx_Fifo) + ASCLIN_RX_BU
 */
 static uint8 ascRxBuffer[ASCLIN_RX_BUFFER_SIZE + sizeof(Ifx_Fifo) + ASCLIN_RX_BUFFER_PADDING];
 
+/* Set once the ASCLIN module is configured, the drain does nothing before that */
+static bool bAscReady = false;
+
+#if (ADI_WIL_EX_LOG_DEFERRED == 1)
+/*
+    Deferred log ring. Producers (main loop, WIL callbacks in ISR context, other cores)
+    append whole records with interrupts disabled and LogLock held; adi_wil_ex_LogDrain()
+    is the only consumer. Head and tail are free-running byte counts.
+*/
+static IfxCpu_spinLock LogLock;
+static uint32 LogRing[ADI_WIL_EX_LOG_RING_WORDS];
+static volatile uint32 iLogHead;
+static volatile uint32 iLogTail;
+static uint32 iLogDroppedPending;
+static volatile uint32 iLogLockDroppedPending;  /* Records lost to the lock timeout, counted without the lock */
+uint32 adi_wil_ex_LogDroppedCount;          /* Total records lost, for the debugger */
+#endif
+
 
 
 /* Tx ISR. When called, it refills the ASCLIN hardware FIFO (16 bytes) with characters from the transmit buffer */
@@ -113,6 +154,282 @@ void adi_wil_ex_printfInit(void)
 
     /* Initialize module  */
     IfxAsclin_Asc_initModule(&asc, &ascConfig);
+
+    bAscReady = true;
+}
+
+#if (ADI_WIL_EX_LOG_DEFERRED == 1)
+/*
+ * Captures the arguments of one printf-style call as raw 32-bit words.
+ * Integers and pointers take one word, 64-bit integers and doubles two (low word first),
+ * %s takes a length word followed by up to ADI_WIL_EX_LOG_MAX_STRING characters.
+ *
+ * @arguments : pWords - destination, iMaxWords - its capacity, format/args - printf arguments
+ *
+ * @return number of words written
+ */
+static uint32 adi_wil_ex_LogCaptureArgs(uint32 * pWords, uint32 iMaxWords, const char * format, va_list * pArgs)
+{
+    uint32 iCount = 0u;
+    const char * p = format;
+
+    while ((*p != '\0') && (iCount < iMaxWords))
+    {
+        if (*p++ != '%')
+        {
+            continue;
+        }
+        if (*p == '%')
+        {
+            p++;
+            continue;
+        }
+
+        /* Flags */
+        while ((*p == '-') || (*p == '+') || (*p == ' ') || (*p == '#') || (*p == '0'))
+        {
+            p++;
+        }
+
+        /* Width and precision, '*' consumes an int argument */
+        for (uint8 iField = 0u; iField < 2u; iField++)
+        {
+            if (*p == '*')
+            {
+                pWords[iCount++] = (uint32)va_arg(*pArgs, int);
+                p++;
+            }
+            else
+            {
+                while ((*p >= '0') && (*p <= '9'))
+                {
+                    p++;
+                }
+            }
+            if ((iField == 0u) && (*p == '.'))
+            {
+                p++;
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        /* Length modifier, only ll/j change the argument size on TriCore */
+        bool bWide = false;
+        while ((*p == 'h') || (*p == 'l') || (*p == 'z') || (*p == 't') || (*p == 'j') || (*p == 'L'))
+        {
+            bWide = bWide || (*p == 'j') || ((*p == 'l') && (p[1] == 'l'));
+            p++;
+        }
+
+        if (iCount + 2u > iMaxWords)
+        {
+            break;
+        }
+
+        switch (*p)
+        {
+            case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+            {
+                double fValue = va_arg(*pArgs, double);
+                uint64 iBits;
+                (void)memcpy(&iBits, &fValue, sizeof(iBits));
+                pWords[iCount++] = (uint32)iBits;
+                pWords[iCount++] = (uint32)(iBits >> 32);
+                break;
+            }
+            case 's':
+            {
+                const char * pStr = va_arg(*pArgs, const char *);
+                uint32 iLen = 0u;
+                if (pStr != NULL_PTR)
+                {
+                    while ((iLen < ADI_WIL_EX_LOG_MAX_STRING) && (pStr[iLen] != '\0'))
+                    {
+                        iLen++;
+                    }
+                }
+                if ((iCount + 1u + ((iLen + 3u) / 4u)) > iMaxWords)
+                {
+                    /* Truncate to what still fits */
+                    iLen = (iMaxWords - iCount - 1u) * 4u;
+                }
+                pWords[iCount++] = iLen;
+                if (iLen != 0u)
+                {
+                    pWords[iCount + ((iLen - 1u) / 4u)] = 0u;
+                    (void)memcpy(&pWords[iCount], pStr, iLen);
+                    iCount += (iLen + 3u) / 4u;
+                }
+                break;
+            }
+            case 'n':
+                (void)va_arg(*pArgs, void *);
+                break;
+            case '\0':
+                p--;
+                break;
+            default:
+                if (bWide)
+                {
+                    uint64 iValue = va_arg(*pArgs, uint64);
+                    pWords[iCount++] = (uint32)iValue;
+                    pWords[iCount++] = (uint32)(iValue >> 32);
+                }
+                else
+                {
+                    pWords[iCount++] = (uint32)va_arg(*pArgs, unsigned int);
+                }
+                break;
+        }
+        p++;
+    }
+
+    return iCount;
+}
+
+/*
+ * Appends one record to the log ring. Whole records are queued or dropped, never split.
+ *
+ * @arguments : pRecord - record words, iWords - record length in words
+ *
+ * @return true if queued
+ */
+static bool adi_wil_ex_LogPush(const uint32 * pRecord, uint32 iWords)
+{
+    uint32 aDropped[LOG_HEADER_WORDS + 1u];
+    uint32 iBytes = iWords * 4u;
+    uint32 iNeeded;
+    uint32 iLockDropped;
+    bool bQueued = false;
+    boolean bIntEnabled = IfxCpu_disableInterrupts();
+
+    /* Disabling interrupts only keeps this core out, the spin lock keeps the others out */
+    if (IfxCpu_setSpinLock(&LogLock, LOG_LOCK_TIMEOUT) == FALSE)
+    {
+        /* Another core may be counting as well, the next record holding the lock reports them */
+        do
+        {
+            iLockDropped = iLogLockDroppedPending;
+        } while (Ifx__cmpAndSwap((unsigned int volatile *)&iLogLockDroppedPending, iLockDropped + 1u, iLockDropped) != iLockDropped);
+        IfxCpu_restoreInterrupts(bIntEnabled);
+        return false;
+    }
+
+    /* Fold the lock timeouts into the DROPPED record */
+    do
+    {
+        iLockDropped = iLogLockDroppedPending;
+    } while ((iLockDropped != 0u) && (Ifx__cmpAndSwap((unsigned int volatile *)&iLogLockDroppedPending, 0u, iLockDropped) != iLockDropped));
+    iLogDroppedPending += iLockDropped;
+    adi_wil_ex_LogDroppedCount += iLockDropped;
+
+    /* Report earlier losses first so the host sees them in order */
+    iNeeded = (iLogDroppedPending != 0u) ? (iBytes + sizeof(aDropped)) : iBytes;
+
+    if ((LOG_RING_BYTES - (iLogHead - iLogTail)) >= iNeeded)
+    {
+        if (iLogDroppedPending != 0u)
+        {
+            aDropped[0] = (LOG_SYNC << 16) | (LOG_LEVEL_DROPPED << 8) | (LOG_HEADER_WORDS + 1u);
+            aDropped[1] = 0u;
+            aDropped[2] = adi_wil_hal_TickerGetTimestamp();
+            aDropped[3] = iLogDroppedPending;
+            iLogDroppedPending = 0u;
+            for (uint32 i = 0u; i < (LOG_HEADER_WORDS + 1u); i++)
+            {
+                LogRing[((iLogHead / 4u) + i) & (ADI_WIL_EX_LOG_RING_WORDS - 1u)] = aDropped[i];
+            }
+            iLogHead += sizeof(aDropped);
+        }
+
+        for (uint32 i = 0u; i < iWords; i++)
+        {
+            LogRing[((iLogHead / 4u) + i) & (ADI_WIL_EX_LOG_RING_WORDS - 1u)] = pRecord[i];
+        }
+        iLogHead += iBytes;
+        bQueued = true;
+    }
+    else
+    {
+        iLogDroppedPending++;
+        adi_wil_ex_LogDroppedCount++;
+    }
+
+    IfxCpu_resetSpinLock(&LogLock);
+    IfxCpu_restoreInterrupts(bIntEnabled);
+
+    return bQueued;
+}
+
+/*
+ * Builds and queues one deferred record.
+ *
+ * @arguments : iLevel - LOG_LEVEL_xxx, format/args - printf arguments
+ *
+ * @return number of bytes queued, 0 if the record was dropped
+ */
+static int adi_wil_ex_LogRecord(uint32 iLevel, const char * format, va_list * pArgs)
+{
+    uint32 aRecord[ADI_WIL_EX_LOG_MAX_WORDS];
+    uint32 iWords;
+
+    iWords = LOG_HEADER_WORDS + adi_wil_ex_LogCaptureArgs(&aRecord[LOG_HEADER_WORDS],
+                                                          ADI_WIL_EX_LOG_MAX_WORDS - LOG_HEADER_WORDS,
+                                                          format, pArgs);
+
+    aRecord[0] = (LOG_SYNC << 16) | (iLevel << 8) | iWords;
+    aRecord[1] = (uint32)format;
+    aRecord[2] = adi_wil_hal_TickerGetTimestamp();
+
+    return adi_wil_ex_LogPush(&aRecord[0], iWords) ? (int)(iWords * 4u) : 0;
+}
+#endif
+
+/*
+ * Streams queued log records to the UART without blocking. Call from the idle loop;
+ * each call hands over as many bytes as the ASCLIN software FIFO can take.
+ *
+ * @arguments : none
+ *
+ * @return none
+ */
+void adi_wil_ex_LogDrain(void)
+{
+#if (ADI_WIL_EX_LOG_DEFERRED == 1)
+    uint32 iTail = iLogTail;
+    uint32 iPending = iLogHead - iTail;
+    uint32 iOffset = iTail & (LOG_RING_BYTES - 1u);
+    sint32 iFree;
+    Ifx_SizeT iCount;
+
+    if ((!bAscReady) || (iPending == 0u))
+    {
+        return;
+    }
+
+    iFree = IfxAsclin_Asc_getWriteCount(&asc);
+    if (iFree <= 0)
+    {
+        return;
+    }
+
+    /* Contiguous part only, the rest goes out on the next call */
+    if (iPending > (LOG_RING_BYTES - iOffset))
+    {
+        iPending = LOG_RING_BYTES - iOffset;
+    }
+    if (iPending > (uint32)iFree)
+    {
+        iPending = (uint32)iFree;
+    }
+
+    iCount = (Ifx_SizeT)iPending;
+    (void)IfxAsclin_Asc_write(&asc, &((const uint8 *)LogRing)[iOffset], &iCount, TIME_NULL);
+    iLogTail = iTail + (uint32)iCount;
+#endif
 }
 
 /*
@@ -122,13 +439,17 @@ void adi_wil_ex_printfInit(void)
  *
  * @arguments : same as standard printf()
  *
- * @return number of characters printed
+ * @return number of characters printed (deferred: bytes queued, 0 if dropped)
  */
 int adi_wil_ex_printf(const char * format, ...) __format__(printf,1,2)
 {
     va_list args;
     va_start(args, format);
+#if (ADI_WIL_EX_LOG_DEFERRED == 1)
+    int iCharCount = adi_wil_ex_LogRecord(LOG_LEVEL_PRINTF, format, &args);
+#else
     int iCharCount = vprintf(format, args);
+#endif
     va_end(args);
 
     return iCharCount;
@@ -140,14 +461,19 @@ int adi_wil_ex_printf(const char * format, ...) __format__(printf,1,2)
  *
  * @arguments : same as standard printf()
  *
- * @return number of characters printed
+ * @return number of characters printed (deferred: bytes queued, 0 if dropped)
  */
 int adi_wil_ex_info(const char * format, ...) __format__(printf,1,2)
 {
-    int iCharCount = printf(ASCLIN_ENDLINE "[INFO] ");
     va_list args;
+#if (ADI_WIL_EX_LOG_DEFERRED == 1)
+    va_start(args, format);
+    int iCharCount = adi_wil_ex_LogRecord(LOG_LEVEL_INFO, format, &args);
+#else
+    int iCharCount = printf(ASCLIN_ENDLINE "[INFO] ");
     va_start(args, format);
     iCharCount += vprintf(format, args);
+#endif
     va_end(args);
 
     return iCharCount;
@@ -159,14 +485,19 @@ int adi_wil_ex_info(const char * format, ...) __format__(printf,1,2)
  *
  * @arguments : same as standard printf()
  *
- * @return number of characters printed
+ * @return number of characters printed (deferred: bytes queued, 0 if dropped)
  */
 int adi_wil_ex_error(const char * format, ...) __format__(printf,1,2)
 {
-    int iCharCount = printf(ASCLIN_ENDLINE "[ERROR] ");
     va_list args;
+#if (ADI_WIL_EX_LOG_DEFERRED == 1)
+    va_start(args, format);
+    int iCharCount = adi_wil_ex_LogRecord(LOG_LEVEL_ERROR, format, &args);
+#else
+    int iCharCount = printf(ASCLIN_ENDLINE "[ERROR] ");
     va_start(args, format);
     iCharCount += vprintf(format, args);
+#endif
     va_end(args);
 
     return iCharCount;
@@ -178,14 +509,19 @@ int adi_wil_ex_error(const char * format, ...) __format__(printf,1,2)
  *
  * @arguments : same as standard printf()
  *
- * @return number of characters printed
+ * @return number of characters printed (deferred: bytes queued, 0 if dropped)
  */
 int adi_wil_ex_fatal(const char * format, ...) __format__(printf,1,2)
 {
-    int iCharCount = printf(ASCLIN_ENDLINE "[FATAL] ");
     va_list args;
+#if (ADI_WIL_EX_LOG_DEFERRED == 1)
+    va_start(args, format);
+    int iCharCount = adi_wil_ex_LogRecord(LOG_LEVEL_FATAL, format, &args);
+#else
+    int iCharCount = printf(ASCLIN_ENDLINE "[FATAL] ");
     va_start(args, format);
     iCharCount += vprintf(format, args);
+#endif
     va_end(args);
 
     return iCharCount;
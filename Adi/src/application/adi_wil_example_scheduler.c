@@ -9,6 +9,7 @@
 * This software is proprietary and confidential to Analog Devices, Inc. and its licensors.
 *******************************************************************************/
 #include <stdint.h>
+#include <string.h>
 #include "adi_wil_example_scheduler.h"
 #include "adi_wil_example_utilities.h"
 #include "adi_wil_example_owd.h"
@@ -17,16 +18,37 @@
 #include "IfxStm.h"
 
 #include "adi_wil_example_debug_functions.h"
+#include "adi_wil_example_printf.h"
+#include "adi_wil_example_w2can.h"
+#include "adi_wil_example_event_bus.h"
+#include "adi_wil_hal_trace.h"
 
 #define STM                     &MODULE_STM0                    /* STM0 is used in this example                     */
 
 /*******************************************************************************/
 /* Local MACRO Declarations                                                    */
 /*******************************************************************************/
+/* Suspend the core until the next interrupt (TriCore 1.6.2 WAIT instruction) */
+#if defined(__TASKING__)
+#define SCHDLR_CPU_WAIT()               __asm("wait")
+#elif defined(__GNUC__)
+#define SCHDLR_CPU_WAIT()               __asm__ volatile ("wait" ::: "memory")
+#else
+#define SCHDLR_CPU_WAIT()
+#endif
+
+/* Wrap safe "time t has been reached" on the free running ms counter */
+#define SCHDLR_TIME_REACHED(now, t)     ((int32_t)((uint32_t)(now) - (uint32_t)(t)) >= 0)
 
 /*******************************************************************************/
 /* User Defined Type                                                           */
 /*******************************************************************************/
+typedef struct
+{
+    SchedulerEntry_t *pEntry;
+    uint32_t iPeriod;                   /* ms */
+    uint32_t iDeadline;                 /* ms after release */
+}SchedulerTask_t;
 
 /*******************************************************************************/
 /* Global Variable Declarations                                                */
@@ -34,21 +56,41 @@
 
 extern IfxStm_CompareConfig g_STMConf;                               /* STM configuration structure                      */
 extern Ifx_TickTime g_ticksFor1ms;                                   /* Variable to store the number of ticks to wait    */
-extern unsigned int Schdlr_CurrentMsCount;                           /* @remark  : static removed */  
-extern bool Schdlr_1ms_tick;                                         /* @remark  : static removed */  
+extern volatile unsigned int Schdlr_CurrentMsCount;                  /* @remark  : static removed */  
+extern volatile bool Schdlr_1ms_tick;                                /* @remark  : static removed */  
+extern volatile unsigned int Schdlr_TickStm;                         /* STM0 count of the last 1ms tick */
 uint32_t DBG_main_idle = 0;
 
 /*******************************************************************************/
 /* Local Variable Declarations                                                 */
 /*******************************************************************************/
-static void Scheduler_ExecuteTasks(uint32_t iTaskSlot);
+static void Scheduler_BuildTaskList(void);
+static SchedulerTask_t *Scheduler_NextTask(uint32_t iNowMs);
+static void Scheduler_RunTask(SchedulerTask_t *pTask);
+static uint32_t Scheduler_ReleaseStm(uint32_t iReleaseMs);
+static uint32_t Scheduler_TicksToUs(uint64_t iTicks);
+#if (SCHDLR_STATS_DUMP_ENABLE == 1)
+static void Scheduler_StatsDumpTask(void);
+#endif
+#if (SCHDLR_STATS_DUMP_ENABLE == 1) && defined(ADI_WIL_HAL_PROFILE_ENABLE)
+static void Scheduler_HalProfileDump(bool bReset);
+#endif
 extern void Scheduler_1ms_Trigger(void);
 
+static SchedulerTask_t SchedulerTasks[SCHDLR_TASK_COUNT_MAX];        /* Flattened view of the tables below */
+static uint32_t iSchedulerTaskCount = 0;
+static uint64_t iSchedulerBusyTicks = 0;                             /* STM ticks spent in tasks since the last reset */
+static uint64_t iSchedulerWindowStart = 0;
+
 /* Scheduler 1ms Tasks */
 #if SCHDLR_1MS_TABLE_SIZE > 0
 SchedulerEntry_t SchedulerTable_1ms[SCHDLR_1MS_TABLE_SIZE] =
 {
-    {0,adi_wil_example_w2canBmsMsgHandler},
+    SCHDLR_TASK(0, adi_example_select_script_statemachine),
+    SCHDLR_TASK(0, adi_wil_example_EventBusDrain),
+#if (ADI_W2CAN_ENABLE == 1)
+    SCHDLR_TASK(0, adi_wil_example_w2canBmsMsgHandler),
+#endif
     /* add more tasks here */
 };
 #endif
@@ -73,8 +115,8 @@ SchedulerEntry_t SchedulerTable_5ms[SCHDLR_5MS_TABLE_SIZE] =
 #if SCHDLR_10MS_TABLE_SIZE > 0
 SchedulerEntry_t SchedulerTable_10ms[SCHDLR_10MS_TABLE_SIZE] =
 {
-    {0,adi_task_pmsDataRetrieval},
-    {1,adi_wil_example_w2canHealthReportHandler}
+    SCHDLR_TASK(0, adi_task_pmsDataRetrieval),
+    SCHDLR_TASK(1, adi_wil_example_w2canHealthReportHandler),
     /* add more tasks here */
 };
 #endif
@@ -83,7 +125,7 @@ SchedulerEntry_t SchedulerTable_10ms[SCHDLR_10MS_TABLE_SIZE] =
 #if SCHDLR_25MS_TABLE_SIZE > 0
 SchedulerEntry_t SchedulerTable_25ms[SCHDLR_25MS_TABLE_SIZE] =
 {
-    {0,adi_wil_example_w2canPmsMsgHandler},
+    SCHDLR_TASK(0, adi_wil_example_w2canPmsMsgHandler),
     /* add more tasks here */
 };
 #endif
@@ -100,7 +142,6 @@ SchedulerEntry_t SchedulerTable_50ms[SCHDLR_50MS_TABLE_SIZE] =
 #if SCHDLR_100MS_TABLE_SIZE > 0
 SchedulerEntry_t SchedulerTable_100ms[SCHDLR_100MS_TABLE_SIZE] =
 {
-    {0, adi_example_select_script_statemachine},
     /* add more tasks here */
 };
 #endif
@@ -117,7 +158,11 @@ SchedulerEntry_t SchedulerTable_1000ms[SCHDLR_1000MS_TABLE_SIZE] =
 #if SCHDLR_60000MS_TABLE_SIZE > 0
 SchedulerEntry_t SchedulerTable_60000ms[SCHDLR_60000MS_TABLE_SIZE] =
 {
-    {0, adi_example_null_function},
+#if (SCHDLR_STATS_DUMP_ENABLE == 1)
+    SCHDLR_TASK(0, Scheduler_StatsDumpTask),
+#else
+    SCHDLR_TASK(0, adi_example_null_function),
+#endif
     /* add more tasks here */
 };
 #endif
@@ -172,7 +217,9 @@ SchedulerSlots_t SchedulerTickSlots[SCHDLR_MAXSLOTS] =
  * adi_wil_example_scheduleTasks
  *
  * Scheduler Function (with an infinite While loop).
- * Traverses the Available Tables and invokes the function when the respective period expires.
+ * Runs the released task with the earliest deadline, one task per pass so that
+ * a newly released shorter deadline is seen between two long tasks. Sleeps
+ * when no task is released.
  *
  * @arguments :None
  *
@@ -180,112 +227,312 @@ SchedulerSlots_t SchedulerTickSlots[SCHDLR_MAXSLOTS] =
 ***********************************************************************************/
 void adi_wil_example_scheduleTasks(void)
 {
+    SchedulerTask_t *pTask;
+
+    Scheduler_BuildTaskList();
+
     while(1)
     {
         DBG_main_idle++; /* @remark: test purpose */
-        adi_example_select_script_statemachine();
-        if(true == Schdlr_1ms_tick)
+        adi_wil_ex_LogDrain();
+
+        Schdlr_1ms_tick = false;
+        pTask = Scheduler_NextTask(Schdlr_CurrentMsCount);
+        if(NULL != pTask)
         {
-            Schdlr_1ms_tick = false;
-
-            /* 1ms Task : start */
-            #if SCHDLR_1MS_TABLE_SIZE > 0
-            Scheduler_ExecuteTasks(SCHDLR_1MS_INTERVAL);
-            #endif
-            /* 1ms Task : end */
-
-            /*2ms Task : Start */
-            #if SCHDLR_2MS_TABLE_SIZE > 0
-            Scheduler_ExecuteTasks(SCHDLR_2MS_INTERVAL);
-            #endif
-            /*2ms Task : end */
-
-            /*5ms Task : Start */
-            #if SCHDLR_5MS_TABLE_SIZE > 0
-            Scheduler_ExecuteTasks(SCHDLR_5MS_INTERVAL);
-            #endif
-            /*5ms Task : end */
-
-            /*10ms Task : Start */
-            #if SCHDLR_10MS_TABLE_SIZE > 0
-            Scheduler_ExecuteTasks(SCHDLR_10MS_INTERVAL);
-            #endif
-            /*10ms Task : end */
-
-            /*25ms Task : Start */
-            #if SCHDLR_25MS_TABLE_SIZE > 0
-            Scheduler_ExecuteTasks(SCHDLR_25MS_INTERVAL);
-            #endif
-            /*25ms Task : end */
-            
-            /*50ms Task : Start */
-            #if SCHDLR_50MS_TABLE_SIZE > 0
-            Scheduler_ExecuteTasks(SCHDLR_50MS_INTERVAL);
-            #endif
-            /*50ms Task : end */
-            
-            /* 100ms Task : start*/
-            #if SCHDLR_100MS_TABLE_SIZE > 0
-            Scheduler_ExecuteTasks(SCHDLR_100MS_INTERVAL);
-            #endif
-            /* 100ms Task : end*/
-
-            /* 1000ms Task : start*/
-            #if SCHDLR_1000MS_TABLE_SIZE > 0
-            Scheduler_ExecuteTasks(SCHDLR_1000MS_INTERVAL);
-            #endif
-            /* 1000ms Task : end*/
-
-            /* 60000ms Task : start*/
-            #if SCHDLR_60000MS_TABLE_SIZE > 0
-            Scheduler_ExecuteTasks(SCHDLR_60000MS_INTERVAL);
-            #endif
-            /* 60000ms Task : end*/
+            Scheduler_RunTask(pTask);
         }
-        else {
-            /* Do nothing till timer triggered */
+        else
+        {
+#if (SCHDLR_IDLE_WAIT == 1)
+            /* A tick between the check above and WAIT costs at most one tick of
+             * latency, the next STM interrupt wakes the core; it shows up as jitter */
+            if(false == Schdlr_1ms_tick)
+            {
+                SCHDLR_CPU_WAIT();
+            }
+#endif
         }
     }
 }
+
 /************************************************************************************
- * Scheduler_ExecuteTasks
+ * adi_wil_example_SchedulerDumpStats
  *
- * Generic function to execute all the tasks of provided Slot
+ * Prints the per task statistics, times in microseconds.
  *
- * @arguments : Time Slot : 1,2,5,100ms .. etc.
+ * @arguments : bReset : clear the statistics after printing
  *
  * @return none
  ***********************************************************************************/
-static void Scheduler_ExecuteTasks(uint32_t iTaskInterval)
+void adi_wil_example_SchedulerDumpStats(bool bReset)
 {
-    uint32_t iCurrentDelayMillisec = 0;
-    uint32_t iTaskTableIdx;
-    uint32_t iSlotIdx = 0;
+    uint32_t iTask;
+    uint64_t iNow = IfxStm_get(STM);
+    uint64_t iWindow = iNow - iSchedulerWindowStart;
+    SchedulerTaskStats_t *pStats;
+
+    adi_wil_ex_printf("Scheduler : %u tasks, load %u.%u%% over %u ms" LINE_END,
+                      (unsigned int)iSchedulerTaskCount,
+                      (unsigned int)((iWindow != 0u) ? ((iSchedulerBusyTicks * 1000u) / iWindow) / 10u : 0u),
+                      (unsigned int)((iWindow != 0u) ? ((iSchedulerBusyTicks * 1000u) / iWindow) % 10u : 0u),
+                      (unsigned int)(Scheduler_TicksToUs(iWindow) / 1000u));
+    adi_wil_ex_printf("%-40s %6s %9s %8s %8s %8s %6s %6s" LINE_END,
+                      "task", "period", "runs", "wcet", "avg", "jitter", "missed", "skip");
+
+    for(iTask = 0; iTask < iSchedulerTaskCount; iTask++)
+    {
+        pStats = &SchedulerTasks[iTask].pEntry->Stats;
+        adi_wil_ex_printf("%-40s %6u %9u %8u %8u %8u %6u %6u" LINE_END,
+                          SchedulerTasks[iTask].pEntry->pName,
+                          (unsigned int)SchedulerTasks[iTask].iPeriod,
+                          (unsigned int)pStats->iReleases,
+                          (unsigned int)Scheduler_TicksToUs(pStats->iWcetTicks),
+                          (unsigned int)((pStats->iReleases != 0u) ? Scheduler_TicksToUs(pStats->iTotalExecTicks / pStats->iReleases) : 0u),
+                          (unsigned int)Scheduler_TicksToUs(pStats->iMaxJitterTicks),
+                          (unsigned int)pStats->iMissedDeadlines,
+                          (unsigned int)pStats->iSkippedReleases);
+        if(bReset)
+        {
+            memset(pStats, 0, sizeof(SchedulerTaskStats_t));
+        }
+    }
 
-    iCurrentDelayMillisec = Schdlr_CurrentMsCount%iTaskInterval;
+    if(bReset)
+    {
+        iSchedulerBusyTicks = 0;
+        iSchedulerWindowStart = iNow;
+    }
+}
 
-    /* find the scheduler slot index , eg:- 1ms or 10ms or 100ms.... */
-    for(iTaskTableIdx = 0; iTaskTableIdx < SCHDLR_MAXSLOTS; iTaskTableIdx++)
+/************************************************************************************
+ * Scheduler_BuildTaskList
+ *
+ * Collects the entries of all tables and sets each first release to the next
+ * ms count where (ms % period) == TickDelay.
+ *
+ * @arguments : none
+ *
+ * @return none
+ ***********************************************************************************/
+static void Scheduler_BuildTaskList(void)
+{
+    uint32_t iSlotIdx;
+    uint32_t iEntryIdx;
+    uint32_t iNowMs = Schdlr_CurrentMsCount;
+    uint32_t iPeriod;
+    SchedulerEntry_t *pEntry;
+
+    iSchedulerTaskCount = 0;
+    for(iSlotIdx = 0; iSlotIdx < SCHDLR_MAXSLOTS; iSlotIdx++)
+    {
+        iPeriod = SchedulerTickSlots[iSlotIdx].timeSlot;
+        if((iPeriod == 0u) || (NULL == SchedulerTickSlots[iSlotIdx].timeSlotEntry))
+        {
+            continue;
+        }
+        for(iEntryIdx = 0; iEntryIdx < SchedulerTickSlots[iSlotIdx].currentTableSize; iEntryIdx++)
+        {
+            pEntry = &SchedulerTickSlots[iSlotIdx].timeSlotEntry[iEntryIdx];
+            if((NULL == pEntry->TaskPtr) || (iSchedulerTaskCount >= SCHDLR_TASK_COUNT_MAX))
+            {
+                continue;
+            }
+            pEntry->NextRelease = iNowMs - (iNowMs % iPeriod) + (pEntry->TickDelay % iPeriod);
+            if(!SCHDLR_TIME_REACHED(pEntry->NextRelease, iNowMs))
+            {
+                pEntry->NextRelease += iPeriod;
+            }
+            memset(&pEntry->Stats, 0, sizeof(SchedulerTaskStats_t));
+
+            SchedulerTasks[iSchedulerTaskCount].pEntry = pEntry;
+            SchedulerTasks[iSchedulerTaskCount].iPeriod = iPeriod;
+            SchedulerTasks[iSchedulerTaskCount].iDeadline = ((pEntry->Deadline != 0u) && (pEntry->Deadline < iPeriod)) ? pEntry->Deadline : iPeriod;
+            iSchedulerTaskCount++;
+        }
+    }
+
+    iSchedulerBusyTicks = 0;
+    iSchedulerWindowStart = IfxStm_get(STM);
+}
+
+/************************************************************************************
+ * Scheduler_NextTask
+ *
+ * Earliest deadline first among the released tasks, table order breaks ties.
+ *
+ * @arguments : iNowMs : current ms count
+ *
+ * @return task to run or NULL when nothing is released
+ ***********************************************************************************/
+static SchedulerTask_t *Scheduler_NextTask(uint32_t iNowMs)
+{
+    uint32_t iTask;
+    int32_t iSlack;
+    int32_t iBestSlack = INT32_MAX;
+    SchedulerTask_t *pBest = NULL;
+
+    for(iTask = 0; iTask < iSchedulerTaskCount; iTask++)
     {
-        if(iTaskInterval == SchedulerTickSlots[iTaskTableIdx].timeSlot)
+        if(SCHDLR_TIME_REACHED(iNowMs, SchedulerTasks[iTask].pEntry->NextRelease))
         {
-            iSlotIdx = iTaskTableIdx;
-            for(iTaskTableIdx = 0; iTaskTableIdx < SchedulerTickSlots[iSlotIdx].currentTableSize; iTaskTableIdx++)
+            iSlack = (int32_t)(SchedulerTasks[iTask].pEntry->NextRelease + SchedulerTasks[iTask].iDeadline - iNowMs);
+            if(iSlack < iBestSlack)
             {
-                if(iCurrentDelayMillisec == SchedulerTickSlots[iSlotIdx].timeSlotEntry[iTaskTableIdx].TickDelay)
-                    {
-                        /* time to invoke the task, if the function pointer is not NULL */
-                        if(NULL != SchedulerTickSlots[iSlotIdx].timeSlotEntry[iTaskTableIdx].TaskPtr)
-                            {
-                                SchedulerTickSlots[iSlotIdx].timeSlotEntry[iTaskTableIdx].TaskPtr();
-                                }
-                            }
-                    }
-            break;
+                iBestSlack = iSlack;
+                pBest = &SchedulerTasks[iTask];
+            }
         }
     }
+    return pBest;
 }
 
+/************************************************************************************
+ * Scheduler_RunTask
+ *
+ * Runs one released task, updates its statistics and schedules its next release.
+ *
+ * @arguments : pTask : released task
+ *
+ * @return none
+ ***********************************************************************************/
+static void Scheduler_RunTask(SchedulerTask_t *pTask)
+{
+    SchedulerEntry_t *pEntry = pTask->pEntry;
+    SchedulerTaskStats_t *pStats = &pEntry->Stats;
+    uint32_t iReleaseStm = Scheduler_ReleaseStm(pEntry->NextRelease);
+    uint32_t iStartStm;
+    uint32_t iExecTicks;
+    uint32_t iJitterTicks;
+
+    iStartStm = IfxStm_getLower(STM);
+    pEntry->TaskPtr();
+    iExecTicks = IfxStm_getLower(STM) - iStartStm;
+
+    iJitterTicks = iStartStm - iReleaseStm;
+    pStats->iReleases++;
+    pStats->iLastExecTicks = iExecTicks;
+    pStats->iTotalExecTicks += iExecTicks;
+    iSchedulerBusyTicks += iExecTicks;
+    if(iExecTicks > pStats->iWcetTicks)
+    {
+        pStats->iWcetTicks = iExecTicks;
+    }
+    if(iJitterTicks > pStats->iMaxJitterTicks)
+    {
+        pStats->iMaxJitterTicks = iJitterTicks;
+    }
+    if((iJitterTicks + iExecTicks) > (pTask->iDeadline * (uint32_t)g_ticksFor1ms))
+    {
+        pStats->iMissedDeadlines++;
+    }
+
+    /* Next release; releases a full period or more in the past are dropped, not queued */
+    pEntry->NextRelease += pTask->iPeriod;
+    while(SCHDLR_TIME_REACHED(Schdlr_CurrentMsCount, pEntry->NextRelease + pTask->iPeriod))
+    {
+        pEntry->NextRelease += pTask->iPeriod;
+        pStats->iSkippedReleases++;
+    }
+}
+
+/************************************************************************************
+ * Scheduler_ReleaseStm
+ *
+ * STM0 count at which a ms count started, from the STM count of the last tick.
+ *
+ * @arguments : iReleaseMs : ms count, not in the future
+ *
+ * @return STM0 lower 32 bits
+ ***********************************************************************************/
+static uint32_t Scheduler_ReleaseStm(uint32_t iReleaseMs)
+{
+    uint32_t iMs;
+    uint32_t iTickStm;
+
+    /* Re-read if the tick interrupt hit between the two loads */
+    do
+    {
+        iMs = Schdlr_CurrentMsCount;
+        iTickStm = Schdlr_TickStm;
+    } while(iMs != Schdlr_CurrentMsCount);
+
+    return iTickStm - ((iMs - iReleaseMs) * (uint32_t)g_ticksFor1ms);
+}
+
+static uint32_t Scheduler_TicksToUs(uint64_t iTicks)
+{
+    return (g_ticksFor1ms > 0) ? (uint32_t)((iTicks * 1000u) / (uint64_t)g_ticksFor1ms) : 0u;
+}
+
+#if (SCHDLR_STATS_DUMP_ENABLE == 1)
+static void Scheduler_StatsDumpTask(void)
+{
+    adi_wil_example_SchedulerDumpStats(true);
+    adi_wil_example_EventBusDumpStats(true);
+#if defined(ADI_WIL_HAL_PROFILE_ENABLE)
+    Scheduler_HalProfileDump(true);
+#endif
+}
+#endif
+
+#if (SCHDLR_STATS_DUMP_ENABLE == 1) && defined(ADI_WIL_HAL_PROFILE_ENABLE)
+/************************************************************************************
+ * Scheduler_HalProfileDump
+ *
+ * Prints the WIL receive path function timings of the HAL profile table, in
+ * STM0 ticks and ns. Run the same traffic on a default and on an
+ * ADI_WIL_PERF_PROFILE build and compare the two tables.
+ *
+ * @arguments : bReset : clear the table after printing
+ *
+ * @return none
+ ***********************************************************************************/
+static void Scheduler_HalProfileDump(bool bReset)
+{
+    static const char * const FuncNames[ADI_WIL_HAL_PROFILE_COUNT] =
+    {
+        "wb_nil_ReadFrame",
+        "wb_nil_ValidateFrameMetadata",
+        "wb_nil_ProcessFramePayload",
+        "wb_xms_HandleMeasurementCommon",
+        "wb_xms_StorePacket",
+        "wb_xms_SubmitBuffer",
+        "wb_scl_ComputeCrc",
+        "wb_xms_HandleBmsMeasurementFast",
+    };
+    adi_wil_hal_profile_entry_t const *pEntry;
+    uint32_t iAvgTicks;
+    uint32_t iFunc;
+
+#if defined(ADI_WIL_PERF_PROFILE)
+    adi_wil_ex_printf("HAL profile : performance layout (PSPR0 code, DSPR0 tables)" LINE_END);
+#else
+    adi_wil_ex_printf("HAL profile : default layout" LINE_END);
+#endif
+    adi_wil_ex_printf("%-32s %9s %8s %8s %8s %8s" LINE_END,
+                      "function", "calls", "min", "avg", "max", "avg ns");
+
+    for(iFunc = 0; iFunc < (uint32_t)ADI_WIL_HAL_PROFILE_COUNT; iFunc++)
+    {
+        pEntry = &adi_wil_hal_ProfileTable[iFunc];
+        iAvgTicks = (pEntry->iCount != 0u) ? (uint32_t)(pEntry->iTotalTicks / pEntry->iCount) : 0u;
+        adi_wil_ex_printf("%-32s %9u %8u %8u %8u %8u" LINE_END,
+                          FuncNames[iFunc],
+                          (unsigned int)pEntry->iCount,
+                          (unsigned int)pEntry->iMinTicks,
+                          (unsigned int)iAvgTicks,
+                          (unsigned int)pEntry->iMaxTicks,
+                          (unsigned int)((g_ticksFor1ms > 0) ? (((uint64_t)iAvgTicks * 1000000u) / (uint64_t)g_ticksFor1ms) : 0u));
+    }
+
+    if(bReset)
+    {
+        adi_wil_hal_ProfileReset();
+    }
+}
+#endif
+
 /************************************************************************************
  * adi_wil_example_SchedulerInit
  *
@@ -297,6 +544,11 @@ static void Scheduler_ExecuteTasks(uint32_t iTaskInterval)
  ***********************************************************************************/
 bool adi_wil_example_SchedulerInit(void)
 {
+    bool bStatus = true;
+
     initPeripherals();
-    return true;
+#if (ADI_W2CAN_ENABLE == 1)
+    bStatus = adi_wil_example_w2canInit();
+#endif
+    return bStatus;
 }
@@ -0,0 +1,130 @@
+/*******************************************************************************
+ * @file     adi_wil_example_script_cache.c
+ *
+ * @brief    Per node cache of the configuration registers set with ModifyScript
+ *
+ * @details  Keeps, for every node, the CFGA/CFGB payload the node last
+ *           accepted and the payload last built for it. A build whose data
+ *           bytes match the accepted payload needs no request, so a balancing
+ *           update only reaches the nodes and registers that change. The PEC
+ *           of a payload is computed once and reused when the same payload is
+ *           sent again.
+ *
+ * Copyright (c) 2020-2022 Analog Devices, Inc. All Rights Reserved.
+ * This software is proprietary and confidential to Analog Devices, Inc. and its licensors.
+ *******************************************************************************/
+
+#include <string.h>
+
+#include "adi_wil_example_script_cache.h"
+#include "adi_wil_example_config.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define ADI_SCRIPT_CACHE_PEC_OFFSET     ADI_PEC_GROUP_DATA_SIZE
+
+/******************************************************************************
+ * Static variable declarations
+ *****************************************************************************/
+static adi_script_node_cache_t ScriptCache[ADI_WIL_MAX_NODES];
+static adi_script_cache_stats_t ScriptCacheStats;
+
+/******************************************************************************
+ * Function definitions
+ *****************************************************************************/
+void adi_wil_example_ScriptCacheReset(void)
+{
+    memset(ScriptCache, 0, sizeof(ScriptCache));
+    memset(&ScriptCacheStats, 0, sizeof(ScriptCacheStats));
+}
+
+void adi_wil_example_ScriptCacheInvalidate(uint8_t iNodeIndex)
+{
+    if (iNodeIndex < ADI_WIL_MAX_NODES)
+    {
+        ScriptCache[iNodeIndex].iAppliedMask = 0u;
+    }
+}
+
+bool adi_wil_example_ScriptCacheBuild(uint8_t iNodeIndex, adi_script_reg_t eReg, uint8_t *pPayload)
+{
+    adi_script_node_cache_t *pNode;
+    uint8_t iMask = (uint8_t)ADI_SCRIPT_CACHE_REG_MASK(eReg);
+    uint16_t iPec;
+
+    ScriptCacheStats.iBuilds++;
+
+    if ((iNodeIndex >= ADI_WIL_MAX_NODES) || (eReg >= ADI_SCRIPT_REG_COUNT))
+    {
+        /* Not cached, always sent */
+        pPayload[ADI_SCRIPT_CACHE_PEC_OFFSET] = 0u;
+        iPec = adi_pec10_Calc(pPayload, ADI_PEC_GROUP_DATA_SIZE, true);
+        pPayload[ADI_SCRIPT_CACHE_PEC_OFFSET] = (uint8_t)(iPec >> 8);
+        pPayload[ADI_SCRIPT_CACHE_PEC_OFFSET + 1u] = (uint8_t)(iPec >> 0);
+        ScriptCacheStats.iRequests++;
+        ScriptCacheStats.iPecComputed++;
+        return true;
+    }
+
+    pNode = &ScriptCache[iNodeIndex];
+
+    if (((pNode->iAppliedMask & iMask) != 0u) &&
+        (memcmp(pNode->Applied[eReg], pPayload, ADI_PEC_GROUP_DATA_SIZE) == 0))
+    {
+        memcpy(&pPayload[ADI_SCRIPT_CACHE_PEC_OFFSET], &pNode->Applied[eReg][ADI_SCRIPT_CACHE_PEC_OFFSET], 2u);
+        pNode->iPendingMask &= (uint8_t)~iMask;
+        return false;
+    }
+
+    ScriptCacheStats.iRequests++;
+
+    if (((pNode->iPendingMask & iMask) == 0u) ||
+        (memcmp(pNode->Pending[eReg], pPayload, ADI_PEC_GROUP_DATA_SIZE) != 0))
+    {
+        /* The command counter bits sent with the PEC are 0 */
+        pPayload[ADI_SCRIPT_CACHE_PEC_OFFSET] = 0u;
+        iPec = adi_pec10_Calc(pPayload, ADI_PEC_GROUP_DATA_SIZE, true);
+        pPayload[ADI_SCRIPT_CACHE_PEC_OFFSET] = (uint8_t)(iPec >> 8);
+        pPayload[ADI_SCRIPT_CACHE_PEC_OFFSET + 1u] = (uint8_t)(iPec >> 0);
+
+        memcpy(pNode->Pending[eReg], pPayload, ADI_PEC_GROUP_SIZE);
+        pNode->iPendingMask |= iMask;
+        ScriptCacheStats.iPecComputed++;
+    }
+    else
+    {
+        memcpy(&pPayload[ADI_SCRIPT_CACHE_PEC_OFFSET], &pNode->Pending[eReg][ADI_SCRIPT_CACHE_PEC_OFFSET], 2u);
+    }
+
+    return true;
+}
+
+void adi_wil_example_ScriptCacheCommit(uint8_t iNodeIndex, adi_script_reg_t eReg, bool bApplied)
+{
+    adi_script_node_cache_t *pNode;
+    uint8_t iMask = (uint8_t)ADI_SCRIPT_CACHE_REG_MASK(eReg);
+
+    if ((iNodeIndex >= ADI_WIL_MAX_NODES) || (eReg >= ADI_SCRIPT_REG_COUNT))
+    {
+        return;
+    }
+
+    pNode = &ScriptCache[iNodeIndex];
+
+    if (bApplied && ((pNode->iPendingMask & iMask) != 0u))
+    {
+        memcpy(pNode->Applied[eReg], pNode->Pending[eReg], ADI_PEC_GROUP_SIZE);
+        pNode->iAppliedMask |= iMask;
+    }
+    else if (!bApplied)
+    {
+        /* The node may or may not hold the payload, the pending PEC stays for the resend */
+        pNode->iAppliedMask &= (uint8_t)~iMask;
+    }
+}
+
+adi_script_cache_stats_t const *adi_wil_example_ScriptCacheGetStats(void)
+{
+    return &ScriptCacheStats;
+}
@@ -0,0 +1,841 @@
+/*******************************************************************************
+* @file     adi_wil_example_w2can.c
+*
+* @brief    Wireless to CAN gateway
+*
+* @details  Maps BMS / PMS / EMS data, network metadata and health reports
+*           onto CAN messages and transmits them through the MCMCAN Tx FIFO.
+*
+*           The WIL event callbacks only update per node CAN message images.
+*           The cyclic handlers copy complete images into a software frame
+*           queue (a whole pack snapshot is queued at once) and the 1ms task
+*           moves the queue into the hardware Tx FIFO in bursts of up to
+*           ADI_W2CAN_TXFIFO_SIZE frames.
+*
+* Copyright (c) 2020-2021 Analog Devices, Inc. All Rights Reserved.
+* This software is proprietary and confidential to Analog Devices, Inc. and its licensors.
+*******************************************************************************/
+#include <stddef.h>
+#include <string.h>
+#include "adi_wil_example_w2can.h"
+#include "adi_wil_example_functions.h"
+#include "adi_bms_types.h"
+#include "IfxCpu.h"
+#if (ADI_W2CAN_VIRTUAL_SINK == 0)
+#include "Can/Can/IfxCan_Can.h"
+#endif
+
+/*******************************************************************************/
+/* Local MACRO Declarations                                                    */
+/*******************************************************************************/
+#define ADI_W2CAN_TXQUEUE_MASK          (ADI_W2CAN_TXQUEUE_SIZE - 1U)
+#define ADI_W2CAN_SINK_MASK             (ADI_W2CAN_SINK_SIZE - 1U)
+
+/* Network metadata record : MD01 | MD02 | MD03 payloads back to back */
+#define ADI_W2CAN_MD_RECORD_SIZE        (3U * ADI_W2CAN_CANMESSAGE_SIZE)
+#define ADI_W2CAN_MD_SLOT(n)            ((n) * ADI_W2CAN_CANMESSAGE_SIZE)
+
+/* Health report handler : retries of one node before the transmission is aborted */
+#define ADI_W2CAN_HR_MAX_WAIT_CYCLES    (ADI_W2CAN_HRTX_TIMEOUT / ADI_W2CAN_HRTASK_PERIOD)
+
+/* Health reports required from a node before its CAN messages are sent */
+#define ADI_W2CAN_HR_DEVICE_RCVD        0x01U
+#define ADI_W2CAN_HR_BGRSSI_RCVD        0x02U
+#define ADI_W2CAN_HR_APPLICATION_RCVD   0x04U
+#define ADI_W2CAN_HR_ALL_RCVD           (ADI_W2CAN_HR_DEVICE_RCVD | ADI_W2CAN_HR_BGRSSI_RCVD | ADI_W2CAN_HR_APPLICATION_RCVD)
+
+#define ADI_W2CAN_BASE_PKT0_OFFSET(grp, type, field)  (offsetof(adi_bms_base_pkt_0_t, grp) + offsetof(type, field))
+
+/*******************************************************************************/
+/* Global Variable Declarations                                                */
+/*******************************************************************************/
+uint32_t adi_gW2canNodeCount = 0;                                   /* Nodes forwarded in the last BMS snapshot */
+adi_w2can_Stats_t adi_gW2canStats;
+adi_w2can_Frame_t adi_gW2canSink[ADI_W2CAN_SINK_SIZE];              /* Virtual CAN sink (virtual sink / loopback mode) */
+volatile uint32_t adi_gW2canSinkHead = 0;
+
+/*******************************************************************************/
+/* Extern Variable Declarations                                                */
+/*******************************************************************************/
+extern adi_wil_health_report0_t         *userHR0Buffer;
+extern adi_wil_health_report1_t         *userHR1Buffer;
+extern adi_wil_health_report2_t         *userHR2Buffer;
+extern adi_wil_health_report80_t        *userHR80Buffer;
+
+/*******************************************************************************/
+/* Signal Maps                                                                 */
+/*******************************************************************************/
+/*
+ * G2B signal map, one entry per signal in enum order :
+ * {Signal ID, Message Index, Start Byte, Length (bits), Source Packet, Source Offset}
+ * Signals with a length of 0 are not mapped and stay 0 in the CAN message.
+ */
+static const adi_w2can_CanSignals_t adi_w2can_G2BSignalMap[] =
+{
+    /* BMS cell voltages : base packet 0, averaged cell voltage register groups A-D */
+    {ADI_BMS_PACKET_C1V,          ADI_W2CAN_G2B_CELLGRPA_MSGINDEX, ADI_W2CAN_SIG_C1V_OFFSET,      ADI_W2CAN_SIG_C1V_LENGTH * 8U,      ADI_BMS_BASE_PKT_0_ID, ADI_W2CAN_BASE_PKT0_OFFSET(Rdaca, adi_bms_rdaca_t, iAc1v)},
+    {ADI_BMS_PACKET_C2V,          ADI_W2CAN_G2B_CELLGRPA_MSGINDEX, ADI_W2CAN_SIG_C2V_OFFSET,      ADI_W2CAN_SIG_C2V_LENGTH * 8U,      ADI_BMS_BASE_PKT_0_ID, ADI_W2CAN_BASE_PKT0_OFFSET(Rdaca, adi_bms_rdaca_t, iAc2v)},
+    {ADI_BMS_PACKET_C3V,          ADI_W2CAN_G2B_CELLGRPA_MSGINDEX, ADI_W2CAN_SIG_C3V_OFFSET,      ADI_W2CAN_SIG_C3V_LENGTH * 8U,      ADI_BMS_BASE_PKT_0_ID, ADI_W2CAN_BASE_PKT0_OFFSET(Rdaca, adi_bms_rdaca_t, iAc3v)},
+    {ADI_BMS_PACKET_CVAR_PEC,     ADI_W2CAN_G2B_CELLGRPA_MSGINDEX, ADI_W2CAN_SIG_CVARPEC_OFFSET,  ADI_W2CAN_SIG_CVARPEC_LENGTH * 8U,  ADI_BMS_BASE_PKT_0_ID, ADI_W2CAN_BASE_PKT0_OFFSET(Rdaca, adi_bms_rdaca_t, iRdaca_pec)},
+    {ADI_BMS_PACKET_C4V,          ADI_W2CAN_G2B_CELLGRPB_MSGINDEX, ADI_W2CAN_SIG_C4V_OFFSET,      ADI_W2CAN_SIG_C4V_LENGTH * 8U,      ADI_BMS_BASE_PKT_0_ID, ADI_W2CAN_BASE_PKT0_OFFSET(Rdacb, adi_bms_rdacb_t, iAc4v)},
+    {ADI_BMS_PACKET_C5V,          ADI_W2CAN_G2B_CELLGRPB_MSGINDEX, ADI_W2CAN_SIG_C5V_OFFSET,      ADI_W2CAN_SIG_C5V_LENGTH * 8U,      ADI_BMS_BASE_PKT_0_ID, ADI_W2CAN_BASE_PKT0_OFFSET(Rdacb, adi_bms_rdacb_t, iAc5v)},
+    {ADI_BMS_PACKET_C6V,          ADI_W2CAN_G2B_CELLGRPB_MSGINDEX, ADI_W2CAN_SIG_C6V_OFFSET,      ADI_W2CAN_SIG_C6V_LENGTH * 8U,      ADI_BMS_BASE_PKT_0_ID, ADI_W2CAN_BASE_PKT0_OFFSET(Rdacb, adi_bms_rdacb_t, iAc6v)},
+    {ADI_BMS_PACKET_CVBR_PEC,     ADI_W2CAN_G2B_CELLGRPB_MSGINDEX, ADI_W2CAN_SIG_CVBRPEC_OFFSET,  ADI_W2CAN_SIG_CVBRPEC_LENGTH * 8U,  ADI_BMS_BASE_PKT_0_ID, ADI_W2CAN_BASE_PKT0_OFFSET(Rdacb, adi_bms_rdacb_t, iRdacb_pec)},
+    {ADI_BMS_PACKET_C7V,          ADI_W2CAN_G2B_CELLGRPC_MSGINDEX, ADI_W2CAN_SIG_C7V_OFFSET,      ADI_W2CAN_SIG_C7V_LENGTH * 8U,      ADI_BMS_BASE_PKT_0_ID, ADI_W2CAN_BASE_PKT0_OFFSET(Rdacc, adi_bms_rdacc_t, iAc7v)},
+    {ADI_BMS_PACKET_C8V,          ADI_W2CAN_G2B_CELLGRPC_MSGINDEX, ADI_W2CAN_SIG_C8V_OFFSET,      ADI_W2CAN_SIG_C8V_LENGTH * 8U,      ADI_BMS_BASE_PKT_0_ID, ADI_W2CAN_BASE_PKT0_OFFSET(Rdacc, adi_bms_rdacc_t, iAc8v)},
+    {ADI_BMS_PACKET_C9V,          ADI_W2CAN_G2B_CELLGRPC_MSGINDEX, ADI_W2CAN_SIG_C9V_OFFSET,      ADI_W2CAN_SIG_C9V_LENGTH * 8U,      ADI_BMS_BASE_PKT_0_ID, ADI_W2CAN_BASE_PKT0_OFFSET(Rdacc, adi_bms_rdacc_t, iAc9v)},
+    {ADI_BMS_PACKET_CVCR_PEC,     ADI_W2CAN_G2B_CELLGRPC_MSGINDEX, ADI_W2CAN_SIG_CVCRPEC_OFFSET,  ADI_W2CAN_SIG_CVCRPEC_LENGTH * 8U,  ADI_BMS_BASE_PKT_0_ID, ADI_W2CAN_BASE_PKT0_OFFSET(Rdacc, adi_bms_rdacc_t, iRdacc_pec)},
+    {ADI_BMS_PACKET_C10V,         ADI_W2CAN_G2B_CELLGRPD_MSGINDEX, ADI_W2CAN_SIG_C10V_OFFSET,     ADI_W2CAN_SIG_C10V_LENGTH * 8U,     ADI_BMS_BASE_PKT_0_ID, ADI_W2CAN_BASE_PKT0_OFFSET(Rdacd, adi_bms_rdacd_t, iAc10v)},
+    {ADI_BMS_PACKET_C11V,         ADI_W2CAN_G2B_CELLGRPD_MSGINDEX, ADI_W2CAN_SIG_C11V_OFFSET,     ADI_W2CAN_SIG_C11V_LENGTH * 8U,     ADI_BMS_BASE_PKT_0_ID, ADI_W2CAN_BASE_PKT0_OFFSET(Rdacd, adi_bms_rdacd_t, iAc11v)},
+    {ADI_BMS_PACKET_C12V,         ADI_W2CAN_G2B_CELLGRPD_MSGINDEX, ADI_W2CAN_SIG_C12V_OFFSET,     ADI_W2CAN_SIG_C12V_LENGTH * 8U,     ADI_BMS_BASE_PKT_0_ID, ADI_W2CAN_BASE_PKT0_OFFSET(Rdacd, adi_bms_rdacd_t, iAc12v)},
+    {ADI_BMS_PACKET_CVDR_PEC,     ADI_W2CAN_G2B_CELLGRPD_MSGINDEX, ADI_W2CAN_SIG_CVDRPEC_OFFSET,  ADI_W2CAN_SIG_CVDRPEC_LENGTH * 8U,  ADI_BMS_BASE_PKT_0_ID, ADI_W2CAN_BASE_PKT0_OFFSET(Rdacd, adi_bms_rdacd_t, iRdacd_pec)},
+
+    /* EMS cell group A and diagnostic cell group A */
+    {ADI_EMS_PACKET_C1V,          ADI_W2CAN_G2B_EMS1_CELL_MSGINDEX, ADI_W2CAN_EMS_SIG_C1V_OFFSET,     ADI_W2CAN_EMS_SIG_C1V_LENGTH * 8U,     ADI_W2CAN_SRC_ANY_PACKET, ADI_EMS_PACKET_C1V_OFFSET},
+    {ADI_EMS_PACKET_C2V,          ADI_W2CAN_G2B_EMS1_CELL_MSGINDEX, ADI_W2CAN_EMS_SIG_C2V_OFFSET,     ADI_W2CAN_EMS_SIG_C2V_LENGTH * 8U,     ADI_W2CAN_SRC_ANY_PACKET, ADI_EMS_PACKET_C2V_OFFSET},
+    {ADI_EMS_PACKET_C3V,          ADI_W2CAN_G2B_EMS1_CELL_MSGINDEX, ADI_W2CAN_EMS_SIG_C3V_OFFSET,     ADI_W2CAN_EMS_SIG_C3V_LENGTH * 8U,     ADI_W2CAN_SRC_ANY_PACKET, ADI_EMS_PACKET_C3V_OFFSET},
+    {ADI_EMS_PACKET_CVAR_PEC,     ADI_W2CAN_G2B_EMS1_CELL_MSGINDEX, ADI_W2CAN_EMS_SIG_CVARPEC_OFFSET, ADI_W2CAN_EMS_SIG_CVARPEC_LENGTH * 8U, ADI_W2CAN_SRC_ANY_PACKET, ADI_EMS_PACKET_CVAR_PEC_OFFSET},
+    {ADI_EMS_PACKET_CD1V,         ADI_W2CAN_G2B_EMS1_DIAG_MSGINDEX, ADI_W2CAN_SIG_CD1V_OFFSET,        ADI_W2CAN_EMS_SIG_CD1V_LENGTH * 8U,    ADI_W2CAN_SRC_ANY_PACKET, ADI_EMS_PACKET_CD1V_OFFSET},
+    {ADI_EMS_PACKET_CD2V,         ADI_W2CAN_G2B_EMS1_DIAG_MSGINDEX, ADI_W2CAN_SIG_CD2V_OFFSET,        ADI_W2CAN_EMS_SIG_CD2V_LENGTH * 8U,    ADI_W2CAN_SRC_ANY_PACKET, ADI_EMS_PACKET_CD2V_OFFSET},
+    {ADI_EMS_PACKET_CD3V,         ADI_W2CAN_G2B_EMS1_DIAG_MSGINDEX, ADI_W2CAN_SIG_CD3V_OFFSET,        ADI_W2CAN_EMS_SIG_CD3V_LENGTH * 8U,    ADI_W2CAN_SRC_ANY_PACKET, ADI_EMS_PACKET_CD3V_OFFSET},
+    {ADI_EMS_PACKET_CSA_PEC,      ADI_W2CAN_G2B_EMS1_DIAG_MSGINDEX, ADI_W2CAN_SIG_CSAPEC_OFFSET,      ADI_W2CAN_EMS_SIG_CSAPEC_LENGTH * 8U,  ADI_W2CAN_SRC_ANY_PACKET, ADI_EMS_PACKET_CSA_PEC_OFFSET},
+
+    /* PMS current, battery voltage and aux measurements */
+    {ADI_PMS_CURR_I1,             ADI_W2CAN_G2B_PMS_I1_I2_VBAT_MSGINDEX, ADI_W2CAN_SIG_CURR_I1_OFFSET,         ADI_W2CAN_SIG_CURR_I1_LENGTH * 8U,         ADI_W2CAN_SRC_ANY_PACKET, ADI_PMS_I1_OFFSET},
+    {ADI_PMS_CURR_I2,             ADI_W2CAN_G2B_PMS_I1_I2_VBAT_MSGINDEX, ADI_W2CAN_SIG_CURR_I2_OFFSET,         ADI_W2CAN_SIG_CURR_I2_LENGTH * 8U,         ADI_W2CAN_SRC_ANY_PACKET, ADI_PMS_I2_OFFSET},
+    {ADI_PMS_VBAT,                ADI_W2CAN_G2B_PMS_I1_I2_VBAT_MSGINDEX, ADI_W2CAN_SIG_VBAT_OFFSET,            ADI_W2CAN_SIG_VBAT_LENGTH * 8U,            ADI_W2CAN_SRC_ANY_PACKET, ADI_PMS_VBAT_OFFSET},
+    {ADI_PMS_I1_I2_VBAT_PEC,      ADI_W2CAN_G2B_PMS_I1_I2_VBAT_MSGINDEX, ADI_W2CAN_SIG_I1_I2_VBAT_PEC_OFFSET,  ADI_W2CAN_SIG_I1_I2_VBAT_PEC_LENGTH * 8U,  ADI_W2CAN_SRC_ANY_PACKET, ADI_PMS_I1_I2_VBAT_PEC_OFFSET},
+    {ADI_PMS_AUX_PM1,             ADI_W2CAN_G2B_PMS_AUX_MSGINDEX,        ADI_W2CAN_SIG_AUX_PM1_OFFSET,         ADI_W2CAN_SIG_AUX_PM1_LENGTH * 8U,         ADI_W2CAN_SRC_ANY_PACKET, ADI_PMS_AUX_OFFSET},
+    {ADI_PMS_HS1_PM1,             ADI_W2CAN_G2B_PMS_AUX_MSGINDEX,        ADI_W2CAN_SIG_HS1_PM1_OFFSET,         ADI_W2CAN_SIG_HS1_PM1_LENGTH * 8U,         ADI_W2CAN_SRC_ANY_PACKET, ADI_PMS_HS1_OFFSET},
+    {ADI_PMS_HS2_PM1,             ADI_W2CAN_G2B_PMS_AUX_MSGINDEX,        ADI_W2CAN_SIG_HS2_PM1_OFFSET,         ADI_W2CAN_SIG_HS2_PM1_LENGTH * 8U,         ADI_W2CAN_SRC_ANY_PACKET, ADI_PMS_HS2_OFFSET},
+    {ADI_PMS_AUX_HS1_HS2_PEC,     ADI_W2CAN_G2B_PMS_AUX_MSGINDEX,        ADI_W2CAN_SIG_AUX_HS1_HS2_PEC_OFFSET, ADI_W2CAN_SIG_AUX_HS1_HS2_PEC_LENGTH * 8U, ADI_W2CAN_SRC_ANY_PACKET, ADI_PMS_AUX_HS1_HS2_PEC_OFFSET},
+
+    /* Network metadata : MD01-MD03 from the manager 0 path, MD05-MD07 from the manager 1 path */
+    {ADI_MD01_ASN,                ADI_W2CAN_C2B_MD01_MSGINDEX, ADI_MD01_ASN_OFFSET,     ADI_MD01_ASN_LENGTH * 8U,     ADI_W2CAN_SRC_NETWORK_DATA, ADI_W2CAN_MD_SLOT(0U) + ADI_MD01_ASN_OFFSET},
+    {ADI_MD02_LATENCY,            ADI_W2CAN_C2B_MD02_MSGINDEX, ADI_MD02_LATENCY_OFFSET, ADI_MD02_LATENCY_LENGTH * 8U, ADI_W2CAN_SRC_NETWORK_DATA, ADI_W2CAN_MD_SLOT(1U) + ADI_MD02_LATENCY_OFFSET},
+    {ADI_MD02_SEQ_NO,             ADI_W2CAN_C2B_MD02_MSGINDEX, ADI_MD02_SEQNO_OFFSET,   ADI_MD02_SEQNO_LENGTH * 8U,   ADI_W2CAN_SRC_NETWORK_DATA, ADI_W2CAN_MD_SLOT(1U) + ADI_MD02_SEQNO_OFFSET},
+    {ADI_MD02_CHANNEL,            ADI_W2CAN_C2B_MD02_MSGINDEX, ADI_MD02_CHANNEL_OFFSET, ADI_MD02_CHANNEL_LENGTH * 8U, ADI_W2CAN_SRC_NETWORK_DATA, ADI_W2CAN_MD_SLOT(1U) + ADI_MD02_CHANNEL_OFFSET},
+    {ADI_MD02_RSSI,               ADI_W2CAN_C2B_MD02_MSGINDEX, ADI_MD02_RSSI_OFFSET,    ADI_MD02_RSSI_LENGTH * 8U,    ADI_W2CAN_SRC_NETWORK_DATA, ADI_W2CAN_MD_SLOT(1U) + ADI_MD02_RSSI_OFFSET},
+    {ADI_MD03_TWOHOP,             ADI_W2CAN_C2B_MD03_MSGINDEX, ADI_MD03_TWOHOP_OFFSET,  ADI_MD03_TWOHOP_LENGTH * 8U,  ADI_W2CAN_SRC_NETWORK_DATA, ADI_W2CAN_MD_SLOT(2U) + ADI_MD03_TWOHOP_OFFSET},
+    {ADI_MD03_PORTID,             ADI_W2CAN_C2B_MD03_MSGINDEX, ADI_MD03_PORTID_OFFSET,  ADI_MD03_PORTID_LENGTH * 8U,  ADI_W2CAN_SRC_NETWORK_DATA, ADI_W2CAN_MD_SLOT(2U) + ADI_MD03_PORTID_OFFSET},
+    {ADI_MD03_SRCID,              ADI_W2CAN_C2B_MD03_MSGINDEX, ADI_MD03_SRCID_OFFSET,   ADI_MD03_SRCID_LENGTH * 8U,   ADI_W2CAN_SRC_NETWORK_DATA, ADI_W2CAN_MD_SLOT(2U) + ADI_MD03_SRCID_OFFSET},
+
+    /* BMS packet header of base packet 0 */
+    {ADI_BMS_PACKET_PKTID,        ADI_W2CAN_G2B_BMS_PACKET_MSGINDEX, ADI_BMS_PACKET_PKTID_OFFSET,        ADI_BMS_PACKET_PKTID_LENGTH * 8U,        ADI_BMS_BASE_PKT_0_ID, offsetof(adi_bms_packetheader_t, iPacket_id)},
+    {ADI_BMS_PACKET_PKTTIMESTAMP, ADI_W2CAN_G2B_BMS_PACKET_MSGINDEX, ADI_BMS_PACKET_PKTTIMESTAMP_OFFSET, ADI_BMS_PACKET_PKTTIMESTAMP_LENGTH * 8U, ADI_BMS_BASE_PKT_0_ID, offsetof(adi_bms_packetheader_t, iPacket_timestamp_0)},
+    {ADI_BMS_PACKET_PKTCRC,       ADI_W2CAN_G2B_BMS_PACKET_MSGINDEX, ADI_BMS_PACKET_PKTCRC_OFFSET,       ADI_BMS_PACKET_PKTCRC_LENGTH * 8U,       ADI_BMS_BASE_PKT_0_ID, offsetof(adi_bms_packetheader_t, iPacket_crc)},
+
+    {ADI_MD05_ASN,                ADI_W2CAN_C2B_MD05_MSGINDEX, ADI_MD05_ASN_OFFSET,     ADI_MD05_ASN_LENGTH * 8U,     ADI_W2CAN_SRC_NETWORK_DATA, ADI_W2CAN_MD_SLOT(0U) + ADI_MD05_ASN_OFFSET},
+    {ADI_MD06_LATENCY,            ADI_W2CAN_C2B_MD06_MSGINDEX, ADI_MD06_LATENCY_OFFSET, ADI_MD06_LATENCY_LENGTH * 8U, ADI_W2CAN_SRC_NETWORK_DATA, ADI_W2CAN_MD_SLOT(1U) + ADI_MD06_LATENCY_OFFSET},
+    {ADI_MD06_SEQ_NO,             ADI_W2CAN_C2B_MD06_MSGINDEX, ADI_MD06_SEQNO_OFFSET,   ADI_MD06_SEQNO_LENGTH * 8U,   ADI_W2CAN_SRC_NETWORK_DATA, ADI_W2CAN_MD_SLOT(1U) + ADI_MD06_SEQNO_OFFSET},
+    {ADI_MD06_CHANNEL,            ADI_W2CAN_C2B_MD06_MSGINDEX, ADI_MD06_CHANNEL_OFFSET, ADI_MD06_CHANNEL_LENGTH * 8U, ADI_W2CAN_SRC_NETWORK_DATA, ADI_W2CAN_MD_SLOT(1U) + ADI_MD06_CHANNEL_OFFSET},
+    {ADI_MD06_RSSI,               ADI_W2CAN_C2B_MD06_MSGINDEX, ADI_MD06_RSSI_OFFSET,    ADI_MD06_RSSI_LENGTH * 8U,    ADI_W2CAN_SRC_NETWORK_DATA, ADI_W2CAN_MD_SLOT(1U) + ADI_MD06_RSSI_OFFSET},
+    {ADI_MD07_TWOHOP,             ADI_W2CAN_C2B_MD07_MSGINDEX, ADI_MD07_TWOHOP_OFFSET,  ADI_MD07_TWOHOP_LENGTH * 8U,  ADI_W2CAN_SRC_NETWORK_DATA, ADI_W2CAN_MD_SLOT(2U) + ADI_MD07_TWOHOP_OFFSET},
+    {ADI_MD07_PORTID,             ADI_W2CAN_C2B_MD07_MSGINDEX, ADI_MD07_PORTID_OFFSET,  ADI_MD07_PORTID_LENGTH * 8U,  ADI_W2CAN_SRC_NETWORK_DATA, ADI_W2CAN_MD_SLOT(2U) + ADI_MD07_PORTID_OFFSET},
+    {ADI_MD07_SRCID,              ADI_W2CAN_C2B_MD07_MSGINDEX, ADI_MD07_SRCID_OFFSET,   ADI_MD07_SRCID_LENGTH * 8U,   ADI_W2CAN_SRC_NETWORK_DATA, ADI_W2CAN_MD_SLOT(2U) + ADI_MD07_SRCID_OFFSET},
+};
+
+/* C2B health report signal map, one entry per signal in enum order */
+static const adi_w2can_CanSignals_t adi_w2can_HRSignalMap[] =
+{
+    {ADI_HR01_TOTAL_PKTS_GEN,  ADI_W2CAN_C2B_HR01_MSGINDEX, ADI_HR01_TOTAL_PKTS_GEN_OFFSET, ADI_HR01_TOTAL_PKTS_GEN_LENGTH * 8U, PACKET_ID_NODE_DEVICE,      offsetof(adi_wil_health_report0_t, iTotalPktsGenerated)},
+    {ADI_HR01_PKTS_NACKED,     ADI_W2CAN_C2B_HR01_MSGINDEX, ADI_HR01_PKTS_NACKED_OFFSET,    ADI_HR01_PKTS_NACKED_LENGTH * 8U,    PACKET_ID_NODE_DEVICE,      offsetof(adi_wil_health_report0_t, iPacketsNacked)},
+    {ADI_HR01_NETMICFAIL,      ADI_W2CAN_C2B_HR01_MSGINDEX, ADI_HR01_NETMICFAILS_OFFSET,    ADI_HR01_NETMICFAILS_LENGTH * 8U,    PACKET_ID_NODE_DEVICE,      offsetof(adi_wil_health_report0_t, iNetMicFailures)},
+    {ADI_HR01_MACMICFAIL,      ADI_W2CAN_C2B_HR01_MSGINDEX, ADI_HR01_MACMICFAILS_OFFSET,    ADI_HR01_MACMICFAILS_LENGTH * 8U,    PACKET_ID_NODE_DEVICE,      offsetof(adi_wil_health_report0_t, iMacMicFailures)},
+
+    {ADI_HR02_JOINATTEMPTS,    ADI_W2CAN_C2B_HR02_MSGINDEX, ADI_HR02_JOINATTEMPTS_OFFSET,   ADI_HR02_JOINATTEMPTS_LENGTH * 8U,   PACKET_ID_NODE_DEVICE,      offsetof(adi_wil_health_report0_t, iJoinAttempts)},
+    {ADI_HR02_RESET_CNTR,      ADI_W2CAN_C2B_HR02_MSGINDEX, ADI_HR02_RESET_CNTR_OFFSET,     ADI_HR02_RESET_CNTR_LENGTH * 8U,     PACKET_ID_NODE_APPLICATION, offsetof(adi_wil_health_report80_t, iResetCounter)},
+    {ADI_HR02_TWOHOP_CNTR,     ADI_W2CAN_C2B_HR02_MSGINDEX, ADI_HR02_TWOHOP_CNTR_OFFSET,    ADI_HR02_TWOHOP_CNTR_LENGTH * 8U,    PACKET_ID_NODE_DEVICE,      offsetof(adi_wil_health_report0_t, iParents)},
+    {ADI_HR02_SYSDEBUG_INFO,   ADI_W2CAN_C2B_HR02_MSGINDEX, ADI_HR02_SYSDBGINFO_OFFSET,     ADI_HR02_SYSDBGINFO_LENGTH * 8U,     PACKET_ID_NODE_APPLICATION, offsetof(adi_wil_health_report80_t, iAppDebugInfo)},
+
+    {ADI_HR03_PATH_STABILITY,  ADI_W2CAN_C2B_HR03_MSGINDEX, ADI_HR03_PATH_STABILITY_OFFSET, ADI_HR03_PATH_STABILITY_LENGTH * 8U, PACKET_ID_NODE_DEVICE,      offsetof(adi_wil_health_report0_t, pathStability) + 0U},
+    {ADI_HR04_PATH_STABILITY,  ADI_W2CAN_C2B_HR04_MSGINDEX, ADI_HR04_PATH_STABILITY_OFFSET, ADI_HR04_PATH_STABILITY_LENGTH * 8U, PACKET_ID_NODE_DEVICE,      offsetof(adi_wil_health_report0_t, pathStability) + 8U},
+    {ADI_HR05_PATH_STABILITY,  ADI_W2CAN_C2B_HR05_MSGINDEX, ADI_HR05_PATH_STABILITY_OFFSET, ADI_HR05_PATH_STABILITY_LENGTH * 8U, PACKET_ID_NODE_DEVICE,      offsetof(adi_wil_health_report0_t, pathStability) + 16U},
+    {ADI_HR06_PATH_STABILITY,  ADI_W2CAN_C2B_HR06_MSGINDEX, ADI_HR06_PATH_STABILITY_OFFSET, ADI_HR06_PATH_STABILITY_LENGTH * 8U, PACKET_ID_NODE_DEVICE,      offsetof(adi_wil_health_report0_t, pathStability) + 24U},
+
+    {ADI_HR07_SIGNAL_RSSI,     ADI_W2CAN_C2B_HR07_MSGINDEX, ADI_HR07_SIGNAL_RSSI_OFFSET,    ADI_HR07_SIGNAL_RSSI_LENGTH * 8U,    PACKET_ID_NODE_AVERAGE_RSSI, offsetof(adi_wil_health_report1_t, signalRssi) + 0U},
+    {ADI_HR08_SIGNAL_RSSI,     ADI_W2CAN_C2B_HR08_MSGINDEX, ADI_HR08_SIGNAL_RSSI_OFFSET,    ADI_HR08_SIGNAL_RSSI_LENGTH * 8U,    PACKET_ID_NODE_AVERAGE_RSSI, offsetof(adi_wil_health_report1_t, signalRssi) + 8U},
+    {ADI_HR09_SIGNAL_RSSI,     ADI_W2CAN_C2B_HR09_MSGINDEX, ADI_HR09_SIGNAL_RSSI_OFFSET,    ADI_HR09_SIGNAL_RSSI_LENGTH * 8U,    PACKET_ID_NODE_AVERAGE_RSSI, offsetof(adi_wil_health_report1_t, signalRssi) + 16U},
+    {ADI_HR10_SIGNAL_RSSI,     ADI_W2CAN_C2B_HR10_MSGINDEX, ADI_HR10_SIGNAL_RSSI_OFFSET,    ADI_HR10_SIGNAL_RSSI_LENGTH * 8U,    PACKET_ID_NODE_AVERAGE_RSSI, offsetof(adi_wil_health_report1_t, signalRssi) + 24U},
+    {ADI_HR10_QUEUE_FAILURE,   ADI_W2CAN_C2B_HR10_MSGINDEX, ADI_HR10_QUEUE_FAILURE_OFFSET,  ADI_HR10_QUEUE_FAILURE_LENGTH * 8U,  PACKET_ID_NODE_DEVICE,       offsetof(adi_wil_health_report0_t, iPacketQueueFailure)},
+    {ADI_HR10_ADC_TEMPERATURE, ADI_W2CAN_C2B_HR10_MSGINDEX, ADI_HR10_ADC_TEMPERATURE_OFFSET, ADI_HR10_ADC_TEMPERATURE_LENGTH * 8U, PACKET_ID_NODE_DEVICE,   offsetof(adi_wil_health_report0_t, iADCtemp)},
+
+    {ADI_HR11_BACKGROUND_RSSI, ADI_W2CAN_C2B_HR11_MSGINDEX, ADI_HR11_BCKGNDRSSI_OFFSET, ADI_HR11_BCKGNDRSSI_LENGTH * 8U, PACKET_ID_NODE_BACKGROUND_RSSI, offsetof(adi_wil_health_report2_t, backgroundRSSi) + 0U},
+    {ADI_HR12_BACKGROUND_RSSI, ADI_W2CAN_C2B_HR12_MSGINDEX, ADI_HR12_BCKGNDRSSI_OFFSET, ADI_HR12_BCKGNDRSSI_LENGTH * 8U, PACKET_ID_NODE_BACKGROUND_RSSI, offsetof(adi_wil_health_report2_t, backgroundRSSi) + 8U},
+    {ADI_HR13_BACKGROUND_RSSI, ADI_W2CAN_C2B_HR13_MSGINDEX, ADI_HR13_BCKGNDRSSI_OFFSET, ADI_HR13_BCKGNDRSSI_LENGTH * 8U, PACKET_ID_NODE_BACKGROUND_RSSI, offsetof(adi_wil_health_report2_t, backgroundRSSi) + 16U},
+    {ADI_HR14_BACKGROUND_RSSI, ADI_W2CAN_C2B_HR14_MSGINDEX, ADI_HR14_BCKGNDRSSI_OFFSET, ADI_HR14_BCKGNDRSSI_LENGTH * 8U, PACKET_ID_NODE_BACKGROUND_RSSI, offsetof(adi_wil_health_report2_t, backgroundRSSi) + 24U},
+    {ADI_HR15_BACKGROUND_RSSI, ADI_W2CAN_C2B_HR15_MSGINDEX, ADI_HR15_BCKGNDRSSI_OFFSET, ADI_HR15_BCKGNDRSSI_LENGTH * 8U, PACKET_ID_NODE_BACKGROUND_RSSI, offsetof(adi_wil_health_report2_t, backgroundRSSi) + 32U},
+    {ADI_HR16_BACKGROUND_RSSI, ADI_W2CAN_C2B_HR16_MSGINDEX, ADI_HR16_BCKGNDRSSI_OFFSET, ADI_HR16_BCKGNDRSSI_LENGTH * 8U, PACKET_ID_NODE_BACKGROUND_RSSI, offsetof(adi_wil_health_report2_t, backgroundRSSi) + 40U},
+    {ADI_HR17_BACKGROUND_RSSI, ADI_W2CAN_C2B_HR17_MSGINDEX, ADI_HR17_BCKGNDRSSI_OFFSET, ADI_HR17_BCKGNDRSSI_LENGTH * 8U, PACKET_ID_NODE_BACKGROUND_RSSI, offsetof(adi_wil_health_report2_t, backgroundRSSi) + 48U},
+    {ADI_HR18_BACKGROUND_RSSI, ADI_W2CAN_C2B_HR18_MSGINDEX, ADI_HR18_BCKGNDRSSI_OFFSET, ADI_HR18_BCKGNDRSSI_LENGTH * 8U, PACKET_ID_NODE_BACKGROUND_RSSI, offsetof(adi_wil_health_report2_t, backgroundRSSi) + 56U},
+    {ADI_HR19_BACKGROUND_RSSI, ADI_W2CAN_C2B_HR19_MSGINDEX, ADI_HR19_BCKGNDRSSI_OFFSET, ADI_HR19_BCKGNDRSSI_LENGTH * 8U, PACKET_ID_NODE_BACKGROUND_RSSI, offsetof(adi_wil_health_report2_t, backgroundRSSi) + 64U},
+    {ADI_HR20_BACKGROUND_RSSI, ADI_W2CAN_C2B_HR20_MSGINDEX, ADI_HR20_BCKGNDRSSI_OFFSET, ADI_HR20_BCKGNDRSSI_LENGTH * 8U, PACKET_ID_NODE_BACKGROUND_RSSI, offsetof(adi_wil_health_report2_t, backgroundRSSi) + 72U},
+
+    {ADI_HR21_RESET_STATUS,    ADI_W2CAN_C2B_HR21_MSGINDEX, ADI_HR21_RESET_STATUS_OFFSET,  ADI_HR21_RESET_STATUS_LENGTH * 8U,  PACKET_ID_NODE_APPLICATION, offsetof(adi_wil_health_report80_t, iResetStatus)},
+    {ADI_HR21_RESET_COUNTER,   ADI_W2CAN_C2B_HR21_MSGINDEX, ADI_HR21_RESET_CNTR_OFFSET,    ADI_HR21_RESET_CNTR_LENGTH * 8U,    PACKET_ID_NODE_APPLICATION, offsetof(adi_wil_health_report80_t, iResetCounter)},
+    {ADI_HR21_FREE_SPACE,      ADI_W2CAN_C2B_HR21_MSGINDEX, ADI_HR21_FREE_SPACE_OFFSET,    ADI_HR21_FREE_SPACE_LENGTH * 8U,    PACKET_ID_NODE_APPLICATION, offsetof(adi_wil_health_report80_t, iFreeSpaceFS)},
+};
+
+#define ADI_W2CAN_G2B_SIGNAL_COUNT      (sizeof(adi_w2can_G2BSignalMap) / sizeof(adi_w2can_G2BSignalMap[0]))
+#define ADI_W2CAN_HR_SIGNAL_COUNT       (sizeof(adi_w2can_HRSignalMap) / sizeof(adi_w2can_HRSignalMap[0]))
+
+/* 11-bit IDs of node 1 for the per node messages, node n uses base + (n - 1) */
+static const uint32_t adi_w2can_MetaDataBaseId[ADI_W2CAN_CANMESSAGES_PER_NODE - ADI_W2CAN_C2B_MD01_MSGINDEX] =
+{
+    ADI_W2CAN_C2B_MD01_P01,
+    ADI_W2CAN_C2B_MD02_P01,
+    ADI_W2CAN_C2B_MD03_P01,
+    ADI_W2CAN_G2B_N01_BMS_PACKET,
+    ADI_W2CAN_C2B_MD05_P01,
+    ADI_W2CAN_C2B_MD06_P01,
+    ADI_W2CAN_C2B_MD07_P01,
+};
+
+static const uint32_t adi_w2can_PmsMsgId[ADI_W2CAN_PMS_CANMESSAGES] =
+{
+    ADI_W2CAN_G2B_PMS_AUX,
+    ADI_W2CAN_G2B_PMS_I1_I2_VBAT,
+};
+
+static const uint32_t adi_w2can_EmsMsgId[ADI_W2CAN_EMS_CANMESSAGES] =
+{
+    ADI_W2CAN_G2B_G2B_EMS1_CELL_GRP_A,
+    ADI_W2CAN_G2B_G2B_EMS1_CELL_DIAG_GRP_A,
+};
+
+/*******************************************************************************/
+/* Local Variable Declarations                                                 */
+/*******************************************************************************/
+/* CAN message images, written from the WIL event callbacks */
+static uint32_t adi_w2can_NodeImage[ADI_W2CAN_NODE_COUNT][ADI_W2CAN_CANMESSAGES_PER_NODE][ADI_W2CAN_CANMESSAGE_SIZE / 4U];
+static uint32_t adi_w2can_PmsImage[ADI_W2CAN_PMS_CANMESSAGES][ADI_W2CAN_CANMESSAGE_SIZE / 4U];
+static uint32_t adi_w2can_EmsImage[ADI_W2CAN_EMS_CANMESSAGES][ADI_W2CAN_CANMESSAGE_SIZE / 4U];
+static uint32_t adi_w2can_HRImage[ADI_W2CAN_HRCANMESSAGES_PER_NODE][ADI_W2CAN_CANMESSAGE_SIZE / 4U];
+
+/* Node 0-31 in word 0, node 32-61 in word 1 */
+static volatile uint32_t adi_w2can_BmsValid[2];
+static volatile bool adi_w2can_bPmsValid;
+static volatile bool adi_w2can_bEmsValid;
+
+/* Health reports received per node since the last transmission (ADI_W2CAN_HR_xxx_RCVD) */
+static volatile uint8_t adi_w2can_HRReceived[ADI_W2CAN_NODE_COUNT];
+static uint8_t adi_w2can_HRState = ADI_W2CAN_HRHANDLER_IDLE;
+static uint8_t adi_w2can_HRNode;
+static uint16_t adi_w2can_HRWaitCycles;
+
+/* Software frame queue : producers are the cyclic handlers, consumer is adi_w2can_TxPump */
+static adi_w2can_Frame_t adi_w2can_TxQueue[ADI_W2CAN_TXQUEUE_SIZE];
+static uint32_t adi_w2can_TxHead;
+static uint32_t adi_w2can_TxTail;
+
+static uint32_t adi_w2can_BmsCycle;
+
+#if (ADI_W2CAN_VIRTUAL_SINK == 0)
+static IfxCan_Can adi_w2can_Module;
+static IfxCan_Can_Node adi_w2can_Node;
+static bool adi_w2can_bNodeReady = false;
+#endif
+
+/*******************************************************************************/
+/* Local Function Declarations                                                 */
+/*******************************************************************************/
+static void adi_w2can_CopySignal(uint32_t *pImage, adi_w2can_CanSignals_t const *pSignal, uint8_t const *pSrcBuff);
+static uint32_t adi_w2can_TxFree(void);
+static void adi_w2can_Enqueue(uint32_t iFrameId, bool bExtendedId, uint32_t const *pData);
+static void adi_w2can_TxPump(void);
+static void adi_w2can_SinkStore(uint32_t iFrameId, bool bExtendedId, uint32_t const *pData);
+static bool adi_w2can_NodeFrameId(uint8_t iNodeId, uint8_t iMsgIndex, uint32_t *pFrameId);
+static void adi_w2can_QueueNode(uint8_t iNodeId);
+static uint8_t const *adi_w2can_HRSource(uint8_t iNodeId, uint8_t iPacketId);
+static bool adi_w2can_NextHRNode(void);
+
+/*******************************************************************************/
+/* Functions                                                                   */
+/*******************************************************************************/
+
+bool adi_wil_example_w2canInit(void)
+{
+    memset(adi_w2can_NodeImage, 0, sizeof(adi_w2can_NodeImage));
+    memset(adi_w2can_PmsImage, 0, sizeof(adi_w2can_PmsImage));
+    memset(adi_w2can_EmsImage, 0, sizeof(adi_w2can_EmsImage));
+    memset((void *) adi_w2can_HRReceived, 0, sizeof(adi_w2can_HRReceived));
+    memset(&adi_gW2canStats, 0, sizeof(adi_gW2canStats));
+    adi_w2can_BmsValid[0] = 0;
+    adi_w2can_BmsValid[1] = 0;
+    adi_w2can_TxHead = 0;
+    adi_w2can_TxTail = 0;
+    adi_gW2canSinkHead = 0;
+    adi_w2can_HRState = ADI_W2CAN_HRHANDLER_IDLE;
+
+#if (ADI_W2CAN_VIRTUAL_SINK == 0)
+    IfxCan_Can_Config canConfig;
+    IfxCan_Can_NodeConfig nodeConfig;
+
+    IfxCan_Can_initModuleConfig(&canConfig, &MODULE_CAN0);
+    IfxCan_Can_initModule(&adi_w2can_Module, &canConfig);
+
+    IfxCan_Can_initNodeConfig(&nodeConfig, &adi_w2can_Module);
+    nodeConfig.nodeId = IfxCan_NodeId_0;
+    nodeConfig.clockSource = IfxCan_ClockSource_both;
+    nodeConfig.baudRate.baudrate = ADI_W2CAN_BAUDRATE;
+#if (ADI_W2CAN_FD_ENABLE == 1)
+    nodeConfig.frame.mode = IfxCan_FrameMode_fdLongAndFast;
+    nodeConfig.fastBaudRate.baudrate = ADI_W2CAN_FAST_BAUDRATE;
+#else
+    nodeConfig.frame.mode = IfxCan_FrameMode_standard;
+#endif
+
+    /* Tx FIFO only : the gateway never needs a dedicated Tx buffer */
+    nodeConfig.txConfig.txMode = IfxCan_TxMode_fifo;
+    nodeConfig.txConfig.dedicatedTxBuffersNumber = 0;
+    nodeConfig.txConfig.txFifoQueueSize = ADI_W2CAN_TXFIFO_SIZE;
+    nodeConfig.txConfig.txBufferDataFieldSize = IfxCan_DataFieldSize_8;
+
+#if (ADI_W2CAN_LOOPBACK == 1)
+    /* Internal loopback : everything sent is received back into Rx FIFO 0 */
+    nodeConfig.frame.type = IfxCan_FrameType_transmitAndReceive;
+    nodeConfig.busLoopbackEnabled = TRUE;
+    nodeConfig.filterConfig.messageIdLength = IfxCan_MessageIdLength_both;
+    nodeConfig.filterConfig.standardListSize = 0;
+    nodeConfig.filterConfig.extendedListSize = 0;
+    nodeConfig.filterConfig.standardFilterForNonMatchingFrames = IfxCan_NonMatchingFrame_acceptToRxFifo0;
+    nodeConfig.filterConfig.extendedFilterForNonMatchingFrames = IfxCan_NonMatchingFrame_acceptToRxFifo0;
+    nodeConfig.rxConfig.rxMode = IfxCan_RxMode_fifo0;
+    nodeConfig.rxConfig.rxFifo0Size = ADI_W2CAN_TXFIFO_SIZE;
+#else
+    nodeConfig.frame.type = IfxCan_FrameType_transmit;
+    nodeConfig.pins = &(IfxCan_Can_Pins){
+        .txPin = &ADI_W2CAN_TX_PIN,
+        .txPinMode = IfxPort_OutputMode_pushPull,
+        .rxPin = &ADI_W2CAN_RX_PIN,
+        .rxPinMode = IfxPort_InputMode_pullUp,
+        .padDriver = IfxPort_PadDriver_cmosAutomotiveSpeed2
+    };
+#endif
+
+    adi_w2can_bNodeReady = (TRUE == IfxCan_Can_initNode(&adi_w2can_Node, &nodeConfig));
+    return adi_w2can_bNodeReady;
+#else
+    return true;
+#endif
+}
+
+void adi_wil_example_w2canSetSignal(uint8_t NodeId, uint16_t SignalID, uint8_t const *SrcBuff)
+{
+    adi_w2can_CanSignals_t const *pSignal;
+
+    if ((SignalID >= ADI_W2CAN_G2B_SIGNAL_COUNT) || (SrcBuff == NULL))
+    {
+        return;
+    }
+    pSignal = &adi_w2can_G2BSignalMap[SignalID];
+
+    if ((SignalID >= ADI_PMS_CURR_I1) && (SignalID <= ADI_PMS_AUX_HS1_HS2_PEC))
+    {
+        adi_w2can_CopySignal(adi_w2can_PmsImage[pSignal->iMsgTableIndex], pSignal, SrcBuff);
+    }
+    else if ((SignalID >= ADI_EMS_PACKET_C1V) && (SignalID <= ADI_EMS_PACKET_CSA_PEC))
+    {
+        adi_w2can_CopySignal(adi_w2can_EmsImage[pSignal->iMsgTableIndex], pSignal, SrcBuff);
+    }
+    else if (NodeId < ADI_W2CAN_NODE_COUNT)
+    {
+        adi_w2can_CopySignal(adi_w2can_NodeImage[NodeId][pSignal->iMsgTableIndex], pSignal, SrcBuff);
+    }
+}
+
+void adi_wil_example_w2canSetHRSignal(uint8_t iNodeId, uint16_t iSignal, uint8_t const *pSrcBuff)
+{
+    (void) iNodeId;     /* one node is serialized at a time, see adi_wil_example_w2canHealthReportHandler */
+
+    if ((iSignal < ADI_W2CAN_HR_SIGNAL_COUNT) && (pSrcBuff != NULL))
+    {
+        adi_w2can_CopySignal(adi_w2can_HRImage[adi_w2can_HRSignalMap[iSignal].iMsgTableIndex], &adi_w2can_HRSignalMap[iSignal], pSrcBuff);
+    }
+}
+
+void adi_w2can_NotifyBmsData(adi_wil_sensor_data_t const *pData, uint16_t iCount)
+{
+    uint16_t iPacket;
+    uint16_t iSignal;
+    uint8_t iNodeId;
+
+    for (iPacket = 0; iPacket < iCount; iPacket++)
+    {
+        if ((pData[iPacket].iLength == 0) || (pData[iPacket].Data[0] != ADI_BMS_BASE_PKT_0_ID))
+        {
+            continue;
+        }
+        iNodeId = ADK_ConvertDeviceId(pData[iPacket].eDeviceId);
+        if (iNodeId >= ADI_W2CAN_NODE_COUNT)
+        {
+            continue;
+        }
+        for (iSignal = 0; iSignal < ADI_W2CAN_G2B_SIGNAL_COUNT; iSignal++)
+        {
+            if (adi_w2can_G2BSignalMap[iSignal].iSrcPacketId == ADI_BMS_BASE_PKT_0_ID)
+            {
+                adi_wil_example_w2canSetSignal(iNodeId, iSignal, pData[iPacket].Data);
+            }
+        }
+        adi_w2can_BmsValid[iNodeId >> 5] |= (1UL << (iNodeId & 0x1FU));
+    }
+}
+
+void adi_w2can_NotifyNetworkData(adi_wil_network_data_t const *pData, uint16_t iCount)
+{
+    uint8_t aRecord[ADI_W2CAN_MD_RECORD_SIZE];
+    uint16_t iEntry;
+    uint16_t iSignal;
+    uint8_t iNodeId;
+    uint8_t iFirstSignal;
+    uint8_t iLastSignal;
+
+    for (iEntry = 0; iEntry < iCount; iEntry++)
+    {
+        iNodeId = ADK_ConvertDeviceId(pData[iEntry].eSrcDeviceId);
+        if (iNodeId >= ADI_W2CAN_NODE_COUNT)
+        {
+            continue;
+        }
+
+        /* Lay the record out as the MD01 | MD02 | MD03 payloads; WIL does not report two-hop routing */
+        memset(aRecord, 0, sizeof(aRecord));
+        memcpy(&aRecord[ADI_W2CAN_MD_SLOT(0U) + ADI_MD01_ASN_OFFSET], &pData[iEntry].iPacketGenerationTime, ADI_MD01_ASN_LENGTH);
+        memcpy(&aRecord[ADI_W2CAN_MD_SLOT(1U) + ADI_MD02_LATENCY_OFFSET], &pData[iEntry].iLatency, ADI_MD02_LATENCY_LENGTH);
+        memcpy(&aRecord[ADI_W2CAN_MD_SLOT(1U) + ADI_MD02_SEQNO_OFFSET], &pData[iEntry].iSequenceNumber, ADI_MD02_SEQNO_LENGTH);
+        aRecord[ADI_W2CAN_MD_SLOT(1U) + ADI_MD02_CHANNEL_OFFSET] = pData[iEntry].iChannel;
+        aRecord[ADI_W2CAN_MD_SLOT(1U) + ADI_MD02_RSSI_OFFSET] = (uint8_t) pData[iEntry].iRSSI;
+        aRecord[ADI_W2CAN_MD_SLOT(2U) + ADI_MD03_PORTID_OFFSET] = (pData[iEntry].eSrcManagerId == ADI_WIL_DEV_MANAGER_0) ? 0U : 1U;
+        aRecord[ADI_W2CAN_MD_SLOT(2U) + ADI_MD03_SRCID_OFFSET] = iNodeId;
+
+        if (pData[iEntry].eSrcManagerId == ADI_WIL_DEV_MANAGER_0)
+        {
+            iFirstSignal = ADI_MD01_ASN;
+            iLastSignal = ADI_MD03_SRCID;
+        }
+        else
+        {
+            iFirstSignal = ADI_MD05_ASN;
+            iLastSignal = ADI_MD07_SRCID;
+        }
+        for (iSignal = iFirstSignal; iSignal <= iLastSignal; iSignal++)
+        {
+            adi_wil_example_w2canSetSignal(iNodeId, iSignal, aRecord);
+        }
+    }
+}
+
+void adi_w2can_NotifyPmsData(adi_wil_sensor_data_t const *pData, uint16_t iCount)
+{
+    uint16_t iSignal;
+
+    /* Forward the most recent PMS packet of the buffer */
+    while ((iCount > 0) && (pData[iCount - 1U].iLength == 0))
+    {
+        iCount--;
+    }
+    if (iCount == 0)
+    {
+        return;
+    }
+    for (iSignal = ADI_PMS_CURR_I1; iSignal <= ADI_PMS_AUX_HS1_HS2_PEC; iSignal++)
+    {
+        adi_wil_example_w2canSetSignal(0, iSignal, pData[iCount - 1U].Data);
+    }
+    adi_w2can_bPmsValid = true;
+}
+
+void adi_w2can_NotifyEmsData(adi_wil_sensor_data_t const *pData, uint16_t iCount)
+{
+    uint16_t iSignal;
+
+    /* Forward the most recent EMS packet of the buffer */
+    while ((iCount > 0) && (pData[iCount - 1U].iLength == 0))
+    {
+        iCount--;
+    }
+    if (iCount == 0)
+    {
+        return;
+    }
+    for (iSignal = ADI_EMS_PACKET_C1V; iSignal <= ADI_EMS_PACKET_CSA_PEC; iSignal++)
+    {
+        adi_wil_example_w2canSetSignal(0, iSignal, pData[iCount - 1U].Data);
+    }
+    adi_w2can_bEmsValid = true;
+}
+
+void adi_w2can_NotifyHR_availability(uint8_t iNodeId, uint8_t iPacketId)
+{
+    if (iNodeId >= ADI_W2CAN_NODE_COUNT)
+    {
+        return;
+    }
+    switch (iPacketId)
+    {
+        case PACKET_ID_NODE_DEVICE:
+            adi_w2can_HRReceived[iNodeId] |= ADI_W2CAN_HR_DEVICE_RCVD;
+            break;
+        case PACKET_ID_NODE_BACKGROUND_RSSI:
+            adi_w2can_HRReceived[iNodeId] |= ADI_W2CAN_HR_BGRSSI_RCVD;
+            break;
+        case PACKET_ID_NODE_APPLICATION:
+            adi_w2can_HRReceived[iNodeId] |= ADI_W2CAN_HR_APPLICATION_RCVD;
+            break;
+        default:
+            break;
+    }
+}
+
+void adi_wil_example_w2canBmsMsgHandler(void)
+{
+    uint8_t iNodeId;
+    uint32_t iNodes = 0;
+    uint32_t iValid[2];
+
+    if (++adi_w2can_BmsCycle >= ADI_W2CAN_BMS_MSGPERIODICITY)
+    {
+        adi_w2can_BmsCycle = 0;
+        iValid[0] = adi_w2can_BmsValid[0];
+        iValid[1] = adi_w2can_BmsValid[1];
+
+        for (iNodeId = 0; iNodeId < ADI_W2CAN_NODE_COUNT; iNodeId++)
+        {
+            if ((iValid[iNodeId >> 5] & (1UL << (iNodeId & 0x1FU))) != 0)
+            {
+                iNodes++;
+            }
+        }
+
+        /* The whole snapshot goes in at once or not at all, never half a pack */
+        if (adi_w2can_TxFree() < (iNodes * ADI_W2CAN_CANMESSAGES_PER_NODE))
+        {
+            adi_gW2canStats.iSnapshotsSkipped++;
+        }
+        else
+        {
+            for (iNodeId = 0; iNodeId < ADI_W2CAN_NODE_COUNT; iNodeId++)
+            {
+                if ((iValid[iNodeId >> 5] & (1UL << (iNodeId & 0x1FU))) != 0)
+                {
+                    adi_w2can_QueueNode(iNodeId);
+                }
+            }
+            adi_gW2canNodeCount = iNodes;
+        }
+    }
+
+    adi_w2can_TxPump();
+}
+
+void adi_wil_example_w2canPmsMsgHandler(void)
+{
+    uint8_t iMsg;
+    boolean bInterruptState;
+
+    if (!adi_w2can_bPmsValid)
+    {
+        return;
+    }
+    bInterruptState = IfxCpu_disableInterrupts();
+    for (iMsg = 0; iMsg < ADI_W2CAN_PMS_CANMESSAGES; iMsg++)
+    {
+        adi_w2can_Enqueue(ADI_W2CAN_EXTENDED_ID ? ADI_W2CAN_EXT_ID(ADI_W2CAN_EXT_GROUP_PACK, 0U, iMsg) : adi_w2can_PmsMsgId[iMsg],
+                          ADI_W2CAN_EXTENDED_ID, adi_w2can_PmsImage[iMsg]);
+    }
+    IfxCpu_restoreInterrupts(bInterruptState);
+}
+
+void adi_wil_example_w2canEmsMsgHandler(void)
+{
+    uint8_t iMsg;
+    boolean bInterruptState;
+
+    if (!adi_w2can_bEmsValid)
+    {
+        return;
+    }
+    bInterruptState = IfxCpu_disableInterrupts();
+    for (iMsg = 0; iMsg < ADI_W2CAN_EMS_CANMESSAGES; iMsg++)
+    {
+        adi_w2can_Enqueue(ADI_W2CAN_EXTENDED_ID ? ADI_W2CAN_EXT_ID(ADI_W2CAN_EXT_GROUP_PACK, 1U, iMsg) : adi_w2can_EmsMsgId[iMsg],
+                          ADI_W2CAN_EXTENDED_ID, adi_w2can_EmsImage[iMsg]);
+    }
+    IfxCpu_restoreInterrupts(bInterruptState);
+}
+
+void adi_wil_example_w2canHealthReportHandler(void)
+{
+    uint16_t iSignal;
+    uint8_t iMsg;
+    uint32_t iFrameId;
+
+    switch (adi_w2can_HRState)
+    {
+        case ADI_W2CAN_HRHANDLER_IDLE:
+            if (adi_w2can_NextHRNode())
+            {
+                adi_w2can_HRState = ADI_W2CAN_HRHANDLER_SETSIGNALS;
+            }
+            break;
+
+        case ADI_W2CAN_HRHANDLER_SETSIGNALS:
+            memset(adi_w2can_HRImage, 0, sizeof(adi_w2can_HRImage));
+            for (iSignal = 0; iSignal < ADI_W2CAN_HR_SIGNAL_COUNT; iSignal++)
+            {
+                adi_wil_example_w2canSetHRSignal(adi_w2can_HRNode, iSignal,
+                                                 adi_w2can_HRSource(adi_w2can_HRNode, adi_w2can_HRSignalMap[iSignal].iSrcPacketId));
+            }
+            adi_w2can_HRWaitCycles = 0;
+            adi_w2can_HRState = ADI_W2CAN_HRHANDLER_TRANSMIT;
+            /* fall through : try to queue straight away */
+
+        case ADI_W2CAN_HRHANDLER_TRANSMIT:
+            if (adi_w2can_TxFree() >= ADI_W2CAN_HRCANMESSAGES_PER_NODE)
+            {
+                for (iMsg = 0; iMsg < ADI_W2CAN_HRCANMESSAGES_PER_NODE; iMsg++)
+                {
+                    if (ADI_W2CAN_EXTENDED_ID)
+                    {
+                        iFrameId = ADI_W2CAN_EXT_ID(ADI_W2CAN_EXT_GROUP_HR, adi_w2can_HRNode, iMsg);
+                    }
+                    else
+                    {
+                        iFrameId = ADI_W2CAN_C2B_HR01_N01 + ((uint32_t) iMsg * (ADI_W2CAN_C2B_HR02_N01 - ADI_W2CAN_C2B_HR01_N01)) + adi_w2can_HRNode;
+                    }
+                    adi_w2can_Enqueue(iFrameId, ADI_W2CAN_EXTENDED_ID, adi_w2can_HRImage[iMsg]);
+                }
+                adi_w2can_HRState = ADI_W2CAN_HRHANDLER_IDLE;
+            }
+            else if (++adi_w2can_HRWaitCycles >= ADI_W2CAN_HR_MAX_WAIT_CYCLES)
+            {
+                /* The BMS traffic did not leave room within ADI_W2CAN_HRTX_TIMEOUT */
+                adi_gW2canStats.iHRAborted++;
+                adi_w2can_HRState = ADI_W2CAN_HRHANDLER_IDLE;
+            }
+            break;
+
+        default:
+            adi_w2can_HRState = ADI_W2CAN_HRHANDLER_IDLE;
+            break;
+    }
+}
+
+/**
+ * @brief   Copies one mapped signal from its source packet into a CAN message image
+ */
+static void adi_w2can_CopySignal(uint32_t *pImage, adi_w2can_CanSignals_t const *pSignal, uint8_t const *pSrcBuff)
+{
+    uint8_t iBytes = pSignal->iSignalLen / 8U;
+
+    if ((iBytes != 0) && ((pSignal->iStartByte + iBytes) <= ADI_W2CAN_CANMESSAGE_SIZE))
+    {
+        memcpy(((uint8_t *) pImage) + pSignal->iStartByte, &pSrcBuff[pSignal->iSrcOffset], iBytes);
+    }
+}
+
+/**
+ * @brief   Resolves the CAN ID of a per node message, false if the node has no 11-bit ID
+ */
+static bool adi_w2can_NodeFrameId(uint8_t iNodeId, uint8_t iMsgIndex, uint32_t *pFrameId)
+{
+#if (ADI_W2CAN_EXTENDED_ID == 1)
+    *pFrameId = ADI_W2CAN_EXT_ID(ADI_W2CAN_EXT_GROUP_BMS, iNodeId, iMsgIndex);
+    return true;
+#else
+    if (iNodeId >= ADI_W2CAN_MAXIMUM_WIRELESS_NODES)
+    {
+        return false;
+    }
+    if (iMsgIndex <= ADI_W2CAN_G2B_CELLGRPD_MSGINDEX)
+    {
+        *pFrameId = ADI_W2CAN_G2B_N1_CELL_GRPA + (4U * iNodeId) + iMsgIndex;
+    }
+    else
+    {
+        *pFrameId = adi_w2can_MetaDataBaseId[iMsgIndex - ADI_W2CAN_C2B_MD01_MSGINDEX] + iNodeId;
+    }
+    return true;
+#endif
+}
+
+/**
+ * @brief   Queues the CAN messages of one node; the image is copied with interrupts
+ *          disabled so a WIL callback cannot update it half way through
+ */
+static void adi_w2can_QueueNode(uint8_t iNodeId)
+{
+    uint8_t iMsg;
+    uint32_t iFrameId;
+    boolean bInterruptState;
+
+    if (!adi_w2can_NodeFrameId(iNodeId, 0, &iFrameId))
+    {
+        adi_gW2canStats.iNodesWithoutId++;
+        return;
+    }
+
+    bInterruptState = IfxCpu_disableInterrupts();
+    for (iMsg = 0; iMsg < ADI_W2CAN_CANMESSAGES_PER_NODE; iMsg++)
+    {
+        (void) adi_w2can_NodeFrameId(iNodeId, iMsg, &iFrameId);
+        adi_w2can_Enqueue(iFrameId, ADI_W2CAN_EXTENDED_ID, adi_w2can_NodeImage[iNodeId][iMsg]);
+    }
+    IfxCpu_restoreInterrupts(bInterruptState);
+}
+
+/**
+ * @brief   Returns the stored health report a signal is taken from
+ */
+static uint8_t const *adi_w2can_HRSource(uint8_t iNodeId, uint8_t iPacketId)
+{
+    switch (iPacketId)
+    {
+        case PACKET_ID_NODE_DEVICE:
+            return (uint8_t const *) &userHR0Buffer[iNodeId];
+        case PACKET_ID_NODE_AVERAGE_RSSI:
+            return (uint8_t const *) &userHR1Buffer[iNodeId];
+        case PACKET_ID_NODE_BACKGROUND_RSSI:
+            return (uint8_t const *) &userHR2Buffer[iNodeId];
+        case PACKET_ID_NODE_APPLICATION:
+            return (uint8_t const *) &userHR80Buffer[iNodeId];
+        default:
+            return NULL;
+    }
+}
+
+/**
+ * @brief   Picks the next node (round robin) that has reported all NUM_HEALTH_REPORT_PER_NODE reports
+ */
+static bool adi_w2can_NextHRNode(void)
+{
+    uint8_t iCount;
+    uint8_t iNodeId = adi_w2can_HRNode;
+
+    for (iCount = 0; iCount < ADI_W2CAN_NODE_COUNT; iCount++)
+    {
+        iNodeId = (uint8_t) ((iNodeId + 1U) % ADI_W2CAN_NODE_COUNT);
+        if (adi_w2can_HRReceived[iNodeId] == ADI_W2CAN_HR_ALL_RCVD)
+        {
+            adi_w2can_HRReceived[iNodeId] = 0;
+            adi_w2can_HRNode = iNodeId;
+            return true;
+        }
+    }
+    return false;
+}
+
+static uint32_t adi_w2can_TxFree(void)
+{
+    return ADI_W2CAN_TXQUEUE_SIZE - (adi_w2can_TxHead - adi_w2can_TxTail);
+}
+
+static void adi_w2can_Enqueue(uint32_t iFrameId, bool bExtendedId, uint32_t const *pData)
+{
+    adi_w2can_Frame_t *pFrame;
+    uint32_t iUsed;
+
+    if (adi_w2can_TxFree() == 0)
+    {
+        adi_gW2canStats.iFramesDropped++;
+        return;
+    }
+    pFrame = &adi_w2can_TxQueue[adi_w2can_TxHead & ADI_W2CAN_TXQUEUE_MASK];
+    pFrame->iCanFrameID = iFrameId;
+    pFrame->bExtendedId = bExtendedId ? 1U : 0U;
+    pFrame->iDlc = ADI_W2CAN_CANMESSAGE_SIZE;
+    pFrame->Data[0] = pData[0];
+    pFrame->Data[1] = pData[1];
+    adi_w2can_TxHead++;
+
+    adi_gW2canStats.iFramesQueued++;
+    iUsed = adi_w2can_TxHead - adi_w2can_TxTail;
+    if (iUsed > adi_gW2canStats.iQueuePeak)
+    {
+        adi_gW2canStats.iQueuePeak = (uint16_t) iUsed;
+    }
+}
+
+static void adi_w2can_SinkStore(uint32_t iFrameId, bool bExtendedId, uint32_t const *pData)
+{
+    adi_w2can_Frame_t *pFrame = &adi_gW2canSink[adi_gW2canSinkHead & ADI_W2CAN_SINK_MASK];
+
+    pFrame->iCanFrameID = iFrameId;
+    pFrame->bExtendedId = bExtendedId ? 1U : 0U;
+    pFrame->iDlc = ADI_W2CAN_CANMESSAGE_SIZE;
+    pFrame->Data[0] = pData[0];
+    pFrame->Data[1] = pData[1];
+    adi_gW2canSinkHead++;
+    adi_gW2canStats.iSinkFrames++;
+}
+
+/**
+ * @brief   Moves queued frames into the MCMCAN Tx FIFO until it is full (one burst)
+ *          and, in loopback mode, collects the frames received back
+ */
+static void adi_w2can_TxPump(void)
+{
+    adi_w2can_Frame_t *pFrame;
+    uint16_t iBurst = 0;
+
+#if (ADI_W2CAN_VIRTUAL_SINK == 1)
+    while ((adi_w2can_TxTail != adi_w2can_TxHead) && (iBurst < ADI_W2CAN_TXFIFO_SIZE))
+    {
+        pFrame = &adi_w2can_TxQueue[adi_w2can_TxTail & ADI_W2CAN_TXQUEUE_MASK];
+        adi_w2can_SinkStore(pFrame->iCanFrameID, (pFrame->bExtendedId != 0U), pFrame->Data);
+        adi_w2can_TxTail++;
+        iBurst++;
+    }
+#else
+    IfxCan_Message txMsg;
+
+    if (!adi_w2can_bNodeReady)
+    {
+        return;
+    }
+
+    IfxCan_Can_initMessage(&txMsg);
+    txMsg.storeInTxFifoQueue = TRUE;
+    txMsg.dataLengthCode = IfxCan_DataLengthCode_8;
+#if (ADI_W2CAN_FD_ENABLE == 1)
+    txMsg.frameMode = IfxCan_FrameMode_fdLongAndFast;
+#else
+    txMsg.frameMode = IfxCan_FrameMode_standard;
+#endif
+
+    while ((adi_w2can_TxTail != adi_w2can_TxHead) && (IfxCan_Can_isTxFifoQueueFull(&adi_w2can_Node) == FALSE))
+    {
+        pFrame = &adi_w2can_TxQueue[adi_w2can_TxTail & ADI_W2CAN_TXQUEUE_MASK];
+        txMsg.messageId = pFrame->iCanFrameID;
+        txMsg.messageIdLength = (pFrame->bExtendedId != 0U) ? IfxCan_MessageIdLength_extended : IfxCan_MessageIdLength_standard;
+        if (IfxCan_Can_sendMessage(&adi_w2can_Node, &txMsg, (uint32 *) pFrame->Data) != IfxCan_Status_ok)
+        {
+            break;
+        }
+        adi_w2can_TxTail++;
+        iBurst++;
+    }
+
+#if (ADI_W2CAN_LOOPBACK == 1)
+    {
+        IfxCan_Message rxMsg;
+        uint32 rxData[ADI_W2CAN_CANMESSAGE_SIZE / 4U];
+
+        IfxCan_Can_initMessage(&rxMsg);
+        rxMsg.readFromRxFifo0 = TRUE;
+        while (IfxCan_Can_getRxFifo0FillLevel(&adi_w2can_Node) > 0)
+        {
+            IfxCan_Can_readMessage(&adi_w2can_Node, &rxMsg, rxData);
+            adi_w2can_SinkStore(rxMsg.messageId, (rxMsg.messageIdLength == IfxCan_MessageIdLength_extended), (uint32_t const *) rxData);
+        }
+    }
+#endif
+#endif
+
+    adi_gW2canStats.iFramesSent += iBurst;
+    if (iBurst > adi_gW2canStats.iTxBurstPeak)
+    {
+        adi_gW2canStats.iTxBurstPeak = iBurst;
+    }
+}
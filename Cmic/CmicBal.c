@@ -0,0 +1,344 @@
+/*
+ * CmicBal.c
+ *
+ *  Closed loop cell balancing. A cell starts discharging when it reads more
+ *  than CMIC_BAL_START_DELTA above the lowest plausible cell of the pack and
+ *  stops at CMIC_BAL_STOP_DELTA. Neighbouring cells never discharge together,
+ *  at most CMIC_BAL_MAX_CELLS_NODE cells of a node discharge and a hot node
+ *  stops. A written pattern is held for CMIC_BAL_HOLD_INTERVALS, except when
+ *  cells have to stop for a fault or the thermal limit.
+ */
+
+#include <string.h>
+
+#include "CmicBal.h"
+#if (CMIC_BAL_SIMULATION == 1)
+#include "adi_wil_example_functions.h"
+#include "adi_wil_example_printf.h"
+#endif
+
+typedef struct
+{
+	uint32			m_aTarget[CMIC_PACK_MAX_NODES];			//Cells to discharge, bit per cell
+	uint32			m_aWritten[CMIC_PACK_MAX_NODES];		//Cells last written with ModifyScript
+	uint8			m_aHold[CMIC_PACK_MAX_NODES];			//Intervals before the target may change again
+	bool			m_aHot[CMIC_PACK_MAX_NODES];			//Held off by the thermal limit
+	Cmic_BalStats_t	m_tStats;
+
+} CmicBal_Instance_t;
+
+static CmicBal_Instance_t CmicBal_Inst;
+
+static bool Cmic_BalNodeHot(uint8 nNode);
+static uint32 Cmic_BalNodeTarget(uint8 nNode, sint16 nRef, uint32 nCurrent, uint32 *pBlocked);
+static uint8 Cmic_BalCount(uint32 nCells);
+
+void Cmic_BalInit(void)
+{
+	memset(&CmicBal_Inst, 0, sizeof(CmicBal_Inst));
+}
+
+bool Cmic_BalUpdate(uint8 nNodeCount)
+{
+	Cmic_PackAgg_t const *pAgg = Cmic_PackGetCellAgg();
+	Cmic_BalStats_t *pStats = &CmicBal_Inst.m_tStats;
+	uint32 nTarget, nBlocked;
+	uint8 nNode;
+
+	if (nNodeCount > CMIC_PACK_MAX_NODES) {
+		nNodeCount = CMIC_PACK_MAX_NODES;
+	}
+
+	pStats->nIntervals++;
+	pStats->nActiveCells = 0u;
+	pStats->nPendingNodes = 0u;
+	pStats->nHotNodes = 0u;
+
+	for (nNode = 0; nNode < nNodeCount; nNode++) {
+
+		if (CmicBal_Inst.m_aHold[nNode] != 0u) {
+			CmicBal_Inst.m_aHold[nNode]--;
+		}
+
+		CmicBal_Inst.m_aHot[nNode] = Cmic_BalNodeHot(nNode);
+
+		if (CmicBal_Inst.m_aHot[nNode] || (pAgg->nCount == 0u)) {
+			pStats->nHotNodes += CmicBal_Inst.m_aHot[nNode] ? 1u : 0u;
+			nTarget = 0u;
+			nBlocked = CmicBal_Inst.m_aTarget[nNode];
+		}
+		else {
+			nTarget = Cmic_BalNodeTarget(nNode, pAgg->nMin, CmicBal_Inst.m_aTarget[nNode], &nBlocked);
+		}
+
+		/* Stopping a cell that may no longer discharge does not wait for the hold */
+		if (nTarget != CmicBal_Inst.m_aTarget[nNode]) {
+			if ((CmicBal_Inst.m_aHold[nNode] == 0u) || ((CmicBal_Inst.m_aTarget[nNode] & nBlocked) != 0u)) {
+				if (CmicBal_Inst.m_aHold[nNode] != 0u) {
+					nTarget = CmicBal_Inst.m_aTarget[nNode] & ~nBlocked;
+				}
+				CmicBal_Inst.m_aTarget[nNode] = nTarget;
+				CmicBal_Inst.m_aHold[nNode] = CMIC_BAL_HOLD_INTERVALS;
+				pStats->nPatternChanges++;
+			}
+		}
+
+		pStats->nActiveCells += Cmic_BalCount(CmicBal_Inst.m_aTarget[nNode]);
+		if (CmicBal_Inst.m_aTarget[nNode] != CmicBal_Inst.m_aWritten[nNode]) {
+			pStats->nPendingNodes++;
+		}
+	}
+
+	return (pStats->nPendingNodes != 0u);
+}
+
+uint32 Cmic_BalGetTarget(uint8 nNode)
+{
+	return (nNode < CMIC_PACK_MAX_NODES) ? CmicBal_Inst.m_aTarget[nNode] : 0u;
+}
+
+uint32 Cmic_BalGetChange(uint8 nNode)
+{
+	return (nNode < CMIC_PACK_MAX_NODES) ? (CmicBal_Inst.m_aTarget[nNode] ^ CmicBal_Inst.m_aWritten[nNode]) : 0u;
+}
+
+void Cmic_BalCommit(uint8 nNode, uint32 nCells, uint8 nWrites)
+{
+	if (nNode >= CMIC_PACK_MAX_NODES) return;
+
+	CmicBal_Inst.m_aWritten[nNode] = nCells;
+	CmicBal_Inst.m_tStats.nTransactions += nWrites;
+}
+
+Cmic_BalStats_t const * Cmic_BalGetStats(void)
+{
+	return &CmicBal_Inst.m_tStats;
+}
+
+/* Lowest present aux code against the thermal limit, with hysteresis */
+static bool Cmic_BalNodeHot(uint8 nNode)
+{
+	sint16 const *pCode = &Cmic_PackGetTempCodes()[CMIC_PACK_TEMP_INDEX(nNode, 0u)];
+	sint16 nLimit;
+	bool bHot = false;
+	uint8 i;
+
+	nLimit = CmicBal_Inst.m_aHot[nNode] ? (sint16)(CMIC_BAL_TEMP_CODE_MIN + CMIC_BAL_TEMP_CODE_HYST) : (sint16)CMIC_BAL_TEMP_CODE_MIN;
+
+	for (i = 0; i < CMIC_PACK_TEMPS; i++) {
+		if (pCode[i] < nLimit) {
+			bHot = true;
+		}
+	}
+
+	return bHot;
+}
+
+/* Cells of the node to discharge. Cells already discharging are kept until
+ * they reach the stop threshold, so the pattern only changes when it has to.
+ * New cells are added highest first, skipping neighbours of chosen cells.
+ * *pBlocked returns the cells that may not discharge at all */
+static uint32 Cmic_BalNodeTarget(uint8 nNode, sint16 nRef, uint32 nCurrent, uint32 *pBlocked)
+{
+	uint16 nBase = CMIC_PACK_CELL_INDEX(nNode, 0u);
+	sint16 const *pCode = &Cmic_PackGetCellCodes()[nBase];
+	uint8 const *pStatus = &Cmic_PackGetCellStatus()[nBase];
+	uint32 nKeep = 0u;
+	uint32 nCandidate = 0u;
+	uint32 nBlocked = 0u;
+	sint32 nDelta, nBest;
+	uint8 nCount, nPick, i;
+
+	for (i = 0; i < CMIC_PACK_CELLS; i++) {
+
+		if ((pStatus[i] & (CMIC_PACK_ST_PRESENT | CMIC_PACK_ST_FAULT | CMIC_PACK_ST_OWD)) != CMIC_PACK_ST_PRESENT) {
+			nBlocked |= (1uL << i);
+			continue;
+		}
+
+		nDelta = (sint32)pCode[i] - (sint32)nRef;
+
+		if ((nCurrent & (1uL << i)) != 0u) {
+			if (nDelta > CMIC_BAL_STOP_DELTA) {
+				nKeep |= (1uL << i);
+			}
+		}
+		else if (nDelta > CMIC_BAL_START_DELTA) {
+			nCandidate |= (1uL << i);
+		}
+	}
+
+	/* At most CMIC_PACK_CELLS rounds, each takes a candidate out */
+	nCount = Cmic_BalCount(nKeep);
+	while ((nCount < CMIC_BAL_MAX_CELLS_NODE) && (nCandidate != 0u)) {
+
+		nPick = CMIC_PACK_CELLS;
+		nBest = 0;
+		for (i = 0; i < CMIC_PACK_CELLS; i++) {
+			if (((nCandidate & (1uL << i)) != 0u) && ((nPick == CMIC_PACK_CELLS) || (pCode[i] > nBest))) {
+				nPick = i;
+				nBest = pCode[i];
+			}
+		}
+
+		nCandidate &= ~(1uL << nPick);
+		if ((nKeep & (((1uL << nPick) << 1) | ((1uL << nPick) >> 1))) == 0u) {
+			nKeep |= (1uL << nPick);
+			nCount++;
+		}
+	}
+
+	*pBlocked = nBlocked;
+	return nKeep;
+}
+
+static uint8 Cmic_BalCount(uint32 nCells)
+{
+	uint8 nCount = 0u;
+
+	for (; nCells != 0u; nCells &= (nCells - 1u)) {
+		nCount++;
+	}
+
+	return nCount;
+}
+
+#if (CMIC_BAL_SIMULATION == 1)
+#define CMIC_BAL_SIM_NODES			12u
+#define CMIC_BAL_SIM_INTERVALS		20000u
+#define CMIC_BAL_SIM_REPORT			500u
+#define CMIC_BAL_SIM_SPREAD			400u		/* Initial spread of the cells, 60 mV */
+#define CMIC_BAL_SIM_BLEED			0.25f		/* Codes per interval lost by a discharging cell */
+#define CMIC_BAL_SIM_DRIFT			0.02f		/* Largest self discharge, codes per interval */
+#define CMIC_BAL_SIM_IR_DROP		7			/* Codes a discharging cell reads low */
+#define CMIC_BAL_SIM_HOT_NODE		3u			/* Node with the poorest cooling */
+#define CMIC_BAL_SIM_HEAT			250.0f		/* Settled aux code drop per discharging cell */
+#define CMIC_BAL_SIM_HOT_HEAT		1000.0f		/* Same on the hot node, three cells take it past CMIC_BAL_TEMP_CODE_MIN */
+#define CMIC_BAL_SIM_AMBIENT		(-3000.0f)	/* Aux code at about 40 degC */
+
+static uint32 nCmicBalSimSeed;
+
+static uint32 Cmic_BalSimRandom(uint32 nRange)
+{
+	nCmicBalSimSeed = (nCmicBalSimSeed * 1664525uL) + 1013904223uL;
+	return (nCmicBalSimSeed >> 8) % nRange;
+}
+
+/* Spread of the modelled cells in codes */
+static float32 Cmic_BalSimSpread(float32 const *pCell)
+{
+	float32 fMin = pCell[0];
+	float32 fMax = pCell[0];
+	uint16 i;
+
+	for (i = 1u; i < (CMIC_BAL_SIM_NODES * CMIC_PACK_CELLS); i++) {
+		if (pCell[i] < fMin) fMin = pCell[i];
+		if (pCell[i] > fMax) fMax = pCell[i];
+	}
+
+	return fMax - fMin;
+}
+
+/* Models a pack at rest with an uneven state of charge and uneven self
+ * discharge. Each interval the modelled cells are measured into the pack
+ * matrix, the controller runs and the changed nodes are written the way the
+ * CMIC balancing steps do: CFGA only for DCC[18:17], CFGB only for DCC[16:1] */
+void Cmic_BalSimulation(void)
+{
+	static float32 aCell[CMIC_BAL_SIM_NODES * CMIC_PACK_CELLS];
+	static float32 aDrift[CMIC_BAL_SIM_NODES * CMIC_PACK_CELLS];
+	static float32 aHeat[CMIC_BAL_SIM_NODES];
+	sint16 aCodes[CMIC_PACK_CELLS];
+	sint16 aTemps[CMIC_PACK_TEMPS];
+	Cmic_BalStats_t const *pStats = Cmic_BalGetStats();
+	uint32 nInterval, nConverged = 0u, nHotIntervals = 0u, nCells, nDcc;
+	uint16 nIdx;
+	uint8 nNode, nWrites, i;
+
+	Cmic_PackInit();
+	Cmic_BalInit();
+	nCmicBalSimSeed = 1u;
+
+	for (nIdx = 0u; nIdx < (CMIC_BAL_SIM_NODES * CMIC_PACK_CELLS); nIdx++) {
+		aCell[nIdx] = 14667.0f + (float32)Cmic_BalSimRandom(CMIC_BAL_SIM_SPREAD);
+		aDrift[nIdx] = CMIC_BAL_SIM_DRIFT * (float32)Cmic_BalSimRandom(1000u) / 1000.0f;
+	}
+	memset(aHeat, 0, sizeof(aHeat));
+
+	adi_wil_ex_printf("Cmic balancing simulation, %u nodes, initial spread %u uV" LINE_END,
+	                  (unsigned int)CMIC_BAL_SIM_NODES, (unsigned int)(Cmic_BalSimSpread(aCell) * CELL_UNIT));
+
+	for (nInterval = 1u; nInterval <= CMIC_BAL_SIM_INTERVALS; nInterval++) {
+
+		for (nNode = 0u; nNode < CMIC_BAL_SIM_NODES; nNode++) {
+			nCells = Cmic_BalGetTarget(nNode);
+			for (i = 0u; i < CMIC_PACK_CELLS; i++) {
+				nIdx = CMIC_PACK_CELL_INDEX(nNode, i);
+				aCodes[i] = (sint16)aCell[nIdx] + (sint16)Cmic_BalSimRandom(5u) - 2;
+				if ((nCells & (1uL << i)) != 0u) {
+					aCodes[i] -= CMIC_BAL_SIM_IR_DROP;
+				}
+			}
+			Cmic_PackSetNodeCells(nNode, aCodes, 0u, 0u);
+
+			/* Every discharging cell heats the board above ambient */
+			for (i = 0u; i < CMIC_PACK_TEMPS; i++) {
+				aTemps[i] = (sint16)(CMIC_BAL_SIM_AMBIENT - aHeat[nNode]);
+			}
+			Cmic_PackSetNodeTemps(nNode, aTemps);
+		}
+
+		(void)Cmic_BalUpdate(CMIC_BAL_SIM_NODES);
+		if (pStats->nHotNodes != 0u) {
+			nHotIntervals++;
+		}
+
+		for (nNode = 0u; nNode < CMIC_BAL_SIM_NODES; nNode++) {
+			nDcc = CMIC_BAL_CELLS_TO_DCC(Cmic_BalGetChange(nNode));
+			if (nDcc != 0u) {
+				nWrites = (uint8)((((nDcc & CMIC_BAL_DCC_CFGA_MASK) != 0u) ? 1u : 0u) + (((nDcc & CMIC_BAL_DCC_CFGB_MASK) != 0u) ? 1u : 0u));
+				Cmic_BalCommit(nNode, Cmic_BalGetTarget(nNode), nWrites);
+			}
+
+			/* The written pattern acts on the cells until the next interval */
+			nCells = Cmic_BalGetTarget(nNode);
+			for (i = 0u; i < CMIC_PACK_CELLS; i++) {
+				nIdx = CMIC_PACK_CELL_INDEX(nNode, i);
+				aCell[nIdx] -= aDrift[nIdx];
+				if ((nCells & (1uL << i)) != 0u) {
+					aCell[nIdx] -= CMIC_BAL_SIM_BLEED;
+				}
+			}
+			aHeat[nNode] += ((((nNode == CMIC_BAL_SIM_HOT_NODE) ? CMIC_BAL_SIM_HOT_HEAT : CMIC_BAL_SIM_HEAT) * (float32)Cmic_BalCount(nCells)) - aHeat[nNode]) / 50.0f;
+		}
+
+		if ((nConverged == 0u) && (pStats->nActiveCells == 0u) && (Cmic_BalSimSpread(aCell) <= (float32)CMIC_BAL_START_DELTA)) {
+			nConverged = nInterval;
+		}
+
+		if ((nInterval % CMIC_BAL_SIM_REPORT) == 0u) {
+			adi_wil_ex_printf("  interval %5u : spread %6u uV, discharging %3u, hot nodes %u, writes %u" LINE_END,
+			                  (unsigned int)nInterval,
+			                  (unsigned int)(Cmic_BalSimSpread(aCell) * CELL_UNIT),
+			                  (unsigned int)pStats->nActiveCells,
+			                  (unsigned int)pStats->nHotNodes,
+			                  (unsigned int)pStats->nTransactions);
+		}
+
+		if (nConverged != 0u) {
+			break;
+		}
+	}
+
+	adi_wil_ex_printf("Converged at interval %u, spread %u uV, %u intervals with a hot node, %u pattern changes, %u ModifyScript writes (%u when every node is written each interval)" LINE_END,
+	                  (unsigned int)nConverged,
+	                  (unsigned int)(Cmic_BalSimSpread(aCell) * CELL_UNIT),
+	                  (unsigned int)nHotIntervals,
+	                  (unsigned int)pStats->nPatternChanges,
+	                  (unsigned int)pStats->nTransactions,
+	                  (unsigned int)(2u * CMIC_BAL_SIM_NODES * ((nConverged != 0u) ? nConverged : CMIC_BAL_SIM_INTERVALS)));
+
+	Cmic_PackInit();
+	Cmic_BalInit();
+}
+#endif
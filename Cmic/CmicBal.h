@@ -0,0 +1,65 @@
+/*
+ * CmicBal.h
+ *
+ *  Closed loop cell balancing. Once per measurement interval the controller
+ *  reads the pack cell matrix and decides which cells of each node discharge.
+ *  The CMIC balancing steps only write the nodes whose pattern changed.
+ */
+
+#ifndef CMICBAL_H_
+#define CMICBAL_H_
+
+#include <stdbool.h>
+
+#include "Platform_Types.h"
+#include "CmicMConfig.h"
+#include "CmicPack.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+/* The 16 cells are read from C channels 2..9 and 11..18, see Cmic_ReadBasePkt0.
+ * Cell bit i maps to DCC bit i+1 for cells 0..7 and i+2 for cells 8..15 */
+#define CMIC_BAL_CELLS_TO_DCC(cells)	((((uint32)(cells) & 0x00FFu) << 1) | (((uint32)(cells) & 0xFF00u) << 2))
+
+/* DCC[18:17] are held in CFGA, DCC[16:1] in CFGB */
+#define CMIC_BAL_DCC_CFGA_MASK			0x30000uL
+#define CMIC_BAL_DCC_CFGB_MASK			0x0FFFFuL
+
+/*******************************************************************************
+ * Structures
+ *******************************************************************************/
+typedef struct
+{
+	uint32	nIntervals;						/* Cmic_BalUpdate calls */
+	uint32	nPatternChanges;				/* Node targets that changed */
+	uint32	nTransactions;					/* ModifyScript writes reported by Cmic_BalCommit */
+	uint16	nActiveCells;					/* Discharging cells of the pack targets */
+	uint16	nPendingNodes;					/* Nodes whose target is not written yet */
+	uint8	nHotNodes;						/* Nodes held off by the thermal limit */
+}Cmic_BalStats_t;
+
+/*******************************************************************************
+ * Functions
+ *******************************************************************************/
+void Cmic_BalInit(void);
+
+/* Runs the controller on the pack matrix for nodes 0..nNodeCount-1, once per
+ * measurement interval. Returns true when a node target differs from what
+ * was last written */
+bool Cmic_BalUpdate(uint8 nNodeCount);
+
+/* Target and not yet written changes of a node, bit per pack cell */
+uint32 Cmic_BalGetTarget(uint8 nNode);
+uint32 Cmic_BalGetChange(uint8 nNode);
+
+/* Records the cells written to a node with nWrites ModifyScript calls */
+void Cmic_BalCommit(uint8 nNode, uint32 nCells, uint8 nWrites);
+
+Cmic_BalStats_t const * Cmic_BalGetStats(void);
+
+#if (CMIC_BAL_SIMULATION == 1)
+void Cmic_BalSimulation(void);
+#endif
+
+#endif /* CMICBAL_H_ */
@@ -10,6 +10,22 @@
 #include "CmicM.h"
 #include "CmicMConfig.h"
 #include "adi_wil_app_interface.h"
+#include "adi_wil_hal_trace.h"
+#include "adi_wil_example_link_stats.h"
+#include "adi_wil_example_event_bus.h"
+#include "adi_wil_example_device_dir.h"
+#include "adi_wil_example_arena.h"
+#include "adi_wil_example_pec.h"
+#include "adi_wil_example_script_cache.h"
+#include "adi_wil_example_w2can.h"
+#if (CMIC_BMS_BENCHMARK == 1)
+#include "adi_wil_example_printf.h"
+#include "IfxStm.h"
+#include "IfxScuCcu.h"
+#endif
+#if (CMIC_SCRIPT_BENCHMARK == 1)
+#include "adi_wil_example_printf.h"
+#endif
 
 
 typedef struct
@@ -39,8 +55,9 @@ typedef struct
 	float					m_fBOOT_TIME;
 	CmicM_State_t			m_tSt;
 	adi_wil_configuration_t m_portConfig[2];
-	adi_wil_sensor_data_t   m_wbmsSysSensorData[BMS_DATA_PACKET_COUNT];
-	adi_wil_sensor_data_t	m_userBMSBuf[BMS_DATA_PACKET_COUNT];
+	adi_wil_sensor_data_t   *m_wbmsSysSensorData;	//Carved from CmicArenaBlock by Cmic_AllocateBuffers
+	uint16					m_nSysSensorDataCount;
+	adi_wil_sensor_data_t	*m_userBMSBuf;
 	sint16 					m_tempBuf[22];
 	adi_wil_file_type_t     m_eFileType;
 	uint64_t 				m_DeviceType;
@@ -48,7 +65,7 @@ typedef struct
 
 	adi_wil_acl_t			m_sysAcl;
 	adi_wil_network_status_t m_networkStatus;
-	adi_wil_network_data_t   m_networkDataBuffer[ADI_WIL_MAX_NODES*ADI_BMS_PACKETS_PER_NODE_PER_INTERVAL];
+	adi_wil_network_data_t   *m_networkDataBuffer;
 	adi_wil_app_cell_balance_change_t 	m_tScriptChange;
 	adi_wil_err_t			m_notifyRC;
     NODESTR 				m_NODE;
@@ -58,6 +75,11 @@ typedef struct
 	uint32					m_iDecTemp[12];
 	uint32 					m_iDecFinal[12];
 	uint8  					m_nNodeCount; //ModifyScript에서 순차적으로 스크립트 실행을 위해 저장할 현재 노드카운트값.
+	uint8					m_aWriteMask[12];	//Registers differing from what the node applied, bit per adi_script_reg_t
+	uint16					m_iActivationTime;	//iActivationTime of every ModifyScript request of the pass
+	bool					m_bActivationSet;	//m_iActivationTime was taken for the current pass
+	uint32					m_iBalCells[12];	//eMAIN_BALANCING_AUTO: controller target being written, bit per cell
+	bool					m_bBalRequest;		//eMAIN_BALANCING_AUTO: a controller target changed since the last pass
 	
 	uint8_t *					m_pOtapImage;
     uint32_t 					m_iOtapImageLen;
@@ -68,6 +90,7 @@ typedef struct
 	uint8					m_nMgrConnectCnt;
 	uint8					m_nMgrDisConnectCnt;
 	uint8					m_nNodeConnectCnt;
+	bool					m_bEventsRegistered;	//false : the event bus had no room for every Cmic handler, CmicM_Handler holds the machine
 
 	bool					m_bAclUpdateNoNeed;
 	bool					m_bAclUpdateForce;
@@ -84,10 +107,22 @@ typedef struct
     adi_bms_base_pkt_1_t* 	m_pBMS_Pkt_1;
     adi_bms_base_pkt_2_t* 	m_pBMS_Pkt_2;
 
+	Cmic_PackStats_t		m_tPackStats;						//Pack view of the last interval
+	uint32					m_aPecErrors[CMIC_MAX_NODES];		//Register groups failing PEC10 since init, CMIC_PEC_VERIFY
+	uint8					m_aPackMiss[CMIC_MAX_NODES];		//Consecutive BMS intervals without a base packet 0 of the node
+
 } CmicM_Instance_t;
 
 static CmicM_Instance_t CmicM_Inst;
 static void CmicM_ControlBootState(void);
+static void Cmic_ProcessBMSInterval(adi_wil_sensor_data_t const *pBuf, uint16 nCount);
+static void Cmic_ReadBasePkt0(uint8 eNode, adi_bms_base_pkt_0_t const *pPkt, uint16 nPecFail);
+#if (CMIC_PEC_VERIFY == 1)
+static uint16 Cmic_CheckPacketPec(uint8 eNode, uint8 const *pGroups, uint16 nPacketSize);
+#endif
+#if defined(ADI_WIL_HAL_TRACE_ENABLE)
+static uint32 CmicM_PackState(void);
+#endif
 static void CmicM_ControlSensingState(void);
 static void CmicM_ControlBalancingState(void);
 static void CmicM_ControlKeyOnState(void);
@@ -184,6 +219,14 @@ static void	Cmic_Balancing_Step1_REQ(void);
 static void	Cmic_Balancing_Step1_RES(void);
 static void	Cmic_Balancing_Step2_REQ(void);
 static void	Cmic_Balancing_Step2_RES(void);
+static void	Cmic_Balancing_WriteNode(void);
+static void	Cmic_Balancing_NextNode(void);
+static void	Cmic_BuildNodePayload(uint8 nodeCnt);
+static adi_script_reg_t	Cmic_WriteNodeFirst(void);
+static void	Cmic_CommitNodeRegister(adi_script_reg_t eReg);
+static adi_wil_err_t	Cmic_ModifyScript(adi_wil_device_t eDevice, adi_wil_script_change_t const *pChange);
+static boolean	Cmic_IsModifyScriptReleased(void);
+static uint16	Cmic_GetActivationTime(void);
 
 static void	Cmic_KeyOn_Step1_REQ(void);
 static void	Cmic_KeyOn_Step1_RES(void);
@@ -371,6 +414,50 @@ static uint8_t  iOWDPcktsRcvd[ADI_WIL_MAX_NODES];// Status flag to indicate if a
 
 boolean  powerOn=TRUE;
 
+/* Arena block for the WIL data buffers and the BMS copy, dimensioned for
+ * ADI_WIL_EX_ARENA_NODES and carved for the nodes of userAcl */
+#define CMIC_ARENA_BYTES	(ADI_ARENA_REGION_SIZE(ADI_BMS_PACKETS_PER_NODE_PER_INTERVAL * sizeof(adi_wil_sensor_data_t), \
+												   (PMS_DATA_PACKET_COUNT + EMS_DATA_PACKET_COUNT) * sizeof(adi_wil_sensor_data_t), \
+												   ADI_WIL_EX_ARENA_NODES) + \
+							 ADI_ARENA_REGION_SIZE(ADI_BMS_PACKETS_PER_NODE_PER_INTERVAL * sizeof(adi_wil_sensor_data_t), 0u, \
+												   ADI_WIL_EX_ARENA_NODES) + \
+							 ADI_ARENA_REGION_SIZE(ADI_BMS_PACKETS_PER_NODE_PER_INTERVAL * sizeof(adi_wil_network_data_t), 0u, \
+												   ADI_WIL_EX_ARENA_NODES))
+static uint64_t CmicArenaBlock[(CMIC_ARENA_BYTES + 7u) / 8u];
+
+static void Cmic_AllocateBuffers(void)
+{
+	uint8 nNodeCount = (userAcl.iCount != 0u) ? userAcl.iCount : (uint8)ADI_WIL_EX_ARENA_NODES;
+
+	adi_wil_example_ArenaInit(CmicArenaBlock, sizeof(CmicArenaBlock), nNodeCount);
+
+	CmicM_Inst.m_nSysSensorDataCount = (uint16)((nNodeCount * ADI_BMS_PACKETS_PER_NODE_PER_INTERVAL) + PMS_DATA_PACKET_COUNT + EMS_DATA_PACKET_COUNT);
+	CmicM_Inst.m_wbmsSysSensorData = adi_wil_example_ArenaAlloc("WIL sensor data",
+	                                                            ADI_BMS_PACKETS_PER_NODE_PER_INTERVAL * sizeof(adi_wil_sensor_data_t),
+	                                                            (PMS_DATA_PACKET_COUNT + EMS_DATA_PACKET_COUNT) * sizeof(adi_wil_sensor_data_t));
+	CmicM_Inst.m_userBMSBuf = adi_wil_example_ArenaAlloc("BMS data copy",
+	                                                     ADI_BMS_PACKETS_PER_NODE_PER_INTERVAL * sizeof(adi_wil_sensor_data_t), 0u);
+	CmicM_Inst.m_networkDataBuffer = adi_wil_example_ArenaAlloc("WIL network data",
+	                                                            ADI_BMS_PACKETS_PER_NODE_PER_INTERVAL * sizeof(adi_wil_network_data_t), 0u);
+
+	if ((CmicM_Inst.m_wbmsSysSensorData == NULL) || (CmicM_Inst.m_userBMSBuf == NULL) || (CmicM_Inst.m_networkDataBuffer == NULL)) {
+		/* userAcl holds more nodes than ADI_WIL_EX_ARENA_NODES */
+		while(1);
+	}
+
+	adi_wil_example_ArenaDumpFootprint();
+}
+
+static uint16 Cmic_NetworkDataCount(void)
+{
+	uint8 nNodes = CmicM_Inst.m_networkStatus.iCount;
+
+	if (nNodes > adi_wil_example_ArenaNodeCount()) {
+		nNodes = adi_wil_example_ArenaNodeCount();
+	}
+	return (uint16)(nNodes * ADI_BMS_PACKETS_PER_NODE_PER_INTERVAL);
+}
+
 void CmicM_Init(void)
 {
 	if (powerOn == FALSE ){
@@ -378,7 +465,24 @@ void CmicM_Init(void)
 		return;
 	}
 
+#if (CMIC_BMS_BENCHMARK == 1)
+	Cmic_BenchmarkReadBMS();
+#endif
+
 	memset(&CmicM_Inst, 0, sizeof(CmicM_Instance_t));
+	Cmic_AllocateBuffers();
+#if (CMIC_PACK_BENCHMARK == 1)
+	Cmic_PackBenchmark();
+#endif
+#if (CMIC_SCRIPT_BENCHMARK == 1)
+	Cmic_ScriptBenchmark();
+#endif
+#if (CMIC_BAL_SIMULATION == 1)
+	Cmic_BalSimulation();
+#endif
+	Cmic_PackInit();
+	Cmic_BalInit();
+	adi_wil_example_ScriptCacheReset();
 
 	CmicM_Inst.m_nBOOT = 1;
 	
@@ -393,6 +497,9 @@ void CmicM_Init(void)
 
 	CmicM_Inst.m_eFileType = ADI_WIL_FILE_TYPE_CONFIGURATION;
 	CmicM_Inst.m_DeviceType = ADI_WIL_DEV_ALL_NODES;
+#ifndef _ADI_ONLY
+	CmicM_Inst.m_bEventsRegistered = Cmic_RegisterEventHandlers();
+#endif
 
    adk_debug_BootTimeLog(Overall_, LogStart, 999, Demo_Total_boot_time__________________);
  
@@ -402,6 +509,10 @@ void CmicM_IG_Init(void)
 {
 
 	memset(&CmicM_Inst, 0, sizeof(CmicM_Instance_t));
+	Cmic_AllocateBuffers();
+	Cmic_PackInit();
+	Cmic_BalInit();
+	adi_wil_example_ScriptCacheReset();
 
 	CmicM_Inst.m_nBOOT = 700;
 	
@@ -411,6 +522,9 @@ void CmicM_IG_Init(void)
 
 	CmicM_Inst.m_tSt.m_eMain = eMAIN_KEY_ON_EVENT;
 	CmicM_Inst.m_tSt.m_eKeyOn = eKEY_ON_st1_REQ;
+#ifndef _ADI_ONLY
+	CmicM_Inst.m_bEventsRegistered = Cmic_RegisterEventHandlers();
+#endif
 	
     adk_debug_BootTimeLog(Overall_, LogStart, 730, Demo_key_on_event_____________________);
      
@@ -419,6 +533,9 @@ void CmicM_IG_Init(void)
 void CmicM_Handler(void)
 {
 	uint32  aTick;
+#if defined(ADI_WIL_HAL_TRACE_ENABLE)
+	uint32  nPrevState;
+#endif
     
 	aTick =	GetTick_1ms();
 
@@ -426,6 +543,20 @@ void CmicM_Handler(void)
 
 	    CmicM_Inst.m_nTick1ms = aTick;
 
+#ifndef _ADI_ONLY
+		/* Without its handlers the machine never sees a connect or BMS event,
+		 * hold it in its current step and retry the registration */
+		if (CmicM_Inst.m_bEventsRegistered == FALSE) {
+			if ((aTick % CMIC_EVENT_RETRY_MS) == 0u) {
+				CmicM_Inst.m_bEventsRegistered = Cmic_RegisterEventHandlers();
+			}
+			return;
+		}
+#endif
+#if defined(ADI_WIL_HAL_TRACE_ENABLE)
+		nPrevState = CmicM_PackState();
+#endif
+
 		switch(CmicM_Inst.m_tSt.m_eMain)
 		{
 			case eMAIN_BOOT :
@@ -436,6 +567,7 @@ void CmicM_Handler(void)
 				break;
 			case eMAIN_BALANCING_EVEN :						
 			case eMAIN_BALANCING_ODD :
+			case eMAIN_BALANCING_AUTO :
 				CmicM_ControlBalancingState();
 				break;
 			case eMAIN_KEY_ON_EVENT :
@@ -448,9 +580,49 @@ void CmicM_Handler(void)
 				break;
 		}
 		
-		
+#if defined(ADI_WIL_HAL_TRACE_ENABLE)
+		if (CmicM_PackState() != nPrevState) {
+			ADI_WIL_HAL_TRACE(ADI_WIL_HAL_TRACE_EVT_CMIC_STEP, CmicM_PackState(), nPrevState);
+		}
+#endif
+	}
+}
+
+#if defined(ADI_WIL_HAL_TRACE_ENABLE)
+/********************************************************************************
+	FUNCTION :  CmicM_PackState
+    	DESCRIPTION : Main(8) | Boot(8) | Sub step of the active machine(8) | Balancing(4) | Sensing(4),
+    	              used as the trace argument for step transitions
+**********************************************************************************/
+static uint32 CmicM_PackState(void)
+{
+	uint32 nSub;
+
+	switch(CmicM_Inst.m_tSt.m_eMain)
+	{
+		case eMAIN_BOOT :
+			switch(CmicM_Inst.m_tSt.m_eBoot)
+			{
+				case eBOOT_INIT :		nSub = (uint32)CmicM_Inst.m_tSt.m_eSubInit;		break;
+				case eBOOT_CONNECT :	nSub = (uint32)CmicM_Inst.m_tSt.m_eSubConnect;	break;
+				case eBOOT_JOIN :		nSub = (uint32)CmicM_Inst.m_tSt.m_eSubJoin;		break;
+				case eBOOT_LOAD :		nSub = (uint32)CmicM_Inst.m_tSt.m_eSubLoad;		break;
+				case eBOOT_ACTIVE :		nSub = (uint32)CmicM_Inst.m_tSt.m_eSubActive;	break;
+				default :				nSub = 0xFFu;									break;
+			}
+			break;
+		case eMAIN_KEY_ON_EVENT :	nSub = (uint32)CmicM_Inst.m_tSt.m_eKeyOn;	break;
+		case eMAIN_KEY_OFF_EVENT :	nSub = (uint32)CmicM_Inst.m_tSt.m_eKeyOff;	break;
+		default :					nSub = 0xFFu;								break;
 	}
+
+	return ((((uint32)CmicM_Inst.m_tSt.m_eMain & 0xFFu) << 24) |
+			(((uint32)CmicM_Inst.m_tSt.m_eBoot & 0xFFu) << 16) |
+			((nSub & 0xFFu) << 8) |
+			(((uint32)CmicM_Inst.m_tSt.m_eBalancing & 0x0Fu) << 4) |
+			((uint32)CmicM_Inst.m_tSt.m_eSensing & 0x0Fu));
 }
+#endif
 
 static void CmicM_ControlSensingState(void)
 {
@@ -633,7 +805,7 @@ static void Cmic_Connect_Step1_REQ(void)
 
 
 	 Cmic_RequestConnect(&packInstance,	  CmicM_Inst.m_wbmsSysSensorData,
-										  (BMS_DATA_PACKET_COUNT));
+										  CmicM_Inst.m_nSysSensorDataCount);
 
 	 CmicM_Inst.m_nBOOT = 120;
 	 
@@ -922,7 +1094,7 @@ static void Cmic_Connect_Step6_REQ(void)
 
 	
     Cmic_RequestConnect(&packInstance,  CmicM_Inst.m_wbmsSysSensorData,
-                                       (BMS_DATA_PACKET_COUNT));
+                                       CmicM_Inst.m_nSysSensorDataCount);
     CmicM_Inst.m_nBOOT = 130;
 
     CmicM_Inst.m_tSt.m_eSubConnect = eCONNECT_st6_RES;
@@ -1525,7 +1697,7 @@ static void Cmic_Load_Step5_REQ(void)
 	/* STEP 27 : Connect *************************************************************/
 	adk_debug_BootTimeLog(Interval, LogStart, 261, Demo_ExecuteConnect_2_________________);
 
-	Cmic_RequestConnect(&packInstance, CmicM_Inst.m_wbmsSysSensorData, (BMS_DATA_PACKET_COUNT + PMS_DATA_PACKET_COUNT + EMS_DATA_PACKET_COUNT));
+	Cmic_RequestConnect(&packInstance, CmicM_Inst.m_wbmsSysSensorData, CmicM_Inst.m_nSysSensorDataCount);
 	
 	CmicM_Inst.m_nBOOT = 261;
 	CmicM_Inst.m_tSt.m_eSubLoad = eLOAD_st5_RES;
@@ -1992,10 +2164,12 @@ static void Cmic_Active_Step9_REQ(void)
 	/* STEP 37 : Enable Network Data Capture *********************************************/
 	  adk_debug_BootTimeLog(Interval, LogStart, 420, Demo_EnableNetworkDataCapture_________);
 
-	  nNWBufferSize = CmicM_Inst.m_networkStatus.iCount * ADI_BMS_PACKETS_PER_NODE_PER_INTERVAL;
+	  /* The capture buffer holds the nodes the arena was carved for */
+	  nNWBufferSize = Cmic_NetworkDataCount();
 	  
+	  adi_wil_example_LinkStatsReset();
 	  adi_wil_EnableNetworkDataCapture(&packInstance, CmicM_Inst.m_networkDataBuffer,
-	  	                                (CmicM_Inst.m_networkStatus.iCount * ADI_BMS_PACKETS_PER_NODE_PER_INTERVAL), true);
+	  	                                nNWBufferSize, true);
 
 	  CmicM_Inst.m_nBOOT = 420;
 	  
@@ -2067,16 +2241,16 @@ static void Cmic_Sensing_Step1_REQ(void)
 	Cmic_PresetModifyData(); //DCC default roll back
 
 	CmicM_Inst.m_nNodeCount = 0;
+	CmicM_Inst.m_bActivationSet = false;
 
 	if ( !Cmic_CheckNode()){
 		CmicM_Inst.m_tSt.m_eSensing = eSENSING_st0_IDLE;
 		CmicM_Inst.m_tSt.m_ePrevMain = CmicM_Inst.m_tSt.m_eMain;
 		return;
 	}else {
-		Cmic_RequestModifyScript_CFG_A();
+		CmicM_Inst.m_tSt.m_eSensing = (Cmic_WriteNodeFirst() == ADI_SCRIPT_REG_CFGA) ? eSENSING_st1_RES : eSENSING_st2_RES;
 	}
    	
-	CmicM_Inst.m_tSt.m_eSensing = eSENSING_st1_RES;
 	CmicM_Inst.m_nTaskCnt=0;
 	
 }
@@ -2084,13 +2258,18 @@ static void Cmic_Sensing_Step1_REQ(void)
 
 static void Cmic_Sensing_Step1_RES(void)
 {
-	if (IsReleaseWilAPI(&packInstance)){
+	if (Cmic_IsModifyScriptReleased()){
 
 		if (CmicM_Inst.m_notifyRC != ADI_WIL_ERR_SUCCESS) {
               CmicM_Inst.m_tScriptChange.bFailureFlag[CmicM_Inst.m_nNodeCount] = true;
 		}        
-				
-		CmicM_Inst.m_tSt.m_eSensing = eSENSING_st2_REQ;
+		Cmic_CommitNodeRegister(ADI_SCRIPT_REG_CFGA);
+
+		if ((CmicM_Inst.m_aWriteMask[CmicM_Inst.m_nNodeCount] & ADI_SCRIPT_CACHE_REG_MASK(ADI_SCRIPT_REG_CFGB)) == 0u){
+			CmicM_Inst.m_tSt.m_eSensing = eSENSING_st2_RES; //CFGB already applied
+		}else {
+			CmicM_Inst.m_tSt.m_eSensing = eSENSING_st2_REQ;
+		}
 		CmicM_ControlSensingState();
 			
 	}else {
@@ -2109,11 +2288,12 @@ static void Cmic_Sensing_Step2_REQ(void)
 
 static void Cmic_Sensing_Step2_RES(void)
 {
-	if (IsReleaseWilAPI(&packInstance)){
+	if (Cmic_IsModifyScriptReleased()){
 
 		if (CmicM_Inst.m_notifyRC != ADI_WIL_ERR_SUCCESS) {
              CmicM_Inst.m_tScriptChange.bFailureFlag[CmicM_Inst.m_nNodeCount] = true;
 		}  
+		Cmic_CommitNodeRegister(ADI_SCRIPT_REG_CFGB);
 		CmicM_Inst.m_NODE[CmicM_Inst.m_nNodeCount++].CB_STAT = 0;  //CB_STAT=0 & Next Node Set!
 		
 		if ( !Cmic_CheckNode()){ //실행할 다음노드가 없음.
@@ -2122,8 +2302,8 @@ static void Cmic_Sensing_Step2_RES(void)
 			return;
 
 		}else {
-			Cmic_RequestModifyScript_CFG_A();
-			CmicM_Inst.m_tSt.m_eSensing = eSENSING_st1_RES;
+			CmicM_Inst.m_tSt.m_eSensing = (Cmic_WriteNodeFirst() == ADI_SCRIPT_REG_CFGA) ? eSENSING_st1_RES : eSENSING_st2_RES;
+			CmicM_Inst.m_nTaskCnt=0;
 		}
 
 			
@@ -2139,6 +2319,14 @@ static void Cmic_Sensing_Step2_RES(void)
 static void Cmic_Balancing_Step0_IDLE(void)
 {
 	if ( CmicM_Inst.m_tSt.m_eMain != CmicM_Inst.m_tSt.m_ePrevMain ){
+		if (eMAIN_BALANCING_AUTO == CmicM_Inst.m_tSt.m_eMain){
+			Cmic_BalInit(); //Sensing left every DCC off
+		}
+		CmicM_Inst.m_tSt.m_eBalancing = eBALANCING_st1_REQ;
+		CmicM_ControlBalancingState();
+	}
+	else if ((eMAIN_BALANCING_AUTO == CmicM_Inst.m_tSt.m_eMain) && CmicM_Inst.m_bBalRequest){
+		CmicM_Inst.m_bBalRequest = false;
 		CmicM_Inst.m_tSt.m_eBalancing = eBALANCING_st1_REQ;
 		CmicM_ControlBalancingState();
 	}
@@ -2150,28 +2338,31 @@ static void Cmic_Balancing_Step1_REQ(void)
 	Cmic_PresetModifyData();
 
 	CmicM_Inst.m_nNodeCount = 0;
+	CmicM_Inst.m_bActivationSet = false;
 
 	if ( !Cmic_CheckNode()){
 		CmicM_Inst.m_tSt.m_eBalancing = eBALANCING_st0_IDLE;
 		CmicM_Inst.m_tSt.m_ePrevMain = CmicM_Inst.m_tSt.m_eMain;
 		return;
 	}else {
-		Cmic_RequestModifyScript_CFG_A();
+		Cmic_Balancing_WriteNode();
 	}
-   	
-	CmicM_Inst.m_tSt.m_eBalancing = eBALANCING_st1_RES;
-	CmicM_Inst.m_nTaskCnt=0;
 }
 
 static void Cmic_Balancing_Step1_RES(void)
 {
-	if (IsReleaseWilAPI(&packInstance)){
+	if (Cmic_IsModifyScriptReleased()){
 
 		if (CmicM_Inst.m_notifyRC != ADI_WIL_ERR_SUCCESS) {
               CmicM_Inst.m_tScriptChange.bFailureFlag[CmicM_Inst.m_nNodeCount] = true;
 		}        
-				
-		CmicM_Inst.m_tSt.m_eBalancing = eBALANCING_st2_REQ;
+		Cmic_CommitNodeRegister(ADI_SCRIPT_REG_CFGA);
+
+		if ((CmicM_Inst.m_aWriteMask[CmicM_Inst.m_nNodeCount] & ADI_SCRIPT_CACHE_REG_MASK(ADI_SCRIPT_REG_CFGB)) == 0u){
+			CmicM_Inst.m_tSt.m_eBalancing = eBALANCING_st2_RES; //CFGB already applied
+		}else {
+			CmicM_Inst.m_tSt.m_eBalancing = eBALANCING_st2_REQ;
+		}
 		CmicM_ControlBalancingState();
 			
 	}else {
@@ -2191,23 +2382,13 @@ static void Cmic_Balancing_Step2_REQ(void)
 
 static void Cmic_Balancing_Step2_RES(void)
 {
-	if (IsReleaseWilAPI(&packInstance)){
+	if (Cmic_IsModifyScriptReleased()){
 
 		if (CmicM_Inst.m_notifyRC != ADI_WIL_ERR_SUCCESS) {
              CmicM_Inst.m_tScriptChange.bFailureFlag[CmicM_Inst.m_nNodeCount] = true;
 		}        
-		 ++CmicM_Inst.m_nNodeCount;  //Next Node Set!
-		
-		if ( !Cmic_CheckNode()){ //실행할 다음노드가 없음.
-			CmicM_Inst.m_tSt.m_eBalancing = eBALANCING_st0_IDLE;
-			CmicM_Inst.m_tSt.m_ePrevMain = CmicM_Inst.m_tSt.m_eMain;
-			return;
-
-		}else {
-			Cmic_RequestModifyScript_CFG_A();
-			CmicM_Inst.m_tSt.m_eBalancing = eBALANCING_st1_RES;
-		}
-
+		Cmic_CommitNodeRegister(ADI_SCRIPT_REG_CFGB);
+		Cmic_Balancing_NextNode();
 			
 	}else {
 		if( ++CmicM_Inst.m_nTaskCnt > 1000) {
@@ -2217,6 +2398,35 @@ static void Cmic_Balancing_Step2_RES(void)
 
 }
 
+static void Cmic_Balancing_WriteNode(void)
+{
+	CmicM_Inst.m_tSt.m_eBalancing = (Cmic_WriteNodeFirst() == ADI_SCRIPT_REG_CFGA) ? eBALANCING_st1_RES : eBALANCING_st2_RES;
+	CmicM_Inst.m_nTaskCnt=0;
+}
+
+static void Cmic_Balancing_NextNode(void)
+{
+	uint8  nodeCnt = CmicM_Inst.m_nNodeCount;
+	uint8  nMask = CmicM_Inst.m_aWriteMask[nodeCnt];
+
+	/* A failed node stays pending and is written again on the next pass */
+	if ((eMAIN_BALANCING_AUTO == CmicM_Inst.m_tSt.m_eMain) && !CmicM_Inst.m_tScriptChange.bFailureFlag[nodeCnt]){
+		Cmic_BalCommit(nodeCnt, CmicM_Inst.m_iBalCells[nodeCnt],
+					   (uint8)((((nMask & ADI_SCRIPT_CACHE_REG_MASK(ADI_SCRIPT_REG_CFGA)) != 0u) ? 1u : 0u) +
+							   (((nMask & ADI_SCRIPT_CACHE_REG_MASK(ADI_SCRIPT_REG_CFGB)) != 0u) ? 1u : 0u)));
+	}
+
+	++CmicM_Inst.m_nNodeCount;  //Next Node Set!
+
+	if ( !Cmic_CheckNode()){ //실행할 다음노드가 없음.
+		CmicM_Inst.m_tSt.m_eBalancing = eBALANCING_st0_IDLE;
+		CmicM_Inst.m_tSt.m_ePrevMain = CmicM_Inst.m_tSt.m_eMain;
+		return;
+	}
+
+	Cmic_Balancing_WriteNode();
+}
+
 static void Cmic_KeyOn_Step1_REQ(void)
 {
     adk_debug_BootTimeLog(Interval, LogStart, 703, Demo_TaskStart________________________);
@@ -2239,7 +2449,7 @@ static void Cmic_KeyOn_Step2_REQ(void)
 	adk_debug_BootTimeLog(Interval, LogStart, 710, Demo_ExcuteConnect____________________);
    	
     Cmic_RequestConnect(&packInstance,  CmicM_Inst.m_wbmsSysSensorData,
-                                       (BMS_DATA_PACKET_COUNT));
+                                       CmicM_Inst.m_nSysSensorDataCount);
 	CmicM_Inst.m_nBOOT = 710;
 	CmicM_Inst.m_tSt.m_eKeyOn = eKEY_ON_st2_RES;		
 	CmicM_Inst.m_nTaskCnt=0;						   
@@ -2326,8 +2536,9 @@ static void Cmic_KeyOn_Step5_RES(void)
 static void Cmic_KeyOn_Step6_REQ(void)
 {
       
+	adi_wil_example_LinkStatsReset();
 	adi_wil_EnableNetworkDataCapture(&packInstance, CmicM_Inst.m_networkDataBuffer,
-	  	                 (CmicM_Inst.m_networkStatus.iCount * ADI_BMS_PACKETS_PER_NODE_PER_INTERVAL), true);
+	  	                 Cmic_NetworkDataCount(), true);
 
 	/* STEP 38 : Init CB_CELL for demo ***************************************************/
 	  for(uint8 i=0; i<12; i++){	 /* ADBMS6833 */
@@ -2546,6 +2757,7 @@ void adi_wil_HandleCallback (adi_wil_pack_t const * const pPack,
 			case ADI_WIL_API_GET_ACL :
         
     	   	    (void)memcpy(&CmicM_Inst.m_sysAcl, pData, sizeof(adi_wil_acl_t));
+			adi_wil_example_DeviceDirUpdate(&CmicM_Inst.m_sysAcl);
         		break;
 
 			default : break;
@@ -2558,47 +2770,107 @@ void adi_wil_HandleCallback (adi_wil_pack_t const * const pPack,
 
 
  
+static void Cmic_EventMgrConnected(adi_wil_pack_t const *pPack, adi_wil_event_id_t eEvent, void const *pData)
+{
+	CmicM_Inst.m_nMgrConnectCnt++;
+}
+
+static void Cmic_EventMgrDisconnected(adi_wil_pack_t const *pPack, adi_wil_event_id_t eEvent, void const *pData)
+{
+	CmicM_Inst.m_nMgrDisConnectCnt++;
+}
+
+/* A node coming back starts without the codes it left with, its first
+ * interval is not rate checked against them. It may also have reset while
+ * away, so its script registers are written again */
+static void Cmic_EventNodeConnected(adi_wil_pack_t const *pPack, adi_wil_event_id_t eEvent, void const *pData)
+{
+	uint8 eNode = Cmic_ConvertDeviceId(*(adi_wil_device_t const *)pData);
+
+	CmicM_Inst.m_nNodeConnectCnt++;
+	Cmic_PackClearNode(eNode);
+	adi_wil_example_ScriptCacheInvalidate(eNode);
+}
+
+static void Cmic_EventNodeDisconnected(adi_wil_pack_t const *pPack, adi_wil_event_id_t eEvent, void const *pData)
+{
+	uint8 eNode = Cmic_ConvertDeviceId(*(adi_wil_device_t const *)pData);
+
+	Cmic_PackClearNode(eNode);
+	adi_wil_example_ScriptCacheInvalidate(eNode);
+}
+
+static void Cmic_EventBms(adi_wil_pack_t const *pPack, adi_wil_event_id_t eEvent, void const *pData)
+{
+	memcpy(CmicM_Inst.m_userBMSBuf, ((adi_wil_sensor_data_buffer_t *)pData)->pData, 
+	 (((adi_wil_sensor_data_buffer_t *)pData)->iCount)*(sizeof(adi_wil_sensor_data_t)));
+
+	/* Set before the reads below, which walk m_nTotalPacketRcvd packets */
+	CmicM_Inst.m_nTotalPacketRcvd = ((adi_wil_sensor_data_buffer_t *)pData)->iCount;  /*  @remark Akash : Variable to store total no. of bms packets received */
+
+	if (CmicM_Inst.m_tSt.m_eMain == eMAIN_KEY_ON_EVENT){ 
+		Cmic_ReadInitPacket();
+	}else{
+		Cmic_ReadBMS();	
+	}
+
+	if (CmicM_Inst.m_tSt.m_eMain == eMAIN_KEY_OFF_EVENT){ 
+		Cmic_SaveLatencyPkt();
+	}
+}
+
+#if (ADI_W2CAN_ENABLE == 1) && (ADI_W2CAN_PMS_FORWARD == 1)
+static void Cmic_EventPms(adi_wil_pack_t const *pPack, adi_wil_event_id_t eEvent, void const *pData)
+{
+	adi_w2can_NotifyPmsData(((adi_wil_sensor_data_buffer_t *)pData)->pData,
+	                        (uint16)((adi_wil_sensor_data_buffer_t *)pData)->iCount);
+}
+#endif
+
+static void Cmic_EventNetworkData(adi_wil_pack_t const *pPack, adi_wil_event_id_t eEvent, void const *pData)
+{
+	/* Link statistics are folded in record by record, the capture buffer is not kept */
+	adi_wil_example_LinkStatsUpdateBuffer(((adi_wil_network_data_buffer_t *)pData)->pData,
+	                                      ((adi_wil_network_data_buffer_t *)pData)->iCount);
+}
+
+static bool Cmic_RegisterHandler(adi_wil_event_id_t eEvent, adi_event_handler_t pfHandler, const char *pName)
+{
+	if (adi_wil_example_EventBusRegister(eEvent, pfHandler, pName, 0u, ADI_EVENT_EXEC_INLINE, 0u) == ADI_EVENT_BUS_INVALID_HANDLE)
+	{
+		adi_wil_ex_error("Event bus : handler %s for event %u not registered", pName, (unsigned int)eEvent);
+		return false;
+	}
+	return true;
+}
+
+/* All handlers run inline: the BMS buffer is copied and decoded before the WIL
+ * reuses it for the next interval. false when any handler found the table full */
+bool Cmic_RegisterEventHandlers(void)
+{
+	bool bRegistered = true;
+
+	adi_wil_example_EventBusReset();
+
+	bRegistered &= Cmic_RegisterHandler(ADI_WIL_EVENT_COMM_MGR_CONNECTED, Cmic_EventMgrConnected, "MgrConnected");
+	bRegistered &= Cmic_RegisterHandler(ADI_WIL_EVENT_COMM_MGR_DISCONNECTED, Cmic_EventMgrDisconnected, "MgrDisconnected");
+	bRegistered &= Cmic_RegisterHandler(ADI_WIL_EVENT_COMM_NODE_CONNECTED, Cmic_EventNodeConnected, "NodeConnected");
+	bRegistered &= Cmic_RegisterHandler(ADI_WIL_EVENT_COMM_NODE_DISCONNECTED, Cmic_EventNodeDisconnected, "NodeDisconnected");
+	bRegistered &= Cmic_RegisterHandler(ADI_WIL_EVENT_DATA_READY_BMS, Cmic_EventBms, "Bms");
+	bRegistered &= Cmic_RegisterHandler(ADI_WIL_EVENT_DATA_READY_NETWORK_DATA, Cmic_EventNetworkData, "NetworkData");
+#if (ADI_W2CAN_ENABLE == 1) && (ADI_W2CAN_PMS_FORWARD == 1)
+	bRegistered &= Cmic_RegisterHandler(ADI_WIL_EVENT_DATA_READY_PMS, Cmic_EventPms, "Pms");
+#endif
+
+	return bRegistered;
+}
+
 void adi_wil_HandleEvent (adi_wil_pack_t const * const pPack,
                           void const * const pClientData,
                           adi_wil_event_id_t EventCode,
                           void const * const pData)
 {
-  
-	  switch (EventCode)
-	  {
-		  case ADI_WIL_EVENT_COMM_MGR_CONNECTED:
-			  CmicM_Inst.m_nMgrConnectCnt++;
-			  break;
-	
-		  case ADI_WIL_EVENT_COMM_MGR_DISCONNECTED:
-			  CmicM_Inst.m_nMgrDisConnectCnt++;
-			  break;
-  	     case ADI_WIL_EVENT_COMM_NODE_CONNECTED:
-			  CmicM_Inst.m_nNodeConnectCnt++;
-			  break;
-		
-		 case ADI_WIL_EVENT_DATA_READY_BMS:	
-		 	
-			 memcpy(CmicM_Inst.m_userBMSBuf, ((adi_wil_sensor_data_buffer_t *)pData)->pData, 
-			  (((adi_wil_sensor_data_buffer_t *)pData)->iCount)*(sizeof(adi_wil_sensor_data_t)));
-
-			if (CmicM_Inst.m_tSt.m_eMain == eMAIN_KEY_ON_EVENT){ 
-				Cmic_ReadInitPacket();
-			}else{
-				Cmic_ReadBMS();	
-			}
-			CmicM_Inst.m_nTotalPacketRcvd = ((adi_wil_sensor_data_buffer_t *)pData)->iCount;  /*  @remark Akash : Variable to store total no. of bms packets received */
-  
-		
-			if (CmicM_Inst.m_tSt.m_eMain == eMAIN_KEY_OFF_EVENT){ 
-			
-				Cmic_SaveLatencyPkt();
-			}
-			 break;
-			 
-		  default:
-		  	break;
-	 }
+	adi_wil_example_EventBusDispatch(pPack, EventCode, pData);
 }
 #endif
 
@@ -2700,31 +2972,7 @@ bool Cmic_CompareACL(void){
 
 uint8 Cmic_ConvertDeviceId (adi_wil_device_t WilDeviceId)
 {
-    uint8_t DeviceId = 0;
-    
-    if(WilDeviceId != 0)
-    {
-        if 		(WilDeviceId == ADI_WIL_DEV_MANAGER_0) return 240;
-        else if (WilDeviceId == ADI_WIL_DEV_MANAGER_1) return 241;
-        else if (WilDeviceId == ADI_WIL_DEV_ALL_MANAGERS) return 254;
-        else if (WilDeviceId == ADI_WIL_DEV_ALL_NODES) return 255;
-    
-        while ((WilDeviceId & (ADI_WIL_DEV_NODE_0 << DeviceId)) == 0)
-        {
-            if(DeviceId < 255) {
-                DeviceId++;
-            }
-            else {
-                DeviceId = 200;
-                break;
-            }
-        }
-    }
-    else {
-        DeviceId = 200;
-    }
-	
-    return DeviceId;
+	return adi_wil_example_DeviceDirNodeIndex(WilDeviceId);
 }
 
 
@@ -2804,106 +3052,318 @@ void Cmic_ReadInitPacket(void)
 
 void Cmic_ReadBMS(void)
 {
-    uint8_t cnt, packetId, eNode, i;
-	sint16 	tempBuf[22]={0,}; 
+	uint8_t cnt;
+
+	Cmic_ProcessBMSInterval(CmicM_Inst.m_userBMSBuf, CmicM_Inst.m_nTotalPacketRcvd);
+
+	for(cnt = 0; cnt < realAcl.iCount; cnt++)
+    {
+        // Adele
+        uint8_t* bms_pkt_map = CmicM_Inst.m_NODE[cnt].BMS_PKT_MAP;
+        //if(iBMSNotificationCount < 5)
+        //    bms_pkt_map[1] = 0xFF;
+        //bms_pkt_map[0] = tempBuf[cnt];
+        if (adi_cnt1_8bit(bms_pkt_map[0]) < adi_cnt1_8bit(bms_pkt_map[1]))
+            bms_pkt_map[1] = bms_pkt_map[0];
+    }
 	
-  
-    for(cnt = 0; cnt < CmicM_Inst.m_nTotalPacketRcvd; cnt++){
-		
-        if (CmicM_Inst.m_userBMSBuf[cnt].iLength == 0) continue; // Adele: skip processing of empty packet
+}
 
-        eNode = Cmic_ConvertDeviceId(CmicM_Inst.m_userBMSBuf[cnt].eDeviceId);
+Cmic_PackStats_t const * Cmic_GetPackStats(void)
+{
+	return &CmicM_Inst.m_tPackStats;
+}
+
+/* One sweep over the interval: every packet is decoded once and the cell
+ * plausibility, the pack statistics and the open wire inputs are taken from
+ * the decoded codes while they are at hand */
+static void Cmic_ProcessBMSInterval(adi_wil_sensor_data_t const *pBuf, uint16 nCount)
+{
+	Cmic_PackStats_t *pStats = &CmicM_Inst.m_tPackStats;
+	Cmic_PackAgg_t const *pCells = Cmic_PackGetCellAgg();
+	adi_bms_base_pkt_1_t const *pPkt1;
+	adi_bms_base_pkt_2_t const *pPkt2;
+	uint64 nOwdReady = 0U;			//Nodes with all open wire packets, bit per node
+	uint64 nReported = 0U;			//Nodes with a base packet 0, bit per node
+	uint16 nPecFail = 0U;			//Failing register groups of the packet, bit per group
+	uint16 cnt;
+	uint8 packetId, eNode;
+
+	memset(pStats, 0, sizeof(Cmic_PackStats_t));
+
+	for(cnt = 0; cnt < nCount; cnt++){
+
+        if (pBuf[cnt].iLength == 0) continue; // Adele: skip processing of empty packet
+
+        eNode = Cmic_ConvertDeviceId(pBuf[cnt].eDeviceId);
+		/* The decode and the pack matrix take every node of the pack, the
+		 * m_NODE view only the first ADK_MAX_node */
+		if (eNode >= CMIC_MAX_NODES) continue;
+
+		packetId = pBuf[cnt].Data[0];
 
-		packetId = CmicM_Inst.m_userBMSBuf[cnt].Data[0];
-                
         if( packetId == ADI_BMS_BASE_PKT_0_ID )
 		{
 			CmicM_Inst.m_nBMSNotifyCnt++; // for debug..
-        
-			CmicM_Inst.m_pBMS_Pkt_0 = (adi_bms_base_pkt_0_t*) &CmicM_Inst.m_userBMSBuf[cnt].iLength;
-            
-            /* @remark : Read raw data (float) */
-            tempBuf[0]  = (signed short int)((CmicM_Inst.m_pBMS_Pkt_0->Rdaca.iAc2v[1]   << 8) + CmicM_Inst.m_pBMS_Pkt_0->Rdaca.iAc2v[0]);
-            tempBuf[1]  = (signed short int)((CmicM_Inst.m_pBMS_Pkt_0->Rdaca.iAc3v[1]   << 8) + CmicM_Inst.m_pBMS_Pkt_0->Rdaca.iAc3v[0]);
-            tempBuf[2]  = (signed short int)((CmicM_Inst.m_pBMS_Pkt_0->Rdacb.iAc4v[1]   << 8) + CmicM_Inst.m_pBMS_Pkt_0->Rdacb.iAc4v[0]);
-            tempBuf[3]  = (signed short int)((CmicM_Inst.m_pBMS_Pkt_0->Rdacb.iAc5v[1]   << 8) + CmicM_Inst.m_pBMS_Pkt_0->Rdacb.iAc5v[0]);
-            tempBuf[4]  = (signed short int)((CmicM_Inst.m_pBMS_Pkt_0->Rdacb.iAc6v[1]   << 8) + CmicM_Inst.m_pBMS_Pkt_0->Rdacb.iAc6v[0]);
-            tempBuf[5]  = (signed short int)((CmicM_Inst.m_pBMS_Pkt_0->Rdacc.iAc7v[1]   << 8) + CmicM_Inst.m_pBMS_Pkt_0->Rdacc.iAc7v[0]);
-            tempBuf[6]  = (signed short int)((CmicM_Inst.m_pBMS_Pkt_0->Rdacc.iAc8v[1]   << 8) + CmicM_Inst.m_pBMS_Pkt_0->Rdacc.iAc8v[0]);
-            tempBuf[7]  = (signed short int)((CmicM_Inst.m_pBMS_Pkt_0->Rdacc.iAc9v[1]   << 8) + CmicM_Inst.m_pBMS_Pkt_0->Rdacc.iAc9v[0]);
-            tempBuf[8]  = (signed short int)((CmicM_Inst.m_pBMS_Pkt_0->Rdacd.iAc11v[1]  << 8) + CmicM_Inst.m_pBMS_Pkt_0->Rdacd.iAc11v[0]);
-            tempBuf[9]  = (signed short int)((CmicM_Inst.m_pBMS_Pkt_0->Rdacd.iAc12v[1]  << 8) + CmicM_Inst.m_pBMS_Pkt_0->Rdacd.iAc12v[0]);
-            tempBuf[10] = (signed short int)((CmicM_Inst.m_pBMS_Pkt_0->Rdace.iAc13v[1]  << 8) + CmicM_Inst.m_pBMS_Pkt_0->Rdace.iAc13v[0]);
-            tempBuf[11] = (signed short int)((CmicM_Inst.m_pBMS_Pkt_0->Rdace.iAc14v[1]  << 8) + CmicM_Inst.m_pBMS_Pkt_0->Rdace.iAc14v[0]);
-            tempBuf[12] = (signed short int)((CmicM_Inst.m_pBMS_Pkt_0->Rdace.iAc15v[1]  << 8) + CmicM_Inst.m_pBMS_Pkt_0->Rdace.iAc15v[0]);
-            tempBuf[13] = (signed short int)((CmicM_Inst.m_pBMS_Pkt_0->Rdacf.iAc16v[1]  << 8) + CmicM_Inst.m_pBMS_Pkt_0->Rdacf.iAc16v[0]);
-            tempBuf[14] = (signed short int)((CmicM_Inst.m_pBMS_Pkt_0->Rdacf.iAc17v[1]  << 8) + CmicM_Inst.m_pBMS_Pkt_0->Rdacf.iAc17v[0]);
-            tempBuf[15] = (signed short int)((CmicM_Inst.m_pBMS_Pkt_0->Rdacf.iAc18v[1]  << 8) + CmicM_Inst.m_pBMS_Pkt_0->Rdacf.iAc18v[0]);
-            tempBuf[16] = (signed short int)((CmicM_Inst.m_pBMS_Pkt_0->Rdauxa.iG1v[1]   << 8) + CmicM_Inst.m_pBMS_Pkt_0->Rdauxa.iG1v[0]);
-            tempBuf[17] = (signed short int)((CmicM_Inst.m_pBMS_Pkt_0->Rdauxa.iG2v[1]   << 8) + CmicM_Inst.m_pBMS_Pkt_0->Rdauxa.iG2v[0]);
-            tempBuf[18] = (signed short int)((CmicM_Inst.m_pBMS_Pkt_0->Rdauxa.iGa11v[1] << 8) + CmicM_Inst.m_pBMS_Pkt_0->Rdauxa.iGa11v[0]);
-            tempBuf[19] = (signed short int)((CmicM_Inst.m_pBMS_Pkt_0->Rdauxe.iG3v[1]   << 8) + CmicM_Inst.m_pBMS_Pkt_0->Rdauxe.iG3v[0]);
-
-                  
-            for( i = 0; i < 16; i++){
-                /* @remark : Cell voltage convert (float) */
-                CmicM_Inst.m_NODE[eNode].CELL_V[i] = (float)(tempBuf[i]  * CELL_UNIT / 1000000.0f) + CELL_OFFSET;
-                /* @remark : Cell voltage convert (int16) */
-                CmicM_Inst.m_NODE[eNode].CELL_Vi[i] = tempBuf[i] + 10000;
-            }
 
-            for(i = 0; i < 4; i++){
-                /* @remark : AUX voltage convert (float) */
-                CmicM_Inst.m_NODE[eNode].TEMP_V[i]  = (tempBuf[i + 16] * CELL_UNIT / 1000000.0f) + CELL_OFFSET;
+			CmicM_Inst.m_pBMS_Pkt_0 = (adi_bms_base_pkt_0_t*) &pBuf[cnt].iLength;
+#if (CMIC_PEC_VERIFY == 1)
+			nPecFail = Cmic_CheckPacketPec(eNode, (uint8 const *)&CmicM_Inst.m_pBMS_Pkt_0->Rdaca, sizeof(adi_bms_base_pkt_0_t));
+#endif
 
-                /* @remark : AUX voltage convert (int16) */
-                CmicM_Inst.m_NODE[eNode].TEMP_Vi[i]  = tempBuf[i + 16] + 10000;  
-            }
-  
-            Cmic_ADBMS683x_Monitor_Base_Pkt0(&CmicM_Inst.m_userBMSBuf[cnt]);  
-			
+			Cmic_ReadBasePkt0(eNode, CmicM_Inst.m_pBMS_Pkt_0, nPecFail);
+			nReported |= (1uLL << eNode);
         }
         else if (packetId == ADI_BMS_BASE_PKT_1_ID)
 		{
-      
-            CmicM_Inst.m_pBMS_Pkt_1 = (adi_bms_base_pkt_1_t*) &CmicM_Inst.m_userBMSBuf[cnt].iLength;
+			CmicM_Inst.m_pBMS_Pkt_1 = (adi_bms_base_pkt_1_t*) &pBuf[cnt].iLength;
+			pPkt1 = CmicM_Inst.m_pBMS_Pkt_1;
+#if (CMIC_PEC_VERIFY == 1)
+			(void)Cmic_CheckPacketPec(eNode, (uint8 const *)&pPkt1->Rdsva, sizeof(adi_bms_base_pkt_1_t));
+#endif
 
-            CmicM_Inst.m_NODE[eNode].CB_STAT = ((CmicM_Inst.m_pBMS_Pkt_1->Rdcfga.iCfgar2 & BMS_CELLS_1_TO_2_MASK) << 16) + (CmicM_Inst.m_pBMS_Pkt_1->Rdcfgb.iCfgbr5 << 8) + CmicM_Inst.m_pBMS_Pkt_1->Rdcfgb.iCfgbr4;
+            if (eNode < ADK_MAX_node) {
+                CmicM_Inst.m_NODE[eNode].CB_STAT = ((pPkt1->Rdcfga.iCfgar2 & BMS_CELLS_1_TO_2_MASK) << 16) + (pPkt1->Rdcfgb.iCfgbr5 << 8) + pPkt1->Rdcfgb.iCfgbr4;
+            }
 
-			Cmic_ADBMS683x_Monitor_Base_Pkt1(&CmicM_Inst.m_userBMSBuf[cnt]);       
+			Cmic_ADBMS683x_Monitor_Base_Pkt1((adi_wil_sensor_data_t*) &pBuf[cnt]);
         }
         else if (packetId == ADI_BMS_BASE_PKT_2_ID)
 		{
-         
-            CmicM_Inst.m_pBMS_Pkt_2 = (adi_bms_base_pkt_2_t*) &CmicM_Inst.m_userBMSBuf[cnt].iLength;
+			CmicM_Inst.m_pBMS_Pkt_2 = (adi_bms_base_pkt_2_t*) &pBuf[cnt].iLength;
+			pPkt2 = CmicM_Inst.m_pBMS_Pkt_2;
+#if (CMIC_PEC_VERIFY == 1)
+			(void)Cmic_CheckPacketPec(eNode, (uint8 const *)&pPkt2->Rdstatb, sizeof(adi_bms_base_pkt_2_t));
+#endif
 
-            CmicM_Inst.m_NODE[eNode].OWD_CS_STAT = ((CmicM_Inst.m_pBMS_Pkt_2->Rdstatc.iStcr2 & 0xC0) << 10) + (CmicM_Inst.m_pBMS_Pkt_2->Rdstatc.iStcr1 << 8) + CmicM_Inst.m_pBMS_Pkt_2->Rdstatc.iStcr0;
-           
+            if (eNode < ADK_MAX_node) {
+                CmicM_Inst.m_NODE[eNode].OWD_CS_STAT = ((pPkt2->Rdstatc.iStcr2 & 0xC0) << 10) + (pPkt2->Rdstatc.iStcr1 << 8) + pPkt2->Rdstatc.iStcr0;
+            }
         }
         else{
-           
+
         }
 
         if(iOWDPcktsRcvd[eNode] == SM_ADBMS6833_ALL_PCKTS_FOR_OWD_RCVD)
         {
-            Cmic_ADBMS683x_Monitor_Cell_OWD(eNode);
-            iOWDPcktsRcvd[eNode] = 0U;
+            nOwdReady |= (1uLL << eNode);
         }
     }
-	
-	for(cnt = 0; cnt < realAcl.iCount; cnt++)
+
+    if (nOwdReady != 0U)
     {
-        // Adele
-        uint8_t* bms_pkt_map = CmicM_Inst.m_NODE[cnt].BMS_PKT_MAP;
-        //if(iBMSNotificationCount < 5)
-        //    bms_pkt_map[1] = 0xFF;
-        //bms_pkt_map[0] = tempBuf[cnt];
-        if (adi_cnt1_8bit(bms_pkt_map[0]) < adi_cnt1_8bit(bms_pkt_map[1]))
-            bms_pkt_map[1] = bms_pkt_map[0];
+        Cmic_ADBMS683x_Monitor_Pack_OWD(nOwdReady);
     }
-	
+
+#if (CMIC_PACK_MISS_LIMIT > 0)
+	/* A node still in the network can stop reporting without a disconnect
+	 * event. An interval without any base packet says nothing about the nodes */
+	if (nReported != 0U)
+	{
+		for (eNode = 0; eNode < CMIC_MAX_NODES; eNode++)
+		{
+			if ((nReported & (1uLL << eNode)) != 0U)
+			{
+				CmicM_Inst.m_aPackMiss[eNode] = 0U;
+			}
+			else if (CmicM_Inst.m_aPackMiss[eNode] < CMIC_PACK_MISS_LIMIT)
+			{
+				if (++CmicM_Inst.m_aPackMiss[eNode] == CMIC_PACK_MISS_LIMIT)
+				{
+					Cmic_PackClearNode(eNode);
+				}
+			}
+		}
+	}
+#endif
+
+	/* The pack matrix kept its aggregates up to date while the nodes were stored */
+	if (pCells->nCount > 0u)
+	{
+		pStats->fAvgV = CMIC_PACK_CODE_TO_V((float)pCells->nSum / (float)pCells->nCount);
+		pStats->fImbalanceV = CMIC_PACK_DELTA_TO_V(pCells->nMax - pCells->nMin);
+	}
+
+	/* The controller follows every interval, the balancing steps write what changed */
+	if ((eMAIN_BALANCING_AUTO == CmicM_Inst.m_tSt.m_eMain) && Cmic_BalUpdate(realAcl.iCount))
+	{
+		CmicM_Inst.m_bBalRequest = true;
+	}
+}
+
+#if (CMIC_PEC_VERIFY == 1)
+/* PEC10 check of the register groups following the packet header */
+static uint16 Cmic_CheckPacketPec(uint8 eNode, uint8 const *pGroups, uint16 nPacketSize)
+{
+	uint16 nFail;
+	uint16 nBits;
+
+	nFail = adi_pec10_CheckGroups(pGroups, (uint8)((nPacketSize - sizeof(adi_bms_packetheader_t)) / ADI_PEC_GROUP_SIZE));
+
+	for (nBits = nFail; nBits != 0U; nBits &= (uint16)(nBits - 1U))
+	{
+		CmicM_Inst.m_tPackStats.nPecErrors++;
+		CmicM_Inst.m_aPecErrors[eNode]++;
+	}
+
+	return nFail;
+}
+#endif
+
+uint32 Cmic_GetPecErrorCount(uint8 eNode)
+{
+	return (eNode < CMIC_MAX_NODES) ? CmicM_Inst.m_aPecErrors[eNode] : 0U;
+}
+
+static void Cmic_ReadBasePkt0(uint8 eNode, adi_bms_base_pkt_0_t const *pPkt, uint16 nPecFail)
+{
+	/* Cells of the averaged cell voltage groups A..F, group order of the packet */
+	static const uint16 aGroupCells[6] = { 0x0003U, 0x001CU, 0x00E0U, 0x0300U, 0x1C00U, 0xE000U };
+	Cmic_PackStats_t *pStats = &CmicM_Inst.m_tPackStats;
+	/* The matrix still holds the previous interval of the node for the rate check */
+	sint16 const *pPrev = &Cmic_PackGetCellCodes()[CMIC_PACK_CELL_INDEX(eNode, 0u)];
+	uint8 const *pPrevStatus = &Cmic_PackGetCellStatus()[CMIC_PACK_CELL_INDEX(eNode, 0u)];
+	uint32 nFault = 0u;
+	uint32 nCandidate = 0u;
+	sint16 tempBuf[20];
+	sint16 nCode;
+	sint32 nStep;
+	uint8 i;
+
+	/* @remark : Read raw data, the only decode of the packet */
+	tempBuf[0]  = (signed short int)((pPkt->Rdaca.iAc2v[1]   << 8) + pPkt->Rdaca.iAc2v[0]);
+	tempBuf[1]  = (signed short int)((pPkt->Rdaca.iAc3v[1]   << 8) + pPkt->Rdaca.iAc3v[0]);
+	tempBuf[2]  = (signed short int)((pPkt->Rdacb.iAc4v[1]   << 8) + pPkt->Rdacb.iAc4v[0]);
+	tempBuf[3]  = (signed short int)((pPkt->Rdacb.iAc5v[1]   << 8) + pPkt->Rdacb.iAc5v[0]);
+	tempBuf[4]  = (signed short int)((pPkt->Rdacb.iAc6v[1]   << 8) + pPkt->Rdacb.iAc6v[0]);
+	tempBuf[5]  = (signed short int)((pPkt->Rdacc.iAc7v[1]   << 8) + pPkt->Rdacc.iAc7v[0]);
+	tempBuf[6]  = (signed short int)((pPkt->Rdacc.iAc8v[1]   << 8) + pPkt->Rdacc.iAc8v[0]);
+	tempBuf[7]  = (signed short int)((pPkt->Rdacc.iAc9v[1]   << 8) + pPkt->Rdacc.iAc9v[0]);
+	tempBuf[8]  = (signed short int)((pPkt->Rdacd.iAc11v[1]  << 8) + pPkt->Rdacd.iAc11v[0]);
+	tempBuf[9]  = (signed short int)((pPkt->Rdacd.iAc12v[1]  << 8) + pPkt->Rdacd.iAc12v[0]);
+	tempBuf[10] = (signed short int)((pPkt->Rdace.iAc13v[1]  << 8) + pPkt->Rdace.iAc13v[0]);
+	tempBuf[11] = (signed short int)((pPkt->Rdace.iAc14v[1]  << 8) + pPkt->Rdace.iAc14v[0]);
+	tempBuf[12] = (signed short int)((pPkt->Rdace.iAc15v[1]  << 8) + pPkt->Rdace.iAc15v[0]);
+	tempBuf[13] = (signed short int)((pPkt->Rdacf.iAc16v[1]  << 8) + pPkt->Rdacf.iAc16v[0]);
+	tempBuf[14] = (signed short int)((pPkt->Rdacf.iAc17v[1]  << 8) + pPkt->Rdacf.iAc17v[0]);
+	tempBuf[15] = (signed short int)((pPkt->Rdacf.iAc18v[1]  << 8) + pPkt->Rdacf.iAc18v[0]);
+	tempBuf[16] = (signed short int)((pPkt->Rdauxa.iG1v[1]   << 8) + pPkt->Rdauxa.iG1v[0]);
+	tempBuf[17] = (signed short int)((pPkt->Rdauxa.iG2v[1]   << 8) + pPkt->Rdauxa.iG2v[0]);
+	tempBuf[18] = (signed short int)((pPkt->Rdauxa.iGa11v[1] << 8) + pPkt->Rdauxa.iGa11v[0]);
+	tempBuf[19] = (signed short int)((pPkt->Rdauxe.iG3v[1]   << 8) + pPkt->Rdauxe.iG3v[0]);
+
+	for( i = 0; i < 16; i++){
+		nCode = tempBuf[i];
+
+		if (eNode < ADK_MAX_node) {
+			/* @remark : Cell voltage convert (float) */
+			CmicM_Inst.m_NODE[eNode].CELL_V[i] = (float)(nCode * CELL_UNIT / 1000000.0f) + CELL_OFFSET;
+			/* @remark : Cell voltage convert (int16) */
+			CmicM_Inst.m_NODE[eNode].CELL_Vi[i] = nCode + 10000;
+		}
+
+		/* A reading near zero is what an open wire leaves on the C channel */
+		if (nCode < SM_ADBMS6833_OW_ZERO_VOL) {
+			nCandidate |= (1uL << i);
+		}
+
+		nStep = (sint32)nCode - (sint32)pPrev[i];
+
+		if ((nCode < CMIC_CELL_CODE_MIN) || (nCode > CMIC_CELL_CODE_MAX)) {
+			nFault |= (1uL << i);
+			pStats->nRangeFaults++;
+		}
+		else if (((pPrevStatus[i] & (CMIC_PACK_ST_PRESENT | CMIC_PACK_ST_FAULT)) == CMIC_PACK_ST_PRESENT) && ((nStep > CMIC_CELL_CODE_MAX_STEP) || (nStep < -CMIC_CELL_CODE_MAX_STEP))) {
+			nFault |= (1uL << i);
+			pStats->nRateFaults++;
+		}
+	}
+
+	for(i = 0; (i < 4) && (eNode < ADK_MAX_node); i++){
+		/* @remark : AUX voltage convert (float) */
+		CmicM_Inst.m_NODE[eNode].TEMP_V[i]  = (tempBuf[i + 16] * CELL_UNIT / 1000000.0f) + CELL_OFFSET;
+
+		/* @remark : AUX voltage convert (int16) */
+		CmicM_Inst.m_NODE[eNode].TEMP_Vi[i]  = tempBuf[i + 16] + 10000;
+	}
+
+	/* Cells of a group failing its PEC are not trusted either */
+	for (i = 0; i < 6; i++) {
+		if ((nPecFail & (1U << i)) != 0U) {
+			nFault |= aGroupCells[i];
+		}
+	}
+
+	pStats->aPlausFault[eNode] = nFault;
+	pStats->aOwdCandidate[eNode] = nCandidate;
+
+	Cmic_PackSetNodeCells(eNode, tempBuf, nFault, nCandidate);
+	Cmic_PackSetNodeTemps(eNode, &tempBuf[16]);
+
+	/* The open wire check takes the C channel codes decoded above */
+	Cmic_ADBMS683x_Monitor_Base_Pkt0(eNode, tempBuf);
 }
 
+#if (CMIC_BMS_BENCHMARK == 1)
+#define CMIC_BENCH_NODES		62u
+#define CMIC_BENCH_ROUNDS		10u
+
+void Cmic_BenchmarkReadBMS(void)
+{
+	/* Three base packets per node, as one interval of the base script */
+	static adi_wil_sensor_data_t aBenchBuf[CMIC_BENCH_NODES * ADI_BMS_PACKETS_PER_NODE_PER_INTERVAL];
+	Cmic_PackStats_t const *pStats;
+	uint32 nStart, nTicks, nCycles;
+	uint16 nPkt, j;
+	uint8 nRound;
+
+	/* Cell codes around 3.7 V. Every node has its own row of the pack
+	 * matrix and its own open wire state, the m_NODE view only holds the
+	 * first ADK_MAX_node nodes */
+	for (nPkt = 0; nPkt < (CMIC_BENCH_NODES * ADI_BMS_PACKETS_PER_NODE_PER_INTERVAL); nPkt++)
+	{
+		aBenchBuf[nPkt].eDeviceId = (adi_wil_device_t)ADI_WIL_DEV_NODE_0 << (nPkt / ADI_BMS_PACKETS_PER_NODE_PER_INTERVAL);
+		aBenchBuf[nPkt].iLength = ADI_WIL_MAX_APP_PAYLOAD_SIZE;
+		for (j = 1; j < ADI_WIL_MAX_APP_PAYLOAD_SIZE; j++)
+		{
+			aBenchBuf[nPkt].Data[j] = ((j & 1u) != 0u) ? (uint8)(nPkt + j) : 0x39u;
+		}
+	}
+	for (nPkt = 0; nPkt < CMIC_BENCH_NODES; nPkt++)
+	{
+		aBenchBuf[(nPkt * ADI_BMS_PACKETS_PER_NODE_PER_INTERVAL) + 0u].Data[0] = ADI_BMS_BASE_PKT_0_ID;
+		aBenchBuf[(nPkt * ADI_BMS_PACKETS_PER_NODE_PER_INTERVAL) + 1u].Data[0] = ADI_BMS_BASE_PKT_1_ID;
+		aBenchBuf[(nPkt * ADI_BMS_PACKETS_PER_NODE_PER_INTERVAL) + 2u].Data[0] = ADI_BMS_BASE_PKT_2_ID;
+	}
+
+	nStart = IfxStm_getLower(&MODULE_STM0);
+	for (nRound = 0; nRound < CMIC_BENCH_ROUNDS; nRound++)
+	{
+		Cmic_ProcessBMSInterval(aBenchBuf, (uint16)(CMIC_BENCH_NODES * ADI_BMS_PACKETS_PER_NODE_PER_INTERVAL));
+	}
+	nTicks = (IfxStm_getLower(&MODULE_STM0) - nStart) / CMIC_BENCH_ROUNDS;
+	nCycles = (uint32)((float32)nTicks * (IfxScuCcu_getCpuFrequency(IfxCpu_ResourceCpu_0) / IfxStm_getFrequency(&MODULE_STM0)));
+
+	pStats = Cmic_GetPackStats();
+
+	adi_wil_ex_printf("Cmic_ReadBMS : %u nodes x 16 cells, %u cycles per interval (%u per node)" LINE_END,
+	                  (unsigned int)CMIC_BENCH_NODES,
+	                  (unsigned int)nCycles,
+	                  (unsigned int)(nCycles / CMIC_BENCH_NODES));
+	adi_wil_ex_printf("Cmic_ReadBMS : last interval %u range and %u rate faults, average %d mV" LINE_END,
+	                  (unsigned int)pStats->nRangeFaults,
+	                  (unsigned int)pStats->nRateFaults,
+	                  (int)(pStats->fAvgV * 1000.0f));
+
+	/* Runs ahead of the instance reset in CmicM_Init, only the open wire
+	 * state outside the instance is left to clear */
+	memset(aiOWStatus, 0, sizeof(aiOWStatus));
+	memset(aiOWCellData, 0, sizeof(aiOWCellData));
+	memset(aiNominalCellData, 0, sizeof(aiNominalCellData));
+	memset(iOWDPcktsRcvd, 0, sizeof(iOWDPcktsRcvd));
+}
+#endif
+
 adi_bms_latent0_pkt_0_t Latency0_Pkt_0;
 adi_bms_latent0_pkt_1_t Latency0_Pkt_1;
 adi_bms_latent0_pkt_2_t Latency0_Pkt_2;
@@ -3015,9 +3475,27 @@ void Cmic_PresetModifyData(void)
             CmicM_Inst.m_iDecFinal[nodeCnt] = CmicM_Inst.m_iDecTemp[nodeCnt];
             CmicM_Inst.m_iDecFinal[nodeCnt] &= 0x154AA; //ODD for  [6833]
         }
+        else if(eMAIN_BALANCING_AUTO == CmicM_Inst.m_tSt.m_eMain){
+            /* Only the nodes whose controller target changed are written */
+            CmicM_Inst.m_iBalCells[nodeCnt] = Cmic_BalGetTarget(nodeCnt);
+            CmicM_Inst.m_iDecFinal[nodeCnt] = CMIC_BAL_CELLS_TO_DCC(CmicM_Inst.m_iBalCells[nodeCnt]);
+            CmicM_Inst.m_bCB_NODE[nodeCnt] = (Cmic_BalGetChange(nodeCnt) != 0u);
+        }
         else{ //sensing
             CmicM_Inst.m_iDecFinal[nodeCnt] = 0; //DCC default roll back
         }          
+
+        /* A node already holding both registers is skipped */
+        if(CmicM_Inst.m_bCB_NODE[nodeCnt] == true){
+            Cmic_BuildNodePayload(nodeCnt);
+
+            if(CmicM_Inst.m_aWriteMask[nodeCnt] == 0u){
+                CmicM_Inst.m_bCB_NODE[nodeCnt] = false;
+                if(eMAIN_BALANCING_AUTO == CmicM_Inst.m_tSt.m_eMain){
+                    Cmic_BalCommit(nodeCnt, CmicM_Inst.m_iBalCells[nodeCnt], 0u);
+                }
+            }
+        }
     }
 
 	CmicM_Inst.m_tScriptChange.iCount = realAcl.iCount; //node count
@@ -3026,6 +3504,76 @@ void Cmic_PresetModifyData(void)
 }
 
 
+/* Fills the WRCFGA and WRCFGB payloads of a node from m_iDecFinal and asks
+ * the script cache which of them the node does not hold yet */
+static void Cmic_BuildNodePayload(uint8 nodeCnt)
+{
+	uint8 *pData = CmicM_Inst.m_tScriptChange.iDeviceChangeScriptInfo[nodeCnt].iChangeData;
+
+	//Setting WRCFGA 6Bytes 
+	pData[0] = 0x80; //REFON=1, CTH[2:0]=0
+	pData[1] = 0x00;  //FLAG_D[7:0]=0      
+	pData[WRCFGA_DCC_OFFSET] = 0x40; //OWRNG=1 (?)
+	pData[WRCFGA_DCC_OFFSET] |= (uint8_t)((CmicM_Inst.m_iDecFinal[nodeCnt] / 0x10000 ) & BMS_CELLS_1_TO_2_MASK); //WRCFGA DCC[18,17]
+	pData[WRCFGA_DCC_OFFSET+1] = 0xFF; //GPIO[8~1] pull-down off
+	pData[WRCFGA_DCC_OFFSET+2] = 0x03; //GPIO[10,9] pull-down off
+	pData[WRCFGA_DCC_OFFSET+3] = 0x07; //FC[2:0]:IIR Filter
+
+	//WRCFGB DCC설정
+	pData[WRCFGB_DCC_OFFSET] = (uint8_t)(CmicM_Inst.m_iDecFinal[nodeCnt] & BMS_CELLS_1_TO_8_MASK);
+	pData[WRCFGB_DCC_OFFSET+1] = (uint8_t)((CmicM_Inst.m_iDecFinal[nodeCnt] & BMS_CELLS_9_TO_16_MASK) >> 8);
+
+	CmicM_Inst.m_aWriteMask[nodeCnt] = 0u;
+	if (adi_wil_example_ScriptCacheBuild(nodeCnt, ADI_SCRIPT_REG_CFGA, pData)){
+		CmicM_Inst.m_aWriteMask[nodeCnt] |= ADI_SCRIPT_CACHE_REG_MASK(ADI_SCRIPT_REG_CFGA);
+	}
+	if (adi_wil_example_ScriptCacheBuild(nodeCnt, ADI_SCRIPT_REG_CFGB, &pData[BMS_SCRIPT_WRCFGA_DATA_LENGTH])){
+		CmicM_Inst.m_aWriteMask[nodeCnt] |= ADI_SCRIPT_CACHE_REG_MASK(ADI_SCRIPT_REG_CFGB);
+	}
+}
+
+/* Sends the first register of the node at m_nNodeCount that needs a write */
+static adi_script_reg_t Cmic_WriteNodeFirst(void)
+{
+	if ((CmicM_Inst.m_aWriteMask[CmicM_Inst.m_nNodeCount] & ADI_SCRIPT_CACHE_REG_MASK(ADI_SCRIPT_REG_CFGA)) != 0u){
+		Cmic_RequestModifyScript_CFG_A();
+		return ADI_SCRIPT_REG_CFGA;
+	}
+
+	Cmic_RequestModifyScript_CFG_B();
+	return ADI_SCRIPT_REG_CFGB;
+}
+
+/* Tells the script cache whether the node at m_nNodeCount took the register */
+static void Cmic_CommitNodeRegister(adi_script_reg_t eReg)
+{
+	uint8 nodeCnt = CmicM_Inst.m_nNodeCount;
+
+	if ((CmicM_Inst.m_aWriteMask[nodeCnt] & ADI_SCRIPT_CACHE_REG_MASK(eReg)) != 0u){
+		adi_wil_example_ScriptCacheCommit(nodeCnt, eReg, !CmicM_Inst.m_tScriptChange.bFailureFlag[nodeCnt]);
+	}
+}
+
+/* iActivationTime needs to be calculated from latest BMS packet timestamp and ACTIVATION_DELAY specified.
+   It is taken once per pass, when the first node is actually written, so every node of the pass
+   applies its registers at the same time */
+static uint16 Cmic_GetActivationTime(void)
+{
+	uint16 currPktTimestamp;
+
+	if (CmicM_Inst.m_bActivationSet == false){
+		currPktTimestamp = CmicM_Inst.m_userBMSBuf[0].Data[PACKET_HEADER_TIMESTAMP_OFFSET] << 8;
+		currPktTimestamp |= CmicM_Inst.m_userBMSBuf[0].Data[PACKET_HEADER_TIMESTAMP_OFFSET+1];
+		currPktTimestamp = (currPktTimestamp & 0x7FFF) + ACTIVATION_DELAY;
+
+		CmicM_Inst.m_iActivationTime = (currPktTimestamp & BMS_CELLS_9_TO_16_MASK) >> 8;
+		CmicM_Inst.m_iActivationTime |= (currPktTimestamp & BMS_CELLS_1_TO_8_MASK) << 8;
+		CmicM_Inst.m_bActivationSet = true;
+	}
+
+	return CmicM_Inst.m_iActivationTime;
+}
+
 bool Cmic_CheckNode(void)
 {
 	bool   bExecute=false;	//밸런싱할 노드를 찾았을 때=true
@@ -3045,50 +3593,20 @@ bool Cmic_CheckNode(void)
 void Cmic_RequestModifyScript_CFG_A(void)
 {
 	adi_wil_err_t errorCode = ADI_WIL_ERR_SUCCESS;
-	uint16 currPktTimestamp=0, calPktTimestamp=0;
-	uint16 pecVal = 0;
 	uint8  devID = 0;
 	uint8  nodeCnt = CmicM_Inst.m_nNodeCount;
 
-	//Setting WRCFGA 6Bytes 
-	CmicM_Inst.m_tScriptChange.iDeviceChangeScriptInfo[nodeCnt].iChangeData[0] = 0x80; //REFON=1, CTH[2:0]=0
-	CmicM_Inst.m_tScriptChange.iDeviceChangeScriptInfo[nodeCnt].iChangeData[1] = 0x00;  //FLAG_D[7:0]=0      
-	CmicM_Inst.m_tScriptChange.iDeviceChangeScriptInfo[nodeCnt].iChangeData[WRCFGA_DCC_OFFSET] = 0x40; //OWRNG=1 (?)
-	CmicM_Inst.m_tScriptChange.iDeviceChangeScriptInfo[nodeCnt].iChangeData[WRCFGA_DCC_OFFSET] |= (uint8_t)((CmicM_Inst.m_iDecFinal[nodeCnt] / 0x10000 ) & BMS_CELLS_1_TO_2_MASK); //WRCFGA DCC[18,17]
-	CmicM_Inst.m_tScriptChange.iDeviceChangeScriptInfo[nodeCnt].iChangeData[WRCFGA_DCC_OFFSET+1] = 0xFF; //GPIO[8~1] pull-down off
-	CmicM_Inst.m_tScriptChange.iDeviceChangeScriptInfo[nodeCnt].iChangeData[WRCFGA_DCC_OFFSET+2] = 0x03; //GPIO[10,9] pull-down off
-	CmicM_Inst.m_tScriptChange.iDeviceChangeScriptInfo[nodeCnt].iChangeData[WRCFGA_DCC_OFFSET+3] = 0x07; //FC[2:0]:IIR Filter
- 
+	//WRCFGA 6Bytes and PEC were set by Cmic_BuildNodePayload
 	CmicM_Inst.m_tScriptChange.iDeviceChangeScriptInfo[nodeCnt].iChangeDataLength = BMS_SCRIPT_WRCFGA_DATA_LENGTH;    /* Length of the data to change in the script at the node */
     CmicM_Inst.m_tScriptChange.iDeviceChangeScriptInfo[nodeCnt].iEntryOffset = BMS_SCRIPT_WRCFGA_OFFSET;              /* Offset to the DCC bits to be changed in Config B register */
 
-   	/* iActivationTime needs to be calculated from latest BMS packet timestamp and ACTIVATION_DELAY specified. 
-	   Latest BMS packet will be retrieved from the timestamp field from the latest BMS data packet */
-	if(nodeCnt == 0)
-	{
-		currPktTimestamp = CmicM_Inst.m_userBMSBuf[0].Data[PACKET_HEADER_TIMESTAMP_OFFSET] << 8;
-		currPktTimestamp |= CmicM_Inst.m_userBMSBuf[0].Data[PACKET_HEADER_TIMESTAMP_OFFSET+1];
-		currPktTimestamp = (currPktTimestamp & 0x7FFF) + ACTIVATION_DELAY;
-
-		calPktTimestamp = (currPktTimestamp & BMS_CELLS_9_TO_16_MASK) >> 8;
-		calPktTimestamp |= (currPktTimestamp & BMS_CELLS_1_TO_8_MASK) << 8;
-	}
-	CmicM_Inst.m_tScriptChange.iDeviceChangeScriptInfo[nodeCnt].iActivationTime = calPktTimestamp;
-
-	/* Calculating the PEC for updated configuration A register to be set on the node */
-	pecVal = Cmic_PEC10_Calc(true, 0,
-							BMS_SCRIPT_WRCFGA_DATA_LENGTH - 2,
-							CmicM_Inst.m_tScriptChange.iDeviceChangeScriptInfo[nodeCnt].iChangeData);
+	CmicM_Inst.m_tScriptChange.iDeviceChangeScriptInfo[nodeCnt].iActivationTime = Cmic_GetActivationTime();
 
-	CmicM_Inst.m_tScriptChange.iDeviceChangeScriptInfo[nodeCnt].iChangeData[WRCFGA_PEC_OFFSET] = (uint8_t)(pecVal >> 8);
-	CmicM_Inst.m_tScriptChange.iDeviceChangeScriptInfo[nodeCnt].iChangeData[WRCFGA_PEC_OFFSET+1] = (uint8_t)(pecVal >> 0);
-
-	
 	Cmic_MAC_DeviceID_Return(&packInstance, false, &CmicM_Inst.m_tScriptChange.iDeviceList[ADI_WIL_MAC_ADDR_SIZE * nodeCnt], &devID);
 
 	/* Calling ModifyScript node API */
-	errorCode = adi_wil_ModifyScript(&packInstance, (adi_wil_device_t)(ADI_WIL_DEV_NODE_0 << devID),
-									ADI_WIL_SENSOR_ID_BMS, 	&CmicM_Inst.m_tScriptChange.iDeviceChangeScriptInfo[nodeCnt]);
+	errorCode = Cmic_ModifyScript((adi_wil_device_t)ADI_WIL_DEV_NODE_0 << devID,
+									&CmicM_Inst.m_tScriptChange.iDeviceChangeScriptInfo[nodeCnt]);
 										
 	if (errorCode != ADI_WIL_ERR_SUCCESS) {
 		CmicM_Inst.m_tScriptChange.bFailureFlag[nodeCnt] = true;
@@ -3099,22 +3617,10 @@ void Cmic_RequestModifyScript_CFG_A(void)
 void Cmic_RequestModifyScript_CFG_B(void)
 {
 	adi_wil_err_t errorCode = ADI_WIL_ERR_SUCCESS;
-	uint16 pecVal = 0;
 	uint8  devID = 0;
 	uint8  nodeCnt = CmicM_Inst.m_nNodeCount;
 
-	//WRCFGB DCC설정
-	CmicM_Inst.m_tScriptChange.iDeviceChangeScriptInfo[nodeCnt].iChangeData[WRCFGB_DCC_OFFSET] = (uint8_t)(CmicM_Inst.m_iDecFinal[nodeCnt] & BMS_CELLS_1_TO_8_MASK);
-	CmicM_Inst.m_tScriptChange.iDeviceChangeScriptInfo[nodeCnt].iChangeData[WRCFGB_DCC_OFFSET+1] = (uint8_t)((CmicM_Inst.m_iDecFinal[nodeCnt] & BMS_CELLS_9_TO_16_MASK) >> 8);
-	
-	/* Calculating the PEC for updated configuration B register to be set on the node */
-	pecVal = Cmic_PEC10_Calc(true, WRCFGB_PEC_OFFSET - WRCFGA_PEC_OFFSET,
-							BMS_SCRIPT_WRCFGB_DATA_LENGTH - 2,
-							CmicM_Inst.m_tScriptChange.iDeviceChangeScriptInfo[nodeCnt].iChangeData);
-
-	CmicM_Inst.m_tScriptChange.iDeviceChangeScriptInfo[nodeCnt].iChangeData[WRCFGB_PEC_OFFSET] = (uint8_t)(pecVal >> 8);
-	CmicM_Inst.m_tScriptChange.iDeviceChangeScriptInfo[nodeCnt].iChangeData[WRCFGB_PEC_OFFSET+1] = (uint8_t)(pecVal >> 0);
-
+	//WRCFGB DCC and PEC were set by Cmic_BuildNodePayload
 	Cmic_MAC_DeviceID_Return(&packInstance, false, &CmicM_Inst.m_tScriptChange.iDeviceList[ADI_WIL_MAC_ADDR_SIZE * nodeCnt], &devID);
 
     for (int k = 0; k < BMS_SCRIPT_WRCFGB_DATA_LENGTH; k++)
@@ -3124,10 +3630,11 @@ void Cmic_RequestModifyScript_CFG_B(void)
 	}
     CmicM_Inst.m_tScriptChange.iDeviceChangeScriptInfo[nodeCnt].iChangeDataLength = BMS_SCRIPT_WRCFGB_DATA_LENGTH;    /* Length of the data to change in the script at the node */
     CmicM_Inst.m_tScriptChange.iDeviceChangeScriptInfo[nodeCnt].iEntryOffset = BMS_SCRIPT_WRCFGB_OFFSET;
+	CmicM_Inst.m_tScriptChange.iDeviceChangeScriptInfo[nodeCnt].iActivationTime = Cmic_GetActivationTime();
 	
 	/* Calling ModifyScript node API */
-	errorCode = adi_wil_ModifyScript(&packInstance, (adi_wil_device_t)(ADI_WIL_DEV_NODE_0 << devID),
-									ADI_WIL_SENSOR_ID_BMS, 	&CmicM_Inst.m_tScriptChange.iDeviceChangeScriptInfo[nodeCnt]);
+	errorCode = Cmic_ModifyScript((adi_wil_device_t)ADI_WIL_DEV_NODE_0 << devID,
+									&CmicM_Inst.m_tScriptChange.iDeviceChangeScriptInfo[nodeCnt]);
 										
 	if (errorCode != ADI_WIL_ERR_SUCCESS) {
 		CmicM_Inst.m_tScriptChange.bFailureFlag[nodeCnt] = true;
@@ -3136,47 +3643,120 @@ void Cmic_RequestModifyScript_CFG_B(void)
 }
 
 
-uint16_t Cmic_PEC10_Calc(bool rx_cmd, int offset, int len, uint8_t *data)
+#if (CMIC_SCRIPT_BENCHMARK == 1)
+#define CMIC_SCRIPT_BENCH_UPDATES	100u
+#define CMIC_SCRIPT_BENCH_CHANGES	2u		//Cells toggled per update
+
+typedef struct
 {
-    uint16_t remainder = 16; /* PEC_SEED;   0000010000 */
-    uint16_t polynom = 0x8F; /* x10 + x7 + x3 + x2 + x + 1 <- the CRC15 polynomial         100 1000 1111   48F */
+	boolean	m_bRunning;
+	uint32	m_nCalls;		//adi_wil_ModifyScript calls the writes made
+	boolean	m_bPecOk;		//Every payload sent carried the PEC of its data
+}Cmic_ScriptBench_t;
 
-    /* Perform modulo-2 division, a byte at a time. */
-    for (int pbyte = offset; pbyte < (offset + len); ++pbyte)
-    {
-        /* Bring the next byte into the remainder. */
-        remainder ^= (uint16_t)(data[pbyte] << 2);
+static Cmic_ScriptBench_t Cmic_ScriptBench;
+#endif
 
-        /* Perform modulo-2 division, a bit at a time.*/
-        for (uint8_t bit_ = 8; bit_ > 0; --bit_)
-        {
-            /* Try to divide the current data bit. */
-            if ((remainder & 0x200) > 0) { /* equivalent to remainder & 2^14 simply check for MSB */
-                remainder = (uint16_t)((remainder << 1));
-                remainder = (uint16_t)(remainder ^ polynom);
-            } else {
-                remainder = (uint16_t)(remainder << 1);
-            }
-        }
-    }
+/* Sends one register payload of the node. While the script benchmark runs
+ * the call is counted and its PEC checked instead */
+static adi_wil_err_t Cmic_ModifyScript(adi_wil_device_t eDevice, adi_wil_script_change_t const *pChange)
+{
+#if (CMIC_SCRIPT_BENCHMARK == 1)
+	uint8  aCheck[ADI_PEC_GROUP_SIZE];
+	uint16 nPec;
+
+	if (Cmic_ScriptBench.m_bRunning == TRUE){
+		memcpy(aCheck, pChange->iChangeData, ADI_PEC_GROUP_SIZE);
+		aCheck[ADI_PEC_GROUP_DATA_SIZE] = 0u;
+		nPec = adi_pec10_Calc(aCheck, ADI_PEC_GROUP_DATA_SIZE, true);
+		if ((pChange->iChangeData[ADI_PEC_GROUP_DATA_SIZE] != (uint8)(nPec >> 8)) ||
+			(pChange->iChangeData[ADI_PEC_GROUP_DATA_SIZE+1] != (uint8)nPec)){
+			Cmic_ScriptBench.m_bPecOk = FALSE;
+		}
+		Cmic_ScriptBench.m_nCalls++;
+		return ADI_WIL_ERR_SUCCESS;
+	}
+#endif
+	return adi_wil_ModifyScript(&packInstance, eDevice, ADI_WIL_SENSOR_ID_BMS, pChange);
+}
 
-    if (rx_cmd == true) {
-        remainder ^= (uint16_t)((data[offset + len] & 0xFC) << 2);
+/* The WIL finished the ModifyScript request, at once while the script benchmark runs */
+static boolean Cmic_IsModifyScriptReleased(void)
+{
+#if (CMIC_SCRIPT_BENCHMARK == 1)
+	if (Cmic_ScriptBench.m_bRunning == TRUE){
+		return TRUE;
+	}
+#endif
+	return IsReleaseWilAPI(&packInstance);
+}
 
-        /* Perform modulo-2 division, a bit at a time */
-        for (uint8_t bit_ = 6; bit_ > 0; --bit_)
-        {
-            /* Try to divide the current data bit */
-            if ((remainder & 0x200) > 0) { /* equivalent to remainder & 2^14 simply check for MSB */
-                remainder = (uint16_t)((remainder << 1));
-                remainder = (uint16_t)(remainder ^ polynom);
-            } else {
-                remainder = (uint16_t)((remainder << 1));
-            }
-        }
-    }
-    return ((uint16_t)(remainder & 0x3FF));
+#if (CMIC_SCRIPT_BENCHMARK == 1)
+void Cmic_ScriptBenchmark(void)
+{
+	adi_script_cache_stats_t const *pStats = adi_wil_example_ScriptCacheGetStats();
+	uint8  nAclCount = realAcl.iCount;
+	uint32 nSeed = 1u;
+	uint16 nUpdate;
+	uint8  nNode, nCell, nChange;
+
+	adi_wil_example_ScriptCacheReset();
+	Cmic_ScriptBench.m_bRunning = TRUE;
+	Cmic_ScriptBench.m_nCalls = 0u;
+	Cmic_ScriptBench.m_bPecOk = TRUE;
+
+	/* Every cell selected as at boot, balanced by even cell passes */
+	realAcl.iCount = ADK_MAX_node;
+	for (nNode = 0; nNode < ADK_MAX_node; nNode++){
+		for (nCell = 0; nCell < ADK_MAX_cell; nCell++){
+			CmicM_Inst.m_bCB_CELL[nNode][nCell] = true;
+		}
+	}
+	CmicM_Inst.m_tSt.m_eMain = eMAIN_BALANCING_EVEN;
+	CmicM_Inst.m_notifyRC = ADI_WIL_ERR_SUCCESS;
+
+	for (nUpdate = 0; nUpdate <= CMIC_SCRIPT_BENCH_UPDATES; nUpdate++){
+		/* The first pass writes every node, then a few cells change per update */
+		for (nChange = 0; (nUpdate != 0u) && (nChange < CMIC_SCRIPT_BENCH_CHANGES); nChange++){
+			nSeed = (nSeed * 1664525uL) + 1013904223uL;
+			nNode = (uint8)((nSeed >> 8) % ADK_MAX_node);
+			nCell = (uint8)((nSeed >> 16) % ADK_MAX_cell);
+			CmicM_Inst.m_bCB_CELL[nNode][nCell] = !CmicM_Inst.m_bCB_CELL[nNode][nCell];
+		}
+
+		/* One balancing pass through the state machine, every request completes at once */
+		CmicM_Inst.m_tSt.m_eBalancing = eBALANCING_st1_REQ;
+		do {
+			CmicM_ControlBalancingState();
+		} while (CmicM_Inst.m_tSt.m_eBalancing != eBALANCING_st0_IDLE);
+	}
+
+	adi_wil_ex_printf("Script benchmark, %u nodes x %u updates : %u ModifyScript calls (%u without the cache), %u PEC computed, PEC check %s" LINE_END,
+					  (unsigned int)ADK_MAX_node,
+					  (unsigned int)CMIC_SCRIPT_BENCH_UPDATES,
+					  (unsigned int)Cmic_ScriptBench.m_nCalls,
+					  (unsigned int)pStats->iBuilds,
+					  (unsigned int)pStats->iPecComputed,
+					  (Cmic_ScriptBench.m_bPecOk == TRUE) ? "passed" : "FAILED");
+
+	/* Leave the balancing state as CmicM_Init found it */
+	Cmic_ScriptBench.m_bRunning = FALSE;
+	realAcl.iCount = nAclCount;
+	memset(&CmicM_Inst.m_tSt, 0, sizeof(CmicM_Inst.m_tSt));
+	memset(&CmicM_Inst.m_tScriptChange, 0, sizeof(CmicM_Inst.m_tScriptChange));
+	memset(CmicM_Inst.m_bCB_CELL, 0, sizeof(CmicM_Inst.m_bCB_CELL));
+	memset(CmicM_Inst.m_bCB_NODE, 0, sizeof(CmicM_Inst.m_bCB_NODE));
+	memset(CmicM_Inst.m_iDecTemp, 0, sizeof(CmicM_Inst.m_iDecTemp));
+	memset(CmicM_Inst.m_iDecFinal, 0, sizeof(CmicM_Inst.m_iDecFinal));
+	memset(CmicM_Inst.m_aWriteMask, 0, sizeof(CmicM_Inst.m_aWriteMask));
+	CmicM_Inst.m_nNodeCount = 0;
+	CmicM_Inst.m_nTaskCnt = 0;
+	CmicM_Inst.m_bActivationSet = false;
+	CmicM_Inst.m_iActivationTime = 0;
+	adi_wil_example_ScriptCacheReset();
 }
+#endif
+
 
 /******************************************************************************
  * MAC <-> index retrieval function
@@ -3194,54 +3774,17 @@ void Cmic_MAC_DeviceID_Return(adi_wil_pack_t *pPack, bool bMacReturn, uint8_t *p
         }
     }
     else {
-        for(uint8_t i=0;i<ADI_WIL_MAX_NODES;i++) {
-            bool bMacFound = true;
-            for(uint8_t j=0;j<ADI_WIL_MAC_ADDR_SIZE && bMacFound;j++) {
-                bMacFound = (CmicM_Inst.m_sysAcl.Data[(ADI_WIL_MAC_ADDR_SIZE*i)+j] == *(pMacPtr+j));
-            }
-            if(bMacFound == true) {
-                /*Retrieving the Device ID */
-                *pDeviceID = i;
-                break;
-            }
-        }
+        /*Retrieving the Device ID, left unchanged when the MAC is not in the ACL */
+        (void)adi_wil_example_DeviceDirFindMac(pMacPtr, pDeviceID);
     }
 }
 
 
-void Cmic_ADBMS683x_Monitor_Base_Pkt0(adi_wil_sensor_data_t* BMSBufferPtr)
+void Cmic_ADBMS683x_Monitor_Base_Pkt0(uint8 eNode, sint16 const *pCellCodes)
 {
-    uint8_t eNode   = 100;
-    adi_bms_base_pkt_0_t* pPacketPtr;
-
-    /* Get Node ID from the BMS packet */
-    eNode       = Cmic_ConvertDeviceId(BMSBufferPtr->eDeviceId);
-
-    /* Use corresponding packet structure to easily parse data from the BMS packet */
-    pPacketPtr  = (adi_bms_base_pkt_0_t*) &BMSBufferPtr->iLength;
-    
     /******************** Get C ch Data for Open Wire detection ********************/
-    aiNominalCellData[eNode][0]  = (pPacketPtr->Rdaca.iAc2v[1] << 8) +  pPacketPtr->Rdaca.iAc2v[0];    
-    aiNominalCellData[eNode][1]  = (pPacketPtr->Rdaca.iAc3v[1] << 8) +  pPacketPtr->Rdaca.iAc3v[0];   
-    aiNominalCellData[eNode][2]  = (pPacketPtr->Rdacb.iAc4v[1] << 8) +  pPacketPtr->Rdacb.iAc4v[0];  
-    aiNominalCellData[eNode][3]  = (pPacketPtr->Rdacb.iAc5v[1] << 8) +  pPacketPtr->Rdacb.iAc5v[0]; 
-    aiNominalCellData[eNode][4]  = (pPacketPtr->Rdacb.iAc6v[1] << 8) +  pPacketPtr->Rdacb.iAc6v[0];  
-    aiNominalCellData[eNode][5]  = (pPacketPtr->Rdacc.iAc7v[1] << 8) +  pPacketPtr->Rdacc.iAc7v[0];  
-    aiNominalCellData[eNode][6]  = (pPacketPtr->Rdacc.iAc8v[1] << 8) +  pPacketPtr->Rdacc.iAc8v[0];
-    aiNominalCellData[eNode][7]  = (pPacketPtr->Rdacc.iAc9v[1] << 8) +  pPacketPtr->Rdacc.iAc9v[0];
-    aiNominalCellData[eNode][8]  = (pPacketPtr->Rdacd.iAc11v[1] << 8) + pPacketPtr->Rdacd.iAc11v[0];
-    aiNominalCellData[eNode][9]  = (pPacketPtr->Rdacd.iAc12v[1] << 8) + pPacketPtr->Rdacd.iAc12v[0];
-    aiNominalCellData[eNode][10] = (pPacketPtr->Rdace.iAc13v[1] << 8) + pPacketPtr->Rdace.iAc13v[0];
-    aiNominalCellData[eNode][11] = (pPacketPtr->Rdace.iAc14v[1] << 8) + pPacketPtr->Rdace.iAc14v[0];
-    aiNominalCellData[eNode][12] = (pPacketPtr->Rdace.iAc15v[1] << 8) + pPacketPtr->Rdace.iAc15v[0];
-    aiNominalCellData[eNode][13] = (pPacketPtr->Rdacf.iAc16v[1] << 8) + pPacketPtr->Rdacf.iAc16v[0];
-    aiNominalCellData[eNode][14] = (pPacketPtr->Rdacf.iAc17v[1] << 8) + pPacketPtr->Rdacf.iAc17v[0];
-    aiNominalCellData[eNode][15] = (pPacketPtr->Rdacf.iAc18v[1] << 8) + pPacketPtr->Rdacf.iAc18v[0];
+    memcpy(aiNominalCellData[eNode], pCellCodes, sizeof(aiNominalCellData[eNode]));
 
-    /******************** Get S ch Data for Open Wire detection ********************/
- //   aiOWCellData[eNode][0]  = (pPacketPtr->Rdsva.iS2v[1] << 8) + pPacketPtr->Rdsva.iS2v[0];
- //   aiOWCellData[eNode][1]  = (pPacketPtr->Rdsva.iS3v[1] << 8) + pPacketPtr->Rdsva.iS3v[0];
-        
     iOWDPcktsRcvd[eNode] |= SM_ADBMS6833_C_CH_ODD_RCVD;
     iOWDPcktsRcvd[eNode] |= SM_ADBMS6833_C_CH_EVEN_RCVD;
    
@@ -3280,45 +3823,45 @@ void Cmic_ADBMS683x_Monitor_Base_Pkt1(adi_wil_sensor_data_t* BMSBufferPtr)
     iOWDPcktsRcvd[eNode] |= SM_ADBMS6833_S_CH_EVEN_RCVD;
 }
 
-void Cmic_ADBMS683x_Monitor_Cell_OWD(adi_wil_device_t eNode)
+/* Open wire check of every node in nNodeMask (bit per node) in one batch pass
+ * over the pack's nominal and open wire codes */
+void Cmic_ADBMS683x_Monitor_Pack_OWD(uint64 nNodeMask)
 {
-    uint8_t iCellIndx       = 0U;
-    int32_t iCellData       = 0U;
-    int32_t iCellOWData     = 0U;
-    int32_t iCellDrop       = 0U;
-    int32_t iCellOWThres_p    = 0U;
-    int32_t iCellOWThres_m    = 0U;
+    static uint16 aFaultMask[CMIC_MAX_NODES];
+    static uint16 aZeroMask[CMIC_MAX_NODES];
+    uint8 nNodes = 0U;
+    uint8 eNode;
+    uint8 iCellIndx;
 
-  
-    aiOWStatus[eNode] = SM_ADBMS6833_STATUS_PASS;
-    CmicM_Inst.m_NODE[eNode].OWD_STAT = SM_ADBMS6833_STATUS_PASS;
+    /* The batch runs over the nodes up to the highest one ready */
+    while ((nNodes < CMIC_MAX_NODES) && ((nNodeMask >> nNodes) != 0U))
+    {
+        nNodes++;
+    }
+
+    adi_wil_example_OwdBatch(ADI_OWD_ADBMS6833, &aiNominalCellData[0][0], &aiOWCellData[0][0], nNodes, aFaultMask, aZeroMask);
 
-    for(iCellIndx = 0U; iCellIndx < SM_ADBMS6833_TOTAL_CELLS_PER_DEVICE; iCellIndx++)
+    for (eNode = 0U; eNode < nNodes; eNode++)
     {
-        iCellData    = (aiNominalCellData[eNode][iCellIndx] * SM_ADBMS6833_VTG_REG_RESOLUTION) + SM_ADBMS6833_VTG_REG_OFFSET;
-        iCellOWData  = (aiOWCellData[eNode][iCellIndx]      * SM_ADBMS6833_VTG_REG_RESOLUTION) + SM_ADBMS6833_VTG_REG_OFFSET;
-        iCellDrop    = iCellData - iCellOWData;
+        if ((nNodeMask & (1uLL << eNode)) == 0U) continue;
 
-        iCellOWThres_p = ((iCellData * SM_ADBMS6833_OW_THRESHOLD_PERCENT) / 100);
-        iCellOWThres_m = -((iCellData * SM_ADBMS6833_OW_THRESHOLD_PERCENT) / 100);
+        /* A zero volt reading counts as a failed check but does not fail the node */
+        aiOWStatus[eNode] = (aFaultMask[eNode] != 0U) ? SM_ADBMS6833_STATUS_FAIL : SM_ADBMS6833_STATUS_PASS;
+        iOWDPcktsRcvd[eNode] = 0U;
 
-        if(aiNominalCellData[eNode][iCellIndx] < SM_ADBMS6833_OW_ZERO_VOL)
-        {
-            CmicM_Inst.m_NODE[eNode].OWD_FAIL[iCellIndx]++;
-        }
-        else
+        if (eNode >= ADK_MAX_node) continue;
+
+        CmicM_Inst.m_NODE[eNode].OWD_STAT = aiOWStatus[eNode];
+
+        for(iCellIndx = 0U; iCellIndx < SM_ADBMS6833_TOTAL_CELLS_PER_DEVICE; iCellIndx++)
         {
-            if ((iCellDrop > iCellOWThres_p) || (iCellDrop < iCellOWThres_m))
+            if ((((aFaultMask[eNode] | aZeroMask[eNode]) >> iCellIndx) & 1U) != 0U)
             {
                 CmicM_Inst.m_NODE[eNode].OWD_FAIL[iCellIndx]++;
-                aiOWStatus[eNode] = SM_ADBMS6833_STATUS_FAIL;
-                CmicM_Inst.m_NODE[eNode].OWD_STAT = SM_ADBMS6833_STATUS_FAIL;
             }
             else{ /* DEBUG */
                 CmicM_Inst.m_NODE[eNode].OWD_SUCCESS[iCellIndx]++;
             }
         }
-    
     }
-  
 }
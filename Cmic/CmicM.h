@@ -22,6 +22,9 @@
 #include "adi_wil_example_cell_balance.h"
 #include "adi_wil_example_owd.h"
 #include "adi_wil_example_cfg_profiles.h"
+#include "CmicMConfig.h"
+#include "CmicPack.h"
+#include "CmicBal.h"
 
 /*******************************************************************************
  * Enumerations
@@ -34,6 +37,7 @@ typedef enum
 	eMAIN_BALANCING_ODD,
 	eMAIN_KEY_ON_EVENT,
 	eMAIN_KEY_OFF_EVENT,
+	eMAIN_BALANCING_AUTO,		//Closed loop balancing by CmicBal, entered from eMAIN_SENSING
 }MAIN_STATE_E;
 
 typedef enum
@@ -206,9 +210,34 @@ typedef enum
 	
 }KEY_OFF_STATE_E;
 
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+/* Node count for the types of this header. adi_wil_example_functions.h
+ * includes it before ADK_MAX_node is defined */
+#define CMIC_MAX_NODES		ADI_WIL_MAX_NODES
+
+/*******************************************************************************
+ * Structures
+ *******************************************************************************/
+/* Interval view built by Cmic_ReadBMS in the same sweep that decodes the cells.
+ * Cells failing a plausibility check are left out of the pack aggregates,
+ * see Cmic_PackGetCellAgg() for the min/max and their location */
+typedef struct
+{
+	uint16	nRangeFaults;					/* Cells outside CMIC_CELL_CODE_MIN..MAX */
+	uint16	nRateFaults;					/* Cells changed by more than CMIC_CELL_CODE_MAX_STEP */
+	uint16	nPecErrors;						/* Register groups failing PEC10, CMIC_PEC_VERIFY */
+	float	fAvgV;						/* Of the plausible cells in the pack matrix */
+	float	fImbalanceV;					/* Highest minus lowest plausible cell */
+	uint32	aPlausFault[CMIC_MAX_NODES];		/* Cells failing either check, bit per cell */
+	uint32	aOwdCandidate[CMIC_MAX_NODES];	/* Cells read below SM_ADBMS6833_OW_ZERO_VOL, bit per cell */
+}Cmic_PackStats_t;
+
 void CmicM_Init(void);
 void CmicM_IG_Init(void);
 void CmicM_Handler(void);
+bool Cmic_RegisterEventHandlers(void);
 
 
 MAIN_STATE_E Cmic_GetMainState(void);
@@ -223,15 +252,22 @@ bool Cmic_CompareACL(void);
 uint8 Cmic_ConvertDeviceId (adi_wil_device_t WilDeviceId);
 void Cmic_ReadInitPacket(void);
 void Cmic_ReadBMS(void);
+Cmic_PackStats_t const * Cmic_GetPackStats(void);
+uint32 Cmic_GetPecErrorCount(uint8 eNode);
+#if (CMIC_BMS_BENCHMARK == 1)
+void Cmic_BenchmarkReadBMS(void);
+#endif
+#if (CMIC_SCRIPT_BENCHMARK == 1)
+void Cmic_ScriptBenchmark(void);
+#endif
 void Cmic_SaveLatencyPkt(void);
 void Cmic_PresetModifyData(void);
 bool Cmic_CheckNode(void);
 void Cmic_RequestModifyScript_CFG_A(void);
 void Cmic_RequestModifyScript_CFG_B(void);
-uint16_t Cmic_PEC10_Calc(bool rx_cmd, int offset, int len, uint8_t *data);
 void Cmic_MAC_DeviceID_Return(adi_wil_pack_t *pPack, bool bMacReturn, uint8_t *pMacPtr, uint8_t *pDeviceID);
-void Cmic_ADBMS683x_Monitor_Base_Pkt0(adi_wil_sensor_data_t* BMSBufferPtr);
+void Cmic_ADBMS683x_Monitor_Base_Pkt0(uint8 eNode, sint16 const *pCellCodes);
 void Cmic_ADBMS683x_Monitor_Base_Pkt1(adi_wil_sensor_data_t* BMSBufferPtr);
 void Cmic_ADBMS683x_Monitor_Base_Pkt2(adi_wil_sensor_data_t* BMSBufferPtr);
-void Cmic_ADBMS683x_Monitor_Cell_OWD(adi_wil_device_t eNode);
+void Cmic_ADBMS683x_Monitor_Pack_OWD(uint64 nNodeMask);
 #endif /* CMICM_H_ */
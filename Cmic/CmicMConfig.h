@@ -5,5 +5,57 @@
 ******************************************************************************/
 //#define     _ADI_ONLY       1
 
+/* Period in ms at which CmicM_Handler retries registering the Cmic event
+ * handlers after the event bus had no room for them */
+#define     CMIC_EVENT_RETRY_MS     (1000u)
+
+/******************************************************************************
+**                     BMS Interval Plausibility                   **
+******************************************************************************/
+/* Limits in ADBMS683x cell codes, V = code * 150 uV + 1.5 V */
+#define     CMIC_CELL_CODE_MIN      (-8000)     /* 0.3 V, lower codes are out of range */
+#define     CMIC_CELL_CODE_MAX      (20000)     /* 4.5 V, higher codes are out of range */
+#define     CMIC_CELL_CODE_MAX_STEP (1333)      /* 200 mV, largest change between two intervals */
+
+/* Consecutive BMS intervals without a base packet of a node after which its
+ * codes leave the pack aggregates, 0 : only on a disconnect event */
+#define     CMIC_PACK_MISS_LIMIT    (4)
+
+/* 1: time Cmic_ReadBMS on a synthetic 62 node interval at power on and print
+ * the CPU cycles per interval */
+#define     CMIC_BMS_BENCHMARK      0
+
+/* 1: compare a pack min/max/sum query walking m_NODE style node structs with
+ * the aggregates kept by CmicPack, for 62 nodes, at power on */
+#define     CMIC_PACK_BENCHMARK     0
+
+/* 1: run the balancing writes over typical DCC updates of 12 nodes at power
+ * on, with adi_wil_ModifyScript replaced by a call counter, and print the
+ * requests the script cache let through */
+#define     CMIC_SCRIPT_BENCHMARK   0
+
+/* 1: check the PEC10 of every register group of the base packets and count
+ * the failures per node. Cells read from a failing group are left out of the
+ * pack aggregates */
+#define     CMIC_PEC_VERIFY         0
+
+/******************************************************************************
+**                     Closed Loop Balancing                       **
+******************************************************************************/
+/* Thresholds in cell codes above the lowest plausible cell of the pack */
+#define     CMIC_BAL_START_DELTA    (67)        /* 10 mV, a cell starts discharging above it */
+#define     CMIC_BAL_STOP_DELTA     (20)        /* 3 mV, a discharging cell stops at or below it */
+#define     CMIC_BAL_MAX_CELLS_NODE (4)         /* Discharging cells per node, bounds the heat of the bleed resistors */
+#define     CMIC_BAL_HOLD_INTERVALS (10)        /* Intervals a node keeps a written pattern before it may change */
+
+/* Thermal limit on the aux codes of a node. With the NTC on the low side of a
+ * 10k divider from 3 V a hotter node reads a lower code */
+#define     CMIC_BAL_TEMP_CODE_MIN  (-5400)     /* About 60 degC, the node stops discharging below it */
+#define     CMIC_BAL_TEMP_CODE_HYST (700)       /* About 5 degC, the node resumes above MIN + HYST */
+
+/* 1: run the controller on a modelled drifting pack at power on and print the
+ * convergence and the ModifyScript writes used */
+#define     CMIC_BAL_SIMULATION     0
+
 
 #endif /*CMICMCONFIG_H_*/
@@ -0,0 +1,331 @@
+/*
+ * CmicPack.c
+ *
+ *  Pack wide cell matrix, node-major (see CMIC_PACK_CELL_INDEX). A node
+ *  update recomputes the aggregate of that node's row and folds it into the
+ *  pack aggregate, so the pack min/max/sum is read without walking the
+ *  nodes. Only when the node holding the pack min or max moves away from it
+ *  are the node aggregates scanned again.
+ */
+
+#include <string.h>
+
+#include "CmicPack.h"
+#include "adi_wil_example_functions.h"
+#if (CMIC_PACK_BENCHMARK == 1)
+#include "adi_wil_example_printf.h"
+#include "IfxStm.h"
+#include "IfxScuCcu.h"
+#endif
+
+typedef struct
+{
+	sint16			m_aCell[CMIC_PACK_MAX_CELLS];			//Raw cell codes, CMIC_PACK_CELL_INDEX
+	sint16			m_aTemp[CMIC_PACK_MAX_TEMPS];			//Raw aux codes, CMIC_PACK_TEMP_INDEX
+	uint8			m_aCellStatus[CMIC_PACK_MAX_CELLS];		//CMIC_PACK_ST_xxx
+	uint8			m_aTempStatus[CMIC_PACK_MAX_TEMPS];
+
+	Cmic_PackAgg_t	m_aNodeCell[CMIC_PACK_MAX_NODES];		//Aggregate of each node row
+	Cmic_PackAgg_t	m_aNodeTemp[CMIC_PACK_MAX_NODES];
+	Cmic_PackAgg_t	m_tCell;								//Aggregate of the pack
+	Cmic_PackAgg_t	m_tTemp;
+
+} CmicPack_Instance_t;
+
+static CmicPack_Instance_t CmicPack_Inst;
+
+static void Cmic_PackAggReset(Cmic_PackAgg_t *pAgg);
+static void Cmic_PackUpdateRow(sint16 *pRow, uint8 *pStatus, sint16 const *pCodes, uint8 nWidth, uint32 nExclude,
+                               uint16 nBase, Cmic_PackAgg_t *pNodeAgg);
+static void Cmic_PackMerge(Cmic_PackAgg_t *pPack, Cmic_PackAgg_t const *pNodes, Cmic_PackAgg_t const *pOld,
+                           uint8 nNode, uint8 nWidth);
+static void Cmic_PackRescanMin(Cmic_PackAgg_t *pPack, Cmic_PackAgg_t const *pNodes);
+static void Cmic_PackRescanMax(Cmic_PackAgg_t *pPack, Cmic_PackAgg_t const *pNodes);
+
+void Cmic_PackInit(void)
+{
+	uint8 nNode;
+
+	memset(&CmicPack_Inst, 0, sizeof(CmicPack_Inst));
+
+	for (nNode = 0; nNode < CMIC_PACK_MAX_NODES; nNode++) {
+		Cmic_PackAggReset(&CmicPack_Inst.m_aNodeCell[nNode]);
+		Cmic_PackAggReset(&CmicPack_Inst.m_aNodeTemp[nNode]);
+	}
+	Cmic_PackAggReset(&CmicPack_Inst.m_tCell);
+	Cmic_PackAggReset(&CmicPack_Inst.m_tTemp);
+}
+
+void Cmic_PackSetNodeCells(uint8 nNode, sint16 const *pCodes, uint32 nFaultMask, uint32 nOwdMask)
+{
+	Cmic_PackAgg_t tOld;
+	uint16 nBase;
+	uint8 i;
+
+	if (nNode >= CMIC_PACK_MAX_NODES) return;
+
+	nBase = CMIC_PACK_CELL_INDEX(nNode, 0u);
+	tOld = CmicPack_Inst.m_aNodeCell[nNode];
+
+	Cmic_PackUpdateRow(&CmicPack_Inst.m_aCell[nBase], &CmicPack_Inst.m_aCellStatus[nBase], pCodes, CMIC_PACK_CELLS,
+	                   nFaultMask, nBase, &CmicPack_Inst.m_aNodeCell[nNode]);
+
+	for (i = 0; i < CMIC_PACK_CELLS; i++) {
+		if ((nOwdMask & (1uL << i)) != 0u) {
+			CmicPack_Inst.m_aCellStatus[nBase + i] |= CMIC_PACK_ST_OWD;
+		}
+	}
+
+	Cmic_PackMerge(&CmicPack_Inst.m_tCell, CmicPack_Inst.m_aNodeCell, &tOld, nNode, CMIC_PACK_CELLS);
+}
+
+void Cmic_PackSetNodeTemps(uint8 nNode, sint16 const *pCodes)
+{
+	Cmic_PackAgg_t tOld;
+	uint16 nBase;
+
+	if (nNode >= CMIC_PACK_MAX_NODES) return;
+
+	nBase = CMIC_PACK_TEMP_INDEX(nNode, 0u);
+	tOld = CmicPack_Inst.m_aNodeTemp[nNode];
+
+	Cmic_PackUpdateRow(&CmicPack_Inst.m_aTemp[nBase], &CmicPack_Inst.m_aTempStatus[nBase], pCodes, CMIC_PACK_TEMPS,
+	                   0u, nBase, &CmicPack_Inst.m_aNodeTemp[nNode]);
+
+	Cmic_PackMerge(&CmicPack_Inst.m_tTemp, CmicPack_Inst.m_aNodeTemp, &tOld, nNode, CMIC_PACK_TEMPS);
+}
+
+void Cmic_PackClearNode(uint8 nNode)
+{
+	Cmic_PackAgg_t tOld;
+
+	if (nNode >= CMIC_PACK_MAX_NODES) return;
+
+	/* An empty node aggregate folds the old row out of the pack */
+	tOld = CmicPack_Inst.m_aNodeCell[nNode];
+	memset(&CmicPack_Inst.m_aCell[CMIC_PACK_CELL_INDEX(nNode, 0u)], 0, CMIC_PACK_CELLS * sizeof(sint16));
+	memset(&CmicPack_Inst.m_aCellStatus[CMIC_PACK_CELL_INDEX(nNode, 0u)], 0, CMIC_PACK_CELLS);
+	Cmic_PackAggReset(&CmicPack_Inst.m_aNodeCell[nNode]);
+	Cmic_PackMerge(&CmicPack_Inst.m_tCell, CmicPack_Inst.m_aNodeCell, &tOld, nNode, CMIC_PACK_CELLS);
+
+	tOld = CmicPack_Inst.m_aNodeTemp[nNode];
+	memset(&CmicPack_Inst.m_aTemp[CMIC_PACK_TEMP_INDEX(nNode, 0u)], 0, CMIC_PACK_TEMPS * sizeof(sint16));
+	memset(&CmicPack_Inst.m_aTempStatus[CMIC_PACK_TEMP_INDEX(nNode, 0u)], 0, CMIC_PACK_TEMPS);
+	Cmic_PackAggReset(&CmicPack_Inst.m_aNodeTemp[nNode]);
+	Cmic_PackMerge(&CmicPack_Inst.m_tTemp, CmicPack_Inst.m_aNodeTemp, &tOld, nNode, CMIC_PACK_TEMPS);
+}
+
+Cmic_PackAgg_t const * Cmic_PackGetCellAgg(void)
+{
+	return &CmicPack_Inst.m_tCell;
+}
+
+Cmic_PackAgg_t const * Cmic_PackGetTempAgg(void)
+{
+	return &CmicPack_Inst.m_tTemp;
+}
+
+Cmic_PackAgg_t const * Cmic_PackGetNodeCellAgg(uint8 nNode)
+{
+	if (nNode >= CMIC_PACK_MAX_NODES) return NULL_PTR;
+
+	return &CmicPack_Inst.m_aNodeCell[nNode];
+}
+
+sint16 const * Cmic_PackGetCellCodes(void)
+{
+	return CmicPack_Inst.m_aCell;
+}
+
+uint8 const * Cmic_PackGetCellStatus(void)
+{
+	return CmicPack_Inst.m_aCellStatus;
+}
+
+sint16 const * Cmic_PackGetTempCodes(void)
+{
+	return CmicPack_Inst.m_aTemp;
+}
+
+static void Cmic_PackAggReset(Cmic_PackAgg_t *pAgg)
+{
+	pAgg->nMin = 0x7FFF;
+	pAgg->nMax = -0x8000;
+	pAgg->nMinIdx = CMIC_PACK_NO_INDEX;
+	pAgg->nMaxIdx = CMIC_PACK_NO_INDEX;
+	pAgg->nSum = 0;
+	pAgg->nCount = 0u;
+}
+
+/* Stores one node row and rebuilds its aggregate, the row is a handful of
+ * adjacent codes so this is a single short pass */
+static void Cmic_PackUpdateRow(sint16 *pRow, uint8 *pStatus, sint16 const *pCodes, uint8 nWidth, uint32 nExclude,
+                               uint16 nBase, Cmic_PackAgg_t *pNodeAgg)
+{
+	sint16 nCode;
+	uint8 i;
+
+	Cmic_PackAggReset(pNodeAgg);
+
+	for (i = 0; i < nWidth; i++) {
+		nCode = pCodes[i];
+		pRow[i] = nCode;
+
+		if ((nExclude & (1uL << i)) != 0u) {
+			pStatus[i] = CMIC_PACK_ST_PRESENT | CMIC_PACK_ST_FAULT;
+			continue;
+		}
+		pStatus[i] = CMIC_PACK_ST_PRESENT;
+
+		pNodeAgg->nSum += nCode;
+		pNodeAgg->nCount++;
+
+		if ((pNodeAgg->nMinIdx == CMIC_PACK_NO_INDEX) || (nCode < pNodeAgg->nMin)) {
+			pNodeAgg->nMin = nCode;
+			pNodeAgg->nMinIdx = nBase + i;
+		}
+		if ((pNodeAgg->nMaxIdx == CMIC_PACK_NO_INDEX) || (nCode > pNodeAgg->nMax)) {
+			pNodeAgg->nMax = nCode;
+			pNodeAgg->nMaxIdx = nBase + i;
+		}
+	}
+}
+
+/* Folds the new aggregate of node nNode into the pack. pOld is the node
+ * aggregate before the update */
+static void Cmic_PackMerge(Cmic_PackAgg_t *pPack, Cmic_PackAgg_t const *pNodes, Cmic_PackAgg_t const *pOld,
+                           uint8 nNode, uint8 nWidth)
+{
+	Cmic_PackAgg_t const *pNew = &pNodes[nNode];
+	boolean bOwnsMin = (pPack->nMinIdx != CMIC_PACK_NO_INDEX) && ((pPack->nMinIdx / nWidth) == nNode);
+	boolean bOwnsMax = (pPack->nMaxIdx != CMIC_PACK_NO_INDEX) && ((pPack->nMaxIdx / nWidth) == nNode);
+
+	pPack->nSum += pNew->nSum - pOld->nSum;
+	pPack->nCount = (uint16)(pPack->nCount + pNew->nCount - pOld->nCount);
+
+	if ((pNew->nCount > 0u) && ((pPack->nMinIdx == CMIC_PACK_NO_INDEX) || (pNew->nMin < pPack->nMin) ||
+	                            (bOwnsMin && (pNew->nMin == pPack->nMin)))) {
+		pPack->nMin = pNew->nMin;
+		pPack->nMinIdx = pNew->nMinIdx;
+	}
+	else if (bOwnsMin) {
+		/* The node held the pack min and moved up, another node may hold it now */
+		Cmic_PackRescanMin(pPack, pNodes);
+	}
+
+	if ((pNew->nCount > 0u) && ((pPack->nMaxIdx == CMIC_PACK_NO_INDEX) || (pNew->nMax > pPack->nMax) ||
+	                            (bOwnsMax && (pNew->nMax == pPack->nMax)))) {
+		pPack->nMax = pNew->nMax;
+		pPack->nMaxIdx = pNew->nMaxIdx;
+	}
+	else if (bOwnsMax) {
+		Cmic_PackRescanMax(pPack, pNodes);
+	}
+}
+
+static void Cmic_PackRescanMin(Cmic_PackAgg_t *pPack, Cmic_PackAgg_t const *pNodes)
+{
+	uint8 nNode;
+
+	pPack->nMin = 0x7FFF;
+	pPack->nMinIdx = CMIC_PACK_NO_INDEX;
+
+	for (nNode = 0; nNode < CMIC_PACK_MAX_NODES; nNode++) {
+		if ((pNodes[nNode].nCount > 0u) &&
+		    ((pPack->nMinIdx == CMIC_PACK_NO_INDEX) || (pNodes[nNode].nMin < pPack->nMin))) {
+			pPack->nMin = pNodes[nNode].nMin;
+			pPack->nMinIdx = pNodes[nNode].nMinIdx;
+		}
+	}
+}
+
+static void Cmic_PackRescanMax(Cmic_PackAgg_t *pPack, Cmic_PackAgg_t const *pNodes)
+{
+	uint8 nNode;
+
+	pPack->nMax = -0x8000;
+	pPack->nMaxIdx = CMIC_PACK_NO_INDEX;
+
+	for (nNode = 0; nNode < CMIC_PACK_MAX_NODES; nNode++) {
+		if ((pNodes[nNode].nCount > 0u) &&
+		    ((pPack->nMaxIdx == CMIC_PACK_NO_INDEX) || (pNodes[nNode].nMax > pPack->nMax))) {
+			pPack->nMax = pNodes[nNode].nMax;
+			pPack->nMaxIdx = pNodes[nNode].nMaxIdx;
+		}
+	}
+}
+
+#if (CMIC_PACK_BENCHMARK == 1)
+#define CMIC_PACK_BENCH_NODES		62u
+#define CMIC_PACK_BENCH_ROUNDS		100u
+
+static uint32 Cmic_PackTicksToCycles(uint32 nTicks)
+{
+	return (uint32)((float32)nTicks * (IfxScuCcu_getCpuFrequency(IfxCpu_ResourceCpu_0) / IfxStm_getFrequency(&MODULE_STM0)));
+}
+
+void Cmic_PackBenchmark(void)
+{
+	/* The per node layout of m_NODE, enough of them for the benchmark nodes */
+	static NODESTR aNodes[(CMIC_PACK_BENCH_NODES + ADK_MAX_node - 1u) / ADK_MAX_node];
+	sint16 aCodes[CMIC_PACK_CELLS];
+	volatile sint32 nSink = 0;
+	sint16 nMin, nMax, nCode;
+	sint32 nSum;
+	uint32 nStart, nScanTicks, nQueryTicks, nUpdateTicks;
+	uint16 nRound;
+	uint8 nNode, i;
+
+	for (nNode = 0; nNode < CMIC_PACK_BENCH_NODES; nNode++) {
+		for (i = 0; i < CMIC_PACK_CELLS; i++) {
+			aCodes[i] = (sint16)(14667 + (sint16)((nNode * 7u + i * 13u) % 64u));
+			aNodes[nNode / ADK_MAX_node][nNode % ADK_MAX_node].CELL_Vi[i] = aCodes[i] + 10000;
+		}
+		Cmic_PackSetNodeCells(nNode, aCodes, 0u, 0u);
+	}
+
+	/* Before: every query walks the cells of each node struct */
+	nStart = IfxStm_getLower(&MODULE_STM0);
+	for (nRound = 0; nRound < CMIC_PACK_BENCH_ROUNDS; nRound++) {
+		nMin = 0x7FFF;
+		nMax = -0x8000;
+		nSum = 0;
+		for (nNode = 0; nNode < CMIC_PACK_BENCH_NODES; nNode++) {
+			for (i = 0; i < CMIC_PACK_CELLS; i++) {
+				nCode = aNodes[nNode / ADK_MAX_node][nNode % ADK_MAX_node].CELL_Vi[i];
+				if (nCode < nMin) nMin = nCode;
+				if (nCode > nMax) nMax = nCode;
+				nSum += nCode;
+			}
+		}
+		nSink += nMin + nMax + nSum;
+	}
+	nScanTicks = (IfxStm_getLower(&MODULE_STM0) - nStart) / CMIC_PACK_BENCH_ROUNDS;
+
+	/* After: the query reads the maintained aggregate */
+	nStart = IfxStm_getLower(&MODULE_STM0);
+	for (nRound = 0; nRound < CMIC_PACK_BENCH_ROUNDS; nRound++) {
+		nSink += Cmic_PackGetCellAgg()->nMin + Cmic_PackGetCellAgg()->nMax + Cmic_PackGetCellAgg()->nSum;
+	}
+	nQueryTicks = (IfxStm_getLower(&MODULE_STM0) - nStart) / CMIC_PACK_BENCH_ROUNDS;
+
+	/* The price paid instead, once per node per interval */
+	nStart = IfxStm_getLower(&MODULE_STM0);
+	for (nRound = 0; nRound < CMIC_PACK_BENCH_ROUNDS; nRound++) {
+		nNode = (uint8)(nRound % CMIC_PACK_BENCH_NODES);
+		memcpy(aCodes, &CmicPack_Inst.m_aCell[CMIC_PACK_CELL_INDEX(nNode, 0u)], sizeof(aCodes));
+		aCodes[nRound % CMIC_PACK_CELLS] += (sint16)(((nRound & 1u) != 0u) ? 100 : -100);
+		Cmic_PackSetNodeCells(nNode, aCodes, 0u, 0u);
+	}
+	nUpdateTicks = (IfxStm_getLower(&MODULE_STM0) - nStart) / CMIC_PACK_BENCH_ROUNDS;
+
+	adi_wil_ex_printf("Cmic pack query, %u nodes : scan %u cycles, aggregate %u cycles, node update %u cycles" LINE_END,
+	                  (unsigned int)CMIC_PACK_BENCH_NODES,
+	                  (unsigned int)Cmic_PackTicksToCycles(nScanTicks),
+	                  (unsigned int)Cmic_PackTicksToCycles(nQueryTicks),
+	                  (unsigned int)Cmic_PackTicksToCycles(nUpdateTicks));
+
+	(void)nSink;
+	Cmic_PackInit();
+}
+#endif
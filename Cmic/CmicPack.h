@@ -0,0 +1,91 @@
+/*
+ * CmicPack.h
+ *
+ *  Pack wide cell matrix. Cell and aux codes of every node are kept in dense
+ *  arrays in pack order, with the min/max/sum of the pack maintained as the
+ *  nodes are updated.
+ */
+
+#ifndef CMICPACK_H_
+#define CMICPACK_H_
+
+#include "Platform_Types.h"
+#include "adi_wil_types.h"
+#include "CmicMConfig.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define CMIC_PACK_MAX_NODES		ADI_WIL_MAX_NODES
+#define CMIC_PACK_CELLS			16u								/* Cells read per node */
+#define CMIC_PACK_TEMPS			4u								/* Aux inputs read per node */
+#define CMIC_PACK_MAX_CELLS		(CMIC_PACK_MAX_NODES * CMIC_PACK_CELLS)
+#define CMIC_PACK_MAX_TEMPS		(CMIC_PACK_MAX_NODES * CMIC_PACK_TEMPS)
+
+/* Pack index of an entry, the arrays are walked in series order. The layout is
+ * node-major (the CMIC_PACK_CELLS cells of a node are adjacent) rather than
+ * cell-major (cell i of every node adjacent): a base packet 0 carries one
+ * node's cells, so the per interval update writes one contiguous row in
+ * packet decode order, and the node aggregate that the pack aggregate is
+ * folded from is rebuilt in one short pass over that row. Pack wide queries
+ * read the aggregates and do not depend on the layout */
+#define CMIC_PACK_CELL_INDEX(node, cell)	((uint16)(((uint16)(node) * CMIC_PACK_CELLS) + (cell)))
+#define CMIC_PACK_TEMP_INDEX(node, temp)	((uint16)(((uint16)(node) * CMIC_PACK_TEMPS) + (temp)))
+
+#define CMIC_PACK_NO_INDEX		0xFFFFu							/* Aggregate without any entry */
+
+/* Raw code to volts, V = code * 150 uV + 1.5 V */
+#define CMIC_PACK_CODE_TO_V(code)		(((float)(code) * CELL_UNIT / 1000000.0f) + CELL_OFFSET)
+#define CMIC_PACK_DELTA_TO_V(delta)		((float)(delta) * CELL_UNIT / 1000000.0f)
+
+/* Entry status, bit per flag */
+#define CMIC_PACK_ST_PRESENT	0x01u							/* A code was stored */
+#define CMIC_PACK_ST_FAULT		0x02u							/* Failed plausibility, left out of the aggregates */
+#define CMIC_PACK_ST_OWD		0x04u							/* Open wire candidate */
+
+/*******************************************************************************
+ * Structures
+ *******************************************************************************/
+/* Min/max/sum over the present entries without a fault */
+typedef struct
+{
+	sint16	nMin;
+	sint16	nMax;
+	uint16	nMinIdx;						/* Pack index of nMin, CMIC_PACK_NO_INDEX when nCount is 0 */
+	uint16	nMaxIdx;
+	sint32	nSum;
+	uint16	nCount;
+}Cmic_PackAgg_t;
+
+/*******************************************************************************
+ * Functions
+ *******************************************************************************/
+void Cmic_PackInit(void);
+
+/* Stores the CMIC_PACK_CELLS codes of a node. Cells set in nFaultMask are
+ * stored but left out of the aggregates */
+void Cmic_PackSetNodeCells(uint8 nNode, sint16 const *pCodes, uint32 nFaultMask, uint32 nOwdMask);
+
+/* Stores the CMIC_PACK_TEMPS aux codes of a node */
+void Cmic_PackSetNodeTemps(uint8 nNode, sint16 const *pCodes);
+
+/* Drops the cell and aux rows of a node that left the network or stopped
+ * reporting, its codes leave the aggregates and lose CMIC_PACK_ST_PRESENT */
+void Cmic_PackClearNode(uint8 nNode);
+
+/* Pack aggregates, constant time */
+Cmic_PackAgg_t const * Cmic_PackGetCellAgg(void);
+Cmic_PackAgg_t const * Cmic_PackGetTempAgg(void);
+Cmic_PackAgg_t const * Cmic_PackGetNodeCellAgg(uint8 nNode);
+
+/* Dense arrays for consumers walking the whole pack, indexed by
+ * CMIC_PACK_CELL_INDEX / CMIC_PACK_TEMP_INDEX */
+sint16 const * Cmic_PackGetCellCodes(void);
+uint8 const * Cmic_PackGetCellStatus(void);
+sint16 const * Cmic_PackGetTempCodes(void);
+
+#if (CMIC_PACK_BENCHMARK == 1)
+void Cmic_PackBenchmark(void);
+#endif
+
+#endif /* CMICPACK_H_ */
@@ -29,6 +29,9 @@
 #include "IfxScuWdt.h"
 #include "CmicM.h"
 #include "CmicMConfig.h"
+#include "adi_wil_hal_trace.h"
+#include "adi_wil_example_printf.h"
+#include "adi_wil_example_event_bus.h"
 
 int adi_wil_example_Main(void);
 
@@ -49,6 +52,8 @@ void core0_main(void)
     IfxCpu_emitEvent(&g_cpuSyncEvent);
     IfxCpu_waitEvent(&g_cpuSyncEvent, 1);
 
+    ADI_WIL_HAL_TRACE_INIT();
+
 #ifndef _ADI_ONLY
 
     CmicM_Init();
@@ -57,6 +62,8 @@ void core0_main(void)
     while(1)
     {
         CmicM_Handler();
+        adi_wil_example_EventBusDrain();
+        adi_wil_ex_LogDrain();
     }
 
 #else
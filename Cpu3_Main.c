@@ -27,6 +27,7 @@
 #include "Ifx_Types.h"
 #include "IfxCpu.h"
 #include "IfxScuWdt.h"
+#include "adi_wil_example_event_bus.h"
 
 extern IfxCpu_syncEvent g_cpuSyncEvent;
 
@@ -45,5 +46,7 @@ void core3_main(void)
     
     while(1)
     {
+        /* Event handlers registered as deferred to this core */
+        adi_wil_example_EventBusDrain();
     }
 }
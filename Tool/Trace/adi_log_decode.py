@@ -0,0 +1,160 @@
+#!/usr/bin/env python3
+"""Format the deferred log stream written by adi_wil_ex_LogDrain().
+
+usage: adi_log_decode.py firmware.elf capture.bin [--time]
+       adi_log_decode.py firmware.elf COM5 --baud 921600   (needs pyserial)
+
+Each record is a little-endian word stream:
+  word0  0xA55A << 16 | level << 8 | word count
+  word1  address of the format string in the ELF image
+  word2  HAL ticker timestamp in ms
+  word3+ raw arguments (see adi_wil_ex_LogCaptureArgs)
+Bytes outside records (plain printf output) are passed through unchanged.
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+SYNC = 0xA55A
+LEVELS = {0: "", 1: "\r\n[INFO] ", 2: "\r\n[ERROR] ", 3: "\r\n[FATAL] "}
+LEVEL_DROPPED = 0xFF
+CONVERSION = re.compile(r"%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d+))?(hh|h|ll|l|j|z|t|L)?([diouxXeEfFgGaAcspn%])")
+
+
+class Elf32:
+    """Just enough ELF32 parsing to read constant strings by address."""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            self.data = f.read()
+        if self.data[:4] != b"\x7fELF" or self.data[4] != 1:
+            raise ValueError("%s is not an ELF32 file" % path)
+        shoff, = struct.unpack_from("<I", self.data, 0x20)
+        shentsize, shnum = struct.unpack_from("<HH", self.data, 0x2E)
+        self.sections = []
+        for i in range(shnum):
+            _, sh_type, flags, addr, offset, size = struct.unpack_from("<IIIIII", self.data, shoff + i * shentsize)
+            if sh_type == 1 and (flags & 0x2) and size:  # SHT_PROGBITS, SHF_ALLOC
+                self.sections.append((addr, offset, size))
+
+    def string(self, address):
+        # Cached (0x8...) and non-cached (0xA...) flash views map to the same image
+        for candidate in (address, address ^ 0x20000000):
+            for addr, offset, size in self.sections:
+                if addr <= candidate < addr + size:
+                    start = offset + candidate - addr
+                    end = self.data.index(b"\0", start)
+                    return self.data[start:end].decode("latin-1")
+        return None
+
+
+def signed(value, bits):
+    return value - (1 << bits) if value & (1 << (bits - 1)) else value
+
+
+def render(fmt, words):
+    """printf() for captured argument words."""
+    out = []
+    pos = 0
+    args = iter(words)
+
+    def take():
+        return next(args, 0)
+
+    for m in CONVERSION.finditer(fmt):
+        out.append(fmt[pos:m.start()])
+        pos = m.end()
+        flags, width, precision, length, conv = m.groups()
+        if conv == "%":
+            out.append("%")
+            continue
+        if width == "*":
+            width = str(signed(take(), 32))
+        if precision == "*":
+            precision = str(signed(take(), 32))
+        spec = "%" + flags + (width or "") + ("." + precision if precision else "")
+        wide = length in ("ll", "j")
+        if conv in "diouxXc":
+            value = take()
+            if wide:
+                value |= take() << 32
+            bits = 64 if wide else 32
+            if conv in "di":
+                out.append((spec + "d") % signed(value, bits))
+            elif conv == "u":
+                out.append((spec + "d") % value)
+            elif conv == "c":
+                out.append((spec + "c") % chr(value & 0xFF))
+            else:
+                out.append((spec + conv) % value)
+        elif conv in "eEfFgGaA":
+            value, = struct.unpack("<d", struct.pack("<II", take(), take()))
+            out.append(value.hex() if conv in "aA" else (spec + conv) % value)
+        elif conv == "s":
+            length_bytes = take()
+            raw = b"".join(struct.pack("<I", take()) for _ in range((length_bytes + 3) // 4))
+            out.append((spec + "s") % raw[:length_bytes].decode("latin-1"))
+        elif conv == "p":
+            out.append("0x%08x" % take())
+    out.append(fmt[pos:])
+    return "".join(out)
+
+
+def decode(stream, elf, show_time):
+    buf = b""
+    while True:
+        chunk = stream.read(4096)
+        if not chunk:
+            break
+        buf += chunk
+        while len(buf) >= 4:
+            header, = struct.unpack_from("<I", buf, 0)
+            count = header & 0xFF
+            if (header >> 16 != SYNC) or (count < 3):
+                # Plain printf() text, pass it through one byte at a time
+                sys.stdout.write(buf[:1].decode("latin-1"))
+                buf = buf[1:]
+                continue
+            if len(buf) < count * 4:
+                break
+            words = struct.unpack_from("<%dI" % count, buf, 0)
+            buf = buf[count * 4:]
+            level = (header >> 8) & 0xFF
+            stamp = "%10.3f " % (words[2] / 1000.0) if show_time else ""
+            if level == LEVEL_DROPPED:
+                sys.stdout.write("\r\n%s[LOG] %u record(s) dropped" % (stamp, words[3]))
+                continue
+            fmt = elf.string(words[1])
+            if fmt is None:
+                text = "<unknown format 0x%08X>" % words[1]
+            else:
+                text = render(fmt, words[3:])
+            prefix = LEVELS.get(level, "\r\n[L%d] " % level)
+            if prefix and stamp:
+                prefix = prefix + stamp
+            sys.stdout.write(prefix + text)
+        sys.stdout.flush()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("elf")
+    parser.add_argument("source", help="binary capture file or serial port")
+    parser.add_argument("--baud", type=int, default=921600)
+    parser.add_argument("--time", action="store_true", help="prefix messages with the target timestamp")
+    args = parser.parse_args()
+
+    elf = Elf32(args.elf)
+    try:
+        stream = open(args.source, "rb")
+    except OSError:
+        import serial
+        stream = serial.Serial(args.source, args.baud, timeout=None)
+    with stream:
+        decode(stream, elf, args.time)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,103 @@
+#!/usr/bin/env python3
+"""Convert a HAL trace dump (see trace-dump.cmm) to Chrome trace / Perfetto JSON.
+
+usage: adi_trace_decode.py trace.bin [-o trace.json]
+
+Open the result in chrome://tracing or https://ui.perfetto.dev.
+The dump layout follows adi_wil_hal_trace.h (little-endian TriCore).
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+MAGIC = 0x52544441
+HEADER = struct.Struct("<IHHII")
+RING_HEADER = struct.Struct("<I12x")
+RECORD = struct.Struct("<IHHII")
+
+EVENTS = {
+    0x0001: "FRAME_TX",
+    0x0002: "FRAME_RX",
+    0x0003: "API_CB",
+    0x0004: "API_TIMEOUT",
+    0x0005: "XMS_SUBMIT",
+    0x0006: "CMIC_STEP",
+}
+
+
+def read_ring(data, offset, record_count):
+    """Return the records of one ring, oldest first, skipping torn entries."""
+    (head,) = RING_HEADER.unpack_from(data, offset)
+    offset += RING_HEADER.size
+    first = max(0, head - record_count)
+    records = []
+    for position in range(first, head):
+        slot = position % record_count
+        ts, event, seq, arg0, arg1 = RECORD.unpack_from(data, offset + slot * RECORD.size)
+        if seq != (position & 0xFFFF):
+            continue
+        records.append((ts, event, arg0, arg1))
+    return records
+
+
+def unwrap(records):
+    """Extend the 32-bit STM timestamps to a monotonic 64-bit count."""
+    base = 0
+    previous = None
+    for ts, event, arg0, arg1 in records:
+        if previous is not None and ts < previous:
+            base += 1 << 32
+        previous = ts
+        yield base + ts, event, arg0, arg1
+
+
+def decode(data):
+    magic, record_size, record_count, tick_hz, core_count = HEADER.unpack_from(data, 0)
+    if magic != MAGIC:
+        raise ValueError("not a HAL trace dump (magic 0x%08X)" % magic)
+    if record_size != RECORD.size:
+        raise ValueError("unexpected record size %d" % record_size)
+    if tick_hz == 0:
+        raise ValueError("tick frequency not set - adi_wil_hal_TraceInit() was not called")
+
+    ring_size = RING_HEADER.size + record_count * RECORD.size
+    events = []
+    for core in range(core_count):
+        offset = HEADER.size + core * ring_size
+        for ticks, event, arg0, arg1 in unwrap(read_ring(data, offset, record_count)):
+            name = EVENTS.get(event, "USER_0x%04X" % event if event >= 0x8000 else "0x%04X" % event)
+            events.append({
+                "name": name,
+                "ph": "i",
+                "s": "t",
+                "pid": 0,
+                "tid": core,
+                "ts": ticks * 1e6 / tick_hz,
+                "args": {"arg0": "0x%08X" % arg0, "arg1": "0x%08X" % arg1},
+            })
+    for core in range(core_count):
+        events.append({"name": "thread_name", "ph": "M", "pid": 0, "tid": core,
+                       "args": {"name": "CPU%d" % core}})
+    return {"traceEvents": events, "displayTimeUnit": "ns"}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("dump")
+    parser.add_argument("-o", "--output", default="-")
+    args = parser.parse_args()
+
+    with open(args.dump, "rb") as f:
+        trace = decode(f.read())
+
+    if args.output == "-":
+        json.dump(trace, sys.stdout, indent=1)
+    else:
+        with open(args.output, "w") as f:
+            json.dump(trace, f, indent=1)
+
+
+if __name__ == "__main__":
+    main()